@@ -85,6 +85,7 @@ typedef struct
     double total_time;
     int num_iter;
     int t_computed;
+    int num_cond_skip;  // number of solves that reused the condensed matrices
 } qp_info;
 #endif
 
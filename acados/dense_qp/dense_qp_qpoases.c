@@ -179,9 +179,14 @@ void dense_qp_qpoases_opts_set(void *config_, void *opts_, const char *field, vo
             opts->warm_start = 1;
             opts->hotstart = 1;
         }
+        else if (*warm_start == 3)
+        {
+            opts->warm_start = 1;
+            opts->hotstart = 2;
+        }
         else
         {
-            printf("\ndense_qp_qpoases: setting warm_start: supported values are: 0 - cold, 1 - warm, 2 - hot\n");
+            printf("\ndense_qp_qpoases: setting warm_start: supported values are: 0 - cold, 1 - warm, 2 - hot, 3 - hot if matrices unchanged\n");
             exit(1);
         }
     }
@@ -243,6 +248,8 @@ int dense_qp_qpoases_memory_calculate_size(void *config_, dense_qp_dims *dims, v
     size += 1 * nv2 * sizeof(double);          // prim_sol
     size += 1 * (nv2 + ng2) * sizeof(double);  // dual_sol
     size += 6 * ns * sizeof(double);           // Zl, Zu, zl, zu, d_ls, d_us
+    size += 1 * nv2 * nv2 * sizeof(double);    // H_prev
+    size += 1 * nv2 * ng2 * sizeof(double);    // C_prev
 
     if (ns > 0)
     {
@@ -255,6 +262,10 @@ int dense_qp_qpoases_memory_calculate_size(void *config_, dense_qp_dims *dims, v
     else  // QProblemB
         size += QProblemB_calculateMemorySize(nv);
 
+    // working set of the last call
+    size += Bounds_calculateMemorySize(nv2);
+    size += Constraints_calculateMemorySize(ng2);
+
     make_int_multiple_of(8, &size);
 
     return size;
@@ -326,6 +337,8 @@ void *dense_qp_qpoases_memory_assign(void *config_, dense_qp_dims *dims, void *o
     assign_and_advance_double(ns, &mem->zu, &c_ptr);
     assign_and_advance_double(nv2, &mem->prim_sol, &c_ptr);
     assign_and_advance_double(nv2 + ng2, &mem->dual_sol, &c_ptr);
+    assign_and_advance_double(nv2 * nv2, &mem->H_prev, &c_ptr);
+    assign_and_advance_double(nv2 * ng2, &mem->C_prev, &c_ptr);
 
     // TODO(dimitris): update assign syntax in qpOASES
     assert((size_t) c_ptr % 8 == 0 && "double not 8-byte aligned!");
@@ -341,6 +354,12 @@ void *dense_qp_qpoases_memory_assign(void *config_, dense_qp_dims *dims, void *o
         c_ptr += QProblemB_calculateMemorySize(nv);
     }
 
+    Bounds_assignMemory(nv2, (Bounds **) &(mem->guess_bounds), c_ptr);
+    c_ptr += Bounds_calculateMemorySize(nv2);
+
+    Constraints_assignMemory(ng2, (Constraints **) &(mem->guess_constraints), c_ptr);
+    c_ptr += Constraints_calculateMemorySize(ng2);
+
     assign_and_advance_int(nb, &mem->idxb, &c_ptr);
     assign_and_advance_int(nb2, &mem->idxb_stacked, &c_ptr);
     assign_and_advance_int(ns, &mem->idxs, &c_ptr);
@@ -350,6 +369,10 @@ void *dense_qp_qpoases_memory_assign(void *config_, dense_qp_dims *dims, void *o
 
     // assign default values to fields stored in the memory
     mem->first_it = 1;  // only used if hotstart (only constant data matrices) is enabled
+    mem->qp_init = 0;
+    mem->num_qp_init = 0;
+    mem->flops = 0.0;
+    mem->time_qp_interface = 0.0;
 
     return mem;
 }
@@ -371,6 +394,26 @@ void dense_qp_qpoases_memory_get(void *config_, void *mem_, const char *field, v
         int *tmp_ptr = value;
         *tmp_ptr = mem->iter;
     }
+    else if (!strcmp(field, "time_qp_interface"))
+    {
+        double *tmp_ptr = value;
+        *tmp_ptr = mem->time_qp_interface;
+    }
+    else if (!strcmp(field, "flops"))
+    {
+        double *tmp_ptr = value;
+        *tmp_ptr = mem->flops;
+    }
+    else if (!strcmp(field, "qp_init"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->qp_init;
+    }
+    else if (!strcmp(field, "num_qp_init"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->num_qp_init;
+    }
     else
     {
         printf("\nerror: dense_qp_qpoases_memory_get: field %s not available\n", field);
@@ -398,6 +441,107 @@ int dense_qp_qpoases_workspace_calculate_size(void *config_, dense_qp_dims *dims
  * functions
  ************************************************/
 
+// hotstart if H and C are the same as in the last initialization, otherwise initialize
+// qpOASES with the working set and the solution of the last call
+static int dense_qp_qpoases_hotstart_mat(dense_qp_qpoases_opts *opts,
+        dense_qp_qpoases_memory *memory, int nv, int ng, int use_qproblem, double *H, double *g,
+        double *C, double *d_lb, double *d_ub, double *d_lg, double *d_ug, int *nwsr,
+        double *cputime)
+{
+    QProblemB *QPB = memory->QPB;
+    QProblem *QP = memory->QP;
+    Bounds *guess_bounds = memory->guess_bounds;
+    Constraints *guess_constraints = memory->guess_constraints;
+
+    int qpoases_status;
+
+    int mat_changed = memory->first_it;
+    mat_changed = mat_changed || memcmp(H, memory->H_prev, nv * nv * sizeof(double));
+    mat_changed = mat_changed || memcmp(C, memory->C_prev, nv * ng * sizeof(double));
+
+    if (!mat_changed)
+    {
+        qpoases_status = use_qproblem ?
+            QProblem_hotstart(QP, g, d_lb, d_ub, d_lg, d_ug, nwsr, cputime) :
+            QProblemB_hotstart(QPB, g, d_lb, d_ub, nwsr, cputime);
+        memory->qp_init = 0;
+    }
+    else
+    {
+        int first_it = memory->first_it;
+
+        // the working set is overwritten by the constructor
+        if (!first_it)
+        {
+            if (use_qproblem)
+            {
+                QProblem_getBounds(QP, guess_bounds);
+                QProblem_getConstraints(QP, guess_constraints);
+            }
+            else
+            {
+                QProblemB_getBounds(QPB, guess_bounds);
+            }
+        }
+
+        static Options options;
+        Options_setToMPC(&options);
+        options.terminationTolerance = opts->tolerance;
+
+        if (use_qproblem)
+        {
+            QProblemCON(QP, nv, ng, HST_POSDEF);
+            QProblem_setPrintLevel(QP, PL_NONE);
+            if (opts->set_acado_opts)
+                QProblem_setOptions(QP, options);
+
+            qpoases_status = first_it ?
+                QProblem_init(QP, H, g, C, d_lb, d_ub, d_lg, d_ug, nwsr, cputime) :
+                QProblem_initW(QP, H, g, C, d_lb, d_ub, d_lg, d_ug, nwsr, cputime,
+                               memory->prim_sol, memory->dual_sol, guess_bounds,
+                               guess_constraints, /* R */ NULL);
+        }
+        else
+        {
+            QProblemBCON(QPB, nv, HST_POSDEF);
+            QProblemB_setPrintLevel(QPB, PL_NONE);
+            if (opts->set_acado_opts)
+                QProblemB_setOptions(QPB, options);
+
+            qpoases_status = first_it ?
+                QProblemB_init(QPB, H, g, d_lb, d_ub, nwsr, cputime) :
+                QProblemB_initW(QPB, H, g, d_lb, d_ub, nwsr, cputime, memory->prim_sol,
+                                memory->dual_sol, guess_bounds, /* R */ NULL);
+        }
+
+        memcpy(memory->H_prev, H, nv * nv * sizeof(double));
+        memcpy(memory->C_prev, C, nv * ng * sizeof(double));
+        memory->first_it = 0;
+        memory->qp_init = 1;
+        memory->num_qp_init++;
+    }
+
+    if (use_qproblem)
+    {
+        QProblem_getPrimalSolution(QP, memory->prim_sol);
+        QProblem_getDualSolution(QP, memory->dual_sol);
+    }
+    else
+    {
+        QProblemB_getPrimalSolution(QPB, memory->prim_sol);
+        QProblemB_getDualSolution(QPB, memory->dual_sol);
+    }
+
+    // factorization of H on initialization, working set changes are quadratic
+    memory->flops = 2.0 * (*nwsr) * nv * (nv + ng);
+    if (memory->qp_init)
+        memory->flops += nv * nv * nv / 3.0 + nv * nv * ng;
+
+    return qpoases_status;
+}
+
+
+
 int dense_qp_qpoases(void *config_, dense_qp_in *qp_in, dense_qp_out *qp_out, void *opts_,
                      void *memory_, void *work_)
 {
@@ -509,7 +653,15 @@ int dense_qp_qpoases(void *config_, dense_qp_in *qp_in, dense_qp_out *qp_out, vo
     double cputime = opts->max_cputime;
 
     int qpoases_status = 0;
-    if (opts->hotstart == 1)
+    if (opts->hotstart == 2)
+    {
+        qpoases_status = (ns > 0) ?
+            dense_qp_qpoases_hotstart_mat(opts, memory, nv2, ng2, 1, HH, gg, CC, d_lb, d_ub,
+                                          d_lg, d_ug, &nwsr, &cputime) :
+            dense_qp_qpoases_hotstart_mat(opts, memory, nv, ng, ng > 0, H, g, C, d_lb, d_ub,
+                                          d_lg0, d_ug0, &nwsr, &cputime);
+    }
+    else if (opts->hotstart == 1)
     {  // only to be used with fixed data matrices!
         if (ng > 0 || ns > 0)
         {  // QProblem
@@ -741,6 +893,7 @@ int dense_qp_qpoases(void *config_, dense_qp_in *qp_in, dense_qp_out *qp_out, vo
     info->num_iter = nwsr;
 
     memory->time_qp_solver_call = info->solve_QP_time;
+    memory->time_qp_interface = info->interface_time;
     memory->iter = nwsr;
 
     // compute slacks
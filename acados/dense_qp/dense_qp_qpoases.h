@@ -52,8 +52,10 @@ typedef struct dense_qp_qpoases_opts_
     int max_nwsr;        // maximum number of working set recalculations
     int warm_start;      // warm start with dual_sol in memory
     int use_precomputed_cholesky;
-    int hotstart;  // this option requires constant data matrices! (eg linear MPC, inexact schemes
+    int hotstart;  // 1: this option requires constant data matrices! (eg linear MPC, inexact schemes
                    // with frozen sensitivities)
+                   // 2: hotstart if the matrices did not change, otherwise initialize from the
+                   // previous working set
     int set_acado_opts;  // use same options as in acado code generation
     int compute_t;       // compute t in qp_out (to have correct residuals in NLP)
     double tolerance;  // terminationTolerance
@@ -91,11 +93,19 @@ typedef struct dense_qp_qpoases_memory_
     double *dual_sol;
     void *QPB;       // NOTE(giaf): cast to QProblemB to use
     void *QP;        // NOTE(giaf): cast to QProblem to use
+    double *H_prev;  // matrices of the last initialization, hotstart = 2
+    double *C_prev;
+    void *guess_bounds;       // NOTE: cast to Bounds to use, working set of the last call
+    void *guess_constraints;  // NOTE: cast to Constraints to use
     double cputime;  // cputime of qpoases
     int nwsr;        // performed number of working set recalculations
     int first_it;    // to be used with hotstart
     dense_qp_in *qp_stacked;
     double time_qp_solver_call; // equal to cputime
+    double time_qp_interface;   // time to extract the data from qp_in and to write qp_out
+    double flops;    // estimated flops of the last call with hotstart = 2
+    int qp_init;     // the last call initialized qpOASES (factorization of H), 0 if hotstart
+    int num_qp_init; // number of initializations
     int iter;
 
 } dense_qp_qpoases_memory;
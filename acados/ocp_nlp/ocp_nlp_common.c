@@ -41,8 +41,10 @@
 
 // blasfeo
 #include "blasfeo/include/blasfeo_common.h"
+#include "blasfeo/include/blasfeo_d_aux.h"
 #include "blasfeo/include/blasfeo_d_blas.h"
 // hpipm
+#include "hpipm/include/hpipm_d_ocp_qp.h"
 #include "hpipm/include/hpipm_d_ocp_qp_dim.h"
 // acados
 #include "acados/utils/mem.h"
@@ -587,7 +589,8 @@ void ocp_nlp_dims_set_constraints(void *config_, void *dims_, int stage, const c
         // qp solver
         config->qp_solver->dims_set(config->qp_solver, dims->qp_solver, i, field, int_value);
     }
-    else if ( (!strcmp(field, "ng")) || (!strcmp(field, "nh")) || (!strcmp(field, "nphi")))
+    else if ( (!strcmp(field, "ng")) || (!strcmp(field, "nh")) || (!strcmp(field, "nphi"))
+              || (!strcmp(field, "nbxd")) )
     {
         // update ng_qp_solver in qp_solver
         int ng_qp_solver;
@@ -729,6 +732,8 @@ ocp_nlp_in *ocp_nlp_in_assign_self(int N, void *raw_memory)
     ocp_nlp_in *in = (ocp_nlp_in *) c_ptr;
     c_ptr += sizeof(ocp_nlp_in);
 
+    in->worker = NULL;
+
     // Ts
     assign_and_advance_double(N, &in->Ts, &c_ptr);
 
@@ -857,6 +862,8 @@ ocp_nlp_out *ocp_nlp_out_assign(ocp_nlp_config *config, ocp_nlp_dims *dims, void
     ocp_nlp_out *out = (ocp_nlp_out *) c_ptr;
     c_ptr += sizeof(ocp_nlp_out);
 
+    out->worker = NULL;
+
     // blasfeo_struct align
     align_char_to(8, &c_ptr);
 
@@ -1059,14 +1066,26 @@ void ocp_nlp_opts_initialize_default(void *config_, void *dims_, void *opts_)
     int N = dims->N;
 
     opts->reuse_workspace = 1;
-#if defined(ACADOS_WITH_OPENMP)
+#if defined(ACADOS_NUM_THREADS)
     opts->num_threads = ACADOS_NUM_THREADS;
+#else
+    opts->num_threads = 1;
 #endif
+    opts->thread_schedule = ACADOS_SCHEDULE_LPT;
+    opts->thread_spin = 10000;
+    for (ii = 0; ii < ACADOS_MAX_THREADS; ii++)
+        opts->thread_affinity[ii] = -1;
 
     opts->globalization = FIXED_STEP;
     opts->step_length = 1.0;
     opts->levenberg_marquardt = 0.0;
 
+    opts->alpha_min = 0.05;
+    opts->alpha_reduction = 0.7;
+    opts->eps_sufficient_descent = 1e-4;
+    opts->line_search_use_sufficient_descent = 1;
+    opts->globalization_use_SOC = 0;
+
 
     /* submodules opts */
     // qp solver
@@ -1176,8 +1195,48 @@ void ocp_nlp_opts_set(void *config_, void *opts_, const char *field, void* value
         else if (!strcmp(field, "num_threads"))
         {
             int* num_threads = (int *) value;
+            if (*num_threads < 1 || *num_threads > ACADOS_MAX_THREADS)
+            {
+                printf("\nerror: ocp_nlp_opts_set: num_threads must be in [1, %d], got %d.\n",
+                       ACADOS_MAX_THREADS, *num_threads);
+                exit(1);
+            }
             opts->num_threads = *num_threads;
         }
+        else if (!strcmp(field, "thread_schedule"))
+        {
+            char* thread_schedule = (char *) value;
+            if (!strcmp(thread_schedule, "static"))
+            {
+                opts->thread_schedule = ACADOS_SCHEDULE_STATIC;
+            }
+            else if (!strcmp(thread_schedule, "lpt"))
+            {
+                opts->thread_schedule = ACADOS_SCHEDULE_LPT;
+            }
+            else if (!strcmp(thread_schedule, "dynamic"))
+            {
+                opts->thread_schedule = ACADOS_SCHEDULE_DYNAMIC;
+            }
+            else
+            {
+                printf("\nerror: ocp_nlp_opts_set: not supported value for thread_schedule, got: %s\n",
+                       thread_schedule);
+                exit(1);
+            }
+        }
+        else if (!strcmp(field, "thread_spin"))
+        {
+            int* thread_spin = (int *) value;
+            opts->thread_spin = *thread_spin;
+        }
+        else if (!strcmp(field, "thread_affinity"))
+        {
+            // one core per thread, the first entry (the calling thread) is ignored
+            int* thread_affinity = (int *) value;
+            for (ii = 0; ii < opts->num_threads; ii++)
+                opts->thread_affinity[ii] = thread_affinity[ii];
+        }
         else if (!strcmp(field, "step_length"))
         {
             double* step_length = (double *) value;
@@ -1194,6 +1253,10 @@ void ocp_nlp_opts_set(void *config_, void *opts_, const char *field, void* value
             {
                 opts->globalization = MERIT_BACKTRACKING;
             }
+            else if (!strcmp(globalization, "filter_line_search"))
+            {
+                opts->globalization = FILTER_LINE_SEARCH;
+            }
             else
             {
                 printf("\nerror: ocp_nlp_opts_set: not supported value for globalization, got: %s\n",
@@ -1206,6 +1269,37 @@ void ocp_nlp_opts_set(void *config_, void *opts_, const char *field, void* value
             double* levenberg_marquardt = (double *) value;
             opts->levenberg_marquardt = *levenberg_marquardt;
         }
+        else if (!strcmp(field, "alpha_min"))
+        {
+            double* alpha_min = (double *) value;
+            opts->alpha_min = *alpha_min;
+        }
+        else if (!strcmp(field, "alpha_reduction"))
+        {
+            double* alpha_reduction = (double *) value;
+            if (*alpha_reduction <= 0.0 || *alpha_reduction >= 1.0)
+            {
+                printf("\nerror: ocp_nlp_opts_set: alpha_reduction has to be in (0, 1), got %e\n",
+                       *alpha_reduction);
+                exit(1);
+            }
+            opts->alpha_reduction = *alpha_reduction;
+        }
+        else if (!strcmp(field, "eps_sufficient_descent"))
+        {
+            double* eps_sufficient_descent = (double *) value;
+            opts->eps_sufficient_descent = *eps_sufficient_descent;
+        }
+        else if (!strcmp(field, "line_search_use_sufficient_descent"))
+        {
+            int* line_search_use_sufficient_descent = (int *) value;
+            opts->line_search_use_sufficient_descent = *line_search_use_sufficient_descent;
+        }
+        else if (!strcmp(field, "globalization_use_SOC"))
+        {
+            int* globalization_use_SOC = (int *) value;
+            opts->globalization_use_SOC = *globalization_use_SOC;
+        }
         else if (!strcmp(field, "exact_hess"))
         {
             int N = config->N;
@@ -1311,6 +1405,17 @@ void ocp_nlp_opts_set_at_stage(void *config_, void *opts_, int stage, const char
  * memory
  ************************************************/
 
+// number of dense output points of the integrator at stage ii, zero at the terminal stage
+static int ocp_nlp_n_dense(ocp_nlp_config *config, ocp_nlp_dims *dims, int ii)
+{
+    int n_dense = 0;
+    if (ii < dims->N)
+        config->dynamics[ii]->dims_get(config->dynamics[ii], dims->dynamics[ii], "n_dense", &n_dense);
+    return n_dense;
+}
+
+
+
 int ocp_nlp_memory_calculate_size(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_opts *opts)
 {
     ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
@@ -1363,14 +1468,18 @@ int ocp_nlp_memory_calculate_size(ocp_nlp_config *config, ocp_nlp_dims *dims, oc
 
     size += (N+1)*sizeof(bool); // set_sim_guess
 
-    size += (N+1)*sizeof(struct blasfeo_dmat); // dzduxt
-    size += 6*(N+1)*sizeof(struct blasfeo_dvec);  // cost_grad ineq_fun ineq_adj dyn_adj sim_guess z_alg
+    size += 2*(N+1)*sizeof(struct blasfeo_dmat); // dzduxt dxdenseduxt
+    size += 7*(N+1)*sizeof(struct blasfeo_dvec);  // cost_grad ineq_fun ineq_adj dyn_adj sim_guess z_alg x_dense
     size += 1*N*sizeof(struct blasfeo_dvec);        // dyn_fun
 
+    int n_dense;
     for (int ii = 0; ii < N; ii++)
     {
+        n_dense = ocp_nlp_n_dense(config, dims, ii);
         size += 1*blasfeo_memsize_dmat(nu[ii]+nx[ii], nz[ii]); // dzduxt
         size += 1*blasfeo_memsize_dvec(nz[ii]); // z_alg
+        size += 1*blasfeo_memsize_dmat(nu[ii]+nx[ii], n_dense*nx[ii]); // dxdenseduxt
+        size += 1*blasfeo_memsize_dvec(n_dense*nx[ii]); // x_dense
         size += 2*blasfeo_memsize_dvec(nv[ii]);           // cost_grad ineq_adj
         size += 1*blasfeo_memsize_dvec(nu[ii] + nx[ii]);  // dyn_adj
         size += 1*blasfeo_memsize_dvec(nx[ii + 1]);       // dyn_fun
@@ -1384,6 +1493,11 @@ int ocp_nlp_memory_calculate_size(ocp_nlp_config *config, ocp_nlp_dims *dims, oc
     size += 1*blasfeo_memsize_dvec(2 * ni[N]);      // ineq_fun
     size += 1*blasfeo_memsize_dvec(nx[N] + nz[N]);  // sim_guess
 
+    // thread pool
+    size += acados_thread_pool_calculate_size(opts->num_threads, N+1);
+    size += 2*(N+1)*sizeof(double);  // stage_time_lin stage_time_fun
+    size += 8;  // stage times align
+
     size += 8;   // initial align
     size += 8;   // middle align
     size += 8;   // blasfeo_struct align
@@ -1478,6 +1592,22 @@ ocp_nlp_memory *ocp_nlp_memory_assign(ocp_nlp_config *config, ocp_nlp_dims *dims
                                                                  opts->constraints[ii]);
     }
 
+    // thread pool
+    mem->pool = acados_thread_pool_assign(opts->num_threads, N+1, c_ptr);
+    c_ptr += acados_thread_pool_calculate_size(opts->num_threads, N+1);
+    acados_thread_pool_configure(mem->pool, opts->thread_schedule, opts->thread_spin,
+                                 opts->thread_affinity);
+
+    // stage times
+    align_char_to(8, &c_ptr);
+    assign_and_advance_double(N+1, &mem->stage_time_lin, &c_ptr);
+    assign_and_advance_double(N+1, &mem->stage_time_fun, &c_ptr);
+    for (int ii = 0; ii <= N; ii++)
+    {
+        mem->stage_time_lin[ii] = 0.0;
+        mem->stage_time_fun[ii] = 0.0;
+    }
+
 
 
     // blasfeo_struct align
@@ -1488,6 +1618,10 @@ ocp_nlp_memory *ocp_nlp_memory_assign(ocp_nlp_config *config, ocp_nlp_dims *dims
 
     // z_alg
     assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->z_alg, &c_ptr);
+    // dxdenseduxt
+    assign_and_advance_blasfeo_dmat_structs(N + 1, &mem->dxdenseduxt, &c_ptr);
+    // x_dense
+    assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->x_dense, &c_ptr);
     // cost_grad
     assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->cost_grad, &c_ptr);
     // ineq_fun
@@ -1516,12 +1650,24 @@ ocp_nlp_memory *ocp_nlp_memory_assign(ocp_nlp_config *config, ocp_nlp_dims *dims
     {
         assign_and_advance_blasfeo_dmat_mem(nu[ii]+nx[ii], nz[ii], mem->dzduxt+ii, &c_ptr);
     }
+    // dxdenseduxt
+    for (int ii=0; ii<=N; ii++)
+    {
+        assign_and_advance_blasfeo_dmat_mem(nu[ii]+nx[ii], ocp_nlp_n_dense(config, dims, ii)*nx[ii],
+                                            mem->dxdenseduxt+ii, &c_ptr);
+    }
     // z_alg
     for (int ii=0; ii<=N; ii++)
     {
         blasfeo_create_dvec(nz[ii], mem->z_alg+ii, c_ptr);
         c_ptr += blasfeo_memsize_dvec(nz[ii]);
     }
+    // x_dense
+    for (int ii=0; ii<=N; ii++)
+    {
+        assign_and_advance_blasfeo_dvec_mem(ocp_nlp_n_dense(config, dims, ii)*nx[ii], mem->x_dense+ii,
+                                            &c_ptr);
+    }
 
     // cost_grad
     for (int ii = 0; ii <= N; ii++)
@@ -1563,10 +1709,29 @@ ocp_nlp_memory *ocp_nlp_memory_assign(ocp_nlp_config *config, ocp_nlp_dims *dims
 
 
 
+void ocp_nlp_memory_terminate(ocp_nlp_memory *mem)
+{
+    acados_thread_pool_stop(mem->pool);
+}
+
+
+
 /************************************************
  * workspace
  ************************************************/
 
+// the modules share one workspace only if they are evaluated one after the other
+static int ocp_nlp_shared_workspace(ocp_nlp_opts *opts)
+{
+#if defined(ACADOS_WITH_OPENMP)
+    return 0;
+#else
+    return opts->reuse_workspace && opts->num_threads == 1;
+#endif
+}
+
+
+
 int ocp_nlp_workspace_calculate_size(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_opts *opts)
 {
     ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
@@ -1594,6 +1759,18 @@ int ocp_nlp_workspace_calculate_size(ocp_nlp_config *config, ocp_nlp_dims *dims,
     // weight_merit_fun
     size += ocp_nlp_out_calculate_size(config, dims);
 
+    // tmp_qp_out
+    size += ocp_qp_out_calculate_size(dims->qp_solver->orig_dims);
+
+    // tmp_b tmp_d
+    size += N*sizeof(struct blasfeo_dvec) + (N+1)*sizeof(struct blasfeo_dvec);
+    for (ii = 0; ii < N; ii++)
+        size += blasfeo_memsize_dvec(dims->nx[ii+1]);
+    for (ii = 0; ii <= N; ii++)
+        size += blasfeo_memsize_dvec(2*dims->ni[ii]);
+    size += 8;  // blasfeo_struct align
+    size += 64;  // blasfeo_mem align
+
     // array of pointers
     // cost
     size += (N+1)*sizeof(void *);
@@ -1602,36 +1779,10 @@ int ocp_nlp_workspace_calculate_size(ocp_nlp_config *config, ocp_nlp_dims *dims,
     // constraints
     size += (N+1)*sizeof(void *);
 
-    // module workspace
-    if (opts->reuse_workspace)
+    // module workspace, shared between the modules unless the stages run in parallel
+    if (ocp_nlp_shared_workspace(opts))
     {
 
-#if defined(ACADOS_WITH_OPENMP)
-
-        // qp solver
-        size += qp_solver->workspace_calculate_size(qp_solver, dims->qp_solver,
-            opts->qp_solver_opts);
-
-        // dynamics
-        for (ii = 0; ii < N; ii++)
-        {
-            size += dynamics[ii]->workspace_calculate_size(dynamics[ii], dims->dynamics[ii], opts->dynamics[ii]);
-        }
-
-        // cost
-        for (ii = 0; ii <= N; ii++)
-        {
-            size += cost[ii]->workspace_calculate_size(cost[ii], dims->cost[ii], opts->cost[ii]);
-        }
-
-        // constraints
-        for (ii = 0; ii <= N; ii++)
-        {
-            size += constraints[ii]->workspace_calculate_size(constraints[ii], dims->constraints[ii], opts->constraints[ii]);
-        }
-
-#else
-
         // qp solver
         tmp = qp_solver->workspace_calculate_size(qp_solver, dims->qp_solver, opts->qp_solver_opts);
         size_tmp = tmp > size_tmp ? tmp : size_tmp;
@@ -1659,8 +1810,6 @@ int ocp_nlp_workspace_calculate_size(ocp_nlp_config *config, ocp_nlp_dims *dims,
 
         size += size_tmp;
 
-#endif
-
     }
     else
     {
@@ -1735,37 +1884,30 @@ ocp_nlp_workspace *ocp_nlp_workspace_assign(ocp_nlp_config *config, ocp_nlp_dims
     work->weight_merit_fun = ocp_nlp_out_assign(config, dims, c_ptr);
     c_ptr += ocp_nlp_out_calculate_size(config, dims);
 
-    if (opts->reuse_workspace)
-    {
-
-#if defined(ACADOS_WITH_OPENMP)
+    // tmp_qp_out
+    work->tmp_qp_out = ocp_qp_out_assign(dims->qp_solver->orig_dims, c_ptr);
+    c_ptr += ocp_qp_out_calculate_size(dims->qp_solver->orig_dims);
 
-        // qp solver
-        work->qp_work = (void *) c_ptr;
-        c_ptr += qp_solver->workspace_calculate_size(qp_solver, dims->qp_solver, opts->qp_solver_opts);
+    // blasfeo_struct align
+    align_char_to(8, &c_ptr);
 
-        // dynamics
-        for (int ii = 0; ii < N; ii++)
-        {
-            work->dynamics[ii] = c_ptr;
-            c_ptr += dynamics[ii]->workspace_calculate_size(dynamics[ii], dims->dynamics[ii], opts->dynamics[ii]);
-        }
+    // tmp_b
+    assign_and_advance_blasfeo_dvec_structs(N, &work->tmp_b, &c_ptr);
+    // tmp_d
+    assign_and_advance_blasfeo_dvec_structs(N + 1, &work->tmp_d, &c_ptr);
 
-        // cost
-        for (int ii = 0; ii <= N; ii++)
-        {
-            work->cost[ii] = c_ptr;
-            c_ptr += cost[ii]->workspace_calculate_size(cost[ii], dims->cost[ii], opts->cost[ii]);
-        }
+    // blasfeo_mem align
+    align_char_to(64, &c_ptr);
 
-        // constraints
-        for (int ii = 0; ii <= N; ii++)
-        {
-            work->constraints[ii] = c_ptr;
-            c_ptr += constraints[ii]->workspace_calculate_size(constraints[ii], dims->constraints[ii], opts->constraints[ii]);
-        }
+    // tmp_b
+    for (int ii = 0; ii < N; ii++)
+        assign_and_advance_blasfeo_dvec_mem(dims->nx[ii+1], work->tmp_b + ii, &c_ptr);
+    // tmp_d
+    for (int ii = 0; ii <= N; ii++)
+        assign_and_advance_blasfeo_dvec_mem(2*dims->ni[ii], work->tmp_d + ii, &c_ptr);
 
-#else
+    if (ocp_nlp_shared_workspace(opts))
+    {
 
         int size_tmp = 0;
         int tmp;
@@ -1801,8 +1943,6 @@ ocp_nlp_workspace *ocp_nlp_workspace_assign(ocp_nlp_config *config, ocp_nlp_dims
 
         c_ptr += size_tmp;
 
-#endif
-
     }
     else
     {
@@ -1846,229 +1986,300 @@ ocp_nlp_workspace *ocp_nlp_workspace_assign(ocp_nlp_config *config, ocp_nlp_dims
  * functions
  ************************************************/
 
-void ocp_nlp_initialize_qp(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
-         ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work)
+// arguments of the stage-wise loops executed by the thread pool
+typedef struct
 {
+    ocp_nlp_config *config;
+    ocp_nlp_dims *dims;
+    ocp_nlp_in *in;
+    ocp_nlp_out *out;
+    ocp_nlp_opts *opts;
+    ocp_nlp_memory *mem;
+    ocp_nlp_workspace *work;
+    ocp_nlp_res *res;
+    double alpha;
+} ocp_nlp_stage_args;
 
-    int ii;
 
-    int N = dims->N;
 
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp parallel for
-#endif
-    for (ii = 0; ii <= N; ii++)
-    {
-        // cost
-        config->cost[ii]->initialize(config->cost[ii], dims->cost[ii], in->cost[ii],
-                opts->cost[ii], mem->cost[ii], work->cost[ii]);
-        // dynamics
-        if (ii < N)
-            config->dynamics[ii]->initialize(config->dynamics[ii], dims->dynamics[ii],
-                    in->dynamics[ii], opts->dynamics[ii], mem->dynamics[ii], work->dynamics[ii]);
-        // constraints
-        config->constraints[ii]->initialize(config->constraints[ii], dims->constraints[ii],
-                in->constraints[ii], opts->constraints[ii], mem->constraints[ii], work->constraints[ii]);
-    }
+static void ocp_nlp_initialize_qp_stage(void *args_, int ii)
+{
+    ocp_nlp_stage_args *args = args_;
+    ocp_nlp_config *config = args->config;
+    ocp_nlp_dims *dims = args->dims;
+    ocp_nlp_in *in = args->in;
+    ocp_nlp_opts *opts = args->opts;
+    ocp_nlp_memory *mem = args->mem;
+    ocp_nlp_workspace *work = args->work;
 
-    return;
+    int N = dims->N;
+
+    // cost
+    config->cost[ii]->initialize(config->cost[ii], dims->cost[ii], in->cost[ii],
+            opts->cost[ii], mem->cost[ii], work->cost[ii]);
+    // dynamics
+    if (ii < N)
+        config->dynamics[ii]->initialize(config->dynamics[ii], dims->dynamics[ii],
+                in->dynamics[ii], opts->dynamics[ii], mem->dynamics[ii], work->dynamics[ii]);
+    // constraints
+    config->constraints[ii]->initialize(config->constraints[ii], dims->constraints[ii],
+            in->constraints[ii], opts->constraints[ii], mem->constraints[ii], work->constraints[ii]);
 }
 
 
-void ocp_nlp_initialize_t_slacks(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+
+void ocp_nlp_initialize_qp(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
          ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work)
 {
-    int ii;
-    struct blasfeo_dvec *ineq_fun;
-    int N = dims->N;
-    int *ni = dims->ni;
-    int *ns = dims->ns;
-    int *nx = dims->nx;
-    int *nu = dims->nu;
-
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp parallel for
-#endif
-    for (ii = 0; ii <= N; ii++)
-    {
-        // copy out->ux to tmp_nlp_out->ux, since this is used in compute_fun
-        blasfeo_dveccp(nx[ii]+nu[ii]+2*ns[ii], out->ux+ii, 0, work->tmp_nlp_out->ux+ii, 0);
+    ocp_nlp_stage_args args = {config, dims, in, out, opts, mem, work, NULL, 0.0};
 
-        // evaluate inequalities
-        config->constraints[ii]->compute_fun(config->constraints[ii], dims->constraints[ii],
-                                             in->constraints[ii], opts->constraints[ii],
-                                             mem->constraints[ii], work->constraints[ii]);
-        ineq_fun = config->constraints[ii]->memory_get_fun_ptr(mem->constraints[ii]);
-        // t = -ineq_fun
-        blasfeo_dveccpsc(2 * ni[ii], -1.0, ineq_fun, 0, out->t + ii, 0);
-    }
+    acados_thread_pool_parallel_for(mem->pool, dims->N+1, &ocp_nlp_initialize_qp_stage, &args);
 
     return;
 }
 
 
 
-void ocp_nlp_approximate_qp_matrices(ocp_nlp_config *config, ocp_nlp_dims *dims,
-    ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem,
-    ocp_nlp_workspace *work)
+static void ocp_nlp_initialize_t_slacks_stage(void *args_, int ii)
 {
+    ocp_nlp_stage_args *args = args_;
+    ocp_nlp_config *config = args->config;
+    ocp_nlp_dims *dims = args->dims;
+    ocp_nlp_in *in = args->in;
+    ocp_nlp_out *out = args->out;
+    ocp_nlp_opts *opts = args->opts;
+    ocp_nlp_memory *mem = args->mem;
+    ocp_nlp_workspace *work = args->work;
 
-    int i;
-
-    int N = dims->N;
-    int *nv = dims->nv;
-    int *nx = dims->nx;
-    int *nu = dims->nu;
+    struct blasfeo_dvec *ineq_fun;
     int *ni = dims->ni;
 
-    /* stage-wise multiple shooting lagrangian evaluation */
-
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp parallel for
-#endif
-    for (i = 0; i <= N; i++)
+    // the constraints on the dense output read x_dense, which is computed by the dynamics
+    if (ocp_nlp_n_dense(config, dims, ii) > 0)
     {
-        // init Hessian to 0 
-        blasfeo_dgese(nu[i] + nx[i], nu[i] + nx[i], 0.0, mem->qp_in->RSQrq+i, 0, 0);
+        config->dynamics[ii]->compute_fun(config->dynamics[ii], dims->dynamics[ii],
+                                          in->dynamics[ii], opts->dynamics[ii],
+                                          mem->dynamics[ii], work->dynamics[ii]);
+    }
 
+    // evaluate inequalities
+    config->constraints[ii]->compute_fun(config->constraints[ii], dims->constraints[ii],
+                                         in->constraints[ii], opts->constraints[ii],
+                                         mem->constraints[ii], work->constraints[ii]);
+    ineq_fun = config->constraints[ii]->memory_get_fun_ptr(mem->constraints[ii]);
+    // t = -ineq_fun
+    blasfeo_dveccpsc(2 * ni[ii], -1.0, ineq_fun, 0, out->t + ii, 0);
+}
 
-        if (i < N)
-        {
-            // Levenberg Marquardt term: Ts[i] * levenberg_marquardt * eye()
-            if (opts->levenberg_marquardt > 0.0)
-                blasfeo_ddiare(nu[i] + nx[i], in->Ts[i] * opts->levenberg_marquardt,
-                               mem->qp_in->RSQrq+i, 0, 0);
 
-            // dynamics
-            config->dynamics[i]->update_qp_matrices(config->dynamics[i], dims->dynamics[i],
-                    in->dynamics[i], opts->dynamics[i], mem->dynamics[i], work->dynamics[i]);
-        }
-        else
-        {
-            // Levenberg Marquardt term: 1.0 * levenberg_marquardt * eye()
-            if (opts->levenberg_marquardt > 0.0)
-                blasfeo_ddiare(nu[i] + nx[i], opts->levenberg_marquardt,
-                               mem->qp_in->RSQrq+i, 0, 0);
-        }
+void ocp_nlp_initialize_t_slacks(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+         ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work)
+{
+    ocp_nlp_stage_args args = {config, dims, in, out, opts, mem, work, NULL, 0.0};
 
-        // cost
-        config->cost[i]->update_qp_matrices(config->cost[i], dims->cost[i], in->cost[i],
-                opts->cost[i], mem->cost[i], work->cost[i]);
+    int *nv = dims->nv;
 
-        // constraints
-        config->constraints[i]->update_qp_matrices(config->constraints[i], dims->constraints[i],
-                in->constraints[i], opts->constraints[i], mem->constraints[i], work->constraints[i]);
-    }
+    // copy out->ux to tmp_nlp_out->ux, since this is used in compute_fun;
+    // before the stage loop, as the dynamics of stage i also read stage i+1
+    for (int ii = 0; ii <= dims->N; ii++)
+        blasfeo_dveccp(nv[ii], out->ux+ii, 0, work->tmp_nlp_out->ux+ii, 0);
 
-    /* collect stage-wise evaluations */
+    acados_thread_pool_parallel_for(mem->pool, dims->N+1, &ocp_nlp_initialize_t_slacks_stage,
+                                    &args);
 
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp parallel for
-#endif
-    for (i=0; i <= N; i++)
-    {
+    return;
+}
 
-        // nlp mem: cost_grad
-        struct blasfeo_dvec *cost_grad = config->cost[i]->memory_get_grad_ptr(mem->cost[i]);
-        blasfeo_dveccp(nv[i], cost_grad, 0, mem->cost_grad + i, 0);
 
-        // nlp mem: dyn_fun
-        if (i < N)
-        {
-            struct blasfeo_dvec *dyn_fun
-                = config->dynamics[i]->memory_get_fun_ptr(mem->dynamics[i]);
-            blasfeo_dveccp(nx[i + 1], dyn_fun, 0, mem->dyn_fun + i, 0);
-        }
 
-        // nlp mem: dyn_adj
-        if (i < N)
-        {
-            struct blasfeo_dvec *dyn_adj
-                = config->dynamics[i]->memory_get_adj_ptr(mem->dynamics[i]);
-            blasfeo_dveccp(nu[i] + nx[i], dyn_adj, 0, mem->dyn_adj + i, 0);
-        }
-        else
-        {
-            blasfeo_dvecse(nu[N] + nx[N], 0.0, mem->dyn_adj + N, 0);
-        }
-        if (i > 0)
-        {
-            struct blasfeo_dvec *dyn_adj
-                = config->dynamics[i-1]->memory_get_adj_ptr(mem->dynamics[i-1]);
-            blasfeo_daxpy(nx[i], 1.0, dyn_adj, nu[i-1]+nx[i-1], mem->dyn_adj+i, nu[i],
-                mem->dyn_adj+i, nu[i]);
-        }
+// stage-wise multiple shooting lagrangian evaluation
+static void ocp_nlp_approximate_qp_matrices_stage(void *args_, int i)
+{
+    ocp_nlp_stage_args *args = args_;
+    ocp_nlp_config *config = args->config;
+    ocp_nlp_dims *dims = args->dims;
+    ocp_nlp_in *in = args->in;
+    ocp_nlp_opts *opts = args->opts;
+    ocp_nlp_memory *mem = args->mem;
+    ocp_nlp_workspace *work = args->work;
+
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
 
-        // nlp mem: ineq_fun
-        struct blasfeo_dvec *ineq_fun =
-            config->constraints[i]->memory_get_fun_ptr(mem->constraints[i]);
-        blasfeo_dveccp(2 * ni[i], ineq_fun, 0, mem->ineq_fun + i, 0);
+    // init Hessian to 0 
+    blasfeo_dgese(nu[i] + nx[i], nu[i] + nx[i], 0.0, mem->qp_in->RSQrq+i, 0, 0);
 
-        // nlp mem: ineq_adj
-        struct blasfeo_dvec *ineq_adj =
-            config->constraints[i]->memory_get_adj_ptr(mem->constraints[i]);
-        blasfeo_dveccp(nv[i], ineq_adj, 0, mem->ineq_adj + i, 0);
 
-    }
+    if (i < N)
+    {
+        // Levenberg Marquardt term: Ts[i] * levenberg_marquardt * eye()
+        if (opts->levenberg_marquardt > 0.0)
+            blasfeo_ddiare(nu[i] + nx[i], in->Ts[i] * opts->levenberg_marquardt,
+                           mem->qp_in->RSQrq+i, 0, 0);
 
-    for (i = 0; i <= N; i++)
+        // dynamics
+        config->dynamics[i]->update_qp_matrices(config->dynamics[i], dims->dynamics[i],
+                in->dynamics[i], opts->dynamics[i], mem->dynamics[i], work->dynamics[i]);
+    }
+    else
     {
-        // TODO(rien) where should the update happen??? move to qp update ???
-        // TODO(all): fix and move where appropriate
-        //  if (i<N)
-        //  {
-        //   ocp_nlp_dynamics_opts *dynamics_opts = opts->dynamics[i];
-        //   sim_opts *opts = dynamics_opts->sim_solver;
-        //   if (opts->scheme != NULL && opts->scheme->type != exact)
-        //   {
-        //    for (int_t j = 0; j < nx; j++)
-        //     BLASFEO_DVECEL(nlp_mem->cost_grad+i, nu+j) += work->sim_out[i]->grad[j];
-        //    for (int_t j = 0; j < nu; j++)
-        //     BLASFEO_DVECEL(nlp_mem->cost_grad+i, j) += work->sim_out[i]->grad[nx+j];
-        //   }
-        //  }
+        // Levenberg Marquardt term: 1.0 * levenberg_marquardt * eye()
+        if (opts->levenberg_marquardt > 0.0)
+            blasfeo_ddiare(nu[i] + nx[i], opts->levenberg_marquardt,
+                           mem->qp_in->RSQrq+i, 0, 0);
     }
 
-    return;
+    // cost
+    config->cost[i]->update_qp_matrices(config->cost[i], dims->cost[i], in->cost[i],
+            opts->cost[i], mem->cost[i], work->cost[i]);
+
+    // constraints
+    config->constraints[i]->update_qp_matrices(config->constraints[i], dims->constraints[i],
+            in->constraints[i], opts->constraints[i], mem->constraints[i], work->constraints[i]);
+
+    // the qp matrices of this stage changed
+    config->qp_solver->memory_set(config->qp_solver, mem->qp_solver_mem, "mat_dirty", &i);
 }
 
 
 
-// update QP rhs for SQP (step prim var, abs dual var)
-// TODO(all): move in dynamics, cost, constraints modules ???
-void ocp_nlp_approximate_qp_vectors_sqp(ocp_nlp_config *config,
-    ocp_nlp_dims *dims, ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts,
-    ocp_nlp_memory *mem, ocp_nlp_workspace *work)
+// collect stage-wise evaluations
+static void ocp_nlp_collect_evaluations_stage(void *args_, int i)
 {
-    int i;
+    ocp_nlp_stage_args *args = args_;
+    ocp_nlp_config *config = args->config;
+    ocp_nlp_dims *dims = args->dims;
+    ocp_nlp_memory *mem = args->mem;
 
     int N = dims->N;
     int *nv = dims->nv;
     int *nx = dims->nx;
-    // int *nu = dims->nu;
+    int *nu = dims->nu;
     int *ni = dims->ni;
 
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp parallel for
-#endif
-    for (i = 0; i <= N; i++)
-    {
-        // g
-        blasfeo_dveccp(nv[i], mem->cost_grad + i, 0, mem->qp_in->rqz + i, 0);
-
-        // b
-        if (i < N)
-            blasfeo_dveccp(nx[i + 1], mem->dyn_fun + i, 0, mem->qp_in->b + i, 0);
+    // nlp mem: cost_grad
+    struct blasfeo_dvec *cost_grad = config->cost[i]->memory_get_grad_ptr(mem->cost[i]);
+    blasfeo_dveccp(nv[i], cost_grad, 0, mem->cost_grad + i, 0);
 
-        // d
-        blasfeo_dveccp(2 * ni[i], mem->ineq_fun + i, 0, mem->qp_in->d + i, 0);
+    // nlp mem: dyn_fun
+    if (i < N)
+    {
+        struct blasfeo_dvec *dyn_fun
+            = config->dynamics[i]->memory_get_fun_ptr(mem->dynamics[i]);
+        blasfeo_dveccp(nx[i + 1], dyn_fun, 0, mem->dyn_fun + i, 0);
     }
 
-    return;
-}
-
-
-
+    // nlp mem: dyn_adj
+    if (i < N)
+    {
+        struct blasfeo_dvec *dyn_adj
+            = config->dynamics[i]->memory_get_adj_ptr(mem->dynamics[i]);
+        blasfeo_dveccp(nu[i] + nx[i], dyn_adj, 0, mem->dyn_adj + i, 0);
+    }
+    else
+    {
+        blasfeo_dvecse(nu[N] + nx[N], 0.0, mem->dyn_adj + N, 0);
+    }
+    if (i > 0)
+    {
+        struct blasfeo_dvec *dyn_adj
+            = config->dynamics[i-1]->memory_get_adj_ptr(mem->dynamics[i-1]);
+        blasfeo_daxpy(nx[i], 1.0, dyn_adj, nu[i-1]+nx[i-1], mem->dyn_adj+i, nu[i],
+            mem->dyn_adj+i, nu[i]);
+    }
+
+    // nlp mem: ineq_fun
+    struct blasfeo_dvec *ineq_fun =
+        config->constraints[i]->memory_get_fun_ptr(mem->constraints[i]);
+    blasfeo_dveccp(2 * ni[i], ineq_fun, 0, mem->ineq_fun + i, 0);
+
+    // nlp mem: ineq_adj
+    struct blasfeo_dvec *ineq_adj =
+        config->constraints[i]->memory_get_adj_ptr(mem->constraints[i]);
+    blasfeo_dveccp(nv[i], ineq_adj, 0, mem->ineq_adj + i, 0);
+}
+
+
+
+void ocp_nlp_approximate_qp_matrices(ocp_nlp_config *config, ocp_nlp_dims *dims,
+    ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem,
+    ocp_nlp_workspace *work)
+{
+    int N = dims->N;
+
+    ocp_nlp_stage_args args = {config, dims, in, out, opts, mem, work, NULL, 0.0};
+
+    /* stage-wise multiple shooting lagrangian evaluation */
+    acados_thread_pool_parallel_for_balanced(mem->pool, N+1,
+            &ocp_nlp_approximate_qp_matrices_stage, &args, mem->stage_time_lin);
+
+    /* collect stage-wise evaluations */
+    acados_thread_pool_parallel_for(mem->pool, N+1, &ocp_nlp_collect_evaluations_stage, &args);
+
+    // TODO(rien) where should the update happen??? move to qp update ???
+    // TODO(all): fix and move where appropriate
+    //  for (i = 0; i <= N; i++)
+    //  {
+    //  if (i<N)
+    //  {
+    //   ocp_nlp_dynamics_opts *dynamics_opts = opts->dynamics[i];
+    //   sim_opts *opts = dynamics_opts->sim_solver;
+    //   if (opts->scheme != NULL && opts->scheme->type != exact)
+    //   {
+    //    for (int_t j = 0; j < nx; j++)
+    //     BLASFEO_DVECEL(nlp_mem->cost_grad+i, nu+j) += work->sim_out[i]->grad[j];
+    //    for (int_t j = 0; j < nu; j++)
+    //     BLASFEO_DVECEL(nlp_mem->cost_grad+i, nx+j) += work->sim_out[i]->grad[nx+j];
+    //   }
+    //  }
+    //  }
+
+    return;
+}
+
+
+
+static void ocp_nlp_approximate_qp_vectors_sqp_stage(void *args_, int i)
+{
+    ocp_nlp_stage_args *args = args_;
+    ocp_nlp_dims *dims = args->dims;
+    ocp_nlp_memory *mem = args->mem;
+
+    int N = dims->N;
+    int *nv = dims->nv;
+    int *nx = dims->nx;
+    int *ni = dims->ni;
+
+    // g
+    blasfeo_dveccp(nv[i], mem->cost_grad + i, 0, mem->qp_in->rqz + i, 0);
+
+    // b
+    if (i < N)
+        blasfeo_dveccp(nx[i + 1], mem->dyn_fun + i, 0, mem->qp_in->b + i, 0);
+
+    // d
+    blasfeo_dveccp(2 * ni[i], mem->ineq_fun + i, 0, mem->qp_in->d + i, 0);
+}
+
+
+
+// update QP rhs for SQP (step prim var, abs dual var)
+// TODO(all): move in dynamics, cost, constraints modules ???
+void ocp_nlp_approximate_qp_vectors_sqp(ocp_nlp_config *config,
+    ocp_nlp_dims *dims, ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts,
+    ocp_nlp_memory *mem, ocp_nlp_workspace *work)
+{
+    ocp_nlp_stage_args args = {config, dims, in, out, opts, mem, work, NULL, 0.0};
+
+    acados_thread_pool_parallel_for(mem->pool, dims->N+1,
+                                    &ocp_nlp_approximate_qp_vectors_sqp_stage, &args);
+
+    return;
+}
+
+
+
 
 void ocp_nlp_embed_initial_value(ocp_nlp_config *config, ocp_nlp_dims *dims,
     ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts,
@@ -2093,6 +2304,49 @@ void ocp_nlp_embed_initial_value(ocp_nlp_config *config, ocp_nlp_dims *dims,
 
 
 
+static void ocp_nlp_compute_fun_stage(void *args_, int i)
+{
+    ocp_nlp_stage_args *args = args_;
+    ocp_nlp_config *config = args->config;
+    ocp_nlp_dims *dims = args->dims;
+    ocp_nlp_in *in = args->in;
+    ocp_nlp_opts *opts = args->opts;
+    ocp_nlp_memory *mem = args->mem;
+    ocp_nlp_workspace *work = args->work;
+
+    int N = dims->N;
+
+    // cost
+    config->cost[i]->compute_fun(config->cost[i], dims->cost[i], in->cost[i], opts->cost[i],
+                                mem->cost[i], work->cost[i]);
+
+    // dynamics
+    if (i < N)
+        config->dynamics[i]->compute_fun(config->dynamics[i], dims->dynamics[i], in->dynamics[i],
+                                         opts->dynamics[i], mem->dynamics[i], work->dynamics[i]);
+
+    // constr
+    config->constraints[i]->compute_fun(config->constraints[i], dims->constraints[i],
+                                        in->constraints[i], opts->constraints[i],
+                                        mem->constraints[i], work->constraints[i]);
+}
+
+
+
+// evaluate cost, dynamics and constraint functions at the point in work->tmp_nlp_out
+static void ocp_nlp_compute_fun(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+                                ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work)
+{
+    ocp_nlp_stage_args args = {config, dims, in, NULL, opts, mem, work, NULL, 0.0};
+
+    acados_thread_pool_parallel_for_balanced(mem->pool, dims->N+1, &ocp_nlp_compute_fun_stage,
+            &args, mem->stage_time_fun);
+
+    return;
+}
+
+
+
 double ocp_nlp_evaluate_merit_fun(ocp_nlp_config *config, ocp_nlp_dims *dims,
                                   ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts,
                                   ocp_nlp_memory *mem, ocp_nlp_workspace *work)
@@ -2106,34 +2360,7 @@ double ocp_nlp_evaluate_merit_fun(ocp_nlp_config *config, ocp_nlp_dims *dims,
     double merit_fun = 0.0;
 
     // compute fun value
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp parallel for
-#endif
-    for (i=0; i<=N; i++)
-    {
-        // cost
-        config->cost[i]->compute_fun(config->cost[i], dims->cost[i], in->cost[i], opts->cost[i],
-                                    mem->cost[i], work->cost[i]);
-    }
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp parallel for
-#endif
-    for (i=0; i<N; i++)
-    {
-        // dynamics
-        config->dynamics[i]->compute_fun(config->dynamics[i], dims->dynamics[i], in->dynamics[i],
-                                         opts->dynamics[i], mem->dynamics[i], work->dynamics[i]);
-    }
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp parallel for
-#endif
-    for (i=0; i<=N; i++)
-    {
-        // constr
-        config->constraints[i]->compute_fun(config->constraints[i], dims->constraints[i],
-                                            in->constraints[i], opts->constraints[i],
-                                            mem->constraints[i], work->constraints[i]);
-    }
+    ocp_nlp_compute_fun(config, dims, in, opts, mem, work);
 
     double *tmp_fun;
     double tmp;
@@ -2185,96 +2412,195 @@ double ocp_nlp_evaluate_merit_fun(ocp_nlp_config *config, ocp_nlp_dims *dims,
 
 
 
-static double ocp_nlp_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
-            ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work)
+void ocp_nlp_evaluate_cost_and_infeasibility(ocp_nlp_config *config, ocp_nlp_dims *dims,
+            ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem,
+            ocp_nlp_workspace *work, double *cost, double *infeas)
 {
-    int i;
+    int i, j;
 
     int N = dims->N;
-    int *nv = dims->nv;
     int *nx = dims->nx;
     int *ni = dims->ni;
 
-    double alpha = opts->step_length;
-    double tmp0, tmp1;
-    int j;
+    // compute fun value
+    ocp_nlp_compute_fun(config, dims, in, opts, mem, work);
 
+    double tmp;
+    struct blasfeo_dvec *tmp_fun_vec;
 
-#if 0 // Line Search Gianluca version
-    // current point
+    double cost_fun = 0.0;
     for (i = 0; i <= N; i++)
-        blasfeo_dveccp(nv[i], out->ux+i, 0, work->tmp_nlp_out->ux+i, 0);
+        cost_fun += *config->cost[i]->memory_get_fun_ptr(mem->cost[i]);
 
+    // l1 norm of the constraint violation
+    double infeas_fun = 0.0;
     for (i = 0; i < N; i++)
-        blasfeo_dveccp(nx[i+1], out->pi+i, 0, work->tmp_nlp_out->pi+i, 0);
-
+    {
+        tmp_fun_vec = config->dynamics[i]->memory_get_fun_ptr(mem->dynamics[i]);
+        for (j = 0; j < nx[i+1]; j++)
+            infeas_fun += fabs(BLASFEO_DVECEL(tmp_fun_vec, j));
+    }
     for (i = 0; i <= N; i++)
-        blasfeo_dveccp(2*ni[i], out->lam+i, 0, work->tmp_nlp_out->lam+i, 0);
+    {
+        tmp_fun_vec = config->constraints[i]->memory_get_fun_ptr(mem->constraints[i]);
+        for (j = 0; j < 2*ni[i]; j++)
+        {
+            tmp = BLASFEO_DVECEL(tmp_fun_vec, j);
+            infeas_fun += tmp>0.0 ? tmp : 0.0;
+        }
+    }
 
-        // linear update of algebraic variables using state and input sensitivity
-//        if (i < N)
-//        {
-//            blasfeo_dgemv_t(nu[i]+nx[i], nz[i], alpha, mem->dzduxt+i, 0, 0, mem->qp_out->ux+i, 0, 1.0, mem->z_alg+i, 0, out->z+i, 0);
-//        }
+    *cost = cost_fun;
+    *infeas = infeas_fun;
 
-    // initialize weights
-    if(mem->sqp_iter[0]==0)
-    {
-        for (i = 0; i < N; i++)
-            blasfeo_dveccp(nx[i+1], out->pi+i, 0, work->weight_merit_fun->pi+i, 0);
+    return;
+}
 
-        for (i = 0; i <= N; i++)
-            blasfeo_dveccp(2*ni[i], out->lam+i, 0, work->weight_merit_fun->lam+i, 0);
-    }
 
-    // update weigths
-    for (i = 0; i < N; i++)
+
+// sufficient decrease test for the merit backtracking line search
+static bool ocp_nlp_line_search_accept(ocp_nlp_opts *opts, double merit_fun0, double merit_fun1,
+                                       double dmerit, double alpha)
+{
+    if (opts->line_search_use_sufficient_descent)
     {
-        for(j=0; j<nx[i+1]; j++)
-        {
-            tmp0 = fabs(BLASFEO_DVECEL(work->weight_merit_fun->pi+i, j));
-            tmp1 = 0.5 * (tmp0 + fabs(BLASFEO_DVECEL(mem->qp_out->pi+i, j)));
-            BLASFEO_DVECEL(work->weight_merit_fun->pi+i, j) = tmp0>tmp1 ? tmp0 : tmp1;
-        }
+        // Armijo condition, Leineweber1999 (2.35)
+        return merit_fun1 <= merit_fun0 + opts->eps_sufficient_descent * alpha * dmerit;
     }
+    return merit_fun1 < merit_fun0;
+}
+
+
+
+// trial point: tmp_nlp_out->ux = out->ux + alpha * qp_out->ux
+static void ocp_nlp_line_search_trial_point(ocp_nlp_dims *dims, ocp_nlp_out *out,
+                                            ocp_nlp_memory *mem, ocp_nlp_workspace *work,
+                                            double alpha)
+{
+    int i;
+
+    int N = dims->N;
+    int *nv = dims->nv;
+
+    for (i = 0; i <= N; i++)
+        blasfeo_daxpy(nv[i], alpha, mem->qp_out->ux+i, 0, out->ux+i, 0, work->tmp_nlp_out->ux+i, 0);
+
+    return;
+}
+
+
+
+// second-order correction of the full step, see e.g. Nocedal2006, Section 18.3:
+// the QP is solved again, with the linearization residuals of the constraints at the rejected
+// trial point added to the QP rhs, i.e.
+//     b_soc = b + f(x+d) - (b + A d)   and   d_soc = d + g(x+d) - (d + J d),
+// where the QP constraints are satisfied by the rejected step d; the term J d is recovered from
+// the QP slacks t. On rejection the original QP rhs and solution are restored.
+static bool ocp_nlp_line_search_soc(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+            ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
+            double merit_fun0, double dmerit)
+{
+    int i;
+
+    int N = dims->N;
+    int *nv = dims->nv;
+    int *nx = dims->nx;
+    int *ni = dims->ni;
+
+    ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
+    struct blasfeo_dvec *tmp_fun_vec;
+
+    // backup QP solution and rhs
     for (i = 0; i <= N; i++)
     {
-        for(j=0; j<2*ni[i]; j++)
+        blasfeo_dveccp(nv[i], mem->qp_out->ux+i, 0, work->tmp_qp_out->ux+i, 0);
+        blasfeo_dveccp(2*ni[i], mem->qp_out->lam+i, 0, work->tmp_qp_out->lam+i, 0);
+        blasfeo_dveccp(2*ni[i], mem->qp_out->t+i, 0, work->tmp_qp_out->t+i, 0);
+        blasfeo_dveccp(2*ni[i], mem->qp_in->d+i, 0, work->tmp_d+i, 0);
+        if (i < N)
         {
-            tmp0 = fabs(BLASFEO_DVECEL(work->weight_merit_fun->lam+i, j));
-            tmp1 = 0.5 * (tmp0 + fabs(BLASFEO_DVECEL(mem->qp_out->lam+i, j)));
-            BLASFEO_DVECEL(work->weight_merit_fun->lam+i, j) = tmp0>tmp1 ? tmp0 : tmp1;
+            blasfeo_dveccp(nx[i+1], mem->qp_out->pi+i, 0, work->tmp_qp_out->pi+i, 0);
+            blasfeo_dveccp(nx[i+1], mem->qp_in->b+i, 0, work->tmp_b+i, 0);
         }
     }
 
-    printf("\n\nmerit fun value\n");
-    double merit_fun0 = ocp_nlp_evaluate_merit_fun(config, dims, in, out, opts, mem, work);
+    // corrected rhs, module memory holds the function values at the rejected full step
+    for (i = 0; i < N; i++)
+    {
+        tmp_fun_vec = config->dynamics[i]->memory_get_fun_ptr(mem->dynamics[i]);
+        blasfeo_daxpy(nx[i+1], 1.0, tmp_fun_vec, 0, mem->qp_in->b+i, 0, mem->qp_in->b+i, 0);
+    }
+    for (i = 0; i <= N; i++)
+    {
+        tmp_fun_vec = config->constraints[i]->memory_get_fun_ptr(mem->constraints[i]);
+        blasfeo_daxpy(2*ni[i], 1.0, tmp_fun_vec, 0, mem->qp_in->d+i, 0, mem->qp_in->d+i, 0);
+        blasfeo_daxpy(2*ni[i], 1.0, mem->qp_out->t+i, 0, mem->qp_in->d+i, 0, mem->qp_in->d+i, 0);
+    }
 
-    double alpha_min = 0.1;
+    // correct_dual_sol of the regular step restored the unregularized Hessian in qp_in
+    config->regularize->regularize_hessian(config->regularize, dims->regularize,
+                                           opts->regularize, mem->regularize_mem);
+    // otherwise the matrices of the regular step are unchanged and their condensing is reused
+    if (config->regularize->regularize_writes_qp_mat)
+        qp_solver->memory_set(qp_solver, mem->qp_solver_mem, "mat_dirty_all", NULL);
 
-    for (j=0; j<10 & alpha>alpha_min; j++)
-    {
+    int qp_status = qp_solver->evaluate(qp_solver, dims->qp_solver, mem->qp_in, mem->qp_out,
+                                        opts->qp_solver_opts, mem->qp_solver_mem, work->qp_work);
 
-        for (i = 0; i <= N; i++)
-            blasfeo_daxpy(nv[i], alpha, mem->qp_out->ux+i, 0, out->ux+i, 0, work->tmp_nlp_out->ux+i, 0);
+    config->regularize->correct_dual_sol(config->regularize, dims->regularize,
+                                         opts->regularize, mem->regularize_mem);
+    if (config->regularize->correct_writes_qp_mat)
+        qp_solver->memory_set(qp_solver, mem->qp_solver_mem, "mat_dirty_all", NULL);
 
-        printf("\n%d tmp merit fun value\n", j);
+    bool accept = false;
+    if ((qp_status == ACADOS_SUCCESS) | (qp_status == ACADOS_MAXITER))
+    {
+        ocp_nlp_line_search_trial_point(dims, out, mem, work, 1.0);
         double merit_fun1 = ocp_nlp_evaluate_merit_fun(config, dims, in, out, opts, mem, work);
+        accept = ocp_nlp_line_search_accept(opts, merit_fun0, merit_fun1, dmerit, 1.0);
+    }
 
-        if(merit_fun1 < merit_fun0)
-        {
-            break;
-        }
-        else
+    // restore QP rhs
+    for (i = 0; i <= N; i++)
+    {
+        blasfeo_dveccp(2*ni[i], work->tmp_d+i, 0, mem->qp_in->d+i, 0);
+        if (i < N)
+            blasfeo_dveccp(nx[i+1], work->tmp_b+i, 0, mem->qp_in->b+i, 0);
+    }
+
+    // restore QP solution
+    if (!accept)
+    {
+        for (i = 0; i <= N; i++)
         {
-            alpha *= 0.7;
+            blasfeo_dveccp(nv[i], work->tmp_qp_out->ux+i, 0, mem->qp_out->ux+i, 0);
+            blasfeo_dveccp(2*ni[i], work->tmp_qp_out->lam+i, 0, mem->qp_out->lam+i, 0);
+            blasfeo_dveccp(2*ni[i], work->tmp_qp_out->t+i, 0, mem->qp_out->t+i, 0);
+            if (i < N)
+                blasfeo_dveccp(nx[i+1], work->tmp_qp_out->pi+i, 0, mem->qp_out->pi+i, 0);
         }
     }
 
-    printf("\nalpha %f\n", alpha);
+    return accept;
+}
+
 
-#endif
 
+// computes the step length in alpha_out; returns ACADOS_MINSTEP if no step length
+// down to alpha_min satisfies the Armijo condition
+static int ocp_nlp_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+            ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
+            double *alpha_out)
+{
+    int i, j;
+
+    int N = dims->N;
+    int *nv = dims->nv;
+    int *nx = dims->nx;
+    int *ni = dims->ni;
+
+    double alpha = opts->step_length;
+    double tmp0, tmp1;
 
     if (opts->globalization == MERIT_BACKTRACKING)
     {
@@ -2290,13 +2616,7 @@ static double ocp_nlp_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims, oc
         for (i = 0; i <= N; i++)
             blasfeo_dveccp(2*ni[i], out->lam+i, 0, work->tmp_nlp_out->lam+i, 0);
 
-            // linear update of algebraic variables using state and input sensitivity
-    //        if (i < N)
-    //        {
-    //            blasfeo_dgemv_t(nu[i]+nx[i], nz[i], alpha, mem->dzduxt+i, 0, 0, mem->qp_out->ux+i, 0, 1.0, mem->z_alg+i, 0, out->z+i, 0);
-    //        }
-
-        /* initialize (Leineweber1999 M5.1) */
+        /* merit function weights (Leineweber1999 M5.1), using the multipliers of the QP */
         if (mem->sqp_iter[0]==0)
         {
             // initialize weights
@@ -2305,28 +2625,25 @@ static double ocp_nlp_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims, oc
             {
                 for (j=0; j<nx[i+1]; j++)
                 {
-                    tmp0 = fabs(BLASFEO_DVECEL(out->pi+i, j));
+                    tmp0 = fabs(BLASFEO_DVECEL(mem->qp_out->pi+i, j));
                     BLASFEO_DVECEL(work->weight_merit_fun->pi+i, j) = tmp0;
                 }
             }
 
-            // printf("merit fun: initialize weights lam\n");
             for (i = 0; i <= N; i++)
             {
-                blasfeo_dveccp(2*ni[i], out->lam+i, 0, work->weight_merit_fun->lam+i, 0);
-                // blasfeo_print_dvec(nx[i+1], work->weight_merit_fun->lam+i, 0);
+                blasfeo_dveccp(2*ni[i], mem->qp_out->lam+i, 0, work->weight_merit_fun->lam+i, 0);
             }
         }
         else
         {
             // update weights
-            // printf("merit fun: update weights, sqp_iter = %d\n", mem->sqp_iter[0]);
             for (i = 0; i < N; i++)
             {
                 for(j=0; j<nx[i+1]; j++)
                 {
                     // abs(lambda) (LW)
-                    tmp0 = fabs(BLASFEO_DVECEL(out->pi+i, j));
+                    tmp0 = fabs(BLASFEO_DVECEL(mem->qp_out->pi+i, j));
                     // .5 * (abs(lambda) + sigma)
                     tmp1 = 0.5 * (tmp0 + BLASFEO_DVECEL(work->weight_merit_fun->pi+i, j));
                     BLASFEO_DVECEL(work->weight_merit_fun->pi+i, j) = tmp0>tmp1 ? tmp0 : tmp1;
@@ -2337,7 +2654,7 @@ static double ocp_nlp_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims, oc
                 for(j=0; j<2*ni[i]; j++)
                 {
                     // mu (LW)
-                    tmp0 = BLASFEO_DVECEL(out->lam+i, j);
+                    tmp0 = BLASFEO_DVECEL(mem->qp_out->lam+i, j);
                     // .5 * (mu + tau)
                     tmp1 = 0.5 * (tmp0 + BLASFEO_DVECEL(work->weight_merit_fun->lam+i, j));
                     BLASFEO_DVECEL(work->weight_merit_fun->lam+i, j) = tmp0>tmp1 ? tmp0 : tmp1;
@@ -2345,48 +2662,90 @@ static double ocp_nlp_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims, oc
             }
         }
 
-        if (1) // (mem->sqp_iter[0]!=0) // TODO: why does Leineweber do full step in first SQP iter?
-        {
-            double merit_fun0 = ocp_nlp_evaluate_merit_fun(config, dims, in, out, opts, mem, work);
+        double merit_fun0 = ocp_nlp_evaluate_merit_fun(config, dims, in, out, opts, mem, work);
 
-            double alpha_min = 0.1;
-            // TODO(oj): add alpha_min and alpha_reduction factor [0.7] to options.
+        // directional derivative of the l1 merit function along the QP step:
+        // the linearized constraints are satisfied by the step, thus
+        // dmerit = grad_cost' * d - (weighted constraint violation at the current iterate)
+        double cost_fun0 = 0.0;
+        for (i = 0; i <= N; i++)
+            cost_fun0 += *config->cost[i]->memory_get_fun_ptr(mem->cost[i]);
 
-            /* actual Line Search*/
-            alpha = 1.0;
-            // TODO: check out more advanced step search Leineweber1995
+        double dmerit = 0.0;
+        for (i = 0; i <= N; i++)
+            dmerit += blasfeo_ddot(nv[i], mem->cost_grad+i, 0, mem->qp_out->ux+i, 0);
+        dmerit -= merit_fun0 - cost_fun0;
+        // no descent direction (e.g. poor Hessian approximation): require simple decrease
+        dmerit = dmerit < 0.0 ? dmerit : 0.0;
 
-            for (j=0; alpha>alpha_min; j++)
-            {
+        /* actual Line Search*/
+        alpha = 1.0;
+        // TODO: check out more advanced step search Leineweber1995
 
-                for (i = 0; i <= N; i++)
-                    blasfeo_daxpy(nv[i], alpha, mem->qp_out->ux+i, 0, out->ux+i, 0, work->tmp_nlp_out->ux+i, 0);
+        for (j=0; ; j++)
+        {
+            ocp_nlp_line_search_trial_point(dims, out, mem, work, alpha);
 
-                // printf("\ntmp merit fun value step search iter: %d", j);
-                double merit_fun1 = ocp_nlp_evaluate_merit_fun(config, dims, in, out, opts, mem, work);
-                // TODO(oj): also check Armijo-type condition Leinweber1999 (2.35)
+            // only function evaluations (no sensitivities) at the trial point
+            double merit_fun1 = ocp_nlp_evaluate_merit_fun(config, dims, in, out, opts, mem, work);
 
-                if (merit_fun1 < merit_fun0)
-                {
+            if (ocp_nlp_line_search_accept(opts, merit_fun0, merit_fun1, dmerit, alpha))
+                break;
+
+            // try to rescue the full step
+            if (j == 0 && opts->globalization_use_SOC)
+            {
+                if (ocp_nlp_line_search_soc(config, dims, in, out, opts, mem, work,
+                                            merit_fun0, dmerit))
                     break;
-                }
-                else
-                {
-                    alpha *= 0.7;
-                }
             }
+
+            if (alpha <= opts->alpha_min)
+            {
+                // not even the minimal step is accepted
+                *alpha_out = alpha;
+                return ACADOS_MINSTEP;
+            }
+
+            alpha *= opts->alpha_reduction;
+
+            // try alpha_min itself before giving up
+            if (alpha < opts->alpha_min)
+                alpha = opts->alpha_min;
         }
-        printf("\nalpha %f\n", alpha);
     }
 
-    return alpha;
+    *alpha_out = alpha;
+    return ACADOS_SUCCESS;
 }
 
 
-void ocp_nlp_update_variables_sqp(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+
+int ocp_nlp_update_variables_sqp(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
             ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work)
 {
-    int i;
+    // step length
+    double alpha;
+    int status = ocp_nlp_line_search(config, dims, in, out, opts, mem, work, &alpha);
+
+    // keep the current iterate if the line search failed
+    if (status != ACADOS_SUCCESS)
+        return status;
+
+    ocp_nlp_update_variables_step(config, dims, in, out, opts, mem, work, alpha);
+
+    return ACADOS_SUCCESS;
+}
+
+
+
+static void ocp_nlp_update_variables_step_stage(void *args_, int i)
+{
+    ocp_nlp_stage_args *args = args_;
+    ocp_nlp_dims *dims = args->dims;
+    ocp_nlp_out *out = args->out;
+    ocp_nlp_memory *mem = args->mem;
+    double alpha = args->alpha;
 
     int N = dims->N;
     int *nv = dims->nv;
@@ -2395,36 +2754,138 @@ void ocp_nlp_update_variables_sqp(ocp_nlp_config *config, ocp_nlp_dims *dims, oc
     int *ni = dims->ni;
     int *nz = dims->nz;
 
-    // step length
-    double alpha = ocp_nlp_line_search(config, dims, in, out, opts, mem, work);
+    // step in primal variables
+    blasfeo_daxpy(nv[i], alpha, mem->qp_out->ux + i, 0, out->ux + i, 0, out->ux + i, 0);
 
+    // update dual variables
+    if (i < N)
+    {
+        blasfeo_dvecsc(nx[i+1], 1.0-alpha, out->pi+i, 0);
+        blasfeo_daxpy(nx[i+1], alpha, mem->qp_out->pi+i, 0, out->pi+i, 0, out->pi+i, 0);
+    }
 
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp parallel for
-#endif
-    for (i = 0; i <= N; i++)
+    blasfeo_dvecsc(2*ni[i], 1.0-alpha, out->lam+i, 0);
+    blasfeo_daxpy(2*ni[i], alpha, mem->qp_out->lam+i, 0, out->lam+i, 0, out->lam+i, 0);
+
+    // update slack values
+    blasfeo_dvecsc(2*ni[i], 1.0-alpha, out->t+i, 0);
+    blasfeo_daxpy(2*ni[i], alpha, mem->qp_out->t+i, 0, out->t+i, 0, out->t+i, 0);
+
+    // linear update of algebraic variables using state and input sensitivity
+    if (i < N)
     {
-        // step in primal variables
-        blasfeo_daxpy(nv[i], alpha, mem->qp_out->ux + i, 0, out->ux + i, 0, out->ux + i, 0);
-    
-        // update dual variables
-        if (i < N)
-        {
-            blasfeo_dvecsc(nx[i+1], 1.0-alpha, out->pi+i, 0);
-            blasfeo_daxpy(nx[i+1], alpha, mem->qp_out->pi+i, 0, out->pi+i, 0, out->pi+i, 0);
-        }
+        blasfeo_dgemv_t(nu[i]+nx[i], nz[i], alpha, mem->dzduxt+i, 0, 0, mem->qp_out->ux+i, 0, 1.0, mem->z_alg+i, 0, out->z+i, 0); 
+    }
+}
 
-        blasfeo_dvecsc(2*ni[i], 1.0-alpha, out->lam+i, 0);
-        blasfeo_daxpy(2*ni[i], alpha, mem->qp_out->lam+i, 0, out->lam+i, 0, out->lam+i, 0);
 
-        // update slack values
-        blasfeo_dvecsc(2*ni[i], 1.0-alpha, out->t+i, 0);
-        blasfeo_daxpy(2*ni[i], alpha, mem->qp_out->t+i, 0, out->t+i, 0, out->t+i, 0);
 
-        // linear update of algebraic variables using state and input sensitivity
+void ocp_nlp_update_variables_step(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+            ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
+            double alpha)
+{
+    ocp_nlp_stage_args args = {config, dims, in, out, opts, mem, work, NULL, alpha};
+
+    acados_thread_pool_parallel_for(mem->pool, dims->N+1, &ocp_nlp_update_variables_step_stage,
+                                    &args);
+
+    return;
+}
+
+
+
+/************************************************
+ * parametric sensitivities
+ ************************************************/
+
+int ocp_nlp_param_sens_rows(ocp_nlp_dims *dims)
+{
+    int N = dims->N;
+    int *nv = dims->nv;
+    int *nx = dims->nx;
+    int *ni = dims->ni;
+
+    int rows = 0;
+    for (int i = 0; i <= N; i++)
+    {
+        rows += nv[i] + 2 * ni[i];
         if (i < N)
+            rows += nx[i+1];
+    }
+
+    return rows;
+}
+
+
+
+void ocp_nlp_eval_param_sens_batch_qp(ocp_nlp_config *config, ocp_nlp_dims *dims,
+          ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work, ocp_qp_in *tmp_qp_in,
+          ocp_qp_out *tmp_qp_out, char *field, int stage, int n_dir, int *index, double *sens,
+          int ld_sens)
+{
+    int N = dims->N;
+    int *nv = dims->nv;
+    int *nx = dims->nx;
+    int *ni = dims->ni;
+
+    if (!strcmp("p", field) || !strcmp("p_global", field) || !strcmp("parameter_values", field))
+    {
+        // the qp only depends on x0 through its rhs, the model functions provide no derivatives
+        // w.r.t. the parameters, which would enter the qp matrices and rhs of every stage
+        printf("\nerror: ocp_nlp_eval_param_sens_batch: sensitivities w.r.t. the parameters %s "
+               "are not supported, only w.r.t. the initial state (\"ex\" at stage 0)\n", field);
+        exit(1);
+    }
+    if (!((!strcmp("ex", field)) & (stage==0)))
+    {
+        printf("\nerror: field %s at stage %d not available in ocp_nlp_eval_param_sens_batch\n",
+               field, stage);
+        exit(1);
+    }
+
+    int rows = ocp_nlp_param_sens_rows(dims);
+    if (ld_sens < rows)
+    {
+        printf("\nerror: ocp_nlp_eval_param_sens_batch: ld_sens = %d, needs at least %d\n",
+               ld_sens, rows);
+        exit(1);
+    }
+
+    // the qp data is copied and its rhs zeroed once for all directions,
+    // each direction only sets and resets a single entry of the rhs
+    d_ocp_qp_copy_all(mem->qp_in, tmp_qp_in);
+    d_ocp_qp_set_rhs_zero(tmp_qp_in);
+
+    double one = 1.0;
+    double zero = 0.0;
+
+    for (int k = 0; k < n_dir; k++)
+    {
+        d_ocp_qp_set_el("lbx", stage, index[k], &one, tmp_qp_in);
+        d_ocp_qp_set_el("ubx", stage, index[k], &one, tmp_qp_in);
+
+        config->qp_solver->eval_sens(config->qp_solver, dims->qp_solver, tmp_qp_in, tmp_qp_out,
+                                     opts->qp_solver_opts, mem->qp_solver_mem, work->qp_work);
+
+        d_ocp_qp_set_el("lbx", stage, index[k], &zero, tmp_qp_in);
+        d_ocp_qp_set_el("ubx", stage, index[k], &zero, tmp_qp_in);
+
+        // unpack into column k: ux, pi, lam of all stages
+        double *col = sens + k * ld_sens;
+        for (int i = 0; i <= N; i++)
+        {
+            blasfeo_unpack_dvec(nv[i], tmp_qp_out->ux + i, 0, col);
+            col += nv[i];
+        }
+        for (int i = 0; i < N; i++)
+        {
+            blasfeo_unpack_dvec(nx[i+1], tmp_qp_out->pi + i, 0, col);
+            col += nx[i+1];
+        }
+        for (int i = 0; i <= N; i++)
         {
-            blasfeo_dgemv_t(nu[i]+nx[i], nz[i], alpha, mem->dzduxt+i, 0, 0, mem->qp_out->ux+i, 0, 1.0, mem->z_alg+i, 0, out->z+i, 0); 
+            blasfeo_unpack_dvec(2 * ni[i], tmp_qp_out->lam + i, 0, col);
+            col += 2 * ni[i];
         }
     }
 
@@ -2530,6 +2991,39 @@ ocp_nlp_res *ocp_nlp_res_assign(ocp_nlp_dims *dims, void *raw_memory)
 
 
 
+static void ocp_nlp_res_compute_stage(void *args_, int ii)
+{
+    ocp_nlp_stage_args *args = args_;
+    ocp_nlp_dims *dims = args->dims;
+    ocp_nlp_out *out = args->out;
+    ocp_nlp_memory *mem = args->mem;
+    ocp_nlp_res *res = args->res;
+
+    int N = dims->N;
+    int *nv = dims->nv;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *ni = dims->ni;
+
+    // res_g
+    blasfeo_daxpy(nv[ii], -1.0, mem->ineq_adj + ii, 0, mem->cost_grad + ii, 0, res->res_g + ii,
+                  0);
+    blasfeo_daxpy(nu[ii] + nx[ii], -1.0, mem->dyn_adj + ii, 0, res->res_g + ii, 0,
+                  res->res_g + ii, 0);
+
+    // res_b
+    if (ii < N)
+        blasfeo_dveccp(nx[ii + 1], mem->dyn_fun + ii, 0, res->res_b + ii, 0);
+
+    // res_d
+    blasfeo_daxpy(2 * ni[ii], 1.0, out->t + ii, 0, mem->ineq_fun + ii, 0, res->res_d + ii, 0);
+
+    // res_m
+    blasfeo_dvecmul(2 * ni[ii], out->lam + ii, 0, out->t + ii, 0, res->res_m + ii, 0);
+}
+
+
+
 void ocp_nlp_res_compute(ocp_nlp_dims *dims, ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_res *res,
                          ocp_nlp_memory *mem)
 {
@@ -2537,19 +3031,18 @@ void ocp_nlp_res_compute(ocp_nlp_dims *dims, ocp_nlp_in *in, ocp_nlp_out *out, o
     int N = dims->N;
     int *nv = dims->nv;
     int *nx = dims->nx;
-    int *nu = dims->nu;
     int *ni = dims->ni;
 
     double tmp_res;
 
+    ocp_nlp_stage_args args = {NULL, dims, in, out, NULL, mem, NULL, res, 0.0};
+
+    acados_thread_pool_parallel_for(mem->pool, N+1, &ocp_nlp_res_compute_stage, &args);
+
     // res_g
     res->inf_norm_res_g = 0.0;
     for (int ii = 0; ii <= N; ii++)
     {
-        blasfeo_daxpy(nv[ii], -1.0, mem->ineq_adj + ii, 0, mem->cost_grad + ii, 0, res->res_g + ii,
-                      0);
-        blasfeo_daxpy(nu[ii] + nx[ii], -1.0, mem->dyn_adj + ii, 0, res->res_g + ii, 0,
-                      res->res_g + ii, 0);
         blasfeo_dvecnrm_inf(nv[ii], res->res_g + ii, 0, &tmp_res);
         res->inf_norm_res_g = tmp_res > res->inf_norm_res_g ? tmp_res : res->inf_norm_res_g;
     }
@@ -2558,7 +3051,6 @@ void ocp_nlp_res_compute(ocp_nlp_dims *dims, ocp_nlp_in *in, ocp_nlp_out *out, o
     res->inf_norm_res_b = 0.0;
     for (int ii = 0; ii < N; ii++)
     {
-        blasfeo_dveccp(nx[ii + 1], mem->dyn_fun + ii, 0, res->res_b + ii, 0);
         blasfeo_dvecnrm_inf(nx[ii + 1], res->res_b + ii, 0, &tmp_res);
         res->inf_norm_res_b = tmp_res > res->inf_norm_res_b ? tmp_res : res->inf_norm_res_b;
     }
@@ -2567,7 +3059,6 @@ void ocp_nlp_res_compute(ocp_nlp_dims *dims, ocp_nlp_in *in, ocp_nlp_out *out, o
     res->inf_norm_res_d = 0.0;
     for (int ii = 0; ii <= N; ii++)
     {
-        blasfeo_daxpy(2 * ni[ii], 1.0, out->t + ii, 0, mem->ineq_fun + ii, 0, res->res_d + ii, 0);
         blasfeo_dvecnrm_inf(2 * ni[ii], res->res_d + ii, 0, &tmp_res);
         res->inf_norm_res_d = tmp_res > res->inf_norm_res_d ? tmp_res : res->inf_norm_res_d;
     }
@@ -2576,7 +3067,6 @@ void ocp_nlp_res_compute(ocp_nlp_dims *dims, ocp_nlp_in *in, ocp_nlp_out *out, o
     res->inf_norm_res_m = 0.0;
     for (int ii = 0; ii <= N; ii++)
     {
-        blasfeo_dvecmul(2 * ni[ii], out->lam + ii, 0, out->t + ii, 0, res->res_m + ii, 0);
         blasfeo_dvecnrm_inf(2 * ni[ii], res->res_m + ii, 0, &tmp_res);
         res->inf_norm_res_m = tmp_res > res->inf_norm_res_m ? tmp_res : res->inf_norm_res_m;
     }
@@ -65,6 +65,7 @@ extern "C" {
 #include "acados/ocp_qp/ocp_qp_xcond_solver.h"
 #include "acados/sim/sim_common.h"
 #include "acados/utils/external_function_generic.h"
+#include "acados/utils/threads.h"
 #include "acados/utils/types.h"
 
 
@@ -90,12 +91,17 @@ typedef struct
     // evaluate solver // TODO rename into solve
     int (*evaluate)(void *config, void *dims, void *nlp_in, void *nlp_out, void *opts_, void *mem, void *work);
     void (*eval_param_sens)(void *config, void *dims, void *opts_, void *mem, void *work, char *field, int stage, int index, void *sens_nlp_out);
+    void (*eval_param_sens_batch)(void *config, void *dims, void *opts_, void *mem, void *work, char *field, int stage, int n_dir, int *index, double *sens, int ld_sens);
     // prepare memory
     int (*precompute)(void *config, void *dims, void *nlp_in, void *nlp_out, void *opts_, void *mem, void *work);
     // initalize this struct with default values
     void (*config_initialize_default)(void *config);
     // general getter
     void (*get)(void *config_, void *dims, void *mem_, const char *field, void *return_value_);
+    // wait for work running in the background (if any), NULL if the solver has none
+    void (*wait)(void *config_, void *mem_);
+    // release resources not contained in the memory (e.g. threads), NULL if the solver has none
+    void (*terminate)(void *config_, void *mem_, void *work_);
     // config structs of submodules
     ocp_qp_xcond_solver_config *qp_solver; // TODO rename xcond_solver
     ocp_nlp_dynamics_config **dynamics;
@@ -200,6 +206,9 @@ typedef struct
     /// Pointers to constraints functions (TBC).
     void **constraints;
 
+    /// Worker of an asynchronous preparation phase reading this struct (NULL if none).
+    acados_worker *worker;
+
 } ocp_nlp_in;
 
 //
@@ -232,6 +241,8 @@ typedef struct
     double inf_norm_res;
     double total_time;
 
+    acados_worker *worker;  // worker of an asynchronous preparation phase using this struct (or NULL)
+
 } ocp_nlp_out;
 
 //
@@ -251,6 +262,7 @@ typedef enum
 {
     FIXED_STEP,
     MERIT_BACKTRACKING,
+    FILTER_LINE_SEARCH,  // only in ocp_nlp_sqp
 } ocp_nlp_globalization_t;
 
 typedef struct
@@ -263,8 +275,18 @@ typedef struct
     void **constraints;  // constraints_opts
     double step_length;  // step length in case of FIXED_STEP
     double levenberg_marquardt;  // LM factor to be added to the hessian before regularization
+    // merit backtracking line search
+    double alpha_min;  // minimum step length
+    double alpha_reduction;  // step length reduction factor
+    double eps_sufficient_descent;  // Armijo parameter
+    int line_search_use_sufficient_descent;  // 0: simple decrease, 1: Armijo condition
+    int globalization_use_SOC;  // second-order correction if the full step is rejected
     int reuse_workspace;
     int num_threads;
+    // thread pool
+    acados_schedule_t thread_schedule;  // distribution of the stages of expensive loops
+    int thread_spin;  // spin iterations of idle threads before they sleep
+    int thread_affinity[ACADOS_MAX_THREADS];  // core of each thread, -1: not pinned; [0] is the calling thread, never pinned
 
 } ocp_nlp_opts;
 
@@ -302,6 +324,8 @@ typedef struct
     // QP stuff not entering the qp_in struct
     struct blasfeo_dmat *dzduxt; // dzdux transposed
     struct blasfeo_dvec *z_alg; // z_alg, output algebraic variables
+    struct blasfeo_dmat *dxdenseduxt; // dx_dense/dux transposed
+    struct blasfeo_dvec *x_dense; // dense output states within the shooting interval
 
     struct blasfeo_dvec *cost_grad;
     struct blasfeo_dvec *ineq_fun;
@@ -315,6 +339,10 @@ typedef struct
 
 	int *sqp_iter; // pointer to iteration number
 
+    acados_thread_pool *pool;  // persistent threads for the loops over stages
+    double *stage_time_lin;  // recorded stage times of the linearization
+    double *stage_time_fun;  // recorded stage times of the function evaluation
+
 } ocp_nlp_memory;
 
 //
@@ -322,6 +350,8 @@ int ocp_nlp_memory_calculate_size(ocp_nlp_config *config, ocp_nlp_dims *dims, oc
 //
 ocp_nlp_memory *ocp_nlp_memory_assign(ocp_nlp_config *config, ocp_nlp_dims *dims,
                                       ocp_nlp_opts *opts, void *raw_memory);
+// joins the threads of the thread pool
+void ocp_nlp_memory_terminate(ocp_nlp_memory *mem);
 
 
 
@@ -340,6 +370,11 @@ typedef struct
 	ocp_nlp_out *tmp_nlp_out;
 	ocp_nlp_out *weight_merit_fun;
 
+    // second-order correction
+    ocp_qp_out *tmp_qp_out;  // backup of the QP solution
+    struct blasfeo_dvec *tmp_b;  // backup of the QP dynamics rhs
+    struct blasfeo_dvec *tmp_d;  // backup of the QP inequality rhs
+
 } ocp_nlp_workspace;
 
 //
@@ -366,12 +401,28 @@ void ocp_nlp_approximate_qp_vectors_sqp(ocp_nlp_config *config, ocp_nlp_dims *di
 //
 void ocp_nlp_embed_initial_value(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
                  ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work);
-//
-void ocp_nlp_update_variables_sqp(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+// line search (if enabled) and update; returns ACADOS_MINSTEP if the line search failed
+int ocp_nlp_update_variables_sqp(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
            ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work);
+// full step with step length alpha in primal variables, convex combination in dual variables
+void ocp_nlp_update_variables_step(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+           ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
+           double alpha);
+// number of rows of the dense output of ocp_nlp_eval_param_sens_batch_qp: ux, pi, lam of all stages
+int ocp_nlp_param_sens_rows(ocp_nlp_dims *dims);
+// sensitivities of the last qp solution w.r.t. n_dir entries of field, one column of sens per direction;
+// not a blocked multi-rhs solve: one single-rhs backsolve per direction on the stored factorization
+void ocp_nlp_eval_param_sens_batch_qp(ocp_nlp_config *config, ocp_nlp_dims *dims,
+          ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work, ocp_qp_in *tmp_qp_in,
+          ocp_qp_out *tmp_qp_out, char *field, int stage, int n_dir, int *index, double *sens,
+          int ld_sens);
 //
 double ocp_nlp_evaluate_merit_fun(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
           ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work);
+// cost and l1 norm of the constraint violation at the point in work->tmp_nlp_out
+void ocp_nlp_evaluate_cost_and_infeasibility(ocp_nlp_config *config, ocp_nlp_dims *dims,
+          ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem,
+          ocp_nlp_workspace *work, double *cost, double *infeas);
 //
 void ocp_nlp_initialize_t_slacks(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
             ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work);
@@ -87,6 +87,7 @@ void *ocp_nlp_constraints_bgh_dims_assign(void *config_, void *raw_memory)
     dims->nbue = 0;
     dims->nge = 0;
     dims->nhe = 0;
+    dims->nbxd = 0;
 
     return dims;
 }
@@ -240,6 +241,14 @@ static void ocp_nlp_constraints_bgh_set_nhe(void *config_, void *dims_, const in
 
 
 
+static void ocp_nlp_constraints_bgh_set_nbxd(void *config_, void *dims_, const int *nbxd)
+{
+    ocp_nlp_constraints_bgh_dims *dims = (ocp_nlp_constraints_bgh_dims *) dims_;
+    dims->nbxd = *nbxd;
+}
+
+
+
 void ocp_nlp_constraints_bgh_dims_set(void *config_, void *dims_, const char *field,
                                              const int* value)
 {
@@ -303,6 +312,10 @@ void ocp_nlp_constraints_bgh_dims_set(void *config_, void *dims_, const char *fi
     {
         ocp_nlp_constraints_bgh_set_nhe(config_, dims_, value);
     }
+    else if (!strcmp(field, "nbxd"))
+    {
+        ocp_nlp_constraints_bgh_set_nbxd(config_, dims_, value);
+    }
     else
     {
         printf("\nerror: ocp_nlp_constraints_bgh_dims_get: field %s not available in module\n", field);
@@ -316,7 +329,7 @@ void ocp_nlp_constraints_bgh_dims_set(void *config_, void *dims_, const char *fi
 static void ocp_nlp_constraints_bgh_get_ni(void *config_, void *dims_, int* value)
 {
     ocp_nlp_constraints_bgh_dims *dims = (ocp_nlp_constraints_bgh_dims *) dims_;
-    *value = dims->nbx + dims->nbu + dims->ng + dims->nh + dims->ns;
+    *value = dims->nbx + dims->nbu + dims->ng + dims->nh + dims->nbxd + dims->ns;
 }
 
 
@@ -433,6 +446,14 @@ static void ocp_nlp_constraints_bgh_get_nhe(void *config_, void *dims_, int* val
 
 
 
+static void ocp_nlp_constraints_bgh_get_nbxd(void *config_, void *dims_, int* value)
+{
+    ocp_nlp_constraints_bgh_dims *dims = (ocp_nlp_constraints_bgh_dims *) dims_;
+    *value = dims->nbxd;
+}
+
+
+
 void ocp_nlp_constraints_bgh_dims_get(void *config_, void *dims_, const char *field, int* value)
 {
     if (!strcmp(field, "ni"))
@@ -479,12 +500,17 @@ void ocp_nlp_constraints_bgh_dims_get(void *config_, void *dims_, const char *fi
     {
         ocp_nlp_constraints_bgh_get_nsh(config_, dims_, value);
     }
+    else if (!strcmp(field, "nbxd"))
+    {
+        ocp_nlp_constraints_bgh_get_nbxd(config_, dims_, value);
+    }
     else if (!strcmp(field, "ng_qp_solver"))
     {
-        int ng, nh;
+        int ng, nh, nbxd;
         ocp_nlp_constraints_bgh_get_ng(config_, dims_, &ng);
         ocp_nlp_constraints_bgh_get_nh(config_, dims_, &nh);
-        *value = ng + nh;
+        ocp_nlp_constraints_bgh_get_nbxd(config_, dims_, &nbxd);
+        *value = ng + nh + nbxd;
     }
     else if (!strcmp(field, "nsg_qp_solver"))
     {
@@ -544,6 +570,7 @@ int ocp_nlp_constraints_bgh_model_calculate_size(void *config, void *dims_)
     int nbxe = dims->nbxe;
     int nge = dims->nge;
     int nhe = dims->nhe;
+    int nbxd = dims->nbxd;
 
     int size = 0;
 
@@ -552,7 +579,8 @@ int ocp_nlp_constraints_bgh_model_calculate_size(void *config, void *dims_)
     size += sizeof(int) * nb;                                         // idxb
     size += sizeof(int) * ns;                                         // idxs
     size += sizeof(int)*(nbue+nbxe+nge+nhe);                          // idxe
-    size += blasfeo_memsize_dvec(2 * nb + 2 * ng + 2 * nh + 2 * ns);  // d
+    size += sizeof(int) * nbxd;                                       // idxbxd
+    size += blasfeo_memsize_dvec(2 * nb + 2 * ng + 2 * nh + 2 * nbxd + 2 * ns);  // d
     size += blasfeo_memsize_dmat(nu + nx, ng);                        // DCt
 
     size += 64;  // blasfeo_mem align
@@ -582,6 +610,7 @@ void *ocp_nlp_constraints_bgh_model_assign(void *config, void *dims_, void *raw_
     int nbxe = dims->nbxe;
     int nge = dims->nge;
     int nhe = dims->nhe;
+    int nbxd = dims->nbxd;
 
     int ii;
 
@@ -598,6 +627,8 @@ void *ocp_nlp_constraints_bgh_model_assign(void *config, void *dims_, void *raw_
     assign_and_advance_int(ns, &model->idxs, &c_ptr);
     // idxe
     assign_and_advance_int(nbue+nbxe+nge+nhe, &model->idxe, &c_ptr);
+    // idxbxd
+    assign_and_advance_int(nbxd, &model->idxbxd, &c_ptr);
 
     // blasfeo_mem align
     align_char_to(64, &c_ptr);
@@ -608,15 +639,18 @@ void *ocp_nlp_constraints_bgh_model_assign(void *config, void *dims_, void *raw_
 
     // blasfeo_dvec
     // d
-    assign_and_advance_blasfeo_dvec_mem(2 * nb + 2 * ng + 2 * nh + 2 * ns, &model->d, &c_ptr);
+    assign_and_advance_blasfeo_dvec_mem(2 * nb + 2 * ng + 2 * nh + 2 * nbxd + 2 * ns, &model->d,
+                                        &c_ptr);
 
     /* initialize */
     // default initialization to zero
-    blasfeo_dvecse(2*nb+2*ng+2*nh+2*ns, 0.0, &model->d, 0);
+    blasfeo_dvecse(2*nb+2*ng+2*nh+2*nbxd+2*ns, 0.0, &model->d, 0);
 
     // default initialization
     for(ii=0; ii<nbue+nbxe+nge+nhe; ii++)
         model->idxe[ii] = 0;
+    for(ii=0; ii<nbxd; ii++)
+        model->idxbxd[ii] = 0;
 
     // assert
     assert((char *) raw_memory + ocp_nlp_constraints_bgh_model_calculate_size(config, dims) >=
@@ -627,6 +661,136 @@ void *ocp_nlp_constraints_bgh_model_assign(void *config, void *dims_, void *raw_
 
 
 
+int ocp_nlp_constraints_bgh_model_get_dvec_ptr(void *config_, void *dims_, void *model_,
+        const char *field, struct blasfeo_dvec **vec, int *offset, int *size)
+{
+    ocp_nlp_constraints_bgh_dims *dims = (ocp_nlp_constraints_bgh_dims *) dims_;
+    ocp_nlp_constraints_bgh_model *model = (ocp_nlp_constraints_bgh_model *) model_;
+
+    int nb = dims->nb;
+    int ng = dims->ng;
+    int nh = dims->nh;
+    int nbxd = dims->nbxd;
+    int ns = dims->ns;
+    int nsbu = dims->nsbu;
+    int nsbx = dims->nsbx;
+    int nsg = dims->nsg;
+    int nsh = dims->nsh;
+    int nbx = dims->nbx;
+    int nbu = dims->nbu;
+
+    *vec = &model->d;
+
+    if (!strcmp(field, "lb")) // TODO remove !!!
+    {
+        *size = nb;
+        *offset = 0;
+    }
+    else if (!strcmp(field, "ub")) // TODO remove !!!
+    {
+        *size = nb;
+        *offset = nb+ng+nh+nbxd;
+    }
+    else if (!strcmp(field, "lbx"))
+    {
+        *size = nbx;
+        *offset = nbu;
+    }
+    else if (!strcmp(field, "ubx"))
+    {
+        *size = nbx;
+        *offset = nb + ng + nh + nbxd + nbu;
+    }
+    else if (!strcmp(field, "lbu"))
+    {
+        *size = nbu;
+        *offset = 0;
+    }
+    else if (!strcmp(field, "ubu"))
+    {
+        *size = nbu;
+        *offset = nb + ng + nh + nbxd;
+    }
+    else if (!strcmp(field, "lg"))
+    {
+        *size = ng;
+        *offset = nb;
+    }
+    else if (!strcmp(field, "ug"))
+    {
+        *size = ng;
+        *offset = 2*nb+ng+nh+nbxd;
+    }
+    else if (!strcmp(field, "lh"))
+    {
+        *size = nh;
+        *offset = nb+ng;
+    }
+    else if (!strcmp(field, "uh"))
+    {
+        *size = nh;
+        *offset = 2*nb+2*ng+nh+nbxd;
+    }
+    else if (!strcmp(field, "lbxd"))
+    {
+        *size = nbxd;
+        *offset = nb+ng+nh;
+    }
+    else if (!strcmp(field, "ubxd"))
+    {
+        *size = nbxd;
+        *offset = 2*nb+2*ng+2*nh+nbxd;
+    }
+    else if (!strcmp(field, "lsbu"))
+    {
+        *size = nsbu;
+        *offset = 2*nb+2*ng+2*nh+2*nbxd;
+    }
+    else if (!strcmp(field, "usbu"))
+    {
+        *size = nsbu;
+        *offset = 2*nb+2*ng+2*nh+2*nbxd+ns;
+    }
+    else if (!strcmp(field, "lsbx"))
+    {
+        *size = nsbx;
+        *offset = 2*nb+2*ng+2*nh+2*nbxd+nsbu;
+    }
+    else if (!strcmp(field, "usbx"))
+    {
+        *size = nsbx;
+        *offset = 2*nb+2*ng+2*nh+2*nbxd+ns+nsbu;
+    }
+    else if (!strcmp(field, "lsg"))
+    {
+        *size = nsg;
+        *offset = 2*nb+2*ng+2*nh+2*nbxd+nsbu+nsbx;
+    }
+    else if (!strcmp(field, "usg"))
+    {
+        *size = nsg;
+        *offset = 2*nb+2*ng+2*nh+2*nbxd+ns+nsbu+nsbx;
+    }
+    else if (!strcmp(field, "lsh"))
+    {
+        *size = nsh;
+        *offset = 2*nb+2*ng+2*nh+2*nbxd+nsbu+nsbx+nsg;
+    }
+    else if (!strcmp(field, "ush"))
+    {
+        *size = nsh;
+        *offset = 2*nb+2*ng+2*nh+2*nbxd+ns+nsbu+nsbx+nsg;
+    }
+    else
+    {
+        return ACADOS_FAILURE;
+    }
+
+    return ACADOS_SUCCESS;
+}
+
+
+
 int ocp_nlp_constraints_bgh_model_set(void *config_, void *dims_,
                          void *model_, const char *field, void *value)
 {
@@ -644,10 +808,7 @@ int ocp_nlp_constraints_bgh_model_set(void *config_, void *dims_,
 
     int nu = dims->nu;
     int nx = dims->nx;
-    int nb = dims->nb;
     int ng = dims->ng;
-    int nh = dims->nh;
-    int ns = dims->ns;
     int nsbu = dims->nsbu;
     int nsbx = dims->nsbx;
     int nsg = dims->nsg;
@@ -658,15 +819,16 @@ int ocp_nlp_constraints_bgh_model_set(void *config_, void *dims_,
     int nbxe = dims->nbxe;
     int nge = dims->nge;
     int nhe = dims->nhe;
+    int nbxd = dims->nbxd;
 
     // TODO(oj): document which strings mean what! - adapted from prev implementation..
-    if (!strcmp(field, "lb")) // TODO remove !!!
-    {
-        blasfeo_pack_dvec(nb, value, &model->d, 0);
-    }
-    else if (!strcmp(field, "ub")) // TODO remove !!!
+    struct blasfeo_dvec *vec;
+    int offset, size;
+
+    if (ocp_nlp_constraints_bgh_model_get_dvec_ptr(config_, dims_, model_, field, &vec, &offset,
+            &size) == ACADOS_SUCCESS)
     {
-        blasfeo_pack_dvec(nb, value, &model->d, nb+ng+nh);
+        blasfeo_pack_dvec(size, value, vec, offset);
     }
     else if (!strcmp(field, "idxbx"))
     {
@@ -674,27 +836,17 @@ int ocp_nlp_constraints_bgh_model_set(void *config_, void *dims_,
         for (ii=0; ii < nbx; ii++)
             model->idxb[nbu+ii] = nu+ptr_i[ii];
     }
-    else if (!strcmp(field, "lbx"))
-    {
-        blasfeo_pack_dvec(nbx, value, &model->d, nbu);
-    }
-    else if (!strcmp(field, "ubx"))
-    {
-        blasfeo_pack_dvec(nbx, value, &model->d, nb + ng + nh + nbu);
-    }
     else if (!strcmp(field, "idxbu"))
     {
         ptr_i = (int *) value;
         for (ii=0; ii < nbu; ii++)
             model->idxb[ii] = ptr_i[ii];
     }
-    else if (!strcmp(field, "lbu"))
-    {
-        blasfeo_pack_dvec(nbu, value, &model->d, 0);
-    }
-    else if (!strcmp(field, "ubu"))
+    else if (!strcmp(field, "idxbxd"))
     {
-        blasfeo_pack_dvec(nbu, value, &model->d, nb + ng + nh);
+        ptr_i = (int *) value;
+        for (ii=0; ii < nbxd; ii++)
+            model->idxbxd[ii] = ptr_i[ii];
     }
     else if (!strcmp(field, "C"))
     {
@@ -704,14 +856,6 @@ int ocp_nlp_constraints_bgh_model_set(void *config_, void *dims_,
     {
         blasfeo_pack_tran_dmat(ng, nu, value, ng, &model->DCt, 0, 0);
     }
-    else if (!strcmp(field, "lg"))
-    {
-        blasfeo_pack_dvec(ng, value, &model->d, nb);
-    }
-    else if (!strcmp(field, "ug"))
-    {
-        blasfeo_pack_dvec(ng, value, &model->d, 2*nb+ng+nh);
-    }
     else if (!strcmp(field, "nl_constr_h_fun"))
     {
         model->nl_constr_h_fun = value;
@@ -724,70 +868,30 @@ int ocp_nlp_constraints_bgh_model_set(void *config_, void *dims_,
     {
         model->nl_constr_h_fun_jac_hess = value;
     }
-    else if (!strcmp(field, "lh"))
-    {
-        blasfeo_pack_dvec(nh, value, &model->d, nb+ng);
-    }
-    else if (!strcmp(field, "uh"))
-    {
-        blasfeo_pack_dvec(nh, value, &model->d, 2*nb+2*ng+nh);
-    }
     else if (!strcmp(field, "idxsbu"))
     {
         ptr_i = (int *) value;
         for (ii=0; ii < nsbu; ii++)
             model->idxs[ii] = ptr_i[ii];
     }
-    else if (!strcmp(field, "lsbu"))
-    {
-        blasfeo_pack_dvec(nsbu, value, &model->d, 2*nb+2*ng+2*nh);
-    }
-    else if (!strcmp(field, "usbu"))
-    {
-        blasfeo_pack_dvec(nsbu, value, &model->d, 2*nb+2*ng+2*nh+ns);
-    }
     else if (!strcmp(field, "idxsbx"))
     {
         ptr_i = (int *) value;
         for (ii=0; ii < nsbx; ii++)
             model->idxs[nsbu+ii] = nbu+ptr_i[ii];
     }
-    else if (!strcmp(field, "lsbx"))
-    {
-        blasfeo_pack_dvec(nsbx, value, &model->d, 2*nb+2*ng+2*nh+nsbu);
-    }
-    else if (!strcmp(field, "usbx"))
-    {
-        blasfeo_pack_dvec(nsbx, value, &model->d, 2*nb+2*ng+2*nh+ns+nsbu);
-    }
     else if (!strcmp(field, "idxsg"))
     {
         ptr_i = (int *) value;
         for (ii=0; ii < nsg; ii++)
             model->idxs[nsbu+nsbx+ii] = nbu+nbx+ptr_i[ii];
     }
-    else if (!strcmp(field, "lsg"))
-    {
-        blasfeo_pack_dvec(nsg, value, &model->d, 2*nb+2*ng+2*nh+nsbu+nsbx);
-    }
-    else if (!strcmp(field, "usg"))
-    {
-        blasfeo_pack_dvec(nsg, value, &model->d, 2*nb+2*ng+2*nh+ns+nsbu+nsbx);
-    }
     else if (!strcmp(field, "idxsh"))
     {
         ptr_i = (int *) value;
         for (ii=0; ii < nsh; ii++)
             model->idxs[nsbu+nsbx+nsg+ii] = nbu+nbx+ng+ptr_i[ii];
     }
-    else if (!strcmp(field, "lsh"))
-    {
-        blasfeo_pack_dvec(nsh, value, &model->d, 2*nb+2*ng+2*nh+nsbu+nsbx+nsg);
-    }
-    else if (!strcmp(field, "ush"))
-    {
-        blasfeo_pack_dvec(nsh, value, &model->d, 2*nb+2*ng+2*nh+ns+nsbu+nsbx+nsg);
-    }
     else if (!strcmp(field, "idxbue"))
     {
         ptr_i = (int *) value;
@@ -914,13 +1018,14 @@ int ocp_nlp_constraints_bgh_memory_calculate_size(void *config_, void *dims_, vo
     int nb = dims->nb;
     int ng = dims->ng;
     int nh = dims->nh;
+    int nbxd = dims->nbxd;
     int ns = dims->ns;
 
     int size = 0;
 
     size += sizeof(ocp_nlp_constraints_bgh_memory);
 
-    size += 1 * blasfeo_memsize_dvec(2 * nb + 2 * ng + 2 * nh + 2 * ns);  // fun
+    size += 1 * blasfeo_memsize_dvec(2 * nb + 2 * ng + 2 * nh + 2 * nbxd + 2 * ns);  // fun
     size += 1 * blasfeo_memsize_dvec(nu + nx + 2 * ns);                   // adj
 
     size += 1 * 64;  // blasfeo_mem align
@@ -946,6 +1051,7 @@ void *ocp_nlp_constraints_bgh_memory_assign(void *config_, void *dims_, void *op
     int nb = dims->nb;
     int ng = dims->ng;
     int nh = dims->nh;
+    int nbxd = dims->nbxd;
     int ns = dims->ns;
 
     // struct
@@ -958,7 +1064,8 @@ void *ocp_nlp_constraints_bgh_memory_assign(void *config_, void *dims_, void *op
     align_char_to(64, &c_ptr);
 
     // fun
-    assign_and_advance_blasfeo_dvec_mem(2 * nb + 2 * ng + 2 * nh + 2 * ns, &memory->fun, &c_ptr);
+    assign_and_advance_blasfeo_dvec_mem(2 * nb + 2 * ng + 2 * nh + 2 * nbxd + 2 * ns, &memory->fun,
+                                        &c_ptr);
     // adj
     assign_and_advance_blasfeo_dvec_mem(nu + nx + 2 * ns, &memory->adj, &c_ptr);
 
@@ -1062,6 +1169,25 @@ void ocp_nlp_constraints_bgh_memory_set_dzduxt_ptr(struct blasfeo_dmat *dzduxt,
 
 
 
+void ocp_nlp_constraints_bgh_memory_set_x_dense_ptr(struct blasfeo_dvec *x_dense, void *memory_)
+{
+    ocp_nlp_constraints_bgh_memory *memory = memory_;
+
+    memory->x_dense = x_dense;
+}
+
+
+
+void ocp_nlp_constraints_bgh_memory_set_dxdenseduxt_ptr(struct blasfeo_dmat *dxdenseduxt,
+                                                        void *memory_)
+{
+    ocp_nlp_constraints_bgh_memory *memory = memory_;
+
+    memory->dxdenseduxt = dxdenseduxt;
+}
+
+
+
 void ocp_nlp_constraints_bgh_memory_set_idxb_ptr(int *idxb, void *memory_)
 {
     ocp_nlp_constraints_bgh_memory *memory = memory_;
@@ -1104,6 +1230,7 @@ int ocp_nlp_constraints_bgh_workspace_calculate_size(void *config_, void *dims_,
     int nb = dims->nb;
     int ng = dims->ng;
     int nh = dims->nh;
+    int nbxd = dims->nbxd;
     int ns = dims->ns;
 
     int size = 0;
@@ -1115,7 +1242,7 @@ int ocp_nlp_constraints_bgh_workspace_calculate_size(void *config_, void *dims_,
     size += 1 * blasfeo_memsize_dmat(nz, nx+nu);       // tmp_nz_nv
     size += 1 * blasfeo_memsize_dmat(nx+nu, nh);    // tmp_nv_nh
     size += 1 * blasfeo_memsize_dmat(nz, nz);    // hess_z
-    size += 1 * blasfeo_memsize_dvec(nb+ng+nh+ns);  // tmp_ni
+    size += 1 * blasfeo_memsize_dvec(nb+ng+nh+nbxd+ns);  // tmp_ni
     size += 1 * blasfeo_memsize_dvec(nh);           // tmp_nh
 
     size += 1 * 64;                                 // blasfeo_mem align
@@ -1137,6 +1264,7 @@ static void ocp_nlp_constraints_bgh_cast_workspace(void *config_, void *dims_, v
     int nb = dims->nb;
     int ng = dims->ng;
     int nh = dims->nh;
+    int nbxd = dims->nbxd;
     int ns = dims->ns;
 
     char *c_ptr = (char *) work_;
@@ -1161,7 +1289,7 @@ static void ocp_nlp_constraints_bgh_cast_workspace(void *config_, void *dims_, v
     assign_and_advance_blasfeo_dmat_mem(nz, nx+nu, &work->tmp_nz_nv, &c_ptr);
 
     // tmp_ni
-    assign_and_advance_blasfeo_dvec_mem(nb+ng+nh+ns, &work->tmp_ni, &c_ptr);
+    assign_and_advance_blasfeo_dvec_mem(nb+ng+nh+nbxd+ns, &work->tmp_ni, &c_ptr);
 
     // tmp_nh
     assign_and_advance_blasfeo_dvec_mem(nh, &work->tmp_nh, &c_ptr);
@@ -1243,8 +1371,11 @@ void ocp_nlp_constraints_bgh_update_qp_matrices(void *config_, void *dims_, void
     int nb = dims->nb;
     int ng = dims->ng;
     int nh = dims->nh;
+    int nbxd = dims->nbxd;
     int ns = dims->ns;
 
+    int j;
+
     ext_fun_arg_t ext_fun_type_in[4];
     void *ext_fun_in[4];
     ext_fun_arg_t ext_fun_type_out[5];
@@ -1300,7 +1431,7 @@ void ocp_nlp_constraints_bgh_update_qp_matrices(void *config_, void *dims_, void
             mult_in.x = &work->tmp_nh;
             mult_in.xi = 0;
             // TODO check that it is (upper - lower) and  not the other way around
-            blasfeo_daxpy(nh, -1.0, memory->lam, nb+ng, memory->lam, 2*nb+2*ng+nh, &work->tmp_nh, 0);
+            blasfeo_daxpy(nh, -1.0, memory->lam, nb+ng, memory->lam, 2*nb+2*ng+nh+nbxd, &work->tmp_nh, 0);
            // blasfeo_daxpy(nh, -1.0, memory->lam, 2*nb+2*ng+nh, memory->lam, nb+ng, &work->tmp_nh, 0);
 //            blasfeo_daxpy(nh, 1.0, memory->lam, nb+ng, memory->lam, 2*nb+2*ng+nh, &work->tmp_nh, 0);
 
@@ -1394,6 +1525,15 @@ void ocp_nlp_constraints_bgh_update_qp_matrices(void *config_, void *dims_, void
         }
     }
 
+    // dense output states
+    if (nbxd > 0)
+    {
+        blasfeo_dvecex_sp(nbxd, 1.0, model->idxbxd, memory->x_dense, 0, &work->tmp_ni, nb+ng+nh);
+        // jacobian: columns of dxdenseduxt selected by idxbxd, no hessian contribution
+        for (j = 0; j < nbxd; j++)
+            blasfeo_dgecp(nu+nx, 1, memory->dxdenseduxt, 0, model->idxbxd[j], memory->DCt, 0, ng+nh+j);
+    }
+
     if (nz > 0)
     {
         // update memory->fun wrt z
@@ -1401,29 +1541,29 @@ void ocp_nlp_constraints_bgh_update_qp_matrices(void *config_, void *dims_, void
                         &memory->fun, 0, &memory->fun, 0);
     }
 
-    blasfeo_daxpy(nb+ng+nh, -1.0, &work->tmp_ni, 0, &model->d, 0, &memory->fun, 0);
-    blasfeo_daxpy(nb+ng+nh, -1.0, &model->d, nb+ng+nh, &work->tmp_ni, 0, &memory->fun, nb+ng+nh);
+    blasfeo_daxpy(nb+ng+nh+nbxd, -1.0, &work->tmp_ni, 0, &model->d, 0, &memory->fun, 0);
+    blasfeo_daxpy(nb+ng+nh+nbxd, -1.0, &model->d, nb+ng+nh+nbxd, &work->tmp_ni, 0, &memory->fun, nb+ng+nh+nbxd);
 
     // soft
     // subtract slacks from softened constraints
     // fun_i = fun_i - slack_i for i \in I_slacked
     blasfeo_dvecad_sp(ns, -1.0, memory->ux, nu+nx, model->idxs, &memory->fun, 0);
-    blasfeo_dvecad_sp(ns, -1.0, memory->ux, nu+nx+ns, model->idxs, &memory->fun, nb+ng+nh);
+    blasfeo_dvecad_sp(ns, -1.0, memory->ux, nu+nx+ns, model->idxs, &memory->fun, nb+ng+nh+nbxd);
 
     // fun[2*ni:end] = - slack + slack_bounds
-    blasfeo_daxpy(2*ns, -1.0, memory->ux, nu+nx, &model->d, 2*nb+2*ng+2*nh, &memory->fun, 2*nb+2*ng+2*nh);
+    blasfeo_daxpy(2*ns, -1.0, memory->ux, nu+nx, &model->d, 2*nb+2*ng+2*nh+2*nbxd, &memory->fun, 2*nb+2*ng+2*nh+2*nbxd);
 
     // nlp_mem: ineq_adj
     if (opts->compute_adj)
     {
         blasfeo_dvecse(nu+nx+2*ns, 0.0, &memory->adj, 0);
-        blasfeo_daxpy(nb+ng+nh, -1.0, memory->lam, nb+ng+nh, memory->lam, 0, &work->tmp_ni, 0);
+        blasfeo_daxpy(nb+ng+nh+nbxd, -1.0, memory->lam, nb+ng+nh+nbxd, memory->lam, 0, &work->tmp_ni, 0);
         blasfeo_dvecad_sp(nb, 1.0, &work->tmp_ni, 0, model->idxb, &memory->adj, 0);
-        blasfeo_dgemv_n(nu+nx, ng+nh, 1.0, memory->DCt, 0, 0, &work->tmp_ni, nb, 1.0, &memory->adj, 0, &memory->adj, 0);
+        blasfeo_dgemv_n(nu+nx, ng+nh+nbxd, 1.0, memory->DCt, 0, 0, &work->tmp_ni, nb, 1.0, &memory->adj, 0, &memory->adj, 0);
         // soft
         blasfeo_dvecex_sp(ns, 1.0, model->idxs, memory->lam, 0, &memory->adj, nu+nx);
-        blasfeo_dvecex_sp(ns, 1.0, model->idxs, memory->lam, nb+ng+nh, &memory->adj, nu+nx+ns);
-        blasfeo_daxpy(2*ns, 1.0, memory->lam, 2*nb+2*ng+2*nh, &memory->adj, nu+nx, &memory->adj, nu+nx);
+        blasfeo_dvecex_sp(ns, 1.0, model->idxs, memory->lam, nb+ng+nh+nbxd, &memory->adj, nu+nx+ns);
+        blasfeo_daxpy(2*ns, 1.0, memory->lam, 2*nb+2*ng+2*nh+2*nbxd, &memory->adj, nu+nx, &memory->adj, nu+nx);
     }
 
     return;
@@ -1449,6 +1589,7 @@ void ocp_nlp_constraints_bgh_compute_fun(void *config_, void *dims_, void *model
     int nb = dims->nb;
     int ng = dims->ng;
     int nh = dims->nh;
+    int nbxd = dims->nbxd;
     int ns = dims->ns;
 
     ext_fun_arg_t ext_fun_type_in[3];
@@ -1509,16 +1650,22 @@ void ocp_nlp_constraints_bgh_compute_fun(void *config_, void *dims_, void *model
 
     }
 
+    // dense output states
+    if (nbxd > 0)
+    {
+        blasfeo_dvecex_sp(nbxd, 1.0, model->idxbxd, memory->x_dense, 0, &work->tmp_ni, nb+ng+nh);
+    }
+
     // lower
-    blasfeo_daxpy(nb+ng+nh, -1.0, &work->tmp_ni, 0, &model->d, 0, &memory->fun, 0);
+    blasfeo_daxpy(nb+ng+nh+nbxd, -1.0, &work->tmp_ni, 0, &model->d, 0, &memory->fun, 0);
     // upper
-    blasfeo_daxpy(nb+ng+nh, -1.0, &model->d, nb+ng+nh, &work->tmp_ni, 0, &memory->fun, nb+ng+nh);
+    blasfeo_daxpy(nb+ng+nh+nbxd, -1.0, &model->d, nb+ng+nh+nbxd, &work->tmp_ni, 0, &memory->fun, nb+ng+nh+nbxd);
 
     // soft
-    blasfeo_dvecad_sp(ns, -1.0, memory->ux, nu+nx, model->idxs, &memory->fun, 0);
-    blasfeo_dvecad_sp(ns, -1.0, memory->ux, nu+nx+ns, model->idxs, &memory->fun, nb+ng+nh);
+    blasfeo_dvecad_sp(ns, -1.0, memory->tmp_ux, nu+nx, model->idxs, &memory->fun, 0);
+    blasfeo_dvecad_sp(ns, -1.0, memory->tmp_ux, nu+nx+ns, model->idxs, &memory->fun, nb+ng+nh+nbxd);
 
-    blasfeo_daxpy(2*ns, -1.0, memory->ux, nu+nx, &model->d, 2*nb+2*ng+2*nh, &memory->fun, 2*nb+2*ng+2*nh);
+    blasfeo_daxpy(2*ns, -1.0, memory->tmp_ux, nu+nx, &model->d, 2*nb+2*ng+2*nh+2*nbxd, &memory->fun, 2*nb+2*ng+2*nh+2*nbxd);
 
     return;
 }
@@ -1542,12 +1689,13 @@ void ocp_nlp_constraints_bgh_bounds_update(void *config_, void *dims_, void *mod
     int nb = dims->nb;
     int ng = dims->ng;
     int nh = dims->nh;
+    int nbxd = dims->nbxd;
 
     // box
     blasfeo_dvecex_sp(nb, 1.0, model->idxb, memory->ux, 0, &work->tmp_ni, 0);
 
     blasfeo_daxpy(nb, -1.0, &work->tmp_ni, 0, &model->d, 0, &memory->fun, 0);
-    blasfeo_daxpy(nb, -1.0, &model->d, nb+ng+nh, &work->tmp_ni, 0, &memory->fun, nb+ng+nh);
+    blasfeo_daxpy(nb, -1.0, &model->d, nb+ng+nh+nbxd, &work->tmp_ni, 0, &memory->fun, nb+ng+nh+nbxd);
 
     return;
 }
@@ -1567,6 +1715,7 @@ void ocp_nlp_constraints_bgh_config_initialize_default(void *config_)
     config->model_calculate_size = &ocp_nlp_constraints_bgh_model_calculate_size;
     config->model_assign = &ocp_nlp_constraints_bgh_model_assign;
     config->model_set = &ocp_nlp_constraints_bgh_model_set;
+    config->model_get_dvec_ptr = &ocp_nlp_constraints_bgh_model_get_dvec_ptr;
     config->opts_calculate_size = &ocp_nlp_constraints_bgh_opts_calculate_size;
     config->opts_assign = &ocp_nlp_constraints_bgh_opts_assign;
     config->opts_initialize_default = &ocp_nlp_constraints_bgh_opts_initialize_default;
@@ -1584,6 +1733,8 @@ void ocp_nlp_constraints_bgh_config_initialize_default(void *config_)
     config->memory_set_RSQrq_ptr = &ocp_nlp_constraints_bgh_memory_set_RSQrq_ptr;
     config->memory_set_z_alg_ptr = &ocp_nlp_constraints_bgh_memory_set_z_alg_ptr;
     config->memory_set_dzdux_tran_ptr = &ocp_nlp_constraints_bgh_memory_set_dzduxt_ptr;
+    config->memory_set_x_dense_ptr = &ocp_nlp_constraints_bgh_memory_set_x_dense_ptr;
+    config->memory_set_dxdense_dux_tran_ptr = &ocp_nlp_constraints_bgh_memory_set_dxdenseduxt_ptr;
     config->memory_set_idxb_ptr = &ocp_nlp_constraints_bgh_memory_set_idxb_ptr;
     config->memory_set_idxs_rev_ptr = &ocp_nlp_constraints_bgh_memory_set_idxs_rev_ptr;
     config->memory_set_idxe_ptr = &ocp_nlp_constraints_bgh_memory_set_idxe_ptr;
@@ -75,6 +75,7 @@ typedef struct
     int nbxe; // number of state box constraints which are equality
     int nge;  // number of general linear constraints which are equality
     int nhe;  // number of nonlinear path constraints which are equality
+    int nbxd; // number of bounds on the integrator dense output states
 } ocp_nlp_constraints_bgh_dims;
 
 //
@@ -100,6 +101,7 @@ typedef struct
     int *idxb;
     int *idxs;
     int *idxe;
+    int *idxbxd;  // indices into the stacked dense output states x_dense
     struct blasfeo_dvec d;  // gathers bounds
     struct blasfeo_dmat DCt;  // general linear constraint matrix
             // lg <= [D, C] * [u; x] <= ug
@@ -115,6 +117,9 @@ void *ocp_nlp_constraints_bgh_model_assign(void *config, void *dims, void *raw_m
 //
 int ocp_nlp_constraints_bgh_model_set(void *config_, void *dims_,
                          void *model_, const char *field, void *value);
+//
+int ocp_nlp_constraints_bgh_model_get_dvec_ptr(void *config_, void *dims_, void *model_,
+        const char *field, struct blasfeo_dvec **vec, int *offset, int *size);
 
 
 
@@ -157,6 +162,8 @@ typedef struct
     struct blasfeo_dmat *DCt;    // pointer to DCt in qp_in
     struct blasfeo_dmat *RSQrq;  // pointer to RSQrq in qp_in
     struct blasfeo_dmat *dzduxt; // pointer to dzduxt in ocp_nlp memory
+    struct blasfeo_dvec *x_dense;      // pointer to x_dense in ocp_nlp memory
+    struct blasfeo_dmat *dxdenseduxt;  // pointer to dxdenseduxt in ocp_nlp memory
     int *idxb;                   // pointer to idxb[ii] in qp_in
     int *idxs_rev;               // pointer to idxs_rev[ii] in qp_in
     int *idxe;                   // pointer to idxe[ii] in qp_in
@@ -187,6 +194,11 @@ void ocp_nlp_constraints_bgh_memory_set_z_alg_ptr(struct blasfeo_dvec *z_alg, vo
 //
 void ocp_nlp_constraints_bgh_memory_set_dzduxt_ptr(struct blasfeo_dmat *dzduxt, void *memory_);
 //
+void ocp_nlp_constraints_bgh_memory_set_x_dense_ptr(struct blasfeo_dvec *x_dense, void *memory_);
+//
+void ocp_nlp_constraints_bgh_memory_set_dxdenseduxt_ptr(struct blasfeo_dmat *dxdenseduxt,
+                                                        void *memory_);
+//
 void ocp_nlp_constraints_bgh_memory_set_idxb_ptr(int *idxb, void *memory_);
 //
 void ocp_nlp_constraints_bgh_memory_set_idxs_rev_ptr(int *idxs_rev, void *memory_);
@@ -623,6 +623,125 @@ void *ocp_nlp_constraints_bgp_model_assign(void *config, void *dims_, void *raw_
 }
 
 
+int ocp_nlp_constraints_bgp_model_get_dvec_ptr(void *config_, void *dims_, void *model_,
+        const char *field, struct blasfeo_dvec **vec, int *offset, int *size)
+{
+    ocp_nlp_constraints_bgp_dims *dims = (ocp_nlp_constraints_bgp_dims *) dims_;
+    ocp_nlp_constraints_bgp_model *model = (ocp_nlp_constraints_bgp_model *) model_;
+
+    int nb = dims->nb;
+    int ng = dims->ng;
+    int nphi = dims->nphi;
+    int ns = dims->ns;
+    int nsbu = dims->nsbu;
+    int nsbx = dims->nsbx;
+    int nsg = dims->nsg;
+    int nsphi = dims->nsphi;
+    int nbx = dims->nbx;
+    int nbu = dims->nbu;
+
+    *vec = &model->d;
+
+    if (!strcmp(field, "lb")) // TODO(fuck_lint) remove !!!
+    {
+        *size = nb;
+        *offset = 0;
+    }
+    else if (!strcmp(field, "ub")) // TODO(fuck_lint) remove !!!
+    {
+        *size = nb;
+        *offset = nb+ng+nphi;
+    }
+    else if (!strcmp(field, "lbx"))
+    {
+        *size = nbx;
+        *offset = nbu;
+    }
+    else if (!strcmp(field, "ubx"))
+    {
+        *size = nbx;
+        *offset = nb + ng + nphi + nbu;
+    }
+    else if (!strcmp(field, "lbu"))
+    {
+        *size = nbu;
+        *offset = 0;
+    }
+    else if (!strcmp(field, "ubu"))
+    {
+        *size = nbu;
+        *offset = nb + ng + nphi;
+    }
+    else if (!strcmp(field, "lg"))
+    {
+        *size = ng;
+        *offset = nb;
+    }
+    else if (!strcmp(field, "ug"))
+    {
+        *size = ng;
+        *offset = 2*nb+ng+nphi;
+    }
+    else if (!strcmp(field, "lphi")) // TODO(fuck_lint) remove
+    {
+        *size = nphi;
+        *offset = nb+ng;
+    }
+    else if (!strcmp(field, "uphi"))
+    {
+        *size = nphi;
+        *offset = 2*nb+2*ng+nphi;
+    }
+    else if (!strcmp(field, "lsbu"))
+    {
+        *size = nsbu;
+        *offset = 2*nb+2*ng+2*nphi;
+    }
+    else if (!strcmp(field, "usbu"))
+    {
+        *size = nsbu;
+        *offset = 2*nb+2*ng+2*nphi+ns;
+    }
+    else if (!strcmp(field, "lsbx"))
+    {
+        *size = nsbx;
+        *offset = 2*nb+2*ng+2*nphi+nsbu;
+    }
+    else if (!strcmp(field, "usbx"))
+    {
+        *size = nsbx;
+        *offset = 2*nb+2*ng+2*nphi+ns+nsbu;
+    }
+    else if (!strcmp(field, "lsg"))
+    {
+        *size = nsg;
+        *offset = 2*nb+2*ng+2*nphi+nsbu+nsbx;
+    }
+    else if (!strcmp(field, "usg"))
+    {
+        *size = nsg;
+        *offset = 2*nb+2*ng+2*nphi+ns+nsbu+nsbx;
+    }
+    else if (!strcmp(field, "lsphi"))
+    {
+        *size = nsphi;
+        *offset = 2*nb+2*ng+2*nphi+nsbu+nsbx+nsg;
+    }
+    else if (!strcmp(field, "usphi"))
+    {
+        *size = nsphi;
+        *offset = 2*nb+2*ng+2*nphi+ns+nsbu+nsbx+nsg;
+    }
+    else
+    {
+        return ACADOS_FAILURE;
+    }
+
+    return ACADOS_SUCCESS;
+}
+
+
+
 int ocp_nlp_constraints_bgp_model_set(void *config_, void *dims_,
                          void *model_, const char *field, void *value)
 {
@@ -641,10 +760,7 @@ int ocp_nlp_constraints_bgp_model_set(void *config_, void *dims_,
 
     int nu = dims->nu;
     int nx = dims->nx;
-    int nb = dims->nb;
     int ng = dims->ng;
-    int nphi = dims->nphi;
-    int ns = dims->ns;
     int nsbu = dims->nsbu;
     int nsbx = dims->nsbx;
     int nsg = dims->nsg;
@@ -656,13 +772,13 @@ int ocp_nlp_constraints_bgp_model_set(void *config_, void *dims_,
     int nge = dims->nge;
     int nphie = dims->nphie;
 
-    if (!strcmp(field, "lb")) // TODO(fuck_lint) remove !!!
-    {
-        blasfeo_pack_dvec(nb, value, &model->d, 0);
-    }
-    else if (!strcmp(field, "ub")) // TODO(fuck_lint) remove !!!
+    struct blasfeo_dvec *vec;
+    int offset, size;
+
+    if (ocp_nlp_constraints_bgp_model_get_dvec_ptr(config_, dims_, model_, field, &vec, &offset,
+            &size) == ACADOS_SUCCESS)
     {
-        blasfeo_pack_dvec(nb, value, &model->d, nb+ng+nphi);
+        blasfeo_pack_dvec(size, value, vec, offset);
     }
     else if (!strcmp(field, "idxbx"))
     {
@@ -670,28 +786,12 @@ int ocp_nlp_constraints_bgp_model_set(void *config_, void *dims_,
         for (ii=0; ii < nbx; ii++)
             model->idxb[nbu+ii] = nu+ptr_i[ii];
     }
-    else if (!strcmp(field, "lbx"))
-    {
-        blasfeo_pack_dvec(nbx, value, &model->d, nbu);
-    }
-    else if (!strcmp(field, "ubx"))
-    {
-        blasfeo_pack_dvec(nbx, value, &model->d, nb + ng + nphi + nbu);
-    }
     else if (!strcmp(field, "idxbu"))
     {
         ptr_i = (int *) value;
         for (ii=0; ii < nbu; ii++)
             model->idxb[ii] = ptr_i[ii];
     }
-    else if (!strcmp(field, "lbu"))
-    {
-        blasfeo_pack_dvec(nbu, value, &model->d, 0);
-    }
-    else if (!strcmp(field, "ubu"))
-    {
-        blasfeo_pack_dvec(nbu, value, &model->d, nb + ng + nphi);
-    }
     else if (!strcmp(field, "C"))
     {
         blasfeo_pack_tran_dmat(ng, nx, value, ng, &model->DCt, nu, 0);
@@ -700,14 +800,6 @@ int ocp_nlp_constraints_bgp_model_set(void *config_, void *dims_,
     {
         blasfeo_pack_tran_dmat(ng, nu, value, ng, &model->DCt, 0, 0);
     }
-    else if (!strcmp(field, "lg"))
-    {
-        blasfeo_pack_dvec(ng, value, &model->d, nb);
-    }
-    else if (!strcmp(field, "ug"))
-    {
-        blasfeo_pack_dvec(ng, value, &model->d, 2*nb+ng+nphi);
-    }
     else if (!strcmp(field, "nl_constr_phi_o_r_fun_phi_jac_ux_z_phi_hess_r_jac_ux"))
     {
         model->nl_constr_phi_o_r_fun_phi_jac_ux_z_phi_hess_r_jac_ux = value;
@@ -716,70 +808,30 @@ int ocp_nlp_constraints_bgp_model_set(void *config_, void *dims_,
     {
         model->nl_constr_phi_o_r_fun = value;
     }
-    else if (!strcmp(field, "lphi")) // TODO(fuck_lint) remove
-    {
-        blasfeo_pack_dvec(nphi, value, &model->d, nb+ng);
-    }
-    else if (!strcmp(field, "uphi"))
-    {
-        blasfeo_pack_dvec(nphi, value, &model->d, 2*nb+2*ng+nphi);
-    }
     else if (!strcmp(field, "idxsbu"))
     {
         ptr_i = (int *) value;
         for (ii=0; ii < nsbu; ii++)
             model->idxs[ii] = ptr_i[ii];
     }
-    else if (!strcmp(field, "lsbu"))
-    {
-        blasfeo_pack_dvec(nsbu, value, &model->d, 2*nb+2*ng+2*nphi);
-    }
-    else if (!strcmp(field, "usbu"))
-    {
-        blasfeo_pack_dvec(nsbu, value, &model->d, 2*nb+2*ng+2*nphi+ns);
-    }
     else if (!strcmp(field, "idxsbx"))
     {
         ptr_i = (int *) value;
         for (ii=0; ii < nsbx; ii++)
             model->idxs[nsbu+ii] = nbu+ptr_i[ii];
     }
-    else if (!strcmp(field, "lsbx"))
-    {
-        blasfeo_pack_dvec(nsbx, value, &model->d, 2*nb+2*ng+2*nphi+nsbu);
-    }
-    else if (!strcmp(field, "usbx"))
-    {
-        blasfeo_pack_dvec(nsbx, value, &model->d, 2*nb+2*ng+2*nphi+ns+nsbu);
-    }
     else if (!strcmp(field, "idxsg"))
     {
         ptr_i = (int *) value;
         for (ii=0; ii < nsg; ii++)
             model->idxs[nsbu+nsbx+ii] = nbu+nbx+ptr_i[ii];
     }
-    else if (!strcmp(field, "lsg"))
-    {
-        blasfeo_pack_dvec(nsg, value, &model->d, 2*nb+2*ng+2*nphi+nsbu+nsbx);
-    }
-    else if (!strcmp(field, "usg"))
-    {
-        blasfeo_pack_dvec(nsg, value, &model->d, 2*nb+2*ng+2*nphi+ns+nsbu+nsbx);
-    }
     else if (!strcmp(field, "idxsphi"))
     {
         ptr_i = (int *) value;
         for (ii=0; ii < nsphi; ii++)
             model->idxs[nsbu+nsbx+nsg+ii] = nbu+nbx+ng+ptr_i[ii];
     }
-    else if (!strcmp(field, "lsphi"))
-    {
-        blasfeo_pack_dvec(nsphi, value, &model->d, 2*nb+2*ng+2*nphi+nsbu+nsbx+nsg);
-    }
-    else if (!strcmp(field, "usphi"))
-    {
-        blasfeo_pack_dvec(nsphi, value, &model->d, 2*nb+2*ng+2*nphi+ns+nsbu+nsbx+nsg);
-    }
     else if (!strcmp(field, "idxbue"))
     {
         ptr_i = (int *) value;
@@ -1046,6 +1098,21 @@ void ocp_nlp_constraints_bgp_memory_set_dzduxt_ptr(struct blasfeo_dmat *dzduxt,
 
 
 
+void ocp_nlp_constraints_bgp_memory_set_x_dense_ptr(struct blasfeo_dvec *x_dense, void *memory_)
+{
+    return;  // dense output constraints are only available in the bgh module
+}
+
+
+
+void ocp_nlp_constraints_bgp_memory_set_dxdenseduxt_ptr(struct blasfeo_dmat *dxdenseduxt,
+                                                        void *memory_)
+{
+    return;  // dense output constraints are only available in the bgh module
+}
+
+
+
 
 void ocp_nlp_constraints_bgp_memory_set_idxb_ptr(int *idxb, void *memory_)
 {
@@ -1448,10 +1515,10 @@ void ocp_nlp_constraints_bgp_compute_fun(void *config_, void *dims_, void *model
     blasfeo_daxpy(nb+ng+nphi, -1.0, &model->d, nb+ng+nphi, &work->tmp_ni, 0, &memory->fun, nb+ng+nphi);
 
     // soft
-    blasfeo_dvecad_sp(ns, -1.0, memory->ux, nu+nx, model->idxs, &memory->fun, 0);
-    blasfeo_dvecad_sp(ns, -1.0, memory->ux, nu+nx+ns, model->idxs, &memory->fun, nb+ng+nphi);
+    blasfeo_dvecad_sp(ns, -1.0, memory->tmp_ux, nu+nx, model->idxs, &memory->fun, 0);
+    blasfeo_dvecad_sp(ns, -1.0, memory->tmp_ux, nu+nx+ns, model->idxs, &memory->fun, nb+ng+nphi);
 
-    blasfeo_daxpy(2*ns, -1.0, memory->ux, nu+nx, &model->d, 2*nb+2*ng+2*nphi, &memory->fun, 2*nb+2*ng+2*nphi);
+    blasfeo_daxpy(2*ns, -1.0, memory->tmp_ux, nu+nx, &model->d, 2*nb+2*ng+2*nphi, &memory->fun, 2*nb+2*ng+2*nphi);
 
     return;
 
@@ -1501,6 +1568,7 @@ void ocp_nlp_constraints_bgp_config_initialize_default(void *config_)
     config->model_calculate_size = &ocp_nlp_constraints_bgp_model_calculate_size;
     config->model_assign = &ocp_nlp_constraints_bgp_model_assign;
     config->model_set = &ocp_nlp_constraints_bgp_model_set;
+    config->model_get_dvec_ptr = &ocp_nlp_constraints_bgp_model_get_dvec_ptr;
     config->opts_calculate_size = &ocp_nlp_constraints_bgp_opts_calculate_size;
     config->opts_assign = &ocp_nlp_constraints_bgp_opts_assign;
     config->opts_initialize_default = &ocp_nlp_constraints_bgp_opts_initialize_default;
@@ -1518,6 +1586,8 @@ void ocp_nlp_constraints_bgp_config_initialize_default(void *config_)
     config->memory_set_RSQrq_ptr = &ocp_nlp_constraints_bgp_memory_set_RSQrq_ptr;
     config->memory_set_z_alg_ptr = &ocp_nlp_constraints_bgp_memory_set_z_alg_ptr;
     config->memory_set_dzdux_tran_ptr = &ocp_nlp_constraints_bgp_memory_set_dzduxt_ptr;
+    config->memory_set_x_dense_ptr = &ocp_nlp_constraints_bgp_memory_set_x_dense_ptr;
+    config->memory_set_dxdense_dux_tran_ptr = &ocp_nlp_constraints_bgp_memory_set_dxdenseduxt_ptr;
     config->memory_set_idxb_ptr = &ocp_nlp_constraints_bgp_memory_set_idxb_ptr;
     config->memory_set_idxs_rev_ptr = &ocp_nlp_constraints_bgp_memory_set_idxs_rev_ptr;
     config->memory_set_idxe_ptr = &ocp_nlp_constraints_bgp_memory_set_idxe_ptr;
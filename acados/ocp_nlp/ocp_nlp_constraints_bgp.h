@@ -109,6 +109,9 @@ void *ocp_nlp_constraints_bgp_assign(void *config, void *dims, void *raw_memory)
 //
 int ocp_nlp_constraints_bgp_model_set(void *config_, void *dims_,
                          void *model_, const char *field, void *value);
+//
+int ocp_nlp_constraints_bgp_model_get_dvec_ptr(void *config_, void *dims_, void *model_,
+        const char *field, struct blasfeo_dvec **vec, int *offset, int *size);
 
 /* options */
 
@@ -172,6 +175,11 @@ void ocp_nlp_constraints_bgp_memory_set_z_alg_ptr(struct blasfeo_dvec *z_alg, vo
 //
 void ocp_nlp_constraints_bgp_memory_set_dzduxt_ptr(struct blasfeo_dmat *dzduxt, void *memory_);
 //
+void ocp_nlp_constraints_bgp_memory_set_x_dense_ptr(struct blasfeo_dvec *x_dense, void *memory_);
+//
+void ocp_nlp_constraints_bgp_memory_set_dxdenseduxt_ptr(struct blasfeo_dmat *dxdenseduxt,
+                                                        void *memory_);
+//
 void ocp_nlp_constraints_bgp_memory_set_idxb_ptr(int *idxb, void *memory_);
 //
 void ocp_nlp_constraints_bgp_memory_set_idxs_rev_ptr(int *idxs_rev, void *memory_);
@@ -65,6 +65,9 @@ typedef struct
     int (*model_calculate_size)(void *config, void *dims);
     void *(*model_assign)(void *config, void *dims, void *raw_memory);
     int (*model_set)(void *config_, void *dims_, void *model_, const char *field, void *value);
+    // vector segment of a model field (e.g. bounds), ACADOS_FAILURE if the field is no such segment
+    int (*model_get_dvec_ptr)(void *config_, void *dims_, void *model_, const char *field,
+                              struct blasfeo_dvec **vec, int *offset, int *size);
     int (*opts_calculate_size)(void *config, void *dims);
     void *(*opts_assign)(void *config, void *dims, void *raw_memory);
     void (*opts_initialize_default)(void *config, void *dims, void *opts);
@@ -81,6 +84,8 @@ typedef struct
     void (*memory_set_RSQrq_ptr)(struct blasfeo_dmat *RSQrq, void *memory);
     void (*memory_set_z_alg_ptr)(struct blasfeo_dvec *z_alg, void *memory);
     void (*memory_set_dzdux_tran_ptr)(struct blasfeo_dmat *dzduxt, void *memory);
+    void (*memory_set_x_dense_ptr)(struct blasfeo_dvec *x_dense, void *memory);
+    void (*memory_set_dxdense_dux_tran_ptr)(struct blasfeo_dmat *dxdenseduxt, void *memory);
     void (*memory_set_idxb_ptr)(int *idxb, void *memory);
     void (*memory_set_idxs_rev_ptr)(int *idxs_rev, void *memory);
     void (*memory_set_idxe_ptr)(int *idxe, void *memory);
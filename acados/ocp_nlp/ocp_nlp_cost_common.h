@@ -68,6 +68,9 @@ typedef struct
     int (*model_calculate_size)(void *config, void *dims);
     void *(*model_assign)(void *config, void *dims, void *raw_memory);
     int (*model_set)(void *config_, void *dims_, void *model_, const char *field, void *value_);
+    // vector segment of a model field (e.g. y_ref), ACADOS_FAILURE if the field is no such segment
+    int (*model_get_dvec_ptr)(void *config_, void *dims_, void *model_, const char *field,
+                              struct blasfeo_dvec **vec, int *offset, int *size);
     int (*opts_calculate_size)(void *config, void *dims);
     void *(*opts_assign)(void *config, void *dims, void *raw_memory);
     void (*opts_initialize_default)(void *config, void *dims, void *opts);
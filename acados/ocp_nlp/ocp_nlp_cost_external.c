@@ -193,6 +193,48 @@ void *ocp_nlp_cost_external_model_assign(void *config_, void *dims_, void *raw_m
 
 
 
+int ocp_nlp_cost_external_model_get_dvec_ptr(void *config_, void *dims_, void *model_,
+        const char *field, struct blasfeo_dvec **vec, int *offset, int *size)
+{
+    ocp_nlp_cost_external_dims *dims = dims_;
+    ocp_nlp_cost_external_model *model = model_;
+
+    int ns = dims->ns;
+
+    if (!strcmp(field, "Zl"))
+    {
+        *vec = &model->Z;
+        *size = ns;
+        *offset = 0;
+    }
+    else if (!strcmp(field, "Zu"))
+    {
+        *vec = &model->Z;
+        *size = ns;
+        *offset = ns;
+    }
+    else if (!strcmp(field, "zl"))
+    {
+        *vec = &model->z;
+        *size = ns;
+        *offset = 0;
+    }
+    else if (!strcmp(field, "zu"))
+    {
+        *vec = &model->z;
+        *size = ns;
+        *offset = ns;
+    }
+    else
+    {
+        return ACADOS_FAILURE;
+    }
+
+    return ACADOS_SUCCESS;
+}
+
+
+
 int ocp_nlp_cost_external_model_set(void *config_, void *dims_, void *model_,
                                          const char *field, void *value_)
 {
@@ -211,7 +253,15 @@ int ocp_nlp_cost_external_model_set(void *config_, void *dims_, void *model_,
     int nx = dims->nx;
     int nu = dims->nu;
 
-    if (!strcmp(field, "ext_cost_fun"))
+    struct blasfeo_dvec *vec;
+    int offset, size;
+
+    if (ocp_nlp_cost_external_model_get_dvec_ptr(config_, dims_, model_, field, &vec, &offset,
+            &size) == ACADOS_SUCCESS)
+    {
+        blasfeo_pack_dvec(size, value_, vec, offset);
+    }
+    else if (!strcmp(field, "ext_cost_fun"))
     {
         model->ext_cost_fun = (external_function_generic *) value_;
     }
@@ -234,32 +284,12 @@ int ocp_nlp_cost_external_model_set(void *config_, void *dims_, void *model_,
         blasfeo_pack_dvec(ns, Z, &model->Z, 0);
         blasfeo_pack_dvec(ns, Z, &model->Z, ns);
     }
-    else if (!strcmp(field, "Zl"))
-    {
-        double *Zl = (double *) value_;
-        blasfeo_pack_dvec(ns, Zl, &model->Z, 0);
-    }
-    else if (!strcmp(field, "Zu"))
-    {
-        double *Zu = (double *) value_;
-        blasfeo_pack_dvec(ns, Zu, &model->Z, ns);
-    }
     else if (!strcmp(field, "z"))
     {
         double *z = (double *) value_;
         blasfeo_pack_dvec(ns, z, &model->z, 0);
         blasfeo_pack_dvec(ns, z, &model->z, ns);
     }
-    else if (!strcmp(field, "zl"))
-    {
-        double *zl = (double *) value_;
-        blasfeo_pack_dvec(ns, zl, &model->z, 0);
-    }
-    else if (!strcmp(field, "zu"))
-    {
-        double *zu = (double *) value_;
-        blasfeo_pack_dvec(ns, zu, &model->z, ns);
-    }
     else if (!strcmp(field, "scaling"))
     {
         double *scaling_ptr = (double *) value_;
@@ -746,6 +776,7 @@ void ocp_nlp_cost_external_config_initialize_default(void *config_)
     config->model_calculate_size = &ocp_nlp_cost_external_model_calculate_size;
     config->model_assign = &ocp_nlp_cost_external_model_assign;
     config->model_set = &ocp_nlp_cost_external_model_set;
+    config->model_get_dvec_ptr = &ocp_nlp_cost_external_model_get_dvec_ptr;
     config->opts_calculate_size = &ocp_nlp_cost_external_opts_calculate_size;
     config->opts_assign = &ocp_nlp_cost_external_opts_assign;
     config->opts_initialize_default = &ocp_nlp_cost_external_opts_initialize_default;
@@ -89,6 +89,9 @@ typedef struct
 int ocp_nlp_cost_external_model_calculate_size(void *config, void *dims);
 //
 void *ocp_nlp_cost_external_model_assign(void *config, void *dims, void *raw_memory);
+//
+int ocp_nlp_cost_external_model_get_dvec_ptr(void *config_, void *dims_, void *model_,
+        const char *field, struct blasfeo_dvec **vec, int *offset, int *size);
 
 
 
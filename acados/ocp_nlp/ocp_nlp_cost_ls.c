@@ -300,6 +300,55 @@ void *ocp_nlp_cost_ls_model_assign(void *config_, void *dims_, void *raw_memory)
 
 
 
+int ocp_nlp_cost_ls_model_get_dvec_ptr(void *config_, void *dims_, void *model_,
+        const char *field, struct blasfeo_dvec **vec, int *offset, int *size)
+{
+    ocp_nlp_cost_ls_dims *dims = dims_;
+    ocp_nlp_cost_ls_model *model = model_;
+
+    int ny = dims->ny;
+    int ns = dims->ns;
+
+    if (!strcmp(field, "y_ref") || !strcmp(field, "yref"))
+    {
+        *vec = &model->y_ref;
+        *size = ny;
+        *offset = 0;
+    }
+    else if (!strcmp(field, "Zl"))
+    {
+        *vec = &model->Z;
+        *size = ns;
+        *offset = 0;
+    }
+    else if (!strcmp(field, "Zu"))
+    {
+        *vec = &model->Z;
+        *size = ns;
+        *offset = ns;
+    }
+    else if (!strcmp(field, "zl"))
+    {
+        *vec = &model->z;
+        *size = ns;
+        *offset = 0;
+    }
+    else if (!strcmp(field, "zu"))
+    {
+        *vec = &model->z;
+        *size = ns;
+        *offset = ns;
+    }
+    else
+    {
+        return ACADOS_FAILURE;
+    }
+
+    return ACADOS_SUCCESS;
+}
+
+
+
 int ocp_nlp_cost_ls_model_set(void *config_, void *dims_, void *model_,
                                  const char *field, void *value_)
 {
@@ -320,7 +369,15 @@ int ocp_nlp_cost_ls_model_set(void *config_, void *dims_, void *model_,
     int ny = dims->ny;
     int ns = dims->ns;
 
-    if (!strcmp(field, "W"))
+    struct blasfeo_dvec *vec;
+    int offset, size;
+
+    if (ocp_nlp_cost_ls_model_get_dvec_ptr(config_, dims_, model_, field, &vec, &offset,
+            &size) == ACADOS_SUCCESS)
+    {
+        blasfeo_pack_dvec(size, value_, vec, offset);
+    }
+    else if (!strcmp(field, "W"))
     {
         double *W_col_maj = (double *) value_;
         blasfeo_pack_dmat(ny, ny, W_col_maj, ny, &model->W, 0, 0);
@@ -348,43 +405,18 @@ int ocp_nlp_cost_ls_model_set(void *config_, void *dims_, void *model_,
         blasfeo_pack_dmat(dims->ny, dims->nz, Vz_col_maj, dims->ny,
                 &model->Vz, 0, 0);
     }
-    else if (!strcmp(field, "y_ref") || !strcmp(field, "yref"))
-    {
-        double *y_ref = (double *) value_;
-        blasfeo_pack_dvec(ny, y_ref, &model->y_ref, 0);
-    }
     else if (!strcmp(field, "Z"))
     {
         double *Z = (double *) value_;
         blasfeo_pack_dvec(ns, Z, &model->Z, 0);
         blasfeo_pack_dvec(ns, Z, &model->Z, ns);
     }
-    else if (!strcmp(field, "Zl"))
-    {
-        double *Zl = (double *) value_;
-        blasfeo_pack_dvec(ns, Zl, &model->Z, 0);
-    }
-    else if (!strcmp(field, "Zu"))
-    {
-        double *Zu = (double *) value_;
-        blasfeo_pack_dvec(ns, Zu, &model->Z, ns);
-    }
     else if (!strcmp(field, "z"))
     {
         double *z = (double *) value_;
         blasfeo_pack_dvec(ns, z, &model->z, 0);
         blasfeo_pack_dvec(ns, z, &model->z, ns);
     }
-    else if (!strcmp(field, "zl"))
-    {
-        double *zl = (double *) value_;
-        blasfeo_pack_dvec(ns, zl, &model->z, 0);
-    }
-    else if (!strcmp(field, "zu"))
-    {
-        double *zu = (double *) value_;
-        blasfeo_pack_dvec(ns, zu, &model->z, ns);
-    }
     else if (!strcmp(field, "scaling"))
     {
         double *scaling_ptr = (double *) value_;
@@ -918,6 +950,7 @@ void ocp_nlp_cost_ls_config_initialize_default(void *config_)
     config->model_calculate_size = &ocp_nlp_cost_ls_model_calculate_size;
     config->model_assign = &ocp_nlp_cost_ls_model_assign;
     config->model_set = &ocp_nlp_cost_ls_model_set;
+    config->model_get_dvec_ptr = &ocp_nlp_cost_ls_model_get_dvec_ptr;
     config->opts_calculate_size = &ocp_nlp_cost_ls_opts_calculate_size;
     config->opts_assign = &ocp_nlp_cost_ls_opts_assign;
     config->opts_initialize_default = &ocp_nlp_cost_ls_opts_initialize_default;
@@ -107,6 +107,9 @@ int ocp_nlp_cost_nls_model_calculate_size(void *config, void *dims);
 void *ocp_nlp_cost_nls_model_assign(void *config, void *dims, void *raw_memory);
 //
 int ocp_nlp_cost_nls_model_set(void *config_, void *dims_, void *model_, const char *field, void *value_);
+//
+int ocp_nlp_cost_nls_model_get_dvec_ptr(void *config_, void *dims_, void *model_,
+        const char *field, struct blasfeo_dvec **vec, int *offset, int *size);
 
 
 
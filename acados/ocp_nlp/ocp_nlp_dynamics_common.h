@@ -97,6 +97,8 @@ typedef struct
     void (*memory_set_dzduxt_ptr)(struct blasfeo_dmat *mat, void *memory_);
     void (*memory_set_sim_guess_ptr)(struct blasfeo_dvec *vec, bool *bool_ptr, void *memory_);
     void (*memory_set_z_alg_ptr)(struct blasfeo_dvec *vec, void *memory_);
+    void (*memory_set_x_dense_ptr)(struct blasfeo_dvec *vec, void *memory_);
+    void (*memory_set_dxdenseduxt_ptr)(struct blasfeo_dmat *mat, void *memory_);
     void (*memory_get)(void *config, void *dims, void *mem, const char *field, void* value);
     /* workspace */
     int (*workspace_calculate_size)(void *config, void *dims, void *opts);
@@ -554,6 +554,28 @@ void ocp_nlp_dynamics_cont_memory_set_z_alg_ptr(struct blasfeo_dvec *vec, void *
 
 
 
+void ocp_nlp_dynamics_cont_memory_set_x_dense_ptr(struct blasfeo_dvec *vec, void *memory_)
+{
+    ocp_nlp_dynamics_cont_memory *memory = memory_;
+
+    memory->x_dense = vec;
+
+    return;
+}
+
+
+
+void ocp_nlp_dynamics_cont_memory_set_dxdenseduxt_ptr(struct blasfeo_dmat *mat, void *memory_)
+{
+    ocp_nlp_dynamics_cont_memory *memory = memory_;
+
+    memory->dxdenseduxt = mat;
+
+    return;
+}
+
+
+
 void ocp_nlp_dynamics_cont_memory_get(void *config_, void *dims_, void *mem_, const char *field, void* value)
 {
     ocp_nlp_dynamics_config *config = config_;
@@ -664,7 +686,12 @@ int ocp_nlp_dynamics_cont_model_calculate_size(void *config_, void *dims_)
     size += sizeof(ocp_nlp_dynamics_cont_model);
 
     size += config->sim_solver->model_calculate_size(config->sim_solver, dims->sim);
-    size += 1*8;
+
+    int n_dense;
+    config->sim_solver->dims_get(config->sim_solver, dims->sim, "n_dense", &n_dense);
+    size += n_dense * sizeof(double);  // t_dense
+
+    size += 2*8;
     make_int_multiple_of(8, &size);
 
     return size;
@@ -691,6 +718,14 @@ void *ocp_nlp_dynamics_cont_model_assign(void *config_, void *dims_, void *raw_m
     model->sim_model = config->sim_solver->model_assign(config->sim_solver, dims->sim, c_ptr);
     c_ptr += config->sim_solver->model_calculate_size(config->sim_solver, dims->sim);
 
+    // t_dense
+    int n_dense;
+    config->sim_solver->dims_get(config->sim_solver, dims->sim, "n_dense", &n_dense);
+    align_char_to(8, &c_ptr);
+    assign_and_advance_double(n_dense, &model->t_dense, &c_ptr);
+    for (int ii = 0; ii < n_dense; ii++)
+        model->t_dense[ii] = 0.0;
+
     assert((char *) raw_memory + ocp_nlp_dynamics_cont_model_calculate_size(config, dims) >= c_ptr);
 
     return model;
@@ -701,6 +736,7 @@ void *ocp_nlp_dynamics_cont_model_assign(void *config_, void *dims_, void *raw_m
 void ocp_nlp_dynamics_cont_model_set(void *config_, void *dims_, void *model_, const char *field, void *value)
 {
     ocp_nlp_dynamics_config *config = config_;
+    ocp_nlp_dynamics_cont_dims *dims = dims_;
     ocp_nlp_dynamics_cont_model *model = model_;
 
     sim_config *sim_config = config->sim_solver;
@@ -710,6 +746,14 @@ void ocp_nlp_dynamics_cont_model_set(void *config_, void *dims_, void *model_, c
         double *T = (double *) value;
         model->T = *T;
     }
+    else if (!strcmp(field, "t_dense"))
+    {
+        int n_dense;
+        sim_config->dims_get(sim_config, dims->sim, "n_dense", &n_dense);
+        double *t_dense = (double *) value;
+        for (int ii = 0; ii < n_dense; ii++)
+            model->t_dense[ii] = t_dense[ii];
+    }
     else
     {
         int status = sim_config->model_set(model->sim_model, field, value);
@@ -755,9 +799,14 @@ void ocp_nlp_dynamics_cont_update_qp_matrices(void *config_, void *dims_, void *
     int nx1 = dims->nx1;
     int nu1 = dims->nu1;
 
+    int n_dense;
+    config->sim_solver->dims_get(config->sim_solver, dims->sim, "n_dense", &n_dense);
+
     // setup model
     work->sim_in->model = model->sim_model;
     work->sim_in->T = model->T;
+    for (jj = 0; jj < n_dense; jj++)
+        work->sim_in->t_dense[jj] = model->t_dense[jj];
 
     // pass state and control to integrator
     blasfeo_unpack_dvec(nu, mem->ux, 0, work->sim_in->u);
@@ -808,6 +857,18 @@ void ocp_nlp_dynamics_cont_update_qp_matrices(void *config_, void *dims_, void *
     blasfeo_daxpy(nx1, -1.0, mem->ux1, nu1, &mem->fun, 0, &mem->fun, 0);
     blasfeo_pack_dvec(nz, work->sim_out->zn, mem->z_alg, 0);
 
+    // dense output and its sensitivities, dxdenseduxt = [dx_dense_k/du; dx_dense_k/dx]_k
+    if (n_dense > 0)
+    {
+        blasfeo_pack_dvec(n_dense*nx, work->sim_out->x_dense, mem->x_dense, 0);
+        for (jj = 0; jj < n_dense; jj++)
+        {
+            double *S_dense = work->sim_out->S_dense + jj*nx*(nx+nu);
+            blasfeo_pack_tran_dmat(nx, nu, S_dense + nx*nx, nx, mem->dxdenseduxt, 0, jj*nx);
+            blasfeo_pack_tran_dmat(nx, nx, S_dense + 0, nx, mem->dxdenseduxt, nu, jj*nx);
+        }
+    }
+
     // adjoint
     if (opts->compute_adj)
     {
@@ -869,9 +930,14 @@ void ocp_nlp_dynamics_cont_compute_fun(void *config_, void *dims_, void *model_,
     int nx1 = dims->nx1;
     int nu1 = dims->nu1;
 
+    int n_dense;
+    config->sim_solver->dims_get(config->sim_solver, dims->sim, "n_dense", &n_dense);
+
     // setup model
     work->sim_in->model = model->sim_model;
     work->sim_in->T = model->T;
+    for (int jj = 0; jj < n_dense; jj++)
+        work->sim_in->t_dense[jj] = model->t_dense[jj];
 
     // pass state and control to integrator
     blasfeo_unpack_dvec(nu, mem->tmp_ux, 0, work->sim_in->u);
@@ -914,6 +980,9 @@ void ocp_nlp_dynamics_cont_compute_fun(void *config_, void *dims_, void *model_,
     // fun -= x[next_stage]
     blasfeo_daxpy(nx1, -1.0, mem->tmp_ux1, nu1, &mem->fun, 0, &mem->fun, 0);
 //    blasfeo_pack_dvec(nz, work->sim_out->zn, mem->z_alg, 0);
+    // dense output, evaluated by the constraints at the same point
+    if (n_dense > 0)
+        blasfeo_pack_dvec(n_dense*nx, work->sim_out->x_dense, mem->x_dense, 0);
 
     return;
 
@@ -979,6 +1048,8 @@ void ocp_nlp_dynamics_cont_config_initialize_default(void *config_)
     config->memory_set_dzduxt_ptr = &ocp_nlp_dynamics_cont_memory_set_dzduxt_ptr;
     config->memory_set_sim_guess_ptr = &ocp_nlp_dynamics_cont_memory_set_sim_guess_ptr;
     config->memory_set_z_alg_ptr = &ocp_nlp_dynamics_cont_memory_set_z_alg_ptr;
+    config->memory_set_x_dense_ptr = &ocp_nlp_dynamics_cont_memory_set_x_dense_ptr;
+    config->memory_set_dxdenseduxt_ptr = &ocp_nlp_dynamics_cont_memory_set_dxdenseduxt_ptr;
     config->memory_get = &ocp_nlp_dynamics_cont_memory_get;
     config->workspace_calculate_size = &ocp_nlp_dynamics_cont_workspace_calculate_size;
     config->initialize = &ocp_nlp_dynamics_cont_initialize;
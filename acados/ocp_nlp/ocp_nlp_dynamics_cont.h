@@ -127,6 +127,8 @@ typedef struct
     struct blasfeo_dvec *sim_guess;     // initializations for integrator
     // struct blasfeo_dvec *z;             // pointer to (input) z in nlp_out at current stage
     struct blasfeo_dmat *dzduxt;        // pointer to dzdux transposed
+    struct blasfeo_dvec *x_dense;       // pointer to dense output states at t_dense
+    struct blasfeo_dmat *dxdenseduxt;   // pointer to dx_dense/dux transposed
     void *sim_solver;                   // sim solver memory
 } ocp_nlp_dynamics_cont_memory;
 
@@ -180,6 +182,7 @@ typedef struct
     void *sim_model;
     // double *state_transition; // TODO
     double T;  // simulation time
+    double *t_dense;  // dense output times within [0, T]
 } ocp_nlp_dynamics_cont_model;
 
 //
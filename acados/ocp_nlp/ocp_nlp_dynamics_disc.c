@@ -132,6 +132,14 @@ void ocp_nlp_dynamics_disc_dims_set(void *config_, void *dims_, const char *dim,
             exit(1);
         }
     }
+    else if (!strcmp(dim, "n_dense"))
+    {
+        if ( *value > 0)
+        {
+            printf("\nerror: discrete dynamics with n_dense>0\n");
+            exit(1);
+        }
+    }
     else if (!strcmp(dim, "nu"))
     {
         ocp_nlp_dynamics_disc_set_nu(config_, dims_, value);
@@ -175,6 +183,10 @@ void ocp_nlp_dynamics_disc_dims_get(void *config_, void *dims_, const char *dim,
     {
         *value = dims->nu1;
     }
+    else if (!strcmp(dim, "n_dense"))
+    {
+        *value = 0;  // no dense output for discrete models
+    }
     else
     {
         printf("\ndimension type %s not available in module ocp_nlp_dynamics_disc\n", dim);
@@ -457,6 +469,20 @@ void ocp_nlp_dynamics_disc_memory_set_z_alg_ptr(struct blasfeo_dvec *z, void *me
 
 
 
+void ocp_nlp_dynamics_disc_memory_set_x_dense_ptr(struct blasfeo_dvec *vec, void *memory_)
+{
+    return;  // discrete models have no dense output
+}
+
+
+
+void ocp_nlp_dynamics_disc_memory_set_dxdenseduxt_ptr(struct blasfeo_dmat *mat, void *memory_)
+{
+    return;  // discrete models have no dense output
+}
+
+
+
 void ocp_nlp_dynamics_disc_memory_get(void *config_, void *dims_, void *mem_, const char *field, void* value)
 {
 //    ocp_nlp_dynamics_disc_dims *dims = dims_;
@@ -828,6 +854,8 @@ void ocp_nlp_dynamics_disc_config_initialize_default(void *config_)
     config->memory_set_dzduxt_ptr = &ocp_nlp_dynamics_disc_memory_set_dzduxt_ptr;
     config->memory_set_sim_guess_ptr = &ocp_nlp_dynamics_disc_memory_set_sim_guess_ptr;
     config->memory_set_z_alg_ptr = &ocp_nlp_dynamics_disc_memory_set_z_alg_ptr;
+    config->memory_set_x_dense_ptr = &ocp_nlp_dynamics_disc_memory_set_x_dense_ptr;
+    config->memory_set_dxdenseduxt_ptr = &ocp_nlp_dynamics_disc_memory_set_dxdenseduxt_ptr;
     config->memory_get = &ocp_nlp_dynamics_disc_memory_get;
     config->workspace_calculate_size = &ocp_nlp_dynamics_disc_workspace_calculate_size;
     config->initialize = &ocp_nlp_dynamics_disc_initialize;
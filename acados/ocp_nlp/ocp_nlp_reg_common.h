@@ -100,6 +100,9 @@ typedef struct
     /* functions */
     void (*regularize_hessian)(void *config, ocp_nlp_reg_dims *dims, void *opts, void *memory);
     void (*correct_dual_sol)(void *config, ocp_nlp_reg_dims *dims, void *opts, void *memory);
+    /* properties, used to mark the QP matrices as changed for the QP solver */
+    int regularize_writes_qp_mat;  // regularize_hessian writes the matrices of qp_in
+    int correct_writes_qp_mat;  // correct_dual_sol writes the matrices of qp_in
 } ocp_nlp_reg_config;
 
 //
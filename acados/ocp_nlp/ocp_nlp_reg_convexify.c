@@ -796,4 +796,7 @@ void ocp_nlp_reg_convexify_config_initialize_default(ocp_nlp_reg_config *config)
     // functions
     config->regularize_hessian = &ocp_nlp_reg_convexify_regularize_hessian;
     config->correct_dual_sol = &ocp_nlp_reg_convexify_correct_dual_sol;
+    // properties
+    config->regularize_writes_qp_mat = 1;
+    config->correct_writes_qp_mat = 1;
 }
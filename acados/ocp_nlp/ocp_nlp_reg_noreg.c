@@ -221,5 +221,8 @@ void ocp_nlp_reg_noreg_config_initialize_default(ocp_nlp_reg_config *config)
     // functions
     config->regularize_hessian = &ocp_nlp_reg_noreg_regularize_hessian;
     config->correct_dual_sol = &ocp_nlp_reg_noreg_correct_dual_sol;
+    // properties
+    config->regularize_writes_qp_mat = 0;
+    config->correct_writes_qp_mat = 0;
 }
 
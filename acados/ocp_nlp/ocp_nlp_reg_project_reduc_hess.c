@@ -559,5 +559,8 @@ void ocp_nlp_reg_project_reduc_hess_config_initialize_default(ocp_nlp_reg_config
     // functions
     config->regularize_hessian = &ocp_nlp_reg_project_reduc_hess_regularize_hessian;
     config->correct_dual_sol = &ocp_nlp_reg_project_reduc_hess_correct_dual_sol;
+    // properties
+    config->regularize_writes_qp_mat = 1;
+    config->correct_writes_qp_mat = 0;
 }
 
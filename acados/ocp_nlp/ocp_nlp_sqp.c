@@ -40,9 +40,6 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#if defined(ACADOS_WITH_OPENMP)
-#include <omp.h>
-#endif
 
 // blasfeo
 #include "blasfeo/include/blasfeo_d_aux.h"
@@ -130,6 +127,12 @@ void ocp_nlp_sqp_opts_initialize_default(void *config_, void *dims_, void *opts_
     opts->print_level = 0;
     opts->initialize_t_slacks = 0;
 
+    opts->filter_size = 50;
+    opts->filter_gamma_theta = 1e-5;
+    opts->filter_gamma_phi = 1e-5;
+    opts->filter_theta_max = 1e4;
+    opts->max_restoration_iter = 10;
+
     // overwrite default submodules opts
 
     // qp tolerance
@@ -266,6 +269,36 @@ void ocp_nlp_sqp_opts_set(void *config_, void *opts_, const char *field, void* v
             }
             opts->initialize_t_slacks = *initialize_t_slacks;
         }
+        else if (!strcmp(field, "filter_size"))
+        {
+            int* filter_size = (int *) value;
+            if (*filter_size < 1)
+            {
+                printf("\nerror: ocp_nlp_sqp_opts_set: invalid value for filter_size field, need int >=1, got %d.", *filter_size);
+                exit(1);
+            }
+            opts->filter_size = *filter_size;
+        }
+        else if (!strcmp(field, "filter_gamma_theta"))
+        {
+            double* filter_gamma_theta = (double *) value;
+            opts->filter_gamma_theta = *filter_gamma_theta;
+        }
+        else if (!strcmp(field, "filter_gamma_phi"))
+        {
+            double* filter_gamma_phi = (double *) value;
+            opts->filter_gamma_phi = *filter_gamma_phi;
+        }
+        else if (!strcmp(field, "filter_theta_max"))
+        {
+            double* filter_theta_max = (double *) value;
+            opts->filter_theta_max = *filter_theta_max;
+        }
+        else if (!strcmp(field, "max_restoration_iter"))
+        {
+            int* max_restoration_iter = (int *) value;
+            opts->max_restoration_iter = *max_restoration_iter;
+        }
         else
         {
             ocp_nlp_opts_set(config, nlp_opts, field, value);
@@ -327,6 +360,9 @@ int ocp_nlp_sqp_memory_calculate_size(void *config_, void *dims_, void *opts_)
         stat_n += 4;
     size += stat_n*stat_m*sizeof(double);
 
+    // filter
+    size += 2*opts->filter_size*sizeof(double);
+
     size += 3*8;  // align
 
     make_int_multiple_of(8, &size);
@@ -379,6 +415,11 @@ void *ocp_nlp_sqp_memory_assign(void *config_, void *dims_, void *opts_, void *r
         mem->stat_n += 4;
     c_ptr += mem->stat_m*mem->stat_n*sizeof(double);
 
+    // filter
+    assign_and_advance_double(opts->filter_size, &mem->filter_theta, &c_ptr);
+    assign_and_advance_double(opts->filter_size, &mem->filter_phi, &c_ptr);
+    mem->filter_len = 0;
+
     mem->status = ACADOS_READY;
 
     align_char_to(8, &c_ptr);
@@ -424,6 +465,13 @@ int ocp_nlp_sqp_workspace_calculate_size(void *config_, void *dims_, void *opts_
         size += ocp_qp_res_workspace_calculate_size(dims->qp_solver->orig_dims);
     }
 
+    // tmp rqz
+    size += (dims->N+1)*sizeof(struct blasfeo_dvec);
+    for (int ii = 0; ii <= dims->N; ii++)
+        size += blasfeo_memsize_dvec(dims->nv[ii]);
+    size += 8;  // blasfeo_struct align
+    size += 64;  // blasfeo_mem align
+
     return size;
 }
 
@@ -461,6 +509,18 @@ static void ocp_nlp_sqp_cast_workspace(ocp_nlp_config *config, ocp_nlp_dims *dim
         c_ptr += ocp_qp_res_workspace_calculate_size(dims->qp_solver->orig_dims);
     }
 
+    // blasfeo_struct align
+    align_char_to(8, &c_ptr);
+
+    // tmp rqz
+    assign_and_advance_blasfeo_dvec_structs(dims->N+1, &work->tmp_rqz, &c_ptr);
+
+    // blasfeo_mem align
+    align_char_to(64, &c_ptr);
+
+    for (int ii = 0; ii <= dims->N; ii++)
+        assign_and_advance_blasfeo_dvec_mem(dims->nv[ii], work->tmp_rqz+ii, &c_ptr);
+
     assert((char *) work + ocp_nlp_sqp_workspace_calculate_size(config, dims, opts) >= c_ptr);
 
     return;
@@ -468,6 +528,296 @@ static void ocp_nlp_sqp_cast_workspace(ocp_nlp_config *config, ocp_nlp_dims *dim
 
 
 
+
+
+
+/************************************************
+ * filter
+ ************************************************/
+
+// switching condition parameters, Waechter2005, Section 2.3
+#define FILTER_DELTA 1.0
+#define FILTER_S_THETA 1.1
+#define FILTER_S_PHI 2.3
+
+
+
+// acceptability of (theta, phi) with respect to the filter entry (theta_k, phi_k)
+static bool ocp_nlp_sqp_filter_acceptable_to_entry(ocp_nlp_sqp_opts *opts, double theta,
+                                                   double phi, double theta_k, double phi_k)
+{
+    return (theta <= (1.0 - opts->filter_gamma_theta) * theta_k) |
+           (phi <= phi_k - opts->filter_gamma_phi * theta_k);
+}
+
+
+
+// acceptability of (theta, phi) with respect to the filter and the current iterate
+static bool ocp_nlp_sqp_filter_acceptable(ocp_nlp_sqp_opts *opts,
+                                          ocp_nlp_sqp_memory *mem, double theta, double phi)
+{
+    int ii;
+
+    if (theta > mem->theta_max)
+        return false;
+
+    if (!ocp_nlp_sqp_filter_acceptable_to_entry(opts, theta, phi, mem->theta, mem->phi))
+        return false;
+
+    for (ii = 0; ii < mem->filter_len; ii++)
+    {
+        if (!ocp_nlp_sqp_filter_acceptable_to_entry(opts, theta, phi, mem->filter_theta[ii],
+                                                    mem->filter_phi[ii]))
+            return false;
+    }
+
+    return true;
+}
+
+
+
+static void ocp_nlp_sqp_filter_add(ocp_nlp_sqp_opts *opts, ocp_nlp_sqp_memory *mem,
+                                   double theta, double phi)
+{
+    int ii, jj;
+
+    // remove entries dominated by the new one
+    jj = 0;
+    for (ii = 0; ii < mem->filter_len; ii++)
+    {
+        if ((mem->filter_theta[ii] < theta) | (mem->filter_phi[ii] < phi))
+        {
+            mem->filter_theta[jj] = mem->filter_theta[ii];
+            mem->filter_phi[jj] = mem->filter_phi[ii];
+            jj++;
+        }
+    }
+    mem->filter_len = jj;
+
+    if (mem->filter_len < opts->filter_size)
+    {
+        mem->filter_theta[mem->filter_len] = theta;
+        mem->filter_phi[mem->filter_len] = phi;
+        mem->filter_len++;
+    }
+    else
+    {
+        // filter full: replace the entry with the largest constraint violation
+        jj = 0;
+        for (ii = 1; ii < mem->filter_len; ii++)
+        {
+            if (mem->filter_theta[ii] > mem->filter_theta[jj])
+                jj = ii;
+        }
+        mem->filter_theta[jj] = theta;
+        mem->filter_phi[jj] = phi;
+    }
+
+    return;
+}
+
+
+
+// evaluate cost and constraint violation at out->ux + alpha * qp_out->ux
+static void ocp_nlp_sqp_filter_evaluate_trial_point(ocp_nlp_config *config, ocp_nlp_dims *dims,
+            ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out, ocp_nlp_sqp_opts *opts,
+            ocp_nlp_sqp_memory *mem, ocp_nlp_sqp_workspace *work, double alpha,
+            double *theta, double *phi)
+{
+    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+    ocp_nlp_workspace *nlp_work = work->nlp_work;
+
+    int ii;
+
+    int N = dims->N;
+    int *nv = dims->nv;
+
+    for (ii = 0; ii <= N; ii++)
+        blasfeo_daxpy(nv[ii], alpha, nlp_mem->qp_out->ux+ii, 0, nlp_out->ux+ii, 0,
+                      nlp_work->tmp_nlp_out->ux+ii, 0);
+
+    ocp_nlp_evaluate_cost_and_infeasibility(config, dims, nlp_in, nlp_out, opts->nlp_opts,
+                                            nlp_mem, nlp_work, phi, theta);
+
+    return;
+}
+
+
+
+// feasibility restoration: minimum-norm step onto the linearized constraints, obtained by solving
+// the QP with the gradient set to zero, followed by backtracking until the trial point reduces the
+// constraint violation and is acceptable to the filter; the current iterate is added to the filter,
+// such that it is not revisited
+static int ocp_nlp_sqp_filter_restoration(ocp_nlp_config *config, ocp_nlp_dims *dims,
+            ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out, ocp_nlp_sqp_opts *opts,
+            ocp_nlp_sqp_memory *mem, ocp_nlp_sqp_workspace *work)
+{
+    ocp_nlp_opts *nlp_opts = opts->nlp_opts;
+    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+    ocp_nlp_workspace *nlp_work = work->nlp_work;
+    ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
+
+    acados_timer timer;
+
+    int ii;
+
+    int N = dims->N;
+    int *nv = dims->nv;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *nz = dims->nz;
+
+    if (mem->restoration_iter >= opts->max_restoration_iter)
+        return ACADOS_MINSTEP;
+    mem->restoration_iter++;
+
+    ocp_nlp_sqp_filter_add(opts, mem, mem->theta, mem->phi);
+
+    for (ii = 0; ii <= N; ii++)
+        blasfeo_dveccp(nv[ii], nlp_mem->qp_in->rqz+ii, 0, work->tmp_rqz+ii, 0);
+
+    // correct_dual_sol of the regular step restored the unregularized Hessian in qp_in
+    acados_tic(&timer);
+    config->regularize->regularize_hessian(config->regularize, dims->regularize,
+                                           nlp_opts->regularize, nlp_mem->regularize_mem);
+    if (config->regularize->regularize_writes_qp_mat)
+        qp_solver->memory_set(qp_solver, nlp_mem->qp_solver_mem, "mat_dirty_all", NULL);
+    mem->time_reg += acados_toc(&timer);
+
+    for (ii = 0; ii <= N; ii++)
+        blasfeo_dvecse(nv[ii], 0.0, nlp_mem->qp_in->rqz+ii, 0);
+
+    acados_tic(&timer);
+    int qp_status = qp_solver->evaluate(qp_solver, dims->qp_solver, nlp_mem->qp_in, nlp_mem->qp_out,
+                                        nlp_opts->qp_solver_opts, nlp_mem->qp_solver_mem,
+                                        nlp_work->qp_work);
+    mem->time_qp_sol += acados_toc(&timer);
+
+    acados_tic(&timer);
+    config->regularize->correct_dual_sol(config->regularize, dims->regularize,
+                                         nlp_opts->regularize, nlp_mem->regularize_mem);
+    if (config->regularize->correct_writes_qp_mat)
+        qp_solver->memory_set(qp_solver, nlp_mem->qp_solver_mem, "mat_dirty_all", NULL);
+    mem->time_reg += acados_toc(&timer);
+
+    for (ii = 0; ii <= N; ii++)
+        blasfeo_dveccp(nv[ii], work->tmp_rqz+ii, 0, nlp_mem->qp_in->rqz+ii, 0);
+
+    if ((qp_status!=ACADOS_SUCCESS) & (qp_status!=ACADOS_MAXITER))
+        return ACADOS_QP_FAILURE;
+
+    double theta, phi;
+    double alpha = 1.0;
+    while (alpha >= nlp_opts->alpha_min)
+    {
+        ocp_nlp_sqp_filter_evaluate_trial_point(config, dims, nlp_in, nlp_out, opts, mem, work,
+                                                alpha, &theta, &phi);
+
+        if ((theta <= (1.0 - opts->filter_gamma_theta) * mem->theta) &&
+            ocp_nlp_sqp_filter_acceptable(opts, mem, theta, phi))
+            break;
+
+        alpha *= nlp_opts->alpha_reduction;
+    }
+
+    // no acceptable point along the restoration step
+    if (alpha < nlp_opts->alpha_min)
+        return ACADOS_MINSTEP;
+
+    // primal step only, the multipliers of the restoration QP are not meaningful for the NLP
+    for (ii = 0; ii <= N; ii++)
+    {
+        blasfeo_daxpy(nv[ii], alpha, nlp_mem->qp_out->ux+ii, 0, nlp_out->ux+ii, 0, nlp_out->ux+ii, 0);
+
+        // linear update of algebraic variables using state and input sensitivity
+        if (ii < N)
+        {
+            blasfeo_dgemv_t(nu[ii]+nx[ii], nz[ii], alpha, nlp_mem->dzduxt+ii, 0, 0,
+                            nlp_mem->qp_out->ux+ii, 0, 1.0, nlp_mem->z_alg+ii, 0, nlp_out->z+ii, 0);
+        }
+    }
+
+    mem->theta = theta;
+    mem->phi = phi;
+    mem->alpha = alpha;
+
+    return ACADOS_SUCCESS;
+}
+
+
+
+// backtracking filter line search, Fletcher2002 and Waechter2005
+static int ocp_nlp_sqp_filter_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims,
+            ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out, ocp_nlp_sqp_opts *opts,
+            ocp_nlp_sqp_memory *mem, ocp_nlp_sqp_workspace *work)
+{
+    ocp_nlp_opts *nlp_opts = opts->nlp_opts;
+    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+    ocp_nlp_workspace *nlp_work = work->nlp_work;
+
+    int ii;
+
+    int N = dims->N;
+    int *nv = dims->nv;
+
+    double theta0 = mem->theta;
+    double phi0 = mem->phi;
+
+    // directional derivative of the cost along the QP step
+    double dphi = 0.0;
+    for (ii = 0; ii <= N; ii++)
+        dphi += blasfeo_ddot(nv[ii], nlp_mem->cost_grad+ii, 0, nlp_mem->qp_out->ux+ii, 0);
+
+    double theta, phi;
+    double alpha = 1.0;
+    while (alpha >= nlp_opts->alpha_min)
+    {
+        ocp_nlp_sqp_filter_evaluate_trial_point(config, dims, nlp_in, nlp_out, opts, mem, work,
+                                                alpha, &theta, &phi);
+
+        if (ocp_nlp_sqp_filter_acceptable(opts, mem, theta, phi))
+        {
+            if ((dphi < 0.0) &&
+                (alpha * pow(-dphi, FILTER_S_PHI) > FILTER_DELTA * pow(theta0, FILTER_S_THETA)))
+            {
+                // f-type iteration: Armijo condition on the cost, filter unchanged
+                if (phi <= phi0 + nlp_opts->eps_sufficient_descent * alpha * dphi)
+                    break;
+            }
+            else
+            {
+                // h-type iteration: augment the filter with the current iterate
+                ocp_nlp_sqp_filter_add(opts, mem, theta0, phi0);
+                break;
+            }
+        }
+
+        alpha *= nlp_opts->alpha_reduction;
+    }
+
+    if (alpha < nlp_opts->alpha_min)
+    {
+        if (theta0 > opts->tol_eq)
+            return ocp_nlp_sqp_filter_restoration(config, dims, nlp_in, nlp_out, opts, mem, work);
+
+        // (nearly) feasible iterate: no restoration possible, keep minimal progress
+        alpha = nlp_opts->alpha_min;
+        ocp_nlp_sqp_filter_evaluate_trial_point(config, dims, nlp_in, nlp_out, opts, mem, work,
+                                                alpha, &theta, &phi);
+    }
+
+    ocp_nlp_update_variables_step(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work, alpha);
+
+    mem->theta = theta;
+    mem->phi = phi;
+    mem->alpha = alpha;
+    mem->restoration_iter = 0;
+
+    return ACADOS_SUCCESS;
+}
+
+
+
 /************************************************
  * functions
  ************************************************/
@@ -503,6 +853,7 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     mem->time_lin = 0.0;
     mem->time_reg = 0.0;
     mem->time_tot = 0.0;
+    acados_thread_pool_reset_stats(mem->nlp_mem->pool);
 
     int N = dims->N;
 
@@ -511,19 +862,7 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     int qp_iter = 0;
     int qp_status = 0;
 
-#if defined(ACADOS_WITH_OPENMP)
-    // backup number of threads
-    int num_threads_bkp = omp_get_num_threads();
-    // set number of threads
-    omp_set_num_threads(opts->nlp_opts->num_threads);
-    #pragma omp parallel
-    { // beginning of parallel region
-#endif
-
     // alias to dynamics_memory
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp for
-#endif
     for (ii = 0; ii < N; ii++)
     {
         config->dynamics[ii]->memory_set_ux_ptr(nlp_out->ux+ii, nlp_mem->dynamics[ii]);
@@ -537,12 +876,11 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         config->dynamics[ii]->memory_set_dzduxt_ptr(nlp_mem->dzduxt+ii, nlp_mem->dynamics[ii]);
         config->dynamics[ii]->memory_set_sim_guess_ptr(nlp_mem->sim_guess+ii, nlp_mem->set_sim_guess+ii, nlp_mem->dynamics[ii]);
         config->dynamics[ii]->memory_set_z_alg_ptr(nlp_mem->z_alg+ii, nlp_mem->dynamics[ii]);
+        config->dynamics[ii]->memory_set_x_dense_ptr(nlp_mem->x_dense+ii, nlp_mem->dynamics[ii]);
+        config->dynamics[ii]->memory_set_dxdenseduxt_ptr(nlp_mem->dxdenseduxt+ii, nlp_mem->dynamics[ii]);
     }
 
     // alias to cost_memory
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp for
-#endif
     for (ii = 0; ii <= N; ii++)
     {
         config->cost[ii]->memory_set_ux_ptr(nlp_out->ux+ii, nlp_mem->cost[ii]);
@@ -553,9 +891,6 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         config->cost[ii]->memory_set_Z_ptr(nlp_mem->qp_in->Z+ii, nlp_mem->cost[ii]);
     }
     // alias to constraints_memory
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp for
-#endif
     for (ii = 0; ii <= N; ii++)
     {
         config->constraints[ii]->memory_set_ux_ptr(nlp_out->ux+ii, nlp_mem->constraints[ii]);
@@ -564,6 +899,8 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         config->constraints[ii]->memory_set_tmp_lam_ptr(nlp_work->tmp_nlp_out->lam+ii, nlp_mem->constraints[ii]);
         config->constraints[ii]->memory_set_z_alg_ptr(nlp_mem->z_alg+ii, nlp_mem->constraints[ii]);
         config->constraints[ii]->memory_set_dzdux_tran_ptr(nlp_mem->dzduxt+ii, nlp_mem->constraints[ii]);
+        config->constraints[ii]->memory_set_x_dense_ptr(nlp_mem->x_dense+ii, nlp_mem->constraints[ii]);
+        config->constraints[ii]->memory_set_dxdense_dux_tran_ptr(nlp_mem->dxdenseduxt+ii, nlp_mem->constraints[ii]);
         config->constraints[ii]->memory_set_DCt_ptr(nlp_mem->qp_in->DCt+ii, nlp_mem->constraints[ii]);
         config->constraints[ii]->memory_set_RSQrq_ptr(nlp_mem->qp_in->RSQrq+ii, nlp_mem->constraints[ii]);
         config->constraints[ii]->memory_set_idxb_ptr(nlp_mem->qp_in->idxb[ii], nlp_mem->constraints[ii]);
@@ -583,10 +920,6 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     config->regularize->memory_set_lam_ptr(dims->regularize, nlp_mem->qp_out->lam, nlp_mem->regularize_mem);
 
     // copy sampling times into dynamics model
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp for
-#endif
-
     // NOTE(oj): this will lead in an error for irk_gnsf, T must be set in precompute;
     //    -> remove here and make sure precompute is called everywhere.
     for (ii = 0; ii < N; ii++)
@@ -595,10 +928,6 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
                                          nlp_in->dynamics[ii], "T", nlp_in->Ts+ii);
     }
 
-#if defined(ACADOS_WITH_OPENMP)
-    } // end of parallel region
-#endif
-
     //
     if (opts->initialize_t_slacks > 0)
         ocp_nlp_initialize_t_slacks(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
@@ -606,6 +935,19 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     // initialize QP
     ocp_nlp_initialize_qp(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
 
+    // initialize filter
+    mem->filter_len = 0;
+    mem->restoration_iter = 0;
+    mem->alpha = 0.0;
+    if (nlp_opts->globalization == FILTER_LINE_SEARCH)
+    {
+        for (ii = 0; ii <= N; ii++)
+            blasfeo_dveccp(dims->nv[ii], nlp_out->ux+ii, 0, nlp_work->tmp_nlp_out->ux+ii, 0);
+        ocp_nlp_evaluate_cost_and_infeasibility(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem,
+                                                nlp_work, &mem->phi, &mem->theta);
+        mem->theta_max = opts->filter_theta_max * (mem->theta > 1.0 ? mem->theta : 1.0);
+    }
+
     // main sqp loop
     int sqp_iter = 0;
 	nlp_mem->sqp_iter = &sqp_iter;
@@ -663,10 +1005,6 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             nlp_out->total_time = total_time;
             mem->time_tot = total_time;
 
-#if defined(ACADOS_WITH_OPENMP)
-            // restore number of threads
-            omp_set_num_threads(num_threads_bkp);
-#endif
             mem->status = ACADOS_SUCCESS;
 
             if (opts->print_level > 0)
@@ -685,6 +1023,8 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         acados_tic(&timer1);
         config->regularize->regularize_hessian(config->regularize, dims->regularize,
                                                opts->nlp_opts->regularize, nlp_mem->regularize_mem);
+        if (config->regularize->regularize_writes_qp_mat)
+            qp_solver->memory_set(qp_solver, nlp_mem->qp_solver_mem, "mat_dirty_all", NULL);
         mem->time_reg += acados_toc(&timer1);
 
         // (typically) no warm start at first iteration
@@ -710,6 +1050,9 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         acados_tic(&timer1);
         config->regularize->correct_dual_sol(config->regularize, dims->regularize,
                                              opts->nlp_opts->regularize, nlp_mem->regularize_mem);
+        // the regularization may restore the original Hessian in qp_in
+        if (config->regularize->correct_writes_qp_mat)
+            qp_solver->memory_set(qp_solver, nlp_mem->qp_solver_mem, "mat_dirty_all", NULL);
         mem->time_reg += acados_toc(&timer1);
 
         // restore default warm start
@@ -765,10 +1108,6 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             nlp_out->total_time = total_time;
 
             printf("QP solver returned error status %d in iteration %d\n", qp_status, sqp_iter);
-#if defined(ACADOS_WITH_OPENMP)
-            // restore number of threads
-            omp_set_num_threads(num_threads_bkp);
-#endif
 
             if (opts->print_level > 1)
             {
@@ -781,7 +1120,57 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             return mem->status;
         }
 
-        ocp_nlp_update_variables_sqp(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
+        // globalization
+        if (nlp_opts->globalization == FILTER_LINE_SEARCH)
+        {
+            int ls_status = ocp_nlp_sqp_filter_line_search(config, dims, nlp_in, nlp_out, opts,
+                                                           mem, work);
+
+            if (ls_status != ACADOS_SUCCESS)
+            {
+                // save sqp iterations number
+                mem->sqp_iter = sqp_iter;
+                nlp_out->sqp_iter = sqp_iter;
+
+                // stop timer
+                total_time += acados_toc(&timer0);
+
+                // save time
+                mem->time_tot = total_time;
+                nlp_out->total_time = total_time;
+
+                if (opts->print_level > 0)
+                    printf("ocp_nlp_sqp: feasibility restoration failed in iteration %d\n", sqp_iter);
+
+                mem->status = ls_status;
+                return mem->status;
+            }
+        }
+        else
+        {
+            int ls_status = ocp_nlp_update_variables_sqp(config, dims, nlp_in, nlp_out, nlp_opts,
+                                                         nlp_mem, nlp_work);
+
+            if (ls_status != ACADOS_SUCCESS)
+            {
+                // save sqp iterations number
+                mem->sqp_iter = sqp_iter;
+                nlp_out->sqp_iter = sqp_iter;
+
+                // stop timer
+                total_time += acados_toc(&timer0);
+
+                // save time
+                mem->time_tot = total_time;
+                nlp_out->total_time = total_time;
+
+                if (opts->print_level > 0)
+                    printf("ocp_nlp_sqp: line search failed in iteration %d\n", sqp_iter);
+
+                mem->status = ls_status;
+                return mem->status;
+            }
+        }
 
         // ocp_nlp_dims_print(nlp_out->dims);
         // ocp_nlp_out_print(nlp_out);
@@ -833,10 +1222,6 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     nlp_out->total_time = total_time;
 
     // maximum number of iterations reached
-#if defined(ACADOS_WITH_OPENMP)
-    // restore number of threads
-    omp_set_num_threads(num_threads_bkp);
-#endif
     mem->status = ACADOS_MAXITER;
     printf("\n ocp_nlp_sqp: maximum iterations reached\n");
 
@@ -964,6 +1349,25 @@ void ocp_nlp_sqp_eval_param_sens(void *config_, void *dims_, void *opts_, void *
 
 
 
+void ocp_nlp_sqp_eval_param_sens_batch(void *config_, void *dims_, void *opts_, void *mem_,
+        void *work_, char *field, int stage, int n_dir, int *index, double *sens, int ld_sens)
+{
+    ocp_nlp_dims *dims = dims_;
+    ocp_nlp_config *config = config_;
+    ocp_nlp_sqp_opts *opts = opts_;
+    ocp_nlp_sqp_memory *mem = mem_;
+
+    ocp_nlp_sqp_workspace *work = work_;
+    ocp_nlp_sqp_cast_workspace(config, dims, opts, mem, work);
+
+    ocp_nlp_eval_param_sens_batch_qp(config, dims, opts->nlp_opts, mem->nlp_mem, work->nlp_work,
+        work->tmp_qp_in, work->tmp_qp_out, field, stage, n_dir, index, sens, ld_sens);
+
+    return;
+}
+
+
+
 // TODO rename memory_get ???
 void ocp_nlp_sqp_get(void *config_, void *dims_, void *mem_, const char *field, void *return_value_)
 {
@@ -1011,6 +1415,11 @@ void ocp_nlp_sqp_get(void *config_, void *dims_, void *mem_, const char *field,
         double *value = return_value_;
         *value = mem->time_reg;
     }
+    else if (!strcmp("thread_utilization", field))
+    {
+        double *value = return_value_;
+        acados_thread_pool_get_utilization(mem->nlp_mem->pool, value);
+    }
     else if (!strcmp("time_sim", field) || !strcmp("time_sim_ad", field) || !strcmp("time_sim_la", field))
     {
 		double tmp = 0.0;
@@ -1023,6 +1432,21 @@ void ocp_nlp_sqp_get(void *config_, void *dims_, void *mem_, const char *field,
 			*ptr += tmp;
 		}
 	}
+    else if (!strcmp("alpha", field))
+    {
+        double *value = return_value_;
+        *value = mem->alpha;
+    }
+    else if (!strcmp("filter_len", field))
+    {
+        int *value = return_value_;
+        *value = mem->filter_len;
+    }
+    else if (!strcmp("restoration_iter", field))
+    {
+        int *value = return_value_;
+        *value = mem->restoration_iter;
+    }
     else if (!strcmp("nlp_res", field))
     {
         ocp_nlp_res **value = return_value_;
@@ -1098,6 +1522,18 @@ void ocp_nlp_sqp_get(void *config_, void *dims_, void *mem_, const char *field,
 
 
 
+void ocp_nlp_sqp_terminate(void *config_, void *mem_, void *work_)
+{
+    ocp_nlp_sqp_memory *mem = mem_;
+
+    ocp_nlp_memory_terminate(mem->nlp_mem);
+
+    return;
+}
+
+
+
+
 void ocp_nlp_sqp_config_initialize_default(void *config_)
 {
     ocp_nlp_config *config = (ocp_nlp_config *) config_;
@@ -1113,9 +1549,11 @@ void ocp_nlp_sqp_config_initialize_default(void *config_)
     config->workspace_calculate_size = &ocp_nlp_sqp_workspace_calculate_size;
     config->evaluate = &ocp_nlp_sqp;
     config->eval_param_sens = &ocp_nlp_sqp_eval_param_sens;
+    config->eval_param_sens_batch = &ocp_nlp_sqp_eval_param_sens_batch;
     config->config_initialize_default = &ocp_nlp_sqp_config_initialize_default;
     config->precompute = &ocp_nlp_sqp_precompute;
     config->get = &ocp_nlp_sqp_get;
+    config->terminate = &ocp_nlp_sqp_terminate;
 
     return;
 }
@@ -72,6 +72,12 @@ typedef struct
     int rti_phase;       // only phase 0 at the moment 
     int print_level;     // verbosity
     int initialize_t_slacks;  // 0-false or 1-true
+    // filter line search
+    int filter_size;            // maximum number of filter entries
+    double filter_gamma_theta;  // required reduction of the constraint violation
+    double filter_gamma_phi;    // required reduction of the cost, relative to the constraint violation
+    double filter_theta_max;    // upper bound on the constraint violation, relative to the initial one
+    int max_restoration_iter;   // maximum number of consecutive feasibility restoration steps
 
 } ocp_nlp_sqp_opts;
 
@@ -114,6 +120,19 @@ typedef struct
     int stat_m;
     int stat_n;
 
+    // filter entries (constraint violation, cost)
+    double *filter_theta;
+    double *filter_phi;
+    int filter_len;
+    double theta_max;
+
+    // constraint violation and cost at the current iterate
+    double theta;
+    double phi;
+
+    double alpha;
+    int restoration_iter;
+
     int status;
     int sqp_iter;
 
@@ -142,6 +161,9 @@ typedef struct
     ocp_qp_res *qp_res;
     ocp_qp_res_ws *qp_res_ws;
 
+    // backup of the QP gradient during feasibility restoration
+    struct blasfeo_dvec *tmp_rqz;
+
 } ocp_nlp_sqp_workspace;
 
 //
@@ -159,6 +181,8 @@ int ocp_nlp_sqp(void *config, void *dims, void *nlp_in, void *nlp_out,
 //
 void ocp_nlp_sqp_config_initialize_default(void *config_);
 //
+void ocp_nlp_sqp_terminate(void *config_, void *mem_, void *work_);
+//
 int ocp_nlp_sqp_precompute(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
                 void *opts_, void *mem_, void *work_);
 
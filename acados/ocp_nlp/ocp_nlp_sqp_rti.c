@@ -40,9 +40,6 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
-#if defined(ACADOS_WITH_OPENMP)
-#include <omp.h>
-#endif
 
 // blasfeo
 #include "blasfeo/include/blasfeo_d_aux.h"
@@ -127,6 +124,8 @@ void ocp_nlp_sqp_rti_opts_initialize_default(void *config_,
     opts->warm_start_first_qp = false;
     opts->rti_phase = 0;
     opts->print_level = 0;
+    opts->rti_async = 0;
+    opts->worker = NULL;
 
     // overwrite default submodules opts
 
@@ -166,6 +165,17 @@ void ocp_nlp_sqp_rti_opts_update(void *config_, void *dims_, void *opts_)
 
 
 
+static void ocp_nlp_sqp_rti_opts_wait(ocp_nlp_sqp_rti_opts *opts)
+{
+    if (opts->worker != NULL)
+    {
+        acados_worker_wait(opts->worker);
+        opts->worker = NULL;
+    }
+}
+
+
+
 void ocp_nlp_sqp_rti_opts_set(void *config_, void *opts_,
     const char *field, void* value)
 {
@@ -173,6 +183,9 @@ void ocp_nlp_sqp_rti_opts_set(void *config_, void *opts_,
     ocp_nlp_config *config = config_;
     ocp_nlp_opts *nlp_opts = opts->nlp_opts;
 
+    // the options are read by a running asynchronous preparation phase
+    ocp_nlp_sqp_rti_opts_wait(opts);
+
     int ii;
 
     char module[MAX_STR_LEN];
@@ -234,6 +247,19 @@ void ocp_nlp_sqp_rti_opts_set(void *config_, void *opts_,
             }
             opts->print_level = *print_level;
         }
+        else if (!strcmp(field, "rti_async"))
+        {
+            int* rti_async = (int *) value;
+#if defined(ACADOS_WITH_PTHREADS)
+            opts->rti_async = *rti_async;
+#else
+            if (*rti_async != 0)
+            {
+                printf("\nerror: ocp_nlp_sqp_rti_opts_set: rti_async requires acados to be compiled with ACADOS_WITH_PTHREADS.\n");
+                exit(1);
+            }
+#endif
+        }
         else
         {
             ocp_nlp_opts_set(config, nlp_opts, field, value);
@@ -256,6 +282,8 @@ void ocp_nlp_sqp_rti_opts_set_at_stage(void *config_, void *opts_,
     ocp_nlp_sqp_rti_opts *opts = (ocp_nlp_sqp_rti_opts *) opts_;
     ocp_nlp_opts *nlp_opts = opts->nlp_opts;
 
+    ocp_nlp_sqp_rti_opts_wait(opts);
+
     ocp_nlp_opts_set_at_stage(config, nlp_opts, stage, field, value);
 
     return;
@@ -300,7 +328,11 @@ int ocp_nlp_sqp_rti_memory_calculate_size(void *config_,
         stat_n += 4;
     size += stat_n*stat_m*sizeof(double);
 
+    // worker
+    size += sizeof(acados_worker);
+
     size += 8;  // initial align
+    size += 8;  // align
 
     make_int_multiple_of(8, &size);
 
@@ -349,6 +381,16 @@ void *ocp_nlp_sqp_rti_memory_assign(void *config_, void *dims_,
         mem->stat_n += 4;
     c_ptr += mem->stat_m*mem->stat_n*sizeof(double);
 
+    // worker
+    align_char_to(8, &c_ptr);
+    mem->worker = (acados_worker *) c_ptr;
+    c_ptr += sizeof(acados_worker);
+    acados_worker_init(mem->worker);
+    mem->prepared = 0;
+    mem->prep_opts = NULL;
+    mem->prep_nlp_in = NULL;
+    mem->prep_nlp_out = NULL;
+
     mem->status = ACADOS_READY;
 
     assert((char *) raw_memory+ocp_nlp_sqp_rti_memory_calculate_size(
@@ -448,6 +490,18 @@ static void ocp_nlp_sqp_rti_cast_workspace(
  * functions
  ************************************************/
 
+static void ocp_nlp_sqp_rti_preparation_task(void *mem_)
+{
+    ocp_nlp_sqp_rti_memory *mem = mem_;
+
+    ocp_nlp_sqp_rti_preparation_step(mem->prep_config, mem->prep_dims, mem->prep_nlp_in,
+        mem->prep_nlp_out, mem->prep_opts, mem, mem->prep_work);
+
+    return;
+}
+
+
+
 int ocp_nlp_sqp_rti(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     void *opts_, void *mem_, void *work_)
 {
@@ -465,13 +519,21 @@ int ocp_nlp_sqp_rti(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     int rti_phase = nlp_opts->rti_phase; 
 
     acados_tic(&timer0);
+
+    // wait for the preparation phase started by the previous call
+    if (nlp_opts->rti_async)
+        acados_worker_wait(mem->worker);
+
     switch(rti_phase) 
     {
         
         // perform preparation and feedback rti_phase
         case 0:
-            ocp_nlp_sqp_rti_preparation_step(
-                config_, dims_, nlp_in_, nlp_out_, opts_, mem_, work_);
+            if (!(nlp_opts->rti_async && mem->prepared))
+            {
+                ocp_nlp_sqp_rti_preparation_step(
+                    config_, dims_, nlp_in_, nlp_out_, opts_, mem_, work_);
+            }
 
             ocp_nlp_sqp_rti_feedback_step(
                 config_, dims_, nlp_in_, nlp_out_, opts_, mem_, work_);
@@ -493,6 +555,29 @@ int ocp_nlp_sqp_rti(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             break;
     }
 
+    // start the preparation phase for the next sampling instant in the background,
+    // the next call only waits for it and embeds the initial value
+    if (nlp_opts->rti_async && rti_phase != 1 && mem->status == ACADOS_SUCCESS)
+    {
+        mem->prep_config = config_;
+        mem->prep_dims = dims_;
+        mem->prep_nlp_in = nlp_in_;
+        mem->prep_nlp_out = nlp_out_;
+        mem->prep_opts = opts_;
+        mem->prep_work = work_;
+        mem->prepared = 1;
+        // setters on these structs wait for the worker until the preparation is done
+        nlp_opts->worker = mem->worker;
+        ((ocp_nlp_in *) nlp_in_)->worker = mem->worker;
+        nlp_out->worker = mem->worker;
+        acados_worker_submit(mem->worker, &ocp_nlp_sqp_rti_preparation_task, mem);
+    }
+    else
+    {
+        // e.g. after a failed feedback phase, the next call has to prepare the QP again
+        mem->prepared = 0;
+    }
+
     total_time += acados_toc(&timer0);
 
     mem->time_tot = total_time;
@@ -525,24 +610,13 @@ void ocp_nlp_sqp_rti_preparation_step(void *config_, void *dims_,
 
     mem->time_lin = 0.0;
     mem->time_reg = 0.0;
+    acados_thread_pool_reset_stats(nlp_mem->pool);
 
     int N = dims->N;
 
     int ii;
 
-#if defined(ACADOS_WITH_OPENMP)
-    // backup number of threads
-    int num_threads_bkp = omp_get_num_threads();
-    // set number of threads
-    omp_set_num_threads(opts->nlp_opts->num_threads);
-    #pragma omp parallel
-    { // beginning of parallel region
-#endif
-
     // alias to dynamics_memory
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp for nowait
-#endif
     for (ii = 0; ii < N; ii++)
     {
         config->dynamics[ii]->memory_set_ux_ptr(
@@ -578,12 +652,15 @@ void ocp_nlp_sqp_rti_preparation_step(void *config_, void *dims_,
 
         config->dynamics[ii]->memory_set_z_alg_ptr(
                 nlp_mem->z_alg+ii, nlp_mem->dynamics[ii]);
+
+        config->dynamics[ii]->memory_set_x_dense_ptr(
+                nlp_mem->x_dense+ii, nlp_mem->dynamics[ii]);
+
+        config->dynamics[ii]->memory_set_dxdenseduxt_ptr(
+                nlp_mem->dxdenseduxt+ii, nlp_mem->dynamics[ii]);
     }
 
     // alias to cost_memory
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp for nowait
-#endif
     for (ii = 0; ii <= N; ii++)
     {
         config->cost[ii]->memory_set_ux_ptr(
@@ -606,9 +683,6 @@ void ocp_nlp_sqp_rti_preparation_step(void *config_, void *dims_,
     }
 
     // alias to constraints_memory
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp for nowait
-#endif
     for (ii = 0; ii <= N; ii++)
     {
         config->constraints[ii]->memory_set_ux_ptr(
@@ -629,6 +703,12 @@ void ocp_nlp_sqp_rti_preparation_step(void *config_, void *dims_,
         config->constraints[ii]->memory_set_dzdux_tran_ptr(
             nlp_mem->dzduxt+ii, nlp_mem->constraints[ii]);
 
+        config->constraints[ii]->memory_set_x_dense_ptr(
+            nlp_mem->x_dense+ii, nlp_mem->constraints[ii]);
+
+        config->constraints[ii]->memory_set_dxdense_dux_tran_ptr(
+            nlp_mem->dxdenseduxt+ii, nlp_mem->constraints[ii]);
+
         config->constraints[ii]->memory_set_DCt_ptr(
             nlp_mem->qp_in->DCt+ii, nlp_mem->constraints[ii]);
 
@@ -674,10 +754,6 @@ void ocp_nlp_sqp_rti_preparation_step(void *config_, void *dims_,
         dims->regularize, nlp_mem->qp_out->lam, nlp_mem->regularize_mem);
 
     // copy sampling times into dynamics model
-#if defined(ACADOS_WITH_OPENMP)
-    #pragma omp for nowait
-#endif
-
     // NOTE(oj): this will lead in an error for irk_gnsf, T must be set in precompute;
     //    -> remove here and make sure precompute is called everywhere (e.g. Python interface).
     for (ii = 0; ii < N; ii++)
@@ -686,10 +762,6 @@ void ocp_nlp_sqp_rti_preparation_step(void *config_, void *dims_,
                                          nlp_in->dynamics[ii], "T", nlp_in->Ts+ii);
     }
 
-#if defined(ACADOS_WITH_OPENMP)
-    } // end of parallel region
-#endif
-
     // initialize QP
     ocp_nlp_initialize_qp(config, dims, nlp_in, nlp_out,
         nlp_opts, nlp_mem, nlp_work);
@@ -705,10 +777,22 @@ void ocp_nlp_sqp_rti_preparation_step(void *config_, void *dims_,
 
     mem->time_lin += acados_toc(&timer1);
 
-#if defined(ACADOS_WITH_OPENMP)
-    // restore number of threads
-    omp_set_num_threads(num_threads_bkp);
-#endif
+    if (opts->rti_async)
+    {
+        // only the initial value is embedded in the feedback phase:
+        // QP vectors and regularization do not depend on it
+        ocp_nlp_approximate_qp_vectors_sqp(config, dims, nlp_in,
+            nlp_out, nlp_opts, nlp_mem, nlp_work);
+
+        acados_tic(&timer1);
+        config->regularize->regularize_hessian(config->regularize,
+            dims->regularize, opts->nlp_opts->regularize, nlp_mem->regularize_mem);
+        if (config->regularize->regularize_writes_qp_mat)
+            config->qp_solver->memory_set(config->qp_solver, nlp_mem->qp_solver_mem,
+                "mat_dirty_all", NULL);
+        mem->time_reg += acados_toc(&timer1);
+    }
+
 	
 	return;
 
@@ -746,15 +830,21 @@ void ocp_nlp_sqp_rti_feedback_step(void *config_, void *dims_,
     ocp_nlp_embed_initial_value(config, dims, nlp_in,
         nlp_out, nlp_opts, nlp_mem, nlp_work);
 
-    // update QP rhs for SQP (step prim var, abs dual var)
-    ocp_nlp_approximate_qp_vectors_sqp(config, dims, nlp_in,
-        nlp_out, nlp_opts, nlp_mem, nlp_work);
-
-    // regularize Hessian
-    acados_tic(&timer1);
-    config->regularize->regularize_hessian(config->regularize,
-        dims->regularize, opts->nlp_opts->regularize, nlp_mem->regularize_mem);
-    mem->time_reg += acados_toc(&timer1);
+    if (!opts->rti_async)
+    {
+        // update QP rhs for SQP (step prim var, abs dual var)
+        ocp_nlp_approximate_qp_vectors_sqp(config, dims, nlp_in,
+            nlp_out, nlp_opts, nlp_mem, nlp_work);
+
+        // regularize Hessian
+        acados_tic(&timer1);
+        config->regularize->regularize_hessian(config->regularize,
+            dims->regularize, opts->nlp_opts->regularize, nlp_mem->regularize_mem);
+        if (config->regularize->regularize_writes_qp_mat)
+            config->qp_solver->memory_set(config->qp_solver, nlp_mem->qp_solver_mem,
+                "mat_dirty_all", NULL);
+        mem->time_reg += acados_toc(&timer1);
+    }
 
     if (opts->print_level > 0) {
         printf("\n------- qp_in --------\n");
@@ -785,6 +875,10 @@ void ocp_nlp_sqp_rti_feedback_step(void *config_, void *dims_,
     acados_tic(&timer1);
     config->regularize->correct_dual_sol(config->regularize,
         dims->regularize, opts->nlp_opts->regularize, nlp_mem->regularize_mem);
+    // the regularization may restore the original Hessian in qp_in
+    if (config->regularize->correct_writes_qp_mat)
+        config->qp_solver->memory_set(config->qp_solver, nlp_mem->qp_solver_mem,
+            "mat_dirty_all", NULL);
 
     mem->time_reg += acados_toc(&timer1);
 
@@ -823,9 +917,16 @@ void ocp_nlp_sqp_rti_feedback_step(void *config_, void *dims_,
         return;
     }
 
-    ocp_nlp_update_variables_sqp(config, dims, nlp_in,
+    int ls_status = ocp_nlp_update_variables_sqp(config, dims, nlp_in,
         nlp_out, nlp_opts, nlp_mem, nlp_work);
 
+    if (ls_status != ACADOS_SUCCESS)
+    {
+        printf("line search failed, status %d\n", ls_status);
+        mem->status = ls_status;
+        return;
+    }
+
     // ocp_nlp_dims_print(nlp_out->dims);
     // ocp_nlp_out_print(nlp_out);
     // exit(1);
@@ -853,6 +954,9 @@ int ocp_nlp_sqp_rti_precompute(void *config_, void *dims_, void *nlp_in_,
     ocp_nlp_sqp_rti_cast_workspace(config, dims, opts, mem, work);
     ocp_nlp_workspace *nlp_work = work->nlp_work;
 
+    acados_worker_wait(mem->worker);
+    mem->prepared = 0;
+
     int N = dims->N;
     int status = ACADOS_SUCCESS;
 
@@ -912,6 +1016,9 @@ void ocp_nlp_sqp_rti_eval_param_sens(void *config_, void *dims_, void *opts_,
     ocp_nlp_sqp_rti_cast_workspace(config, dims, opts, mem, work);
     ocp_nlp_workspace *nlp_work = work->nlp_work;
 
+    // NOTE: with rti_async, the QP is already linearized at the next iterate
+    acados_worker_wait(mem->worker);
+
     d_ocp_qp_copy_all(nlp_mem->qp_in, work->tmp_qp_in);
     d_ocp_qp_set_rhs_zero(work->tmp_qp_in);
 
@@ -972,6 +1079,28 @@ void ocp_nlp_sqp_rti_eval_param_sens(void *config_, void *dims_, void *opts_,
 
 
 
+void ocp_nlp_sqp_rti_eval_param_sens_batch(void *config_, void *dims_, void *opts_, void *mem_,
+        void *work_, char *field, int stage, int n_dir, int *index, double *sens, int ld_sens)
+{
+    ocp_nlp_dims *dims = dims_;
+    ocp_nlp_config *config = config_;
+    ocp_nlp_sqp_rti_opts *opts = opts_;
+    ocp_nlp_sqp_rti_memory *mem = mem_;
+
+    ocp_nlp_sqp_rti_workspace *work = work_;
+    ocp_nlp_sqp_rti_cast_workspace(config, dims, opts, mem, work);
+
+    // NOTE: with rti_async, the QP is already linearized at the next iterate
+    acados_worker_wait(mem->worker);
+
+    ocp_nlp_eval_param_sens_batch_qp(config, dims, opts->nlp_opts, mem->nlp_mem, work->nlp_work,
+        work->tmp_qp_in, work->tmp_qp_out, field, stage, n_dir, index, sens, ld_sens);
+
+    return;
+}
+
+
+
 // TODO rename memory_get ???
 void ocp_nlp_sqp_rti_get(void *config_, void *dims_, void *mem_,
     const char *field, void *return_value_)
@@ -980,6 +1109,15 @@ void ocp_nlp_sqp_rti_get(void *config_, void *dims_, void *mem_,
     ocp_nlp_dims *dims = dims_;
     ocp_nlp_sqp_rti_memory *mem = mem_;
 
+    // all fields but the ones set in the feedback phase are written by a running preparation phase
+    if (strcmp("sqp_iter", field) && strcmp("status", field) && strcmp("time_tot", field) &&
+        strcmp("tot_time", field) && strcmp("time_qp_sol", field) && strcmp("time_qp", field) &&
+        strcmp("time_qp_solver", field) && strcmp("time_qp_solver_call", field) &&
+        strcmp("time_qp_xcond", field) && strcmp("stat", field) && strcmp("statistics", field))
+    {
+        acados_worker_wait(mem->worker);
+    }
+
     if (!strcmp("sqp_iter", field))
     {
         int *value = return_value_;
@@ -1020,6 +1158,11 @@ void ocp_nlp_sqp_rti_get(void *config_, void *dims_, void *mem_,
         double *value = return_value_;
         *value = mem->time_reg;
     }
+    else if (!strcmp("thread_utilization", field))
+    {
+        double *value = return_value_;
+        acados_thread_pool_get_utilization(mem->nlp_mem->pool, value);
+    }
     else if (!strcmp("time_sim", field) || !strcmp("time_sim_ad", field) || !strcmp("time_sim_la", field))
     {
         double tmp = 0.0;
@@ -1103,6 +1246,38 @@ void ocp_nlp_sqp_rti_get(void *config_, void *dims_, void *mem_,
 }
 
 
+void ocp_nlp_sqp_rti_wait(void *config_, void *mem_)
+{
+    ocp_nlp_sqp_rti_memory *mem = mem_;
+
+    acados_worker_wait(mem->worker);
+
+    return;
+}
+
+
+
+void ocp_nlp_sqp_rti_terminate(void *config_, void *mem_, void *work_)
+{
+    ocp_nlp_sqp_rti_memory *mem = mem_;
+
+    acados_worker_stop(mem->worker);
+
+    // the worker is gone, the structs of the last preparation must not wait for it anymore
+    if (mem->prep_opts != NULL)
+    {
+        ((ocp_nlp_sqp_rti_opts *) mem->prep_opts)->worker = NULL;
+        ((ocp_nlp_in *) mem->prep_nlp_in)->worker = NULL;
+        ((ocp_nlp_out *) mem->prep_nlp_out)->worker = NULL;
+    }
+
+    ocp_nlp_memory_terminate(mem->nlp_mem);
+
+    return;
+}
+
+
+
 void ocp_nlp_sqp_rti_config_initialize_default(void *config_)
 {
     ocp_nlp_config *config = (ocp_nlp_config *) config_;
@@ -1118,9 +1293,12 @@ void ocp_nlp_sqp_rti_config_initialize_default(void *config_)
     config->workspace_calculate_size = &ocp_nlp_sqp_rti_workspace_calculate_size;
     config->evaluate = &ocp_nlp_sqp_rti;
     config->eval_param_sens = &ocp_nlp_sqp_rti_eval_param_sens;
+    config->eval_param_sens_batch = &ocp_nlp_sqp_rti_eval_param_sens_batch;
     config->config_initialize_default = &ocp_nlp_sqp_rti_config_initialize_default;
     config->precompute = &ocp_nlp_sqp_rti_precompute;
     config->get = &ocp_nlp_sqp_rti_get;
+    config->wait = &ocp_nlp_sqp_rti_wait;
+    config->terminate = &ocp_nlp_sqp_rti_terminate;
 
     return;
 }
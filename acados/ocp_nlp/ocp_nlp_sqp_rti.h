@@ -49,6 +49,7 @@ extern "C" {
 // acados
 #include "acados/ocp_nlp/ocp_nlp_common.h"
 #include "acados/sim/sim_common.h"
+#include "acados/utils/threads.h"
 #include "acados/utils/types.h"
 
 
@@ -67,6 +68,8 @@ typedef struct
     bool warm_start_first_qp; // to set qp_warm_start in first iteration
     int rti_phase;            // phase of RTI. Possible values 1 (preparation), 2 (feedback) 0 (both)
     int print_level;          // possible values 0, 1 
+    int rti_async;            // run the preparation phase on a worker thread after each feedback phase
+    acados_worker *worker;    // worker of a running asynchronous preparation phase using these opts (or NULL)
 
 } ocp_nlp_sqp_rti_opts;
 
@@ -111,6 +114,17 @@ typedef struct
 
     int status;
 
+    // asynchronous preparation phase
+    acados_worker *worker;
+    int prepared;  // the QP matrices are prepared (or being prepared) for the next feedback phase
+    // arguments of the preparation task
+    void *prep_config;
+    void *prep_dims;
+    void *prep_nlp_in;
+    void *prep_nlp_out;
+    void *prep_opts;
+    void *prep_work;
+
 } ocp_nlp_sqp_rti_memory;
 
 //
@@ -163,6 +177,10 @@ void ocp_nlp_sqp_rti_preparation_step(void *config_, void *dims_,
 void ocp_nlp_sqp_rti_feedback_step(void *config_, void *dims_,
     void *nlp_in_, void *nlp_out_, void *opts_, void *mem_, void *work_);
 //
+void ocp_nlp_sqp_rti_wait(void *config_, void *mem_);
+//
+void ocp_nlp_sqp_rti_terminate(void *config_, void *mem_, void *work_);
+//
 void ocp_nlp_sqp_rti_config_initialize_default(void *config_);
 //
 int ocp_nlp_sqp_rti_precompute(void *config_, void *dims_,
@@ -90,6 +90,7 @@ typedef struct
     void (*opts_initialize_default)(void *dims, void *opts);
     void (*opts_update)(void *dims, void *opts);
     void (*opts_set)(void *opts_, const char *field, void* value);
+    void (*opts_copy)(void *dims, void *opts_src, void *opts_dst);  // opts assigned with the same N
     int (*memory_calculate_size)(void *dims, void *opts);
     void *(*memory_assign)(void *dims, void *opts, void *raw_memory);
     void (*memory_get)(void *config, void *mem, const char *field, void* value);
@@ -112,6 +113,7 @@ typedef struct
     double total_time;
     int num_iter;
     int t_computed;
+    int num_cond_skip;  // number of solves that reused the condensed matrices
 } qp_info;
 #endif
 
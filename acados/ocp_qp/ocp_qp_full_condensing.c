@@ -297,6 +297,30 @@ void ocp_qp_full_condensing_opts_set(void *opts_, const char *field, void* value
 
 
 
+void ocp_qp_full_condensing_opts_copy(void *dims_, void *opts_src_, void *opts_dst_)
+{
+    ocp_qp_full_condensing_opts *opts_src = opts_src_;
+    ocp_qp_full_condensing_opts *opts_dst = opts_dst_;
+
+    opts_dst->cond_hess = opts_src->cond_hess;
+    opts_dst->expand_dual_sol = opts_src->expand_dual_sol;
+    opts_dst->ric_alg = opts_src->ric_alg;
+    opts_dst->mem_qp_in = opts_src->mem_qp_in;
+
+    // hpipm_cond_opts
+    d_cond_qp_arg_set_default(opts_dst->hpipm_cond_opts);
+    d_cond_qp_arg_set_ric_alg(opts_dst->ric_alg, opts_dst->hpipm_cond_opts);
+    // hpipm_red_opts
+    d_ocp_qp_reduce_eq_dof_arg_set_default(opts_dst->hpipm_red_opts);
+    d_ocp_qp_reduce_eq_dof_arg_set_alias_unchanged(opts_dst->hpipm_red_opts, 1);
+    d_ocp_qp_reduce_eq_dof_arg_set_comp_dual_sol_eq(opts_dst->hpipm_red_opts, opts_dst->expand_dual_sol);
+    d_ocp_qp_reduce_eq_dof_arg_set_comp_dual_sol_ineq(opts_dst->hpipm_red_opts, opts_dst->expand_dual_sol);
+
+    return;
+}
+
+
+
 /************************************************
  * memory
  ************************************************/
@@ -565,6 +589,7 @@ void ocp_qp_full_condensing_config_initialize_default(void *config_)
     config->opts_initialize_default = &ocp_qp_full_condensing_opts_initialize_default;
     config->opts_update = &ocp_qp_full_condensing_opts_update;
     config->opts_set = &ocp_qp_full_condensing_opts_set;
+    config->opts_copy = &ocp_qp_full_condensing_opts_copy;
     config->memory_calculate_size = &ocp_qp_full_condensing_memory_calculate_size;
     config->memory_assign = &ocp_qp_full_condensing_memory_assign;
     config->memory_get = &ocp_qp_full_condensing_memory_get;
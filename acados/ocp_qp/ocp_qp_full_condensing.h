@@ -98,6 +98,8 @@ void ocp_qp_full_condensing_opts_update(void *dims, void *opts_);
 //
 void ocp_qp_full_condensing_opts_set(void *opts_, const char *field, void* value);
 //
+void ocp_qp_full_condensing_opts_copy(void *dims, void *opts_src, void *opts_dst);
+//
 int ocp_qp_full_condensing_memory_calculate_size(void *dims, void *opts_);
 //
 void *ocp_qp_full_condensing_memory_assign(void *dims, void *opts_, void *raw_memory);
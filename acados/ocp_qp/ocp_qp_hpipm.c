@@ -40,6 +40,10 @@
 #include "hpipm/include/hpipm_d_ocp_qp.h"
 #include "hpipm/include/hpipm_d_ocp_qp_ipm.h"
 #include "hpipm/include/hpipm_d_ocp_qp_sol.h"
+#include "hpipm/include/hpipm_s_ocp_qp.h"
+#include "hpipm/include/hpipm_s_ocp_qp_dim.h"
+#include "hpipm/include/hpipm_s_ocp_qp_ipm.h"
+#include "hpipm/include/hpipm_s_ocp_qp_sol.h"
 // acados
 #include "acados/ocp_qp/ocp_qp_common.h"
 #include "acados/ocp_qp/ocp_qp_hpipm.h"
@@ -50,6 +54,11 @@
 
 
 
+// smallest tolerance requested from the single precision ipm
+#define HPIPM_SINGLE_TOL_MIN 1e-5
+
+
+
 /************************************************
  * opts
  ************************************************/
@@ -62,8 +71,12 @@ int ocp_qp_hpipm_opts_calculate_size(void *config_, void *dims_)
     size += sizeof(ocp_qp_hpipm_opts);
     size += sizeof(struct d_ocp_qp_ipm_arg);
     size += d_ocp_qp_ipm_arg_memsize(dims);
+    // NOTE: the ipm arg does not depend on the precision of the dims, whose structs only
+    // contain integers and are laid out identically in hpipm
+    size += sizeof(struct s_ocp_qp_ipm_arg);
+    size += s_ocp_qp_ipm_arg_memsize((struct s_ocp_qp_dim *) dims);
 
-    size += 1 * 8;
+    size += 2 * 8;
     make_int_multiple_of(8, &size);
 
     return size;
@@ -84,12 +97,20 @@ void *ocp_qp_hpipm_opts_assign(void *config_, void *dims_, void *raw_memory)
     opts->hpipm_opts = (struct d_ocp_qp_ipm_arg *) c_ptr;
     c_ptr += sizeof(struct d_ocp_qp_ipm_arg);
 
+    opts->s_hpipm_opts = (struct s_ocp_qp_ipm_arg *) c_ptr;
+    c_ptr += sizeof(struct s_ocp_qp_ipm_arg);
+
     align_char_to(8, &c_ptr);
     assert((size_t) c_ptr % 8 == 0 && "memory not 8-byte aligned!");
 
     d_ocp_qp_ipm_arg_create(dims, opts->hpipm_opts, c_ptr);
     c_ptr += d_ocp_qp_ipm_arg_memsize(dims);
 
+    align_char_to(8, &c_ptr);
+
+    s_ocp_qp_ipm_arg_create((struct s_ocp_qp_dim *) dims, opts->s_hpipm_opts, c_ptr);
+    c_ptr += s_ocp_qp_ipm_arg_memsize((struct s_ocp_qp_dim *) dims);
+
     assert((char *) raw_memory + ocp_qp_hpipm_opts_calculate_size(config_, dims) >= c_ptr);
 
     return (void *) opts;
@@ -115,6 +136,21 @@ void ocp_qp_hpipm_opts_initialize_default(void *config_, void *dims_, void *opts
     opts->hpipm_opts->mu0 = 1e0;
     opts->hpipm_opts->var_init_scheme = 1;
 
+    // single precision ipm, used in mixed precision mode
+    s_ocp_qp_ipm_arg_set_default(BALANCE, opts->s_hpipm_opts);
+    opts->s_hpipm_opts->res_g_max = HPIPM_SINGLE_TOL_MIN;
+    opts->s_hpipm_opts->res_b_max = HPIPM_SINGLE_TOL_MIN;
+    opts->s_hpipm_opts->res_d_max = HPIPM_SINGLE_TOL_MIN;
+    opts->s_hpipm_opts->res_m_max = HPIPM_SINGLE_TOL_MIN;
+    opts->s_hpipm_opts->iter_max = 50;
+    opts->s_hpipm_opts->stat_max = 50;
+    opts->s_hpipm_opts->alpha_min = 1e-8;
+    opts->s_hpipm_opts->mu0 = 1e0;
+    opts->s_hpipm_opts->var_init_scheme = 1;
+
+    opts->mixed_precision = 0;
+    opts->itref_mixed = 1;
+
     return;
 }
 
@@ -133,8 +169,39 @@ void ocp_qp_hpipm_opts_set(void *config_, void *opts_, const char *field, void *
 {
     ocp_qp_hpipm_opts *opts = opts_;
 
+    if (!strcmp(field, "mixed_precision"))
+    {
+        int *tmp_ptr = value;
+        opts->mixed_precision = *tmp_ptr;
+        return;
+    }
+    else if (!strcmp(field, "itref_mixed"))
+    {
+        int *tmp_ptr = value;
+        opts->itref_mixed = *tmp_ptr;
+        return;
+    }
+
     d_ocp_qp_ipm_arg_set((char *) field, value, opts->hpipm_opts);
 
+    // keep the single precision ipm in sync, real valued fields are passed as float
+    if (!strcmp(field, "mu0") || !strcmp(field, "alpha_min") || !strcmp(field, "reg_prim") ||
+        !strcmp(field, "lam_min") || !strcmp(field, "t_min") || !strcmp(field, "tau_min"))
+    {
+        float tmp = (float) *((double *) value);
+        s_ocp_qp_ipm_arg_set((char *) field, &tmp, opts->s_hpipm_opts);
+    }
+    else if (!strncmp(field, "tol_", 4))
+    {
+        double tol = *((double *) value);
+        float tmp = (float) (tol > HPIPM_SINGLE_TOL_MIN ? tol : HPIPM_SINGLE_TOL_MIN);
+        s_ocp_qp_ipm_arg_set((char *) field, &tmp, opts->s_hpipm_opts);
+    }
+    else
+    {
+        s_ocp_qp_ipm_arg_set((char *) field, value, opts->s_hpipm_opts);
+    }
+
     return;
 }
 
@@ -156,6 +223,23 @@ int ocp_qp_hpipm_memory_calculate_size(void *config_, void *dims_, void *opts_)
 
     size += d_ocp_qp_ipm_ws_memsize(dims, opts->hpipm_opts);
 
+    if (opts->mixed_precision)
+    {
+        // single precision copy of the qp (dims are integer only, see opts_calculate_size)
+        struct s_ocp_qp_dim *s_dims = (struct s_ocp_qp_dim *) dims;
+
+        size += sizeof(struct s_ocp_qp_dim) + s_ocp_qp_dim_memsize(dims->N);
+        size += sizeof(struct s_ocp_qp) + s_ocp_qp_memsize(s_dims);
+        size += 2 * (sizeof(struct s_ocp_qp_sol) + s_ocp_qp_sol_memsize(s_dims));
+        size += sizeof(struct s_ocp_qp_ipm_ws) + s_ocp_qp_ipm_ws_memsize(s_dims, opts->s_hpipm_opts);
+
+        // double precision residuals
+        size += ocp_qp_res_calculate_size(dims);
+        size += ocp_qp_res_workspace_calculate_size(dims);
+
+        size += 6 * 8;
+    }
+
     size += 1 * 8;
     make_int_multiple_of(8, &size);
 
@@ -188,6 +272,71 @@ void *ocp_qp_hpipm_memory_assign(void *config_, void *dims_, void *opts_, void *
     d_ocp_qp_ipm_ws_create(dims, opts->hpipm_opts, ipm_workspace, c_ptr);
     c_ptr += ipm_workspace->memsize;
 
+    mem->itref_mixed_iter = 0;
+
+    if (opts->mixed_precision)
+    {
+        int N = dims->N;
+
+        // single precision dims
+        mem->s_dims = (struct s_ocp_qp_dim *) c_ptr;
+        c_ptr += sizeof(struct s_ocp_qp_dim);
+        align_char_to(8, &c_ptr);
+        s_ocp_qp_dim_create(N, mem->s_dims, c_ptr);
+        c_ptr += mem->s_dims->memsize;
+
+        for (int ii = 0; ii <= N; ii++)
+        {
+            s_ocp_qp_dim_set("nx", ii, dims->nx[ii], mem->s_dims);
+            s_ocp_qp_dim_set("nu", ii, dims->nu[ii], mem->s_dims);
+            s_ocp_qp_dim_set("nbx", ii, dims->nbx[ii], mem->s_dims);
+            s_ocp_qp_dim_set("nbu", ii, dims->nbu[ii], mem->s_dims);
+            s_ocp_qp_dim_set("ng", ii, dims->ng[ii], mem->s_dims);
+            s_ocp_qp_dim_set("nsbx", ii, dims->nsbx[ii], mem->s_dims);
+            s_ocp_qp_dim_set("nsbu", ii, dims->nsbu[ii], mem->s_dims);
+            s_ocp_qp_dim_set("nsg", ii, dims->nsg[ii], mem->s_dims);
+            s_ocp_qp_dim_set("nbxe", ii, dims->nbxe[ii], mem->s_dims);
+            s_ocp_qp_dim_set("nbue", ii, dims->nbue[ii], mem->s_dims);
+            s_ocp_qp_dim_set("nge", ii, dims->nge[ii], mem->s_dims);
+        }
+
+        // single precision qp
+        mem->s_qp = (struct s_ocp_qp *) c_ptr;
+        c_ptr += sizeof(struct s_ocp_qp);
+        align_char_to(8, &c_ptr);
+        s_ocp_qp_create(mem->s_dims, mem->s_qp, c_ptr);
+        c_ptr += mem->s_qp->memsize;
+
+        // single precision solution and iterative refinement step
+        mem->s_qp_sol = (struct s_ocp_qp_sol *) c_ptr;
+        c_ptr += sizeof(struct s_ocp_qp_sol);
+        align_char_to(8, &c_ptr);
+        s_ocp_qp_sol_create(mem->s_dims, mem->s_qp_sol, c_ptr);
+        c_ptr += mem->s_qp_sol->memsize;
+
+        mem->s_qp_step = (struct s_ocp_qp_sol *) c_ptr;
+        c_ptr += sizeof(struct s_ocp_qp_sol);
+        align_char_to(8, &c_ptr);
+        s_ocp_qp_sol_create(mem->s_dims, mem->s_qp_step, c_ptr);
+        c_ptr += mem->s_qp_step->memsize;
+
+        // single precision ipm workspace
+        mem->s_hpipm_workspace = (struct s_ocp_qp_ipm_ws *) c_ptr;
+        c_ptr += sizeof(struct s_ocp_qp_ipm_ws);
+        align_char_to(8, &c_ptr);
+        s_ocp_qp_ipm_ws_create(mem->s_dims, opts->s_hpipm_opts, mem->s_hpipm_workspace, c_ptr);
+        c_ptr += mem->s_hpipm_workspace->memsize;
+
+        // double precision residuals
+        align_char_to(8, &c_ptr);
+        mem->res = ocp_qp_res_assign(dims, c_ptr);
+        c_ptr += ocp_qp_res_calculate_size(dims);
+
+        align_char_to(8, &c_ptr);
+        mem->res_ws = ocp_qp_res_workspace_assign(dims, c_ptr);
+        c_ptr += ocp_qp_res_workspace_calculate_size(dims);
+    }
+
     assert((char *) raw_memory + ocp_qp_hpipm_memory_calculate_size(config_, dims, opts_) >= c_ptr);
 
     return mem;
@@ -210,6 +359,23 @@ void ocp_qp_hpipm_memory_get(void *config_, void *mem_, const char *field, void*
         int *tmp_ptr = value;
         *tmp_ptr = mem->iter;
     }
+    else if (!strcmp(field, "res_single"))
+    {
+        double *tmp_ptr = value;
+        for (int ii = 0; ii < 4; ii++)
+            tmp_ptr[ii] = mem->res_single[ii];
+    }
+    else if (!strcmp(field, "res_mixed"))
+    {
+        double *tmp_ptr = value;
+        for (int ii = 0; ii < 4; ii++)
+            tmp_ptr[ii] = mem->res_mixed[ii];
+    }
+    else if (!strcmp(field, "itref_mixed_iter"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->itref_mixed_iter;
+    }
     else
     {
         printf("\nerror: ocp_qp_hpipm_memory_get: field %s not available\n", field);
@@ -233,6 +399,209 @@ int ocp_qp_hpipm_workspace_calculate_size(void *config_, void *dims_, void *opts
 
 
 
+/************************************************
+ * mixed precision
+ ************************************************/
+
+static void ocp_qp_hpipm_cvt_dmat_to_smat(int m, int n, struct blasfeo_dmat *A,
+                                          struct blasfeo_smat *sA)
+{
+    for (int jj = 0; jj < n; jj++)
+        for (int ii = 0; ii < m; ii++)
+            BLASFEO_SMATEL(sA, ii, jj) = (float) BLASFEO_DMATEL(A, ii, jj);
+}
+
+
+
+static void ocp_qp_hpipm_cvt_dvec_to_svec(int m, struct blasfeo_dvec *v, struct blasfeo_svec *sv)
+{
+    for (int ii = 0; ii < m; ii++)
+        BLASFEO_SVECEL(sv, ii) = (float) BLASFEO_DVECEL(v, ii);
+}
+
+
+
+// vectors of the qp, the matrices are left unchanged
+static void ocp_qp_hpipm_cvt_qp_vec_d2s(ocp_qp_in *qp_in, struct s_ocp_qp *s_qp)
+{
+    int N = qp_in->dim->N;
+    int *nx = qp_in->dim->nx;
+    int *nu = qp_in->dim->nu;
+    int *nb = qp_in->dim->nb;
+    int *ng = qp_in->dim->ng;
+    int *ns = qp_in->dim->ns;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        int nv = nu[ii] + nx[ii];
+        int nc = 2 * nb[ii] + 2 * ng[ii] + 2 * ns[ii];
+
+        if (ii < N)
+            ocp_qp_hpipm_cvt_dvec_to_svec(nx[ii+1], qp_in->b+ii, s_qp->b+ii);
+        ocp_qp_hpipm_cvt_dvec_to_svec(nv + 2 * ns[ii], qp_in->rqz+ii, s_qp->rqz+ii);
+        ocp_qp_hpipm_cvt_dvec_to_svec(nc, qp_in->d+ii, s_qp->d+ii);
+        ocp_qp_hpipm_cvt_dvec_to_svec(nc, qp_in->d_mask+ii, s_qp->d_mask+ii);
+        ocp_qp_hpipm_cvt_dvec_to_svec(nc, qp_in->m+ii, s_qp->m+ii);
+    }
+}
+
+
+
+static void ocp_qp_hpipm_cvt_qp_d2s(ocp_qp_in *qp_in, struct s_ocp_qp *s_qp)
+{
+    int N = qp_in->dim->N;
+    int *nx = qp_in->dim->nx;
+    int *nu = qp_in->dim->nu;
+    int *nb = qp_in->dim->nb;
+    int *ng = qp_in->dim->ng;
+    int *ns = qp_in->dim->ns;
+    int *nbxe = qp_in->dim->nbxe;
+    int *nbue = qp_in->dim->nbue;
+    int *nge = qp_in->dim->nge;
+
+    ocp_qp_hpipm_cvt_qp_vec_d2s(qp_in, s_qp);
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        int nv = nu[ii] + nx[ii];
+
+        if (ii < N)
+            ocp_qp_hpipm_cvt_dmat_to_smat(nv + 1, nx[ii+1], qp_in->BAbt+ii, s_qp->BAbt+ii);
+        ocp_qp_hpipm_cvt_dmat_to_smat(nv + 1, nv, qp_in->RSQrq+ii, s_qp->RSQrq+ii);
+        ocp_qp_hpipm_cvt_dmat_to_smat(nv, ng[ii], qp_in->DCt+ii, s_qp->DCt+ii);
+        ocp_qp_hpipm_cvt_dvec_to_svec(2 * ns[ii], qp_in->Z+ii, s_qp->Z+ii);
+
+        for (int jj = 0; jj < nb[ii]; jj++)
+            s_qp->idxb[ii][jj] = qp_in->idxb[ii][jj];
+        for (int jj = 0; jj < nb[ii] + ng[ii]; jj++)
+            s_qp->idxs_rev[ii][jj] = qp_in->idxs_rev[ii][jj];
+        for (int jj = 0; jj < nbxe[ii] + nbue[ii] + nge[ii]; jj++)
+            s_qp->idxe[ii][jj] = qp_in->idxe[ii][jj];
+        s_qp->diag_H_flag[ii] = qp_in->diag_H_flag[ii];
+    }
+}
+
+
+
+// load the double precision residuals as right hand side of the single precision kkt system
+static void ocp_qp_hpipm_cvt_res_d2s(ocp_qp_res *res, struct s_ocp_qp *s_qp)
+{
+    int N = res->dim->N;
+    int *nx = res->dim->nx;
+    int *nu = res->dim->nu;
+    int *nb = res->dim->nb;
+    int *ng = res->dim->ng;
+    int *ns = res->dim->ns;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        int nc = 2 * nb[ii] + 2 * ng[ii] + 2 * ns[ii];
+
+        if (ii < N)
+            ocp_qp_hpipm_cvt_dvec_to_svec(nx[ii+1], res->res_b+ii, s_qp->b+ii);
+        ocp_qp_hpipm_cvt_dvec_to_svec(nu[ii] + nx[ii] + 2 * ns[ii], res->res_g+ii, s_qp->rqz+ii);
+        ocp_qp_hpipm_cvt_dvec_to_svec(nc, res->res_d+ii, s_qp->d+ii);
+        ocp_qp_hpipm_cvt_dvec_to_svec(nc, res->res_m+ii, s_qp->m+ii);
+    }
+}
+
+
+
+// qp_out (+)= alpha * s_sol, returns 0 if the multipliers or slacks turned negative
+static int ocp_qp_hpipm_add_sol_s2d(double alpha, struct s_ocp_qp_sol *s_sol, ocp_qp_out *qp_out,
+                                    int overwrite)
+{
+    int N = qp_out->dim->N;
+    int *nx = qp_out->dim->nx;
+    int *nu = qp_out->dim->nu;
+    int *nb = qp_out->dim->nb;
+    int *ng = qp_out->dim->ng;
+    int *ns = qp_out->dim->ns;
+
+    int positive = 1;
+    double beta = overwrite ? 0.0 : 1.0;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        int nc = 2 * nb[ii] + 2 * ng[ii] + 2 * ns[ii];
+
+        for (int jj = 0; jj < nu[ii] + nx[ii] + 2 * ns[ii]; jj++)
+            BLASFEO_DVECEL(qp_out->ux+ii, jj) = beta * BLASFEO_DVECEL(qp_out->ux+ii, jj)
+                                              + alpha * BLASFEO_SVECEL(s_sol->ux+ii, jj);
+        if (ii < N)
+        {
+            for (int jj = 0; jj < nx[ii+1]; jj++)
+                BLASFEO_DVECEL(qp_out->pi+ii, jj) = beta * BLASFEO_DVECEL(qp_out->pi+ii, jj)
+                                                  + alpha * BLASFEO_SVECEL(s_sol->pi+ii, jj);
+        }
+        for (int jj = 0; jj < nc; jj++)
+        {
+            BLASFEO_DVECEL(qp_out->lam+ii, jj) = beta * BLASFEO_DVECEL(qp_out->lam+ii, jj)
+                                               + alpha * BLASFEO_SVECEL(s_sol->lam+ii, jj);
+            BLASFEO_DVECEL(qp_out->t+ii, jj) = beta * BLASFEO_DVECEL(qp_out->t+ii, jj)
+                                             + alpha * BLASFEO_SVECEL(s_sol->t+ii, jj);
+            if (BLASFEO_DVECEL(qp_out->lam+ii, jj) < 0.0 || BLASFEO_DVECEL(qp_out->t+ii, jj) < 0.0)
+                positive = 0;
+        }
+    }
+
+    return positive;
+}
+
+
+
+static double ocp_qp_hpipm_res_max(double res[4])
+{
+    double res_max = res[0];
+    for (int ii = 1; ii < 4; ii++)
+        res_max = res[ii] > res_max ? res[ii] : res_max;
+    return res_max;
+}
+
+
+
+// iterative refinement in double precision on the solution of the single precision ipm:
+// the last single precision factorization is reused to solve the kkt system with the
+// double precision residuals as right hand side, a step is kept only if it reduces the
+// inf-norm of the residuals
+static void ocp_qp_hpipm_itref_mixed(ocp_qp_in *qp_in, ocp_qp_out *qp_out,
+                                     ocp_qp_hpipm_opts *opts, ocp_qp_hpipm_memory *mem)
+{
+    double res_new[4];
+
+    ocp_qp_res_compute(qp_in, qp_out, mem->res, mem->res_ws);
+    ocp_qp_res_compute_nrm_inf(mem->res, mem->res_single);
+    for (int ii = 0; ii < 4; ii++)
+        mem->res_mixed[ii] = mem->res_single[ii];
+
+    mem->itref_mixed_iter = 0;
+    for (int it = 0; it < opts->itref_mixed; it++)
+    {
+        ocp_qp_hpipm_cvt_res_d2s(mem->res, mem->s_qp);
+        s_ocp_qp_ipm_sens(mem->s_qp, mem->s_qp_step, opts->s_hpipm_opts, mem->s_hpipm_workspace);
+
+        int positive = ocp_qp_hpipm_add_sol_s2d(1.0, mem->s_qp_step, qp_out, 0);
+        if (positive)
+        {
+            ocp_qp_res_compute(qp_in, qp_out, mem->res, mem->res_ws);
+            ocp_qp_res_compute_nrm_inf(mem->res, res_new);
+        }
+
+        if (!positive || ocp_qp_hpipm_res_max(res_new) >= ocp_qp_hpipm_res_max(mem->res_mixed))
+        {
+            // reject step
+            ocp_qp_hpipm_add_sol_s2d(-1.0, mem->s_qp_step, qp_out, 0);
+            break;
+        }
+
+        for (int ii = 0; ii < 4; ii++)
+            mem->res_mixed[ii] = res_new[ii];
+        mem->itref_mixed_iter++;
+    }
+}
+
+
+
 /************************************************
  * functions
  ************************************************/
@@ -266,17 +635,54 @@ int ocp_qp_hpipm(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *
     acados_tic(&qp_timer);
     // print_ocp_qp_in(qp_in);
     int hpipm_status;
-    d_ocp_qp_ipm_solve(qp_in, qp_out, opts->hpipm_opts, mem->hpipm_workspace);
-    d_ocp_qp_ipm_get_status(mem->hpipm_workspace, &hpipm_status);
+    if (opts->mixed_precision)
+    {
+        acados_timer interface_timer;
+        double interface_time = 0;
+
+        acados_tic(&interface_timer);
+        ocp_qp_hpipm_cvt_qp_d2s(qp_in, mem->s_qp);
+        interface_time += acados_toc(&interface_timer);
+
+        acados_tic(&qp_timer);
+        s_ocp_qp_ipm_solve(mem->s_qp, mem->s_qp_sol, opts->s_hpipm_opts, mem->s_hpipm_workspace);
+        s_ocp_qp_ipm_get_status(mem->s_hpipm_workspace, &hpipm_status);
+        info->solve_QP_time = acados_toc(&qp_timer);
+
+        acados_tic(&interface_timer);
+        ocp_qp_hpipm_add_sol_s2d(1.0, mem->s_qp_sol, qp_out, 1);
+        info->t_computed = 1;
+        ocp_qp_hpipm_itref_mixed(qp_in, qp_out, opts, mem);
+        interface_time += acados_toc(&interface_timer);
+
+        // the refined solution satisfies the double precision tolerances
+        if (mem->res_mixed[0] <= opts->hpipm_opts->res_g_max &&
+            mem->res_mixed[1] <= opts->hpipm_opts->res_b_max &&
+            mem->res_mixed[2] <= opts->hpipm_opts->res_d_max &&
+            mem->res_mixed[3] <= opts->hpipm_opts->res_m_max)
+            hpipm_status = 0;
+
+        info->interface_time = interface_time;
+        info->total_time = acados_toc(&tot_timer);
+        info->num_iter = mem->s_hpipm_workspace->iter;
+
+        mem->time_qp_solver_call = info->solve_QP_time;
+        mem->iter = mem->s_hpipm_workspace->iter;
+    }
+    else
+    {
+        d_ocp_qp_ipm_solve(qp_in, qp_out, opts->hpipm_opts, mem->hpipm_workspace);
+        d_ocp_qp_ipm_get_status(mem->hpipm_workspace, &hpipm_status);
 
-    info->solve_QP_time = acados_toc(&qp_timer);
-    info->interface_time = 0;  // there are no conversions for hpipm
-    info->total_time = acados_toc(&tot_timer);
-    info->num_iter = mem->hpipm_workspace->iter;
-    info->t_computed = 1;
+        info->solve_QP_time = acados_toc(&qp_timer);
+        info->interface_time = 0;  // there are no conversions for hpipm
+        info->total_time = acados_toc(&tot_timer);
+        info->num_iter = mem->hpipm_workspace->iter;
+        info->t_computed = 1;
 
-    mem->time_qp_solver_call = info->solve_QP_time;
-    mem->iter = mem->hpipm_workspace->iter;
+        mem->time_qp_solver_call = info->solve_QP_time;
+        mem->iter = mem->hpipm_workspace->iter;
+    }
 
     // check exit conditions
     int acados_status = hpipm_status;
@@ -305,7 +711,18 @@ void ocp_qp_hpipm_eval_sens(void *config_, void *param_qp_in_, void *sens_qp_out
     // solve ipm
 //    acados_tic(&qp_timer);
     // print_ocp_qp_in(param_qp_in);
-    d_ocp_qp_ipm_sens(param_qp_in, sens_qp_out, opts->hpipm_opts, mem->hpipm_workspace);
+    if (opts->mixed_precision)
+    {
+        // the factorization of the last solve is stored in the single precision workspace,
+        // only the vectors of param_qp_in enter the sensitivities
+        ocp_qp_hpipm_cvt_qp_vec_d2s(param_qp_in, mem->s_qp);
+        s_ocp_qp_ipm_sens(mem->s_qp, mem->s_qp_step, opts->s_hpipm_opts, mem->s_hpipm_workspace);
+        ocp_qp_hpipm_add_sol_s2d(1.0, mem->s_qp_step, sens_qp_out, 1);
+    }
+    else
+    {
+        d_ocp_qp_ipm_sens(param_qp_in, sens_qp_out, opts->hpipm_opts, mem->hpipm_workspace);
+    }
 
 //    info->solve_QP_time = acados_toc(&qp_timer);
 //    info->interface_time = 0;  // there are no conversions for hpipm
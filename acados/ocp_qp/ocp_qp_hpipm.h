@@ -41,6 +41,10 @@ extern "C" {
 
 // hpipm
 #include "hpipm/include/hpipm_d_ocp_qp_ipm.h"
+#include "hpipm/include/hpipm_s_ocp_qp.h"
+#include "hpipm/include/hpipm_s_ocp_qp_dim.h"
+#include "hpipm/include/hpipm_s_ocp_qp_ipm.h"
+#include "hpipm/include/hpipm_s_ocp_qp_sol.h"
 // acados
 #include "acados/ocp_qp/ocp_qp_common.h"
 #include "acados/utils/types.h"
@@ -52,6 +56,11 @@ extern "C" {
 typedef struct ocp_qp_hpipm_opts_
 {
     struct d_ocp_qp_ipm_arg *hpipm_opts;
+    // mixed precision: the ipm runs in single precision on a converted copy of the qp,
+    // followed by itref_mixed iterative refinement steps on the double precision residual
+    struct s_ocp_qp_ipm_arg *s_hpipm_opts;
+    int mixed_precision;
+    int itref_mixed;
 } ocp_qp_hpipm_opts;
 
 
@@ -64,6 +73,18 @@ typedef struct ocp_qp_hpipm_memory_
     double time_qp_solver_call;
     int iter;
 
+    // mixed precision (only assigned if opts->mixed_precision)
+    struct s_ocp_qp_dim *s_dims;
+    struct s_ocp_qp *s_qp;
+    struct s_ocp_qp_sol *s_qp_sol;
+    struct s_ocp_qp_sol *s_qp_step;  // iterative refinement correction
+    struct s_ocp_qp_ipm_ws *s_hpipm_workspace;
+    ocp_qp_res *res;
+    ocp_qp_res_ws *res_ws;
+    double res_single[4];  // inf-norm of the residuals after the single precision solve
+    double res_mixed[4];   // inf-norm of the residuals after iterative refinement
+    int itref_mixed_iter;  // accepted iterative refinement steps
+
 } ocp_qp_hpipm_memory;
 
 
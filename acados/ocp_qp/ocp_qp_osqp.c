@@ -332,11 +332,28 @@ static void update_hessian_structure(const ocp_qp_in *in, ocp_qp_osqp_memory *me
 
 
 
+// writes the nonzero nn of a matrix and records it if its value changed
+static void update_matrix_entry(c_int nn, c_float val, c_float *x, c_int *n_changed,
+                                c_int *idx_changed, c_float *x_changed)
+{
+    if (x[nn] != val)
+    {
+        x[nn] = val;
+        idx_changed[*n_changed] = nn;
+        x_changed[*n_changed] = val;
+        (*n_changed)++;
+    }
+}
+
+
+
 static void update_hessian_data(const ocp_qp_in *in, ocp_qp_osqp_memory *mem)
 {
     c_int ii, jj, kk, nn = 0;
     ocp_qp_dims *dims = in->dim;
 
+    mem->P_nnz_changed = 0;
+
     // Traversing the matrix in column-major order
     for (kk = 0; kk <= dims->N; kk++)
     {
@@ -348,7 +365,8 @@ static void update_hessian_data(const ocp_qp_in *in, ocp_qp_osqp_memory *mem)
                 // we write the lower triangular part in row-major order
                 // that's the same as writing the upper triangular part in
                 // column-major order
-                mem->P_x[nn++] = BLASFEO_DMATEL(&in->RSQrq[kk], ii, jj);
+                update_matrix_entry(nn++, BLASFEO_DMATEL(&in->RSQrq[kk], ii, jj), mem->P_x,
+                                    &mem->P_nnz_changed, mem->P_idx_changed, mem->P_x_changed);
             }
         }
     }
@@ -458,6 +476,8 @@ static void update_constraints_matrix_data(const ocp_qp_in *in, ocp_qp_osqp_memo
     c_int ii, jj, kk, nn = 0;
     ocp_qp_dims *dims = in->dim;
 
+    mem->A_nnz_changed = 0;
+
     // Traverse matrix in column-major order
     for (kk = 0; kk <= dims->N; kk++)
     {
@@ -470,14 +490,16 @@ static void update_constraints_matrix_data(const ocp_qp_in *in, ocp_qp_osqp_memo
                 // write column from B
                 for (ii = 0; ii < dims->nx[kk + 1]; ii++)
                 {
-                    mem->A_x[nn++] = BLASFEO_DMATEL(&in->BAbt[kk], jj, ii);
+                    update_matrix_entry(nn++, BLASFEO_DMATEL(&in->BAbt[kk], jj, ii), mem->A_x,
+                                        &mem->A_nnz_changed, mem->A_idx_changed, mem->A_x_changed);
                 }
             }
 
             // write column from D
             for (ii = 0; ii < dims->ng[kk]; ii++)
             {
-                mem->A_x[nn++] = BLASFEO_DMATEL(&in->DCt[kk], jj, ii);
+                update_matrix_entry(nn++, BLASFEO_DMATEL(&in->DCt[kk], jj, ii), mem->A_x,
+                                    &mem->A_nnz_changed, mem->A_idx_changed, mem->A_x_changed);
             }
 
             // write bound on u
@@ -485,7 +507,8 @@ static void update_constraints_matrix_data(const ocp_qp_in *in, ocp_qp_osqp_memo
             {
                 if (in->idxb[kk][ii] == jj)
                 {
-                    mem->A_x[nn++] = 1.0;
+                    update_matrix_entry(nn++, 1.0, mem->A_x,
+                                        &mem->A_nnz_changed, mem->A_idx_changed, mem->A_x_changed);
                     nbu++;
                     break;
                 }
@@ -497,7 +520,8 @@ static void update_constraints_matrix_data(const ocp_qp_in *in, ocp_qp_osqp_memo
             if (kk > 0)
             {
                 // write column from -I
-                mem->A_x[nn++] = -1.0;
+                update_matrix_entry(nn++, -1.0, mem->A_x,
+                                    &mem->A_nnz_changed, mem->A_idx_changed, mem->A_x_changed);
             }
 
             if (kk < dims->N)
@@ -505,14 +529,16 @@ static void update_constraints_matrix_data(const ocp_qp_in *in, ocp_qp_osqp_memo
                 // write column from A
                 for (ii = 0; ii < dims->nx[kk + 1]; ii++)
                 {
-                    mem->A_x[nn++] = BLASFEO_DMATEL(&in->BAbt[kk], jj + dims->nu[kk], ii);
+                    update_matrix_entry(nn++, BLASFEO_DMATEL(&in->BAbt[kk], jj + dims->nu[kk], ii), mem->A_x,
+                                        &mem->A_nnz_changed, mem->A_idx_changed, mem->A_x_changed);
                 }
             }
 
             // write column from C
             for (ii = 0; ii < dims->ng[kk]; ii++)
             {
-                mem->A_x[nn++] = BLASFEO_DMATEL(&in->DCt[kk], jj + dims->nu[kk], ii);
+                update_matrix_entry(nn++, BLASFEO_DMATEL(&in->DCt[kk], jj + dims->nu[kk], ii), mem->A_x,
+                                    &mem->A_nnz_changed, mem->A_idx_changed, mem->A_x_changed);
             }
 
             // write bound on x
@@ -520,7 +546,8 @@ static void update_constraints_matrix_data(const ocp_qp_in *in, ocp_qp_osqp_memo
             {
                 if (in->idxb[kk][ii] == jj + dims->nu[kk])
                 {
-                    mem->A_x[nn++] = 1.0;
+                    update_matrix_entry(nn++, 1.0, mem->A_x,
+                                        &mem->A_nnz_changed, mem->A_idx_changed, mem->A_x_changed);
                 }
             }
         }
@@ -641,6 +668,7 @@ void ocp_qp_osqp_opts_initialize_default(void *config_, void *dims_, void *opts_
     opts->osqp_opts->verbose = 0;
     opts->osqp_opts->polish = 1;
     opts->osqp_opts->check_termination = 5;
+    opts->rho_warm_start = 1;
 
     return;
 }
@@ -681,12 +709,15 @@ void ocp_qp_osqp_opts_set(void *config_, void *opts_, const char *field, void *v
     }
     else if (!strcmp(field, "warm_start"))
     {
-        // XXX after the first call to the solver, this doesn't work any more, as in osqp the settings are copied in the work !!!!!
-        // XXX i.e. as it is, it gets permanently set to zero if warm start is disabled at the fist iteration !!!!!
+        // NOTE: osqp copies the settings into its workspace on the first call,
+        // later changes are passed on with osqp_update_warm_start in ocp_qp_osqp
         int *tmp_ptr = value;
-//        int tmp_ptr[] = {1};
         opts->osqp_opts->warm_start = *tmp_ptr;
-//        printf("\nwarm start %d\n", opts->osqp_opts->warm_start);
+    }
+    else if (!strcmp(field, "rho_warm_start"))
+    {
+        int *tmp_ptr = value;
+        opts->rho_warm_start = *tmp_ptr;
     }
     else
     {
@@ -799,6 +830,11 @@ int ocp_qp_osqp_memory_calculate_size(void *config_, void *dims_, void *opts_)
     size += A_nnzmax * sizeof(c_int);    // A_i
     size += (n + 1) * sizeof(c_int);     // A_p
 
+    size += P_nnzmax * sizeof(c_float);  // P_x_changed
+    size += P_nnzmax * sizeof(c_int);    // P_idx_changed
+    size += A_nnzmax * sizeof(c_float);  // A_x_changed
+    size += A_nnzmax * sizeof(c_int);    // A_idx_changed
+
     size += sizeof(OSQPData);
     size += 2 * sizeof(csc);  // matrices P and A
     size += osqp_workspace_calculate_size(n, m, P_nnzmax, A_nnzmax);
@@ -1129,6 +1165,12 @@ void *ocp_qp_osqp_memory_assign(void *config_, void *dims_, void *opts_, void *r
     mem->A_x = (c_float *) c_ptr;
     c_ptr += (mem->A_nnzmax) * sizeof(c_float);
 
+    mem->P_x_changed = (c_float *) c_ptr;
+    c_ptr += (mem->P_nnzmax) * sizeof(c_float);
+
+    mem->A_x_changed = (c_float *) c_ptr;
+    c_ptr += (mem->A_nnzmax) * sizeof(c_float);
+
     // ints
     mem->P_i = (c_int *) c_ptr;
     c_ptr += (mem->P_nnzmax) * sizeof(c_int);
@@ -1142,6 +1184,15 @@ void *ocp_qp_osqp_memory_assign(void *config_, void *dims_, void *opts_, void *r
     mem->A_p = (c_int *) c_ptr;
     c_ptr += (n + 1) * sizeof(c_int);
 
+    mem->P_idx_changed = (c_int *) c_ptr;
+    c_ptr += (mem->P_nnzmax) * sizeof(c_int);
+
+    mem->A_idx_changed = (c_int *) c_ptr;
+    c_ptr += (mem->A_nnzmax) * sizeof(c_int);
+
+    mem->P_nnz_changed = 0;
+    mem->A_nnz_changed = 0;
+
     mem->osqp_data = (OSQPData *) c_ptr;
     c_ptr += sizeof(OSQPData);
 
@@ -1190,6 +1241,16 @@ void ocp_qp_osqp_memory_get(void *config_, void *mem_, const char *field, void*
         int *tmp_ptr = value;
         *tmp_ptr = mem->iter;
     }
+    else if(!strcmp(field, "P_nnz_changed"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->P_nnz_changed;
+    }
+    else if(!strcmp(field, "A_nnz_changed"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->A_nnz_changed;
+    }
     else
     {
         printf("\nerror: ocp_qp_osqp_memory_get: field %s not available\n", field);
@@ -1312,10 +1373,23 @@ int ocp_qp_osqp(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *m
     // update osqp workspace with new data
     if (!mem->first_run)
     {
-        osqp_update_lin_cost(mem->osqp_work, mem->q);
-        osqp_update_P_A(mem->osqp_work, mem->P_x, NULL, mem->P_nnzmax, mem->A_x, NULL,
-                        mem->A_nnzmax);
-        osqp_update_bounds(mem->osqp_work, mem->l, mem->u);
+        OSQPWorkspace *work = mem->osqp_work;
+
+        osqp_update_lin_cost(work, mem->q);
+        osqp_update_bounds(work, mem->l, mem->u);
+
+        osqp_update_warm_start(work, opts->osqp_opts->warm_start);
+        if (!opts->rho_warm_start && work->settings->rho != opts->osqp_opts->rho)
+            osqp_update_rho(work, opts->osqp_opts->rho);
+
+        // pass only the changed nonzeros, if none changed the KKT factorization is reused
+        if (mem->P_nnz_changed > 0 && mem->A_nnz_changed > 0)
+            osqp_update_P_A(work, mem->P_x_changed, mem->P_idx_changed, mem->P_nnz_changed,
+                            mem->A_x_changed, mem->A_idx_changed, mem->A_nnz_changed);
+        else if (mem->P_nnz_changed > 0)
+            osqp_update_P(work, mem->P_x_changed, mem->P_idx_changed, mem->P_nnz_changed);
+        else if (mem->A_nnz_changed > 0)
+            osqp_update_A(work, mem->A_x_changed, mem->A_idx_changed, mem->A_nnz_changed);
     }
     else
     {
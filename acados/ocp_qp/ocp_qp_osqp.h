@@ -49,6 +49,7 @@ extern "C" {
 typedef struct ocp_qp_osqp_opts_
 {
     OSQPSettings *osqp_opts;
+    int rho_warm_start;  // keep the rho adapted in the previous call, otherwise reset it to osqp_opts->rho
 } ocp_qp_osqp_opts;
 
 
@@ -70,6 +71,14 @@ typedef struct ocp_qp_osqp_memory_
     c_int *A_p;
     c_float *A_x;
 
+    // nonzeros that changed since the last call
+    c_int P_nnz_changed;
+    c_int *P_idx_changed;
+    c_float *P_x_changed;
+    c_int A_nnz_changed;
+    c_int *A_idx_changed;
+    c_float *A_x_changed;
+
     OSQPData *osqp_data;
     OSQPWorkspace *osqp_work;
 
@@ -190,6 +190,9 @@ int ocp_qp_partial_condensing_opts_calculate_size(void *dims_)
     size += sizeof(struct d_ocp_qp_reduce_eq_dof_arg);
     size += d_ocp_qp_reduce_eq_dof_arg_memsize();
 
+    // block_size
+    size += (N + 1) * sizeof(int);
+
     size += 2*8;
     make_int_multiple_of(8, &size);
 
@@ -228,6 +231,9 @@ void *ocp_qp_partial_condensing_opts_assign(void *dims_, void *raw_memory)
     d_ocp_qp_reduce_eq_dof_arg_create(opts->hpipm_red_opts, c_ptr);
     c_ptr += opts->hpipm_red_opts->memsize;
 
+    // block_size
+    assign_and_advance_int(N + 1, &opts->block_size, &c_ptr);
+
     assert((char *) raw_memory + ocp_qp_partial_condensing_opts_calculate_size(dims) >= c_ptr);
 
     return opts;
@@ -244,6 +250,7 @@ void ocp_qp_partial_condensing_opts_initialize_default(void *dims_, void *opts_)
 
     opts->N2 = N;  // no partial condensing by default
     opts->N2_bkp = opts->N2;
+    opts->set_block_size = 0;  // equal blocks by default
 
     dims->pcond_dims->N = opts->N2;
     opts->hpipm_pcond_opts->N2 = opts->N2;
@@ -285,8 +292,20 @@ void ocp_qp_partial_condensing_opts_set(void *opts_, const char *field, void* va
     if(!strcmp(field, "N"))
     {
         int *tmp_ptr = value;
+        // user-defined block sizes only hold for the horizon they were set for
+        if (*tmp_ptr != opts->N2)
+            opts->set_block_size = 0;
         opts->N2 = *tmp_ptr;
     }
+    else if(!strcmp(field, "block_size"))
+    {
+        // number of stages in each of the N2 blocks, N has to be set before
+        int *tmp_ptr = value;
+        for (int ii = 0; ii < opts->N2; ii++)
+            opts->block_size[ii] = tmp_ptr[ii];
+        opts->block_size[opts->N2] = 0;
+        opts->set_block_size = 1;
+    }
     else if(!strcmp(field, "N_bkp"))
     {
         int *tmp_ptr = value;
@@ -310,6 +329,34 @@ void ocp_qp_partial_condensing_opts_set(void *opts_, const char *field, void* va
 
 
 
+void ocp_qp_partial_condensing_opts_copy(void *dims_, void *opts_src_, void *opts_dst_)
+{
+    ocp_qp_partial_condensing_dims *dims = dims_;
+    ocp_qp_partial_condensing_opts *opts_src = opts_src_;
+    ocp_qp_partial_condensing_opts *opts_dst = opts_dst_;
+
+    opts_dst->N2 = opts_src->N2;
+    opts_dst->N2_bkp = opts_src->N2_bkp;
+    for (int ii = 0; ii <= opts_src->N2; ii++)
+        opts_dst->block_size[ii] = opts_src->block_size[ii];
+    opts_dst->set_block_size = opts_src->set_block_size;
+    opts_dst->ric_alg = opts_src->ric_alg;
+    opts_dst->mem_qp_in = opts_src->mem_qp_in;
+
+    // hpipm_pcond_opts
+    dims->pcond_dims->N = opts_dst->N2;
+    opts_dst->hpipm_pcond_opts->N2 = opts_dst->N2;
+    d_part_cond_qp_arg_set_default(opts_dst->hpipm_pcond_opts);
+    d_part_cond_qp_arg_set_ric_alg(opts_dst->ric_alg, opts_dst->hpipm_pcond_opts);
+    // hpipm_red_opts
+    d_ocp_qp_reduce_eq_dof_arg_set_default(opts_dst->hpipm_red_opts);
+    d_ocp_qp_reduce_eq_dof_arg_set_alias_unchanged(opts_dst->hpipm_red_opts, 1);
+
+    return;
+}
+
+
+
 /************************************************
  * memory
  ************************************************/
@@ -324,8 +371,31 @@ int ocp_qp_partial_condensing_memory_calculate_size(void *dims_, void *opts_)
 
     // populate dimensions of new ocp_qp based on actual N2
     dims->pcond_dims->N = opts->N2;
-    // TODO(all): user-defined block size
-    d_part_cond_qp_compute_block_size(dims->red_dims->N, opts->N2, dims->block_size);
+    if (opts->set_block_size)
+    {
+        int N = 0;
+        for (int ii = 0; ii <= opts->N2; ii++)
+        {
+            if (ii < opts->N2 && opts->block_size[ii] < 1)
+            {
+                printf("\nerror: ocp_qp_partial_condensing: block_size[%d] = %d, must be positive\n",
+                       ii, opts->block_size[ii]);
+                exit(1);
+            }
+            dims->block_size[ii] = opts->block_size[ii];
+            N += opts->block_size[ii];
+        }
+        if (N != dims->red_dims->N)
+        {
+            printf("\nerror: ocp_qp_partial_condensing: block sizes sum up to %d, expected N = %d\n",
+                   N, dims->red_dims->N);
+            exit(1);
+        }
+    }
+    else
+    {
+        d_part_cond_qp_compute_block_size(dims->red_dims->N, opts->N2, dims->block_size);
+    }
     d_part_cond_qp_compute_dim(dims->red_dims, dims->block_size, dims->pcond_dims);
 
     int size = 0;
@@ -571,6 +641,7 @@ void ocp_qp_partial_condensing_config_initialize_default(void *config_)
     config->opts_initialize_default = &ocp_qp_partial_condensing_opts_initialize_default;
     config->opts_update = &ocp_qp_partial_condensing_opts_update;
     config->opts_set = &ocp_qp_partial_condensing_opts_set;
+    config->opts_copy = &ocp_qp_partial_condensing_opts_copy;
     config->memory_calculate_size = &ocp_qp_partial_condensing_memory_calculate_size;
     config->memory_assign = &ocp_qp_partial_condensing_memory_assign;
     config->memory_get = &ocp_qp_partial_condensing_memory_get;
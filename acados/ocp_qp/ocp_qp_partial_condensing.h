@@ -66,6 +66,8 @@ typedef struct ocp_qp_partial_condensing_opts_
 //    int *block_size;
     int N2;
     int N2_bkp;
+    int *block_size;      // user-defined number of stages per block, N2 entries
+    int set_block_size;   // use block_size instead of equal blocks
 //    int expand_dual_sol; // 0 primal sol only, 1 primal + dual sol
     int ric_alg;
     int mem_qp_in; // allocate qp_in in memory
@@ -102,6 +104,8 @@ void ocp_qp_partial_condensing_opts_update(void *dims, void *opts_);
 //
 void ocp_qp_partial_condensing_opts_set(void *opts_, const char *field, void* value);
 //
+void ocp_qp_partial_condensing_opts_copy(void *dims, void *opts_src, void *opts_dst);
+//
 int ocp_qp_partial_condensing_memory_calculate_size(void *dims, void *opts_);
 //
 void *ocp_qp_partial_condensing_memory_assign(void *dims, void *opts, void *raw_memory);
@@ -0,0 +1,832 @@
+/*
+ * Copyright 2019 Gianluca Frison, Dimitris Kouzoupis, Robin Verschueren,
+ * Andrea Zanelli, Niels van Duijkeren, Jonathan Frey, Tommaso Sartor,
+ * Branimir Novoselnik, Rien Quirynen, Rezart Qelibari, Dang Doan,
+ * Jonas Koenemann, Yutao Chen, Tobias Schöls, Jonas Schlagenhauf, Moritz Diehl
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+// external
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// blasfeo
+#include "blasfeo/include/blasfeo_d_aux.h"
+#include "blasfeo/include/blasfeo_d_blas.h"
+
+// acados
+#include "acados/ocp_qp/ocp_qp_common.h"
+#include "acados/ocp_qp/ocp_qp_pdas.h"
+#include "acados/utils/mem.h"
+#include "acados/utils/timing.h"
+#include "acados/utils/types.h"
+
+
+
+// state of a constraint in the active set
+#define PDAS_INACTIVE 0
+#define PDAS_LOWER 1
+#define PDAS_UPPER 2
+#define PDAS_EQUAL 3
+
+
+
+/************************************************
+ * opts
+ ************************************************/
+
+int ocp_qp_pdas_opts_calculate_size(void *config_, void *dims_)
+{
+    int size = 0;
+    size += sizeof(ocp_qp_pdas_opts);
+
+    return size;
+}
+
+
+
+void *ocp_qp_pdas_opts_assign(void *config_, void *dims_, void *raw_memory)
+{
+    char *c_ptr = (char *) raw_memory;
+
+    ocp_qp_pdas_opts *opts = (ocp_qp_pdas_opts *) c_ptr;
+    c_ptr += sizeof(ocp_qp_pdas_opts);
+
+    assert((char *) raw_memory + ocp_qp_pdas_opts_calculate_size(config_, dims_) == c_ptr);
+
+    return (void *) opts;
+}
+
+
+
+void ocp_qp_pdas_opts_initialize_default(void *config_, void *dims_, void *opts_)
+{
+    ocp_qp_pdas_opts *opts = opts_;
+
+    opts->rho = 1e6;
+    opts->tol_eq = 1e-10;
+    opts->tol_ineq = 1e-10;
+    opts->reg_prim = 1e-12;
+    opts->iter_max = 50;
+    opts->ref_iter_max = 10;
+    opts->warm_start = 0;
+
+    return;
+}
+
+
+
+void ocp_qp_pdas_opts_update(void *config_, void *dims_, void *opts_)
+{
+    return;
+}
+
+
+
+void ocp_qp_pdas_opts_set(void *config_, void *opts_, const char *field, void *value)
+{
+    ocp_qp_pdas_opts *opts = opts_;
+
+    if (!strcmp(field, "iter_max"))
+    {
+        int *tmp_ptr = value;
+        opts->iter_max = *tmp_ptr;
+    }
+    else if (!strcmp(field, "ref_iter_max"))
+    {
+        int *tmp_ptr = value;
+        opts->ref_iter_max = *tmp_ptr;
+    }
+    else if (!strcmp(field, "warm_start"))
+    {
+        int *tmp_ptr = value;
+        opts->warm_start = *tmp_ptr;
+    }
+    else if (!strcmp(field, "rho"))
+    {
+        double *tmp_ptr = value;
+        opts->rho = *tmp_ptr;
+    }
+    else if (!strcmp(field, "reg_prim"))
+    {
+        double *tmp_ptr = value;
+        opts->reg_prim = *tmp_ptr;
+    }
+    else if (!strcmp(field, "tol_eq"))
+    {
+        double *tmp_ptr = value;
+        opts->tol_eq = *tmp_ptr;
+    }
+    else if (!strcmp(field, "tol_ineq"))
+    {
+        double *tmp_ptr = value;
+        opts->tol_ineq = *tmp_ptr;
+    }
+    else if (!strcmp(field, "tol_stat") || !strcmp(field, "tol_comp"))
+    {
+        // stationarity and complementarity hold by construction at a fixed point of the active set
+    }
+    else
+    {
+        printf("\nerror: ocp_qp_pdas_opts_set: wrong field: %s\n", field);
+        exit(1);
+    }
+
+    return;
+}
+
+
+
+/************************************************
+ * memory
+ ************************************************/
+
+int ocp_qp_pdas_memory_calculate_size(void *config_, void *dims_, void *opts_)
+{
+    ocp_qp_dims *dims = dims_;
+
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *nb = dims->nb;
+    int *ng = dims->ng;
+
+    int size = 0;
+    size += sizeof(ocp_qp_pdas_memory);
+
+    size += (N + 1) * sizeof(struct blasfeo_dmat);  // L
+    size += (N + 1) * sizeof(struct blasfeo_dvec);  // l
+    size += (N + 1) * sizeof(int *);  // act
+    size += 2 * (N + 1) * sizeof(double *);  // mu, mu_sens
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        size += blasfeo_memsize_dmat(nu[ii] + nx[ii], nu[ii] + nx[ii]);  // L
+        size += blasfeo_memsize_dvec(nu[ii] + nx[ii]);  // l
+        size += (nb[ii] + ng[ii]) * sizeof(int);  // act
+        size += 2 * (nb[ii] + ng[ii]) * sizeof(double);  // mu, mu_sens
+    }
+
+    size += 2 * 64;  // align
+
+    return size;
+}
+
+
+
+void *ocp_qp_pdas_memory_assign(void *config_, void *dims_, void *opts_, void *raw_memory)
+{
+    ocp_qp_dims *dims = dims_;
+
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *nb = dims->nb;
+    int *ng = dims->ng;
+
+    char *c_ptr = (char *) raw_memory;
+
+    ocp_qp_pdas_memory *mem = (ocp_qp_pdas_memory *) c_ptr;
+    c_ptr += sizeof(ocp_qp_pdas_memory);
+
+    assign_and_advance_blasfeo_dmat_structs(N + 1, &mem->L, &c_ptr);
+    assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->l, &c_ptr);
+    assign_and_advance_int_ptrs(N + 1, &mem->act, &c_ptr);
+    assign_and_advance_double_ptrs(N + 1, &mem->mu, &c_ptr);
+    assign_and_advance_double_ptrs(N + 1, &mem->mu_sens, &c_ptr);
+
+    align_char_to(64, &c_ptr);
+
+    for (int ii = 0; ii <= N; ii++)
+        assign_and_advance_blasfeo_dmat_mem(nu[ii] + nx[ii], nu[ii] + nx[ii], mem->L + ii, &c_ptr);
+
+    for (int ii = 0; ii <= N; ii++)
+        assign_and_advance_blasfeo_dvec_mem(nu[ii] + nx[ii], mem->l + ii, &c_ptr);
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        assign_and_advance_double(nb[ii] + ng[ii], &mem->mu[ii], &c_ptr);
+        assign_and_advance_double(nb[ii] + ng[ii], &mem->mu_sens[ii], &c_ptr);
+    }
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        assign_and_advance_int(nb[ii] + ng[ii], &mem->act[ii], &c_ptr);
+        for (int jj = 0; jj < nb[ii] + ng[ii]; jj++)
+        {
+            mem->act[ii][jj] = PDAS_INACTIVE;
+            mem->mu[ii][jj] = 0.0;
+        }
+    }
+
+    mem->time_qp_solver_call = 0.0;
+    mem->iter = 0;
+    mem->ref_iter = 0;
+    mem->num_active = 0;
+    mem->res_eq = 0.0;
+
+    assert((char *) raw_memory + ocp_qp_pdas_memory_calculate_size(config_, dims_, opts_) >= c_ptr);
+
+    return mem;
+}
+
+
+
+void ocp_qp_pdas_memory_get(void *config_, void *mem_, const char *field, void* value)
+{
+    ocp_qp_pdas_memory *mem = mem_;
+
+    if (!strcmp(field, "time_qp_solver_call"))
+    {
+        double *tmp_ptr = value;
+        *tmp_ptr = mem->time_qp_solver_call;
+    }
+    else if (!strcmp(field, "iter"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->iter;
+    }
+    else if (!strcmp(field, "ref_iter"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->ref_iter;
+    }
+    else if (!strcmp(field, "num_active"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->num_active;
+    }
+    else if (!strcmp(field, "res_eq"))
+    {
+        double *tmp_ptr = value;
+        *tmp_ptr = mem->res_eq;
+    }
+    else
+    {
+        printf("\nerror: ocp_qp_pdas_memory_get: field %s not available\n", field);
+        exit(1);
+    }
+
+    return;
+}
+
+
+
+/************************************************
+ * workspace
+ ************************************************/
+
+int ocp_qp_pdas_workspace_calculate_size(void *config_, void *dims_, void *opts_)
+{
+    ocp_qp_dims *dims = dims_;
+
+    int nv_max = 0, nx_max = 0;
+    for (int ii = 0; ii <= dims->N; ii++)
+    {
+        int nv = dims->nu[ii] + dims->nx[ii];
+        nv_max = nv > nv_max ? nv : nv_max;
+        nx_max = dims->nx[ii] > nx_max ? dims->nx[ii] : nx_max;
+    }
+
+    int size = sizeof(ocp_qp_pdas_workspace);
+
+    size += blasfeo_memsize_dmat(nv_max, nv_max);  // M
+    size += blasfeo_memsize_dmat(nv_max, nx_max);  // AL
+    size += 3 * blasfeo_memsize_dvec(nv_max);  // g, tmp0, tmp1
+
+    size += 64;  // align
+
+    return size;
+}
+
+
+
+static void cast_workspace(ocp_qp_dims *dims, ocp_qp_pdas_workspace *work)
+{
+    int nv_max = 0, nx_max = 0;
+    for (int ii = 0; ii <= dims->N; ii++)
+    {
+        int nv = dims->nu[ii] + dims->nx[ii];
+        nv_max = nv > nv_max ? nv : nv_max;
+        nx_max = dims->nx[ii] > nx_max ? dims->nx[ii] : nx_max;
+    }
+
+    char *c_ptr = (char *) work;
+    c_ptr += sizeof(ocp_qp_pdas_workspace);
+
+    align_char_to(64, &c_ptr);
+
+    assign_and_advance_blasfeo_dmat_mem(nv_max, nv_max, &work->M, &c_ptr);
+    assign_and_advance_blasfeo_dmat_mem(nv_max, nx_max, &work->AL, &c_ptr);
+    assign_and_advance_blasfeo_dvec_mem(nv_max, &work->g, &c_ptr);
+    assign_and_advance_blasfeo_dvec_mem(nv_max, &work->tmp0, &c_ptr);
+    assign_and_advance_blasfeo_dvec_mem(nv_max, &work->tmp1, &c_ptr);
+
+    assert((char *) work + ocp_qp_pdas_workspace_calculate_size(NULL, dims, NULL) >= c_ptr);
+}
+
+
+
+/************************************************
+ * helper functions
+ ************************************************/
+
+// bounds of constraint jj of stage ii, infinite if masked out
+static void ocp_qp_pdas_bounds(ocp_qp_in *qp_in, int ii, int jj, double *lo, double *up)
+{
+    int nb = qp_in->dim->nb[ii];
+    int ng = qp_in->dim->ng[ii];
+    struct blasfeo_dvec *d = qp_in->d+ii;
+    struct blasfeo_dvec *d_mask = qp_in->d_mask+ii;
+
+    // NOTE: the upper bounds are stored with flipped sign in d
+    *lo = BLASFEO_DVECEL(d_mask, jj) != 0.0 ? BLASFEO_DVECEL(d, jj) : ACADOS_NEG_INFTY;
+    *up = BLASFEO_DVECEL(d_mask, nb+ng+jj) != 0.0 ? -BLASFEO_DVECEL(d, nb+ng+jj) : ACADOS_POS_INFTY;
+}
+
+
+
+// value of constraint jj of stage ii at ux
+static double ocp_qp_pdas_constr(ocp_qp_in *qp_in, int ii, int jj, struct blasfeo_dvec *ux)
+{
+    int nb = qp_in->dim->nb[ii];
+    int nv = qp_in->dim->nu[ii] + qp_in->dim->nx[ii];
+
+    if (jj < nb)
+        return BLASFEO_DVECEL(ux, qp_in->idxb[ii][jj]);
+
+    double tmp = 0.0;
+    for (int kk = 0; kk < nv; kk++)
+        tmp += BLASFEO_DMATEL(qp_in->DCt+ii, kk, jj-nb) * BLASFEO_DVECEL(ux, kk);
+
+    return tmp;
+}
+
+
+
+// value the active constraint jj of stage ii is fixed to
+static double ocp_qp_pdas_active_bound(ocp_qp_in *qp_in, int ii, int jj, int act)
+{
+    double lo, up;
+    ocp_qp_pdas_bounds(qp_in, ii, jj, &lo, &up);
+
+    return act == PDAS_UPPER ? up : lo;
+}
+
+
+
+// Riccati factorization of the qp with the active constraints in the Hessian
+static void ocp_qp_pdas_factorize(ocp_qp_in *qp_in, ocp_qp_pdas_opts *opts,
+                                  ocp_qp_pdas_memory *mem, ocp_qp_pdas_workspace *work)
+{
+    int N = qp_in->dim->N;
+    int *nx = qp_in->dim->nx;
+    int *nu = qp_in->dim->nu;
+    int *nb = qp_in->dim->nb;
+    int *ng = qp_in->dim->ng;
+
+    struct blasfeo_dmat *M = &work->M;
+    struct blasfeo_dmat *AL = &work->AL;
+    double rho = opts->rho;
+
+    for (int ii = N; ii >= 0; ii--)
+    {
+        int nv = nu[ii] + nx[ii];
+
+        blasfeo_dtrcp_l(nv, qp_in->RSQrq+ii, 0, 0, M, 0, 0);
+        for (int kk = 0; kk < nv; kk++)
+            BLASFEO_DMATEL(M, kk, kk) += opts->reg_prim;
+
+        // rho * C' * C of the active constraints
+        for (int jj = 0; jj < nb[ii]; jj++)
+        {
+            if (mem->act[ii][jj] != PDAS_INACTIVE)
+            {
+                int idx = qp_in->idxb[ii][jj];
+                BLASFEO_DMATEL(M, idx, idx) += rho;
+            }
+        }
+        for (int jj = 0; jj < ng[ii]; jj++)
+        {
+            if (mem->act[ii][nb[ii]+jj] == PDAS_INACTIVE)
+                continue;
+            struct blasfeo_dmat *DCt = qp_in->DCt+ii;
+            for (int kk = 0; kk < nv; kk++)
+            {
+                double tmp = rho * BLASFEO_DMATEL(DCt, kk, jj);
+                if (tmp == 0.0)
+                    continue;
+                for (int ll = kk; ll < nv; ll++)
+                    BLASFEO_DMATEL(M, ll, kk) += tmp * BLASFEO_DMATEL(DCt, ll, jj);
+            }
+        }
+
+        if (ii < N)
+        {
+            // [B; A] * P * [B; A]', with P = Lxx * Lxx' of the next stage
+            blasfeo_dtrmm_rlnn(nv, nx[ii+1], 1.0, mem->L+ii+1, nu[ii+1], nu[ii+1], qp_in->BAbt+ii,
+                               0, 0, AL, 0, 0);
+            blasfeo_dsyrk_ln(nv, nx[ii+1], 1.0, AL, 0, 0, AL, 0, 0, 1.0, M, 0, 0, mem->L+ii, 0, 0);
+        }
+        else
+        {
+            blasfeo_dtrcp_l(nv, M, 0, 0, mem->L+ii, 0, 0);
+        }
+
+        blasfeo_dpotrf_l(nv, mem->L+ii, 0, 0, mem->L+ii, 0, 0);
+    }
+}
+
+
+
+// solve the qp with the active constraints in the Hessian, given the factorization and the
+// multiplier estimates mu of the active constraints; returns the multipliers in mu and the max
+// violation of the active constraints
+static double ocp_qp_pdas_solve(ocp_qp_in *qp_in, ocp_qp_out *qp_out, ocp_qp_pdas_opts *opts,
+                                ocp_qp_pdas_memory *mem, ocp_qp_pdas_workspace *work, double **mu)
+{
+    int N = qp_in->dim->N;
+    int *nx = qp_in->dim->nx;
+    int *nu = qp_in->dim->nu;
+    int *nb = qp_in->dim->nb;
+    int *ng = qp_in->dim->ng;
+
+    struct blasfeo_dvec *g = &work->g;
+    struct blasfeo_dvec *tmp0 = &work->tmp0;
+    struct blasfeo_dvec *tmp1 = &work->tmp1;
+    double rho = opts->rho;
+
+    // backward recursion of the gradient
+    for (int ii = N; ii >= 0; ii--)
+    {
+        int nv = nu[ii] + nx[ii];
+
+        blasfeo_dveccp(nv, qp_in->rqz+ii, 0, g, 0);
+
+        // C' * (mu - rho * bound) of the active constraints
+        for (int jj = 0; jj < nb[ii] + ng[ii]; jj++)
+        {
+            int act = mem->act[ii][jj];
+            if (act == PDAS_INACTIVE)
+                continue;
+            double tmp = mu[ii][jj] - rho * ocp_qp_pdas_active_bound(qp_in, ii, jj, act);
+            if (jj < nb[ii])
+                BLASFEO_DVECEL(g, qp_in->idxb[ii][jj]) += tmp;
+            else
+                for (int kk = 0; kk < nv; kk++)
+                    BLASFEO_DVECEL(g, kk) += tmp * BLASFEO_DMATEL(qp_in->DCt+ii, kk, jj-nb[ii]);
+        }
+
+        if (ii < N)
+        {
+            // [B; A] * (P * b + p), with P = Lxx * Lxx' and p = Lxx * lx of the next stage
+            int nu1 = nu[ii+1];
+            int nx1 = nx[ii+1];
+            blasfeo_dtrmv_ltn(nx1, mem->L+ii+1, nu1, nu1, qp_in->b+ii, 0, tmp0, 0);
+            blasfeo_daxpy(nx1, 1.0, mem->l+ii+1, nu1, tmp0, 0, tmp0, 0);
+            blasfeo_dtrmv_lnn(nx1, mem->L+ii+1, nu1, nu1, tmp0, 0, tmp1, 0);
+            blasfeo_dgemv_n(nv, nx1, 1.0, qp_in->BAbt+ii, 0, 0, tmp1, 0, 1.0, g, 0, g, 0);
+        }
+
+        blasfeo_dtrsv_lnn(nv, mem->L+ii, 0, 0, g, 0, mem->l+ii, 0);
+    }
+
+    // forward recursion
+    int nv0 = nu[0] + nx[0];
+    blasfeo_dtrsv_ltn(nv0, mem->L, 0, 0, mem->l, 0, qp_out->ux, 0);
+    blasfeo_dvecsc(nv0, -1.0, qp_out->ux, 0);
+
+    for (int ii = 0; ii < N; ii++)
+    {
+        int nv = nu[ii] + nx[ii];
+        int nu1 = nu[ii+1];
+        int nx1 = nx[ii+1];
+
+        // x_{k+1} = [B; A]' * ux_k + b
+        blasfeo_dgemv_t(nv, nx1, 1.0, qp_in->BAbt+ii, 0, 0, qp_out->ux+ii, 0, 1.0, qp_in->b+ii, 0,
+                        qp_out->ux+ii+1, nu1);
+
+        // pi_k = P * x_{k+1} + p
+        blasfeo_dtrmv_ltn(nx1, mem->L+ii+1, nu1, nu1, qp_out->ux+ii+1, nu1, tmp0, 0);
+        blasfeo_daxpy(nx1, 1.0, mem->l+ii+1, nu1, tmp0, 0, tmp0, 0);
+        blasfeo_dtrmv_lnn(nx1, mem->L+ii+1, nu1, nu1, tmp0, 0, qp_out->pi+ii, 0);
+
+        // u_{k+1} = - Luu^-T * (lu + Lxu' * x_{k+1})
+        blasfeo_dgemv_t(nx1, nu1, 1.0, mem->L+ii+1, nu1, 0, qp_out->ux+ii+1, nu1, 1.0, mem->l+ii+1, 0,
+                        tmp0, 0);
+        blasfeo_dtrsv_ltn(nu1, mem->L+ii+1, 0, 0, tmp0, 0, qp_out->ux+ii+1, 0);
+        blasfeo_dvecsc(nu1, -1.0, qp_out->ux+ii+1, 0);
+    }
+
+    // multipliers of the active constraints
+    double res_max = 0.0;
+    for (int ii = 0; ii <= N; ii++)
+    {
+        for (int jj = 0; jj < nb[ii] + ng[ii]; jj++)
+        {
+            int act = mem->act[ii][jj];
+            if (act == PDAS_INACTIVE)
+                continue;
+            double res = ocp_qp_pdas_constr(qp_in, ii, jj, qp_out->ux+ii) -
+                         ocp_qp_pdas_active_bound(qp_in, ii, jj, act);
+            mu[ii][jj] += rho * res;
+            res_max = fabs(res) > res_max ? fabs(res) : res_max;
+        }
+    }
+
+    return res_max;
+}
+
+
+
+// solve the equality constrained qp of the current active set,
+// returns the max violation of the active constraints
+static double ocp_qp_pdas_solve_active_set(ocp_qp_in *qp_in, ocp_qp_out *qp_out,
+                                           ocp_qp_pdas_opts *opts, ocp_qp_pdas_memory *mem,
+                                           ocp_qp_pdas_workspace *work, double **mu)
+{
+    mem->ref_iter = 0;
+    double res_max = ocp_qp_pdas_solve(qp_in, qp_out, opts, mem, work, mu);
+    while (res_max > opts->tol_eq && mem->ref_iter < opts->ref_iter_max)
+    {
+        res_max = ocp_qp_pdas_solve(qp_in, qp_out, opts, mem, work, mu);
+        mem->ref_iter++;
+    }
+
+    return res_max;
+}
+
+
+
+// lam = [lb lg ub ug] from the multipliers of the active constraints
+static void ocp_qp_pdas_fill_lam(ocp_qp_in *qp_in, ocp_qp_out *qp_out, ocp_qp_pdas_memory *mem,
+                                 double **mu)
+{
+    int N = qp_in->dim->N;
+    int *nb = qp_in->dim->nb;
+    int *ng = qp_in->dim->ng;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        blasfeo_dvecse(2*nb[ii]+2*ng[ii], 0.0, qp_out->lam+ii, 0);
+        for (int jj = 0; jj < nb[ii] + ng[ii]; jj++)
+        {
+            int act = mem->act[ii][jj];
+            if (act == PDAS_INACTIVE)
+                continue;
+            if ((act == PDAS_LOWER || act == PDAS_EQUAL) && mu[ii][jj] < 0.0)
+                BLASFEO_DVECEL(qp_out->lam+ii, jj) = -mu[ii][jj];
+            if ((act == PDAS_UPPER || act == PDAS_EQUAL) && mu[ii][jj] > 0.0)
+                BLASFEO_DVECEL(qp_out->lam+ii, nb[ii]+ng[ii]+jj) = mu[ii][jj];
+        }
+    }
+}
+
+
+
+// initial active set: equality constraints, and the constraints with positive multipliers in qp_out
+static void ocp_qp_pdas_init_active_set(ocp_qp_in *qp_in, ocp_qp_out *qp_out,
+                                        ocp_qp_pdas_opts *opts, ocp_qp_pdas_memory *mem)
+{
+    int N = qp_in->dim->N;
+    int *nb = qp_in->dim->nb;
+    int *ng = qp_in->dim->ng;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        for (int jj = 0; jj < nb[ii] + ng[ii]; jj++)
+        {
+            double lo, up;
+            ocp_qp_pdas_bounds(qp_in, ii, jj, &lo, &up);
+
+            int act = PDAS_INACTIVE;
+            double mu = 0.0;
+            if (lo > ACADOS_NEG_INFTY && up < ACADOS_POS_INFTY && up - lo <= 0.0)
+            {
+                act = PDAS_EQUAL;
+            }
+            if (opts->warm_start)
+            {
+                double lam_lo = BLASFEO_DVECEL(qp_out->lam+ii, jj);
+                double lam_up = BLASFEO_DVECEL(qp_out->lam+ii, nb[ii]+ng[ii]+jj);
+                if (act == PDAS_INACTIVE && lam_lo > 0.0 && lam_lo >= lam_up && lo > ACADOS_NEG_INFTY)
+                    act = PDAS_LOWER;
+                else if (act == PDAS_INACTIVE && lam_up > 0.0 && up < ACADOS_POS_INFTY)
+                    act = PDAS_UPPER;
+                if (act != PDAS_INACTIVE)
+                    mu = lam_up - lam_lo;
+            }
+            mem->act[ii][jj] = act;
+            mem->mu[ii][jj] = mu;
+        }
+    }
+}
+
+
+
+// primal-dual active set update, returns the number of changed constraints
+static int ocp_qp_pdas_update_active_set(ocp_qp_in *qp_in, ocp_qp_out *qp_out,
+                                         ocp_qp_pdas_opts *opts, ocp_qp_pdas_memory *mem)
+{
+    int N = qp_in->dim->N;
+    int *nb = qp_in->dim->nb;
+    int *ng = qp_in->dim->ng;
+
+    double tol = opts->tol_ineq;
+    int num_change = 0;
+    mem->num_active = 0;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        for (int jj = 0; jj < nb[ii] + ng[ii]; jj++)
+        {
+            int act = mem->act[ii][jj];
+            if (act == PDAS_EQUAL)
+            {
+                mem->num_active++;
+                continue;
+            }
+
+            double lo, up;
+            ocp_qp_pdas_bounds(qp_in, ii, jj, &lo, &up);
+            double v = ocp_qp_pdas_constr(qp_in, ii, jj, qp_out->ux+ii);
+            double mu = mem->mu[ii][jj];
+
+            // lam + (violation) > 0, with hysteresis in favor of the current state
+            double lam_lo = act == PDAS_LOWER ? -mu : 0.0;
+            double lam_up = act == PDAS_UPPER ? mu : 0.0;
+            double ind_lo = lo > ACADOS_NEG_INFTY ? lam_lo + lo - v : -1.0;
+            double ind_up = up < ACADOS_POS_INFTY ? lam_up + v - up : -1.0;
+            double thr_lo = act == PDAS_LOWER ? -tol : tol;
+            double thr_up = act == PDAS_UPPER ? -tol : tol;
+
+            int act_new = PDAS_INACTIVE;
+            if (ind_lo > thr_lo && (ind_up <= thr_up || ind_lo - thr_lo >= ind_up - thr_up))
+                act_new = PDAS_LOWER;
+            else if (ind_up > thr_up)
+                act_new = PDAS_UPPER;
+
+            if (act_new != act)
+            {
+                num_change++;
+                mem->act[ii][jj] = act_new;
+                mem->mu[ii][jj] = 0.0;
+            }
+            if (act_new != PDAS_INACTIVE)
+                mem->num_active++;
+        }
+    }
+
+    return num_change;
+}
+
+
+
+/************************************************
+ * functions
+ ************************************************/
+
+int ocp_qp_pdas(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, void *work_)
+{
+    ocp_qp_in *qp_in = qp_in_;
+    ocp_qp_out *qp_out = qp_out_;
+
+    int N = qp_in->dim->N;
+    int *ns = qp_in->dim->ns;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        if (ns[ii] > 0)
+        {
+            printf("\nerror: ocp_qp_pdas: soft constraints (ns > 0) not supported\n");
+            exit(1);
+        }
+    }
+
+    qp_info *info = (qp_info *) qp_out->misc;
+    acados_timer tot_timer, qp_timer;
+    acados_tic(&tot_timer);
+
+    // cast data structures
+    ocp_qp_pdas_opts *opts = opts_;
+    ocp_qp_pdas_memory *mem = mem_;
+    ocp_qp_pdas_workspace *work = work_;
+
+    cast_workspace(qp_in->dim, work);
+
+    acados_tic(&qp_timer);
+
+    ocp_qp_pdas_init_active_set(qp_in, qp_out, opts, mem);
+
+    int acados_status = ACADOS_MAXITER;
+    for (mem->iter = 1; mem->iter <= opts->iter_max; mem->iter++)
+    {
+        ocp_qp_pdas_factorize(qp_in, opts, mem, work);
+        mem->res_eq = ocp_qp_pdas_solve_active_set(qp_in, qp_out, opts, mem, work, mem->mu);
+
+        if (ocp_qp_pdas_update_active_set(qp_in, qp_out, opts, mem) == 0)
+        {
+            // the active set is stable, the solution is only optimal if its constraints hold:
+            // otherwise the multiplier refinement hit ref_iter_max
+            if (mem->res_eq <= opts->tol_eq)
+                acados_status = ACADOS_SUCCESS;
+            break;
+        }
+    }
+    if (mem->iter > opts->iter_max)
+        mem->iter = opts->iter_max;
+
+    // NOTE: eval_sens reuses the factorization, which is the one of the solution only if converged
+    ocp_qp_pdas_fill_lam(qp_in, qp_out, mem, mem->mu);
+
+    mem->time_qp_solver_call = acados_toc(&qp_timer);
+
+    ocp_qp_compute_t(qp_in, qp_out);
+
+    info->solve_QP_time = mem->time_qp_solver_call;
+    info->interface_time = 0.0;
+    info->total_time = acados_toc(&tot_timer);
+    info->num_iter = mem->iter;
+    info->t_computed = 1;
+
+    return acados_status;
+}
+
+
+
+void ocp_qp_pdas_eval_sens(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *mem_, void *work_)
+{
+    ocp_qp_in *qp_in = qp_in_;
+    ocp_qp_out *qp_out = qp_out_;
+
+    ocp_qp_pdas_opts *opts = opts_;
+    ocp_qp_pdas_memory *mem = mem_;
+    ocp_qp_pdas_workspace *work = work_;
+
+    cast_workspace(qp_in->dim, work);
+
+    int N = qp_in->dim->N;
+    int *nb = qp_in->dim->nb;
+    int *ng = qp_in->dim->ng;
+
+    // the active set and the factorization of the last solve are kept, only the vectors change
+    for (int ii = 0; ii <= N; ii++)
+        for (int jj = 0; jj < nb[ii] + ng[ii]; jj++)
+            mem->mu_sens[ii][jj] = 0.0;
+
+    ocp_qp_pdas_solve_active_set(qp_in, qp_out, opts, mem, work, mem->mu_sens);
+    ocp_qp_pdas_fill_lam(qp_in, qp_out, mem, mem->mu_sens);
+
+    return;
+}
+
+
+
+void ocp_qp_pdas_config_initialize_default(void *config_)
+{
+    qp_solver_config *config = config_;
+
+    config->dims_set = &ocp_qp_dims_set;
+    config->opts_calculate_size = &ocp_qp_pdas_opts_calculate_size;
+    config->opts_assign = &ocp_qp_pdas_opts_assign;
+    config->opts_initialize_default = &ocp_qp_pdas_opts_initialize_default;
+    config->opts_update = &ocp_qp_pdas_opts_update;
+    config->opts_set = &ocp_qp_pdas_opts_set;
+    config->memory_calculate_size = &ocp_qp_pdas_memory_calculate_size;
+    config->memory_assign = &ocp_qp_pdas_memory_assign;
+    config->memory_get = &ocp_qp_pdas_memory_get;
+    config->workspace_calculate_size = &ocp_qp_pdas_workspace_calculate_size;
+    config->evaluate = &ocp_qp_pdas;
+    config->eval_sens = &ocp_qp_pdas_eval_sens;
+
+    return;
+}
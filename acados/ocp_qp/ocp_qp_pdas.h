@@ -0,0 +1,124 @@
+/*
+ * Copyright 2019 Gianluca Frison, Dimitris Kouzoupis, Robin Verschueren,
+ * Andrea Zanelli, Niels van Duijkeren, Jonathan Frey, Tommaso Sartor,
+ * Branimir Novoselnik, Rien Quirynen, Rezart Qelibari, Dang Doan,
+ * Jonas Koenemann, Yutao Chen, Tobias Schöls, Jonas Schlagenhauf, Moritz Diehl
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#ifndef ACADOS_OCP_QP_OCP_QP_PDAS_H_
+#define ACADOS_OCP_QP_OCP_QP_PDAS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// blasfeo
+#include "blasfeo/include/blasfeo_common.h"
+// acados
+#include "acados/ocp_qp/ocp_qp_common.h"
+#include "acados/utils/types.h"
+
+
+
+// primal-dual active-set method on the stage-wise qp: the equality constrained qp of an active set
+// is solved by a Riccati recursion on the Hessian augmented by rho*C'*C of the active constraints,
+// followed by iterative refinement of their multipliers (method of multipliers)
+typedef struct ocp_qp_pdas_opts_
+{
+    double rho;           // penalty weight of the active constraints
+    double tol_eq;        // max violation of the active constraints after refinement and at convergence
+    double tol_ineq;      // hysteresis of the active set update
+    double reg_prim;      // regularization of the Hessian
+    int iter_max;         // max number of active set changes
+    int ref_iter_max;     // max number of multiplier refinement steps per active set
+    int warm_start;       // 0: cold start, 1: active set and multipliers from qp_out
+} ocp_qp_pdas_opts;
+
+
+
+typedef struct ocp_qp_pdas_memory_
+{
+    struct blasfeo_dmat *L;  // Riccati factors of the last active set
+    struct blasfeo_dvec *l;  // Riccati vectors
+    int **act;               // per constraint: 0 inactive, 1 lower, 2 upper, 3 equality (lb == ub)
+    double **mu;             // multipliers of the active constraints, lam_ub - lam_lb
+    double **mu_sens;        // multipliers of the active constraints in eval_sens
+    double time_qp_solver_call;
+    int iter;
+    int ref_iter;            // refinement steps of the last active set
+    int num_active;          // size of the last active set
+    double res_eq;           // max violation of the active constraints of the last active set
+} ocp_qp_pdas_memory;
+
+
+
+typedef struct ocp_qp_pdas_workspace_
+{
+    struct blasfeo_dmat M;   // augmented Hessian of a stage
+    struct blasfeo_dmat AL;  // [B; A] * Lxx of the next stage
+    struct blasfeo_dvec g;   // gradient of a stage
+    struct blasfeo_dvec tmp0;
+    struct blasfeo_dvec tmp1;
+} ocp_qp_pdas_workspace;
+
+
+
+//
+int ocp_qp_pdas_opts_calculate_size(void *config, void *dims);
+//
+void *ocp_qp_pdas_opts_assign(void *config, void *dims, void *raw_memory);
+//
+void ocp_qp_pdas_opts_initialize_default(void *config, void *dims, void *opts_);
+//
+void ocp_qp_pdas_opts_update(void *config, void *dims, void *opts_);
+//
+void ocp_qp_pdas_opts_set(void *config_, void *opts_, const char *field, void *value);
+//
+int ocp_qp_pdas_memory_calculate_size(void *config, void *dims, void *opts_);
+//
+void *ocp_qp_pdas_memory_assign(void *config, void *dims, void *opts_, void *raw_memory);
+//
+void ocp_qp_pdas_memory_get(void *config_, void *mem_, const char *field, void* value);
+//
+int ocp_qp_pdas_workspace_calculate_size(void *config, void *dims, void *opts_);
+//
+int ocp_qp_pdas(void *config, void *qp_in, void *qp_out, void *opts_, void *mem_, void *work_);
+//
+void ocp_qp_pdas_eval_sens(void *config, void *qp_in, void *qp_out, void *opts_, void *mem_, void *work_);
+//
+void ocp_qp_pdas_config_initialize_default(void *config);
+
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  // ACADOS_OCP_QP_OCP_QP_PDAS_H_
@@ -0,0 +1,761 @@
+/*
+ * Copyright 2019 Gianluca Frison, Dimitris Kouzoupis, Robin Verschueren,
+ * Andrea Zanelli, Niels van Duijkeren, Jonathan Frey, Tommaso Sartor,
+ * Branimir Novoselnik, Rien Quirynen, Rezart Qelibari, Dang Doan,
+ * Jonas Koenemann, Yutao Chen, Tobias Schöls, Jonas Schlagenhauf, Moritz Diehl
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+// external
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// blasfeo
+#include "blasfeo/include/blasfeo_d_aux.h"
+
+// acados
+#include "acados/ocp_qp/ocp_qp_common.h"
+#include "acados/ocp_qp/ocp_qp_presolve.h"
+#include "acados/utils/mem.h"
+#include "acados/utils/types.h"
+
+
+
+// flags of the original constraints
+#define PRESOLVE_SOFT 1
+#define PRESOLVE_EQ 2
+
+
+
+/************************************************
+ * memory
+ ************************************************/
+
+int ocp_qp_presolve_memory_calculate_size(ocp_qp_dims *dims)
+{
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *nb = dims->nb;
+    int *ng = dims->ng;
+
+    int pattern_size = 0, nu_tot = 0, ng_tot = 0;
+    int nv_max = 0, nu_max = 0, nb_max = 0, ng_max = 0;
+    for (int ii = 0; ii <= N; ii++)
+    {
+        pattern_size += nu[ii] + nb[ii] + ng[ii];
+        nu_tot += nu[ii];
+        ng_tot += ng[ii];
+        nv_max = nu[ii] + nx[ii] > nv_max ? nu[ii] + nx[ii] : nv_max;
+        nu_max = nu[ii] > nu_max ? nu[ii] : nu_max;
+        nb_max = nb[ii] > nb_max ? nb[ii] : nb_max;
+        ng_max = ng[ii] > ng_max ? ng[ii] : ng_max;
+    }
+
+    int size = sizeof(ocp_qp_presolve_memory);
+
+    size += ocp_qp_dims_calculate_size(N);  // red_dims
+
+    // red_qp_in, red_qp_out: the presolved qp is never larger than the original one
+    size += ocp_qp_in_calculate_size(dims);
+    size += ocp_qp_out_calculate_size(dims);
+
+    size += ocp_qp_res_calculate_size(dims);
+    size += ocp_qp_res_workspace_calculate_size(dims);
+
+    size += (nu_tot + ng_max) * sizeof(double);  // u_val, g_shift
+
+    size += 2 * pattern_size * sizeof(int);  // pattern, pattern_new
+    size += 3 * (N + 1) * sizeof(int);  // pattern_offset, g_offset, u_offset
+    size += 2 * ng_tot * sizeof(int);  // g_lg_src, g_ug_src
+    size += (nv_max + nu_max + nb_max + 2 * ng_max + nb_max + ng_max) * sizeof(int);  // scratch
+
+    size += 4 * 8;
+    make_int_multiple_of(8, &size);
+
+    return size;
+}
+
+
+
+ocp_qp_presolve_memory *ocp_qp_presolve_memory_assign(ocp_qp_dims *dims, void *raw_memory)
+{
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *nb = dims->nb;
+    int *ng = dims->ng;
+
+    int pattern_size = 0, nu_tot = 0, ng_tot = 0;
+    int nv_max = 0, nu_max = 0, nb_max = 0, ng_max = 0;
+    for (int ii = 0; ii <= N; ii++)
+    {
+        pattern_size += nu[ii] + nb[ii] + ng[ii];
+        nu_tot += nu[ii];
+        ng_tot += ng[ii];
+        nv_max = nu[ii] + nx[ii] > nv_max ? nu[ii] + nx[ii] : nv_max;
+        nu_max = nu[ii] > nu_max ? nu[ii] : nu_max;
+        nb_max = nb[ii] > nb_max ? nb[ii] : nb_max;
+        ng_max = ng[ii] > ng_max ? ng[ii] : ng_max;
+    }
+
+    char *c_ptr = (char *) raw_memory;
+
+    ocp_qp_presolve_memory *mem = (ocp_qp_presolve_memory *) c_ptr;
+    c_ptr += sizeof(ocp_qp_presolve_memory);
+
+    align_char_to(8, &c_ptr);
+
+    // red_dims, initially equal to the original dims
+    mem->red_dims = ocp_qp_dims_assign(N, c_ptr);
+    c_ptr += ocp_qp_dims_calculate_size(N);
+    d_ocp_qp_dim_copy_all(dims, mem->red_dims);
+
+    // red_qp_in, red_qp_out
+    mem->red_qp_mem = c_ptr;
+    mem->red_qp_in_size = ocp_qp_in_calculate_size(dims);
+    mem->red_qp_in = ocp_qp_in_assign(mem->red_dims, c_ptr);
+    c_ptr += mem->red_qp_in_size;
+    mem->red_qp_out = ocp_qp_out_assign(mem->red_dims, c_ptr);
+    c_ptr += ocp_qp_out_calculate_size(dims);
+
+    // res, res_ws
+    mem->res = ocp_qp_res_assign(dims, c_ptr);
+    c_ptr += ocp_qp_res_calculate_size(dims);
+    mem->res_ws = ocp_qp_res_workspace_assign(dims, c_ptr);
+    c_ptr += ocp_qp_res_workspace_calculate_size(dims);
+
+    align_char_to(8, &c_ptr);
+
+    assign_and_advance_double(nu_tot, &mem->u_val, &c_ptr);
+    assign_and_advance_double(ng_max, &mem->g_shift, &c_ptr);
+
+    assign_and_advance_int(pattern_size, &mem->pattern, &c_ptr);
+    assign_and_advance_int(pattern_size, &mem->pattern_new, &c_ptr);
+    assign_and_advance_int(N + 1, &mem->pattern_offset, &c_ptr);
+    assign_and_advance_int(N + 1, &mem->g_offset, &c_ptr);
+    assign_and_advance_int(N + 1, &mem->u_offset, &c_ptr);
+    assign_and_advance_int(ng_tot, &mem->g_lg_src, &c_ptr);
+    assign_and_advance_int(ng_tot, &mem->g_ug_src, &c_ptr);
+    assign_and_advance_int(nv_max, &mem->v_map, &c_ptr);
+    assign_and_advance_int(nu_max, &mem->u_new, &c_ptr);
+    assign_and_advance_int(nb_max, &mem->b_map, &c_ptr);
+    assign_and_advance_int(ng_max, &mem->g_map, &c_ptr);
+    assign_and_advance_int(ng_max, &mem->g_cnt, &c_ptr);
+    assign_and_advance_int(nb_max + ng_max, &mem->flag, &c_ptr);
+
+    // nothing removed
+    int offset = 0, g_offset = 0, u_offset = 0;
+    for (int ii = 0; ii <= N; ii++)
+    {
+        mem->pattern_offset[ii] = offset;
+        mem->g_offset[ii] = g_offset;
+        mem->u_offset[ii] = u_offset;
+
+        int *u_fix = mem->pattern + offset;
+        int *b_red = u_fix + nu[ii];
+        int *g_red = b_red + nb[ii];
+        for (int jj = 0; jj < nu[ii]; jj++)
+            u_fix[jj] = -1;
+        for (int jj = 0; jj < nb[ii]; jj++)
+            b_red[jj] = jj;
+        for (int jj = 0; jj < ng[ii]; jj++)
+            g_red[jj] = jj;
+
+        offset += nu[ii] + nb[ii] + ng[ii];
+        g_offset += ng[ii];
+        u_offset += nu[ii];
+    }
+
+    mem->nu_fixed = 0;
+    mem->nb_removed = 0;
+    mem->ng_removed = 0;
+    mem->num_update = 0;
+
+    assert((char *) raw_memory + ocp_qp_presolve_memory_calculate_size(dims) >= c_ptr);
+
+    return mem;
+}
+
+
+
+/************************************************
+ * helper functions
+ ************************************************/
+
+// mark soft constraints and constraints flagged as equalities
+static void ocp_qp_presolve_flags(ocp_qp_in *qp_in, int ii, int *flag)
+{
+    int nb = qp_in->dim->nb[ii];
+    int ng = qp_in->dim->ng[ii];
+    int nbe = qp_in->dim->nbue[ii] + qp_in->dim->nbxe[ii];
+    int nge = qp_in->dim->nge[ii];
+
+    for (int jj = 0; jj < nb + ng; jj++)
+        flag[jj] = qp_in->idxs_rev[ii][jj] != -1 ? PRESOLVE_SOFT : 0;
+    for (int jj = 0; jj < nbe; jj++)
+        flag[qp_in->idxe[ii][jj]] |= PRESOLVE_EQ;
+    for (int jj = 0; jj < nge; jj++)
+        flag[nb + qp_in->idxe[ii][nbe + jj]] |= PRESOLVE_EQ;
+}
+
+
+
+// value of a fixed input, in the middle of its bounds
+static double ocp_qp_presolve_fixed_value(ocp_qp_in *qp_in, int ii, int jb)
+{
+    int nb = qp_in->dim->nb[ii];
+    int ng = qp_in->dim->ng[ii];
+
+    // NOTE: the upper bounds are stored with flipped sign in d
+    return 0.5 * (BLASFEO_DVECEL(qp_in->d+ii, jb) - BLASFEO_DVECEL(qp_in->d+ii, nb+ng+jb));
+}
+
+
+
+// maps between the presolved and the original qp at stage ii
+static void ocp_qp_presolve_stage_maps(ocp_qp_in *qp_in, int ii, ocp_qp_presolve_memory *mem,
+                                       int *nv_r, int *nb_r, int *ng_r)
+{
+    int nx = qp_in->dim->nx[ii];
+    int nu = qp_in->dim->nu[ii];
+    int nb = qp_in->dim->nb[ii];
+    int ng = qp_in->dim->ng[ii];
+
+    int *u_fix = mem->pattern + mem->pattern_offset[ii];
+    int *b_red = u_fix + nu;
+    int *g_red = b_red + nb;
+
+    int kk = 0;
+    for (int jj = 0; jj < nu; jj++)
+    {
+        mem->u_new[jj] = -1;
+        if (u_fix[jj] == -1)
+        {
+            mem->u_new[jj] = kk;
+            mem->v_map[kk++] = jj;
+        }
+    }
+    for (int jj = 0; jj < nx; jj++)
+        mem->v_map[kk++] = nu + jj;
+    *nv_r = kk;
+
+    *nb_r = 0;
+    for (int jj = 0; jj < nb; jj++)
+    {
+        if (b_red[jj] >= 0)
+        {
+            mem->b_map[b_red[jj]] = jj;
+            (*nb_r)++;
+        }
+    }
+
+    *ng_r = 0;
+    for (int jj = 0; jj < ng; jj++)
+        mem->g_cnt[jj] = 0;
+    for (int jj = 0; jj < ng; jj++)
+    {
+        int q = g_red[jj];
+        if (q >= 0)
+        {
+            if (mem->g_cnt[q] == 0)
+            {
+                mem->g_map[q] = jj;
+                (*ng_r)++;
+            }
+            mem->g_cnt[q]++;
+        }
+    }
+}
+
+
+
+// update red_dims to the current pattern and re-assign the presolved qp
+static void ocp_qp_presolve_update_dims(ocp_qp_in *qp_in, ocp_qp_presolve_memory *mem)
+{
+    int N = qp_in->dim->N;
+    ocp_qp_dims *red_dims = mem->red_dims;
+
+    d_ocp_qp_dim_copy_all(qp_in->dim, red_dims);
+
+    mem->nu_fixed = 0;
+    mem->nb_removed = 0;
+    mem->ng_removed = 0;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        int nu = qp_in->dim->nu[ii];
+        int nb = qp_in->dim->nb[ii];
+        int ng = qp_in->dim->ng[ii];
+        int nbue = qp_in->dim->nbue[ii];
+        int *u_fix = mem->pattern + mem->pattern_offset[ii];
+        int *b_red = u_fix + nu;
+
+        int nv_r, nb_r, ng_r;
+        ocp_qp_presolve_stage_maps(qp_in, ii, mem, &nv_r, &nb_r, &ng_r);
+
+        int nu_r = nv_r - qp_in->dim->nx[ii];
+        int nbu_r = 0;
+        for (int jj = 0; jj < nb_r; jj++)
+            if (qp_in->idxb[ii][mem->b_map[jj]] < nu)
+                nbu_r++;
+        int nbx_r = nb_r - nbu_r;
+        int nbue_r = 0;
+        for (int jj = 0; jj < nbue; jj++)
+            if (b_red[qp_in->idxe[ii][jj]] >= 0)
+                nbue_r++;
+
+        ocp_qp_dims_set(NULL, red_dims, ii, "nu", &nu_r);
+        ocp_qp_dims_set(NULL, red_dims, ii, "nbu", &nbu_r);
+        ocp_qp_dims_set(NULL, red_dims, ii, "nbx", &nbx_r);
+        ocp_qp_dims_set(NULL, red_dims, ii, "ng", &ng_r);
+        ocp_qp_dims_set(NULL, red_dims, ii, "nbue", &nbue_r);
+
+        mem->nu_fixed += nu - nu_r;
+        mem->nb_removed += nb - nb_r;
+        mem->ng_removed += ng - ng_r;
+    }
+
+    mem->red_qp_in = ocp_qp_in_assign(red_dims, mem->red_qp_mem);
+    mem->red_qp_out = ocp_qp_out_assign(red_dims, mem->red_qp_mem + mem->red_qp_in_size);
+
+    mem->num_update++;
+}
+
+
+
+/************************************************
+ * functions
+ ************************************************/
+
+int ocp_qp_presolve_structure(ocp_qp_in *qp_in, double tol, ocp_qp_presolve_memory *mem)
+{
+    int N = qp_in->dim->N;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        int nx = qp_in->dim->nx[ii];
+        int nu = qp_in->dim->nu[ii];
+        int nb = qp_in->dim->nb[ii];
+        int ng = qp_in->dim->ng[ii];
+        int nv = nu + nx;
+
+        struct blasfeo_dvec *d = qp_in->d+ii;
+        struct blasfeo_dmat *DCt = qp_in->DCt+ii;
+        int *idxb = qp_in->idxb[ii];
+
+        int *u_fix = mem->pattern_new + mem->pattern_offset[ii];
+        int *b_red = u_fix + nu;
+        int *g_red = b_red + nb;
+        int *flag = mem->flag;
+
+        ocp_qp_presolve_flags(qp_in, ii, flag);
+
+        // fixed inputs
+        for (int jj = 0; jj < nu; jj++)
+            u_fix[jj] = -1;
+        for (int jj = 0; jj < nb; jj++)
+        {
+            int iv = idxb[jj];
+            double lb = BLASFEO_DVECEL(d, jj);
+            double ub = -BLASFEO_DVECEL(d, nb+ng+jj);
+            if (iv < nu && !(flag[jj] & PRESOLVE_SOFT) && u_fix[iv] == -1 &&
+                lb > ACADOS_NEG_INFTY && ub - lb <= tol)
+                u_fix[iv] = jj;
+        }
+
+        // box constraints: drop the ones on fixed inputs and the ones without finite bounds
+        int nb_r = 0;
+        for (int jj = 0; jj < nb; jj++)
+        {
+            int iv = idxb[jj];
+            double lb = BLASFEO_DVECEL(d, jj);
+            double ub = -BLASFEO_DVECEL(d, nb+ng+jj);
+            if (iv < nu && u_fix[iv] != -1)
+                b_red[jj] = -1;
+            else if (!flag[jj] && lb <= ACADOS_NEG_INFTY && ub >= ACADOS_POS_INFTY)
+                b_red[jj] = -1;
+            else
+                b_red[jj] = nb_r++;
+        }
+
+        // contribution of the fixed inputs to the general constraints
+        for (int jj = 0; jj < ng; jj++)
+        {
+            mem->g_shift[jj] = 0.0;
+            for (int iv = 0; iv < nu; iv++)
+                if (u_fix[iv] != -1)
+                    mem->g_shift[jj] += BLASFEO_DMATEL(DCt, iv, jj) *
+                                        ocp_qp_presolve_fixed_value(qp_in, ii, u_fix[iv]);
+        }
+
+        // general constraints
+        int ng_r = 0;
+        for (int jj = 0; jj < ng; jj++)
+        {
+            if (flag[nb+jj])
+            {
+                g_red[jj] = ng_r++;
+                continue;
+            }
+
+            double lg = BLASFEO_DVECEL(d, nb+jj);
+            double ug = -BLASFEO_DVECEL(d, 2*nb+ng+jj);
+            if (lg <= ACADOS_NEG_INFTY && ug >= ACADOS_POS_INFTY)
+            {
+                g_red[jj] = -1;
+                continue;
+            }
+
+            // row only depending on fixed inputs and satisfied by them
+            int free_zero = 1;
+            for (int iv = 0; iv < nv && free_zero; iv++)
+                if ((iv >= nu || u_fix[iv] == -1) && BLASFEO_DMATEL(DCt, iv, jj) != 0.0)
+                    free_zero = 0;
+            if (free_zero && lg - tol <= mem->g_shift[jj] && mem->g_shift[jj] <= ug + tol)
+            {
+                g_red[jj] = -1;
+                continue;
+            }
+
+            // identical to a previous row
+            g_red[jj] = -1;
+            for (int kk = 0; kk < jj && g_red[jj] == -1; kk++)
+            {
+                if (g_red[kk] < 0 || flag[nb+kk])
+                    continue;
+                int equal = 1;
+                for (int iv = 0; iv < nv && equal; iv++)
+                    equal = BLASFEO_DMATEL(DCt, iv, jj) == BLASFEO_DMATEL(DCt, iv, kk);
+                if (equal)
+                    g_red[jj] = g_red[kk];
+            }
+            if (g_red[jj] == -1)
+                g_red[jj] = ng_r++;
+        }
+    }
+
+    int pattern_size = mem->pattern_offset[N] + qp_in->dim->nu[N] + qp_in->dim->nb[N] +
+                       qp_in->dim->ng[N];
+    if (!memcmp(mem->pattern, mem->pattern_new, pattern_size * sizeof(int)))
+        return 0;
+
+    int *tmp = mem->pattern;
+    mem->pattern = mem->pattern_new;
+    mem->pattern_new = tmp;
+
+    ocp_qp_presolve_update_dims(qp_in, mem);
+
+    return 1;
+}
+
+
+
+void ocp_qp_presolve(ocp_qp_in *qp_in, ocp_qp_presolve_memory *mem)
+{
+    int N = qp_in->dim->N;
+    ocp_qp_in *red = mem->red_qp_in;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        int nx = qp_in->dim->nx[ii];
+        int nu = qp_in->dim->nu[ii];
+        int nb = qp_in->dim->nb[ii];
+        int ng = qp_in->dim->ng[ii];
+        int ns = qp_in->dim->ns[ii];
+        int nbe = qp_in->dim->nbue[ii] + qp_in->dim->nbxe[ii];
+        int nge = qp_in->dim->nge[ii];
+        int nv = nu + nx;
+
+        int *u_fix = mem->pattern + mem->pattern_offset[ii];
+        int *b_red = u_fix + nu;
+        int *g_red = b_red + nb;
+        int *lg_src = mem->g_lg_src + mem->g_offset[ii];
+        int *ug_src = mem->g_ug_src + mem->g_offset[ii];
+        double *u_val = mem->u_val + mem->u_offset[ii];
+        int *v_map = mem->v_map;
+        int *b_map = mem->b_map;
+        int *g_map = mem->g_map;
+
+        int nv_r, nb_r, ng_r;
+        ocp_qp_presolve_stage_maps(qp_in, ii, mem, &nv_r, &nb_r, &ng_r);
+        int nu_r = nv_r - nx;
+
+        // values of the fixed inputs
+        for (int iv = 0; iv < nu; iv++)
+            u_val[iv] = u_fix[iv] != -1 ? ocp_qp_presolve_fixed_value(qp_in, ii, u_fix[iv]) : 0.0;
+
+        // contribution of the fixed inputs to the general constraints
+        for (int jj = 0; jj < ng; jj++)
+        {
+            mem->g_shift[jj] = 0.0;
+            for (int iv = 0; iv < nu; iv++)
+                if (u_fix[iv] != -1)
+                    mem->g_shift[jj] += BLASFEO_DMATEL(qp_in->DCt+ii, iv, jj) * u_val[iv];
+        }
+
+        // rows with the tightest bounds among merged rows
+        for (int q = 0; q < ng_r; q++)
+        {
+            lg_src[q] = -1;
+            ug_src[q] = -1;
+        }
+        for (int jj = 0; jj < ng; jj++)
+        {
+            int q = g_red[jj];
+            if (q < 0)
+                continue;
+            if (lg_src[q] == -1 ||
+                BLASFEO_DVECEL(qp_in->d+ii, nb+jj) > BLASFEO_DVECEL(qp_in->d+ii, nb+lg_src[q]))
+                lg_src[q] = jj;
+            // NOTE: upper bounds are stored with flipped sign
+            if (ug_src[q] == -1 || BLASFEO_DVECEL(qp_in->d+ii, 2*nb+ng+jj) >
+                                   BLASFEO_DVECEL(qp_in->d+ii, 2*nb+ng+ug_src[q]))
+                ug_src[q] = jj;
+        }
+
+        // dynamics, the fixed inputs move into b
+        if (ii < N)
+        {
+            int nx1 = qp_in->dim->nx[ii+1];
+            for (int jc = 0; jc < nx1; jc++)
+            {
+                for (int kk = 0; kk < nv_r; kk++)
+                    BLASFEO_DMATEL(red->BAbt+ii, kk, jc) =
+                        BLASFEO_DMATEL(qp_in->BAbt+ii, v_map[kk], jc);
+
+                double b = BLASFEO_DMATEL(qp_in->BAbt+ii, nv, jc);
+                for (int iv = 0; iv < nu; iv++)
+                    if (u_fix[iv] != -1)
+                        b += BLASFEO_DMATEL(qp_in->BAbt+ii, iv, jc) * u_val[iv];
+                BLASFEO_DMATEL(red->BAbt+ii, nv_r, jc) = b;
+                BLASFEO_DVECEL(red->b+ii, jc) = b;
+            }
+        }
+
+        // cost, the fixed inputs move into the gradient
+        for (int kk = 0; kk < nv_r; kk++)
+        {
+            for (int jj = 0; jj <= kk; jj++)
+                BLASFEO_DMATEL(red->RSQrq+ii, kk, jj) =
+                    BLASFEO_DMATEL(qp_in->RSQrq+ii, v_map[kk], v_map[jj]);
+
+            double g = BLASFEO_DVECEL(qp_in->rqz+ii, v_map[kk]);
+            for (int iv = 0; iv < nu; iv++)
+            {
+                if (u_fix[iv] == -1)
+                    continue;
+                // lower triangular storage
+                int i0 = v_map[kk] > iv ? v_map[kk] : iv;
+                int i1 = v_map[kk] > iv ? iv : v_map[kk];
+                g += BLASFEO_DMATEL(qp_in->RSQrq+ii, i0, i1) * u_val[iv];
+            }
+            BLASFEO_DMATEL(red->RSQrq+ii, nv_r, kk) = g;
+            BLASFEO_DVECEL(red->rqz+ii, kk) = g;
+        }
+        for (int js = 0; js < 2*ns; js++)
+        {
+            BLASFEO_DVECEL(red->rqz+ii, nv_r+js) = BLASFEO_DVECEL(qp_in->rqz+ii, nv+js);
+            BLASFEO_DVECEL(red->Z+ii, js) = BLASFEO_DVECEL(qp_in->Z+ii, js);
+        }
+        red->diag_H_flag[ii] = qp_in->diag_H_flag[ii];
+
+        // general constraints
+        for (int q = 0; q < ng_r; q++)
+            for (int kk = 0; kk < nv_r; kk++)
+                BLASFEO_DMATEL(red->DCt+ii, kk, q) = BLASFEO_DMATEL(qp_in->DCt+ii, v_map[kk], g_map[q]);
+
+        // bounds, d = [lb lg -ub -ug ls us]
+        for (int jb = 0; jb < nb_r; jb++)
+        {
+            int jo = b_map[jb];
+            BLASFEO_DVECEL(red->d+ii, jb) = BLASFEO_DVECEL(qp_in->d+ii, jo);
+            BLASFEO_DVECEL(red->d+ii, nb_r+ng_r+jb) = BLASFEO_DVECEL(qp_in->d+ii, nb+ng+jo);
+            BLASFEO_DVECEL(red->m+ii, jb) = BLASFEO_DVECEL(qp_in->m+ii, jo);
+            BLASFEO_DVECEL(red->m+ii, nb_r+ng_r+jb) = BLASFEO_DVECEL(qp_in->m+ii, nb+ng+jo);
+            BLASFEO_DVECEL(red->d_mask+ii, jb) = BLASFEO_DVECEL(qp_in->d_mask+ii, jo);
+            BLASFEO_DVECEL(red->d_mask+ii, nb_r+ng_r+jb) = BLASFEO_DVECEL(qp_in->d_mask+ii, nb+ng+jo);
+
+            int iv = qp_in->idxb[ii][jo];
+            red->idxb[ii][jb] = iv < nu ? mem->u_new[iv] : nu_r + iv - nu;
+            red->idxs_rev[ii][jb] = qp_in->idxs_rev[ii][jo];
+        }
+        for (int q = 0; q < ng_r; q++)
+        {
+            int jl = lg_src[q];
+            int ju = ug_src[q];
+            BLASFEO_DVECEL(red->d+ii, nb_r+q) = BLASFEO_DVECEL(qp_in->d+ii, nb+jl) - mem->g_shift[jl];
+            BLASFEO_DVECEL(red->d+ii, 2*nb_r+ng_r+q) = BLASFEO_DVECEL(qp_in->d+ii, 2*nb+ng+ju) +
+                                                       mem->g_shift[ju];
+            BLASFEO_DVECEL(red->m+ii, nb_r+q) = BLASFEO_DVECEL(qp_in->m+ii, nb+jl);
+            BLASFEO_DVECEL(red->m+ii, 2*nb_r+ng_r+q) = BLASFEO_DVECEL(qp_in->m+ii, 2*nb+ng+ju);
+            BLASFEO_DVECEL(red->d_mask+ii, nb_r+q) = BLASFEO_DVECEL(qp_in->d_mask+ii, nb+jl);
+            BLASFEO_DVECEL(red->d_mask+ii, 2*nb_r+ng_r+q) = BLASFEO_DVECEL(qp_in->d_mask+ii, 2*nb+ng+ju);
+
+            red->idxs_rev[ii][nb_r+q] = qp_in->idxs_rev[ii][nb+g_map[q]];
+        }
+        for (int js = 0; js < 2*ns; js++)
+        {
+            BLASFEO_DVECEL(red->d+ii, 2*nb_r+2*ng_r+js) = BLASFEO_DVECEL(qp_in->d+ii, 2*nb+2*ng+js);
+            BLASFEO_DVECEL(red->m+ii, 2*nb_r+2*ng_r+js) = BLASFEO_DVECEL(qp_in->m+ii, 2*nb+2*ng+js);
+            BLASFEO_DVECEL(red->d_mask+ii, 2*nb_r+2*ng_r+js) =
+                BLASFEO_DVECEL(qp_in->d_mask+ii, 2*nb+2*ng+js);
+        }
+
+        // equality flags
+        int ke = 0;
+        for (int jj = 0; jj < nbe; jj++)
+            if (b_red[qp_in->idxe[ii][jj]] >= 0)
+                red->idxe[ii][ke++] = b_red[qp_in->idxe[ii][jj]];
+        for (int jj = 0; jj < nge; jj++)
+            red->idxe[ii][ke++] = g_red[qp_in->idxe[ii][nbe+jj]];
+    }
+}
+
+
+
+void ocp_qp_postsolve(ocp_qp_in *qp_in, ocp_qp_out *qp_out, ocp_qp_presolve_memory *mem)
+{
+    int N = qp_in->dim->N;
+    ocp_qp_out *red = mem->red_qp_out;
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        int nx = qp_in->dim->nx[ii];
+        int nu = qp_in->dim->nu[ii];
+        int nb = qp_in->dim->nb[ii];
+        int ng = qp_in->dim->ng[ii];
+        int ns = qp_in->dim->ns[ii];
+        int nv = nu + nx;
+
+        int *u_fix = mem->pattern + mem->pattern_offset[ii];
+        int *b_red = u_fix + nu;
+        int *g_red = b_red + nb;
+        int *lg_src = mem->g_lg_src + mem->g_offset[ii];
+        int *ug_src = mem->g_ug_src + mem->g_offset[ii];
+        double *u_val = mem->u_val + mem->u_offset[ii];
+
+        int nv_r, nb_r, ng_r;
+        ocp_qp_presolve_stage_maps(qp_in, ii, mem, &nv_r, &nb_r, &ng_r);
+
+        // primal solution
+        for (int kk = 0; kk < nv_r; kk++)
+            BLASFEO_DVECEL(qp_out->ux+ii, mem->v_map[kk]) = BLASFEO_DVECEL(red->ux+ii, kk);
+        for (int iv = 0; iv < nu; iv++)
+            if (u_fix[iv] != -1)
+                BLASFEO_DVECEL(qp_out->ux+ii, iv) = u_val[iv];
+        for (int js = 0; js < 2*ns; js++)
+            BLASFEO_DVECEL(qp_out->ux+ii, nv+js) = BLASFEO_DVECEL(red->ux+ii, nv_r+js);
+
+        if (ii < N)
+            blasfeo_dveccp(qp_in->dim->nx[ii+1], red->pi+ii, 0, qp_out->pi+ii, 0);
+
+        // multipliers and slacks of the constraints, lam = [lb lg ub ug ls us]
+        blasfeo_dvecse(2*nb+2*ng+2*ns, 0.0, qp_out->lam+ii, 0);
+        for (int jb = 0; jb < nb; jb++)
+        {
+            int kb = b_red[jb];
+            if (kb >= 0)
+            {
+                BLASFEO_DVECEL(qp_out->lam+ii, jb) = BLASFEO_DVECEL(red->lam+ii, kb);
+                BLASFEO_DVECEL(qp_out->lam+ii, nb+ng+jb) = BLASFEO_DVECEL(red->lam+ii, nb_r+ng_r+kb);
+                BLASFEO_DVECEL(qp_out->t+ii, jb) = BLASFEO_DVECEL(red->t+ii, kb);
+                BLASFEO_DVECEL(qp_out->t+ii, nb+ng+jb) = BLASFEO_DVECEL(red->t+ii, nb_r+ng_r+kb);
+            }
+            else
+            {
+                double x = BLASFEO_DVECEL(qp_out->ux+ii, qp_in->idxb[ii][jb]);
+                BLASFEO_DVECEL(qp_out->t+ii, jb) = x - BLASFEO_DVECEL(qp_in->d+ii, jb);
+                BLASFEO_DVECEL(qp_out->t+ii, nb+ng+jb) = -BLASFEO_DVECEL(qp_in->d+ii, nb+ng+jb) - x;
+            }
+        }
+        for (int jj = 0; jj < ng; jj++)
+        {
+            int q = g_red[jj];
+            if (q >= 0 && mem->g_cnt[q] == 1)
+            {
+                BLASFEO_DVECEL(qp_out->lam+ii, nb+jj) = BLASFEO_DVECEL(red->lam+ii, nb_r+q);
+                BLASFEO_DVECEL(qp_out->lam+ii, 2*nb+ng+jj) = BLASFEO_DVECEL(red->lam+ii, 2*nb_r+ng_r+q);
+                BLASFEO_DVECEL(qp_out->t+ii, nb+jj) = BLASFEO_DVECEL(red->t+ii, nb_r+q);
+                BLASFEO_DVECEL(qp_out->t+ii, 2*nb+ng+jj) = BLASFEO_DVECEL(red->t+ii, 2*nb_r+ng_r+q);
+                continue;
+            }
+
+            // removed or merged row
+            double Dux = 0.0;
+            for (int iv = 0; iv < nv; iv++)
+                Dux += BLASFEO_DMATEL(qp_in->DCt+ii, iv, jj) * BLASFEO_DVECEL(qp_out->ux+ii, iv);
+            BLASFEO_DVECEL(qp_out->t+ii, nb+jj) = Dux - BLASFEO_DVECEL(qp_in->d+ii, nb+jj);
+            BLASFEO_DVECEL(qp_out->t+ii, 2*nb+ng+jj) = -BLASFEO_DVECEL(qp_in->d+ii, 2*nb+ng+jj) - Dux;
+
+            // the multipliers of a merged row go to the rows with the tightest bounds
+            if (q >= 0 && lg_src[q] == jj)
+                BLASFEO_DVECEL(qp_out->lam+ii, nb+jj) = BLASFEO_DVECEL(red->lam+ii, nb_r+q);
+            if (q >= 0 && ug_src[q] == jj)
+                BLASFEO_DVECEL(qp_out->lam+ii, 2*nb+ng+jj) = BLASFEO_DVECEL(red->lam+ii, 2*nb_r+ng_r+q);
+        }
+        for (int js = 0; js < 2*ns; js++)
+        {
+            BLASFEO_DVECEL(qp_out->lam+ii, 2*nb+2*ng+js) = BLASFEO_DVECEL(red->lam+ii, 2*nb_r+2*ng_r+js);
+            BLASFEO_DVECEL(qp_out->t+ii, 2*nb+2*ng+js) = BLASFEO_DVECEL(red->t+ii, 2*nb_r+2*ng_r+js);
+        }
+    }
+
+    qp_info *info = (qp_info *) qp_out->misc;
+    info->t_computed = 1;
+
+    if (mem->nu_fixed == 0)
+        return;
+
+    // multipliers of the bounds fixing the inputs, from the stationarity residual without them:
+    // res_g[idxb] contains lam_ub - lam_lb
+    ocp_qp_res_compute(qp_in, qp_out, mem->res, mem->res_ws);
+
+    for (int ii = 0; ii <= N; ii++)
+    {
+        int nu = qp_in->dim->nu[ii];
+        int nb = qp_in->dim->nb[ii];
+        int ng = qp_in->dim->ng[ii];
+        int *u_fix = mem->pattern + mem->pattern_offset[ii];
+
+        for (int iv = 0; iv < nu; iv++)
+        {
+            int jb = u_fix[iv];
+            if (jb == -1)
+                continue;
+            double r = BLASFEO_DVECEL(mem->res->res_g+ii, iv);
+            if (r > 0.0)
+                BLASFEO_DVECEL(qp_out->lam+ii, jb) = r;
+            else
+                BLASFEO_DVECEL(qp_out->lam+ii, nb+ng+jb) = -r;
+        }
+    }
+}
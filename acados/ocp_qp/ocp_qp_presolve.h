@@ -0,0 +1,105 @@
+/*
+ * Copyright 2019 Gianluca Frison, Dimitris Kouzoupis, Robin Verschueren,
+ * Andrea Zanelli, Niels van Duijkeren, Jonathan Frey, Tommaso Sartor,
+ * Branimir Novoselnik, Rien Quirynen, Rezart Qelibari, Dang Doan,
+ * Jonas Koenemann, Yutao Chen, Tobias Schöls, Jonas Schlagenhauf, Moritz Diehl
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#ifndef ACADOS_OCP_QP_OCP_QP_PRESOLVE_H_
+#define ACADOS_OCP_QP_OCP_QP_PRESOLVE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// acados
+#include "acados/ocp_qp/ocp_qp_common.h"
+#include "acados/utils/types.h"
+
+
+
+// Presolve of an ocp qp keeping its stage structure:
+// - inputs with lbu == ubu (up to tol) are fixed and removed from the qp,
+// - box and general constraints without finite bounds are removed,
+// - general constraints that only depend on fixed inputs and are satisfied are removed,
+// - general constraints with identical rows in DCt are merged into one row.
+// Soft constraints and constraints flagged as equalities (idxe) are kept as they are.
+typedef struct ocp_qp_presolve_memory_
+{
+    ocp_qp_dims *red_dims;    // dims of the presolved qp
+    ocp_qp_in *red_qp_in;     // presolved qp
+    ocp_qp_out *red_qp_out;   // solution of the presolved qp
+    ocp_qp_res *res;          // residuals of the original qp, used to recover the duals of fixed inputs
+    ocp_qp_res_ws *res_ws;
+    char *red_qp_mem;         // red_qp_in and red_qp_out, sized for the original dims
+    int red_qp_in_size;
+    int *pattern;             // per stage: u_fix[nu], b_red[nb], g_red[ng]
+    int *pattern_new;
+    int *pattern_offset;      // start of each stage in pattern
+    int *g_lg_src;            // per stage and row of the presolved qp: original row with the tightest lg
+    int *g_ug_src;            // per stage and row of the presolved qp: original row with the tightest ug
+    int *g_offset;            // start of each stage in g_lg_src, g_ug_src
+    double *u_val;            // values of the fixed inputs, per stage
+    int *u_offset;            // start of each stage in u_val
+    // scratch maps of one stage
+    int *v_map;               // variables of the presolved qp -> original variables
+    int *u_new;               // original inputs -> inputs of the presolved qp, -1 if fixed
+    int *b_map;               // box constraints of the presolved qp -> original box constraints
+    int *g_map;               // rows of the presolved qp -> first original row
+    int *g_cnt;               // number of original rows merged into each row of the presolved qp
+    int *flag;                // soft or equality flag of the original constraints
+    double *g_shift;          // contribution of the fixed inputs to each original row
+    // statistics
+    int nu_fixed;             // number of fixed inputs
+    int nb_removed;           // number of removed box constraints
+    int ng_removed;           // number of removed or merged general constraints
+    int num_update;           // number of structure changes
+} ocp_qp_presolve_memory;
+
+
+
+//
+int ocp_qp_presolve_memory_calculate_size(ocp_qp_dims *dims);
+//
+ocp_qp_presolve_memory *ocp_qp_presolve_memory_assign(ocp_qp_dims *dims, void *raw_memory);
+// detect the structure of the presolved qp, returns 1 if its dims changed since the last call
+int ocp_qp_presolve_structure(ocp_qp_in *qp_in, double tol, ocp_qp_presolve_memory *mem);
+// fill mem->red_qp_in from qp_in, using the last detected structure
+void ocp_qp_presolve(ocp_qp_in *qp_in, ocp_qp_presolve_memory *mem);
+// recover the primal and dual solution of qp_in from mem->red_qp_out
+void ocp_qp_postsolve(ocp_qp_in *qp_in, ocp_qp_out *qp_out, ocp_qp_presolve_memory *mem);
+
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  // ACADOS_OCP_QP_OCP_QP_PRESOLVE_H_
@@ -36,6 +36,9 @@
 #include <assert.h>
 #include <string.h>
 #include <stdlib.h>
+#if defined(__unix__)
+#include <unistd.h>
+#endif
 
 // acados
 #include "acados/ocp_qp/ocp_qp_common.h"
@@ -211,6 +214,13 @@ void ocp_qp_xcond_solver_opts_initialize_default(void *config_, ocp_qp_xcond_sol
 
     // xcond solver opts
     ocp_qp_xcond_solver_opts *opts = (ocp_qp_xcond_solver_opts *) opts_;
+    opts->mat_dirty_tracking = 0;
+    opts->cond_N_auto = 0;
+    opts->cond_N_auto_calls = 3;
+    opts->cond_N = dims->orig_dims->N;  // no partial condensing by default
+    opts->num_cond_N_cand = 0;
+    opts->presolve = 0;
+    opts->presolve_tol = 0.0;
     // xcond opts
     xcond->opts_initialize_default(dims->xcond_dims, opts->xcond_opts);
     // qp solver opts
@@ -219,6 +229,146 @@ void ocp_qp_xcond_solver_opts_initialize_default(void *config_, ocp_qp_xcond_sol
 
 
 
+static double ocp_qp_xcond_solver_cache_size()
+{
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+    long cache_size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (cache_size > 0)
+        return (double) cache_size;
+#endif
+    return 256.0 * 1024.0;
+}
+
+
+
+// analytic cost of condensing + solving the qp with partial condensing horizon N2,
+// in flops scaled by the efficiency of the dense linear algebra on blocks of this size
+static double ocp_qp_xcond_solver_cond_N_cost(ocp_qp_dims *dims, int N2, double cache_size)
+{
+    int N = dims->N;
+
+    // average stage dimensions
+    double nx = 0.0, nu = 0.0, nb = 0.0, ng = 0.0;
+    for (int ii = 0; ii <= N; ii++)
+    {
+        nx += dims->nx[ii];
+        nu += dims->nu[ii];
+        nb += dims->nbx[ii];
+        ng += dims->ng[ii];
+    }
+    nx /= N + 1;
+    nu /= N + 1;
+    nb /= N + 1;
+    ng /= N + 1;
+
+    double M = (double) N / N2;  // stages per block
+    double nv = nx + M * nu;     // variables per block
+    double nc = M * (nb + ng);   // state bounds turn into general constraints
+
+    // condensing is quadratic in the block length
+    double flops_cond = N2 * M * M * (nx * nx * nu + nx * nu * nu + (nb + ng) * nx * nu);
+
+    // riccati recursion per ipm iteration is cubic in the block size
+    double flops_ric = N2 * (nv * nv * nv / 3.0 + nv * nv * nx + nx * nx * nx + nc * nv * nv);
+    double ipm_iter = 10.0;
+
+    // small blocks run far from peak, working sets exceeding the cache are memory bound
+    double efficiency = nv / (nv + 8.0);
+    if (8.0 * (nv + nx) * (nv + nx + nc) > cache_size)
+        efficiency *= 0.5;
+
+    // fixed overhead per stage of the condensed qp
+    double stage_overhead = 2000.0;
+
+    return (flops_cond + ipm_iter * flops_ric) / efficiency + N2 * stage_overhead;
+}
+
+
+
+// sort all horizons 1..N by model cost and keep the best ones as candidates
+static void ocp_qp_xcond_solver_cond_N_candidates(ocp_qp_dims *dims, ocp_qp_xcond_solver_opts *opts)
+{
+    int N = dims->N;
+    double cache_size = ocp_qp_xcond_solver_cache_size();
+
+    int num_cand = opts->cond_N_auto == 2 ? XCOND_SOLVER_N_CAND_MAX : 1;
+    if (num_cand > N)
+        num_cand = N;
+    if (num_cand < 1)
+        num_cand = 1;
+
+    opts->num_cond_N_cand = 0;
+    for (int N2 = 1; N2 <= N; N2++)
+    {
+        double cost = ocp_qp_xcond_solver_cond_N_cost(dims, N2, cache_size);
+
+        // insertion into the sorted candidate list
+        int jj = opts->num_cond_N_cand;
+        if (jj == num_cand)
+        {
+            if (cost >= opts->cond_N_cost[jj-1])
+                continue;
+            jj--;
+        }
+        else
+        {
+            opts->num_cond_N_cand++;
+        }
+        for (; jj > 0 && opts->cond_N_cost[jj-1] > cost; jj--)
+        {
+            opts->cond_N_cand[jj] = opts->cond_N_cand[jj-1];
+            opts->cond_N_cost[jj] = opts->cond_N_cost[jj-1];
+        }
+        opts->cond_N_cand[jj] = N2;
+        opts->cond_N_cost[jj] = cost;
+    }
+    if (opts->num_cond_N_cand == 0)
+    {
+        opts->num_cond_N_cand = 1;
+        opts->cond_N_cand[0] = N;
+        opts->cond_N_cost[0] = 0.0;
+    }
+
+    opts->cond_N = opts->cond_N_cand[0];
+}
+
+
+
+// set the horizon of the partially condensed qp in the given xcond dims and opts
+// NOTE: the qp solver opts do not depend on the dims of the condensed qp
+static void ocp_qp_xcond_solver_set_cond_N(ocp_qp_xcond_config *xcond, void *xcond_dims,
+                                           void *xcond_opts, int N2)
+{
+    xcond->opts_set(xcond_opts, "N", &N2);
+    xcond->opts_update(xcond_dims, xcond_opts);
+    // NOTE: the dimensions of the condensed qp are computed in memory_calculate_size
+    xcond->memory_calculate_size(xcond_dims, xcond_opts);
+}
+
+
+
+// copy the dims of a qp into the xcond dims
+static void ocp_qp_xcond_solver_copy_xcond_dims(ocp_qp_xcond_config *xcond, ocp_qp_dims *qp_dims,
+                                                void *xcond_dims)
+{
+    for (int ii = 0; ii <= qp_dims->N; ii++)
+    {
+        xcond->dims_set(xcond, xcond_dims, ii, "nx", &qp_dims->nx[ii]);
+        xcond->dims_set(xcond, xcond_dims, ii, "nu", &qp_dims->nu[ii]);
+        xcond->dims_set(xcond, xcond_dims, ii, "nbx", &qp_dims->nbx[ii]);
+        xcond->dims_set(xcond, xcond_dims, ii, "nbu", &qp_dims->nbu[ii]);
+        xcond->dims_set(xcond, xcond_dims, ii, "ng", &qp_dims->ng[ii]);
+        xcond->dims_set(xcond, xcond_dims, ii, "nsbx", &qp_dims->nsbx[ii]);
+        xcond->dims_set(xcond, xcond_dims, ii, "nsbu", &qp_dims->nsbu[ii]);
+        xcond->dims_set(xcond, xcond_dims, ii, "nsg", &qp_dims->nsg[ii]);
+        xcond->dims_set(xcond, xcond_dims, ii, "nbxe", &qp_dims->nbxe[ii]);
+        xcond->dims_set(xcond, xcond_dims, ii, "nbue", &qp_dims->nbue[ii]);
+        xcond->dims_set(xcond, xcond_dims, ii, "nge", &qp_dims->nge[ii]);
+    }
+}
+
+
+
 void ocp_qp_xcond_solver_opts_update(void *config_, ocp_qp_xcond_solver_dims *dims, void *opts_)
 {
     ocp_qp_xcond_solver_config *config = config_;
@@ -230,6 +380,12 @@ void ocp_qp_xcond_solver_opts_update(void *config_, ocp_qp_xcond_solver_dims *di
 
     // xcond solver opts
     ocp_qp_xcond_solver_opts *opts = (ocp_qp_xcond_solver_opts *) opts_;
+    if (opts->cond_N_auto)
+    {
+        if (opts->num_cond_N_cand == 0)
+            ocp_qp_xcond_solver_cond_N_candidates(dims->orig_dims, opts);
+        xcond->opts_set(opts->xcond_opts, "N", &opts->cond_N);
+    }
     // xcond opts
     xcond->opts_update(dims->xcond_dims, opts->xcond_opts);
     // qp solver opts
@@ -247,6 +403,43 @@ void ocp_qp_xcond_solver_opts_set_(void *config_, void *opts_, const char *field
 
     int ii;
 
+    if (!strcmp(field, "mat_dirty_tracking"))
+    {
+        int *tmp_ptr = value;
+        opts->mat_dirty_tracking = *tmp_ptr;
+        return;
+    }
+    else if (!strcmp(field, "cond_N_auto"))
+    {
+        int *tmp_ptr = value;
+        opts->cond_N_auto = *tmp_ptr;
+        opts->num_cond_N_cand = 0;  // recompute candidates in opts_update
+        return;
+    }
+    else if (!strcmp(field, "cond_N_auto_calls"))
+    {
+        int *tmp_ptr = value;
+        opts->cond_N_auto_calls = *tmp_ptr > 0 ? *tmp_ptr : 1;
+        return;
+    }
+    else if (!strcmp(field, "presolve"))
+    {
+        int *tmp_ptr = value;
+        opts->presolve = *tmp_ptr;
+        return;
+    }
+    else if (!strcmp(field, "presolve_tol"))
+    {
+        double *tmp_ptr = value;
+        opts->presolve_tol = *tmp_ptr;
+        return;
+    }
+    else if (!strcmp(field, "cond_N"))
+    {
+        int *tmp_ptr = value;
+        opts->cond_N = *tmp_ptr;
+    }
+
     char module[MAX_STR_LEN];
     char *ptr_module = NULL;
     int module_length = 0;
@@ -281,24 +474,70 @@ void ocp_qp_xcond_solver_opts_set_(void *config_, void *opts_, const char *field
  * memory
  ************************************************/
 
-int ocp_qp_xcond_solver_memory_calculate_size(void *config_, ocp_qp_xcond_solver_dims *dims, void *opts_)
+// size of xcond and qp solver memory, maximum over the candidate horizons with cond_N_auto
+static void ocp_qp_xcond_solver_sub_memory_size(void *config_, ocp_qp_xcond_solver_dims *dims,
+                                                ocp_qp_xcond_solver_opts *opts, int *xcond_size,
+                                                int *solver_size)
 {
     ocp_qp_xcond_solver_config *config = config_;
     qp_solver_config *qp_solver = config->qp_solver;
     ocp_qp_xcond_config *xcond = config->xcond;
 
+    // set up dimesions of partially condensed qp
+    void *xcond_qp_dims;
+    xcond->dims_get(xcond, dims->xcond_dims, "xcond_dims", &xcond_qp_dims);
+
+    *xcond_size = xcond->memory_calculate_size(dims->xcond_dims, opts->xcond_opts);
+    *solver_size = qp_solver->memory_calculate_size(qp_solver, xcond_qp_dims, opts->qp_solver_opts);
+
+    if (opts->cond_N_auto && opts->num_cond_N_cand > 1)
+    {
+        for (int ii = 0; ii < opts->num_cond_N_cand; ii++)
+        {
+            ocp_qp_xcond_solver_set_cond_N(xcond, dims->xcond_dims, opts->xcond_opts,
+                                           opts->cond_N_cand[ii]);
+
+            int tmp = xcond->memory_calculate_size(dims->xcond_dims, opts->xcond_opts);
+            *xcond_size = tmp > *xcond_size ? tmp : *xcond_size;
+            tmp = qp_solver->memory_calculate_size(qp_solver, xcond_qp_dims, opts->qp_solver_opts);
+            *solver_size = tmp > *solver_size ? tmp : *solver_size;
+        }
+        ocp_qp_xcond_solver_set_cond_N(xcond, dims->xcond_dims, opts->xcond_opts, opts->cond_N);
+    }
+
+    make_int_multiple_of(8, xcond_size);
+    make_int_multiple_of(8, solver_size);
+}
+
+
+
+int ocp_qp_xcond_solver_memory_calculate_size(void *config_, ocp_qp_xcond_solver_dims *dims, void *opts_)
+{
+    ocp_qp_xcond_solver_config *config = config_;
+    ocp_qp_xcond_config *xcond = config->xcond;
+
     ocp_qp_xcond_solver_opts *opts = (ocp_qp_xcond_solver_opts *) opts_;
 
     int size = 0;
     size += sizeof(ocp_qp_xcond_solver_memory);
 
-    // set up dimesions of partially condensed qp
-    void *xcond_qp_dims;
-    xcond->dims_get(xcond, dims->xcond_dims, "xcond_dims", &xcond_qp_dims);
+    // xcond dims and opts of this memory
+    size += xcond->dims_calculate_size(xcond, dims->orig_dims->N);
+    size += xcond->opts_calculate_size(dims->xcond_dims);
+
+    int xcond_size, solver_size;
+    ocp_qp_xcond_solver_sub_memory_size(config_, dims, opts, &xcond_size, &solver_size);
 
-    size += xcond->memory_calculate_size(dims->xcond_dims, opts->xcond_opts);
+    size += xcond_size;
 
-    size += qp_solver->memory_calculate_size(qp_solver, xcond_qp_dims, opts->qp_solver_opts);
+    size += solver_size;
+
+    size += (dims->orig_dims->N + 1) * sizeof(int);  // mat_dirty
+
+    if (opts->presolve)
+        size += ocp_qp_presolve_memory_calculate_size(dims->orig_dims);
+
+    size += 8;  // align
 
     return size;
 }
@@ -314,28 +553,76 @@ void *ocp_qp_xcond_solver_memory_assign(void *config_, ocp_qp_xcond_solver_dims
 
     ocp_qp_xcond_solver_opts *opts = (ocp_qp_xcond_solver_opts *) opts_;
 
-    char *c_ptr = (char *) raw_memory;
+    int N = dims->orig_dims->N;
 
-    // set up dimesions of partially condensed qp
-    void *xcond_qp_dims;
-    xcond->dims_get(xcond, dims->xcond_dims, "xcond_dims", &xcond_qp_dims);
+    char *c_ptr = (char *) raw_memory;
 
     ocp_qp_xcond_solver_memory *mem = (ocp_qp_xcond_solver_memory *) c_ptr;
     c_ptr += sizeof(ocp_qp_xcond_solver_memory);
 
     assert((size_t) c_ptr % 8 == 0 && "double not 8-byte aligned!");
 
-    mem->xcond_memory = xcond->memory_assign(dims->xcond_dims, opts->xcond_opts, c_ptr);
-    c_ptr += xcond->memory_calculate_size(dims->xcond_dims, opts->xcond_opts);
+    // xcond dims and opts of this memory, changing the horizon or the presolved dims only changes these
+    mem->xcond_dims = xcond->dims_assign(xcond, N, c_ptr);
+    c_ptr += xcond->dims_calculate_size(xcond, N);
+    ocp_qp_xcond_solver_copy_xcond_dims(xcond, dims->orig_dims, mem->xcond_dims);
+
+    int xcond_opts_size = xcond->opts_calculate_size(mem->xcond_dims);
+    mem->xcond_opts = xcond->opts_assign(mem->xcond_dims, c_ptr);
+    c_ptr += xcond_opts_size;
+    xcond->opts_copy(mem->xcond_dims, opts->xcond_opts, mem->xcond_opts);
+    // NOTE: the dimensions of the condensed qp are computed in memory_calculate_size
+    xcond->memory_calculate_size(mem->xcond_dims, mem->xcond_opts);
+
+    // set up dimesions of partially condensed qp
+    void *xcond_qp_dims;
+    xcond->dims_get(xcond, mem->xcond_dims, "xcond_dims", &xcond_qp_dims);
+
+    assert((size_t) c_ptr % 8 == 0 && "double not 8-byte aligned!");
+
+    int xcond_size, solver_size;
+    ocp_qp_xcond_solver_sub_memory_size(config_, dims, opts, &xcond_size, &solver_size);
+    mem->sub_memory = c_ptr;
+    mem->xcond_memory_size = xcond_size;
+    mem->sub_memory_size = xcond_size + solver_size;
+
+    mem->xcond_memory = xcond->memory_assign(mem->xcond_dims, mem->xcond_opts, c_ptr);
+    c_ptr += xcond_size;
 
     assert((size_t) c_ptr % 8 == 0 && "double not 8-byte aligned!");
 
     mem->solver_memory = qp_solver->memory_assign(qp_solver, xcond_qp_dims, opts->qp_solver_opts, c_ptr);
-    c_ptr += qp_solver->memory_calculate_size(qp_solver, xcond_qp_dims, opts->qp_solver_opts);
+    c_ptr += solver_size;
 
     xcond->memory_get(xcond, mem->xcond_memory, "xcond_qp_in", &mem->xcond_qp_in);
     xcond->memory_get(xcond, mem->xcond_memory, "xcond_qp_out", &mem->xcond_qp_out);
 
+    assign_and_advance_int(N + 1, &mem->mat_dirty, &c_ptr);
+    for (int ii = 0; ii <= N; ii++)
+        mem->mat_dirty[ii] = 1;
+    mem->last_qp_in = NULL;
+    mem->num_cond_skip = 0;
+
+    mem->cond_N = opts->cond_N;
+    mem->num_cond_N_cand = opts->cond_N_auto ? opts->num_cond_N_cand : 0;
+    for (int ii = 0; ii < mem->num_cond_N_cand; ii++)
+    {
+        mem->cond_N_cand[ii] = opts->cond_N_cand[ii];
+        mem->cond_N_time[ii] = 0.0;
+    }
+    mem->cond_N_tune_idx = opts->cond_N_auto == 2 ? 0 : mem->num_cond_N_cand;
+    mem->cond_N_tune_calls = 0;
+
+    align_char_to(8, &c_ptr);
+    mem->presolve = NULL;
+    if (opts->presolve)
+    {
+        mem->presolve = ocp_qp_presolve_memory_assign(dims->orig_dims, c_ptr);
+        c_ptr += ocp_qp_presolve_memory_calculate_size(dims->orig_dims);
+    }
+
+    mem->work_size = ocp_qp_xcond_solver_workspace_calculate_size(config_, dims, opts_);
+
     assert((char *) raw_memory + ocp_qp_xcond_solver_memory_calculate_size(config_, dims, opts_) >= c_ptr);
 
     return mem;
@@ -361,10 +648,71 @@ void ocp_qp_xcond_solver_memory_get(void *config_, void *mem_, const char *field
     {
         qp_solver->memory_get(qp_solver, mem->solver_memory, field, value);
     }
+    else if (!strcmp(field, "res_single") || !strcmp(field, "res_mixed") ||
+             !strcmp(field, "itref_mixed_iter"))
+    {
+        // mixed precision accuracy report of the qp solver
+        qp_solver->memory_get(qp_solver, mem->solver_memory, field, value);
+    }
+    else if (!strcmp(field, "P_nnz_changed") || !strcmp(field, "A_nnz_changed"))
+    {
+        // matrix nonzeros passed to the qp solver as an update (osqp)
+        qp_solver->memory_get(qp_solver, mem->solver_memory, field, value);
+    }
+    else if (!strcmp(field, "qp_init") || !strcmp(field, "num_qp_init"))
+    {
+        // initializations of the qp solver, as opposed to hotstarts (qpoases)
+        qp_solver->memory_get(qp_solver, mem->solver_memory, field, value);
+    }
     else if (!strcmp(field, "time_qp_xcond"))
     {
         xcond->memory_get(xcond, mem->xcond_memory, field, value);
     }
+    else if (!strcmp(field, "num_cond_skip"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->num_cond_skip;
+    }
+    else if (!strcmp(field, "cond_N"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->cond_N;
+    }
+    else if (!strcmp(field, "cond_N_num_cand"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->num_cond_N_cand;
+    }
+    else if (!strcmp(field, "cond_N_cand"))
+    {
+        int *tmp_ptr = value;
+        for (int ii = 0; ii < mem->num_cond_N_cand; ii++)
+            tmp_ptr[ii] = mem->cond_N_cand[ii];
+    }
+    else if (!strcmp(field, "cond_N_time"))
+    {
+        // mean time per call of the candidates, 0 if not timed (yet)
+        double *tmp_ptr = value;
+        for (int ii = 0; ii < mem->num_cond_N_cand; ii++)
+            tmp_ptr[ii] = mem->cond_N_time[ii];
+    }
+    else if (!strcmp(field, "presolve_nu_fixed") || !strcmp(field, "presolve_nb_removed") ||
+             !strcmp(field, "presolve_ng_removed") || !strcmp(field, "presolve_num_update"))
+    {
+        // size of the last presolve reduction, 0 if presolve is off
+        int *tmp_ptr = value;
+        ocp_qp_presolve_memory *pre = mem->presolve;
+        if (pre == NULL)
+            *tmp_ptr = 0;
+        else if (!strcmp(field, "presolve_nu_fixed"))
+            *tmp_ptr = pre->nu_fixed;
+        else if (!strcmp(field, "presolve_nb_removed"))
+            *tmp_ptr = pre->nb_removed;
+        else if (!strcmp(field, "presolve_ng_removed"))
+            *tmp_ptr = pre->ng_removed;
+        else
+            *tmp_ptr = pre->num_update;
+    }
     else
     {
         printf("\nerror: ocp_qp_xcond_solver_memory_get: field %s not available\n", field);
@@ -377,6 +725,33 @@ void ocp_qp_xcond_solver_memory_get(void *config_, void *mem_, const char *field
 
 
 
+void ocp_qp_xcond_solver_memory_set(void *config_, void *mem_, const char *field, void* value)
+{
+    ocp_qp_xcond_solver_memory *mem = mem_;
+
+    if (!strcmp(field, "mat_dirty"))
+    {
+        // mark the matrices of one stage of qp_in as changed
+        int *stage = value;
+        mem->mat_dirty[*stage] = 1;
+    }
+    else if (!strcmp(field, "mat_dirty_all"))
+    {
+        // mark the matrices of all stages of qp_in as changed, value is ignored
+        // NOTE: forgetting the last qp_in forces the next call to condense the matrices
+        mem->last_qp_in = NULL;
+    }
+    else
+    {
+        printf("\nerror: ocp_qp_xcond_solver_memory_set: field %s not available\n", field);
+        exit(1);
+    }
+
+    return;
+}
+
+
+
 /************************************************
  * workspace
  ************************************************/
@@ -400,13 +775,28 @@ int ocp_qp_xcond_solver_workspace_calculate_size(void *config_, ocp_qp_xcond_sol
 
     size += qp_solver->workspace_calculate_size(qp_solver, xcond_qp_dims, opts->qp_solver_opts);
 
+    // workspace for the largest candidate horizon
+    if (opts->cond_N_auto && opts->num_cond_N_cand > 1)
+    {
+        for (int ii = 0; ii < opts->num_cond_N_cand; ii++)
+        {
+            ocp_qp_xcond_solver_set_cond_N(xcond, dims->xcond_dims, opts->xcond_opts,
+                                           opts->cond_N_cand[ii]);
+
+            int tmp = sizeof(ocp_qp_xcond_solver_workspace);
+            tmp += xcond->workspace_calculate_size(dims->xcond_dims, opts->xcond_opts);
+            tmp += qp_solver->workspace_calculate_size(qp_solver, xcond_qp_dims, opts->qp_solver_opts);
+            size = tmp > size ? tmp : size;
+        }
+        ocp_qp_xcond_solver_set_cond_N(xcond, dims->xcond_dims, opts->xcond_opts, opts->cond_N);
+    }
+
     return size;
 }
 
 
 
-static void cast_workspace(void *config_, ocp_qp_xcond_solver_dims *dims,
-                           ocp_qp_xcond_solver_opts *opts,
+static void cast_workspace(void *config_, ocp_qp_xcond_solver_opts *opts,
                            ocp_qp_xcond_solver_memory *mem,
                            ocp_qp_xcond_solver_workspace *work)
 {
@@ -416,19 +806,19 @@ static void cast_workspace(void *config_, ocp_qp_xcond_solver_dims *dims,
 
     // set up dimesions of  condensed qp
     void *xcond_qp_dims;
-    xcond->dims_get(xcond, dims->xcond_dims, "xcond_dims", &xcond_qp_dims);
+    xcond->dims_get(xcond, mem->xcond_dims, "xcond_dims", &xcond_qp_dims);
 
     char *c_ptr = (char *) work;
 
     c_ptr += sizeof(ocp_qp_xcond_solver_workspace);
 
     work->xcond_work = c_ptr;
-    c_ptr += xcond->workspace_calculate_size(dims->xcond_dims, opts->xcond_opts);
+    c_ptr += xcond->workspace_calculate_size(mem->xcond_dims, mem->xcond_opts);
 
     work->qp_solver_work = c_ptr;
     c_ptr += qp_solver->workspace_calculate_size(qp_solver, xcond_qp_dims, opts->qp_solver_opts);
 
-    assert((char *) work + config->workspace_calculate_size(config_, dims, opts) >= c_ptr);
+    assert((char *) work + mem->work_size >= c_ptr);
 }
 
 
@@ -437,6 +827,105 @@ static void cast_workspace(void *config_, ocp_qp_xcond_solver_dims *dims,
  * functions
  ************************************************/
 
+// re-assign xcond and qp solver memory after a change of the condensed dims
+static void ocp_qp_xcond_solver_reassign_sub_memory(void *config_, ocp_qp_xcond_solver_opts *opts,
+                                                    ocp_qp_xcond_solver_memory *mem)
+{
+    ocp_qp_xcond_solver_config *config = config_;
+    qp_solver_config *qp_solver = config->qp_solver;
+    ocp_qp_xcond_config *xcond = config->xcond;
+
+    void *xcond_qp_dims;
+    xcond->dims_get(xcond, mem->xcond_dims, "xcond_dims", &xcond_qp_dims);
+
+    char *c_ptr = mem->sub_memory;
+    memset(c_ptr, 0, mem->sub_memory_size);
+
+    mem->xcond_memory = xcond->memory_assign(mem->xcond_dims, mem->xcond_opts, c_ptr);
+    c_ptr += mem->xcond_memory_size;
+
+    mem->solver_memory = qp_solver->memory_assign(qp_solver, xcond_qp_dims, opts->qp_solver_opts, c_ptr);
+
+    xcond->memory_get(xcond, mem->xcond_memory, "xcond_qp_in", &mem->xcond_qp_in);
+    xcond->memory_get(xcond, mem->xcond_memory, "xcond_qp_out", &mem->xcond_qp_out);
+
+    // NOTE: the qp solver memory and the condensed qp_out are cleared,
+    // the next call starts from the zero initial guess of a cold start also with warm_start
+    mem->last_qp_in = NULL;
+}
+
+
+
+// switch the horizon of the partially condensed qp, reusing the memory sized for all candidates
+static void ocp_qp_xcond_solver_switch_cond_N(void *config_, ocp_qp_xcond_solver_opts *opts,
+                                              ocp_qp_xcond_solver_memory *mem, int N2)
+{
+    ocp_qp_xcond_solver_config *config = config_;
+
+    ocp_qp_xcond_solver_set_cond_N(config->xcond, mem->xcond_dims, mem->xcond_opts, N2);
+    ocp_qp_xcond_solver_reassign_sub_memory(config_, opts, mem);
+
+    mem->cond_N = N2;
+}
+
+
+
+// condense the presolved qp: its dims replace the original ones in the xcond dims of the memory,
+// the memory sized for the original dims is reused
+static void ocp_qp_xcond_solver_presolve_update(void *config_, ocp_qp_xcond_solver_opts *opts,
+                                                ocp_qp_xcond_solver_memory *mem)
+{
+    ocp_qp_xcond_solver_config *config = config_;
+    ocp_qp_xcond_config *xcond = config->xcond;
+
+    ocp_qp_xcond_solver_copy_xcond_dims(xcond, mem->presolve->red_dims, mem->xcond_dims);
+
+    // NOTE: the dimensions of the condensed qp are computed in opts_calculate_size (full condensing)
+    // and memory_calculate_size (partial condensing)
+    xcond->opts_calculate_size(mem->xcond_dims);
+    xcond->opts_update(mem->xcond_dims, mem->xcond_opts);
+    xcond->memory_calculate_size(mem->xcond_dims, mem->xcond_opts);
+
+    ocp_qp_xcond_solver_reassign_sub_memory(config_, opts, mem);
+}
+
+
+
+// record the time of a call and move on to the next candidate, or the fastest one when done
+static void ocp_qp_xcond_solver_tune_cond_N(void *config_, ocp_qp_xcond_solver_opts *opts,
+                                            ocp_qp_xcond_solver_memory *mem, double time)
+{
+    int idx = mem->cond_N_tune_idx;
+
+    mem->cond_N_time[idx] += time / opts->cond_N_auto_calls;
+    mem->cond_N_tune_calls++;
+
+    if (mem->cond_N_tune_calls < opts->cond_N_auto_calls)
+        return;
+
+    mem->cond_N_tune_calls = 0;
+    idx++;
+    mem->cond_N_tune_idx = idx;
+
+    int N2;
+    if (idx < mem->num_cond_N_cand)
+    {
+        N2 = mem->cond_N_cand[idx];
+    }
+    else
+    {
+        int idx_min = 0;
+        for (int ii = 1; ii < mem->num_cond_N_cand; ii++)
+            if (mem->cond_N_time[ii] < mem->cond_N_time[idx_min])
+                idx_min = ii;
+        N2 = mem->cond_N_cand[idx_min];
+    }
+
+    if (N2 != mem->cond_N)
+        ocp_qp_xcond_solver_switch_cond_N(config_, opts, mem, N2);
+}
+
+
 int ocp_qp_xcond_solver(void *config_, ocp_qp_xcond_solver_dims *dims, ocp_qp_in *qp_in, ocp_qp_out *qp_out,
                                      void *opts_, void *mem_, void *work_)
 {
@@ -454,13 +943,53 @@ int ocp_qp_xcond_solver(void *config_, ocp_qp_xcond_solver_dims *dims, ocp_qp_in
     ocp_qp_xcond_solver_workspace *work = work_;
 
     // cast workspace
-    cast_workspace(config_, dims, opts, memory, work);
+    cast_workspace(config_, opts, memory, work);
 
     int solver_status = ACADOS_SUCCESS;
 
-    // condensing
+    int N = dims->orig_dims->N;
+
     acados_tic(&cond_timer);
-    xcond->condensing(qp_in, memory->xcond_qp_in, opts->xcond_opts, memory->xcond_memory, work->xcond_work);
+
+    // presolve, the condensing works on the presolved qp
+    ocp_qp_in *xcond_in = qp_in;
+    ocp_qp_out *xcond_out = qp_out;
+    if (opts->presolve)
+    {
+        if (memory->presolve == NULL)
+        {
+            printf("\nerror: ocp_qp_xcond_solver: presolve set after the memory was created\n");
+            exit(1);
+        }
+        if (ocp_qp_presolve_structure(qp_in, opts->presolve_tol, memory->presolve))
+        {
+            ocp_qp_xcond_solver_presolve_update(config_, opts, memory);
+            cast_workspace(config_, opts, memory, work);
+        }
+        ocp_qp_presolve(qp_in, memory->presolve);
+        xcond_in = memory->presolve->red_qp_in;
+        xcond_out = memory->presolve->red_qp_out;
+    }
+
+    // matrices of the condensed qp can be reused if they come from this qp_in and no stage changed
+    // NOTE: the matrices of the presolved qp only depend on the matrices of qp_in
+    int mat_dirty = !opts->mat_dirty_tracking || memory->last_qp_in != qp_in;
+    for (int ii = 0; ii <= N && !mat_dirty; ii++)
+        mat_dirty = memory->mat_dirty[ii];
+
+    // condensing
+    if (mat_dirty)
+    {
+        xcond->condensing(xcond_in, memory->xcond_qp_in, memory->xcond_opts, memory->xcond_memory, work->xcond_work);
+        for (int ii = 0; ii <= N; ii++)
+            memory->mat_dirty[ii] = 0;
+        memory->last_qp_in = qp_in;
+    }
+    else
+    {
+        xcond->condensing_rhs(xcond_in, memory->xcond_qp_in, memory->xcond_opts, memory->xcond_memory, work->xcond_work);
+        memory->num_cond_skip++;
+    }
     info->condensing_time = acados_toc(&cond_timer);
 
     // solve qp
@@ -469,7 +998,7 @@ int ocp_qp_xcond_solver(void *config_, ocp_qp_xcond_solver_dims *dims, ocp_qp_in
 
     // expansion
     acados_tic(&cond_timer);
-    xcond->expansion(memory->xcond_qp_out, qp_out, opts->xcond_opts, memory->xcond_memory, work->xcond_work);
+    xcond->expansion(memory->xcond_qp_out, xcond_out, memory->xcond_opts, memory->xcond_memory, work->xcond_work);
     info->condensing_time += acados_toc(&cond_timer);
 
     // output qp info
@@ -481,6 +1010,20 @@ int ocp_qp_xcond_solver(void *config_, ocp_qp_xcond_solver_dims *dims, ocp_qp_in
     info->interface_time = info_mem->interface_time;
     info->num_iter = info_mem->num_iter;
     info->t_computed = info_mem->t_computed;
+    info->num_cond_skip = memory->num_cond_skip;
+
+    // postsolve, sets t_computed
+    if (opts->presolve)
+    {
+        acados_tic(&cond_timer);
+        ocp_qp_postsolve(qp_in, qp_out, memory->presolve);
+        info->condensing_time += acados_toc(&cond_timer);
+        info->total_time = acados_toc(&tot_timer);
+    }
+
+    // time the candidate horizons during the first calls
+    if (opts->cond_N_auto == 2 && memory->cond_N_tune_idx < memory->num_cond_N_cand)
+        ocp_qp_xcond_solver_tune_cond_N(config_, opts, memory, info->total_time);
 
     return solver_status;
 }
@@ -504,12 +1047,22 @@ void ocp_qp_xcond_solver_eval_sens(void *config_, ocp_qp_xcond_solver_dims *dims
     ocp_qp_xcond_solver_workspace *work = work_;
 
     // cast workspace
-    cast_workspace(config_, dims, opts, memory, work);
+    cast_workspace(config_, opts, memory, work);
 
 
+    // presolve with the structure detected in the last call
+    ocp_qp_in *xcond_in = param_qp_in;
+    ocp_qp_out *xcond_out = sens_qp_out;
+    if (opts->presolve)
+    {
+        ocp_qp_presolve(param_qp_in, memory->presolve);
+        xcond_in = memory->presolve->red_qp_in;
+        xcond_out = memory->presolve->red_qp_out;
+    }
+
     // condensing
 //    acados_tic(&cond_timer);
-    xcond->condensing_rhs(param_qp_in, memory->xcond_qp_in, opts->xcond_opts, memory->xcond_memory, work->xcond_work);
+    xcond->condensing_rhs(xcond_in, memory->xcond_qp_in, memory->xcond_opts, memory->xcond_memory, work->xcond_work);
 //    info->condensing_time = acados_toc(&cond_timer);
 
     // qp evaluate sensitivity
@@ -517,9 +1070,12 @@ void ocp_qp_xcond_solver_eval_sens(void *config_, ocp_qp_xcond_solver_dims *dims
 
     // expansion
 //    acados_tic(&cond_timer);
-    xcond->expansion(memory->xcond_qp_out, sens_qp_out, opts->xcond_opts, memory->xcond_memory, work->xcond_work);
+    xcond->expansion(memory->xcond_qp_out, xcond_out, memory->xcond_opts, memory->xcond_memory, work->xcond_work);
 //    info->condensing_time += acados_toc(&cond_timer);
 
+    if (opts->presolve)
+        ocp_qp_postsolve(param_qp_in, sens_qp_out, memory->presolve);
+
     // output qp info
 //    qp_info *info_mem;
 //    xcond->memory_get(xcond, memory->xcond_memory, "qp_out_info", &info_mem);
@@ -551,6 +1107,7 @@ void ocp_qp_xcond_solver_config_initialize_default(void *config_)
     config->memory_calculate_size = &ocp_qp_xcond_solver_memory_calculate_size;
     config->memory_assign = &ocp_qp_xcond_solver_memory_assign;
     config->memory_get = &ocp_qp_xcond_solver_memory_get;
+    config->memory_set = &ocp_qp_xcond_solver_memory_set;
     config->workspace_calculate_size = &ocp_qp_xcond_solver_workspace_calculate_size;
     config->evaluate = &ocp_qp_xcond_solver;
     config->eval_sens = &ocp_qp_xcond_solver_eval_sens;
@@ -558,3 +1115,147 @@ void ocp_qp_xcond_solver_config_initialize_default(void *config_)
     return;
 }
 
+
+
+/************************************************
+ * batch
+ ************************************************/
+
+int ocp_qp_xcond_solver_batch_memory_calculate_size(void *config_, ocp_qp_xcond_solver_dims *dims,
+                                                    void *opts_, int n_batch, int num_threads)
+{
+    ocp_qp_xcond_solver_config *config = config_;
+
+    int size = sizeof(ocp_qp_xcond_solver_batch_memory);
+
+    size += 2 * n_batch * sizeof(void *);  // mem, work
+    size += n_batch * sizeof(int);  // status
+    size += n_batch * sizeof(double);  // time
+
+    size += acados_thread_pool_calculate_size(num_threads, n_batch);
+
+    // memory and workspace of each instance
+    int mem_size = config->memory_calculate_size(config_, dims, opts_);
+    int work_size = config->workspace_calculate_size(config_, dims, opts_);
+    make_int_multiple_of(8, &mem_size);
+    make_int_multiple_of(8, &work_size);
+    size += n_batch * (mem_size + work_size);
+
+    size += 2 * 8;  // align
+
+    return size;
+}
+
+
+
+void *ocp_qp_xcond_solver_batch_memory_assign(void *config_, ocp_qp_xcond_solver_dims *dims,
+                                              void *opts_, int n_batch, int num_threads,
+                                              void *raw_memory)
+{
+    ocp_qp_xcond_solver_config *config = config_;
+
+    char *c_ptr = (char *) raw_memory;
+
+    ocp_qp_xcond_solver_batch_memory *mem = (ocp_qp_xcond_solver_batch_memory *) c_ptr;
+    c_ptr += sizeof(ocp_qp_xcond_solver_batch_memory);
+
+    mem->n_batch = n_batch;
+
+    mem->mem = (void **) c_ptr;
+    c_ptr += n_batch * sizeof(void *);
+    mem->work = (void **) c_ptr;
+    c_ptr += n_batch * sizeof(void *);
+
+    align_char_to(8, &c_ptr);
+    assign_and_advance_double(n_batch, &mem->time, &c_ptr);
+    assign_and_advance_int(n_batch, &mem->status, &c_ptr);
+
+    mem->pool = acados_thread_pool_assign(num_threads, n_batch, c_ptr);
+    c_ptr += acados_thread_pool_calculate_size(num_threads, n_batch);
+    // instances take different numbers of iterations, let the threads take the next free one
+    acados_thread_pool_configure(mem->pool, ACADOS_SCHEDULE_DYNAMIC, 10000, NULL);
+
+    align_char_to(8, &c_ptr);
+
+    int mem_size = config->memory_calculate_size(config_, dims, opts_);
+    int work_size = config->workspace_calculate_size(config_, dims, opts_);
+    make_int_multiple_of(8, &mem_size);
+    make_int_multiple_of(8, &work_size);
+
+    for (int ii = 0; ii < n_batch; ii++)
+    {
+        mem->mem[ii] = config->memory_assign(config_, dims, opts_, c_ptr);
+        c_ptr += mem_size;
+
+        mem->work[ii] = c_ptr;
+        c_ptr += work_size;
+
+        mem->status[ii] = ACADOS_SUCCESS;
+        mem->time[ii] = 0.0;
+    }
+
+    assert((char *) raw_memory + ocp_qp_xcond_solver_batch_memory_calculate_size(config_, dims,
+           opts_, n_batch, num_threads) >= c_ptr);
+
+    return mem;
+}
+
+
+
+void ocp_qp_xcond_solver_batch_memory_terminate(void *batch_mem_)
+{
+    ocp_qp_xcond_solver_batch_memory *mem = batch_mem_;
+
+    acados_thread_pool_stop(mem->pool);
+}
+
+
+
+typedef struct
+{
+    ocp_qp_xcond_solver_config *config;
+    ocp_qp_xcond_solver_dims *dims;
+    ocp_qp_in **qp_in;
+    ocp_qp_out **qp_out;
+    void *opts;
+    ocp_qp_xcond_solver_batch_memory *mem;
+} ocp_qp_xcond_solver_batch_args;
+
+
+
+static void ocp_qp_xcond_solver_batch_instance(void *args_, int ii)
+{
+    ocp_qp_xcond_solver_batch_args *args = args_;
+    ocp_qp_xcond_solver_batch_memory *mem = args->mem;
+
+    mem->status[ii] = args->config->evaluate(args->config, args->dims, args->qp_in[ii],
+                            args->qp_out[ii], args->opts, mem->mem[ii], mem->work[ii]);
+}
+
+
+
+int ocp_qp_xcond_solver_batch(void *config_, ocp_qp_xcond_solver_dims *dims, ocp_qp_in **qp_in,
+                              ocp_qp_out **qp_out, int n_batch, void *opts_, void *batch_mem_)
+{
+    ocp_qp_xcond_solver_batch_memory *mem = batch_mem_;
+
+    if (n_batch > mem->n_batch)
+    {
+        printf("\nerror: ocp_qp_xcond_solver_batch: n_batch = %d, memory allocated for %d\n",
+               n_batch, mem->n_batch);
+        exit(1);
+    }
+
+    // every instance has its own memory and workspace, the results do not depend on the threads
+    ocp_qp_xcond_solver_batch_args args = {config_, dims, qp_in, qp_out, opts_, mem};
+    acados_thread_pool_parallel_for_balanced(mem->pool, n_batch,
+                                             &ocp_qp_xcond_solver_batch_instance, &args, mem->time);
+
+    for (int ii = 0; ii < n_batch; ii++)
+    {
+        if (mem->status[ii] != ACADOS_SUCCESS)
+            return mem->status[ii];
+    }
+
+    return ACADOS_SUCCESS;
+}
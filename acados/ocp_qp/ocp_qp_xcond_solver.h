@@ -41,10 +41,17 @@ extern "C" {
 
 // acados
 #include "acados/ocp_qp/ocp_qp_common.h"
+#include "acados/ocp_qp/ocp_qp_presolve.h"
+#include "acados/utils/threads.h"
 #include "acados/utils/types.h"
 
 
 
+// maximum number of candidate horizons timed by cond_N_auto
+#define XCOND_SOLVER_N_CAND_MAX 4
+
+
+
 typedef struct
 {
     ocp_qp_dims *orig_dims;
@@ -57,16 +64,41 @@ typedef struct ocp_qp_xcond_solver_opts_
 {
     void *xcond_opts;
     void *qp_solver_opts;
+    int mat_dirty_tracking;  // condense only the vectors if no stage is marked as mat_dirty
+    int cond_N_auto;         // 0: user-defined cond_N, 1: cost model, 2: cost model + timing of the first calls
+    int cond_N_auto_calls;   // number of calls timed per candidate with cond_N_auto = 2
+    int cond_N;              // horizon of the partially condensed qp, the first candidate with cond_N_auto
+    int num_cond_N_cand;     // number of candidate horizons, 0 if not computed yet
+    int cond_N_cand[XCOND_SOLVER_N_CAND_MAX];      // candidate horizons, sorted by model cost
+    double cond_N_cost[XCOND_SOLVER_N_CAND_MAX];   // model cost of the candidates
+    int presolve;            // remove fixed inputs, free bounds and duplicate constraints before condensing
+    double presolve_tol;     // inputs with ub - lb <= presolve_tol are fixed
 } ocp_qp_xcond_solver_opts;
 
 
 
 typedef struct ocp_qp_xcond_solver_memory_
 {
+    void *xcond_dims;     // xcond dims of this memory, with the current horizon and presolved dims
+    void *xcond_opts;     // xcond opts of this memory, copied from opts in memory_assign
     void *xcond_memory;
     void *solver_memory;
     void *xcond_qp_in;
     void *xcond_qp_out;
+    int *mat_dirty;       // per stage, matrices changed since the last condensing
+    void *last_qp_in;     // qp_in of the last condensing
+    int num_cond_skip;    // number of calls that reused the condensed matrices
+    char *sub_memory;     // xcond and qp solver memory, sized for the largest candidate horizon
+    int xcond_memory_size;
+    int sub_memory_size;
+    int work_size;        // workspace size for the largest candidate horizon
+    int cond_N;           // current horizon of the partially condensed qp
+    int num_cond_N_cand;
+    int cond_N_cand[XCOND_SOLVER_N_CAND_MAX];
+    int cond_N_tune_idx;  // candidate currently timed, num_cond_N_cand when tuning is done
+    int cond_N_tune_calls;
+    double cond_N_time[XCOND_SOLVER_N_CAND_MAX];  // mean time per call of the candidates
+    ocp_qp_presolve_memory *presolve;  // NULL if presolve is off
 } ocp_qp_xcond_solver_memory;
 
 
@@ -79,6 +111,21 @@ typedef struct ocp_qp_xcond_solver_workspace_
 
 
 
+// memory to solve a batch of qps with the same dims and opts
+// NOTE: the instances only share the dims and opts, the horizon chosen with cond_N_auto and the
+// presolved dims are kept in the memory of each instance
+typedef struct ocp_qp_xcond_solver_batch_memory_
+{
+    void **mem;      // xcond solver memory of each instance
+    void **work;     // xcond solver workspace of each instance
+    int *status;     // status of each instance in the last call
+    double *time;    // recorded solve time of each instance, used to balance the threads
+    acados_thread_pool *pool;
+    int n_batch;
+} ocp_qp_xcond_solver_batch_memory;
+
+
+
 typedef struct
 {
     int (*dims_calculate_size)(void *config, int N);
@@ -92,6 +139,7 @@ typedef struct
     int (*memory_calculate_size)(void *config, ocp_qp_xcond_solver_dims *dims, void *opts);
     void *(*memory_assign)(void *config, ocp_qp_xcond_solver_dims *dims, void *opts, void *raw_memory);
     void (*memory_get)(void *config_, void *mem_, const char *field, void* value);
+    void (*memory_set)(void *config_, void *mem_, const char *field, void* value);
     int (*workspace_calculate_size)(void *config, ocp_qp_xcond_solver_dims *dims, void *opts);
     int (*evaluate)(void *config, ocp_qp_xcond_solver_dims *dims, ocp_qp_in *qp_in, ocp_qp_out *qp_out, void *opts, void *mem, void *work);
     void (*eval_sens)(void *config, ocp_qp_xcond_solver_dims *dims, ocp_qp_in *param_qp_in, ocp_qp_out *sens_qp_out, void *opts, void *mem, void *work);
@@ -132,6 +180,8 @@ void ocp_qp_xcond_solver_opts_set_(void *config_, void *opts_, const char *field
 int ocp_qp_xcond_solver_memory_calculate_size(void *config, ocp_qp_xcond_solver_dims *dims, void *opts_);
 //
 void *ocp_qp_xcond_solver_memory_assign(void *config, ocp_qp_xcond_solver_dims *dims, void *opts_, void *raw_memory);
+//
+void ocp_qp_xcond_solver_memory_set(void *config_, void *mem_, const char *field, void* value);
 
 /* workspace */
 //
@@ -144,6 +194,20 @@ int ocp_qp_xcond_solver(void *config, ocp_qp_xcond_solver_dims *dims, ocp_qp_in
 //
 void ocp_qp_xcond_solver_config_initialize_default(void *config_);
 
+/* batch */
+//
+int ocp_qp_xcond_solver_batch_memory_calculate_size(void *config, ocp_qp_xcond_solver_dims *dims,
+                                                    void *opts_, int n_batch, int num_threads);
+//
+void *ocp_qp_xcond_solver_batch_memory_assign(void *config, ocp_qp_xcond_solver_dims *dims,
+                                              void *opts_, int n_batch, int num_threads,
+                                              void *raw_memory);
+// joins the threads of the batch memory
+void ocp_qp_xcond_solver_batch_memory_terminate(void *batch_mem_);
+// solves n_batch qps in parallel, returns the first nonzero status of the instances
+int ocp_qp_xcond_solver_batch(void *config, ocp_qp_xcond_solver_dims *dims, ocp_qp_in **qp_in,
+                              ocp_qp_out **qp_out, int n_batch, void *opts_, void *batch_mem_);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
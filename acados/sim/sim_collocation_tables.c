@@ -0,0 +1,661 @@
+/*
+ * Copyright 2019 Gianluca Frison, Dimitris Kouzoupis, Robin Verschueren,
+ * Andrea Zanelli, Niels van Duijkeren, Jonathan Frey, Tommaso Sartor,
+ * Branimir Novoselnik, Rien Quirynen, Rezart Qelibari, Dang Doan,
+ * Jonas Koenemann, Yutao Chen, Tobias Schöls, Jonas Schlagenhauf, Moritz Diehl
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+// Transformations for the simplified Newton scheme of Gauss-Legendre collocation, formerly
+// shipped as acados/sim/simplified/GL<2*ns>_simpl_{T,D}.txt. The tables are stored row-major,
+// one table row per line, for ns = 2, ..., NS_MAX stages.
+
+#include "acados/sim/sim_collocation_tables.h"
+
+#include <stddef.h>
+
+#include "acados/sim/sim_common.h"
+
+
+
+static const double gauss_simplified_T2[4] = {
+    9.6592582628906842e-01, 0.0000000000000000e+00,
+    -6.6359915501009627e-17, -2.5881904510252079e-01,
+};
+
+static const double gauss_simplified_D2[4] = {
+    2.9999999999999996e+00, 1.7320508075688772e+00,
+    -1.7320508075688772e+00, 2.9999999999999996e+00,
+};
+
+static const double gauss_simplified_T3[9] = {
+    -9.4780144954483625e-01, 0.0000000000000000e+00, 9.9047432157564597e-01,
+    -5.0295169925554134e-02, 2.9969960581658434e-01, 1.1770061780985283e-01,
+    7.7948357550038094e-02, -5.6982523211086947e-02, 7.1464556714800287e-02,
+};
+
+static const double gauss_simplified_D3[6] = {
+    3.6778146453739247e+00, 3.5087619195674487e+00,
+    -3.5087619195674487e+00, 3.6778146453739247e+00,
+    4.6443707092521676e+00, 0.0000000000000000e+00,
+};
+
+static const double gauss_simplified_T4[16] = {
+    9.2755121578442024e-01, 0.0000000000000000e+00, 9.7688646208845364e-01, 0.0000000000000000e+00,
+    8.9973980766129363e-02, -3.3944980848817574e-01, 1.7926761499828683e-01, -1.0940228267310095e-01,
+    -1.1347923253170784e-01, 3.6496686603583427e-02, 2.7865866968752602e-02, -1.1762625061477404e-02,
+    4.5676938944744824e-02, 5.5969008293203868e-03, -1.2056498009687994e-02, -2.2953821305620972e-02,
+};
+
+static const double gauss_simplified_D4[8] = {
+    4.2075787943592218e+00, 5.3148360837135682e+00,
+    -5.3148360837135682e+00, 4.2075787943592218e+00,
+    5.7924212056407534e+00, 1.7344682578688573e+00,
+    -1.7344682578688573e+00, 5.7924212056407534e+00,
+};
+
+static const double gauss_simplified_T5[25] = {
+    9.0411743519846155e-01, 0.0000000000000000e+00, 9.5735008970684399e-01, 0.0000000000000000e+00,
+    9.6857461611736728e-01,
+    1.3001130604337371e-01, -3.7516554615897674e-01, 2.2355134850458269e-01, -1.7841467946953624e-01,
+    2.4484872919812409e-01,
+    -1.4426917672856002e-01, 1.1719339710664150e-02, -7.6582332554709395e-04, -3.5728186480685452e-02,
+    4.2697767969383175e-02,
+    4.9645019802481961e-02, 2.9204111659184805e-02, -5.7681622599773828e-03, -1.5214920129763956e-02,
+    -2.7678875562257808e-03,
+    -1.7761143010428849e-02, -1.8320263073173172e-02, -4.6086692807295335e-03, 1.0521756143668244e-02,
+    9.0306274459175748e-03,
+};
+
+static const double gauss_simplified_D5[10] = {
+    4.6493486063632918e+00, 7.1420458406761096e+00,
+    -7.1420458406761096e+00, 4.6493486063632918e+00,
+    6.7039127983069431e+00, 3.4853228323661725e+00,
+    -3.4853228323661725e+00, 6.7039127983069431e+00,
+    7.2934771906594484e+00, 0.0000000000000000e+00,
+};
+
+static const double gauss_simplified_T6[36] = {
+    8.7808321708605108e-01, 0.0000000000000000e+00, 9.3555909275336069e-01, 0.0000000000000000e+00,
+    -9.5290824432258980e-01, 0.0000000000000000e+00,
+    1.7174076768258004e-01, -4.0377104892106513e-01, 2.6160744979570577e-01, -2.2709825698006320e-01,
+    -2.8978071413392414e-01, 7.3038588927541351e-02,
+    -1.7285671470878081e-01, -1.9069352853084826e-02, -2.1776505510137125e-02, -6.3546793662303272e-02,
+    -4.3552536808886155e-02, 2.5902104391501039e-02,
+    4.5557282850813216e-02, 5.3353030317658423e-02, -7.6298439875653557e-03, -5.5741760896124990e-03,
+    -8.8079797671061257e-04, 8.0762161273007990e-03,
+    -9.6857867134837114e-03, -3.0662337246238010e-02, -6.0493347690819075e-03, 6.6963839946151136e-03,
+    -2.8029695104241927e-03, -1.6020585539541729e-03,
+    1.9576377675118153e-03, 1.5523884904491846e-02, 5.4656523812362558e-03, -2.0251798596873515e-03,
+    2.2458329838366277e-03, 3.0281353437578078e-03,
+};
+
+static const double gauss_simplified_D6[12] = {
+    5.0318644956231697e+00, 8.9853459073092949e+00,
+    -8.9853459073092949e+00, 5.0318644956231697e+00,
+    7.4714167126486739e+00, 5.2525446228892765e+00,
+    -5.2525446228892765e+00, 7.4714167126486739e+00,
+    8.4967187917271758e+00, 1.7350193464772943e+00,
+    -1.7350193464772943e+00, 8.4967187917271758e+00,
+};
+
+static const double gauss_simplified_T7[49] = {
+    -8.5035232043588049e-01, 0.0000000000000000e+00, 9.1265021040563343e-01, 0.0000000000000000e+00,
+    9.3458122311122016e-01, 0.0000000000000000e+00, 9.4055978178044097e-01,
+    -2.1450814053661496e-01, 4.2359825665884765e-01, 2.9646814693794837e-01, -2.6195033155582120e-01,
+    3.2554787900384219e-01, -1.2513074581231315e-01, 3.3334883004868687e-01,
+    1.9735124680638266e-01, 5.6667545179045979e-02, -3.7257049634525086e-02, -9.4173302982180893e-02,
+    4.1269009800451721e-02, -5.5313477792228664e-02, 6.4554598012522474e-02,
+    -3.4525786839946324e-02, -7.8082400186207129e-02, -1.4836403119515500e-02, 3.0532524084083915e-03,
+    -9.5750612141811580e-04, -1.2080269976410070e-02, 6.8848385937857201e-03,
+    -3.7480270774970146e-03, 3.8607888395597902e-02, -4.0010474121755834e-03, 4.2899287529169485e-03,
+    -9.4442722610532355e-04, 9.1133366716706233e-04, 2.6598298604616926e-03,
+    7.2456359325201647e-03, -1.8461670570721598e-02, 5.1932873031154004e-03, 3.5806307043106028e-04,
+    -2.6136489066373248e-04, -2.0653078214020217e-03, -1.3756710316336618e-03,
+    -4.9583105855061016e-03, 9.0307885858180396e-03, -3.0042076223673322e-03, -1.2568098411682735e-03,
+    -3.7222800640570127e-04, 1.7480751994739369e-03, 1.4799018907661063e-03,
+};
+
+static const double gauss_simplified_D7[14] = {
+    5.3713537578876096e+00, 1.0841388261432224e+01,
+    -1.0841388261432224e+01, 5.3713537578876096e+00,
+    8.1402783272844630e+00, 7.0343480954312403e+00,
+    -7.0343480954312403e+00, 8.1402783272844630e+00,
+    9.5165810562800210e+00, 3.4785721222551111e+00,
+    -3.4785721222551111e+00, 9.5165810562800210e+00,
+    9.9435737170944289e+00, 0.0000000000000000e+00,
+};
+
+static const double gauss_simplified_T8[64] = {
+    8.2193585582411233e-01, 0.0000000000000000e+00, -8.8931582451607150e-01, 0.0000000000000000e+00,
+    -9.1512355767925158e-01, 0.0000000000000000e+00, 9.2522599677736594e-01, 0.0000000000000000e+00,
+    2.5695191289628649e-01, -4.3397322144122358e-01, -3.2882588278748548e-01, 2.8603256021290585e-01,
+    -3.5608185529462405e-01, 1.6304756704893719e-01, 3.6647984402997824e-01, -5.3056290502956398e-02,
+    -2.1531057258483430e-01, -1.0045115052637008e-01, 4.7412923022494252e-02, 1.2685013315140561e-01,
+    -3.9264932617492761e-02, 8.5681802522811726e-02, 7.6251584480502163e-02, -2.9542231221371132e-02,
+    1.5720097174868292e-02, 1.0192116246093680e-01, 2.6310018504678262e-02, -9.8324966248575178e-03,
+    6.4813850227712173e-03, 1.5247456534805637e-02, 8.8743434172925319e-03, -8.0170353162528803e-03,
+    2.0911795842842178e-02, -4.1952919437378396e-02, 5.2667515379907872e-04, -4.3205079373658485e-03,
+    3.0337745103532049e-03, -5.4819094479204033e-04, 1.3922869826198865e-03, -7.9721274818788843e-04,
+    -1.7389482320966636e-02, 1.6030277877054053e-02, -3.7687869141313324e-03, -1.2389189547245235e-03,
+    -4.4445395875414512e-04, 6.2355066960449333e-04, -4.8940907885001062e-04, -7.4326683631171760e-04,
+    1.1236032025475818e-02, -6.7973400339616007e-03, 2.0093487142945608e-03, 2.4296418392114397e-03,
+    8.3666729513345644e-04, -9.0665413105449160e-04, 5.3987606222104245e-04, 4.9296710287674225e-04,
+    -6.4405756745805273e-03, 3.1044321477736946e-03, -8.5879141228368974e-04, -1.7549768582465566e-03,
+    -7.8577242811880854e-04, 4.9775715568057925e-04, -4.2882093245944554e-04, -5.0010930894975661e-04,
+};
+
+static const double gauss_simplified_D8[16] = {
+    5.6779678978367674e+00, 1.2707822597247784e+01,
+    -1.2707822597247784e+01, 5.6779678978367674e+00,
+    8.7365784339057306e+00, 8.8288850008925976e+00,
+    -8.8288850008925976e+00, 8.7365784339057306e+00,
+    1.0409681582375107e+01, 5.2323503048572375e+00,
+    -5.2323503048572375e+00, 1.0409681582375107e+01,
+    1.1175772085918894e+01, 1.7352288916565461e+00,
+    -1.7352288916565461e+00, 1.1175772085918894e+01,
+};
+
+static const double gauss_simplified_T9[81] = {
+    -7.9384250663601219e-01, 0.0000000000000000e+00, 8.6610261525994126e-01, 0.0000000000000000e+00,
+    -8.9529062622024524e-01, 0.0000000000000000e+00, 9.0860718434217347e-01, 0.0000000000000000e+00,
+    -9.1255025964651593e-01,
+    -2.9742497850721861e-01, 4.3510819292042968e-01, 3.5859837446935416e-01, -3.0131979735734976e-01,
+    -3.8289128779215392e-01, 1.9047468187400898e-01, 3.9362136386700247e-01, -9.2459474364991828e-02,
+    -3.9673481968343782e-01,
+    2.2460684386815194e-01, 1.4868443687827645e-01, -5.2066663574374783e-02, -1.6058246472476828e-01,
+    -3.9057525194806250e-02, 1.1595785351155380e-01, 8.4251374326292219e-02, -5.9356852445781871e-02,
+    -9.8017218221753841e-02,
+    1.1161682429223682e-02, -1.2247643742023198e-01, -4.1340124048056759e-02, 1.3932057977604734e-02,
+    1.4616104678174636e-02, 1.8965580260949778e-02, 7.6262373680541376e-03, -1.6180507738921521e-02,
+    -1.5496079709197074e-02,
+    -4.0671877871012348e-02, 3.9401916831758248e-02, 3.2916099269817609e-03, 6.9646400088144919e-03,
+    4.5033935639012309e-03, -1.1115224521292206e-03, -2.2933663796857292e-04, -1.9991220241953409e-03,
+    -2.3810107162980602e-03,
+    2.6737473182080997e-02, -8.9676937550279452e-03, 2.5812306611151890e-03, 7.2151287212455779e-04,
+    -5.7484040554017866e-04, -4.7966889823557293e-04, -2.4370348999050843e-04, -6.5613727299974520e-04,
+    6.7074588841508433e-05,
+    -1.5477002921820037e-02, 8.7349562388396105e-04, -8.5151233234706189e-04, -2.5088178386964534e-03,
+    6.2584520647701819e-04, -1.8716206869855815e-04, -2.7042771856001551e-05, 3.8701551541923013e-04,
+    -3.8420526509612695e-04,
+    9.1220807918937514e-03, 8.6322018398742994e-04, -1.3357708895478496e-04, 1.9943371519718844e-03,
+    -7.3523837601871501e-04, 4.9557988506226792e-06, -1.3614229048934513e-05, -4.0045363899854532e-04,
+    3.2460930147416666e-04,
+    -5.0931271451387797e-03, -8.5880328675818902e-04, 2.9911796416404499e-04, -1.2015346514997927e-03,
+    5.0968043309344120e-04, 1.0216917939076941e-04, -3.4452339279522420e-05, 3.2014804927610758e-04,
+    -2.7607902116190430e-04,
+};
+
+static const double gauss_simplified_D9[18] = {
+    5.9585215966711083e+00, 1.4582927377244966e+01,
+    -1.4582927377244966e+01, 5.9585215966711083e+00,
+    9.2768797702648644e+00, 1.0634543347748068e+01,
+    -1.0634543347748068e+01, 9.2768797702648644e+00,
+    1.1208843659694733e+01, 6.9963138450570330e+00,
+    -6.9963138450570330e+00, 1.1208843659694733e+01,
+    1.2258735757003109e+01, 3.4756967561812870e+00,
+    -3.4756967561812870e+00, 1.2258735757003109e+01,
+    1.2594038432460025e+01, 0.0000000000000000e+00,
+};
+
+static const double gauss_simplified_T10[100] = {
+    7.6696421679642146e-01, 0.0000000000000000e+00, 8.4345155498060287e-01, 0.0000000000000000e+00,
+    -8.7555066001020920e-01, 0.0000000000000000e+00, 8.9150480393706821e-01, 0.0000000000000000e+00,
+    8.9837707252710763e-01, 0.0000000000000000e+00,
+    3.3430003646156825e-01, -4.2804873600886284e-01, 3.8548631277641754e-01, -3.0941814707005211e-01,
+    -4.0658544742569663e-01, 2.0979001050640489e-01, 4.1667741995086349e-01, -1.2188363461049379e-01,
+    4.2089665061113712e-01, -4.0007707838648862e-02,
+    -2.2391025641440479e-01, -1.9882310462115815e-01, -5.1164231403585815e-02, -1.9421478582598609e-01,
+    -4.1357206368257952e-02, 1.4542710888911345e-01, 9.1166871811163688e-02, -8.8231708885593937e-02,
+    1.1329029771079790e-01, -2.9468917578918796e-02,
+    -4.5388122996651584e-02, 1.3706193505736980e-01, -5.9104190707249336e-02, 1.4545514233306665e-02,
+    2.4562748549316657e-02, 2.4040842407702288e-02, 4.0894745868119359e-03, -2.4823193042183746e-02,
+    1.8888645133837239e-02, -9.7403762893523097e-03,
+    6.1191393164840450e-02, -2.9714457513776306e-02, 6.5306320761368769e-03, 1.2244166545203661e-02,
+    6.0632725975592753e-03, -2.7108610031553685e-03, -2.2258045400798134e-03, -2.9882966191986859e-03,
+    2.3629857181014938e-03, -1.8433768839978559e-03,
+    -3.3638667750526388e-02, -2.4737887026337019e-03, 2.2929991687518931e-03, -8.0386149304577056e-04,
+    -6.3680958705988476e-04, -1.2600627505356284e-03, -3.8780180047974261e-04, -2.9603700752461372e-04,
+    9.1323515359514876e-05, -4.2196550413806230e-04,
+    1.6741138824879698e-02, 7.1928133965788038e-03, -2.1965186270779999e-04, -2.0073733489048427e-03,
+    2.1482125751954255e-04, 2.0445808119055338e-04, -2.0699178587600624e-04, 2.2747641091845660e-04,
+    1.4091610018766867e-04, 6.2125862812462270e-05,
+    -8.8019443929612234e-03, -6.1310139016851114e-03, -8.5479012699169463e-04, 1.5676682677740437e-03,
+    -4.1409060419412392e-04, -2.2884611029986947e-04, 1.4271317435178265e-04, -1.6594546388881248e-04,
+    -1.2118895862570519e-04, -1.2490969554449207e-04,
+    4.9795957452869579e-03, 4.4120323060680717e-03, 9.3835524504017477e-04, -9.2608597879216038e-04,
+    3.2181743964115157e-04, 3.1442242618155881e-04, -1.5522462458972678e-04, 1.6378015764028438e-04,
+    1.1454794037448942e-04, 1.1137127156815757e-04,
+    -2.7312927588711085e-03, -2.7141062323585482e-03, -6.5641548863835930e-04, 4.9040249516471915e-04,
+    -1.8198952042123827e-04, -2.4755430821372145e-04, 1.3162136384273061e-04, -1.0630565963991404e-04,
+    -8.6574556153443030e-05, -9.3331137689708340e-05,
+};
+
+static const double gauss_simplified_D10[20] = {
+    6.2178324667385318e+00, 1.6465398917248510e+01,
+    -1.6465398917248510e+01, 6.2178324667385318e+00,
+    9.7724391136093658e+00, 1.2449970965081574e+01,
+    -1.2449970965081574e+01, 9.7724391136093658e+00,
+    1.1935056852665291e+01, 8.7698942650563083e+00,
+    -8.7698942650563083e+00, 1.1935056852665291e+01,
+    1.3230581477113212e+01, 5.2231364949098458e+00,
+    -5.2231364949098458e+00, 1.3230581477113212e+01,
+    1.3844090088490791e+01, 1.7353290191253850e+00,
+    -1.7353290191253850e+00, 1.3844090088490791e+01,
+};
+
+static const double gauss_simplified_T11[121] = {
+    -7.4196746629927335e-01, 0.0000000000000000e+00, -8.2169310052041877e-01, 0.0000000000000000e+00,
+    8.5622028903158720e-01, 0.0000000000000000e+00, 8.7437203528780660e-01, 0.0000000000000000e+00,
+    8.8355931082404415e-01, 0.0000000000000000e+00, -8.8639310374497848e-01,
+    -3.6626176279891504e-01, 4.1452752341456550e-01, -4.0921639394083176e-01, 3.1179031046471001e-01,
+    4.2743232553412047e-01, -2.2273264942562843e-01, 4.3656483213966146e-01, -1.4371544350754192e-01,
+    4.4099964297501604e-01, -7.0526093465676648e-02, -4.4233690069229753e-01,
+    2.1299894248953785e-01, 2.4793062253936579e-01, 4.4947328628317171e-02, 2.2657949757048984e-01,
+    4.6407757703600901e-02, -1.7348707937977959e-01, 9.8289282320677046e-02, -1.1558737083701062e-01,
+    1.2538988703700460e-01, -5.7574032971667251e-02, -1.3384910090566121e-01,
+    8.5119259143901629e-02, -1.4329357431846865e-01, 7.8582135836890735e-02, -1.1050649378800008e-02,
+    -3.5594195190783467e-02, -3.0976014654955378e-02, -9.3510819817480700e-04, -3.4237381562244602e-02,
+    1.9853666760024650e-02, -2.0436785445839031e-02, -2.6701233894002602e-02,
+    -7.9994874604557828e-02, 1.2321236024276684e-02, -8.2892954777145471e-03, -1.9964182030532809e-02,
+    -8.2539768106312250e-03, 5.2564380416843907e-03, -4.7450542323194192e-03, -3.6163962615684193e-03,
+    1.4729667106716364e-03, -4.0567101944443502e-03, -4.0698697353188451e-03,
+    3.6313581181798643e-02, 1.7519938906662168e-02, -3.3403367262571223e-03, 2.8445129376956269e-03,
+    9.0871421177798396e-04, 1.9047422814272930e-03, -7.1317403082318928e-04, 2.0105905692412157e-04,
+    -8.5152528461404777e-05, -6.6516370557893716e-04, -4.3770052066887012e-04,
+    -1.4240972753909963e-02, -1.6106899073751749e-02, 2.9173946007136854e-04, 1.3942966367637484e-03,
+    1.8835799111915604e-04, -3.8580373795853303e-04, -1.8035633585176161e-04, 1.5632464164937171e-04,
+    -3.3618897202818634e-05, 2.2535564148051571e-05, -1.4093073021980874e-04,
+    5.6321748435753704e-03, 1.1095054870091828e-02, 1.1067301838411495e-03, -9.9014981514275869e-04,
+    1.0621923520248978e-04, 2.3146924301464065e-04, 1.4868530321564190e-04, -9.2954577773192321e-06,
+    -1.8871514293672546e-05, -9.4627289318123116e-05, 6.6807288146179767e-05,
+    -2.3752427378898881e-03, -7.3644374569340840e-03, -1.1715235912057500e-03, 3.6412110131470231e-04,
+    -8.8679974909938351e-05, -3.1298114476983874e-04, -1.3399342829883677e-04, 2.0484600148608146e-05,
+    3.1182720249664506e-06, 8.8416945335202630e-05, -7.8834986004400480e-05,
+    1.0851198483606017e-03, 4.8637211857447378e-03, 8.9684340075128701e-04, -6.7706316734559457e-05,
+    1.2517990667180790e-05, 2.8349573098141720e-04, 1.3104928411842616e-04, -4.7520432905720857e-06,
+    -1.9159897771989156e-06, -8.3459538965293580e-05, 7.1883524015302669e-05,
+    -5.0820860580897147e-04, -2.8996423239333858e-03, -5.6121618273123196e-04, -1.8845320613623334e-05,
+    1.6711518374446049e-05, -1.8928107908500953e-04, -9.3865443935730052e-05, -7.6888065277630780e-06,
+    -2.9584649192501132e-06, 6.3163182985079784e-05, -5.5554219530715821e-05,
+};
+
+static const double gauss_simplified_D11[22] = {
+    6.4594442003055104e+00, 1.8354223140060881e+01,
+    -1.8354223140060881e+01, 6.4594442003055104e+00,
+    1.0231296408903578e+01, 1.4274041449614202e+01,
+    -1.4274041449614202e+01, 1.0231296408903578e+01,
+    1.2602675929412811e+01, 1.0552384163522314e+01,
+    -1.0552384163522314e+01, 1.2602675929412811e+01,
+    1.4115781012949041e+01, 6.9780272017411749e+00,
+    -6.9780272017411749e+00, 1.4115781012949041e+01,
+    1.4968467341802324e+01, 3.4742074498419599e+00,
+    -3.4742074498419599e+00, 1.4968467341802324e+01,
+    1.5244670223544942e+01, 0.0000000000000000e+00,
+};
+
+static const double gauss_simplified_T12[144] = {
+    7.1922193502654030e-01, 0.0000000000000000e+00, -8.0104235922083988e-01, 0.0000000000000000e+00,
+    -8.3751244111780099e-01, 0.0000000000000000e+00, -8.5749025512836041e-01, 0.0000000000000000e+00,
+    -8.7357516242376576e-01, 0.0000000000000000e+00, 8.6856277867716258e-01, 0.0000000000000000e+00,
+    3.9254351247696234e-01, -3.9668103389649656e-01, -4.2965198759231682e-01, 3.0979489963130191e-01,
+    -4.4559010636827434e-01, 2.3067717007280050e-01, -4.5378211038896604e-01, 1.5964694740826149e-01,
+    -4.5994007206043891e-01, 3.0982472063457910e-02, 4.5807087858160350e-01, -9.3871196928645928e-02,
+    -1.9282932465200003e-01, -2.9319172654998221e-01, 3.3973409620503436e-02, 2.5663931161117232e-01,
+    -5.4141796752960977e-02, 1.9962830022903519e-01, -1.0623031133808362e-01, 1.4107652400951873e-01,
+    -1.4973687379612100e-01, 2.7786590316284634e-02, 1.3605059940552985e-01, -8.3819275833776491e-02,
+    -1.2763415786662674e-01, 1.3961273351358927e-01, 9.8615707458315743e-02, -3.1271890547181235e-03,
+    4.7006208458441258e-02, 4.0039164706796901e-02, 6.7747788739291447e-03, 4.4622740084006386e-02,
+    -3.1759550093597835e-02, 1.1343182915601902e-02, 1.9179111095649536e-02, -3.1829475064899235e-02,
+    9.4357131462209351e-02, 1.2333175285117067e-02, -7.7439883327201147e-03, -2.9664555313057374e-02,
+    1.1499976166985249e-02, -8.5196107218932799e-03, 7.9419614107839216e-03, 3.9326403850768969e-03,
+    -4.7774510838240530e-03, 2.7747445188377024e-03, -2.2354202245763628e-04, -6.3731206084994474e-03,
+    -3.3214208853925731e-02, -3.4641213663679421e-02, -5.9721211870808928e-03, 4.7975326414718446e-03,
+    -1.5219095325751299e-03, -2.6558594239240551e-03, 1.1065007876563590e-03, -8.4832662893740145e-04,
+    -5.2061016670233772e-04, 5.2814916434317969e-04, -5.4036483379151271e-04, -7.6641222866278560e-04,
+    7.5762779737426128e-03, 2.4275611643197390e-02, 1.0350748141095584e-03, 1.0988163107072484e-03,
+    -5.2895800891482444e-04, 5.0090158750347750e-04, 5.0919896552573188e-05, -1.8228730226818739e-04,
+    -8.1891639120075987e-05, 5.2557911222309439e-05, -1.4778174867140012e-04, 9.3658581116416611e-06,
+    6.1446656202072031e-05, -1.4478205531859216e-02, 9.7478186106283332e-04, -5.7884539529804249e-04,
+    1.1311781679173917e-04, -1.1309960401444601e-04, -1.1207660081779611e-04, -5.3102511379236768e-05,
+    2.3208062631148323e-05, 3.6806466448727401e-05, 1.1701127233481043e-05, -3.4173238262322089e-05,
+    -1.7913176748345654e-03, 8.6908607671791014e-03, -1.0718012802865666e-03, -1.1990431633871402e-04,
+    -5.4764524475194333e-05, 2.0072975457170600e-04, 7.1064241420473954e-05, 4.7924952172215074e-05,
+    -2.8707932434769599e-05, -2.3676533054306860e-05, -3.1700947885632078e-05, 4.2872427519457348e-05,
+    1.8626554345701045e-03, -5.4582026920803120e-03, 7.8172025110251938e-04, 3.6194997266298599e-04,
+    1.0468087398301989e-04, -1.9531225127123887e-04, -7.1697691142774456e-05, -4.7822132712445068e-05,
+    2.7621543565130290e-05, 2.6417714838762254e-05, 3.1385825480529775e-05, -3.7667847438718602e-05,
+    -1.5033273952938032e-03, 3.5192077545333814e-03, -5.1641876932710640e-04, -3.6324492807133054e-04,
+    -1.1706675717518211e-04, 1.4230544459437047e-04, 5.9007751776520226e-05, 5.2022388618721944e-05,
+    -2.5049271487979979e-05, -2.4386711381560216e-05, -3.1014000904039997e-05, 3.3504251659399432e-05,
+    9.8156258045674349e-04, -2.0774483951653288e-03, 3.0264933822807548e-04, 2.5556165060327971e-04,
+    8.7264934689799798e-05, -8.5234203825970876e-05, -3.7273608501889034e-05, -4.0385796655784432e-05,
+    1.8268450886129738e-05, 1.8757547288520902e-05, 2.4381844748351198e-05, -2.2741023028477462e-05,
+};
+
+static const double gauss_simplified_D12[24] = {
+    6.6860466102930651e+00, 2.0248593650466042e+01,
+    -2.0248593650466042e+01, 6.6860466102930651e+00,
+    1.0659417391619190e+01, 1.6105813483982796e+01,
+    -1.6105813483982796e+01, 1.0659417391619190e+01,
+    1.3222006964955888e+01, 1.2343071944350202e+01,
+    -1.2343071944350202e+01, 1.3222006964955888e+01,
+    1.4931148019838542e+01, 8.7403281204236158e+00,
+    -8.7403281204236158e+00, 1.4931148019838542e+01,
+    1.6506848529031181e+01, 1.7353285790451367e+00,
+    -1.7353285790451367e+00, 1.6506848529031181e+01,
+    1.5994532450868487e+01, 5.2181673467048100e+00,
+    -5.2181673467048100e+00, 1.5994532450868487e+01,
+};
+
+static const double gauss_simplified_T13[169] = {
+    6.9879120776803494e-01, 0.0000000000000000e+00, 7.8160536650389867e-01, 0.0000000000000000e+00,
+    8.1956069545871535e-01, 0.0000000000000000e+00, 8.4103558021364300e-01, 0.0000000000000000e+00,
+    8.5367363150392583e-01, 0.0000000000000000e+00, 8.6040834010644185e-01, 0.0000000000000000e+00,
+    -8.6256539713555935e-01,
+    4.1303631874601726e-01, -3.7667605972937590e-01, 4.4682860169980143e-01, -3.0465464626946059e-01,
+    4.6120505334451123e-01, -2.3474925485122319e-01, 4.6864845262952037e-01, -1.7095498206632767e-01,
+    4.7268468643336670e-01, -1.1165461889864871e-01, 4.7474802832230084e-01, -5.5168757558163889e-02,
+    -4.7534561082523369e-01,
+    -1.6532506863535767e-01, -3.3239969517772938e-01, -1.9049845813404003e-02, -2.8359464471046519e-01,
+    6.4281869587104773e-02, -2.2345420363795074e-01, 1.1521876371133007e-01, -1.6447643315416940e-01,
+    1.4618540560886939e-01, -1.0798614805246963e-01, 1.6302746151389338e-01, -5.3493269028478299e-02,
+    -1.6833660927006791e-01,
+    -1.6979220834175768e-01, 1.2561012939530741e-01, -1.1802453780333250e-01, -9.1921384056342526e-03,
+    -5.8130420844342522e-02, -5.1290240055485048e-02, -1.2858011260031570e-02, -5.6074044055163731e-02,
+    1.7522590812424410e-02, -4.3818296891953899e-02, 3.4862339036190432e-02, -2.3549722693467084e-02,
+    -4.0471796473882188e-02,
+    1.0181131802654238e-01, 4.2729205384044719e-02, 4.2457900301573299e-03, 4.0637190770892742e-02,
+    -1.6108646276733196e-02, 1.2164027300999383e-02, -1.1939959400811478e-02, -4.0890120522533713e-03,
+    -2.6864147512908449e-03, -8.7296837533423349e-03, 4.5401779508225659e-03, -6.0705362777448025e-03,
+    -7.1614647852750648e-03,
+    -2.3422582704552879e-02, -5.1663169669380525e-02, 1.0213715081797616e-02, -5.9907244783108009e-03,
+    2.4884347475568227e-03, 3.7718438729186518e-03, -1.5313633207548586e-03, 1.7134383660144007e-03,
+    -1.2251556304991760e-03, -7.1765988550761780e-04, 2.8421244259718714e-04, -1.0893884076699494e-03,
+    -9.9807656702093073e-04,
+    -3.0047237283488504e-03, 2.9918026977660536e-02, -2.2464295004006002e-03, -1.4951850102140243e-03,
+    8.4217739877361336e-04, -6.6970877112552149e-04, 1.4162586610683470e-04, 2.8348757809457163e-04,
+    -2.2388179818349477e-04, 6.5639172209171009e-05, -1.7442840653422338e-05, -1.2391261676380610e-04,
+    -1.4647135828689919e-04,
+    7.5123086990517987e-03, -1.5152307886955325e-02, -6.5639844305733180e-04, 5.2861518501970601e-04,
+    -2.5216766744139997e-04, -4.5121957516657431e-05, 8.4701671978312215e-05, 4.5719707882988847e-05,
+    1.4683137726756588e-05, 1.8041130616328096e-05, -1.2234176227944298e-05, -3.5904962839779423e-05,
+    1.0868610651219205e-06,
+    -6.5800919355498266e-03, 7.7834233301664127e-03, 8.0756395966801874e-04, 3.7946262777369425e-04,
+    1.0092204316952455e-04, -6.1023514847112549e-05, -1.8535763041026608e-05, -6.3744756371834975e-05,
+    -2.7370716831876081e-05, 1.1514216135920502e-05, 1.3923629604148990e-07, 1.8269703216683249e-05,
+    -2.0073046141305209e-05,
+    4.9675882921262080e-03, -4.2697884353378813e-03, -4.9280702860835890e-04, -6.1160847364371467e-04,
+    -1.3444137313735907e-04, 8.2951549379832722e-05, 1.6791635879504470e-05, 5.2769434511716073e-05,
+    2.9769849078672957e-05, -5.3849903719182430e-06, -2.4011611582904471e-06, -2.0295666602786745e-05,
+    1.7475053554165400e-05,
+    -3.6217433634092343e-03, 2.5208723506644332e-03, 2.5535609503055622e-04, 5.6264652541240031e-04,
+    1.4368619005229155e-04, -4.9458421532384715e-05, -1.3078059204952721e-05, -5.4049563254333905e-05,
+    -2.8357204270338694e-05, 3.9974991556153439e-06, 1.1753119979160466e-06, 1.9781727275635706e-05,
+    -1.7665082184739070e-05,
+    2.5626997917791369e-03, -1.5586787932596743e-03, -1.2576517712612435e-04, -4.3643753712760414e-04,
+    -1.2120946119215544e-04, 2.0226388533096120e-05, 5.0665523160793468e-06, 4.8355714433473461e-05,
+    2.5903365528858981e-05, -1.6833424576553386e-06, -5.6431514302921207e-07, -1.7981636303370609e-05,
+    1.5968155900260048e-05,
+    -1.5878433257282640e-03, 8.9883852783409566e-04, 5.9081405202649082e-05, 2.8014013440773365e-04,
+    8.0576043941932147e-05, -6.0243730606370759e-06, -5.0291927763653640e-07, -3.3349836427555210e-05,
+    -1.8469494801089287e-05, -1.1080645390737487e-07, -1.0221200566769562e-07, 1.3122691534253176e-05,
+    -1.1751894408937832e-05,
+};
+
+static const double gauss_simplified_D13[26] = {
+    6.8997346001032707e+00, 2.2147857393826477e+01,
+    -2.2147857393826477e+01, 6.8997346001032707e+00,
+    1.1061357379148035e+01, 1.7944494370574933e+01,
+    -1.7944494370574933e+01, 1.1061357379148035e+01,
+    1.3800792167202744e+01, 1.4141288621004069e+01,
+    -1.4141288621004069e+01, 1.3800792167202744e+01,
+    1.5688506330507341e+01, 1.0509845515904310e+01,
+    -1.0509845515904310e+01, 1.5688506330507341e+01,
+    1.6941908342326403e+01, 6.9675715858342420e+00,
+    -6.9675715858342420e+00, 1.6941908342326403e+01,
+    1.7659265060202181e+01, 3.4735506634242181e+00,
+    -3.4735506634242181e+00, 1.7659265060202181e+01,
+    1.7896872644408258e+01, 0.0000000000000000e+00,
+};
+
+static const double gauss_simplified_T14[196] = {
+    6.8048780264588604e-01, 0.0000000000000000e+00, 7.6339792239680015e-01, 0.0000000000000000e+00,
+    8.0243132665676509e-01, 0.0000000000000000e+00, 8.2512762712437937e-01, 0.0000000000000000e+00,
+    -8.3905104689838617e-01, 0.0000000000000000e+00, -8.4720850202857534e-01, 0.0000000000000000e+00,
+    8.5103486583136934e-01, 0.0000000000000000e+00,
+    4.2823294498027736e-01, -3.5635240003041269e-01, 4.6093946894730398e-01, -2.9741008462800217e-01,
+    4.7445021808229138e-01, -2.3587931439287124e-01, 4.8140017882520986e-01, -1.7861841242270174e-01,
+    -4.8521823221540339e-01, 1.2511269657100690e-01, -4.8733280756556102e-01, 7.4025705380452708e-02,
+    4.8822515013246864e-01, -2.4610512810727025e-02,
+    -1.3294702420573370e-01, -3.6427068816168295e-01, -1.1247858862159519e-03, -3.0693903725489396e-01,
+    7.6421671646715067e-02, -2.4470610646590410e-01, 1.2526264561224756e-01, -1.8562735938519959e-01,
+    -1.5625218882026984e-01, 1.3004078716940953e-01, -1.7486536306390471e-01, 7.6936510089753954e-02,
+    1.8351539832617547e-01, -2.5568707404423730e-02,
+    -2.0858306671929575e-01, 1.0205984798965373e-01, -1.3572958654385892e-01, -2.5536550165117550e-02,
+    -6.8372544704707175e-02, -6.4610697002224077e-02, -1.8689538352176707e-02, -6.8575545493983286e-02,
+    -1.5396546888528415e-02, 5.6362195381754569e-02, -3.6691568425552608e-02, 3.6231179616978658e-02,
+    4.6837792539071235e-02, -1.2479474292369659e-02,
+    1.0060716405549447e-01, 7.6485889899336051e-02, -2.5961790099225616e-03, 5.1996767056952463e-02,
+    -2.2258231854827563e-02, 1.5783790177774010e-02, -1.6805591418782528e-02, -4.2967301279350709e-03,
+    5.8864062053418610e-03, 1.1171185087209604e-02, -3.4613622736351275e-03, 9.6870563940111929e-03,
+    8.5550846784760350e-03, -3.7097068192160744e-03,
+    -6.9219660459838095e-03, -6.6093093468455683e-02, 1.5844053130764386e-02, -5.7611829962276352e-03,
+    3.7139913868628259e-03, 5.4957306949695384e-03, -2.0131127711270603e-03, 2.8751866271572403e-03,
+    2.1224256429985852e-03, 4.9497754630227465e-04, 2.6769240374454706e-04, 1.6274196060835611e-03,
+    1.1830962200724312e-03, -7.8631062999472633e-04,
+    -1.6503327683032278e-02, 3.1372266129514083e-02, -3.5743012114041435e-03, -2.8539162767808423e-03,
+    1.2224982170101824e-03, -9.6853229156639118e-04, 3.9773031855137430e-04, 4.4141667941441977e-04,
+    2.7437307547332731e-04, -2.0570068047036784e-04, 1.5561472685426958e-04, 1.6230327353852992e-04,
+    1.4237554102667133e-04, -1.2455564160132951e-04,
+    1.5489737296042380e-02, -1.2330523976877700e-02, -4.1174344826275326e-04, 9.1384626056029887e-04,
+    -3.5424058568240402e-04, -2.0329759345641150e-04, 8.5440035019436036e-05, -7.5361103147016148e-06,
+    -1.9235746386144538e-05, -5.6134585145776717e-05, 2.2801507214335068e-05, 1.7804573187440502e-05,
+    7.2071683092351299e-06, -2.5087969069074361e-05,
+    -1.0888043045581920e-02, 4.4350662516029447e-03, 5.6100789046067533e-04, 3.9057785013987790e-04,
+    7.7776342226662152e-05, 6.2518601101922618e-05, 7.1668656395671168e-06, -5.5438470991267004e-05,
+    1.0081992514282302e-05, 3.5972045154133822e-06, 1.0191133844797461e-05, -1.0311413963244970e-05,
+    7.9198605439952916e-06, 2.9827074593354271e-06,
+    7.2995840626416770e-03, -1.4279957904291167e-03, -1.8725309826003001e-04, -6.5961900758330059e-04,
+    -1.0162621083582913e-04, -4.2026766282619245e-06, -1.5809313319214016e-05, 3.6065646540367604e-05,
+    -1.7397768247067043e-05, -8.0108663443164351e-06, -5.9340112065844261e-06, 8.7518864364202956e-06,
+    -6.5094583397930048e-06, -6.4025845822104806e-06,
+    -4.9624675305300599e-03, 3.1764782062393318e-04, -3.7576355769022777e-05, 5.7653415912948397e-04,
+    1.1408208338994279e-04, 2.2941469461683327e-05, 1.4347987930967377e-05, -3.4610941197153074e-05,
+    1.5461504196773521e-05, 9.4158604085220165e-06, 6.7408780222898566e-06, -9.1375550618500720e-06,
+    6.5992743712780250e-06, 5.9291659214738839e-06,
+    3.4490551460658941e-03, 6.9609144673085107e-05, 1.1969190541024678e-04, -4.3584476880411527e-04,
+    -9.7272562185661765e-05, -4.0950634373654009e-05, -1.7524851547780359e-05, 3.1914090190136053e-05,
+    -1.4294971079024335e-05, -9.7699454896183599e-06, -6.8339655761126856e-06, 8.4074187490509536e-06,
+    -6.3188217500497605e-06, -5.9588397255605330e-06,
+    -2.3854925622435173e-03, -1.7123810840453745e-04, -1.2628371946802133e-04, 3.0888102671746342e-04,
+    7.1997340697467236e-05, 4.3134145239843431e-05, 1.8099109534572849e-05, -2.5019492774946643e-05,
+    1.1833576888436142e-05, 9.6559653890705622e-06, 6.4364201899448502e-06, -7.2416064760874617e-06,
+    5.5855829144627815e-06, 5.4056465734389365e-06,
+    1.4633973793750307e-03, 1.4397607063731030e-04, 9.1681422711398401e-05, -1.9034104425861572e-04,
+    -4.4855239929737682e-05, -3.1774742754895557e-05, -1.3541879833131457e-05, 1.5951268640270555e-05,
+    -7.8011759742768597e-06, -7.2739410278272909e-06, -4.8218352924281708e-06, 4.9655455986431222e-06,
+    -3.9779794619751651e-06, -3.9715539950182539e-06,
+};
+
+static const double gauss_simplified_D14[28] = {
+    7.1021745336178519e+00, 2.4051475654778134e+01,
+    -2.4051475654778134e+01, 7.1021745336178519e+00,
+    1.1440724648798126e+01, 1.9789433351147068e+01,
+    -1.9789433351147068e+01, 1.1440724648798126e+01,
+    1.4344639625721110e+01, 1.5946543627700690e+01,
+    -1.5946543627700690e+01, 1.4344639625721110e+01,
+    1.6397736040419296e+01, 1.2285226301760948e+01,
+    -1.2285226301760948e+01, 1.6397736040419296e+01,
+    1.7822740775504869e+01, 8.7254346760234398e+00,
+    -8.7254346760234398e+00, 1.7822740775504869e+01,
+    1.8725022119457179e+01, 5.2111958454243617e+00,
+    -5.2111958454243617e+00, 1.8725022119457179e+01,
+    1.9166962929853675e+01, 1.7407981003349735e+00,
+    -1.7407981003349735e+00, 1.9166962929853675e+01,
+};
+
+static const double gauss_simplified_T15[225] = {
+    -6.6397118070063699e-01, 0.0000000000000000e+00, 7.4637016156764657e-01, 0.0000000000000000e+00,
+    -7.8613387576019211e-01, 0.0000000000000000e+00, -8.0993547869424110e-01, 0.0000000000000000e+00,
+    8.2441998315138953e-01, 0.0000000000000000e+00, 8.3503868783611812e-01, 0.0000000000000000e+00,
+    8.3781256530887172e-01, 0.0000000000000000e+00, 8.4277197220214128e-01,
+    -4.3903508477772296e-01, 3.3698847595612313e-01, 4.7229308512609552e-01, -2.8888785381654997e-01,
+    -4.8553930243113602e-01, 2.3480922659082401e-01, -4.9214722938610284e-01, 1.8348681450009299e-01,
+    4.9629071646218559e-01, -1.3503714307250395e-01, 4.9721403696944788e-01, -8.8931686790511652e-02,
+    5.0057439673842141e-01, -4.4050784737203315e-02, 4.9767844603595035e-01,
+    9.8194338044326201e-02, 3.8850396810967552e-01, 1.8832342086830420e-02, -3.2646352106385224e-01,
+    -9.0123582318643133e-02, 2.6326171811942778e-01, -1.3605848974948126e-01, 2.0440272467373477e-01,
+    1.6703214785026679e-01, -1.5016540422548208e-01, 1.8454343508170584e-01, -9.7913117906997568e-02,
+    1.9881880719913653e-01, -4.9049149908175639e-02, 1.9735371462256077e-01,
+    2.4159248539445516e-01, -7.0681620943019344e-02, -1.5085465714489110e-01, -4.5266416262034904e-02,
+    7.7234532107444603e-02, 7.9759936310495522e-02, 2.3909092623785162e-02, 8.1902811051514701e-02,
+    1.3421678158870517e-02, -6.9720459757765391e-02, 3.7123096070316768e-02, -4.8721889617998712e-02,
+    5.2798001719982487e-02, -2.5906769797999437e-02, 5.4560782778818075e-02,
+    -8.9987744830327704e-02, -1.1075964597380122e-01, -1.2871241343794689e-02, 6.2783619858048353e-02,
+    3.0000047018364298e-02, -1.8939675103368522e-02, 2.2504062251616958e-02, 4.7515091956954747e-03,
+    -9.8151915785543650e-03, -1.3938701102378458e-02, 1.5369336508384236e-03, -1.3292227918053994e-02,
+    9.4038906549091077e-03, -8.2703878957936031e-03, 1.1091984769268398e-02,
+    -1.5335915047478719e-02, 7.5536248178104184e-02, 2.2409586952113585e-02, -3.5451417801601903e-03,
+    -5.0115222733851878e-03, -8.0277966632397290e-03, 2.6103062220778814e-03, -4.3921936869161472e-03,
+    -3.2831821762878653e-03, -9.1408398840144779e-05, -1.1086284885999738e-03, -2.0356884047868051e-03,
+    1.0890503008385121e-03, -1.8086377253839435e-03, 1.7628583889233039e-03,
+    3.1255416710564962e-02, -2.7428243717072903e-02, -4.5628763916372803e-03, -5.2904704223110770e-03,
+    -1.8002160685839565e-03, 1.4161171221026706e-03, -7.3947445443431391e-04, -6.5024122100785771e-04,
+    -3.0892205068906741e-04, 4.4369156521410264e-04, -3.2241517705987761e-04, -1.3024781918692682e-04,
+    6.3142338547573032e-05, -2.9068691672639902e-04, 2.4277132921834697e-04,
+    -2.2447902461362898e-02, 5.7754879883713615e-03, -5.1640077071918365e-04, 1.6772123363709844e-03,
+    4.7161576807547810e-04, 3.6352376351494564e-04, -1.1695293399433226e-04, 9.3122228541666203e-05,
+    4.2255271791483120e-05, 8.5289302792545895e-05, -3.8100093899549077e-05, 1.2084838868780451e-05,
+    -6.0021866120164359e-06, -4.3518955424118611e-05, 2.4965901146412071e-05,
+    1.3568512376321340e-02, 1.0733415892366254e-03, 4.9043687788419147e-04, 2.2596660145602666e-04,
+    -1.8032279741404973e-05, -1.5833296754019967e-04, -5.7711855389659053e-06, 4.3305958306777858e-05,
+    8.2355018595055739e-06, -9.4765985735927459e-06, -9.7940437969667244e-06, 7.3260191548136519e-06,
+    -1.9261988391441790e-06, -3.6979901382469315e-07, 8.2104259557499499e-06,
+    -8.0785202976716205e-03, -2.5770251659008253e-03, 2.1603626564195326e-05, -5.6443702237604957e-04,
+    3.8260422763670191e-05, 5.0169876869122953e-05, 2.7769733235162712e-05, -1.7015378598511864e-05,
+    5.7227957509701252e-06, 8.6147378102843672e-06, 6.6144143476290323e-06, -9.4888637353119569e-07,
+    -1.0286450744508583e-06, -4.8031647400424012e-06, -4.1102727225488615e-06,
+    4.9935275127019453e-03, 2.5147728021263720e-03, -2.5671594476720070e-04, 4.5520765935378187e-04,
+    -6.0777014503124258e-05, -5.6167900255878328e-05, -2.2862665298663172e-05, 1.2465344079483482e-05,
+    -4.1614862623326055e-06, -1.1001856924246494e-05, -6.4951356383136366e-06, 1.8281690526553851e-06,
+    3.2025446358416608e-07, 4.2777671521117942e-06, 4.7328712957327400e-06,
+    -3.2453710954384167e-03, -2.0952419773490809e-03, 3.0350008077390292e-04, -3.0519596362091664e-04,
+    5.0207209203734437e-05, 6.8504181810392906e-05, 2.3175482314655721e-05, -1.1572644345702246e-05,
+    3.2214287085782784e-06, 1.0641496026381289e-05, 6.6566980585181399e-06, -1.4185523668236375e-06,
+    -3.6734900391386575e-07, -4.3195837072662195e-06, -4.6209990250518126e-06,
+    2.1965862848773048e-03, 1.6479498123654372e-03, -2.7363718804914865e-04, 1.9595725051746685e-04,
+    -3.2743431203613046e-05, -6.6744308594398634e-05, -2.2925233214944032e-05, 8.1261670313051315e-06,
+    -2.3513357388253329e-06, -1.0295973684956153e-05, -6.3755784323429561e-06, 1.0399071215347496e-06,
+    2.2087401114643417e-07, 4.1447995961570284e-06, 4.4768206675650817e-06,
+    -1.4958708424336925e-03, -1.2275765076186253e-03, 2.1658837403230617e-04, -1.2426202267640428e-04,
+    1.9248250448451297e-05, 5.5266282096635353e-05, 1.9674155631352157e-05, -4.5566845228916329e-06,
+    1.2526217963385078e-06, 9.0116299745243142e-06, 5.6488059620204290e-06, -6.0717582985747101e-07,
+    -1.0414632664591244e-07, -3.6645454464580696e-06, -3.9704584920056422e-06,
+    9.1051367178938112e-04, 7.8215637548601164e-04, -1.4155195318647047e-04, 7.1806902425401777e-05,
+    -1.0195273871516292e-05, -3.6860574091125668e-05, -1.3396076144646681e-05, 2.1589686914657203e-06,
+    -4.8792512307876950e-07, -6.2482418675233589e-06, -3.9883266497903300e-06, 2.4556322657286849e-07,
+    1.2398918436470722e-08, 2.6074287006634273e-06, 2.8448294021781132e-06,
+};
+
+static const double gauss_simplified_D15[30] = {
+    7.2947122075831832e+00, 2.5959012010981429e+01,
+    -2.5959012010981429e+01, 7.2947122075831832e+00,
+    1.1800392148722135e+01, 2.1640037272359617e+01,
+    -2.1640037272359617e+01, 1.1800392148722135e+01,
+    1.4857084449951218e+01, 1.7757117019398283e+01,
+    -1.7757117019398283e+01, 1.4857084449951218e+01,
+    1.7076542298066997e+01, 1.4072348960079687e+01,
+    -1.4072348960079687e+01, 1.7076542298066997e+01,
+    1.8604703883635100e+01, 1.0476642889443060e+01,
+    -1.0476642889443060e+01, 1.8604703883635100e+01,
+    1.9823935660731344e+01, 6.9791561506376318e+00,
+    -6.9791561506376318e+00, 1.9823935660731344e+01,
+    2.0157337443561907e+01, 3.4608398002701564e+00,
+    -3.4608398002701564e+00, 2.0157337443561907e+01,
+    2.0770566303255059e+01, 0.0000000000000000e+00,
+};
+
+
+
+static const double *gauss_simplified_T_tables[NS_MAX + 1] = {
+    NULL, NULL,
+    gauss_simplified_T2,
+    gauss_simplified_T3,
+    gauss_simplified_T4,
+    gauss_simplified_T5,
+    gauss_simplified_T6,
+    gauss_simplified_T7,
+    gauss_simplified_T8,
+    gauss_simplified_T9,
+    gauss_simplified_T10,
+    gauss_simplified_T11,
+    gauss_simplified_T12,
+    gauss_simplified_T13,
+    gauss_simplified_T14,
+    gauss_simplified_T15,
+};
+
+static const double *gauss_simplified_D_tables[NS_MAX + 1] = {
+    NULL, NULL,
+    gauss_simplified_D2,
+    gauss_simplified_D3,
+    gauss_simplified_D4,
+    gauss_simplified_D5,
+    gauss_simplified_D6,
+    gauss_simplified_D7,
+    gauss_simplified_D8,
+    gauss_simplified_D9,
+    gauss_simplified_D10,
+    gauss_simplified_D11,
+    gauss_simplified_D12,
+    gauss_simplified_D13,
+    gauss_simplified_D14,
+    gauss_simplified_D15,
+};
+
+
+
+const double *gauss_simplified_T_table(int ns)
+{
+    if (ns < 2 || ns > NS_MAX)
+        return NULL;
+
+    return gauss_simplified_T_tables[ns];
+}
+
+
+
+const double *gauss_simplified_D_table(int ns)
+{
+    if (ns < 2 || ns > NS_MAX)
+        return NULL;
+
+    return gauss_simplified_D_tables[ns];
+}
@@ -36,6 +36,7 @@
 
 #include <math.h>
 #include <assert.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -44,8 +45,15 @@
 #include "blasfeo/include/blasfeo_d_kernel.h"
 #include "blasfeo/include/blasfeo_i_aux_ext_dep.h"
 
+#include "acados/sim/sim_collocation_tables.h"
+#include "acados/sim/sim_common.h"
+#include "acados/utils/mem.h"
 #include "acados/utils/print.h"
 
+#if defined(ACADOS_WITH_PTHREADS)
+#include <pthread.h>
+#endif
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -262,7 +270,7 @@ int gauss_simplified_work_calculate_size(int ns)
 
 
 // TODO(all): understand how this works and leave a comment!
-void gauss_simplified(int ns, Newton_scheme *scheme, void *work)
+int gauss_simplified(int ns, Newton_scheme *scheme, void *work)
 {
     char *c_ptr = work;
 
@@ -284,13 +292,19 @@ void gauss_simplified(int ns, Newton_scheme *scheme, void *work)
 
     assert((char *) work + gauss_simplified_work_calculate_size(ns) >= c_ptr);
 
-    char simplified[MAX_STR_LEN];
-
-    snprintf(simplified, sizeof(simplified), "simplified/GL%d_simpl_%s.txt", 2 * ns, "D");
-    read_matrix(simplified, D, ns, 2);
+    const double *D_table = gauss_simplified_D_table(ns);
+    const double *T_table = gauss_simplified_T_table(ns);
+    if (D_table == NULL || T_table == NULL)
+        return ACADOS_FAILURE;
 
-    snprintf(simplified, sizeof(simplified), "simplified/GL%d_simpl_%s.txt", 2 * ns, "T");
-    read_matrix(simplified, T, ns, ns);
+    // column-major copies of the tables
+    for (int i = 0; i < ns; i++)
+    {
+        for (int j = 0; j < 2; j++)
+            D[i + ns * j] = D_table[2 * i + j];
+        for (int j = 0; j < ns; j++)
+            T[i + ns * j] = T_table[ns * i + j];
+    }
 
     scheme->single = false;
     scheme->low_tria = 0;
@@ -372,7 +386,121 @@ void gauss_simplified(int ns, Newton_scheme *scheme, void *work)
         }
     }
 
-    return;
+    return ACADOS_SUCCESS;
+}
+
+
+
+int gauss_transformation_work_calculate_size(int ns)
+{
+    int size = 0;
+
+    size += 3 * ns * ns * sizeof(double);  // T_lu, lu_work, AT
+
+    size += 1 * ns * sizeof(int);  // perm
+
+    return size;
+}
+
+
+
+// Block diagonalization A = T * Lambda * T_inv of the Butcher matrix A of Gauss-Legendre
+// collocation (nodes as returned by gauss_nodes), with T from gauss_simplified_T_table.
+// Lambda has a 2x2 block for each complex conjugate pair of eigenvalues and, for odd ns,
+// one real eigenvalue in the last position. It is returned in scheme->eig as ns x 2 matrix:
+// eig[i] = Lambda[i,i], eig[ns+i] = coupling to the other stage of the pair (0 if real).
+// T is returned in scheme->transf2, T_inv in scheme->transf1, both column-major.
+// Returns ACADOS_FAILURE if T is not tabulated for ns.
+int gauss_transformation(int ns, double *A, Newton_scheme *scheme, void *work)
+{
+    char *c_ptr = work;
+
+    // T_lu
+    double *T_lu = (double *) c_ptr;
+    c_ptr += ns * ns * sizeof(double);
+    // lu_work
+    double *lu_work = (double *) c_ptr;
+    c_ptr += ns * ns * sizeof(double);
+    // AT
+    double *AT = (double *) c_ptr;
+    c_ptr += ns * ns * sizeof(double);
+    // perm
+    int *perm = (int *) c_ptr;
+    c_ptr += ns * sizeof(int);
+
+    assert((char *) work + gauss_transformation_work_calculate_size(ns) >= c_ptr);
+
+    double *T = scheme->transf2;
+    double *T_inv = scheme->transf1;
+    double *eig = scheme->eig;
+
+    int i, j, k;
+
+    if (ns == 1)
+    {
+        T[0] = 1.0;
+        T_inv[0] = 1.0;
+        eig[0] = A[0];
+        eig[1] = 0.0;
+        return ACADOS_SUCCESS;
+    }
+
+    const double *T_table = gauss_simplified_T_table(ns);
+    if (T_table == NULL)
+        return ACADOS_FAILURE;
+
+    for (i = 0; i < ns; i++)
+    {
+        for (j = 0; j < ns; j++)
+            T[i + ns * j] = T_table[ns * i + j];
+    }
+
+    // T_inv
+    for (i = 0; i < ns * ns; i++)
+    {
+        T_lu[i] = T[i];
+        T_inv[i] = 0.0;
+    }
+    for (i = 0; i < ns; i++)
+        T_inv[i * (ns + 1)] = 1.0;
+
+    lu_system_solve(T_lu, T_inv, perm, ns, ns, lu_work);
+
+    // AT = A * T
+    for (j = 0; j < ns; j++)
+    {
+        for (i = 0; i < ns; i++)
+        {
+            AT[i + ns * j] = 0.0;
+            for (k = 0; k < ns; k++)
+                AT[i + ns * j] += A[i + ns * k] * T[k + ns * j];
+        }
+    }
+
+    // diagonal blocks of Lambda = T_inv * A * T;
+    // the remaining entries only vanish up to the accuracy of the tables
+    for (i = 0; i < ns; i++)
+    {
+        if (i % 2 == 0 && i + 1 < ns)
+            j = i + 1;
+        else if (i % 2 == 1)
+            j = i - 1;
+        else
+            j = -1;  // real eigenvalue
+
+        eig[i] = 0.0;
+        for (k = 0; k < ns; k++)
+            eig[i] += T_inv[i + ns * k] * AT[k + ns * i];
+
+        eig[ns + i] = 0.0;
+        if (j >= 0)
+        {
+            for (k = 0; k < ns; k++)
+                eig[ns + i] += T_inv[i + ns * k] * AT[k + ns * j];
+        }
+    }
+
+    return ACADOS_SUCCESS;
 }
 
 
@@ -444,3 +572,174 @@ void butcher_table(int ns, double *nodes, double *b, double *A, void *work)
 
     return;
 }
+
+
+
+int collocation_dense_weights_work_calculate_size(int ns)
+{
+    int size = 0;
+
+    size += 3 * ns * ns * sizeof(double);  // can_vm, rhs, lu_work
+
+    size += 1 * ns * sizeof(int);  // perm
+
+    return size;
+}
+
+
+
+void collocation_dense_weights(int ns, double *nodes, double theta, double *bt, void *work)
+{
+    int i, j;
+
+    char *c_ptr = work;
+
+    // can_vm
+    double *can_vm = (double *) c_ptr;
+    c_ptr += ns * ns * sizeof(double);
+    // rhs
+    double *rhs = (double *) c_ptr;
+    c_ptr += ns * ns * sizeof(double);
+    // lu_work
+    double *lu_work = (double *) c_ptr;
+    c_ptr += ns * ns * sizeof(double);
+    // perm
+    int *perm = (int *) c_ptr;
+    c_ptr += ns * sizeof(int);
+
+    assert((char *) work + collocation_dense_weights_work_calculate_size(ns) >= c_ptr);
+
+    // monomial coefficients of the Lagrange polynomials on the nodes, as in butcher_table
+    for (j = 0; j < ns; j++)
+    {
+        for (i = 0; i < ns; i++) can_vm[i + j * ns] = pow(nodes[i], j);
+    }
+
+    for (i = 0; i < ns * ns; i++) rhs[i] = 0.0;
+    for (i = 0; i < ns; i++) rhs[i * (ns + 1)] = 1.0;
+
+    lu_system_solve(can_vm, rhs, perm, ns, ns, lu_work);
+
+    // integrate from 0 to theta
+    for (i = 0; i < ns; i++)
+    {
+        bt[i] = 0.0;
+        for (j = 0; j < ns; j++)
+        {
+            bt[i] = bt[i] + pow(theta, j + 1) / (j + 1) * rhs[i * ns + j];
+        }
+    }
+
+    return;
+}
+
+
+
+/************************************************
+ * Gauss-Legendre tableau cache
+ ************************************************/
+
+typedef struct
+{
+    gauss_tableau tableau;
+    Newton_scheme scheme;
+    double A_mat[NS_MAX * NS_MAX];
+    double b_vec[NS_MAX];
+    double c_vec[NS_MAX];
+    double eig[2 * NS_MAX];
+    double transf1[NS_MAX * NS_MAX];
+    double transf2[NS_MAX * NS_MAX];
+    bool tableau_ready;
+    bool scheme_ready;
+} gauss_tableau_entry;
+
+static gauss_tableau_entry gauss_tableau_cache[NS_MAX];
+
+#if defined(ACADOS_WITH_PTHREADS)
+static pthread_mutex_t gauss_tableau_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+
+
+// fills the missing parts of the cache entry, called with the cache locked
+static int gauss_tableau_compute(gauss_tableau_entry *entry, int ns, bool simplified)
+{
+    int status = ACADOS_SUCCESS;
+
+    if (entry->tableau_ready && (entry->scheme_ready || !simplified))
+        return status;
+
+    int tmp0 = gauss_nodes_work_calculate_size(ns);
+    int tmp1 = butcher_table_work_calculate_size(ns);
+    int tmp2 = gauss_transformation_work_calculate_size(ns);
+    int work_size = tmp0 > tmp1 ? tmp0 : tmp1;
+    work_size = work_size > tmp2 ? work_size : tmp2;
+    void *work = acados_malloc(work_size, 1);
+
+    if (!entry->tableau_ready)
+    {
+        gauss_nodes(ns, entry->c_vec, work);
+        butcher_table(ns, entry->c_vec, entry->b_vec, entry->A_mat, work);
+
+        entry->tableau.ns = ns;
+        entry->tableau.A_mat = entry->A_mat;
+        entry->tableau.b_vec = entry->b_vec;
+        entry->tableau.c_vec = entry->c_vec;
+        entry->tableau.scheme = NULL;
+        entry->tableau_ready = true;
+    }
+
+    if (simplified && !entry->scheme_ready)
+    {
+        Newton_scheme *scheme = &entry->scheme;
+        scheme->type = simplified_in;
+        scheme->eig = entry->eig;
+        scheme->transf1 = entry->transf1;
+        scheme->transf2 = entry->transf2;
+        scheme->transf1_T = NULL;
+        scheme->transf2_T = NULL;
+        scheme->low_tria = NULL;
+        scheme->single = false;
+        scheme->freeze = false;
+
+        status = gauss_transformation(ns, entry->A_mat, scheme, work);
+
+        if (status == ACADOS_SUCCESS)
+        {
+            entry->tableau.scheme = scheme;
+            entry->scheme_ready = true;
+        }
+    }
+
+    free(work);
+
+    return status;
+}
+
+
+
+const gauss_tableau *gauss_tableau_get(int ns, bool simplified)
+{
+    if (ns < 1 || ns > NS_MAX)
+        return NULL;
+
+    gauss_tableau_entry *entry = gauss_tableau_cache + ns - 1;
+    int status;
+
+#if defined(ACADOS_WITH_PTHREADS)
+    pthread_mutex_lock(&gauss_tableau_mutex);
+#elif defined(ACADOS_WITH_OPENMP)
+    #pragma omp critical (acados_gauss_tableau)
+#endif
+    {
+        status = gauss_tableau_compute(entry, ns, simplified);
+    }
+#if defined(ACADOS_WITH_PTHREADS)
+    pthread_mutex_unlock(&gauss_tableau_mutex);
+#endif
+
+    if (status != ACADOS_SUCCESS)
+        return NULL;
+
+    return &entry->tableau;
+}
@@ -76,11 +76,40 @@ void gauss_nodes(int ns, double *nodes, void *raw_memory);
 //
 int gauss_simplified_work_calculate_size(int ns);
 //
-void gauss_simplified(int ns, Newton_scheme *scheme, void *work);
+int gauss_simplified(int ns, Newton_scheme *scheme, void *work);
+//
+int gauss_transformation_work_calculate_size(int ns);
+//
+int gauss_transformation(int ns, double *A, Newton_scheme *scheme, void *work);
 //
 int butcher_table_work_calculate_size(int ns);
 //
 void butcher_table(int ns, double *nodes, double *b, double *A, void *work);
+//
+int collocation_dense_weights_work_calculate_size(int ns);
+// weights bt(theta) of the collocation polynomial, x(t0 + theta*h) = x0 + h * sum bt_i k_i
+void collocation_dense_weights(int ns, double *nodes, double theta, double *bt, void *work);
+
+
+
+/* Gauss-Legendre tableau cache */
+
+// Butcher tableau of Gauss-Legendre collocation with ns stages, shared read-only between all
+// integrator instances of the process. scheme holds the simplified Newton transformation
+// (eig, transf1, transf2) computed by gauss_transformation, it is NULL until requested.
+typedef struct
+{
+    int ns;
+    double *A_mat;
+    double *b_vec;
+    double *c_vec;
+    Newton_scheme *scheme;
+} gauss_tableau;
+
+// returns the cached tableau for ns stages, computing it on first use; with simplified, the
+// transformation for the simplified Newton scheme is computed as well. Thread safe.
+// Returns NULL if ns is not in [1, NS_MAX].
+const gauss_tableau *gauss_tableau_get(int ns, bool simplified);
 
 
 
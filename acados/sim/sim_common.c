@@ -83,16 +83,18 @@ int sim_in_calculate_size(void *config_, void *dims)
 
     int size = sizeof(sim_in);
 
-    int nx, nu, nz;
+    int nx, nu, nz, n_dense;
 
     config->dims_get(config_, dims, "nx", &nx);
     config->dims_get(config_, dims, "nu", &nu);
     config->dims_get(config_, dims, "nz", &nz);
+    config->dims_get(config_, dims, "n_dense", &n_dense);
 
     size += nx * sizeof(double);              // x
     size += nu * sizeof(double);              // u
     size += nx * (nx + nu) * sizeof(double);  // S_forw (max dimension)
     size += (nx + nu) * sizeof(double);       // S_adj
+    size += n_dense * sizeof(double);         // t_dense
 
     size += config->model_calculate_size(config, dims);
 
@@ -115,10 +117,11 @@ sim_in *sim_in_assign(void *config_, void *dims, void *raw_memory)
 
     in->dims = dims;
 
-    int nx, nu, nz;
+    int nx, nu, nz, n_dense;
     config->dims_get(config_, dims, "nx", &nx);
     config->dims_get(config_, dims, "nu", &nu);
     config->dims_get(config_, dims, "nz", &nz);
+    config->dims_get(config_, dims, "n_dense", &n_dense);
 
     int NF = nx + nu;
 
@@ -130,6 +133,8 @@ sim_in *sim_in_assign(void *config_, void *dims, void *raw_memory)
     assign_and_advance_double(nx * NF, &in->S_forw, &c_ptr);
     assign_and_advance_double(NF, &in->S_adj, &c_ptr);
 
+    assign_and_advance_double(n_dense, &in->t_dense, &c_ptr);
+
     in->identity_seed = false;
 
     in->model = config->model_assign(config, dims, c_ptr);
@@ -221,6 +226,14 @@ int sim_in_set_(void *config_, void *dims_, sim_in *in, const char *field, void
         for (int ii=0; ii < nu; ii++)
             in->S_adj[nx+ii] = 0;
     }
+    else if (!strcmp(field, "t_dense"))
+    {
+        int n_dense;
+        config->dims_get(config_, dims_, "n_dense", &n_dense);
+        double *t_dense = value;
+        for (int ii=0; ii < n_dense; ii++)
+            in->t_dense[ii] = t_dense[ii];
+    }
     else
     {
         status = config->model_set(in->model, field, value);
@@ -241,10 +254,11 @@ int sim_out_calculate_size(void *config_, void *dims)
 
     int size = sizeof(sim_out);
 
-    int nx, nu, nz;
+    int nx, nu, nz, n_dense;
     config->dims_get(config_, dims, "nx", &nx);
     config->dims_get(config_, dims, "nu", &nu);
     config->dims_get(config_, dims, "nz", &nz);
+    config->dims_get(config_, dims, "n_dense", &n_dense);
 
     int NF = nx + nu;
     size += sizeof(sim_info);
@@ -259,6 +273,9 @@ int sim_out_calculate_size(void *config_, void *dims)
 
     size += NF * sizeof(double);                // grad
 
+    size += n_dense * nx * sizeof(double);      // x_dense
+    size += n_dense * nx * NF * sizeof(double); // S_dense
+
     make_int_multiple_of(8, &size);
     size += 1 * 8;
 
@@ -273,10 +290,11 @@ sim_out *sim_out_assign(void *config_, void *dims, void *raw_memory)
 
     char *c_ptr = (char *) raw_memory;
 
-    int nx, nu, nz;
+    int nx, nu, nz, n_dense;
     config->dims_get(config_, dims, "nx", &nx);
     config->dims_get(config_, dims, "nu", &nu);
     config->dims_get(config_, dims, "nz", &nz);
+    config->dims_get(config_, dims, "n_dense", &n_dense);
 
     int NF = nx + nu;
 
@@ -297,6 +315,9 @@ sim_out *sim_out_assign(void *config_, void *dims, void *raw_memory)
     assign_and_advance_double(nz, &out->zn, &c_ptr);
     assign_and_advance_double(nz * NF, &out->S_algebraic, &c_ptr);
 
+    assign_and_advance_double(n_dense * nx, &out->x_dense, &c_ptr);
+    assign_and_advance_double(n_dense * nx * NF, &out->S_dense, &c_ptr);
+
     assert((char *) raw_memory + sim_out_calculate_size(config_, dims) >= c_ptr);
 
     return out;
@@ -391,6 +412,26 @@ int sim_out_get_(void *config_, void *dims_, sim_out *out, const char *field, vo
         for (int ii=0; ii < nz*(nu+nx); ii++)
             S_algebraic[ii] = out->S_algebraic[ii];
     }
+    else if (!strcmp(field, "x_dense"))
+    {
+        int nx, n_dense;
+        config->dims_get(config_, dims_, "nx", &nx);
+        config->dims_get(config_, dims_, "n_dense", &n_dense);
+        double *x_dense = value;
+        for (int ii=0; ii < n_dense*nx; ii++)
+            x_dense[ii] = out->x_dense[ii];
+    }
+    else if (!strcmp(field, "S_dense"))
+    {
+        // note: this assumes nf = nu+nx !!!
+        int nx, nu, n_dense;
+        config->dims_get(config_, dims_, "nx", &nx);
+        config->dims_get(config_, dims_, "nu", &nu);
+        config->dims_get(config_, dims_, "n_dense", &n_dense);
+        double *S_dense = value;
+        for (int ii=0; ii < n_dense*nx*(nu+nx); ii++)
+            S_dense[ii] = out->S_dense[ii];
+    }
     else if (!strcmp(field, "CPUtime") || !strcmp(field, "time_tot"))
     {
         double *time = value;
@@ -417,6 +458,32 @@ int sim_out_get_(void *config_, void *dims_, sim_out *out, const char *field, vo
 
 
 
+/************************************************
+* dense output
+************************************************/
+
+int sim_dense_step_index(double t, double step, int num_steps, double *theta)
+{
+    // times outside of [0, num_steps*step] are clamped to the first and last step
+    int ss = (int) (t / step);
+    if (ss < 0)
+        ss = 0;
+    if (ss > num_steps - 1)
+        ss = num_steps - 1;
+
+    double th = t / step - ss;
+    if (th < 0.0)
+        th = 0.0;
+    if (th > 1.0)
+        th = 1.0;
+
+    *theta = th;
+
+    return ss;
+}
+
+
+
 /************************************************
 * sim_opts
 ************************************************/
@@ -439,6 +506,11 @@ void sim_opts_set_(sim_opts *opts, const char *field, void *value)
         int *newton_iter = (int *) value;
         opts->newton_iter = *newton_iter;
     }
+    else if (!strcmp(field, "newton_tol"))
+    {
+        double *newton_tol = (double *) value;
+        opts->newton_tol = *newton_tol;
+    }
     else if (!strcmp(field, "jac_reuse"))
     {
         bool *jac_reuse = (bool *) value;
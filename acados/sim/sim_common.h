@@ -87,6 +87,8 @@ typedef struct
 
     double T;  // simulation time
 
+    double *t_dense;  // t_dense[N_DENSE] - dense output times within [0, T]
+
 } sim_in;
 
 
@@ -114,6 +116,9 @@ typedef struct
 
     double *grad;  // gradient correction
 
+    double *x_dense;  // x_dense[N_DENSE*NX] - states at the dense output times t_dense
+    double *S_dense;  // S_dense[N_DENSE*NX*(NX+NU)] - forward sensitivities of x_dense
+
     sim_info *info;
 
 } sim_out;
@@ -133,6 +138,7 @@ typedef struct
     double *A_mat;
     double *c_vec;
     double *b_vec;
+    double *e_vec;  // b_vec - b_hat of an embedded pair, for error estimation
 
     bool sens_forw;
     bool sens_adj;
@@ -142,9 +148,16 @@ typedef struct
     bool sens_algebraic;  // 1 -- if S_algebraic should be computed
     bool exact_z_output;  // 1 -- if z, S_algebraic should be computed exactly, extra Newton iterations
 
+    // for explicit integrators with step size control
+    bool adaptive_steps;  // 1 -- if step sizes are chosen by the embedded error estimate
+    int max_num_steps;    // bound on the accepted + rejected steps, sizes the workspace
+    double abs_tol;
+    double rel_tol;
+
     // for explicit integrators: newton_iter == 0 && scheme == NULL
     // && jac_reuse=false
     int newton_iter;
+    double newton_tol;  // > 0: stop the Newton iterations once |rG|_inf <= newton_tol (IRK)
     bool jac_reuse;
     Newton_scheme *scheme;
 
@@ -212,6 +225,10 @@ sim_out *sim_out_assign(void *config, void *dims, void *raw_memory);
 //
 int sim_out_get_(void *config, void *dims, sim_out *out, const char *field, void *value);
 
+/* dense output */
+// returns the index of the step of size step containing time t and its relative position theta
+int sim_dense_step_index(double t, double step, int num_steps, double *theta);
+
 /* opts */
 //
 void sim_opts_set_(sim_opts *opts, const char *field, void *value);
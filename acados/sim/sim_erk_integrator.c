@@ -34,6 +34,7 @@
 
 // standard
 #include <assert.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -42,6 +43,11 @@
 #include "acados/sim/sim_erk_integrator.h"
 #include "acados/utils/mem.h"
 
+// step size controller of the adaptive integrator
+#define ERK_SAFETY 0.9
+#define ERK_FAC_MIN 0.2
+#define ERK_FAC_MAX 5.0
+
 /************************************************
  * dims
  ************************************************/
@@ -65,6 +71,7 @@ void *sim_erk_dims_assign(void *config_, void *raw_memory)
     dims->nx = 0;
     dims->nu = 0;
     dims->nz = 0;
+    dims->n_dense = 0;
 
     assert((char *) raw_memory + sim_erk_dims_calculate_size() >= c_ptr);
 
@@ -94,6 +101,10 @@ void sim_erk_dims_set(void *config_, void *dims_, const char *field, const int *
             exit(1);
         }
     }
+    else if (!strcmp(field, "n_dense"))
+    {
+        dims->n_dense = *value;
+    }
     else
     {
         printf("\nerror: sim_erk_dims_set: dim type not available: %s\n", field);
@@ -119,6 +130,10 @@ void sim_erk_dims_get(void *config_, void *dims_, const char *field, int *value)
     {
         *value = 0;
     }
+    else if (!strcmp(field, "n_dense"))
+    {
+        *value = dims->n_dense;
+    }
     else
     {
         printf("\nerror: sim_erk_dims_get: dim type not available: %s\n", field);
@@ -199,6 +214,7 @@ int sim_erk_opts_calculate_size(void *config_, void *dims)
     size += ns_max * ns_max * sizeof(double);  // A_mat
     size += ns_max * sizeof(double);           // b_vec
     size += ns_max * sizeof(double);           // c_vec
+    size += ns_max * sizeof(double);           // e_vec
 
     make_int_multiple_of(8, &size);
     size += 1 * 8;
@@ -222,10 +238,12 @@ void *sim_erk_opts_assign(void *config_, void *dims, void *raw_memory)
     assign_and_advance_double(ns_max * ns_max, &opts->A_mat, &c_ptr);
     assign_and_advance_double(ns_max, &opts->b_vec, &c_ptr);
     assign_and_advance_double(ns_max, &opts->c_vec, &c_ptr);
+    assign_and_advance_double(ns_max, &opts->e_vec, &c_ptr);
 
     assert((char *) raw_memory + sim_erk_opts_calculate_size(config_, dims) >= c_ptr);
 
     opts->newton_iter = 0;
+    opts->newton_tol = 0.0;
     opts->scheme = NULL;
     opts->jac_reuse = false;
 
@@ -237,7 +255,37 @@ void *sim_erk_opts_assign(void *config_, void *dims, void *raw_memory)
 void sim_erk_opts_set(void *config_, void *opts_, const char *field, void *value)
 {
     sim_opts *opts = (sim_opts *) opts_;
-    sim_opts_set_(opts, field, value);
+
+    if (!strcmp(field, "adaptive_steps"))
+    {
+        bool *adaptive_steps = (bool *) value;
+        opts->adaptive_steps = *adaptive_steps;
+    }
+    else if (!strcmp(field, "max_num_steps"))
+    {
+        int *max_num_steps = (int *) value;
+        if (*max_num_steps < 1)
+        {
+            printf("\nerror: sim_erk_opts_set: max_num_steps has to be positive, got %d\n",
+                   *max_num_steps);
+            exit(1);
+        }
+        opts->max_num_steps = *max_num_steps;
+    }
+    else if (!strcmp(field, "abs_tol"))
+    {
+        double *abs_tol = (double *) value;
+        opts->abs_tol = *abs_tol;
+    }
+    else if (!strcmp(field, "rel_tol"))
+    {
+        double *rel_tol = (double *) value;
+        opts->rel_tol = *rel_tol;
+    }
+    else
+    {
+        sim_opts_set_(opts, field, value);
+    }
 }
 
 
@@ -250,15 +298,28 @@ void sim_erk_opts_get(void *config_, void *opts_, const char *field, void *value
 
 
 
-void sim_erk_opts_initialize_default(void *config_, void *dims_, void *opts_)
+// fills the Butcher tableau for opts->ns stages;
+// with adaptive_steps, ns = 4 is the Bogacki-Shampine 3(2) and ns = 7 the Dormand-Prince 5(4) pair,
+// e_vec holds the difference between the weights of the propagated and the embedded solution
+static void sim_erk_set_tableau(sim_opts *opts)
 {
-    sim_opts *opts = opts_;
-    sim_erk_dims *dims = (sim_erk_dims *) dims_;
-
-    opts->ns = 4;  // ERK 4
     int ns = opts->ns;
 
-    assert((ns == 1 || ns == 2 || ns == 4) && "only number of stages = {1,2,4} implemented!");
+    if (opts->adaptive_steps)
+    {
+        if (ns != 4 && ns != 7)
+        {
+            printf("\nerror: sim_erk: adaptive steps only implemented for ns = {4,7}, got %d\n", ns);
+            exit(1);
+        }
+    }
+    else if (ns != 1 && ns != 2 && ns != 4 && ns != 7)
+    {
+        printf("\nerror: sim_erk: only number of stages = {1,2,4,7} implemented, got %d\n", ns);
+        exit(1);
+    }
+
+    assert(ns <= NS_MAX && "ns > NS_MAX!");
 
     // set tableau size
     opts->tableau_size = opts->ns;
@@ -266,13 +327,17 @@ void sim_erk_opts_initialize_default(void *config_, void *dims_, void *opts_)
     double *A = opts->A_mat;
     double *b = opts->b_vec;
     double *c = opts->c_vec;
+    double *e = opts->e_vec;
+
+    for (int ii = 0; ii < ns * ns; ii++)
+        A[ii] = 0.0;
+    for (int ii = 0; ii < ns; ii++)
+        e[ii] = 0.0;
 
     switch (ns)
     {
         case 1:
         {
-            // A
-            A[0 + ns * 0] = 0.0;
             // b
             b[0] = 1.0;
             // c
@@ -282,10 +347,7 @@ void sim_erk_opts_initialize_default(void *config_, void *dims_, void *opts_)
         case 2:
         {
             // A
-            A[0 + ns * 0] = 0.0;
-            A[0 + ns * 1] = 0.0;
             A[1 + ns * 0] = 0.5;
-            A[1 + ns * 1] = 0.0;
             // b
             b[0] = 0.0;
             b[1] = 1.0;
@@ -296,137 +358,183 @@ void sim_erk_opts_initialize_default(void *config_, void *dims_, void *opts_)
         }
         case 4:
         {
+            if (!opts->adaptive_steps)
+            {
+                // A
+                A[1 + ns * 0] = 0.5;
+                A[2 + ns * 1] = 0.5;
+                A[3 + ns * 2] = 1.0;
+                // b
+                b[0] = 1.0 / 6.0;
+                b[1] = 1.0 / 3.0;
+                b[2] = 1.0 / 3.0;
+                b[3] = 1.0 / 6.0;
+                // c
+                c[0] = 0.0;
+                c[1] = 0.5;
+                c[2] = 0.5;
+                c[3] = 1.0;
+            }
+            else
+            {
+                // Bogacki-Shampine 3(2)
+                // A
+                A[1 + ns * 0] = 1.0 / 2.0;
+                A[2 + ns * 1] = 3.0 / 4.0;
+                A[3 + ns * 0] = 2.0 / 9.0;
+                A[3 + ns * 1] = 1.0 / 3.0;
+                A[3 + ns * 2] = 4.0 / 9.0;
+                // b
+                b[0] = 2.0 / 9.0;
+                b[1] = 1.0 / 3.0;
+                b[2] = 4.0 / 9.0;
+                b[3] = 0.0;
+                // c
+                c[0] = 0.0;
+                c[1] = 1.0 / 2.0;
+                c[2] = 3.0 / 4.0;
+                c[3] = 1.0;
+                // e = b - b_hat
+                e[0] = - 5.0 / 72.0;
+                e[1] = 1.0 / 12.0;
+                e[2] = 1.0 / 9.0;
+                e[3] = - 1.0 / 8.0;
+            }
+            break;
+        }
+        case 7:
+        {
+            // Dormand-Prince 5(4)
             // A
-            A[0 + ns * 0] = 0.0;
-            A[0 + ns * 1] = 0.0;
-            A[0 + ns * 2] = 0.0;
-            A[0 + ns * 3] = 0.0;
-            A[1 + ns * 0] = 0.5;
-            A[1 + ns * 1] = 0.0;
-            A[1 + ns * 2] = 0.0;
-            A[1 + ns * 3] = 0.0;
-            A[2 + ns * 0] = 0.0;
-            A[2 + ns * 1] = 0.5;
-            A[2 + ns * 2] = 0.0;
-            A[2 + ns * 3] = 0.0;
-            A[3 + ns * 0] = 0.0;
-            A[3 + ns * 1] = 0.0;
-            A[3 + ns * 2] = 1.0;
-            A[3 + ns * 3] = 0.0;
+            A[1 + ns * 0] = 1.0 / 5.0;
+            A[2 + ns * 0] = 3.0 / 40.0;
+            A[2 + ns * 1] = 9.0 / 40.0;
+            A[3 + ns * 0] = 44.0 / 45.0;
+            A[3 + ns * 1] = - 56.0 / 15.0;
+            A[3 + ns * 2] = 32.0 / 9.0;
+            A[4 + ns * 0] = 19372.0 / 6561.0;
+            A[4 + ns * 1] = - 25360.0 / 2187.0;
+            A[4 + ns * 2] = 64448.0 / 6561.0;
+            A[4 + ns * 3] = - 212.0 / 729.0;
+            A[5 + ns * 0] = 9017.0 / 3168.0;
+            A[5 + ns * 1] = - 355.0 / 33.0;
+            A[5 + ns * 2] = 46732.0 / 5247.0;
+            A[5 + ns * 3] = 49.0 / 176.0;
+            A[5 + ns * 4] = - 5103.0 / 18656.0;
+            A[6 + ns * 0] = 35.0 / 384.0;
+            A[6 + ns * 2] = 500.0 / 1113.0;
+            A[6 + ns * 3] = 125.0 / 192.0;
+            A[6 + ns * 4] = - 2187.0 / 6784.0;
+            A[6 + ns * 5] = 11.0 / 84.0;
             // b
-            b[0] = 1.0 / 6.0;
-            b[1] = 1.0 / 3.0;
-            b[2] = 1.0 / 3.0;
-            b[3] = 1.0 / 6.0;
+            b[0] = 35.0 / 384.0;
+            b[1] = 0.0;
+            b[2] = 500.0 / 1113.0;
+            b[3] = 125.0 / 192.0;
+            b[4] = - 2187.0 / 6784.0;
+            b[5] = 11.0 / 84.0;
+            b[6] = 0.0;
             // c
             c[0] = 0.0;
-            c[1] = 0.5;
-            c[2] = 0.5;
-            c[3] = 1.0;
+            c[1] = 1.0 / 5.0;
+            c[2] = 3.0 / 10.0;
+            c[3] = 4.0 / 5.0;
+            c[4] = 8.0 / 9.0;
+            c[5] = 1.0;
+            c[6] = 1.0;
+            // e = b - b_hat
+            e[0] = 71.0 / 57600.0;
+            e[1] = 0.0;
+            e[2] = - 71.0 / 16695.0;
+            e[3] = 71.0 / 1920.0;
+            e[4] = - 17253.0 / 339200.0;
+            e[5] = 22.0 / 525.0;
+            e[6] = - 1.0 / 40.0;
             break;
         }
         default:
         {
             // impossible
-            assert((ns == 1 || ns == 2 || ns == 4) &&
-                   "only number of stages = {1,2,4} implemented!");
+            assert((ns == 1 || ns == 2 || ns == 4 || ns == 7) &&
+                   "only number of stages = {1,2,4,7} implemented!");
         }
     }
 
-    opts->num_steps = 1;
-    opts->num_forw_sens = dims->nx + dims->nu;
-    opts->sens_forw = true;
-    opts->sens_adj = false;
-    opts->sens_hess = false;
-
-    opts->output_z = false;
-    opts->sens_algebraic = false;
+    return;
 }
 
 
 
-void sim_erk_opts_update(void *config_, void *dims, void *opts_)
+// continuous extension of the tableau: weights bt(theta) with x(t0 + theta*step) = x0 + step*sum bt_i K_i
+// and bt(1) = b; for the FSAL pairs (ns = 4 adaptive, ns = 7) the last stage is f(x1)
+static void sim_erk_dense_weights(sim_opts *opts, double theta, double *bt)
 {
-    sim_opts *opts = opts_;
-
     int ns = opts->ns;
-
-    opts->tableau_size = opts->ns;
-
-    assert((ns == 1 || ns == 2 || ns == 4) && "only number of stages = {1,2,4} implemented!");
-
-    assert(ns <= NS_MAX && "ns > NS_MAX!");
-
-    // set tableau size
-    opts->tableau_size = opts->ns;
-
-    double *A = opts->A_mat;
     double *b = opts->b_vec;
-    double *c = opts->c_vec;
+
+    double th2 = theta * theta;
+    double th3 = th2 * theta;
 
     switch (ns)
     {
         case 1:
         {
-            // A
-            A[0 + ns * 0] = 0.0;
-            // b
-            b[0] = 1.0;
-            // c
-            c[0] = 0.0;
+            bt[0] = theta;
             break;
         }
         case 2:
         {
-            // A
-            A[0 + ns * 0] = 0.0;
-            A[0 + ns * 1] = 0.0;
-            A[1 + ns * 0] = 0.5;
-            A[1 + ns * 1] = 0.0;
-            // b
-            b[0] = 0.0;
-            b[1] = 1.0;
-            // c
-            c[0] = 0.0;
-            c[1] = 0.5;
+            bt[0] = theta - th2;
+            bt[1] = th2;
             break;
         }
         case 4:
         {
-            // A
-            A[0 + ns * 0] = 0.0;
-            A[0 + ns * 1] = 0.0;
-            A[0 + ns * 2] = 0.0;
-            A[0 + ns * 3] = 0.0;
-            A[1 + ns * 0] = 0.5;
-            A[1 + ns * 1] = 0.0;
-            A[1 + ns * 2] = 0.0;
-            A[1 + ns * 3] = 0.0;
-            A[2 + ns * 0] = 0.0;
-            A[2 + ns * 1] = 0.5;
-            A[2 + ns * 2] = 0.0;
-            A[2 + ns * 3] = 0.0;
-            A[3 + ns * 0] = 0.0;
-            A[3 + ns * 1] = 0.0;
-            A[3 + ns * 2] = 1.0;
-            A[3 + ns * 3] = 0.0;
-            // b
-            b[0] = 1.0 / 6.0;
-            b[1] = 1.0 / 3.0;
-            b[2] = 1.0 / 3.0;
-            b[3] = 1.0 / 6.0;
-            // c
-            c[0] = 0.0;
-            c[1] = 0.5;
-            c[2] = 0.5;
-            c[3] = 1.0;
+            if (!opts->adaptive_steps)
+            {
+                // third order interpolant of RK4
+                bt[0] = theta - 1.5 * th2 + 2.0 / 3.0 * th3;
+                bt[1] = th2 - 2.0 / 3.0 * th3;
+                bt[2] = th2 - 2.0 / 3.0 * th3;
+                bt[3] = - 0.5 * th2 + 2.0 / 3.0 * th3;
+            }
+            else
+            {
+                // cubic Hermite interpolation of x0, x1, K1 = f(x0), K4 = f(x1)
+                for (int ii = 0; ii < ns; ii++)
+                    bt[ii] = b[ii] * (3.0 * th2 - 2.0 * th3);
+                bt[0] += th3 - 2.0 * th2 + theta;
+                bt[3] += th3 - th2;
+            }
+            break;
+        }
+        case 7:
+        {
+            // fourth order interpolant of Dormand-Prince, see Hairer, Norsett, Wanner (1993)
+            double d[7];
+            d[0] = - 12715105075.0 / 11282082432.0;
+            d[1] = 0.0;
+            d[2] = 87487479700.0 / 32700410799.0;
+            d[3] = - 10690763975.0 / 1880347072.0;
+            d[4] = 701980252875.0 / 199316789632.0;
+            d[5] = - 1453857185.0 / 822651844.0;
+            d[6] = 69997945.0 / 29380423.0;
+
+            double th1m = 1.0 - theta;
+            for (int ii = 0; ii < ns; ii++)
+            {
+                bt[ii] = theta * b[ii] - theta * th1m * b[ii] + 2.0 * th2 * th1m * b[ii]
+                         + th2 * th1m * th1m * d[ii];
+            }
+            bt[0] += theta * th1m - th2 * th1m;
+            bt[6] -= th2 * th1m;
             break;
         }
         default:
         {
             // impossible
-            assert((ns == 1 || ns == 2 || ns == 4) &&
-                   "only number of stages = {1,2,4} implemented!");
+            assert((ns == 1 || ns == 2 || ns == 4 || ns == 7) &&
+                   "only number of stages = {1,2,4,7} implemented!");
         }
     }
 
@@ -435,6 +543,43 @@ void sim_erk_opts_update(void *config_, void *dims, void *opts_)
 
 
 
+void sim_erk_opts_initialize_default(void *config_, void *dims_, void *opts_)
+{
+    sim_opts *opts = opts_;
+    sim_erk_dims *dims = (sim_erk_dims *) dims_;
+
+    opts->ns = 4;  // ERK 4
+
+    opts->adaptive_steps = false;
+    opts->max_num_steps = 100;
+    opts->abs_tol = 1e-6;
+    opts->rel_tol = 1e-6;
+
+    sim_erk_set_tableau(opts);
+
+    opts->num_steps = 1;
+    opts->num_forw_sens = dims->nx + dims->nu;
+    opts->sens_forw = true;
+    opts->sens_adj = false;
+    opts->sens_hess = false;
+
+    opts->output_z = false;
+    opts->sens_algebraic = false;
+}
+
+
+
+void sim_erk_opts_update(void *config_, void *dims, void *opts_)
+{
+    sim_opts *opts = opts_;
+
+    sim_erk_set_tableau(opts);
+
+    return;
+}
+
+
+
 /************************************************
  * memory
  ************************************************/
@@ -455,6 +600,10 @@ void *sim_erk_memory_assign(void *config, void *dims, void *opts_, void *raw_mem
     sim_erk_memory *mem = (sim_erk_memory *) c_ptr;
     c_ptr += sizeof(sim_erk_memory);
 
+    mem->num_steps = 0;
+    mem->num_rejected_steps = 0;
+    mem->step_last = 0.0;
+
     return mem;
 }
 
@@ -506,6 +655,21 @@ void sim_erk_memory_get(void *config_, void *dims_, void *mem_, const char *fiel
         double *ptr = value;
         *ptr = mem->time_la;
     }
+    else if (!strcmp(field, "num_steps"))
+    {
+        int *ptr = value;
+        *ptr = mem->num_steps;
+    }
+    else if (!strcmp(field, "num_rejected_steps"))
+    {
+        int *ptr = value;
+        *ptr = mem->num_rejected_steps;
+    }
+    else if (!strcmp(field, "step_last"))
+    {
+        double *ptr = value;
+        *ptr = mem->step_last;
+    }
     else
     {
         printf("sim_erk_memory_get field %s is not supported! \n", field);
@@ -532,7 +696,8 @@ int sim_erk_workspace_calculate_size(void *config_, void *dims_, void *opts_)
 
     int nX = nx * (1 + nf);  // (nx) for ODE and (nf*nx) for VDE
     int nhess = (nf + 1) * nf / 2;
-    int num_steps = opts->num_steps;  // number of steps
+    // with adaptive steps the trajectory is stored for the worst case
+    int num_steps = opts->adaptive_steps ? opts->max_num_steps : opts->num_steps;
 
     int size = sizeof(sim_erk_workspace);
 
@@ -542,11 +707,14 @@ int sim_erk_workspace_calculate_size(void *config_, void *dims_, void *opts_)
     {
         size += num_steps * ns * nX * sizeof(double);   // K_traj
         size += (num_steps + 1) * nX * sizeof(double);  // out_forw_traj
+        size += num_steps * sizeof(double);             // step_traj
     }
     else
     {
         size += ns * nX * sizeof(double);  // K_traj
         size += nX * sizeof(double);       // out_forw_traj
+        if (opts->adaptive_steps)
+            size += nX * sizeof(double);   // forw_tmp
     }
 
     if (opts->sens_hess) // && opts->sens_adj)
@@ -583,7 +751,7 @@ static void *sim_erk_cast_workspace(void *config_, void *dims_, void *opts_, voi
 
     int nX = nx * (1 + nf);  // (nx) for ODE and (nf*nx) for VDE
     int nhess = (nf + 1) * nf / 2;
-    int num_steps = opts->num_steps;  // number of steps
+    int num_steps = opts->adaptive_steps ? opts->max_num_steps : opts->num_steps;
 
     char *c_ptr = (char *) raw_memory;
 
@@ -608,7 +776,9 @@ static void *sim_erk_cast_workspace(void *config_, void *dims_, void *opts_, voi
         //assign_and_advance_double((num_steps + 1) * nX, &workspace->out_forw_traj, &c_ptr);
         work->out_forw_traj = d_ptr;
         d_ptr += (num_steps+1)*nX;
-        
+        work->step_traj = d_ptr;
+        d_ptr += num_steps;
+        work->forw_tmp = NULL;
     }
     else
     {
@@ -618,6 +788,13 @@ static void *sim_erk_cast_workspace(void *config_, void *dims_, void *opts_, voi
         //assign_and_advance_double(nX, &workspace->out_forw_traj, &c_ptr);
         work->out_forw_traj = d_ptr;
         d_ptr += nX;
+        work->step_traj = NULL;
+        work->forw_tmp = NULL;
+        if (opts->adaptive_steps)
+        {
+            work->forw_tmp = d_ptr;
+            d_ptr += nX;
+        }
     }
 
     if (opts->sens_hess) // && opts->sens_adj)
@@ -665,6 +842,197 @@ int sim_erk_precompute(void *config_, sim_in *in, sim_out *out, void *opts_, voi
 
 
 
+// one ERK step of size step from forw_traj_in, with stage values K_traj;
+// forw_traj_out may alias forw_traj_in
+static void sim_erk_step(sim_erk_dims *dims, sim_opts *opts, erk_model *model,
+                         sim_erk_workspace *work, double step, double *forw_traj_in,
+                         double *K_traj, double *forw_traj_out, double *timing_ad)
+{
+    int i, j, s;
+    double a = 0, b = 0;  // temp values of A_mat and b_vec
+
+    int ns = opts->ns;
+    int nx = dims->nx;
+    int nu = dims->nu;
+
+    int nf = opts->num_forw_sens;
+    if (!opts->sens_forw) nf = 0;
+    int nX = nx + nx * nf;
+
+    double *A_mat = opts->A_mat;
+    double *b_vec = opts->b_vec;
+
+    double *rhs_forw_in = work->rhs_forw_in;
+
+    ext_fun_arg_t ext_fun_type_in[5];
+    void *ext_fun_in[5];
+    ext_fun_arg_t ext_fun_type_out[3];
+    void *ext_fun_out[3];
+
+    acados_timer timer_ad;
+
+    for (s = 0; s < ns; s++)
+    {
+        for (i = 0; i < nX; i++)
+            rhs_forw_in[i] = forw_traj_in[i];
+        for (j = 0; j < s; j++)
+        {
+            a = A_mat[j * ns + s];
+            if (a != 0)
+            {
+                a *= step;
+                for (i = 0; i < nX; i++)
+                    rhs_forw_in[i] += a * K_traj[j * nX + i];
+            }
+        }
+
+        acados_tic(&timer_ad);
+        if (opts->sens_forw)
+        {  // simulation + forward sensitivities
+            ext_fun_type_in[0] = COLMAJ;
+            ext_fun_in[0] = rhs_forw_in + 0;  // x: nx
+            ext_fun_type_in[1] = COLMAJ;
+            ext_fun_in[1] = rhs_forw_in + nx;  // Sx: nx*nx
+            ext_fun_type_in[2] = COLMAJ;
+            ext_fun_in[2] = rhs_forw_in + nx + nx * nx;  // Su: nx*nu
+            ext_fun_type_in[3] = COLMAJ;
+            ext_fun_in[3] = rhs_forw_in + nx + nx * nx + nx * nu;  // u: nu
+
+            ext_fun_type_out[0] = COLMAJ;
+            ext_fun_out[0] = K_traj + s * nX + 0;  // fun: nx
+            ext_fun_type_out[1] = COLMAJ;
+            ext_fun_out[1] = K_traj + s * nX + nx;  // Sx: nx*nx
+            ext_fun_type_out[2] = COLMAJ;
+            ext_fun_out[2] = K_traj + s * nX + nx + nx * nx;  // Su: nx*nu
+
+            // forward VDE evaluation
+            model->expl_vde_for->evaluate(model->expl_vde_for, ext_fun_type_in, ext_fun_in,
+                                          ext_fun_type_out, ext_fun_out);
+        }
+        else
+        {  // simulation only
+            ext_fun_type_in[0] = COLMAJ;
+            ext_fun_in[0] = rhs_forw_in + 0;  // x: nx
+            ext_fun_type_in[1] = COLMAJ;
+            ext_fun_in[1] = rhs_forw_in + nx;  // u: nu
+
+            ext_fun_type_out[0] = COLMAJ;
+            ext_fun_out[0] = K_traj + s * nX + 0;  // fun: nx
+
+            if (model->expl_ode_fun == 0)
+            {
+                printf("sim ERK: expl_ode_fun is not provided. Exiting.\n");
+                exit(1);
+            }
+            model->expl_ode_fun->evaluate(model->expl_ode_fun, ext_fun_type_in, ext_fun_in,
+                                          ext_fun_type_out, ext_fun_out);  // ODE evaluation
+        }
+        *timing_ad += acados_toc(&timer_ad);
+    }
+
+    if (forw_traj_out != forw_traj_in)
+    {
+        for (i = 0; i < nX; i++)
+            forw_traj_out[i] = forw_traj_in[i];
+    }
+    for (s = 0; s < ns; s++)
+    {
+        b = step * b_vec[s];
+        for (i = 0; i < nX; i++) forw_traj_out[i] += b * K_traj[s * nX + i];  // ERK step
+    }
+
+    return;
+}
+
+
+
+// dense output of the step of size step starting at t0, from the post-step values forw_traj_out;
+// the points of in->t_dense within the step (or before the first / after the last step) are filled
+static void sim_erk_dense_output(sim_erk_dims *dims, sim_opts *opts, sim_in *in, sim_out *out,
+                                 double t0, double step, bool last, double *K_traj,
+                                 double *forw_traj_out)
+{
+    int ns = opts->ns;
+    int nx = dims->nx;
+    int n_dense = dims->n_dense;
+
+    int nf = opts->num_forw_sens;
+    if (!opts->sens_forw) nf = 0;
+    int nX = nx + nx * nf;
+
+    double *b_vec = opts->b_vec;
+    double bt[NS_MAX];
+
+    double t, theta, w;
+
+    for (int kk = 0; kk < n_dense; kk++)
+    {
+        t = in->t_dense[kk];
+        if ((t < t0 && t0 > 0.0) || (t >= t0 + step && !last))
+            continue;
+
+        theta = (t - t0) / step;
+        if (theta < 0.0)
+            theta = 0.0;
+        if (theta > 1.0)
+            theta = 1.0;
+
+        sim_erk_dense_weights(opts, theta, bt);
+
+        double *x_dense = out->x_dense + kk * nx;
+        double *S_dense = out->S_dense + kk * nx * nf;
+
+        for (int i = 0; i < nx; i++)
+            x_dense[i] = forw_traj_out[i];
+        for (int i = 0; i < nx * nf; i++)
+            S_dense[i] = forw_traj_out[nx + i];
+
+        // x(t0 + theta*step) = x(t0 + step) - step * sum (b_i - bt_i) K_i
+        for (int s = 0; s < ns; s++)
+        {
+            w = step * (b_vec[s] - bt[s]);
+            if (w != 0)
+            {
+                for (int i = 0; i < nx; i++)
+                    x_dense[i] -= w * K_traj[s * nX + i];
+                for (int i = 0; i < nx * nf; i++)
+                    S_dense[i] -= w * K_traj[s * nX + nx + i];
+            }
+        }
+    }
+
+    return;
+}
+
+
+
+// scaled RMS norm of the embedded error estimate of the states (not the sensitivities)
+static double sim_erk_error_norm(int nx, int nX, sim_opts *opts, double step,
+                                 double *forw_traj_in, double *K_traj, double *forw_traj_out)
+{
+    int ns = opts->ns;
+    double *e_vec = opts->e_vec;
+
+    double err = 0.0;
+    double tmp, scale;
+
+    for (int i = 0; i < nx; i++)
+    {
+        tmp = 0.0;
+        for (int s = 0; s < ns; s++)
+            tmp += e_vec[s] * K_traj[s * nX + i];
+        tmp *= step;
+
+        scale = opts->abs_tol +
+                opts->rel_tol * fmax(fabs(forw_traj_in[i]), fabs(forw_traj_out[i]));
+        err += (tmp / scale) * (tmp / scale);
+    }
+
+    return sqrt(err / nx);
+}
+
+
+
 int sim_erk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, void *work_)
 {
     sim_config *config = config_;
@@ -690,6 +1058,8 @@ int sim_erk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
     int nu = dims->nu;
     int nz = dims->nz;
 
+    int status = ACADOS_SUCCESS;
+
     // assert - only use supported features
     if (nz != 0)
     {
@@ -763,81 +1133,124 @@ int sim_erk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
     }
     for (i = 0; i < nu; i++) rhs_forw_in[nX + i] = u[i];  // controls
 
-    for (istep = 0; istep < num_steps; istep++)
+    int store_traj = opts->sens_adj | opts->sens_hess;
+    int num_rejected = 0;
+
+    if (!opts->adaptive_steps)
     {
-        if (opts->sens_adj | opts->sens_hess)
+        for (istep = 0; istep < num_steps; istep++)
         {
-            K_traj = work->K_traj + istep * ns * nX;
-            forw_traj = work->out_forw_traj + (istep + 1) * nX;
-            for (i = 0; i < nX; i++)
-                forw_traj[i] = forw_traj[i - nX];
+            if (store_traj)
+            {
+                K_traj = work->K_traj + istep * ns * nX;
+                forw_traj = work->out_forw_traj + istep * nX;
+                sim_erk_step(dims, opts, model, work, step, forw_traj, K_traj, forw_traj + nX,
+                             &timing_ad);
+                work->step_traj[istep] = step;
+                if (dims->n_dense > 0)
+                    sim_erk_dense_output(dims, opts, in, out, istep * step, step,
+                                         istep == num_steps - 1, K_traj, forw_traj + nX);
+            }
+            else
+            {
+                sim_erk_step(dims, opts, model, work, step, forw_traj, K_traj, forw_traj,
+                             &timing_ad);
+                if (dims->n_dense > 0)
+                    sim_erk_dense_output(dims, opts, in, out, istep * step, step,
+                                         istep == num_steps - 1, K_traj, forw_traj);
+            }
         }
+    }
+    else
+    {
+        // order of the embedded solution
+        int q = ns == 4 ? 2 : 4;
+
+        double T = in->T;
+        double t = 0.0;
+        double fac_max = ERK_FAC_MAX;
+        double err, fac;
+        double *forw_traj_out;
+        int last;
 
-        for (s = 0; s < ns; s++)
+        step = mem->step_last > 0.0 ? mem->step_last : T / num_steps;
+
+        num_steps = 0;
+        while (t < T)
         {
-            for (i = 0; i < nX; i++)
-                rhs_forw_in[i] = forw_traj[i];
-            for (j = 0; j < s; j++)
+            last = 0;
+            if (t + step >= T)
             {
-                a = A_mat[j * ns + s];
-                if (a != 0)
-                {
-                    a *= step;
-                    for (i = 0; i < nX; i++)
-                        rhs_forw_in[i] += a * K_traj[j * nX + i];
-                }
+                step = T - t;
+                last = 1;
+            }
+            // the last attempt covers the rest of the interval and is accepted
+            if (num_steps + num_rejected == opts->max_num_steps - 1)
+            {
+                step = T - t;
+                last = 2;
             }
 
-            acados_tic(&timer_ad);
-            if (opts->sens_forw)
-            {  // simulation + forward sensitivities
-                ext_fun_type_in[0] = COLMAJ;
-                ext_fun_in[0] = rhs_forw_in + 0;  // x: nx
-                ext_fun_type_in[1] = COLMAJ;
-                ext_fun_in[1] = rhs_forw_in + nx;  // Sx: nx*nx
-                ext_fun_type_in[2] = COLMAJ;
-                ext_fun_in[2] = rhs_forw_in + nx + nx * nx;  // Su: nx*nu
-                ext_fun_type_in[3] = COLMAJ;
-                ext_fun_in[3] = rhs_forw_in + nx + nx * nx + nx * nu;  // u: nu
-
-                ext_fun_type_out[0] = COLMAJ;
-                ext_fun_out[0] = K_traj + s * nX + 0;  // fun: nx
-                ext_fun_type_out[1] = COLMAJ;
-                ext_fun_out[1] = K_traj + s * nX + nx;  // Sx: nx*nx
-                ext_fun_type_out[2] = COLMAJ;
-                ext_fun_out[2] = K_traj + s * nX + nx + nx * nx;  // Su: nx*nu
-
-                // forward VDE evaluation
-                model->expl_vde_for->evaluate(model->expl_vde_for, ext_fun_type_in, ext_fun_in,
-                                              ext_fun_type_out, ext_fun_out);
+            if (store_traj)
+            {
+                K_traj = work->K_traj + num_steps * ns * nX;
+                forw_traj = work->out_forw_traj + num_steps * nX;
+                forw_traj_out = forw_traj + nX;
             }
             else
-            {  // simulation only
-                ext_fun_type_in[0] = COLMAJ;
-                ext_fun_in[0] = rhs_forw_in + 0;  // x: nx
-                ext_fun_type_in[1] = COLMAJ;
-                ext_fun_in[1] = rhs_forw_in + nx;  // u: nu
+            {
+                forw_traj_out = work->forw_tmp;
+            }
 
-                ext_fun_type_out[0] = COLMAJ;
-                ext_fun_out[0] = K_traj + s * nX + 0;  // fun: nx
+            sim_erk_step(dims, opts, model, work, step, forw_traj, K_traj, forw_traj_out,
+                         &timing_ad);
+            err = sim_erk_error_norm(nx, nX, opts, step, forw_traj, K_traj, forw_traj_out);
 
-                if (model->expl_ode_fun == 0)
+            // err = NaN is rejected, fmax then falls back to ERK_FAC_MIN
+            fac = ERK_SAFETY * pow(err, -1.0 / (q + 1));
+
+            if (err <= 1.0 || last == 2)
+            {
+                if (dims->n_dense > 0)
+                    sim_erk_dense_output(dims, opts, in, out, t, step, last, K_traj,
+                                         forw_traj_out);
+
+                if (store_traj)
+                {
+                    work->step_traj[num_steps] = step;
+                }
+                else
                 {
-                    printf("sim ERK: expl_ode_fun is not provided. Exiting.\n");
-                    exit(1);
+                    for (i = 0; i < nX; i++) forw_traj[i] = forw_traj_out[i];
                 }
-                model->expl_ode_fun->evaluate(model->expl_ode_fun, ext_fun_type_in, ext_fun_in,
-                                              ext_fun_type_out, ext_fun_out);  // ODE evaluation
+                num_steps++;
+
+                t = last ? T : t + step;
+                if (last == 2 && err > 1.0)
+                    status = ACADOS_MAXITER;
+
+                step *= fmin(fac_max, fmax(ERK_FAC_MIN, fac));
+                fac_max = ERK_FAC_MAX;
+            }
+            else
+            {
+                num_rejected++;
+
+                step *= fmin(1.0, fmax(ERK_FAC_MIN, fac));
+                // no step increase right after a rejection
+                fac_max = 1.0;
             }
-            timing_ad += acados_toc(&timer_ad);
-        }
-        for (s = 0; s < ns; s++)
-        {
-            b = step * b_vec[s];
-            for (i = 0; i < nX; i++) forw_traj[i] += b * K_traj[s * nX + i];  // ERK step
         }
+
+        mem->step_last = step;
     }
 
+    if (store_traj)
+        forw_traj = work->out_forw_traj + num_steps * nX;
+
+    mem->num_steps = num_steps;
+    mem->num_rejected_steps = num_rejected;
+
     // store trajectory
     for (i = 0; i < nx; i++) xn[i] = forw_traj[i];
     // store forward sensitivities
@@ -878,6 +1291,7 @@ int sim_erk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
 
             K_traj = work->K_traj + istep * ns * nX;
             forw_traj = work->out_forw_traj + istep*nX;
+            step = work->step_traj[istep];
 
             for (s = ns - 1; s >= 0; s--)
             {
@@ -1021,7 +1435,7 @@ int sim_erk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
     mem->time_la = out->info->LAtime;
 
     // return
-    return 0;  // success
+    return status;
 }
 
 
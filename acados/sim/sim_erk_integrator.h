@@ -49,6 +49,7 @@ typedef struct
     int nx;
     int nu;
     int nz;
+    int n_dense;  // number of dense output times
 } sim_erk_dims;
 
 
@@ -76,6 +77,11 @@ typedef struct
 	double time_ad;
 	double time_la;
 
+	// step size control
+	int num_steps;           // accepted steps of the last call
+	int num_rejected_steps;  // rejected steps of the last call
+	double step_last;        // proposed step size, initial guess for the next call
+
 	// workspace structs
 } sim_erk_memory;
 
@@ -88,6 +94,8 @@ typedef struct
 
     double *K_traj;         // (stages*nX) or (steps*stages*nX) for adj
     double *out_forw_traj;  // S or (steps+1)*nX for adj
+    double *forw_tmp;       // nX, candidate step with adaptive steps and no adj
+    double *step_traj;      // steps, step sizes for adj
 
     double *rhs_adj_in;
     double *out_adj_tmp;
@@ -0,0 +1,750 @@
+/*
+ * Copyright 2019 Gianluca Frison, Dimitris Kouzoupis, Robin Verschueren,
+ * Andrea Zanelli, Niels van Duijkeren, Jonathan Frey, Tommaso Sartor,
+ * Branimir Novoselnik, Rien Quirynen, Rezart Qelibari, Dang Doan,
+ * Jonas Koenemann, Yutao Chen, Tobias Schöls, Jonas Schlagenhauf, Moritz Diehl
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+/* Exponential Euler integrator for semi-linear models f(x, u) = A_LO * x + N(x, u):
+ *     x_next = exp(step * A_LO) * x + step * phi_1(step * A_LO) * N(x, u) = x + P * f(x, u),
+ * with P = step * phi_1(step * A_LO), which is obtained from one matrix exponential and
+ * reused as long as the step size and A_LO do not change. The stiff linear part is integrated
+ * exactly, for A_LO = 0 the method is the explicit Euler method.
+ *
+ * The forward sensitivities are the exact derivatives of the discrete map, propagated from the
+ * identity seed; the forward seed is applied at the end and the adjoint sensitivities are
+ * computed from the forward sensitivities. */
+
+// standard
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+// acados
+#include "acados/sim/sim_common.h"
+#include "acados/sim/sim_exp_euler_integrator.h"
+#include "acados/utils/math.h"
+#include "acados/utils/mem.h"
+
+/************************************************
+ * dims
+ ************************************************/
+
+int sim_exp_euler_dims_calculate_size()
+{
+    int size = sizeof(sim_exp_euler_dims);
+
+    return size;
+}
+
+
+
+void *sim_exp_euler_dims_assign(void *config_, void *raw_memory)
+{
+    char *c_ptr = raw_memory;
+
+    sim_exp_euler_dims *dims = (sim_exp_euler_dims *) c_ptr;
+    c_ptr += sizeof(sim_exp_euler_dims);
+
+    dims->nx = 0;
+    dims->nu = 0;
+    dims->nz = 0;
+
+    assert((char *) raw_memory + sim_exp_euler_dims_calculate_size() >= c_ptr);
+
+    return dims;
+}
+
+
+
+void sim_exp_euler_dims_set(void *config_, void *dims_, const char *field, const int *value)
+{
+    sim_exp_euler_dims *dims = (sim_exp_euler_dims *) dims_;
+
+    if (!strcmp(field, "nx"))
+    {
+        dims->nx = *value;
+    }
+    else if (!strcmp(field, "nu"))
+    {
+        dims->nu = *value;
+    }
+    else if (!strcmp(field, "nz"))
+    {
+        if (*value != 0)
+        {
+            printf("\nerror: nz != 0\n");
+            printf("algebraic variables not supported by exponential Euler module\n");
+            exit(1);
+        }
+    }
+    else if (!strcmp(field, "n_dense"))
+    {
+        if (*value != 0)
+        {
+            printf("\nerror: n_dense != 0\n");
+            printf("dense output not supported by exponential Euler module\n");
+            exit(1);
+        }
+    }
+    else
+    {
+        printf("\nerror: sim_exp_euler_dims_set: dim type not available: %s\n", field);
+        exit(1);
+    }
+}
+
+
+
+void sim_exp_euler_dims_get(void *config_, void *dims_, const char *field, int *value)
+{
+    sim_exp_euler_dims *dims = (sim_exp_euler_dims *) dims_;
+
+    if (!strcmp(field, "nx"))
+    {
+        *value = dims->nx;
+    }
+    else if (!strcmp(field, "nu"))
+    {
+        *value = dims->nu;
+    }
+    else if (!strcmp(field, "nz"))
+    {
+        *value = 0;
+    }
+    else if (!strcmp(field, "n_dense"))
+    {
+        *value = 0;
+    }
+    else
+    {
+        printf("\nerror: sim_exp_euler_dims_get: dim type not available: %s\n", field);
+        exit(1);
+    }
+}
+
+
+
+/************************************************
+ * model
+ ************************************************/
+
+int sim_exp_euler_model_calculate_size(void *config, void *dims_)
+{
+    sim_exp_euler_dims *dims = (sim_exp_euler_dims *) dims_;
+
+    int nx = dims->nx;
+
+    int size = 0;
+
+    size += sizeof(exp_euler_model);
+
+    size += nx * nx * sizeof(double);  // A_LO
+
+    size += 8;  // align
+
+    return size;
+}
+
+
+
+void *sim_exp_euler_model_assign(void *config, void *dims_, void *raw_memory)
+{
+    sim_exp_euler_dims *dims = (sim_exp_euler_dims *) dims_;
+
+    int nx = dims->nx;
+
+    char *c_ptr = (char *) raw_memory;
+
+    exp_euler_model *model = (exp_euler_model *) c_ptr;
+    c_ptr += sizeof(exp_euler_model);
+
+    align_char_to(8, &c_ptr);
+
+    assign_and_advance_double(nx * nx, &model->A_LO, &c_ptr);
+
+    model->nx = nx;
+    model->expl_ode_fun = NULL;
+    model->expl_vde_for = NULL;
+    for (int ii = 0; ii < nx * nx; ii++)
+        model->A_LO[ii] = 0.0;
+
+    assert((char *) raw_memory + sim_exp_euler_model_calculate_size(config, dims) >= c_ptr);
+
+    return model;
+}
+
+
+
+int sim_exp_euler_model_set(void *model_, const char *field, void *value)
+{
+    exp_euler_model *model = model_;
+
+    if (!strcmp(field, "expl_ode_fun"))
+    {
+        model->expl_ode_fun = value;
+    }
+    else if (!strcmp(field, "expl_vde_for") || !strcmp(field, "expl_vde_forw"))
+    {
+        model->expl_vde_for = value;
+    }
+    else if (!strcmp(field, "A_LO"))
+    {
+        double *A_LO = value;
+        for (int ii = 0; ii < model->nx * model->nx; ii++)
+            model->A_LO[ii] = A_LO[ii];
+    }
+    else
+    {
+        printf("\nerror: sim_exp_euler_model_set: wrong field: %s\n", field);
+        exit(1);
+    }
+
+    return ACADOS_SUCCESS;
+}
+
+
+
+/************************************************
+ * opts
+ ************************************************/
+
+int sim_exp_euler_opts_calculate_size(void *config_, void *dims)
+{
+    int ns_max = NS_MAX;
+
+    int size = sizeof(sim_opts);
+
+    size += ns_max * ns_max * sizeof(double);  // A_mat
+    size += ns_max * sizeof(double);           // b_vec
+    size += ns_max * sizeof(double);           // c_vec
+    size += ns_max * sizeof(double);           // e_vec
+
+    make_int_multiple_of(8, &size);
+    size += 1 * 8;
+
+    return size;
+}
+
+
+
+void *sim_exp_euler_opts_assign(void *config_, void *dims, void *raw_memory)
+{
+    int ns_max = NS_MAX;
+
+    char *c_ptr = (char *) raw_memory;
+
+    sim_opts *opts = (sim_opts *) c_ptr;
+    c_ptr += sizeof(sim_opts);
+
+    align_char_to(8, &c_ptr);
+
+    assign_and_advance_double(ns_max * ns_max, &opts->A_mat, &c_ptr);
+    assign_and_advance_double(ns_max, &opts->b_vec, &c_ptr);
+    assign_and_advance_double(ns_max, &opts->c_vec, &c_ptr);
+    assign_and_advance_double(ns_max, &opts->e_vec, &c_ptr);
+
+    assert((char *) raw_memory + sim_exp_euler_opts_calculate_size(config_, dims) >= c_ptr);
+
+    opts->newton_iter = 0;
+    opts->newton_tol = 0.0;
+    opts->scheme = NULL;
+
+    return (void *) opts;
+}
+
+
+
+void sim_exp_euler_opts_set(void *config_, void *opts_, const char *field, void *value)
+{
+    sim_opts *opts = (sim_opts *) opts_;
+    sim_opts_set_(opts, field, value);
+}
+
+
+
+void sim_exp_euler_opts_get(void *config_, void *opts_, const char *field, void *value)
+{
+    sim_opts *opts = (sim_opts *) opts_;
+    sim_opts_get_(config_, opts, field, value);
+}
+
+
+
+// exponential Euler has one stage, the tableau is not used
+static void sim_exp_euler_set_tableau(sim_opts *opts)
+{
+    opts->ns = 1;
+    opts->tableau_size = 0;
+}
+
+
+
+void sim_exp_euler_opts_initialize_default(void *config_, void *dims_, void *opts_)
+{
+    sim_opts *opts = opts_;
+    sim_exp_euler_dims *dims = (sim_exp_euler_dims *) dims_;
+
+    sim_exp_euler_set_tableau(opts);
+
+    opts->adaptive_steps = false;
+
+    opts->num_steps = 1;
+    opts->num_forw_sens = dims->nx + dims->nu;
+    opts->jac_reuse = false;
+    opts->sens_forw = true;
+    opts->sens_adj = false;
+    opts->sens_hess = false;
+
+    opts->output_z = false;
+    opts->sens_algebraic = false;
+    opts->exact_z_output = false;
+}
+
+
+
+void sim_exp_euler_opts_update(void *config_, void *dims, void *opts_)
+{
+    sim_opts *opts = opts_;
+
+    sim_exp_euler_set_tableau(opts);
+
+    return;
+}
+
+
+
+/************************************************
+ * memory
+ ************************************************/
+
+int sim_exp_euler_memory_calculate_size(void *config, void *dims_, void *opts_)
+{
+    sim_exp_euler_dims *dims = (sim_exp_euler_dims *) dims_;
+
+    int nx = dims->nx;
+
+    int size = sizeof(sim_exp_euler_memory);
+
+    size += 2 * nx * nx * sizeof(double);  // P A_LO_P
+
+    size += 8;  // align
+
+    return size;
+}
+
+
+
+void *sim_exp_euler_memory_assign(void *config, void *dims_, void *opts_, void *raw_memory)
+{
+    char *c_ptr = (char *) raw_memory;
+
+    sim_exp_euler_dims *dims = (sim_exp_euler_dims *) dims_;
+
+    int nx = dims->nx;
+
+    sim_exp_euler_memory *mem = (sim_exp_euler_memory *) c_ptr;
+    c_ptr += sizeof(sim_exp_euler_memory);
+
+    align_char_to(8, &c_ptr);
+
+    assign_and_advance_double(nx * nx, &mem->P, &c_ptr);
+    assign_and_advance_double(nx * nx, &mem->A_LO_P, &c_ptr);
+
+    mem->time_sim = 0.0;
+    mem->time_ad = 0.0;
+    mem->time_la = 0.0;
+    mem->step_P = 0.0;
+
+    assert((char *) raw_memory + sim_exp_euler_memory_calculate_size(config, dims, opts_)
+           >= c_ptr);
+
+    return mem;
+}
+
+
+
+int sim_exp_euler_memory_set(void *config_, void *dims_, void *mem_, const char *field,
+                              void *value)
+{
+    printf("sim_exp_euler_memory_set field %s is not supported! \n", field);
+    exit(1);
+}
+
+
+
+int sim_exp_euler_memory_set_to_zero(void *config_, void * dims_, void *opts_, void *mem_,
+                                      const char *field)
+{
+    int status = ACADOS_SUCCESS;
+
+    if (!strcmp(field, "guesses"))
+    {
+        // no guesses/initialization in exponential Euler
+    }
+    else
+    {
+        printf("sim_exp_euler_memory_set_to_zero field %s is not supported! \n", field);
+        exit(1);
+    }
+
+    return status;
+}
+
+
+
+void sim_exp_euler_memory_get(void *config_, void *dims_, void *mem_, const char *field,
+                               void *value)
+{
+    sim_exp_euler_memory *mem = mem_;
+
+    if (!strcmp(field, "time_sim"))
+    {
+        double *ptr = value;
+        *ptr = mem->time_sim;
+    }
+    else if (!strcmp(field, "time_sim_ad"))
+    {
+        double *ptr = value;
+        *ptr = mem->time_ad;
+    }
+    else if (!strcmp(field, "time_sim_la"))
+    {
+        double *ptr = value;
+        *ptr = mem->time_la;
+    }
+    else
+    {
+        printf("sim_exp_euler_memory_get field %s is not supported! \n", field);
+        exit(1);
+    }
+}
+
+
+
+/************************************************
+ * workspace
+ ************************************************/
+
+int sim_exp_euler_workspace_calculate_size(void *config_, void *dims_, void *opts_)
+{
+    sim_exp_euler_dims *dims = (sim_exp_euler_dims *) dims_;
+
+    int nx = dims->nx;
+    int nu = dims->nu;
+
+    // sized for the sensitivities, which can be switched on and off after creation
+    int nX = nx * (1 + nx + nu);
+
+    int size = sizeof(sim_exp_euler_workspace);
+
+    size += 3 * nX * sizeof(double);  // forw rhs_out K
+    size += 4 * nx * nx * sizeof(double);  // aug
+
+    size += 8;  // align
+
+    return size;
+}
+
+
+
+static void *sim_exp_euler_cast_workspace(void *config_, void *dims_, void *opts_,
+                                          void *raw_memory)
+{
+    sim_exp_euler_dims *dims = (sim_exp_euler_dims *) dims_;
+
+    int nx = dims->nx;
+    int nu = dims->nu;
+
+    int nX = nx * (1 + nx + nu);
+
+    char *c_ptr = (char *) raw_memory;
+
+    sim_exp_euler_workspace *work = (sim_exp_euler_workspace *) c_ptr;
+    c_ptr += sizeof(sim_exp_euler_workspace);
+
+    align_char_to(8, &c_ptr);
+
+    assign_and_advance_double(nX, &work->forw, &c_ptr);
+    assign_and_advance_double(nX, &work->rhs_out, &c_ptr);
+    assign_and_advance_double(nX, &work->K, &c_ptr);
+    assign_and_advance_double(4 * nx * nx, &work->aug, &c_ptr);
+
+    assert((char *) raw_memory + sim_exp_euler_workspace_calculate_size(config_, dims, opts_)
+           >= c_ptr);
+
+    return (void *) work;
+}
+
+
+
+/************************************************
+ * functions
+ ************************************************/
+
+int sim_exp_euler_precompute(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_,
+                              void *work_)
+{
+    return ACADOS_SUCCESS;
+}
+
+
+
+// evaluates f (and with sens, the forward vde) at x_in = x + Sx + Su, writes f + Sx_dot + Su_dot
+static void sim_exp_euler_eval_rhs(exp_euler_model *model, int nx, int nu, int sens,
+                                    double *x_in, double *u, double *out)
+{
+    ext_fun_arg_t ext_fun_type_in[4];
+    void *ext_fun_in[4];
+    ext_fun_arg_t ext_fun_type_out[3];
+    void *ext_fun_out[3];
+
+    if (sens)
+    {
+        ext_fun_type_in[0] = COLMAJ;
+        ext_fun_in[0] = x_in;  // x: nx
+        ext_fun_type_in[1] = COLMAJ;
+        ext_fun_in[1] = x_in + nx;  // Sx: nx*nx
+        ext_fun_type_in[2] = COLMAJ;
+        ext_fun_in[2] = x_in + nx + nx * nx;  // Su: nx*nu
+        ext_fun_type_in[3] = COLMAJ;
+        ext_fun_in[3] = u;  // u: nu
+
+        ext_fun_type_out[0] = COLMAJ;
+        ext_fun_out[0] = out;  // fun: nx
+        ext_fun_type_out[1] = COLMAJ;
+        ext_fun_out[1] = out + nx;  // Sx: nx*nx
+        ext_fun_type_out[2] = COLMAJ;
+        ext_fun_out[2] = out + nx + nx * nx;  // Su: nx*nu
+
+        model->expl_vde_for->evaluate(model->expl_vde_for, ext_fun_type_in, ext_fun_in,
+                                      ext_fun_type_out, ext_fun_out);
+    }
+    else
+    {
+        ext_fun_type_in[0] = COLMAJ;
+        ext_fun_in[0] = x_in;  // x: nx
+        ext_fun_type_in[1] = COLMAJ;
+        ext_fun_in[1] = u;  // u: nu
+
+        ext_fun_type_out[0] = COLMAJ;
+        ext_fun_out[0] = out;  // fun: nx
+
+        model->expl_ode_fun->evaluate(model->expl_ode_fun, ext_fun_type_in, ext_fun_in,
+                                      ext_fun_type_out, ext_fun_out);
+    }
+}
+
+
+
+// P = step * phi_1(step * A_LO), the upper right block of expm([step * A_LO, step * eye(nx); 0, 0])
+static void sim_exp_euler_compute_P(int nx, double step, double *A_LO, double *aug, double *P)
+{
+    int n2 = 2 * nx;
+
+    for (int ii = 0; ii < n2 * n2; ii++)
+        aug[ii] = 0.0;
+    for (int jj = 0; jj < nx; jj++)
+    {
+        for (int ii = 0; ii < nx; ii++)
+            aug[ii + n2 * jj] = step * A_LO[ii + nx * jj];
+        aug[jj + n2 * (nx + jj)] = step;
+    }
+
+    expm(n2, aug);
+
+    for (int jj = 0; jj < nx; jj++)
+        for (int ii = 0; ii < nx; ii++)
+            P[ii + nx * jj] = aug[ii + n2 * (nx + jj)];
+}
+
+
+
+int sim_exp_euler(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, void *work_)
+{
+    sim_opts *opts = opts_;
+    sim_exp_euler_memory *mem = mem_;
+    sim_exp_euler_dims *dims = (sim_exp_euler_dims *) in->dims;
+    sim_exp_euler_workspace *work = sim_exp_euler_cast_workspace(config_, dims, opts, work_);
+    exp_euler_model *model = in->model;
+
+    int i, j, istep;
+    int nx = dims->nx;
+    int nu = dims->nu;
+
+    if (opts->sens_hess)
+    {
+        printf("\nerror: sim_exp_euler: hessian propagation not supported\n");
+        exit(1);
+    }
+
+    // the adjoint sensitivities are computed from the forward sensitivities
+    int sens = opts->sens_forw || opts->sens_adj;
+    int nf = sens ? nx + nu : 0;
+    int nX = nx * (1 + nf);
+
+    if ((sens && model->expl_vde_for == NULL) || (!sens && model->expl_ode_fun == NULL))
+    {
+        printf("\nerror: sim_exp_euler: %s is not provided\n",
+               sens ? "expl_vde_for" : "expl_ode_fun");
+        exit(1);
+    }
+
+    int num_steps = opts->num_steps;
+    double step = in->T / num_steps;
+
+    double *u = in->u;
+
+    double *forw = work->forw;
+    double *rhs_out = work->rhs_out;
+    double *K = work->K;
+    double *P = mem->P;
+
+    acados_timer timer, timer_ad, timer_la;
+    double timing_ad = 0.0;
+    double timing_la = 0.0;
+
+    acados_tic(&timer);
+
+    // update P if the step size or the linear part changed
+    int update_P = step != mem->step_P;
+    for (i = 0; i < nx * nx && !update_P; i++)
+        update_P = model->A_LO[i] != mem->A_LO_P[i];
+
+    acados_tic(&timer_la);
+    if (update_P)
+    {
+        sim_exp_euler_compute_P(nx, step, model->A_LO, work->aug, P);
+        for (i = 0; i < nx * nx; i++)
+            mem->A_LO_P[i] = model->A_LO[i];
+        mem->step_P = step;
+    }
+    timing_la += acados_toc(&timer_la);
+
+    // initialize forw = [x, eye(nx), zeros(nx, nu)]
+    for (i = 0; i < nx; i++)
+        forw[i] = in->x[i];
+    for (i = 0; i < nx * nf; i++)
+        forw[nx + i] = 0.0;
+    for (i = 0; i < nx && sens; i++)
+        forw[nx + i * (nx + 1)] = 1.0;
+
+    for (istep = 0; istep < num_steps; istep++)
+    {
+        // [f, df_dx * S + [0, df_du]]
+        acados_tic(&timer_ad);
+        sim_exp_euler_eval_rhs(model, nx, nu, sens, forw, u, rhs_out);
+        timing_ad += acados_toc(&timer_ad);
+
+        // forw += P * rhs_out
+        acados_tic(&timer_la);
+        dgemm_nn_3l(nx, 1 + nf, nx, P, nx, rhs_out, nx, K, nx);
+        for (i = 0; i < nX; i++)
+            forw[i] += K[i];
+        timing_la += acados_toc(&timer_la);
+    }
+
+    // store result
+    for (i = 0; i < nx; i++)
+        out->xn[i] = forw[i];
+
+    double *Sx = forw + nx;
+    double *Su = forw + nx + nx * nx;
+
+    if (opts->sens_forw)
+    {
+        if (in->identity_seed)
+        {
+            for (i = 0; i < nx * (nx + nu); i++)
+                out->S_forw[i] = Sx[i];
+        }
+        else
+        {
+            // apply the forward seed [Sx_in, Su_in]: [Sx * Sx_in, Sx * Su_in + Su]
+            dgemm_nn_3l(nx, nx + nu, nx, Sx, nx, in->S_forw, nx, out->S_forw, nx);
+            for (i = 0; i < nx * nu; i++)
+                out->S_forw[nx * nx + i] += Su[i];
+        }
+    }
+
+    if (opts->sens_adj)
+    {
+        // S_adj = [Sx, Su]' * seed
+        for (j = 0; j < nx + nu; j++)
+        {
+            out->S_adj[j] = 0.0;
+            for (i = 0; i < nx; i++)
+                out->S_adj[j] += Sx[i + nx * j] * in->S_adj[i];
+        }
+    }
+
+    // store timings
+    out->info->CPUtime = acados_toc(&timer);
+    out->info->LAtime = timing_la;
+    out->info->ADtime = timing_ad;
+
+    mem->time_sim = out->info->CPUtime;
+    mem->time_ad = out->info->ADtime;
+    mem->time_la = out->info->LAtime;
+
+    return ACADOS_SUCCESS;
+}
+
+
+
+void sim_exp_euler_config_initialize_default(void *config_)
+{
+    sim_config *config = config_;
+
+    config->opts_calculate_size = &sim_exp_euler_opts_calculate_size;
+    config->opts_assign = &sim_exp_euler_opts_assign;
+    config->opts_initialize_default = &sim_exp_euler_opts_initialize_default;
+    config->opts_update = &sim_exp_euler_opts_update;
+    config->opts_set = &sim_exp_euler_opts_set;
+    config->opts_get = &sim_exp_euler_opts_get;
+    config->memory_calculate_size = &sim_exp_euler_memory_calculate_size;
+    config->memory_assign = &sim_exp_euler_memory_assign;
+    config->memory_set = &sim_exp_euler_memory_set;
+    config->memory_set_to_zero = &sim_exp_euler_memory_set_to_zero;
+    config->memory_get = &sim_exp_euler_memory_get;
+    config->workspace_calculate_size = &sim_exp_euler_workspace_calculate_size;
+    config->model_calculate_size = &sim_exp_euler_model_calculate_size;
+    config->model_assign = &sim_exp_euler_model_assign;
+    config->model_set = &sim_exp_euler_model_set;
+    config->evaluate = &sim_exp_euler;
+    config->precompute = &sim_exp_euler_precompute;
+    config->config_initialize_default = &sim_exp_euler_config_initialize_default;
+    config->dims_calculate_size = &sim_exp_euler_dims_calculate_size;
+    config->dims_assign = &sim_exp_euler_dims_assign;
+    config->dims_set = &sim_exp_euler_dims_set;
+    config->dims_get = &sim_exp_euler_dims_get;
+    return;
+}
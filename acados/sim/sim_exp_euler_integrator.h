@@ -0,0 +1,145 @@
+/*
+ * Copyright 2019 Gianluca Frison, Dimitris Kouzoupis, Robin Verschueren,
+ * Andrea Zanelli, Niels van Duijkeren, Jonathan Frey, Tommaso Sartor,
+ * Branimir Novoselnik, Rien Quirynen, Rezart Qelibari, Dang Doan,
+ * Jonas Koenemann, Yutao Chen, Tobias Schöls, Jonas Schlagenhauf, Moritz Diehl
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#ifndef ACADOS_SIM_SIM_EXP_EULER_INTEGRATOR_H_
+#define ACADOS_SIM_SIM_EXP_EULER_INTEGRATOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "acados/sim/sim_common.h"
+#include "acados/utils/types.h"
+
+
+
+typedef struct
+{
+    int nx;
+    int nu;
+    int nz;
+} sim_exp_euler_dims;
+
+
+
+typedef struct
+{
+    /* external functions */
+    // explicit ode f(x, u) = A_LO * x + N(x, u)
+    external_function_generic *expl_ode_fun;
+    // forward explicit vde
+    external_function_generic *expl_vde_for;
+
+    /* model defining matrices */
+    // linear part of f, treated exactly as the linear output system of GNSF; zero by default
+    double *A_LO;  // nx * nx
+    int nx;
+
+} exp_euler_model;
+
+
+
+typedef struct
+{
+	// memory
+	double time_sim;
+	double time_ad;
+	double time_la;
+
+	// step * phi_1(step * A_LO), recomputed if the step size or A_LO changes
+	double *P;
+	double *A_LO_P;  // A_LO used for P
+	double step_P;   // step used for P, 0 if P is not computed yet
+
+} sim_exp_euler_memory;
+
+
+
+typedef struct
+{
+	// workspace mem
+    double *forw;     // x + Sx + Su, sensitivities w.r.t. (x0, u)
+    double *rhs_out;  // f + Sx_dot + Su_dot
+    double *K;        // P * rhs_out
+    double *aug;      // (2 * nx) * (2 * nx), matrix exponential of [step * A_LO, step * eye(nx); 0, 0]
+
+} sim_exp_euler_workspace;
+
+
+
+// dims
+int sim_exp_euler_dims_calculate_size();
+void *sim_exp_euler_dims_assign(void *config_, void *raw_memory);
+void sim_exp_euler_dims_set(void *config_, void *dims_, const char *field, const int* value);
+void sim_exp_euler_dims_get(void *config_, void *dims_, const char *field, int* value);
+
+// model
+int sim_exp_euler_model_calculate_size(void *config, void *dims);
+void *sim_exp_euler_model_assign(void *config, void *dims, void *raw_memory);
+int sim_exp_euler_model_set(void *model, const char *field, void *value);
+
+// opts
+int sim_exp_euler_opts_calculate_size(void *config, void *dims);
+//
+void sim_exp_euler_opts_update(void *config_, void *dims, void *opts_);
+//
+void *sim_exp_euler_opts_assign(void *config, void *dims, void *raw_memory);
+//
+void sim_exp_euler_opts_initialize_default(void *config, void *dims, void *opts_);
+//
+void sim_exp_euler_opts_set(void *config_, void *opts_, const char *field, void *value);
+
+
+// memory
+int sim_exp_euler_memory_calculate_size(void *config, void *dims, void *opts_);
+//
+void *sim_exp_euler_memory_assign(void *config, void *dims, void *opts_, void *raw_memory);
+//
+int sim_exp_euler_memory_set(void *config_, void *dims_, void *mem_, const char *field,
+                             void *value);
+
+
+// workspace
+int sim_exp_euler_workspace_calculate_size(void *config, void *dims, void *opts_);
+
+//
+int sim_exp_euler(void *config, sim_in *in, sim_out *out, void *opts_, void *mem_, void *work_);
+//
+void sim_exp_euler_config_initialize_default(void *config);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  // ACADOS_SIM_SIM_EXP_EULER_INTEGRATOR_H_
@@ -77,6 +77,7 @@ void *sim_gnsf_dims_assign(void *config_, void *raw_memory)
     dims->nx = 0;
     dims->nu = 0;
     dims->nz = 0;
+    dims->n_dense = 0;
     dims->nz1 = 0;
     dims->nx1 = 0;
     dims->n_out = 0;
@@ -129,6 +130,10 @@ void sim_gnsf_dims_set(void *config_, void *dims_, const char *field, const int
     {
         dims->nuhat = *value;
     }
+    else if (!strcmp(field, "n_dense"))
+    {
+        dims->n_dense = *value;
+    }
     else
     {
         printf("\nerror: sim_gnsf_dims_set: field not available: %s\n", field);
@@ -158,6 +163,10 @@ void sim_gnsf_dims_get(void *config_, void *dims_, const char *field, int *value
     {
         *value = dims->n_out;
     }
+    else if (!strcmp(field, "n_dense"))
+    {
+        *value = dims->n_dense;
+    }
     else
     {
         printf("\nerror: sim_gnsf_dims_get: field not available: %s\n", field);
@@ -251,21 +260,11 @@ static void sim_gnsf_import_matrices(void *dims_, gnsf_model *model)
 
 int sim_gnsf_opts_calculate_size(void *config_, void *dims)
 {
-    int ns_max = NS_MAX;
-
     int size = 0;
 
+    // the butcher tableau points into the gauss_tableau cache
     size += sizeof(sim_opts);
 
-    size += ns_max * ns_max * sizeof(double);  // A_mat
-    size += ns_max * sizeof(double);           // b_vec
-    size += ns_max * sizeof(double);           // c_vec
-
-    int tmp0 = gauss_nodes_work_calculate_size(ns_max);
-    int tmp1 = butcher_table_work_calculate_size(ns_max);
-    int work_size = tmp0 > tmp1 ? tmp0 : tmp1;
-    size += work_size;  // work
-
     make_int_multiple_of(8, &size);
     size += 1 * 8;
 
@@ -274,8 +273,6 @@ int sim_gnsf_opts_calculate_size(void *config_, void *dims)
 
 void *sim_gnsf_opts_assign(void *config_, void *dims, void *raw_memory)
 {
-    int ns_max = NS_MAX;
-
     char *c_ptr = (char *) raw_memory;
 
     sim_opts *opts = (sim_opts *) c_ptr;
@@ -283,16 +280,10 @@ void *sim_gnsf_opts_assign(void *config_, void *dims, void *raw_memory)
 
     align_char_to(8, &c_ptr);
 
-    assign_and_advance_double(ns_max * ns_max, &opts->A_mat, &c_ptr);
-    assign_and_advance_double(ns_max, &opts->b_vec, &c_ptr);
-    assign_and_advance_double(ns_max, &opts->c_vec, &c_ptr);
-
-    // work
-    int tmp0 = gauss_nodes_work_calculate_size(ns_max);
-    int tmp1 = butcher_table_work_calculate_size(ns_max);
-    int work_size = tmp0 > tmp1 ? tmp0 : tmp1;
-    opts->work = c_ptr;
-    c_ptr += work_size;
+    opts->A_mat = NULL;
+    opts->b_vec = NULL;
+    opts->c_vec = NULL;
+    opts->work = NULL;
 
     assert((char *) raw_memory + sim_gnsf_opts_calculate_size(config_, dims) >= c_ptr);
 
@@ -309,17 +300,16 @@ void sim_gnsf_opts_initialize_default(void *config_, void *dims_, void *opts_)
 
     assert(ns <= NS_MAX && "ns > NS_MAX!");
 
-    // set tableau size
-    opts->tableau_size = opts->ns;
-
-    // gauss collocation nodes
-    gauss_nodes(ns, opts->c_vec, opts->work);
-
-    // butcher tableau
-    butcher_table(ns, opts->c_vec, opts->b_vec, opts->A_mat, opts->work);
+    // butcher tableau, shared between all instances with the same ns
+    const gauss_tableau *tableau = gauss_tableau_get(ns, false);
+    opts->tableau_size = ns;
+    opts->A_mat = tableau->A_mat;
+    opts->b_vec = tableau->b_vec;
+    opts->c_vec = tableau->c_vec;
 
     // default options
     opts->newton_iter = 3;
+    opts->newton_tol = 0.0;
     opts->scheme = NULL;
     opts->num_steps = 2;
     opts->num_forw_sens = dims->nx + dims->nu;
@@ -354,14 +344,12 @@ void sim_gnsf_opts_update(void *config_, void *dims, void *opts_)
 
     assert(ns <= NS_MAX && "ns > NS_MAX!");
 
-    // set tableau size
-    opts->tableau_size = opts->ns;
-
-    // gauss collocation nodes
-    gauss_nodes(ns, opts->c_vec, opts->work);
-
-    // butcher tableau
-    butcher_table(ns, opts->c_vec, opts->b_vec, opts->A_mat, opts->work);
+    // butcher tableau, shared between all instances with the same ns
+    const gauss_tableau *tableau = gauss_tableau_get(ns, false);
+    opts->tableau_size = ns;
+    opts->A_mat = tableau->A_mat;
+    opts->b_vec = tableau->b_vec;
+    opts->c_vec = tableau->c_vec;
 
     return;
 }
@@ -1628,6 +1616,13 @@ int sim_gnsf_workspace_calculate_size(void *config, void *dims_, void *opts_)
     size += blasfeo_memsize_dvec(nuhat);  // uhat
     size += blasfeo_memsize_dvec(nz);  // z0;
 
+    if (dims->n_dense > 0)
+    {
+        size += blasfeo_memsize_dvec(nx);  // x_dense
+        size += collocation_dense_weights_work_calculate_size(num_stages);  // dense_work
+        size += 1 * 8;  // alignment after dense_work
+    }
+
     // if (opts->sens_algebraic){
     //     size += blasfeo_memsize_dvec(nx1);  // x0dot_1;
     //     size += blasfeo_memsize_dvec(ny);  // y_one_stage
@@ -1668,6 +1663,9 @@ int sim_gnsf_workspace_calculate_size(void *config, void *dims_, void *opts_)
     size += blasfeo_memsize_dmat(nvv, ny + nuhat);  // dPHI_dyuhat
     size += blasfeo_memsize_dmat(nz, nx + nu);  // S_algebraic_aux
 
+    if (dims->n_dense > 0)
+        size += 2 * blasfeo_memsize_dmat(nx, nx + nu);  // dxf_dense, S_dense
+
     make_int_multiple_of(8, &size);
     size += 1 * 8;
 
@@ -1751,6 +1749,14 @@ static void *sim_gnsf_cast_workspace(void *config, void *dims_, void *opts_, voi
     assign_and_advance_blasfeo_dvec_mem(nuhat, &workspace->uhat, &c_ptr);
     assign_and_advance_blasfeo_dvec_mem(nz, &workspace->z0, &c_ptr);
 
+    if (dims->n_dense > 0)
+    {
+        assign_and_advance_blasfeo_dvec_mem(nx, &workspace->x_dense, &c_ptr);
+        workspace->dense_work = c_ptr;
+        c_ptr += collocation_dense_weights_work_calculate_size(num_stages);
+        align_char_to(8, &c_ptr);
+    }
+
     // if (opts->sens_algebraic){
         // assign_and_advance_blasfeo_dvec_mem(ny, &workspace->y_one_stage, &c_ptr);
     //     assign_and_advance_blasfeo_dvec_mem(nx1, &workspace->x0dot_1, &c_ptr);
@@ -1798,6 +1804,12 @@ static void *sim_gnsf_cast_workspace(void *config, void *dims_, void *opts_, voi
     assign_and_advance_blasfeo_dmat_mem(nx, nu, &workspace->dPsi_du, &c_ptr);
     assign_and_advance_blasfeo_dmat_mem(nz, nx + nu, &workspace->S_algebraic_aux, &c_ptr);
 
+    if (dims->n_dense > 0)
+    {
+        assign_and_advance_blasfeo_dmat_mem(nx, nx + nu, &workspace->dxf_dense, &c_ptr);
+        assign_and_advance_blasfeo_dmat_mem(nx, nx + nu, &workspace->S_dense, &c_ptr);
+    }
+
     assert((char *) raw_memory + sim_gnsf_workspace_calculate_size(config, dims_, opts) >= c_ptr);
 
     return (void *) workspace;
@@ -1988,7 +2000,8 @@ int sim_gnsf(void *config, sim_in *in, sim_out *out, void *args, void *mem_, voi
     blasfeo_dvecpe(nx, ipiv_x, lambda_old, 0);
 
 
-    if (model->fully_linear && !mem->first_call)
+    // the dense output needs the stage values, which the fully linear shortcut skips
+    if (model->fully_linear && !mem->first_call && dims->n_dense == 0)
     {
         // xf = x_0 + S_forw_x * x0 + S_forw_u * u0; 
         blasfeo_dgemv_n(nx, nx, 1.0, S_forw, 0, 0, x0_traj, 0, 0.0,
@@ -2312,6 +2325,29 @@ int sim_gnsf(void *config, sim_in *in, sim_out *out, void *args, void *mem_, voi
                 out->info->LAtime += acados_toc(&la_timer);
             }
 
+            /* dense output: x(t) = x0 + dt * sum bt_i K_i, unpermuted */
+            for (int kk = 0; kk < dims->n_dense; kk++)
+            {
+                double theta;
+                if (sim_dense_step_index(in->t_dense[kk], mem->dt, num_steps, &theta) != ss)
+                    continue;
+
+                double bt[NS_MAX];
+                collocation_dense_weights(num_stages, mem->c_butcher, theta, bt,
+                                          workspace->dense_work);
+
+                blasfeo_dveccp(nx, x0_traj, nx * ss, &workspace->x_dense, 0);
+                for (int ii = 0; ii < num_stages; ii++)
+                {
+                    blasfeo_daxpy(nx1, mem->dt * bt[ii], K1_val, ii * nx1, &workspace->x_dense, 0,
+                                  &workspace->x_dense, 0);
+                    blasfeo_daxpy(nx2, mem->dt * bt[ii], K2_val, ii * nxz2, &workspace->x_dense, nx1,
+                                  &workspace->x_dense, nx1);
+                }
+                blasfeo_dvecpei(nx, ipiv_x, &workspace->x_dense, 0);
+                blasfeo_unpack_dvec(nx, &workspace->x_dense, 0, out->x_dense + kk * nx);
+            }
+
             /* Get simulation result */
             blasfeo_daxpy(nx, 0.0, x0_traj, 0, x0_traj, nx * ss, x0_traj, nx * (ss + 1));
             for (int ii = 0; ii < num_stages; ii++)
@@ -2466,6 +2502,53 @@ int sim_gnsf(void *config, sim_in *in, sim_out *out, void *args, void *mem_, voi
                     // copy from precomputed dx2f_dx2u
                     blasfeo_dgecp(nx2, nx2 + nu, dx2f_dx2u, 0, 0, dxf_dwn, nx1, nx1);
                 }
+                // dense output sensitivities, S_forw still holds the seed of this step
+                for (int kk = 0; kk < dims->n_dense; kk++)
+                {
+                    double theta;
+                    if (sim_dense_step_index(in->t_dense[kk], mem->dt, num_steps, &theta) != ss)
+                        continue;
+
+                    double bt[NS_MAX];
+                    collocation_dense_weights(num_stages, mem->c_butcher, theta, bt,
+                                              workspace->dense_work);
+
+                    struct blasfeo_dmat *dxf_dense = &workspace->dxf_dense;
+                    struct blasfeo_dmat *S_dense = &workspace->S_dense;
+
+                    // as dxf_dwn, with the weights bt instead of b
+                    blasfeo_dgese(nx, nx + nu, 0.0, dxf_dense, 0, 0);
+                    for (int ii = 0; ii < nx; ii++)
+                        blasfeo_dgein1(1.0, dxf_dense, ii, ii);
+                    for (int ii = 0; ii < num_stages; ii++)
+                    {
+                        double bt_dt = mem->dt * bt[ii];
+                        blasfeo_dgead(nx1, nx1, bt_dt, dK1_dx1, ii * nx1, 0, dxf_dense, 0, 0);
+                        blasfeo_dgead(nx1, nu , bt_dt, dK1_du , ii * nx1, 0, dxf_dense, 0, nx);
+                        if (model->nontrivial_f_LO)
+                            blasfeo_dgead(nx2, nx1, bt_dt, dK2_dx1, ii * nxz2, 0, dxf_dense, nx1, 0);
+                        blasfeo_dgead(nx2, nx2, bt_dt, dK2_dx2, ii * nxz2, 0, dxf_dense, nx1, nx1);
+                        blasfeo_dgead(nx2, nu,  bt_dt, dK2_du,  ii * nxz2, 0, dxf_dense, nx1, nx);
+                    }
+
+                    if (in->identity_seed && ss == 0)
+                    {
+                        blasfeo_dgecp(nx, nx + nu, dxf_dense, 0, 0, S_dense, 0, 0);
+                    }
+                    else
+                    {
+                        blasfeo_dgemm_nn(nx, nx, nx, 1.0, dxf_dense, 0, 0, S_forw, 0, 0, 0.0,
+                                         S_dense, 0, 0, S_dense, 0, 0);
+                        blasfeo_dgemm_nn(nx, nu, nx, 1.0, dxf_dense, 0, 0, S_forw, 0, nx, 1.0,
+                                         dxf_dense, 0, nx, S_dense, 0, nx);
+                    }
+
+                    blasfeo_drowpei(nx, ipiv_x, S_dense);
+                    blasfeo_dcolpei(nx, ipiv_x, S_dense);
+                    blasfeo_unpack_dmat(nx, nx + nu, S_dense, 0, 0,
+                                        out->S_dense + kk * nx * (nx + nu), nx);
+                }
+
                 // omit matrix multiplication for identity seed
                 if (in->identity_seed && ss == 0)
                 {
@@ -75,6 +75,7 @@ typedef struct
     int n_out; // output dimension of phi
     int ny; // dimension of first input of phi
     int nuhat; // dimension of second input of phi
+    int n_dense; // number of dense output times
 
 } sim_gnsf_dims;
 
@@ -235,6 +236,12 @@ typedef struct
     struct blasfeo_dmat dPHI_dyuhat;
     struct blasfeo_dvec z0;
 
+    // only available if (dims->n_dense > 0)
+    struct blasfeo_dvec x_dense;    // state at a dense output time (nx)
+    struct blasfeo_dmat dxf_dense;  // dx(t)/d(x0,u) of the current step (nx, nx+nu)
+    struct blasfeo_dmat S_dense;    // forward sensitivities at a dense output time (nx, nx+nu)
+    void *dense_work;               // work for collocation_dense_weights
+
     // memory only available if (opts->sens_algebraic)
     // struct blasfeo_dvec y_one_stage;
     // struct blasfeo_dvec x0dot_1;
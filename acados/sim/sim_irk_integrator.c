@@ -49,6 +49,9 @@
 #include "blasfeo/include/blasfeo_d_aux.h"
 #include "blasfeo/include/blasfeo_d_blas.h"
 
+// maximum number of stages for the simplified Newton scheme
+#define IRK_SIMPLIFIED_NS_MAX 10
+
 
 
 #define CASADI_HESS_MULT 0
@@ -76,6 +79,7 @@ void *sim_irk_dims_assign(void *config_, void *raw_memory)
     dims->nx = 0;
     dims->nu = 0;
     dims->nz = 0;
+    dims->n_dense = 0;
 
     assert((char *) raw_memory + sim_irk_dims_calculate_size() >= c_ptr);
 
@@ -100,6 +104,10 @@ void sim_irk_dims_set(void *config_, void *dims_, const char *field, const int *
     {
         dims->nz = *value;
     }
+    else if (!strcmp(field, "n_dense"))
+    {
+        dims->n_dense = *value;
+    }
     else
     {
         printf("\nerror: sim_irk_dims_set: field not available: %s\n", field);
@@ -125,6 +133,10 @@ void sim_irk_dims_get(void *config_, void *dims_, const char *field, int *value)
     {
         *value = dims->nz;
     }
+    else if (!strcmp(field, "n_dense"))
+    {
+        *value = dims->n_dense;
+    }
     else
     {
         printf("\nerror: sim_irk_dims_get: field not available: %s\n", field);
@@ -210,20 +222,12 @@ int sim_irk_model_set(void *model_, const char *field, void *value)
 
 int sim_irk_opts_calculate_size(void *config_, void *dims)
 {
-    int ns_max = NS_MAX;
-
     int size = 0;
 
     size += sizeof(sim_opts);
 
-    size += ns_max * ns_max * sizeof(double);  // A_mat
-    size += ns_max * sizeof(double);           // b_vec
-    size += ns_max * sizeof(double);           // c_vec
-
-    int tmp0 = gauss_nodes_work_calculate_size(ns_max);
-    int tmp1 = butcher_table_work_calculate_size(ns_max);
-    int work_size = tmp0 > tmp1 ? tmp0 : tmp1;
-    size += work_size;  // work
+    // simplified Newton, the tableau and transformation point into the gauss_tableau cache
+    size += sizeof(Newton_scheme);
 
     make_int_multiple_of(8, &size);
     size += 1 * 8;
@@ -231,10 +235,36 @@ int sim_irk_opts_calculate_size(void *config_, void *dims)
     return size;
 }
 
-void *sim_irk_opts_assign(void *config_, void *dims, void *raw_memory)
+
+
+// points the opts into the shared gauss_tableau cache
+static void sim_irk_set_tableau(sim_opts *opts)
 {
-    int ns_max = NS_MAX;
+    int ns = opts->ns;
+    bool simplified = opts->scheme->type == simplified_in;
+
+    const gauss_tableau *tableau = gauss_tableau_get(ns, simplified);
+    assert(tableau != NULL && "ns > NS_MAX!");
+
+    opts->tableau_size = ns;
+    opts->A_mat = tableau->A_mat;
+    opts->b_vec = tableau->b_vec;
+    opts->c_vec = tableau->c_vec;
 
+    if (simplified)
+    {
+        opts->scheme->eig = tableau->scheme->eig;
+        opts->scheme->transf1 = tableau->scheme->transf1;
+        opts->scheme->transf2 = tableau->scheme->transf2;
+    }
+
+    return;
+}
+
+
+
+void *sim_irk_opts_assign(void *config_, void *dims, void *raw_memory)
+{
     char *c_ptr = (char *) raw_memory;
 
     sim_opts *opts = (sim_opts *) c_ptr;
@@ -242,16 +272,22 @@ void *sim_irk_opts_assign(void *config_, void *dims, void *raw_memory)
 
     align_char_to(8, &c_ptr);
 
-    assign_and_advance_double(ns_max * ns_max, &opts->A_mat, &c_ptr);
-    assign_and_advance_double(ns_max, &opts->b_vec, &c_ptr);
-    assign_and_advance_double(ns_max, &opts->c_vec, &c_ptr);
+    // simplified Newton
+    Newton_scheme *scheme = (Newton_scheme *) c_ptr;
+    c_ptr += sizeof(Newton_scheme);
+
+    scheme->eig = NULL;
+    scheme->transf1 = NULL;
+    scheme->transf2 = NULL;
+    scheme->transf1_T = NULL;
+    scheme->transf2_T = NULL;
+    scheme->low_tria = NULL;
+    scheme->single = false;
+    scheme->freeze = false;
+    scheme->type = exact;
+    opts->scheme = scheme;
 
-    // work
-    int tmp0 = gauss_nodes_work_calculate_size(ns_max);
-    int tmp1 = butcher_table_work_calculate_size(ns_max);
-    int work_size = tmp0 > tmp1 ? tmp0 : tmp1;
-    opts->work = c_ptr;
-    c_ptr += work_size;
+    opts->work = NULL;
 
     assert((char *) raw_memory + sim_irk_opts_calculate_size(config_, dims) >= c_ptr);
 
@@ -268,18 +304,14 @@ void sim_irk_opts_initialize_default(void *config_, void *dims_, void *opts_)
 
     assert(ns <= NS_MAX && "ns > NS_MAX!");
 
-    // set tableau size
-    opts->tableau_size = opts->ns;
-
-    // gauss collocation nodes
-    gauss_nodes(ns, opts->c_vec, opts->work);
+    // default options
+    opts->newton_iter = 3;
+    opts->newton_tol = 0.0;
+    opts->scheme->type = exact;
 
     // butcher tableau
-    butcher_table(ns, opts->c_vec, opts->b_vec, opts->A_mat, opts->work);
+    sim_irk_set_tableau(opts);
 
-    // default options
-    opts->newton_iter = 3;
-    opts->scheme = NULL;
     opts->num_steps = 2;
     opts->num_forw_sens = dims->nx + dims->nu;
     opts->sens_forw = true;
@@ -313,14 +345,15 @@ void sim_irk_opts_update(void *config_, void *dims, void *opts_)
 
     assert(ns <= NS_MAX && "ns > NS_MAX!");
 
-    // set tableau size
-    opts->tableau_size = opts->ns;
-
-    // gauss collocation nodes
-    gauss_nodes(ns, opts->c_vec, opts->work);
+    if (opts->scheme->type == simplified_in && ns > IRK_SIMPLIFIED_NS_MAX)
+    {
+        printf("\nerror: sim_irk: simplified_newton only available for ns <= %d\n",
+               IRK_SIMPLIFIED_NS_MAX);
+        exit(1);
+    }
 
-    // butcher tableau
-    butcher_table(ns, opts->c_vec, opts->b_vec, opts->A_mat, opts->work);
+    // butcher tableau and its block diagonalization for the simplified Newton scheme
+    sim_irk_set_tableau(opts);
 
     return;
 }
@@ -330,7 +363,32 @@ void sim_irk_opts_update(void *config_, void *dims, void *opts_)
 void sim_irk_opts_set(void *config_, void *opts_, const char *field, void *value)
 {
     sim_opts *opts = (sim_opts *) opts_;
-    sim_opts_set_(opts, field, value);
+
+    if (!strcmp(field, "simplified_newton"))
+    {
+        bool *simplified_newton = (bool *) value;
+        if (*simplified_newton)
+        {
+            opts->scheme->type = simplified_in;
+            // the transformation tables lose accuracy for more stages
+            if (opts->ns > IRK_SIMPLIFIED_NS_MAX)
+            {
+                printf("\nerror: sim_irk_opts_set: simplified_newton only available for ns <= %d\n",
+                       IRK_SIMPLIFIED_NS_MAX);
+                exit(1);
+            }
+            if (opts->ns == opts->tableau_size)
+                sim_irk_set_tableau(opts);
+        }
+        else
+        {
+            opts->scheme->type = exact;
+        }
+    }
+    else
+    {
+        sim_opts_set_(opts, field, value);
+    }
 }
 
 
@@ -351,16 +409,19 @@ int sim_irk_memory_calculate_size(void *config, void *dims_, void *opts_)
 {
     // typecast
     sim_irk_dims *dims = (sim_irk_dims *) dims_;
-    // sim_opts *opts = opts_;
+    sim_opts *opts = opts_;
 
     // necessary integers
     int nx = dims->nx;
     int nz = dims->nz;
+    int num_steps = opts->num_steps;
 
     int size = sizeof(sim_irk_memory);
 
     size += nx * sizeof(double); // xdot
     size += nz * sizeof(double); // z
+    size += num_steps * sizeof(double); // newton_res
+    size += num_steps * sizeof(int); // newton_iter
     size += 8;  // corresponds to memory alignment
 
     return size;
@@ -373,11 +434,12 @@ void *sim_irk_memory_assign(void *config, void *dims_, void *opts_, void *raw_me
 
     // typecast
     sim_irk_dims *dims = (sim_irk_dims *) dims_;
-    // sim_opts *opts = opts_;
+    sim_opts *opts = opts_;
 
     // necessary integers
     int nx = dims->nx;
     int nz = dims->nz;
+    int num_steps = opts->num_steps;
 
     // struct
     sim_irk_memory *mem = (sim_irk_memory *) c_ptr;
@@ -388,6 +450,10 @@ void *sim_irk_memory_assign(void *config, void *dims_, void *opts_, void *raw_me
     // assign doubles
     assign_and_advance_double(nz, &mem->z, &c_ptr);
     assign_and_advance_double(nx, &mem->xdot, &c_ptr);
+    assign_and_advance_double(num_steps, &mem->newton_res, &c_ptr);
+
+    // assign ints
+    assign_and_advance_int(num_steps, &mem->newton_iter, &c_ptr);
 
     // initialization of xdot, z is 0 if not changed
     for (int ii = 0; ii < nx; ii++)
@@ -395,6 +461,15 @@ void *sim_irk_memory_assign(void *config, void *dims_, void *opts_, void *raw_me
     for (int ii = 0; ii < nz; ii++)
         mem->z[ii] = 0.0;
 
+    mem->newton_num_steps = num_steps;
+    for (int ii = 0; ii < num_steps; ii++)
+    {
+        mem->newton_iter[ii] = 0;
+        mem->newton_res[ii] = 0.0;
+    }
+    mem->newton_iter_total = 0;
+    mem->jac_refresh = 0;
+
     return mem;
 }
 
@@ -491,6 +566,29 @@ void sim_irk_memory_get(void *config_, void *dims_, void *mem_, const char *fiel
 		double *ptr = value;
 		*ptr = mem->time_la;
 	}
+    else if (!strcmp(field, "newton_iter"))
+    {
+        // per integration step, sized by num_steps at memory creation
+        int *ptr = value;
+        for (int ii = 0; ii < mem->newton_num_steps; ii++)
+            ptr[ii] = mem->newton_iter[ii];
+    }
+    else if (!strcmp(field, "newton_res"))
+    {
+        double *ptr = value;
+        for (int ii = 0; ii < mem->newton_num_steps; ii++)
+            ptr[ii] = mem->newton_res[ii];
+    }
+    else if (!strcmp(field, "newton_iter_total"))
+    {
+        int *ptr = value;
+        *ptr = mem->newton_iter_total;
+    }
+    else if (!strcmp(field, "jac_refresh"))
+    {
+        int *ptr = value;
+        *ptr = mem->jac_refresh;
+    }
 	else
 	{
 		printf("sim_irk_memory_get field %s is not supported! \n", field);
@@ -591,6 +689,22 @@ int sim_irk_workspace_calculate_size(void *config_, void *dims_, void *opts_)
         size += blasfeo_memsize_dmat(nx + nz, nx + nu);  // dk0_dxu
     }
 
+    if (dims->n_dense > 0)
+    {
+        size += blasfeo_memsize_dmat(nx, nx + nu);                    // S_dense
+        size += collocation_dense_weights_work_calculate_size(ns);    // dense_work
+        size += 1 * 8;  // alignment of dense_work
+    }
+
+    if (opts->scheme->type == simplified_in)
+    {
+        int nblk = (ns + 1) / 2;
+        size += nblk * sizeof(struct blasfeo_dmat);                       // dG_dK_simpl
+        size += nblk * blasfeo_memsize_dmat(2 * (nx + nz), 2 * (nx + nz));  // dG_dK_simpl
+        size += sizeof(struct blasfeo_dvec) + blasfeo_memsize_dvec(nK);   // rG_simpl
+        size += nblk * 2 * (nx + nz) * sizeof(int);                       // ipiv_simpl
+    }
+
     size += 1 * 8; // initial alignment
     make_int_multiple_of(64, &size);
     size += 1 * 64;
@@ -645,6 +759,13 @@ static void *sim_irk_workspace_cast(void *config_, void *dims_, void *opts_, voi
     assign_and_advance_blasfeo_dvec_structs(1, &workspace->xt, &c_ptr);
     assign_and_advance_blasfeo_dvec_structs(1, &workspace->xn, &c_ptr);
 
+    int nblk = (ns + 1) / 2;
+    if (opts->scheme->type == simplified_in)
+    {
+        assign_and_advance_blasfeo_dmat_structs(nblk, &workspace->dG_dK_simpl, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(1, &workspace->rG_simpl, &c_ptr);
+    }
+
     /* algin c_ptr to 64 blasfeo_dmat_mem has to be assigned directly after that  */
     align_char_to(64, &c_ptr);
 
@@ -685,6 +806,17 @@ static void *sim_irk_workspace_cast(void *config_, void *dims_, void *opts_, voi
         assign_and_advance_blasfeo_dmat_mem(nx + nz, nx + nu, &workspace->dk0_dxu, &c_ptr);
     }
 
+    if (dims->n_dense > 0)
+        assign_and_advance_blasfeo_dmat_mem(nx, nx + nu, &workspace->S_dense, &c_ptr);
+
+    if (opts->scheme->type == simplified_in)
+    {
+        for (int ii = 0; ii < nblk; ii++)
+            assign_and_advance_blasfeo_dmat_mem(2 * (nx + nz), 2 * (nx + nz),
+                                                &workspace->dG_dK_simpl[ii], &c_ptr);
+        assign_and_advance_blasfeo_dvec_mem(nK, workspace->rG_simpl, &c_ptr);
+    }
+
     assign_and_advance_blasfeo_dvec_mem(nK, workspace->rG, &c_ptr);
     assign_and_advance_blasfeo_dvec_mem(nK, workspace->K, &c_ptr);
     assign_and_advance_blasfeo_dvec_mem(nx, workspace->xt, &c_ptr);
@@ -713,6 +845,16 @@ static void *sim_irk_workspace_cast(void *config_, void *dims_, void *opts_, voi
         assign_and_advance_int(steps * nK, &workspace->ipiv, &c_ptr);
     }
 
+    if (opts->scheme->type == simplified_in)
+        assign_and_advance_int(nblk * 2 * (nx + nz), &workspace->ipiv_simpl, &c_ptr);
+
+    if (dims->n_dense > 0)
+    {
+        align_char_to(8, &c_ptr);
+        workspace->dense_work = c_ptr;
+        c_ptr += collocation_dense_weights_work_calculate_size(ns);
+    }
+
     // printf("\npointer moved - size calculated = %d bytes\n", c_ptr- (char*)raw_memory -
     // sim_irk_calculate_workspace_size(dims, opts_));
 
@@ -731,6 +873,116 @@ int sim_irk_precompute(void *config_, sim_in *in, sim_out *out, void *opts_, voi
 
 
 
+/************************************************
+ * simplified Newton
+ ************************************************/
+
+// With the Jacobians frozen for all stages, dG_dK = I x [df_dxdot, df_dz] + step * A x [df_dx, 0].
+// The transformation A = T * Lambda * T_inv turns it into the block diagonal matrix
+// I x [df_dxdot, df_dz] + step * Lambda x [df_dx, 0], with one block of size 2*(nx+nz) per
+// complex conjugate pair of eigenvalues and one of size nx+nz for a real eigenvalue.
+static void sim_irk_simplified_factorize(sim_opts *opts, int nx, int nz, double step,
+                                         sim_irk_workspace *work)
+{
+    int ns = opts->ns;
+    int n = nx + nz;
+    double *eig = opts->scheme->eig;
+
+    struct blasfeo_dmat *df_dx = &work->df_dx;
+    struct blasfeo_dmat *df_dxdot = &work->df_dxdot;
+    struct blasfeo_dmat *df_dz = &work->df_dz;
+
+    struct blasfeo_dmat *M;
+    int nb;
+
+    for (int ii = 0; ii < ns; ii += 2)
+    {
+        M = &work->dG_dK_simpl[ii / 2];
+        nb = (ii + 1 < ns) ? 2 : 1;  // number of stages in this block
+
+        blasfeo_dgese(nb * n, nb * n, 0.0, M, 0, 0);
+        for (int jj = 0; jj < nb; jj++)
+        {
+            blasfeo_dgead(n, nx, 1.0, df_dxdot, 0, 0, M, jj * n, jj * n);
+            blasfeo_dgead(n, nz, 1.0, df_dz, 0, 0, M, jj * n, jj * n + nx);
+            blasfeo_dgead(n, nx, step * eig[ii + jj], df_dx, 0, 0, M, jj * n, jj * n);
+            if (nb == 2)
+            {
+                blasfeo_dgead(n, nx, step * eig[ns + ii + jj], df_dx, 0, 0,
+                              M, jj * n, (1 - jj) * n);
+            }
+        }
+
+        blasfeo_dgetrf_rp(nb * n, nb * n, M, 0, 0, M, 0, 0, work->ipiv_simpl + ii * n);
+    }
+
+    return;
+}
+
+
+
+// solves the simplified Newton system for the residual rG (ordered by stages) and overwrites rG
+// with the step in the ordering of K = (k_1,..., k_{ns}, z_1,..., z_{ns})
+static void sim_irk_simplified_solve(sim_opts *opts, int nx, int nz, sim_irk_workspace *work)
+{
+    int ns = opts->ns;
+    int n = nx + nz;
+    double *T = opts->scheme->transf2;
+    double *T_inv = opts->scheme->transf1;
+
+    struct blasfeo_dvec *rG = work->rG;
+    struct blasfeo_dvec *rG_simpl = work->rG_simpl;
+
+    struct blasfeo_dmat *M;
+    int *ipiv;
+    int nb;
+    double t;
+
+    // rG_simpl = (T_inv x I) * rG
+    blasfeo_dvecse(ns * n, 0.0, rG_simpl, 0);
+    for (int ii = 0; ii < ns; ii++)
+    {
+        for (int jj = 0; jj < ns; jj++)
+        {
+            t = T_inv[ii + ns * jj];
+            if (t != 0.0)
+                blasfeo_daxpy(n, t, rG, jj * n, rG_simpl, ii * n, rG_simpl, ii * n);
+        }
+    }
+
+    // block diagonal solve
+    for (int ii = 0; ii < ns; ii += 2)
+    {
+        M = &work->dG_dK_simpl[ii / 2];
+        ipiv = work->ipiv_simpl + ii * n;
+        nb = (ii + 1 < ns) ? 2 : 1;
+
+        blasfeo_dvecpe(nb * n, ipiv, rG_simpl, ii * n);
+        blasfeo_dtrsv_lnu(nb * n, M, 0, 0, rG_simpl, ii * n, rG_simpl, ii * n);
+        blasfeo_dtrsv_unn(nb * n, M, 0, 0, rG_simpl, ii * n, rG_simpl, ii * n);
+    }
+
+    // rG = (T x I) * rG_simpl
+    blasfeo_dvecse(ns * n, 0.0, rG, 0);
+    for (int ii = 0; ii < ns; ii++)
+    {
+        for (int jj = 0; jj < ns; jj++)
+        {
+            t = T[ii + ns * jj];
+            if (t != 0.0)
+            {
+                blasfeo_daxpy(nx, t, rG_simpl, jj * n, rG, ii * nx, rG, ii * nx);
+                blasfeo_daxpy(nz, t, rG_simpl, jj * n + nx, rG, ns * nx + ii * nz,
+                              rG, ns * nx + ii * nz);
+            }
+        }
+    }
+
+    return;
+}
+
+
+
 /************************************************
  * integrator
  ************************************************/
@@ -822,6 +1074,14 @@ int sim_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
     struct blasfeo_dmat *S_forw_ss = S_forw;
     int *ipiv_ss;
 
+    int simplified = opts->scheme->type == simplified_in;
+    int new_jac;
+    int jac_valid = 0;  // a factorization of the (simplified) jacobian is available
+
+    double newton_tol = opts->newton_tol;
+    double res_nrm = 0.0;
+    double res_prev;
+
 
 	// SET FUNCTION IN- & OUTPUT TYPES
     // INPUT: impl_ode
@@ -944,6 +1204,9 @@ int sim_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
     impl_ode_z_in.x = K;
 
     // start the loop
+    mem->newton_iter_total = 0;
+    mem->jac_refresh = 0;
+
     acados_tic(&timer);
     for (int ss = 0; ss < num_steps; ss++)
     {
@@ -978,92 +1241,145 @@ int sim_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
         if ( opts->sens_adj || opts->sens_hess )  // store current xn
             blasfeo_dveccp(nx, xn, 0, &xn_traj[ss], 0);
 
-        for (int iter = 0; iter < newton_iter; iter++)
+        res_prev = 0.0;
+        int iter;
+        for (iter = 0; iter < newton_iter; iter++)
         {
-            if ((opts->jac_reuse && (ss == 0) && (iter == 0)) || (!opts->jac_reuse))
-            {
-                // if new jacobian gets computed, initialize dG_dK_ss with zeros
-                blasfeo_dgese(nK, nK, 0.0, dG_dK_ss, 0, 0);
-            }
-
-            for (int ii = 0; ii < ns; ii++)
-            {  // ii-th row of tableau
-                // take x(n); copy a strvec into a strvec
-                blasfeo_dveccp(nx, xn, 0, xt, 0);
+            // simplified Newton: jacobians are only evaluated at the first iteration of a step;
+            // with jac_reuse, a factorization is kept as long as jac_valid is set
+            if (simplified)
+                new_jac = !jac_valid || ((iter == 0) && !opts->jac_reuse);
+            else
+                new_jac = !jac_valid || !opts->jac_reuse;
 
-                for (int jj = 0; jj < ns; jj++)
-                {  // jj-th col of tableau
-                    // TODO(oj): precompute A_mat * step;
-                    a = A_mat[ii + ns * jj] * step;
-                    // xt = xt + T_int * a[i,j]*K_j
-                    blasfeo_daxpy(nx, a, K, jj * nx, xt, 0, xt, 0);
+            // the residual is evaluated a second time, now with jacobians,
+            // if the divergence guard rejects the reused jacobian
+            for (int eval = 0; eval < 2; eval++)
+            {
+                if (new_jac && !simplified)
+                {
+                    // if new jacobian gets computed, initialize dG_dK_ss with zeros
+                    blasfeo_dgese(nK, nK, 0.0, dG_dK_ss, 0, 0);
                 }
-                impl_ode_xdot_in.xi = ii * nx;  // use k_i of K = (k_1,..., k_{ns},z_1,..., z_{ns})
-                impl_ode_z_in.xi    = ns * nx + ii * nz;
-                                              // use z_i of K = (k_1,..., k_{ns},z_1,..., z_{ns})
-                impl_ode_res_out.xi = ii * (nx + nz);  // store output in this position of rG
 
-                // compute the residual of implicit ode at time t_ii
-                if ((opts->jac_reuse && (ss == 0) && (iter == 0)) || (!opts->jac_reuse))
-                {   // evaluate the ode function & jacobian w.r.t. x, xdot;
-                    // &  compute jacobian dG_dK_ss;
-                    acados_tic(&timer_ad);
-                    model->impl_ode_fun_jac_x_xdot_z->evaluate(
-                        model->impl_ode_fun_jac_x_xdot_z, impl_ode_type_in, impl_ode_in,
-                        impl_ode_fun_jac_x_xdot_z_type_out, impl_ode_fun_jac_x_xdot_z_out);
-                    timing_ad += acados_toc(&timer_ad);
+                for (int ii = 0; ii < ns; ii++)
+                {  // ii-th row of tableau
+                    // take x(n); copy a strvec into a strvec
+                    blasfeo_dveccp(nx, xn, 0, xt, 0);
 
-                    // compute the blocks of dG_dK_ss
                     for (int jj = 0; jj < ns; jj++)
-                    {  // compute the block (ii,jj)th block of dG_dK_ss
+                    {  // jj-th col of tableau
+                        // TODO(oj): precompute A_mat * step;
                         a = A_mat[ii + ns * jj] * step;
-                        blasfeo_dgead(nx + nz, nx, a, df_dx, 0, 0,
-                                            dG_dK_ss, ii * (nx + nz), jj * nx);
-                        if (jj == ii)
+                        // xt = xt + T_int * a[i,j]*K_j
+                        blasfeo_daxpy(nx, a, K, jj * nx, xt, 0, xt, 0);
+                    }
+                    impl_ode_xdot_in.xi = ii * nx;  // use k_i of K = (k_1,..., k_{ns},z_1,..., z_{ns})
+                    impl_ode_z_in.xi    = ns * nx + ii * nz;
+                                                  // use z_i of K = (k_1,..., k_{ns},z_1,..., z_{ns})
+                    impl_ode_res_out.xi = ii * (nx + nz);  // store output in this position of rG
+
+                    // compute the residual of implicit ode at time t_ii
+                    if (new_jac && simplified && ii == 0)
+                    {   // evaluate the ode function & the jacobians used for all stages
+                        acados_tic(&timer_ad);
+                        model->impl_ode_fun_jac_x_xdot_z->evaluate(
+                            model->impl_ode_fun_jac_x_xdot_z, impl_ode_type_in, impl_ode_in,
+                            impl_ode_fun_jac_x_xdot_z_type_out, impl_ode_fun_jac_x_xdot_z_out);
+                        timing_ad += acados_toc(&timer_ad);
+                    }
+                    else if (new_jac && !simplified)
+                    {   // evaluate the ode function & jacobian w.r.t. x, xdot;
+                        // &  compute jacobian dG_dK_ss;
+                        acados_tic(&timer_ad);
+                        model->impl_ode_fun_jac_x_xdot_z->evaluate(
+                            model->impl_ode_fun_jac_x_xdot_z, impl_ode_type_in, impl_ode_in,
+                            impl_ode_fun_jac_x_xdot_z_type_out, impl_ode_fun_jac_x_xdot_z_out);
+                        timing_ad += acados_toc(&timer_ad);
+
+                        // compute the blocks of dG_dK_ss
+                        for (int jj = 0; jj < ns; jj++)
+                        {  // compute the block (ii,jj)th block of dG_dK_ss
+                            a = A_mat[ii + ns * jj] * step;
+                            blasfeo_dgead(nx + nz, nx, a, df_dx, 0, 0,
+                                                dG_dK_ss, ii * (nx + nz), jj * nx);
+                            if (jj == ii)
+                            {
+                                blasfeo_dgead(nx + nz, nx, 1, df_dxdot, 0, 0,
+                                              dG_dK_ss, ii * (nx + nz), jj * nx);
+                                blasfeo_dgead(nx + nz, nz, 1, df_dz,    0, 0,
+                                              dG_dK_ss, ii * (nx + nz), (nx * ns) + jj * nz);
+                            }
+                        }  // end jj
+                    }
+                    else // only eval function (without jacobian)
+                    {
+                        if (model->impl_ode_fun == 0)
                         {
-                            blasfeo_dgead(nx + nz, nx, 1, df_dxdot, 0, 0,
-                                          dG_dK_ss, ii * (nx + nz), jj * nx);
-                            blasfeo_dgead(nx + nz, nz, 1, df_dz,    0, 0,
-                                          dG_dK_ss, ii * (nx + nz), (nx * ns) + jj * nz);
+                            printf("sim IRK: impl_ode_fun is not provided. Exiting.\n");
+                            exit(1);
                         }
-                    }  // end jj
+                        acados_tic(&timer_ad);
+                        model->impl_ode_fun->evaluate(model->impl_ode_fun, impl_ode_type_in,
+                                                      impl_ode_in, impl_ode_fun_type_out,
+                                                      impl_ode_fun_out);
+                        timing_ad += acados_toc(&timer_ad);
+                    }
+                }  // end ii
+
+                blasfeo_dvecnrm_inf(nK, rG, 0, &res_nrm);
+
+                // divergence guard: the residual did not contract with the reused jacobian
+                if (newton_tol > 0.0 && !new_jac && iter > 0 && res_nrm > res_prev)
+                {
+                    new_jac = 1;
+                    jac_valid = 0;
+                    mem->jac_refresh++;
                 }
-                else // only eval function (without jacobian)
+                else
                 {
-                    if (model->impl_ode_fun == 0)
-                    {
-                        printf("sim IRK: impl_ode_fun is not provided. Exiting.\n");
-                        exit(1);
-                    }
-                    acados_tic(&timer_ad);
-                    model->impl_ode_fun->evaluate(model->impl_ode_fun, impl_ode_type_in,
-                                                  impl_ode_in, impl_ode_fun_type_out,
-                                                  impl_ode_fun_out);
-                    timing_ad += acados_toc(&timer_ad);
+                    break;
                 }
-            }  // end ii
+            }  // end eval
+
+            if (newton_tol > 0.0 && res_nrm <= newton_tol)
+                break;
+            res_prev = res_nrm;
 
             acados_tic(&timer_la);
-            // DGETRF computes an LU factorization of a general M-by-N matrix A
-            // using partial pivoting with row interchanges.
-            // printf("dG_dK_ss = (IRK) \n");
-            // blasfeo_print_exp_dmat((nz+nx) *ns, (nz+nx) *ns, dG_dK_ss, 0, 0);
-            if ((opts->jac_reuse && (ss == 0) && (iter == 0)) || (!opts->jac_reuse))
+            if (simplified)
             {
-                blasfeo_dgetrf_rp(nK, nK, dG_dK_ss, 0, 0, dG_dK_ss, 0, 0, ipiv_ss);
-            }
+                if (new_jac)
+                {
+                    sim_irk_simplified_factorize(opts, nx, nz, step, workspace);
+                    jac_valid = 1;
+                }
 
-            // permute also the r.h.s
-            blasfeo_dvecpe(nK, ipiv_ss, rG, 0);
+                sim_irk_simplified_solve(opts, nx, nz, workspace);
+            }
+            else
+            {
+                // DGETRF computes an LU factorization of a general M-by-N matrix A
+                // using partial pivoting with row interchanges.
+                // printf("dG_dK_ss = (IRK) \n");
+                // blasfeo_print_exp_dmat((nz+nx) *ns, (nz+nx) *ns, dG_dK_ss, 0, 0);
+                if (new_jac)
+                {
+                    blasfeo_dgetrf_rp(nK, nK, dG_dK_ss, 0, 0, dG_dK_ss, 0, 0, ipiv_ss);
+                    jac_valid = 1;
+                }
 
-            // solve dG_dK_ss * y = rG, dG_dK_ss on the (l)eft, (l)ower-trian, (n)o-trans
-            // (u)nit trian
-            blasfeo_dtrsv_lnu(nK, dG_dK_ss, 0, 0, rG, 0, rG, 0);
+                // permute also the r.h.s
+                blasfeo_dvecpe(nK, ipiv_ss, rG, 0);
 
-            // solve dG_dK_ss * x = rG, dG_dK_ss on the (l)eft, (u)pper-trian, (n)o-trans
-            // (n)o unit trian , and store x in rG
-            blasfeo_dtrsv_unn(nK, dG_dK_ss, 0, 0, rG, 0, rG, 0);
+                // solve dG_dK_ss * y = rG, dG_dK_ss on the (l)eft, (l)ower-trian, (n)o-trans
+                // (u)nit trian
+                blasfeo_dtrsv_lnu(nK, dG_dK_ss, 0, 0, rG, 0, rG, 0);
 
+                // solve dG_dK_ss * x = rG, dG_dK_ss on the (l)eft, (u)pper-trian, (n)o-trans
+                // (n)o unit trian , and store x in rG
+                blasfeo_dtrsv_unn(nK, dG_dK_ss, 0, 0, rG, 0, rG, 0);
+            }
             timing_la += acados_toc(&timer_la);
 
             // scale and add a generic strmat into a generic strmat // K = K - rG, where rG is
@@ -1071,6 +1387,13 @@ int sim_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
             blasfeo_daxpy(nK, -1.0, rG, 0, K, 0, K, 0);
         }
 
+        if (ss < mem->newton_num_steps)
+        {
+            mem->newton_iter[ss] = iter;
+            mem->newton_res[ss] = res_nrm;
+        }
+        mem->newton_iter_total += iter;
+
         if ( opts->sens_adj || opts->sens_hess )
         {
             blasfeo_dveccp(nK, K, 0, &K_traj[ss], 0);
@@ -1125,6 +1448,8 @@ int sim_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
             acados_tic(&timer_la);
             blasfeo_dgetrf_rp(nK, nK, dG_dK_ss, 0, 0, dG_dK_ss, 0, 0, ipiv_ss);
             timing_la += acados_toc(&timer_la);
+            if (!simplified)
+                jac_valid = 1;
 
             // obtain dK_dxu
             // set up right hand side
@@ -1159,6 +1484,34 @@ int sim_irk(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, vo
         }  // end if sens_forw || sens_hess 
 
 
+        // dense output at the points of in->t_dense within this step
+        for (int kk = 0; kk < dims->n_dense; kk++)
+        {
+            double theta;
+            if (sim_dense_step_index(in->t_dense[kk], step, num_steps, &theta) != ss)
+                continue;
+
+            double bt[NS_MAX];
+            collocation_dense_weights(ns, opts->c_vec, theta, bt, workspace->dense_work);
+
+            // x(t) = x(n) + step * sum bt_i K_i
+            blasfeo_dveccp(nx, xn, 0, xt, 0);
+            for (int ii = 0; ii < ns; ii++)
+                blasfeo_daxpy(nx, step * bt[ii], K, ii * nx, xt, 0, xt, 0);
+            blasfeo_unpack_dvec(nx, xt, 0, out->x_dense + kk * nx);
+
+            if (opts->sens_forw)
+            {
+                // S_forw_ss already holds S(n+1), recall that dK_dxu_ss = -dK_dxu
+                blasfeo_dgecp(nx, nx + nu, S_forw_ss, 0, 0, &workspace->S_dense, 0, 0);
+                for (int jj = 0; jj < ns; jj++)
+                    blasfeo_dgead(nx, nx + nu, step * (b_vec[jj] - bt[jj]), dK_dxu_ss, jj * nx, 0,
+                                  &workspace->S_dense, 0, 0);
+                blasfeo_unpack_dmat(nx, nx + nu, &workspace->S_dense, 0, 0,
+                                    out->S_dense + kk * nx * (nx + nu), nx);
+            }
+        }
+
         // obtain x(n+1)
         for (int ii = 0; ii < ns; ii++){
             blasfeo_daxpy(nx, step * b_vec[ii], K, ii * nx, xn, 0, xn, 0);
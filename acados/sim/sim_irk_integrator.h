@@ -49,6 +49,7 @@ typedef struct
     int nx;
     int nu;
     int nz;
+    int n_dense;  // number of dense output times
 
 } sim_irk_dims;
 
@@ -121,6 +122,12 @@ typedef struct
     //              pivot vectors for dG_dxu
     int *ipiv;  // index of pivot vector
 
+    // only allocated if (opts->scheme->type == simplified_in)
+    //      block diagonal Newton matrix (T_inv x I) dG_dK (T x I) of the simplified Newton scheme
+    struct blasfeo_dmat *dG_dK_simpl;  // factorized blocks ((ns+1)/2 of size 2*(nx+nz))
+    int *ipiv_simpl;                   // index of pivot vectors ((ns+1)/2 * 2*(nx+nz))
+    struct blasfeo_dvec *rG_simpl;     // transformed residual ((nx+nz)*ns)
+
     // xn_traj, K_traj only available if( opts->sens_adj || opts->sens_hess )
     struct blasfeo_dvec *xn_traj;  // xn trajectory
     struct blasfeo_dvec *K_traj;   // K trajectory
@@ -133,6 +140,10 @@ typedef struct
     struct blasfeo_dmat dxkzu_dw0;  // size (2*nx + nu + nz) x (nx + nu)
     struct blasfeo_dmat tmp_dxkzu_dw0;  // size (2*nx + nu + nz) x (nx + nu)
 
+    /* the following variables are only available if (dims->n_dense > 0) */
+    struct blasfeo_dmat S_dense;  // forward sensitivities at a dense output time (nx, nx+nu)
+    void *dense_work;             // work for collocation_dense_weights
+
 } sim_irk_workspace;
 
 
@@ -141,6 +152,13 @@ typedef struct
     double *xdot;  // xdot[NX] - initialization for state derivatives k within the integrator
     double *z;     // z[NZ] - initialization for algebraic variables z
 
+    // Newton monitoring, per integration step
+    int *newton_iter;     // number of Newton updates applied
+    double *newton_res;   // inf-norm of the last evaluated residual rG
+    int newton_num_steps; // number of steps the arrays above are sized for
+    int newton_iter_total;
+    int jac_refresh;      // Jacobians recomputed by the divergence guard
+
 	double time_sim;
 	double time_ad;
 	double time_la;
@@ -98,6 +98,15 @@ void sim_lifted_irk_dims_set(void *config_, void *dims_, const char *field, cons
     {
         dims->nz = *value;
     }
+    else if (!strcmp(field, "n_dense"))
+    {
+        if (*value != 0)
+        {
+            printf("\nerror: n_dense != 0\n");
+            printf("dense output not supported by lifted IRK module\n");
+            exit(1);
+        }
+    }
     else
     {
         printf("\nerror: sim_lifted_irk_dims_set: field not available: %s\n", field);
@@ -123,6 +132,10 @@ void sim_lifted_irk_dims_get(void *config_, void *dims_, const char *field, int
     {
         *value = dims->nz;
     }
+    else if (!strcmp(field, "n_dense"))
+    {
+        *value = 0;
+    }
     else
     {
         printf("\nerror: sim_lifted_irk_dims_get: field not available: %s\n", field);
@@ -190,21 +203,11 @@ int sim_lifted_irk_model_set(void *model_, const char *field, void *value)
 
 int sim_lifted_irk_opts_calculate_size(void *config_, void *dims)
 {
-    int ns_max = NS_MAX;
-
     int size = 0;
 
+    // the butcher tableau points into the gauss_tableau cache
     size += sizeof(sim_opts);
 
-    size += ns_max * ns_max * sizeof(double);  // A_mat
-    size += ns_max * sizeof(double);           // b_vec
-    size += ns_max * sizeof(double);           // c_vec
-
-    int tmp0 = gauss_nodes_work_calculate_size(ns_max);
-    int tmp1 = butcher_table_work_calculate_size(ns_max);
-    int work_size = tmp0 > tmp1 ? tmp0 : tmp1;
-    size += work_size;  // work
-
     make_int_multiple_of(8, &size);
     size += 1 * 8;
 
@@ -215,8 +218,6 @@ int sim_lifted_irk_opts_calculate_size(void *config_, void *dims)
 
 void *sim_lifted_irk_opts_assign(void *config_, void *dims, void *raw_memory)
 {
-    int ns_max = NS_MAX;
-
     char *c_ptr = (char *) raw_memory;
 
     sim_opts *opts = (sim_opts *) c_ptr;
@@ -224,16 +225,10 @@ void *sim_lifted_irk_opts_assign(void *config_, void *dims, void *raw_memory)
 
     align_char_to(8, &c_ptr);
 
-    assign_and_advance_double(ns_max * ns_max, &opts->A_mat, &c_ptr);
-    assign_and_advance_double(ns_max, &opts->b_vec, &c_ptr);
-    assign_and_advance_double(ns_max, &opts->c_vec, &c_ptr);
-
-    // work
-    int tmp0 = gauss_nodes_work_calculate_size(ns_max);
-    int tmp1 = butcher_table_work_calculate_size(ns_max);
-    int work_size = tmp0 > tmp1 ? tmp0 : tmp1;
-    opts->work = c_ptr;
-    c_ptr += work_size;
+    opts->A_mat = NULL;
+    opts->b_vec = NULL;
+    opts->c_vec = NULL;
+    opts->work = NULL;
 
     assert((char *) raw_memory + sim_lifted_irk_opts_calculate_size(config_, dims) >= c_ptr);
 
@@ -254,17 +249,16 @@ void sim_lifted_irk_opts_initialize_default(void *config_, void *dims_, void *op
 
     assert(ns <= NS_MAX && "ns > NS_MAX!");
 
-    // set tableau size
-    opts->tableau_size = opts->ns;
-
-    // gauss collocation nodes
-    gauss_nodes(ns, opts->c_vec, opts->work);
-
-    // butcher tableau
-    butcher_table(ns, opts->c_vec, opts->b_vec, opts->A_mat, opts->work);
+    // butcher tableau, shared between all instances with the same ns
+    const gauss_tableau *tableau = gauss_tableau_get(ns, false);
+    opts->tableau_size = ns;
+    opts->A_mat = tableau->A_mat;
+    opts->b_vec = tableau->b_vec;
+    opts->c_vec = tableau->c_vec;
 
     // default options
     opts->newton_iter = 1;
+    opts->newton_tol = 0.0;
     opts->scheme = NULL;
     opts->num_steps = 1;
     opts->num_forw_sens = nx + nu;
@@ -288,14 +282,12 @@ void sim_lifted_irk_opts_update(void *config_, void *dims, void *opts_)
 
     assert(ns <= NS_MAX && "ns > NS_MAX!");
 
-    // set tableau size
-    opts->tableau_size = opts->ns;
-
-    // gauss collocation nodes
-    gauss_nodes(ns, opts->c_vec, opts->work);
-
-    // butcher tableau
-    butcher_table(ns, opts->c_vec, opts->b_vec, opts->A_mat, opts->work);
+    // butcher tableau, shared between all instances with the same ns
+    const gauss_tableau *tableau = gauss_tableau_get(ns, false);
+    opts->tableau_size = ns;
+    opts->A_mat = tableau->A_mat;
+    opts->b_vec = tableau->b_vec;
+    opts->c_vec = tableau->c_vec;
 
     return;
 }
@@ -0,0 +1,744 @@
+/*
+ * Copyright 2019 Gianluca Frison, Dimitris Kouzoupis, Robin Verschueren,
+ * Andrea Zanelli, Niels van Duijkeren, Jonathan Frey, Tommaso Sartor,
+ * Branimir Novoselnik, Rien Quirynen, Rezart Qelibari, Dang Doan,
+ * Jonas Koenemann, Yutao Chen, Tobias Schöls, Jonas Schlagenhauf, Moritz Diehl
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+/* Linearly implicit Rosenbrock-W integrator: the two stage, L-stable method ROS2 of
+ * Verwer et al. (1999), which is of order two for any approximation of the jacobian in
+ * W = eye(nx) - gamma * step * df_dx. Every step solves two linear systems with one LU
+ * factorization of W; with jac_reuse, the factorization of the first step is used for all steps.
+ *
+ * The sensitivities are obtained by applying the same method to the forward variational
+ * equations, propagated from the identity seed; the forward seed is applied at the end and
+ * the adjoint sensitivities are computed from the forward sensitivities.
+ *
+ * NOTE: these sensitivities are approximate. They are a second order accurate approximation
+ * of the sensitivities of the exact flow, but not the exact derivative of the discrete map
+ * computed above: that would also differentiate W through df_dx, i.e. the term dW/dx * K, which
+ * needs second order derivatives of f. They differ from the derivative of xn by O(step^2).
+ * In an SQP method, both the constraint linearization and the gradient of the Lagrangian use
+ * these sensitivities, so the KKT conditions are not those of the discretized problem: the
+ * computed optimum is feasible for the discrete dynamics, but biased by O(step^2). */
+
+// standard
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+// acados
+#include "acados/sim/sim_common.h"
+#include "acados/sim/sim_rosenbrock_integrator.h"
+#include "acados/utils/math.h"
+#include "acados/utils/mem.h"
+
+// gamma = 1 + 1/sqrt(2) of ROS2
+#define ROS2_GAMMA 1.7071067811865475
+
+/************************************************
+ * dims
+ ************************************************/
+
+int sim_rosenbrock_dims_calculate_size()
+{
+    int size = sizeof(sim_rosenbrock_dims);
+
+    return size;
+}
+
+
+
+void *sim_rosenbrock_dims_assign(void *config_, void *raw_memory)
+{
+    char *c_ptr = raw_memory;
+
+    sim_rosenbrock_dims *dims = (sim_rosenbrock_dims *) c_ptr;
+    c_ptr += sizeof(sim_rosenbrock_dims);
+
+    dims->nx = 0;
+    dims->nu = 0;
+    dims->nz = 0;
+
+    assert((char *) raw_memory + sim_rosenbrock_dims_calculate_size() >= c_ptr);
+
+    return dims;
+}
+
+
+
+void sim_rosenbrock_dims_set(void *config_, void *dims_, const char *field, const int *value)
+{
+    sim_rosenbrock_dims *dims = (sim_rosenbrock_dims *) dims_;
+
+    if (!strcmp(field, "nx"))
+    {
+        dims->nx = *value;
+    }
+    else if (!strcmp(field, "nu"))
+    {
+        dims->nu = *value;
+    }
+    else if (!strcmp(field, "nz"))
+    {
+        if (*value != 0)
+        {
+            printf("\nerror: nz != 0\n");
+            printf("algebraic variables not supported by Rosenbrock module\n");
+            exit(1);
+        }
+    }
+    else if (!strcmp(field, "n_dense"))
+    {
+        if (*value != 0)
+        {
+            printf("\nerror: n_dense != 0\n");
+            printf("dense output not supported by Rosenbrock module\n");
+            exit(1);
+        }
+    }
+    else
+    {
+        printf("\nerror: sim_rosenbrock_dims_set: dim type not available: %s\n", field);
+        exit(1);
+    }
+}
+
+
+
+void sim_rosenbrock_dims_get(void *config_, void *dims_, const char *field, int *value)
+{
+    sim_rosenbrock_dims *dims = (sim_rosenbrock_dims *) dims_;
+
+    if (!strcmp(field, "nx"))
+    {
+        *value = dims->nx;
+    }
+    else if (!strcmp(field, "nu"))
+    {
+        *value = dims->nu;
+    }
+    else if (!strcmp(field, "nz"))
+    {
+        *value = 0;
+    }
+    else if (!strcmp(field, "n_dense"))
+    {
+        *value = 0;
+    }
+    else
+    {
+        printf("\nerror: sim_rosenbrock_dims_get: dim type not available: %s\n", field);
+        exit(1);
+    }
+}
+
+
+
+/************************************************
+ * model
+ ************************************************/
+
+int sim_rosenbrock_model_calculate_size(void *config, void *dims)
+{
+    int size = 0;
+
+    size += sizeof(rosenbrock_model);
+
+    return size;
+}
+
+
+
+void *sim_rosenbrock_model_assign(void *config, void *dims, void *raw_memory)
+{
+    char *c_ptr = (char *) raw_memory;
+
+    rosenbrock_model *model = (rosenbrock_model *) c_ptr;
+    c_ptr += sizeof(rosenbrock_model);
+
+    model->expl_ode_fun = NULL;
+    model->expl_vde_for = NULL;
+
+    return model;
+}
+
+
+
+int sim_rosenbrock_model_set(void *model_, const char *field, void *value)
+{
+    rosenbrock_model *model = model_;
+
+    if (!strcmp(field, "expl_ode_fun"))
+    {
+        model->expl_ode_fun = value;
+    }
+    else if (!strcmp(field, "expl_vde_for") || !strcmp(field, "expl_vde_forw"))
+    {
+        model->expl_vde_for = value;
+    }
+    else
+    {
+        printf("\nerror: sim_rosenbrock_model_set: wrong field: %s\n", field);
+        exit(1);
+    }
+
+    return ACADOS_SUCCESS;
+}
+
+
+
+/************************************************
+ * opts
+ ************************************************/
+
+int sim_rosenbrock_opts_calculate_size(void *config_, void *dims)
+{
+    int ns_max = NS_MAX;
+
+    int size = sizeof(sim_opts);
+
+    size += ns_max * ns_max * sizeof(double);  // A_mat
+    size += ns_max * sizeof(double);           // b_vec
+    size += ns_max * sizeof(double);           // c_vec
+    size += ns_max * sizeof(double);           // e_vec
+
+    make_int_multiple_of(8, &size);
+    size += 1 * 8;
+
+    return size;
+}
+
+
+
+void *sim_rosenbrock_opts_assign(void *config_, void *dims, void *raw_memory)
+{
+    int ns_max = NS_MAX;
+
+    char *c_ptr = (char *) raw_memory;
+
+    sim_opts *opts = (sim_opts *) c_ptr;
+    c_ptr += sizeof(sim_opts);
+
+    align_char_to(8, &c_ptr);
+
+    assign_and_advance_double(ns_max * ns_max, &opts->A_mat, &c_ptr);
+    assign_and_advance_double(ns_max, &opts->b_vec, &c_ptr);
+    assign_and_advance_double(ns_max, &opts->c_vec, &c_ptr);
+    assign_and_advance_double(ns_max, &opts->e_vec, &c_ptr);
+
+    assert((char *) raw_memory + sim_rosenbrock_opts_calculate_size(config_, dims) >= c_ptr);
+
+    opts->newton_iter = 0;
+    opts->newton_tol = 0.0;
+    opts->scheme = NULL;
+
+    return (void *) opts;
+}
+
+
+
+void sim_rosenbrock_opts_set(void *config_, void *opts_, const char *field, void *value)
+{
+    sim_opts *opts = (sim_opts *) opts_;
+    sim_opts_set_(opts, field, value);
+}
+
+
+
+void sim_rosenbrock_opts_get(void *config_, void *opts_, const char *field, void *value)
+{
+    sim_opts *opts = (sim_opts *) opts_;
+    sim_opts_get_(config_, opts, field, value);
+}
+
+
+
+// the stages of ROS2 are fixed, the tableau is not used
+static void sim_rosenbrock_set_tableau(sim_opts *opts)
+{
+    opts->ns = 2;
+    opts->tableau_size = 0;
+}
+
+
+
+void sim_rosenbrock_opts_initialize_default(void *config_, void *dims_, void *opts_)
+{
+    sim_opts *opts = opts_;
+    sim_rosenbrock_dims *dims = (sim_rosenbrock_dims *) dims_;
+
+    sim_rosenbrock_set_tableau(opts);
+
+    opts->adaptive_steps = false;
+
+    opts->num_steps = 1;
+    opts->num_forw_sens = dims->nx + dims->nu;
+    opts->jac_reuse = false;
+    opts->sens_forw = true;
+    opts->sens_adj = false;
+    opts->sens_hess = false;
+
+    opts->output_z = false;
+    opts->sens_algebraic = false;
+    opts->exact_z_output = false;
+}
+
+
+
+void sim_rosenbrock_opts_update(void *config_, void *dims, void *opts_)
+{
+    sim_opts *opts = opts_;
+
+    sim_rosenbrock_set_tableau(opts);
+
+    return;
+}
+
+
+
+/************************************************
+ * memory
+ ************************************************/
+
+int sim_rosenbrock_memory_calculate_size(void *config, void *dims, void *opts_)
+{
+    int size = sizeof(sim_rosenbrock_memory);
+
+    return size;
+}
+
+
+
+void *sim_rosenbrock_memory_assign(void *config, void *dims, void *opts_, void *raw_memory)
+{
+    char *c_ptr = (char *) raw_memory;
+
+    sim_rosenbrock_memory *mem = (sim_rosenbrock_memory *) c_ptr;
+    c_ptr += sizeof(sim_rosenbrock_memory);
+
+    mem->time_sim = 0.0;
+    mem->time_ad = 0.0;
+    mem->time_la = 0.0;
+
+    return mem;
+}
+
+
+
+int sim_rosenbrock_memory_set(void *config_, void *dims_, void *mem_, const char *field,
+                              void *value)
+{
+    printf("sim_rosenbrock_memory_set field %s is not supported! \n", field);
+    exit(1);
+}
+
+
+
+int sim_rosenbrock_memory_set_to_zero(void *config_, void * dims_, void *opts_, void *mem_,
+                                      const char *field)
+{
+    int status = ACADOS_SUCCESS;
+
+    if (!strcmp(field, "guesses"))
+    {
+        // no guesses/initialization in Rosenbrock
+    }
+    else
+    {
+        printf("sim_rosenbrock_memory_set_to_zero field %s is not supported! \n", field);
+        exit(1);
+    }
+
+    return status;
+}
+
+
+
+void sim_rosenbrock_memory_get(void *config_, void *dims_, void *mem_, const char *field,
+                               void *value)
+{
+    sim_rosenbrock_memory *mem = mem_;
+
+    if (!strcmp(field, "time_sim"))
+    {
+        double *ptr = value;
+        *ptr = mem->time_sim;
+    }
+    else if (!strcmp(field, "time_sim_ad"))
+    {
+        double *ptr = value;
+        *ptr = mem->time_ad;
+    }
+    else if (!strcmp(field, "time_sim_la"))
+    {
+        double *ptr = value;
+        *ptr = mem->time_la;
+    }
+    else
+    {
+        printf("sim_rosenbrock_memory_get field %s is not supported! \n", field);
+        exit(1);
+    }
+}
+
+
+
+/************************************************
+ * workspace
+ ************************************************/
+
+int sim_rosenbrock_workspace_calculate_size(void *config_, void *dims_, void *opts_)
+{
+    sim_rosenbrock_dims *dims = (sim_rosenbrock_dims *) dims_;
+
+    int nx = dims->nx;
+    int nu = dims->nu;
+
+    // sized for the sensitivities, which can be switched on and off after creation
+    int nX = nx * (1 + nx + nu);
+
+    int size = sizeof(sim_rosenbrock_workspace);
+
+    size += 6 * nX * sizeof(double);  // jac_in jac_out forw rhs_in K1 K2
+    size += nx * nx * sizeof(double);  // W
+    size += nx * sizeof(int);  // ipiv
+
+    size += 8;  // align
+
+    return size;
+}
+
+
+
+static void *sim_rosenbrock_cast_workspace(void *config_, void *dims_, void *opts_,
+                                           void *raw_memory)
+{
+    sim_rosenbrock_dims *dims = (sim_rosenbrock_dims *) dims_;
+
+    int nx = dims->nx;
+    int nu = dims->nu;
+
+    int nX = nx * (1 + nx + nu);
+
+    char *c_ptr = (char *) raw_memory;
+
+    sim_rosenbrock_workspace *work = (sim_rosenbrock_workspace *) c_ptr;
+    c_ptr += sizeof(sim_rosenbrock_workspace);
+
+    align_char_to(8, &c_ptr);
+
+    assign_and_advance_double(nX, &work->jac_in, &c_ptr);
+    assign_and_advance_double(nX, &work->jac_out, &c_ptr);
+    assign_and_advance_double(nX, &work->forw, &c_ptr);
+    assign_and_advance_double(nX, &work->rhs_in, &c_ptr);
+    assign_and_advance_double(nX, &work->K1, &c_ptr);
+    assign_and_advance_double(nX, &work->K2, &c_ptr);
+    assign_and_advance_double(nx * nx, &work->W, &c_ptr);
+
+    assign_and_advance_int(nx, &work->ipiv, &c_ptr);
+
+    assert((char *) raw_memory + sim_rosenbrock_workspace_calculate_size(config_, dims, opts_)
+           >= c_ptr);
+
+    return (void *) work;
+}
+
+
+
+/************************************************
+ * functions
+ ************************************************/
+
+int sim_rosenbrock_precompute(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_,
+                              void *work_)
+{
+    return ACADOS_SUCCESS;
+}
+
+
+
+// evaluates f (and with sens, the forward vde) at x_in = x + Sx + Su, writes f + Sx_dot + Su_dot
+static void sim_rosenbrock_eval_rhs(rosenbrock_model *model, int nx, int nu, int sens,
+                                    double *x_in, double *u, double *out)
+{
+    ext_fun_arg_t ext_fun_type_in[4];
+    void *ext_fun_in[4];
+    ext_fun_arg_t ext_fun_type_out[3];
+    void *ext_fun_out[3];
+
+    if (sens)
+    {
+        ext_fun_type_in[0] = COLMAJ;
+        ext_fun_in[0] = x_in;  // x: nx
+        ext_fun_type_in[1] = COLMAJ;
+        ext_fun_in[1] = x_in + nx;  // Sx: nx*nx
+        ext_fun_type_in[2] = COLMAJ;
+        ext_fun_in[2] = x_in + nx + nx * nx;  // Su: nx*nu
+        ext_fun_type_in[3] = COLMAJ;
+        ext_fun_in[3] = u;  // u: nu
+
+        ext_fun_type_out[0] = COLMAJ;
+        ext_fun_out[0] = out;  // fun: nx
+        ext_fun_type_out[1] = COLMAJ;
+        ext_fun_out[1] = out + nx;  // Sx: nx*nx
+        ext_fun_type_out[2] = COLMAJ;
+        ext_fun_out[2] = out + nx + nx * nx;  // Su: nx*nu
+
+        model->expl_vde_for->evaluate(model->expl_vde_for, ext_fun_type_in, ext_fun_in,
+                                      ext_fun_type_out, ext_fun_out);
+    }
+    else
+    {
+        ext_fun_type_in[0] = COLMAJ;
+        ext_fun_in[0] = x_in;  // x: nx
+        ext_fun_type_in[1] = COLMAJ;
+        ext_fun_in[1] = u;  // u: nu
+
+        ext_fun_type_out[0] = COLMAJ;
+        ext_fun_out[0] = out;  // fun: nx
+
+        model->expl_ode_fun->evaluate(model->expl_ode_fun, ext_fun_type_in, ext_fun_in,
+                                      ext_fun_type_out, ext_fun_out);
+    }
+}
+
+
+
+int sim_rosenbrock(void *config_, sim_in *in, sim_out *out, void *opts_, void *mem_, void *work_)
+{
+    sim_opts *opts = opts_;
+    sim_rosenbrock_memory *mem = mem_;
+    sim_rosenbrock_dims *dims = (sim_rosenbrock_dims *) in->dims;
+    sim_rosenbrock_workspace *work = sim_rosenbrock_cast_workspace(config_, dims, opts, work_);
+    rosenbrock_model *model = in->model;
+
+    int i, j, istep;
+    int nx = dims->nx;
+    int nu = dims->nu;
+
+    if (opts->sens_hess)
+    {
+        printf("\nerror: sim_rosenbrock: hessian propagation not supported\n");
+        exit(1);
+    }
+    if (model->expl_vde_for == NULL)
+    {
+        printf("\nerror: sim_rosenbrock: expl_vde_for is not provided\n");
+        exit(1);
+    }
+
+    // the adjoint sensitivities are computed from the forward sensitivities
+    int sens = opts->sens_forw || opts->sens_adj;
+    int nf = sens ? nx + nu : 0;
+    int nX = nx * (1 + nf);
+
+    if (!sens && model->expl_ode_fun == NULL)
+    {
+        printf("\nerror: sim_rosenbrock: expl_ode_fun is not provided\n");
+        exit(1);
+    }
+
+    int num_steps = opts->num_steps;
+    double step = in->T / num_steps;
+    double gamma_step = ROS2_GAMMA * step;
+
+    double *u = in->u;
+
+    double *jac_in = work->jac_in;
+    double *jac_out = work->jac_out;
+    double *forw = work->forw;
+    double *rhs_in = work->rhs_in;
+    double *K1 = work->K1;
+    double *K2 = work->K2;
+    double *W = work->W;
+    int *ipiv = work->ipiv;
+
+    double *df_dx = jac_out + nx;
+    double *df_du = jac_out + nx + nx * nx;
+
+    acados_timer timer, timer_ad, timer_la;
+    double timing_ad = 0.0;
+    double timing_la = 0.0;
+
+    int status = ACADOS_SUCCESS;
+
+    acados_tic(&timer);
+
+    // identity seed for the jacobians
+    for (i = 0; i < nx * (nx + nu); i++)
+        jac_in[nx + i] = 0.0;
+    for (i = 0; i < nx; i++)
+        jac_in[nx + i * (nx + 1)] = 1.0;
+
+    // initialize forw = [x, eye(nx), zeros(nx, nu)]
+    for (i = 0; i < nx; i++)
+        forw[i] = in->x[i];
+    for (i = 0; i < nx * nf; i++)
+        forw[nx + i] = jac_in[nx + i];
+
+    for (istep = 0; istep < num_steps; istep++)
+    {
+        int new_jac = istep == 0 || !opts->jac_reuse;
+
+        // f, df_dx, df_du at the current state; f only if the jacobians are not needed
+        for (i = 0; i < nx; i++)
+            jac_in[i] = forw[i];
+        acados_tic(&timer_ad);
+        sim_rosenbrock_eval_rhs(model, nx, nu, new_jac || sens, jac_in, u, jac_out);
+        timing_ad += acados_toc(&timer_ad);
+
+        acados_tic(&timer_la);
+        if (new_jac)
+        {
+            // W = eye(nx) - gamma * step * df_dx
+            for (j = 0; j < nx; j++)
+            {
+                for (i = 0; i < nx; i++)
+                    W[i + nx * j] = - gamma_step * df_dx[i + nx * j];
+                W[j + nx * j] += 1.0;
+            }
+            int info = 0;
+            dgetf2_3l(nx, nx, W, nx, ipiv, &info);
+            if (info != 0)
+            {
+                status = ACADOS_FAILURE;
+                break;
+            }
+        }
+
+        // first stage: W * K1 = step * [f, df_dx * S + [0, df_du]]
+        for (i = 0; i < nx; i++)
+            K1[i] = step * jac_out[i];
+        if (sens)
+        {
+            dgemm_nn_3l(nx, nf, nx, df_dx, nx, forw + nx, nx, K1 + nx, nx);
+            for (i = 0; i < nx * nu; i++)
+                K1[nx + nx * nx + i] += df_du[i];
+            for (i = 0; i < nx * nf; i++)
+                K1[nx + i] *= step;
+        }
+        dgetrs_3l(nx, 1 + nf, W, nx, ipiv, K1, nx);
+        timing_la += acados_toc(&timer_la);
+
+        // second stage: W * K2 = step * rhs(forw + K1) - 2 * K1
+        for (i = 0; i < nX; i++)
+            rhs_in[i] = forw[i] + K1[i];
+        acados_tic(&timer_ad);
+        sim_rosenbrock_eval_rhs(model, nx, nu, sens, rhs_in, u, K2);
+        timing_ad += acados_toc(&timer_ad);
+
+        acados_tic(&timer_la);
+        for (i = 0; i < nX; i++)
+            K2[i] = step * K2[i] - 2.0 * K1[i];
+        dgetrs_3l(nx, 1 + nf, W, nx, ipiv, K2, nx);
+        timing_la += acados_toc(&timer_la);
+
+        for (i = 0; i < nX; i++)
+            forw[i] += 1.5 * K1[i] + 0.5 * K2[i];
+    }
+
+    // store result
+    for (i = 0; i < nx; i++)
+        out->xn[i] = forw[i];
+
+    double *Sx = forw + nx;
+    double *Su = forw + nx + nx * nx;
+
+    if (opts->sens_forw)
+    {
+        if (in->identity_seed)
+        {
+            for (i = 0; i < nx * (nx + nu); i++)
+                out->S_forw[i] = Sx[i];
+        }
+        else
+        {
+            // apply the forward seed [Sx_in, Su_in]: [Sx * Sx_in, Sx * Su_in + Su]
+            dgemm_nn_3l(nx, nx + nu, nx, Sx, nx, in->S_forw, nx, out->S_forw, nx);
+            for (i = 0; i < nx * nu; i++)
+                out->S_forw[nx * nx + i] += Su[i];
+        }
+    }
+
+    if (opts->sens_adj)
+    {
+        // S_adj = [Sx, Su]' * seed
+        for (j = 0; j < nx + nu; j++)
+        {
+            out->S_adj[j] = 0.0;
+            for (i = 0; i < nx; i++)
+                out->S_adj[j] += Sx[i + nx * j] * in->S_adj[i];
+        }
+    }
+
+    // store timings
+    out->info->CPUtime = acados_toc(&timer);
+    out->info->LAtime = timing_la;
+    out->info->ADtime = timing_ad;
+
+    mem->time_sim = out->info->CPUtime;
+    mem->time_ad = out->info->ADtime;
+    mem->time_la = out->info->LAtime;
+
+    return status;
+}
+
+
+
+void sim_rosenbrock_config_initialize_default(void *config_)
+{
+    sim_config *config = config_;
+
+    config->opts_calculate_size = &sim_rosenbrock_opts_calculate_size;
+    config->opts_assign = &sim_rosenbrock_opts_assign;
+    config->opts_initialize_default = &sim_rosenbrock_opts_initialize_default;
+    config->opts_update = &sim_rosenbrock_opts_update;
+    config->opts_set = &sim_rosenbrock_opts_set;
+    config->opts_get = &sim_rosenbrock_opts_get;
+    config->memory_calculate_size = &sim_rosenbrock_memory_calculate_size;
+    config->memory_assign = &sim_rosenbrock_memory_assign;
+    config->memory_set = &sim_rosenbrock_memory_set;
+    config->memory_set_to_zero = &sim_rosenbrock_memory_set_to_zero;
+    config->memory_get = &sim_rosenbrock_memory_get;
+    config->workspace_calculate_size = &sim_rosenbrock_workspace_calculate_size;
+    config->model_calculate_size = &sim_rosenbrock_model_calculate_size;
+    config->model_assign = &sim_rosenbrock_model_assign;
+    config->model_set = &sim_rosenbrock_model_set;
+    config->evaluate = &sim_rosenbrock;
+    config->precompute = &sim_rosenbrock_precompute;
+    config->config_initialize_default = &sim_rosenbrock_config_initialize_default;
+    config->dims_calculate_size = &sim_rosenbrock_dims_calculate_size;
+    config->dims_assign = &sim_rosenbrock_dims_assign;
+    config->dims_set = &sim_rosenbrock_dims_set;
+    config->dims_get = &sim_rosenbrock_dims_get;
+    return;
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2019 Gianluca Frison, Dimitris Kouzoupis, Robin Verschueren,
+ * Andrea Zanelli, Niels van Duijkeren, Jonathan Frey, Tommaso Sartor,
+ * Branimir Novoselnik, Rien Quirynen, Rezart Qelibari, Dang Doan,
+ * Jonas Koenemann, Yutao Chen, Tobias Schöls, Jonas Schlagenhauf, Moritz Diehl
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#ifndef ACADOS_SIM_SIM_ROSENBROCK_INTEGRATOR_H_
+#define ACADOS_SIM_SIM_ROSENBROCK_INTEGRATOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "acados/sim/sim_common.h"
+#include "acados/utils/types.h"
+
+
+
+typedef struct
+{
+    int nx;
+    int nu;
+    int nz;
+} sim_rosenbrock_dims;
+
+
+
+typedef struct
+{
+    /* external functions */
+    // explicit ode
+    external_function_generic *expl_ode_fun;
+    // forward explicit vde, also used with identity seeds to obtain the jacobians
+    external_function_generic *expl_vde_for;
+
+} rosenbrock_model;
+
+
+
+typedef struct
+{
+	// memory
+	double time_sim;
+	double time_ad;
+	double time_la;
+
+} sim_rosenbrock_memory;
+
+
+
+typedef struct
+{
+	// workspace mem
+    double *jac_in;   // x + [eye(nx), zeros(nx, nu)], input of expl_vde_for for the jacobians
+    double *jac_out;  // f + df_dx + df_du at the start of a step
+    double *forw;     // x + Sx + Su, sensitivities w.r.t. (x0, u)
+    double *rhs_in;   // x + Sx + Su of the second stage
+    double *K1;       // first stage, x + Sx + Su
+    double *K2;       // second stage, x + Sx + Su
+    double *W;        // LU factorization of eye(nx) - gamma * step * df_dx
+    int *ipiv;
+
+} sim_rosenbrock_workspace;
+
+
+
+// dims
+int sim_rosenbrock_dims_calculate_size();
+void *sim_rosenbrock_dims_assign(void *config_, void *raw_memory);
+void sim_rosenbrock_dims_set(void *config_, void *dims_, const char *field, const int* value);
+void sim_rosenbrock_dims_get(void *config_, void *dims_, const char *field, int* value);
+
+// model
+int sim_rosenbrock_model_calculate_size(void *config, void *dims);
+void *sim_rosenbrock_model_assign(void *config, void *dims, void *raw_memory);
+int sim_rosenbrock_model_set(void *model, const char *field, void *value);
+
+// opts
+int sim_rosenbrock_opts_calculate_size(void *config, void *dims);
+//
+void sim_rosenbrock_opts_update(void *config_, void *dims, void *opts_);
+//
+void *sim_rosenbrock_opts_assign(void *config, void *dims, void *raw_memory);
+//
+void sim_rosenbrock_opts_initialize_default(void *config, void *dims, void *opts_);
+//
+void sim_rosenbrock_opts_set(void *config_, void *opts_, const char *field, void *value);
+
+
+// memory
+int sim_rosenbrock_memory_calculate_size(void *config, void *dims, void *opts_);
+//
+void *sim_rosenbrock_memory_assign(void *config, void *dims, void *opts_, void *raw_memory);
+//
+int sim_rosenbrock_memory_set(void *config_, void *dims_, void *mem_, const char *field,
+                              void *value);
+
+
+// workspace
+int sim_rosenbrock_workspace_calculate_size(void *config, void *dims, void *opts_);
+
+// S_forw and S_adj are approximate: the W-method applied to the variational equations,
+// not the exact derivative of the discrete map, which biases an OCP optimum by O(step^2)
+// (see sim_rosenbrock_integrator.c)
+int sim_rosenbrock(void *config, sim_in *in, sim_out *out, void *opts_, void *mem_, void *work_);
+//
+void sim_rosenbrock_config_initialize_default(void *config);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  // ACADOS_SIM_SIM_ROSENBROCK_INTEGRATOR_H_
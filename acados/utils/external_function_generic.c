@@ -190,111 +190,59 @@ static int casadi_nnz(const int *sparsity)
 
 
 
-static void d_cvt_casadi_to_colmaj(double *in, int *sparsity_in, double *out)
+static int casadi_sparsity_calculate_size(const int *sparsity)
 {
-    int ii, jj, idx;
-
-    int nrow = sparsity_in[0];
-    int ncol = sparsity_in[1];
-    int dense = sparsity_in[2];
-
-    if ((nrow<=0 )| (ncol<=0))
-        return;
+    int size = 0;
 
-    if (dense)
-    {
-        for (ii = 0; ii < ncol * nrow; ii++) out[ii] = in[ii];
-    }
-    else
+    if (sparsity != NULL)
     {
-        double *ptr = in;
-        int *idxcol = sparsity_in + 2;
-        int *row = sparsity_in + ncol + 3;
-        // Fill with zeros
-        for (jj = 0; jj < ncol; jj++)
-            for (ii = 0; ii < nrow; ii++) out[ii + jj * nrow] = 0.0;
-        // Copy nonzeros
-        for (jj = 0; jj < ncol; jj++)
-        {
-            for (idx = idxcol[jj]; idx != idxcol[jj + 1]; idx++)
-            {
-                out[row[idx] + jj * nrow] = ptr[0];
-                ptr++;
-            }
-        }
+        int nnz = casadi_nnz(sparsity);
+        // row and column index of each nonzero, unless all entries are stored
+        if (nnz != sparsity[0] * sparsity[1])
+            size += 2 * nnz * sizeof(int);
     }
 
-    return;
+    return size;
 }
 
 
 
-static void d_cvt_colmaj_to_casadi(double *in, double *out, int *sparsity_out)
+// unpack the casadi sparsity pattern once, such that the wrappers do not rescan it on each call
+static void casadi_sparsity_assign(const int *sparsity, external_function_casadi_sparsity *sp,
+                                   char **c_ptr)
 {
-    int ii, jj, idx;
-
-    int nrow = sparsity_out[0];
-    int ncol = sparsity_out[1];
-    int dense = sparsity_out[2];
+    sp->row = NULL;
+    sp->col = NULL;
 
-    if ((nrow<=0 )| (ncol<=0))
-        return;
-
-    if (dense)
+    if (sparsity == NULL)
     {
-        for (ii = 0; ii < ncol * nrow; ii++) out[ii] = in[ii];
-    }
-    else
-    {
-        double *ptr = out;
-        int *idxcol = sparsity_out + 2;
-        int *row = sparsity_out + ncol + 3;
-        // Copy nonzeros
-        for (jj = 0; jj < ncol; jj++)
-        {
-            for (idx = idxcol[jj]; idx != idxcol[jj + 1]; idx++)
-            {
-                ptr[0] = in[row[idx] + jj * nrow];
-                ptr++;
-            }
-        }
+        sp->nrow = 0;
+        sp->ncol = 0;
+        sp->nnz = 0;
+        sp->dense = 1;
+        return;
     }
 
-    return;
-}
-
-
+    sp->nrow = sparsity[0];
+    sp->ncol = sparsity[1];
+    sp->nnz = casadi_nnz(sparsity);
+    // row indices are sorted within each column, so a full pattern is stored column-major
+    sp->dense = sp->nnz == sp->nrow * sp->ncol;
 
-// TODO(all): detect if dense from number of elements per column !!!
-static void d_cvt_casadi_to_dmat(double *in, int *sparsity_in, struct blasfeo_dmat *out)
-{
-    int jj, idx;
-
-    int nrow = sparsity_in[0];
-    int ncol = sparsity_in[1];
-    int dense = sparsity_in[2];
+    if (!sp->dense)
+    {
+        const int *idxcol = sparsity + 2;
+        const int *row = sparsity + sp->ncol + 3;
 
-    if ((nrow<=0 )| (ncol<=0))
-        return;
+        assign_and_advance_int(sp->nnz, &sp->row, c_ptr);
+        assign_and_advance_int(sp->nnz, &sp->col, c_ptr);
 
-    if (dense)
-    {
-        blasfeo_pack_dmat(nrow, ncol, in, nrow, out, 0, 0);
-    }
-    else
-    {
-        double *ptr = in;
-        int *idxcol = sparsity_in + 2;
-        int *row = sparsity_in + ncol + 3;
-        // Fill with zeros
-        blasfeo_dgese(nrow, ncol, 0.0, out, 0, 0);
-        // Copy nonzeros
-        for (jj = 0; jj < ncol; jj++)
+        for (int jj = 0; jj < sp->ncol; jj++)
         {
-            for (idx = idxcol[jj]; idx != idxcol[jj + 1]; idx++)
+            for (int idx = idxcol[jj]; idx != idxcol[jj + 1]; idx++)
             {
-                BLASFEO_DMATEL(out, row[idx], jj) = ptr[0];
-                ptr++;
+                sp->row[idx] = row[idx];
+                sp->col[idx] = jj;
             }
         }
     }
@@ -304,153 +252,149 @@ static void d_cvt_casadi_to_dmat(double *in, int *sparsity_in, struct blasfeo_dm
 
 
 
-// TODO(all): detect if dense from number of elements per column !!!
-static void d_cvt_dmat_to_casadi(struct blasfeo_dmat *in, double *out, int *sparsity_out)
+// pointer to the data of a dense argument if casadi can read/write it in place, NULL otherwise
+static double *d_casadi_direct_ptr(external_function_casadi_sparsity *sp, ext_fun_arg_t type,
+                                   void *arg)
 {
-    int jj, idx;
-
-    int nrow = sparsity_out[0];
-    int ncol = sparsity_out[1];
-    int dense = sparsity_out[2];
+    if (!sp->dense)
+        return NULL;
 
-    if ((nrow<=0 )| (ncol<=0))
-        return;
-
-    if (dense)
-    {
-        blasfeo_unpack_dmat(nrow, ncol, in, 0, 0, out, nrow);
-    }
-    else
+    switch (type)
     {
-        double *ptr = out;
-        int *idxcol = sparsity_out + 2;
-        int *row = sparsity_out + ncol + 3;
-        // Copy nonzeros
-        for (jj = 0; jj < ncol; jj++)
+        case COLMAJ:
+            return arg;
+
+        case COLMAJ_ARGS:
         {
-            for (idx = idxcol[jj]; idx != idxcol[jj + 1]; idx++)
-            {
-                ptr[0] = BLASFEO_DMATEL(in, row[idx], jj);
-                ptr++;
-            }
+            struct colmaj_args *args = arg;
+            if (args->lda == sp->nrow || sp->ncol <= 1)
+                return args->A;
+            return NULL;
         }
-    }
 
-    return;
-}
-
-
-
-// column vector: assume sparsity_in[1] = 1 !!! or empty vector;
-// TODO(all): detect if dense from number of elements per column !!!
-static void d_cvt_casadi_to_dvec(double *in, int *sparsity_in, struct blasfeo_dvec *out)
-{
-    int idx;
-
-    assert((sparsity_in[1] == 1) | (sparsity_in[0] == 0) | (sparsity_in[1] == 0));
-
-    int n = sparsity_in[0];
-    int dense = sparsity_in[2];
-
-    if (n<=0)
-        return;
+        case BLASFEO_DVEC:
+        {
+            struct blasfeo_dvec *x = arg;
+            return x->pa;
+        }
 
-    if (dense)
-    {
-        blasfeo_pack_dvec(n, in, out, 0);
-    }
-    else
-    {
-        double *ptr = in;
-        int *idxcol = sparsity_in + 2;
-        int *row = sparsity_in + 1 + 3;
-        // Fill with zeros
-        blasfeo_dvecse(n, 0.0, out, 0);
-        // Copy nonzeros
-        for (idx = idxcol[0]; idx != idxcol[1]; idx++)
+        case BLASFEO_DVEC_ARGS:
         {
-            BLASFEO_DVECEL(out, row[idx]) = ptr[0];
-            ptr++;
+            struct blasfeo_dvec_args *args = arg;
+            return args->x->pa + args->xi;
         }
-    }
 
-    return;
+        default:
+            // panel-major blasfeo matrices are always converted
+            return NULL;
+    }
 }
 
 
 
-// column vector: assume sparsity_in[1] = 1 !!! or empty vector;
-// TODO(all): detect if dense from number of elements per column !!!
-static void d_cvt_dvec_to_casadi(struct blasfeo_dvec *in, double *out, int *sparsity_out)
+// convert an acados argument into the casadi sparse storage
+static void d_cvt_arg_to_casadi(external_function_casadi_sparsity *sp, ext_fun_arg_t type,
+                                void *in, double *out)
 {
-    int idx;
-
-    assert((sparsity_out[1] == 1) | (sparsity_out[0] == 0) | (sparsity_out[1] == 0));
+    int ii, jj, kk;
 
-    int n = sparsity_out[0];
-    int dense = sparsity_out[2];
+    int nrow = sp->nrow;
+    int ncol = sp->ncol;
+    int *row = sp->row;
+    int *col = sp->col;
 
-    if (n<=0)
+    if ((nrow <= 0) | (ncol <= 0))
         return;
 
-    if (dense)
+    switch (type)
     {
-        blasfeo_unpack_dvec(n, in, 0, out);
-    }
-    else
-    {
-        double *ptr = out;
-        int *idxcol = sparsity_out + 2;
-        int *row = sparsity_out + 1 + 3;
-        // Copy nonzeros
-        for (idx = idxcol[0]; idx != idxcol[1]; idx++)
+        case COLMAJ:
+        case COLMAJ_ARGS:
         {
-            ptr[0] = BLASFEO_DVECEL(in, row[idx]);
-            ptr++;
-        }
-    }
-
-    return;
-}
-
+            double *A;
+            int lda;
+            if (type == COLMAJ)
+            {
+                A = in;
+                lda = nrow;
+            }
+            else
+            {
+                A = ((struct colmaj_args *) in)->A;
+                lda = ((struct colmaj_args *) in)->lda;
+            }
 
+            if (sp->dense)
+            {
+                for (jj = 0; jj < ncol; jj++)
+                    for (ii = 0; ii < nrow; ii++) out[ii + jj * nrow] = A[ii + jj * lda];
+            }
+            else
+            {
+                for (kk = 0; kk < sp->nnz; kk++) out[kk] = A[row[kk] + col[kk] * lda];
+            }
+            break;
+        }
 
-static void d_cvt_casadi_to_colmaj_args(double *in, int *sparsity_in, struct colmaj_args *out)
-{
-    int ii, jj, idx;
+        case BLASFEO_DMAT:
+        case BLASFEO_DMAT_ARGS:
+        {
+            struct blasfeo_dmat *A;
+            int ai = 0, aj = 0;
+            if (type == BLASFEO_DMAT)
+            {
+                A = in;
+            }
+            else
+            {
+                A = ((struct blasfeo_dmat_args *) in)->A;
+                ai = ((struct blasfeo_dmat_args *) in)->ai;
+                aj = ((struct blasfeo_dmat_args *) in)->aj;
+            }
 
-    int nrow = sparsity_in[0];
-    int ncol = sparsity_in[1];
-    int dense = sparsity_in[2];
+            if (sp->dense)
+            {
+                blasfeo_unpack_dmat(nrow, ncol, A, ai, aj, out, nrow);
+            }
+            else
+            {
+                for (kk = 0; kk < sp->nnz; kk++)
+                    out[kk] = BLASFEO_DMATEL(A, ai + row[kk], aj + col[kk]);
+            }
+            break;
+        }
 
-    if ((nrow<=0 )| (ncol<=0))
-        return;
+        case BLASFEO_DVEC:
+        case BLASFEO_DVEC_ARGS:
+        {
+            // column vector: assume ncol = 1
+            assert(ncol == 1);
 
-    double *A = out->A;
-    int lda = out->lda;
+            struct blasfeo_dvec *x;
+            int xi = 0;
+            if (type == BLASFEO_DVEC)
+            {
+                x = in;
+            }
+            else
+            {
+                x = ((struct blasfeo_dvec_args *) in)->x;
+                xi = ((struct blasfeo_dvec_args *) in)->xi;
+            }
 
-    if (dense)
-    {
-        for (ii = 0; ii < ncol; ii++)
-            for (jj = 0; jj < nrow; jj++) A[ii + jj * lda] = in[ii + ncol * jj];
-    }
-    else
-    {
-        double *ptr = in;
-        int *idxcol = sparsity_in + 2;
-        int *row = sparsity_in + ncol + 3;
-        // Fill with zeros
-        for (jj = 0; jj < ncol; jj++)
-            for (ii = 0; ii < nrow; ii++) A[ii + jj * lda] = 0.0;
-        // Copy nonzeros
-        for (jj = 0; jj < ncol; jj++)
-        {
-            for (idx = idxcol[jj]; idx != idxcol[jj + 1]; idx++)
+            if (sp->dense)
             {
-                A[row[idx] + jj * lda] = ptr[0];
-                ptr++;
+                blasfeo_unpack_dvec(nrow, x, xi, out);
             }
+            else
+            {
+                for (kk = 0; kk < sp->nnz; kk++) out[kk] = BLASFEO_DVECEL(x, xi + row[kk]);
+            }
+            break;
         }
+
+        default:
+            break;
     }
 
     return;
@@ -458,82 +402,119 @@ static void d_cvt_casadi_to_colmaj_args(double *in, int *sparsity_in, struct col
 
 
 
-static void d_cvt_colmaj_args_to_casadi(struct colmaj_args *in, double *out, int *sparsity_out)
+// convert the casadi sparse storage into an acados argument
+static void d_cvt_casadi_to_arg(external_function_casadi_sparsity *sp, ext_fun_arg_t type,
+                                double *in, void *out)
 {
-    int ii, jj, idx;
+    int ii, jj, kk;
 
-    int nrow = sparsity_out[0];
-    int ncol = sparsity_out[1];
-    int dense = sparsity_out[2];
+    int nrow = sp->nrow;
+    int ncol = sp->ncol;
+    int *row = sp->row;
+    int *col = sp->col;
 
-    if ((nrow<=0 )| (ncol<=0))
+    if ((nrow <= 0) | (ncol <= 0))
         return;
 
-    double *A = in->A;
-    int lda = in->lda;
-
-    if (dense)
-    {
-        for (ii = 0; ii < ncol; ii++)
-            for (jj = 0; jj < nrow; jj++) out[ii + ncol * jj] = A[ii + jj * lda];
-    }
-    else
+    switch (type)
     {
-        double *ptr = out;
-        int *idxcol = sparsity_out + 2;
-        int *row = sparsity_out + ncol + 3;
-        // Copy nonzeros
-        for (jj = 0; jj < ncol; jj++)
+        case COLMAJ:
+        case COLMAJ_ARGS:
         {
-            for (idx = idxcol[jj]; idx != idxcol[jj + 1]; idx++)
+            double *A;
+            int lda;
+            if (type == COLMAJ)
             {
-                ptr[0] = A[row[idx] + jj * lda];
-                ptr++;
+                A = out;
+                lda = nrow;
+            }
+            else
+            {
+                A = ((struct colmaj_args *) out)->A;
+                lda = ((struct colmaj_args *) out)->lda;
             }
-        }
-    }
-
-    return;
-}
-
 
+            if (sp->dense)
+            {
+                for (jj = 0; jj < ncol; jj++)
+                    for (ii = 0; ii < nrow; ii++) A[ii + jj * lda] = in[ii + jj * nrow];
+            }
+            else
+            {
+                // Fill with zeros
+                for (jj = 0; jj < ncol; jj++)
+                    for (ii = 0; ii < nrow; ii++) A[ii + jj * lda] = 0.0;
+                // Copy nonzeros
+                for (kk = 0; kk < sp->nnz; kk++) A[row[kk] + col[kk] * lda] = in[kk];
+            }
+            break;
+        }
 
-// TODO(all): detect if dense from number of elements per column !!!
-static void d_cvt_casadi_to_dmat_args(double *in, int *sparsity_in, struct blasfeo_dmat_args *out)
-{
-    int jj, idx;
+        case BLASFEO_DMAT:
+        case BLASFEO_DMAT_ARGS:
+        {
+            struct blasfeo_dmat *A;
+            int ai = 0, aj = 0;
+            if (type == BLASFEO_DMAT)
+            {
+                A = out;
+            }
+            else
+            {
+                A = ((struct blasfeo_dmat_args *) out)->A;
+                ai = ((struct blasfeo_dmat_args *) out)->ai;
+                aj = ((struct blasfeo_dmat_args *) out)->aj;
+            }
 
-    int nrow = sparsity_in[0];
-    int ncol = sparsity_in[1];
-    int dense = sparsity_in[2];
+            if (sp->dense)
+            {
+                blasfeo_pack_dmat(nrow, ncol, in, nrow, A, ai, aj);
+            }
+            else
+            {
+                // Fill with zeros
+                blasfeo_dgese(nrow, ncol, 0.0, A, ai, aj);
+                // Copy nonzeros
+                for (kk = 0; kk < sp->nnz; kk++)
+                    BLASFEO_DMATEL(A, ai + row[kk], aj + col[kk]) = in[kk];
+            }
+            break;
+        }
 
-    if ((nrow<=0 )| (ncol<=0))
-        return;
+        case BLASFEO_DVEC:
+        case BLASFEO_DVEC_ARGS:
+        {
+            // column vector: assume ncol = 1
+            assert(ncol == 1);
 
-    struct blasfeo_dmat *A = out->A;
-    int ai = out->ai;
-    int aj = out->aj;
+            struct blasfeo_dvec *x;
+            int xi = 0;
+            if (type == BLASFEO_DVEC)
+            {
+                x = out;
+            }
+            else
+            {
+                x = ((struct blasfeo_dvec_args *) out)->x;
+                xi = ((struct blasfeo_dvec_args *) out)->xi;
+            }
 
-    if (dense)
-    {
-        blasfeo_pack_dmat(nrow, ncol, in, nrow, A, ai, aj);
-    }
-    else
-    {
-        double *ptr = in;
-        int *idxcol = sparsity_in + 2;
-        int *row = sparsity_in + ncol + 3;
-        // Fill with zeros
-        blasfeo_dgese(nrow, ncol, 0.0, A, ai, aj);
-        // Copy nonzeros
-        for (jj = 0; jj < ncol; jj++)
-        {
-            for (idx = idxcol[jj]; idx != idxcol[jj + 1]; idx++)
+            if (sp->dense)
             {
-                BLASFEO_DMATEL(A, ai + row[idx], aj + jj) = ptr[0];
-                ptr++;
+                blasfeo_pack_dvec(nrow, in, x, xi);
             }
+            else
+            {
+                // Fill with zeros
+                blasfeo_dvecse(nrow, 0.0, x, xi);
+                // Copy nonzeros
+                for (kk = 0; kk < sp->nnz; kk++) BLASFEO_DVECEL(x, xi + row[kk]) = in[kk];
+            }
+            break;
         }
+
+        default:
+            break;
     }
 
     return;
@@ -541,39 +522,36 @@ static void d_cvt_casadi_to_dmat_args(double *in, int *sparsity_in, struct blasf
 
 
 
-// TODO(all): detect if dense from number of elements per column !!!
-static void d_cvt_dmat_args_to_casadi(struct blasfeo_dmat_args *in, double *out, int *sparsity_out)
+// set the casadi input pointers, converting only the arguments that cannot be passed in place
+static void casadi_wrapper_in(external_function_casadi_sparsity *sp, int num,
+                              ext_fun_arg_t *type_in, void **in, double **args, double **args_mem)
 {
-    int jj, idx;
-
-    int nrow = sparsity_out[0];
-    int ncol = sparsity_out[1];
-    int dense = sparsity_out[2];
-
-    if ((nrow<=0 )| (ncol<=0))
-        return;
-
-    struct blasfeo_dmat *A = in->A;
-    int ai = in->ai;
-    int aj = in->aj;
-
-    if (dense)
+    for (int ii = 0; ii < num; ii++)
     {
-        blasfeo_unpack_dmat(nrow, ncol, A, ai, aj, out, nrow);
-    }
-    else
-    {
-        double *ptr = out;
-        int *idxcol = sparsity_out + 2;
-        int *row = sparsity_out + ncol + 3;
-        // Copy nonzeros
-        for (jj = 0; jj < ncol; jj++)
+        switch (type_in[ii])
         {
-            for (idx = idxcol[jj]; idx != idxcol[jj + 1]; idx++)
-            {
-                ptr[0] = BLASFEO_DMATEL(A, ai + row[idx], aj + nrow);
-                ptr++;
-            }
+            case COLMAJ:
+            case BLASFEO_DMAT:
+            case BLASFEO_DVEC:
+            case COLMAJ_ARGS:
+            case BLASFEO_DMAT_ARGS:
+            case BLASFEO_DVEC_ARGS:
+                args[ii] = d_casadi_direct_ptr(sp + ii, type_in[ii], in[ii]);
+                if (args[ii] == NULL)
+                {
+                    args[ii] = args_mem[ii];
+                    d_cvt_arg_to_casadi(sp + ii, type_in[ii], in[ii], args[ii]);
+                }
+                break;
+
+            case IGNORE_ARGUMENT:
+                args[ii] = args_mem[ii];
+                break;
+
+            default:
+                printf("\ntype in %d\n", type_in[ii]);
+                printf("\nUnknown external function argument type for argument %i\n\n", ii);
+                exit(1);
         }
     }
 
@@ -582,39 +560,33 @@ static void d_cvt_dmat_args_to_casadi(struct blasfeo_dmat_args *in, double *out,
 
 
 
-// column vector: assume sparsity_in[1] = 1 !!! or empty vector;
-// TODO(all): detect if dense from number of elements per column !!!
-static void d_cvt_casadi_to_dvec_args(double *in, int *sparsity_in, struct blasfeo_dvec_args *out)
+// set the casadi output pointers, such that dense outputs are written in place
+static void casadi_wrapper_res(external_function_casadi_sparsity *sp, int num,
+                               ext_fun_arg_t *type_out, void **out, double **res, double **res_mem)
 {
-    int idx;
-
-    assert((sparsity_in[1] == 1) | (sparsity_in[0] == 0) | (sparsity_in[1] == 0));
-
-    int n = sparsity_in[0];
-    int dense = sparsity_in[2];
-
-    if (n<=0)
-        return;
-
-    struct blasfeo_dvec *x = out->x;
-    int xi = out->xi;
-
-    if (dense)
-    {
-        blasfeo_pack_dvec(n, in, x, xi);
-    }
-    else
+    for (int ii = 0; ii < num; ii++)
     {
-        double *ptr = in;
-        int *idxcol = sparsity_in + 2;
-        int *row = sparsity_in + 1 + 3;
-        // Fill with zeros
-        blasfeo_dvecse(n, 0.0, x, xi);
-        // Copy nonzeros
-        for (idx = idxcol[0]; idx != idxcol[1]; idx++)
+        switch (type_out[ii])
         {
-            BLASFEO_DVECEL(x, xi + row[idx]) = ptr[0];
-            ptr++;
+            case COLMAJ:
+            case BLASFEO_DMAT:
+            case BLASFEO_DVEC:
+            case COLMAJ_ARGS:
+            case BLASFEO_DMAT_ARGS:
+            case BLASFEO_DVEC_ARGS:
+                res[ii] = d_casadi_direct_ptr(sp + ii, type_out[ii], out[ii]);
+                if (res[ii] == NULL)
+                    res[ii] = res_mem[ii];
+                break;
+
+            case IGNORE_ARGUMENT:
+                res[ii] = res_mem[ii];
+                break;
+
+            default:
+                printf("\ntype out %d\n", type_out[ii]);
+                printf("\nUnknown external function argument type for output %i\n\n", ii);
+                exit(1);
         }
     }
 
@@ -623,38 +595,14 @@ static void d_cvt_casadi_to_dvec_args(double *in, int *sparsity_in, struct blasf
 
 
 
-// column vector: assume sparsity_in[1] = 1 !!! or empty vector;
-// TODO(all): detect if dense from number of elements per column !!!
-static void d_cvt_dvec_args_to_casadi(struct blasfeo_dvec_args *in, double *out, int *sparsity_out)
+// convert the outputs that were not written in place
+static void casadi_wrapper_out(external_function_casadi_sparsity *sp, int num,
+                               ext_fun_arg_t *type_out, void **out, double **res, double **res_mem)
 {
-    int idx;
-
-    assert((sparsity_out[1] == 1) | (sparsity_out[0] == 0) | (sparsity_out[1] == 0));
-
-    int n = sparsity_out[0];
-    int dense = sparsity_out[2];
-
-    if (n<=0)
-        return;
-
-    struct blasfeo_dvec *x = in->x;
-    int xi = in->xi;
-
-    if (dense)
+    for (int ii = 0; ii < num; ii++)
     {
-        blasfeo_unpack_dvec(n, x, xi, out);
-    }
-    else
-    {
-        double *ptr = out;
-        int *idxcol = sparsity_out + 2;
-        int *row = sparsity_out + 1 + 3;
-        // Copy nonzeros
-        for (idx = idxcol[0]; idx != idxcol[1]; idx++)
-        {
-            ptr[0] = BLASFEO_DVECEL(x, xi + row[idx]);
-            ptr++;
-        }
+        if (type_out[ii] != IGNORE_ARGUMENT && res[ii] == res_mem[ii])
+            d_cvt_casadi_to_arg(sp + ii, type_out[ii], res[ii], out[ii]);
     }
 
     return;
@@ -747,13 +695,21 @@ int external_function_casadi_calculate_size(external_function_casadi *fun)
     int size = 0;
 
     // double pointers
-    size += fun->args_num * sizeof(double *);  // args
-    size += fun->res_num * sizeof(double *);   // res
+    size += 2 * fun->args_num * sizeof(double *);  // args, args_mem
+    size += 2 * fun->res_num * sizeof(double *);   // res, res_mem
+
+    // sparsity
+    size += fun->in_num * sizeof(external_function_casadi_sparsity);   // sparsity_in
+    size += fun->out_num * sizeof(external_function_casadi_sparsity);  // sparsity_out
 
     // ints
     size += fun->args_num * sizeof(int);  // args_size
     size += fun->res_num * sizeof(int);   // res_size
     size += fun->iw_size * sizeof(int);   // iw
+    for (ii = 0; ii < fun->in_num; ii++)
+        size += casadi_sparsity_calculate_size(fun->casadi_sparsity_in(ii));
+    for (ii = 0; ii < fun->out_num; ii++)
+        size += casadi_sparsity_calculate_size(fun->casadi_sparsity_out(ii));
 
     // doubles
     size += fun->args_size_tot * sizeof(double);  // args
@@ -788,8 +744,16 @@ void external_function_casadi_assign(external_function_casadi *fun, void *raw_me
 
     // args
     assign_and_advance_double_ptrs(fun->args_num, &fun->args, &c_ptr);
+    assign_and_advance_double_ptrs(fun->args_num, &fun->args_mem, &c_ptr);
     // res
     assign_and_advance_double_ptrs(fun->res_num, &fun->res, &c_ptr);
+    assign_and_advance_double_ptrs(fun->res_num, &fun->res_mem, &c_ptr);
+
+    // sparsity
+    fun->sparsity_in = (external_function_casadi_sparsity *) c_ptr;
+    c_ptr += fun->in_num * sizeof(external_function_casadi_sparsity);
+    fun->sparsity_out = (external_function_casadi_sparsity *) c_ptr;
+    c_ptr += fun->out_num * sizeof(external_function_casadi_sparsity);
 
     // args_size
     assign_and_advance_int(fun->args_num, &fun->args_size, &c_ptr);
@@ -801,16 +765,27 @@ void external_function_casadi_assign(external_function_casadi *fun, void *raw_me
         fun->res_size[ii] = casadi_nnz(fun->casadi_sparsity_out(ii));
     // iw
     assign_and_advance_int(fun->iw_size, &fun->iw, &c_ptr);
+    // sparsity patterns
+    for (ii = 0; ii < fun->in_num; ii++)
+        casadi_sparsity_assign(fun->casadi_sparsity_in(ii), fun->sparsity_in + ii, &c_ptr);
+    for (ii = 0; ii < fun->out_num; ii++)
+        casadi_sparsity_assign(fun->casadi_sparsity_out(ii), fun->sparsity_out + ii, &c_ptr);
 
     // align to double
     align_char_to(8, &c_ptr);
 
     // args
     for (ii = 0; ii < fun->args_num; ii++)
-        assign_and_advance_double(fun->args_size[ii], &fun->args[ii], &c_ptr);
+    {
+        assign_and_advance_double(fun->args_size[ii], &fun->args_mem[ii], &c_ptr);
+        fun->args[ii] = fun->args_mem[ii];
+    }
     // res
     for (ii = 0; ii < fun->res_num; ii++)
-        assign_and_advance_double(fun->res_size[ii], &fun->res[ii], &c_ptr);
+    {
+        assign_and_advance_double(fun->res_size[ii], &fun->res_mem[ii], &c_ptr);
+        fun->res[ii] = fun->res_mem[ii];
+    }
     // w
     assign_and_advance_double(fun->w_size, &fun->w, &c_ptr);
 
@@ -827,102 +802,16 @@ void external_function_casadi_wrapper(void *self, ext_fun_arg_t *type_in, void *
     // cast into external casadi function
     external_function_casadi *fun = self;
 
-    // loop index
-    int ii;
-
     // in as args
-    for (ii = 0; ii < fun->in_num; ii++)
-    {
-        switch (type_in[ii])
-        {
-            case COLMAJ:
-                d_cvt_colmaj_to_casadi(in[ii], (double *) fun->args[ii],
-                                       (int *) fun->casadi_sparsity_in(ii));
-                break;
-
-            case BLASFEO_DMAT:
-                d_cvt_dmat_to_casadi(in[ii], (double *) fun->args[ii],
-                                     (int *) fun->casadi_sparsity_in(ii));
-                break;
-
-            case BLASFEO_DVEC:
-                d_cvt_dvec_to_casadi(in[ii], (double *) fun->args[ii],
-                                     (int *) fun->casadi_sparsity_in(ii));
-                break;
-
-            case COLMAJ_ARGS:
-                d_cvt_colmaj_args_to_casadi(in[ii], (double *) fun->args[ii],
-                                            (int *) fun->casadi_sparsity_in(ii));
-                break;
+    casadi_wrapper_in(fun->sparsity_in, fun->in_num, type_in, in, fun->args, fun->args_mem);
 
-            case BLASFEO_DMAT_ARGS:
-                d_cvt_dmat_args_to_casadi(in[ii], (double *) fun->args[ii],
-                                          (int *) fun->casadi_sparsity_in(ii));
-                break;
-
-            case BLASFEO_DVEC_ARGS:
-                d_cvt_dvec_args_to_casadi(in[ii], (double *) fun->args[ii],
-                                          (int *) fun->casadi_sparsity_in(ii));
-                break;
-
-            case IGNORE_ARGUMENT:
-                // do nothing
-                break;
-
-            default:
-                printf("\ntype in %d\n", type_in[ii]);
-                printf("\nUnknown external function argument type for argument %i\n\n", ii);
-                exit(1);
-        }
-    }
+    // out as res
+    casadi_wrapper_res(fun->sparsity_out, fun->out_num, type_out, out, fun->res, fun->res_mem);
 
     // call casadi function
     fun->casadi_fun((const double **) fun->args, fun->res, fun->iw, fun->w, NULL);
 
-    for (ii = 0; ii < fun->out_num; ii++)
-    {
-        switch (type_out[ii])
-        {
-            case COLMAJ:
-                d_cvt_casadi_to_colmaj((double *) fun->res[ii],
-                                       (int *) fun->casadi_sparsity_out(ii), out[ii]);
-                break;
-
-            case BLASFEO_DMAT:
-                d_cvt_casadi_to_dmat((double *) fun->res[ii], (int *) fun->casadi_sparsity_out(ii),
-                                     out[ii]);
-                break;
-
-            case BLASFEO_DVEC:
-                d_cvt_casadi_to_dvec((double *) fun->res[ii], (int *) fun->casadi_sparsity_out(ii),
-                                     out[ii]);
-                break;
-
-            case COLMAJ_ARGS:
-                d_cvt_casadi_to_colmaj_args((double *) fun->res[ii],
-                                            (int *) fun->casadi_sparsity_out(ii), out[ii]);
-                break;
-
-            case BLASFEO_DMAT_ARGS:
-                d_cvt_casadi_to_dmat_args((double *) fun->res[ii],
-                                          (int *) fun->casadi_sparsity_out(ii), out[ii]);
-                break;
-
-            case BLASFEO_DVEC_ARGS:
-                d_cvt_casadi_to_dvec_args((double *) fun->res[ii],
-                                          (int *) fun->casadi_sparsity_out(ii), out[ii]);
-                break;
-
-            case IGNORE_ARGUMENT:
-                // do nothing
-                break;
-
-            default:
-                printf("\ntype out %d\n", type_out[ii]);
-                printf("\nUnknown external function argument type for output %i\n\n", ii);
-                exit(1);
-        }
-    }
+    casadi_wrapper_out(fun->sparsity_out, fun->out_num, type_out, out, fun->res, fun->res_mem);
 
     return;
 }
@@ -1019,13 +908,21 @@ int external_function_param_casadi_calculate_size(external_function_param_casadi
     int size = 0;
 
     // double pointers
-    size += fun->args_num * sizeof(double *);  // args
-    size += fun->res_num * sizeof(double *);   // res
+    size += 2 * fun->args_num * sizeof(double *);  // args, args_mem
+    size += 2 * fun->res_num * sizeof(double *);   // res, res_mem
+
+    // sparsity
+    size += fun->in_num * sizeof(external_function_casadi_sparsity);   // sparsity_in
+    size += fun->out_num * sizeof(external_function_casadi_sparsity);  // sparsity_out
 
     // ints
     size += fun->args_num * sizeof(int);  // args_size
     size += fun->res_num * sizeof(int);   // res_size
     size += fun->iw_size * sizeof(int);   // iw
+    for (ii = 0; ii < fun->in_num; ii++)
+        size += casadi_sparsity_calculate_size(fun->casadi_sparsity_in(ii));
+    for (ii = 0; ii < fun->out_num; ii++)
+        size += casadi_sparsity_calculate_size(fun->casadi_sparsity_out(ii));
 
     // doubles
     size += fun->args_size_tot * sizeof(double);  // args
@@ -1061,8 +958,16 @@ void external_function_param_casadi_assign(external_function_param_casadi *fun,
 
     // args
     assign_and_advance_double_ptrs(fun->args_num, &fun->args, &c_ptr);
+    assign_and_advance_double_ptrs(fun->args_num, &fun->args_mem, &c_ptr);
     // res
     assign_and_advance_double_ptrs(fun->res_num, &fun->res, &c_ptr);
+    assign_and_advance_double_ptrs(fun->res_num, &fun->res_mem, &c_ptr);
+
+    // sparsity
+    fun->sparsity_in = (external_function_casadi_sparsity *) c_ptr;
+    c_ptr += fun->in_num * sizeof(external_function_casadi_sparsity);
+    fun->sparsity_out = (external_function_casadi_sparsity *) c_ptr;
+    c_ptr += fun->out_num * sizeof(external_function_casadi_sparsity);
 
     // args_size
     assign_and_advance_int(fun->args_num, &fun->args_size, &c_ptr);
@@ -1074,16 +979,27 @@ void external_function_param_casadi_assign(external_function_param_casadi *fun,
         fun->res_size[ii] = casadi_nnz(fun->casadi_sparsity_out(ii));
     // iw
     assign_and_advance_int(fun->iw_size, &fun->iw, &c_ptr);
+    // sparsity patterns
+    for (ii = 0; ii < fun->in_num; ii++)
+        casadi_sparsity_assign(fun->casadi_sparsity_in(ii), fun->sparsity_in + ii, &c_ptr);
+    for (ii = 0; ii < fun->out_num; ii++)
+        casadi_sparsity_assign(fun->casadi_sparsity_out(ii), fun->sparsity_out + ii, &c_ptr);
 
     // align to double
     align_char_to(8, &c_ptr);
 
     // args
     for (ii = 0; ii < fun->args_num; ii++)
-        assign_and_advance_double(fun->args_size[ii], &fun->args[ii], &c_ptr);
+    {
+        assign_and_advance_double(fun->args_size[ii], &fun->args_mem[ii], &c_ptr);
+        fun->args[ii] = fun->args_mem[ii];
+    }
     // res
     for (ii = 0; ii < fun->res_num; ii++)
-        assign_and_advance_double(fun->res_size[ii], &fun->res[ii], &c_ptr);
+    {
+        assign_and_advance_double(fun->res_size[ii], &fun->res_mem[ii], &c_ptr);
+        fun->res[ii] = fun->res_mem[ii];
+    }
     // w
     assign_and_advance_double(fun->w_size, &fun->w, &c_ptr);
     // p
@@ -1103,104 +1019,20 @@ void external_function_param_casadi_wrapper(void *self, ext_fun_arg_t *type_in,
     // cast into external casadi function
     external_function_param_casadi *fun = self;
 
-    // loop index
-    int ii, jj;
-
     // in as args
     // skip last argument (that is the parameters vector)
-    for (ii = 0; ii < fun->in_num - 1; ii++)
-    {
-        switch (type_in[ii])
-        {
-            case COLMAJ:
-                d_cvt_colmaj_to_casadi(in[ii], (double *) fun->args[ii],
-                                       (int *) fun->casadi_sparsity_in(ii));
-                break;
-
-            case BLASFEO_DMAT:
-                d_cvt_dmat_to_casadi(in[ii], (double *) fun->args[ii],
-                                     (int *) fun->casadi_sparsity_in(ii));
-                break;
-
-            case BLASFEO_DVEC:
-                d_cvt_dvec_to_casadi(in[ii], (double *) fun->args[ii],
-                                     (int *) fun->casadi_sparsity_in(ii));
-                break;
-            case COLMAJ_ARGS:
-                d_cvt_colmaj_args_to_casadi(in[ii], (double *) fun->args[ii],
-                                            (int *) fun->casadi_sparsity_in(ii));
-                break;
+    casadi_wrapper_in(fun->sparsity_in, fun->in_num - 1, type_in, in, fun->args, fun->args_mem);
 
-            case BLASFEO_DMAT_ARGS:
-                d_cvt_dmat_args_to_casadi(in[ii], (double *) fun->args[ii],
-                                          (int *) fun->casadi_sparsity_in(ii));
-                break;
-
-            case BLASFEO_DVEC_ARGS:
-                d_cvt_dvec_args_to_casadi(in[ii], (double *) fun->args[ii],
-                                          (int *) fun->casadi_sparsity_in(ii));
-                break;
+    // parameters vector as last arg, passed in place
+    fun->args[fun->in_num - 1] = fun->p;
 
-            case IGNORE_ARGUMENT:
-                // do nothing
-                break;
-
-            default:
-                printf("\ntype in %d\n", type_in[ii]);
-                printf("\nUnknown external function argument type for argument %i\n\n", ii);
-                exit(1);
-        }
-    }
-    // copy parametrs vector as last arg
-    ii = fun->in_num - 1;
-    for (jj = 0; jj < fun->np; jj++) fun->args[ii][jj] = fun->p[jj];
+    // out as res
+    casadi_wrapper_res(fun->sparsity_out, fun->out_num, type_out, out, fun->res, fun->res_mem);
 
     // call casadi function
     fun->casadi_fun((const double **) fun->args, fun->res, fun->iw, fun->w, NULL);
 
-    for (ii = 0; ii < fun->out_num; ii++)
-    {
-        switch (type_out[ii])
-        {
-            case COLMAJ:
-                d_cvt_casadi_to_colmaj((double *) fun->res[ii],
-                                       (int *) fun->casadi_sparsity_out(ii), out[ii]);
-                break;
-
-            case BLASFEO_DMAT:
-                d_cvt_casadi_to_dmat((double *) fun->res[ii], (int *) fun->casadi_sparsity_out(ii),
-                                     out[ii]);
-                break;
-
-            case BLASFEO_DVEC:
-                d_cvt_casadi_to_dvec((double *) fun->res[ii], (int *) fun->casadi_sparsity_out(ii),
-                                     out[ii]);
-                break;
-            case COLMAJ_ARGS:
-                d_cvt_casadi_to_colmaj_args((double *) fun->res[ii],
-                                            (int *) fun->casadi_sparsity_out(ii), out[ii]);
-                break;
-
-            case BLASFEO_DMAT_ARGS:
-                d_cvt_casadi_to_dmat_args((double *) fun->res[ii],
-                                          (int *) fun->casadi_sparsity_out(ii), out[ii]);
-                break;
-
-            case BLASFEO_DVEC_ARGS:
-                d_cvt_casadi_to_dvec_args((double *) fun->res[ii],
-                                          (int *) fun->casadi_sparsity_out(ii), out[ii]);
-                break;
-
-            case IGNORE_ARGUMENT:
-                // do nothing
-                break;
-
-            default:
-                printf("\ntype in %d\n", type_out[ii]);
-                printf("\nUnknown external function argument type for output %i\n\n", ii);
-                exit(1);
-        }
-    }
+    casadi_wrapper_out(fun->sparsity_out, fun->out_num, type_out, out, fun->res, fun->res_mem);
 
     return;
 }
@@ -122,6 +122,17 @@ void external_function_param_generic_get_nparam(void *self, int *np);
 void external_function_param_generic_set_param(void *self, double *p);
 
 
+// sparsity pattern of a casadi argument, unpacked once at assign time
+typedef struct
+{
+    int nrow;
+    int ncol;
+    int nnz;
+    int dense;  // all entries stored in column-major order
+    int *row;   // row index of each nonzero, NULL if dense
+    int *col;   // column index of each nonzero, NULL if dense
+} external_function_casadi_sparsity;
+
 /************************************************
  * casadi external function
  ************************************************/
@@ -140,6 +151,10 @@ typedef struct
     int (*casadi_n_out)();
     double **args;
     double **res;
+    double **args_mem;  // internal buffer of args[i], if the input can not be passed in place
+    double **res_mem;   // internal buffer of res[i], if the output can not be written in place
+    external_function_casadi_sparsity *sparsity_in;
+    external_function_casadi_sparsity *sparsity_out;
     double *w;
     int *iw;
     int *args_size;     // size of args[i]
@@ -197,6 +212,10 @@ typedef struct
     int (*casadi_n_out)();
     double **args;
     double **res;
+    double **args_mem;  // internal buffer of args[i], if the input can not be passed in place
+    double **res_mem;   // internal buffer of res[i], if the output can not be written in place
+    external_function_casadi_sparsity *sparsity_in;
+    external_function_casadi_sparsity *sparsity_out;
     double *w;
     double *p;  // parameters
     int *iw;
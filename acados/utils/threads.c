@@ -0,0 +1,680 @@
+/*
+ * Copyright 2019 Gianluca Frison, Dimitris Kouzoupis, Robin Verschueren,
+ * Andrea Zanelli, Niels van Duijkeren, Jonathan Frey, Tommaso Sartor,
+ * Branimir Novoselnik, Rien Quirynen, Rezart Qelibari, Dang Doan,
+ * Jonas Koenemann, Yutao Chen, Tobias Schöls, Jonas Schlagenhauf, Moritz Diehl
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  // pthread_setaffinity_np
+#endif
+
+#include "acados/utils/threads.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(ACADOS_WITH_PTHREADS) && defined(__linux__)
+#include <sched.h>
+#endif
+#if defined(ACADOS_WITH_OPENMP)
+#include <omp.h>
+#endif
+
+#include "acados/utils/timing.h"
+
+
+
+#if defined(ACADOS_WITH_PTHREADS)
+
+static void *acados_worker_loop(void *worker_)
+{
+    acados_worker *worker = worker_;
+
+    pthread_mutex_lock(&worker->mutex);
+    while (1)
+    {
+        while (!worker->pending && !worker->shutdown)
+            pthread_cond_wait(&worker->cond_task, &worker->mutex);
+
+        if (worker->pending)
+        {
+            pthread_mutex_unlock(&worker->mutex);
+            worker->task(worker->arg);
+            pthread_mutex_lock(&worker->mutex);
+
+            worker->pending = 0;
+            pthread_cond_broadcast(&worker->cond_done);
+        }
+        else  // shutdown
+        {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&worker->mutex);
+
+    return NULL;
+}
+
+#endif
+
+
+
+void acados_worker_init(acados_worker *worker)
+{
+    worker->task = NULL;
+    worker->arg = NULL;
+    worker->pending = 0;
+    worker->started = 0;
+    worker->shutdown = 0;
+}
+
+
+
+void acados_worker_submit(acados_worker *worker, acados_task_fun task, void *arg)
+{
+#if defined(ACADOS_WITH_PTHREADS)
+    if (!worker->started)
+    {
+        pthread_mutex_init(&worker->mutex, NULL);
+        pthread_cond_init(&worker->cond_task, NULL);
+        pthread_cond_init(&worker->cond_done, NULL);
+        worker->shutdown = 0;
+        if (pthread_create(&worker->thread, NULL, &acados_worker_loop, worker))
+        {
+            printf("\nerror: acados_worker_submit: failed to create thread\n");
+            exit(1);
+        }
+        worker->started = 1;
+    }
+
+    pthread_mutex_lock(&worker->mutex);
+    while (worker->pending)
+        pthread_cond_wait(&worker->cond_done, &worker->mutex);
+    worker->task = task;
+    worker->arg = arg;
+    worker->pending = 1;
+    pthread_cond_signal(&worker->cond_task);
+    pthread_mutex_unlock(&worker->mutex);
+#else
+    task(arg);
+#endif
+}
+
+
+
+void acados_worker_wait(acados_worker *worker)
+{
+#if defined(ACADOS_WITH_PTHREADS)
+    if (!worker->started)
+        return;
+
+    pthread_mutex_lock(&worker->mutex);
+    while (worker->pending)
+        pthread_cond_wait(&worker->cond_done, &worker->mutex);
+    pthread_mutex_unlock(&worker->mutex);
+#endif
+}
+
+
+
+int acados_worker_busy(acados_worker *worker)
+{
+    int busy = 0;
+#if defined(ACADOS_WITH_PTHREADS)
+    if (!worker->started)
+        return 0;
+
+    pthread_mutex_lock(&worker->mutex);
+    busy = worker->pending;
+    pthread_mutex_unlock(&worker->mutex);
+#endif
+    return busy;
+}
+
+
+
+void acados_worker_stop(acados_worker *worker)
+{
+#if defined(ACADOS_WITH_PTHREADS)
+    if (!worker->started)
+        return;
+
+    pthread_mutex_lock(&worker->mutex);
+    worker->shutdown = 1;
+    pthread_cond_signal(&worker->cond_task);
+    pthread_mutex_unlock(&worker->mutex);
+
+    // the pending task is finished before the loop exits
+    pthread_join(worker->thread, NULL);
+
+    pthread_cond_destroy(&worker->cond_done);
+    pthread_cond_destroy(&worker->cond_task);
+    pthread_mutex_destroy(&worker->mutex);
+    worker->started = 0;
+#endif
+}
+
+
+
+/************************************************
+ * thread pool
+ ************************************************/
+
+int acados_thread_pool_calculate_size(int num_threads, int max_n)
+{
+    int size = sizeof(acados_thread_pool);
+
+    size += num_threads * sizeof(double);  // busy_time
+#if defined(ACADOS_WITH_PTHREADS)
+    size += num_threads * sizeof(pthread_t);
+#endif
+    size += num_threads * sizeof(acados_pool_worker);
+    size += num_threads * sizeof(int);  // affinity
+    size += (num_threads + 1) * sizeof(int);  // list_start
+    size += 3 * max_n * sizeof(int);  // order list owner
+
+    size += 8;  // align
+
+    return size;
+}
+
+
+
+acados_thread_pool *acados_thread_pool_assign(int num_threads, int max_n, void *raw_memory)
+{
+    char *c_ptr = (char *) raw_memory;
+
+    acados_thread_pool *pool = (acados_thread_pool *) c_ptr;
+    c_ptr += sizeof(acados_thread_pool);
+
+    // align
+    c_ptr = (char *) ((((uintptr_t) c_ptr) + 7) / 8 * 8);
+
+    pool->busy_time = (double *) c_ptr;
+    c_ptr += num_threads * sizeof(double);
+
+#if defined(ACADOS_WITH_PTHREADS)
+    pool->threads = (pthread_t *) c_ptr;
+    c_ptr += num_threads * sizeof(pthread_t);
+#endif
+
+    pool->workers = (acados_pool_worker *) c_ptr;
+    c_ptr += num_threads * sizeof(acados_pool_worker);
+
+    pool->affinity = (int *) c_ptr;
+    c_ptr += num_threads * sizeof(int);
+
+    pool->list_start = (int *) c_ptr;
+    c_ptr += (num_threads + 1) * sizeof(int);
+
+    pool->order = (int *) c_ptr;
+    c_ptr += max_n * sizeof(int);
+
+    pool->list = (int *) c_ptr;
+    c_ptr += max_n * sizeof(int);
+
+    pool->owner = (int *) c_ptr;
+    c_ptr += max_n * sizeof(int);
+
+    pool->num_threads = num_threads;
+    pool->max_n = max_n;
+    pool->spin_iter = 0;
+    pool->schedule = ACADOS_SCHEDULE_STATIC;
+    for (int ii = 0; ii < num_threads; ii++)
+    {
+        pool->workers[ii].pool = pool;
+        pool->workers[ii].id = ii;
+        pool->affinity[ii] = -1;
+    }
+    for (int ii = 0; ii < max_n; ii++)
+        pool->order[ii] = ii;
+    pool->order_n = max_n;
+
+    pool->fun = NULL;
+    pool->arg = NULL;
+    pool->n = 0;
+    pool->loop_schedule = ACADOS_SCHEDULE_STATIC;
+    pool->stage_time = NULL;
+    pool->next = 0;
+    pool->generation = 0;
+    pool->num_done = 0;
+    pool->num_sleeping = 0;
+    pool->started = 0;
+    pool->shutdown = 0;
+
+    acados_thread_pool_reset_stats(pool);
+
+    return pool;
+}
+
+
+
+void acados_thread_pool_configure(acados_thread_pool *pool, acados_schedule_t schedule,
+                                  int spin_iter, int *affinity)
+{
+    pool->schedule = schedule;
+    pool->spin_iter = spin_iter;
+    if (affinity != NULL)
+    {
+        for (int ii = 0; ii < pool->num_threads; ii++)
+            pool->affinity[ii] = affinity[ii];
+    }
+}
+
+
+
+void acados_thread_pool_get_utilization(acados_thread_pool *pool, double *utilization)
+{
+    for (int ii = 0; ii < pool->num_threads; ii++)
+        utilization[ii] = pool->wall_time > 0.0 ? pool->busy_time[ii] / pool->wall_time : 0.0;
+}
+
+
+
+void acados_thread_pool_reset_stats(acados_thread_pool *pool)
+{
+    for (int ii = 0; ii < pool->num_threads; ii++)
+        pool->busy_time[ii] = 0.0;
+    pool->wall_time = 0.0;
+}
+
+
+
+static void acados_thread_pool_run_stage(acados_thread_pool *pool, int ii)
+{
+    if (pool->stage_time == NULL)
+    {
+        pool->fun(pool->arg, ii);
+        return;
+    }
+
+    acados_timer timer;
+    acados_tic(&timer);
+    pool->fun(pool->arg, ii);
+    double time = acados_toc(&timer);
+
+    // smoothed with the time of the previous loops
+    double *stage_time = pool->stage_time + ii;
+    *stage_time = *stage_time > 0.0 ? 0.5 * (*stage_time + time) : time;
+}
+
+
+
+// stages of the current loop executed by worker id
+static void acados_thread_pool_run(acados_thread_pool *pool, int id)
+{
+    int n = pool->n;
+    int nt = pool->num_threads;
+    int ii, kk;
+
+    acados_timer timer;
+    acados_tic(&timer);
+
+    if (pool->loop_schedule == ACADOS_SCHEDULE_LPT)
+    {
+        for (kk = pool->list_start[id]; kk < pool->list_start[id + 1]; kk++)
+            acados_thread_pool_run_stage(pool, pool->list[kk]);
+    }
+    else if (pool->loop_schedule == ACADOS_SCHEDULE_DYNAMIC)
+    {
+#if defined(ACADOS_WITH_PTHREADS)
+        while ((kk = __atomic_fetch_add(&pool->next, 1, __ATOMIC_RELAXED)) < n)
+            acados_thread_pool_run_stage(pool, pool->order[kk]);
+#else
+        for (kk = 0; kk < n; kk++)
+            acados_thread_pool_run_stage(pool, pool->order[kk]);
+#endif
+    }
+    else  // static
+    {
+        int i_start = (id * n) / nt;
+        int i_end = ((id + 1) * n) / nt;
+        for (ii = i_start; ii < i_end; ii++)
+            acados_thread_pool_run_stage(pool, ii);
+    }
+
+    pool->busy_time[id] += acados_toc(&timer);
+}
+
+
+
+// sorts the stages by decreasing stage time and distributes them over the workers
+static void acados_thread_pool_schedule(acados_thread_pool *pool, int n, double *stage_time)
+{
+    int nt = pool->num_threads;
+    int *order = pool->order;
+    int ii, jj, kk, tmp;
+
+    // stages without recorded time (e.g. in the first loop) are weighted equally
+    double stage_time_min = 0.0;
+    for (ii = 0; ii < n; ii++)
+    {
+        if (stage_time[ii] > 0.0 && (stage_time_min == 0.0 || stage_time[ii] < stage_time_min))
+            stage_time_min = stage_time[ii];
+    }
+    if (stage_time_min == 0.0)
+        stage_time_min = 1.0;
+
+    // insertion sort, starting from the order of the previous loop (nearly sorted)
+    if (n != pool->order_n)
+    {
+        for (ii = 0; ii < n; ii++)
+            order[ii] = ii;
+        pool->order_n = n;
+    }
+    for (ii = 1; ii < n; ii++)
+    {
+        tmp = order[ii];
+        double t_tmp = stage_time[tmp] > 0.0 ? stage_time[tmp] : stage_time_min;
+        for (jj = ii; jj > 0; jj--)
+        {
+            double t_prev = stage_time[order[jj-1]] > 0.0 ? stage_time[order[jj-1]] : stage_time_min;
+            if (t_prev >= t_tmp)
+                break;
+            order[jj] = order[jj-1];
+        }
+        order[jj] = tmp;
+    }
+
+    if (pool->loop_schedule != ACADOS_SCHEDULE_LPT)
+        return;
+
+    // longest processing time first: next stage to the least loaded worker
+    double load[ACADOS_MAX_THREADS];
+    for (kk = 0; kk < nt; kk++)
+        load[kk] = 0.0;
+    for (ii = 0; ii < n; ii++)
+    {
+        int stage = order[ii];
+        int kk_min = 0;
+        for (kk = 1; kk < nt; kk++)
+        {
+            if (load[kk] < load[kk_min])
+                kk_min = kk;
+        }
+        load[kk_min] += stage_time[stage] > 0.0 ? stage_time[stage] : stage_time_min;
+        pool->owner[stage] = kk_min;
+    }
+
+    // stages of each worker, in order of decreasing stage time
+    int *list_start = pool->list_start;
+    for (kk = 0; kk <= nt; kk++)
+        list_start[kk] = 0;
+    for (ii = 0; ii < n; ii++)
+        list_start[pool->owner[ii] + 1]++;
+    for (kk = 0; kk < nt; kk++)
+        list_start[kk + 1] += list_start[kk];
+
+    int pos[ACADOS_MAX_THREADS];
+    for (kk = 0; kk < nt; kk++)
+        pos[kk] = list_start[kk];
+    for (ii = 0; ii < n; ii++)
+    {
+        int stage = order[ii];
+        pool->list[pos[pool->owner[stage]]++] = stage;
+    }
+}
+
+
+
+#if defined(ACADOS_WITH_PTHREADS)
+
+static void acados_thread_pool_pin(pthread_t thread, int cpu)
+{
+#if defined(__linux__)
+    if (cpu < 0)
+        return;
+
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    if (pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuset))
+        printf("\nwarning: acados_thread_pool: failed to pin thread to core %d\n", cpu);
+#endif
+}
+
+
+
+static void *acados_thread_pool_loop(void *worker_)
+{
+    acados_pool_worker *worker = worker_;
+    acados_thread_pool *pool = worker->pool;
+
+    unsigned seen = 0;
+
+    while (1)
+    {
+        // spin
+        for (int kk = 0; kk < pool->spin_iter; kk++)
+        {
+            if (__atomic_load_n(&pool->generation, __ATOMIC_ACQUIRE) != seen ||
+                __atomic_load_n(&pool->shutdown, __ATOMIC_ACQUIRE))
+                break;
+        }
+
+        // sleep
+        if (__atomic_load_n(&pool->generation, __ATOMIC_ACQUIRE) == seen)
+        {
+            pthread_mutex_lock(&pool->mutex);
+            __atomic_add_fetch(&pool->num_sleeping, 1, __ATOMIC_SEQ_CST);
+            while (__atomic_load_n(&pool->generation, __ATOMIC_SEQ_CST) == seen &&
+                   !pool->shutdown)
+                pthread_cond_wait(&pool->cond_task, &pool->mutex);
+            __atomic_sub_fetch(&pool->num_sleeping, 1, __ATOMIC_SEQ_CST);
+            pthread_mutex_unlock(&pool->mutex);
+        }
+
+        if (__atomic_load_n(&pool->shutdown, __ATOMIC_ACQUIRE))
+            break;
+
+        seen = __atomic_load_n(&pool->generation, __ATOMIC_ACQUIRE);
+
+        acados_thread_pool_run(pool, worker->id);
+
+        // the last worker wakes up the calling thread
+        if (__atomic_add_fetch(&pool->num_done, 1, __ATOMIC_ACQ_REL) == pool->num_threads - 1)
+        {
+            pthread_mutex_lock(&pool->mutex);
+            pthread_cond_signal(&pool->cond_done);
+            pthread_mutex_unlock(&pool->mutex);
+        }
+    }
+
+    return NULL;
+}
+
+
+
+static void acados_thread_pool_start(acados_thread_pool *pool)
+{
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->cond_task, NULL);
+    pthread_cond_init(&pool->cond_done, NULL);
+    pool->shutdown = 0;
+
+    // the calling thread (worker 0) belongs to the user and is not pinned
+    for (int ii = 1; ii < pool->num_threads; ii++)
+    {
+        if (pthread_create(pool->threads+ii, NULL, &acados_thread_pool_loop, pool->workers+ii))
+        {
+            printf("\nerror: acados_thread_pool_start: failed to create thread\n");
+            exit(1);
+        }
+        acados_thread_pool_pin(pool->threads[ii], pool->affinity[ii]);
+    }
+
+    pool->started = 1;
+}
+
+#endif
+
+
+
+static void acados_thread_pool_execute(acados_thread_pool *pool, int n, acados_stage_fun fun,
+                                       void *arg, acados_schedule_t schedule, double *stage_time)
+{
+    if (n > pool->max_n)
+        schedule = ACADOS_SCHEDULE_STATIC;
+
+    acados_timer timer;
+    acados_tic(&timer);
+
+    pool->fun = fun;
+    pool->arg = arg;
+    pool->n = n;
+    pool->loop_schedule = schedule;
+    pool->stage_time = stage_time;
+
+#if defined(ACADOS_WITH_PTHREADS)
+    if (pool->num_threads > 1 && n > 1)
+    {
+        if (!pool->started)
+            acados_thread_pool_start(pool);
+
+        if (schedule != ACADOS_SCHEDULE_STATIC)
+            acados_thread_pool_schedule(pool, n, stage_time);
+        pool->next = 0;
+        __atomic_store_n(&pool->num_done, 0, __ATOMIC_RELAXED);
+
+        // publish the loop, sleeping workers have to be woken up
+        __atomic_add_fetch(&pool->generation, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&pool->num_sleeping, __ATOMIC_SEQ_CST) > 0)
+        {
+            pthread_mutex_lock(&pool->mutex);
+            pthread_cond_broadcast(&pool->cond_task);
+            pthread_mutex_unlock(&pool->mutex);
+        }
+
+        acados_thread_pool_run(pool, 0);
+
+        // wait for the workers
+        int num_workers = pool->num_threads - 1;
+        for (int kk = 0; kk < pool->spin_iter; kk++)
+        {
+            if (__atomic_load_n(&pool->num_done, __ATOMIC_ACQUIRE) == num_workers)
+                break;
+        }
+        if (__atomic_load_n(&pool->num_done, __ATOMIC_ACQUIRE) < num_workers)
+        {
+            pthread_mutex_lock(&pool->mutex);
+            while (__atomic_load_n(&pool->num_done, __ATOMIC_ACQUIRE) < num_workers)
+                pthread_cond_wait(&pool->cond_done, &pool->mutex);
+            pthread_mutex_unlock(&pool->mutex);
+        }
+
+        pool->wall_time += acados_toc(&timer);
+
+        return;
+    }
+#endif
+
+#if defined(ACADOS_WITH_OPENMP)
+    if (pool->num_threads > 1 && n > 1)
+    {
+        // OpenMP thread ii is accounted as worker ii
+        if (schedule == ACADOS_SCHEDULE_STATIC)
+        {
+            #pragma omp parallel for schedule(static) num_threads(pool->num_threads)
+            for (int ii = 0; ii < n; ii++)
+            {
+                acados_timer stage_timer;
+                acados_tic(&stage_timer);
+                acados_thread_pool_run_stage(pool, ii);
+                pool->busy_time[omp_get_thread_num()] += acados_toc(&stage_timer);
+            }
+        }
+        else
+        {
+            acados_thread_pool_schedule(pool, n, stage_time);
+            #pragma omp parallel for schedule(dynamic) num_threads(pool->num_threads)
+            for (int kk = 0; kk < n; kk++)
+            {
+                acados_timer stage_timer;
+                acados_tic(&stage_timer);
+                acados_thread_pool_run_stage(pool, pool->order[kk]);
+                pool->busy_time[omp_get_thread_num()] += acados_toc(&stage_timer);
+            }
+        }
+
+        pool->wall_time += acados_toc(&timer);
+
+        return;
+    }
+#endif
+
+    // serial
+    for (int ii = 0; ii < n; ii++)
+        acados_thread_pool_run_stage(pool, ii);
+
+    double time = acados_toc(&timer);
+    pool->busy_time[0] += time;
+    pool->wall_time += time;
+}
+
+
+
+void acados_thread_pool_parallel_for(acados_thread_pool *pool, int n, acados_stage_fun fun,
+                                     void *arg)
+{
+    acados_thread_pool_execute(pool, n, fun, arg, ACADOS_SCHEDULE_STATIC, NULL);
+}
+
+
+
+void acados_thread_pool_parallel_for_balanced(acados_thread_pool *pool, int n,
+                                              acados_stage_fun fun, void *arg, double *stage_time)
+{
+    acados_thread_pool_execute(pool, n, fun, arg, pool->schedule, stage_time);
+}
+
+
+
+void acados_thread_pool_stop(acados_thread_pool *pool)
+{
+#if defined(ACADOS_WITH_PTHREADS)
+    if (!pool->started)
+        return;
+
+    pthread_mutex_lock(&pool->mutex);
+    __atomic_store_n(&pool->shutdown, 1, __ATOMIC_SEQ_CST);
+    pthread_cond_broadcast(&pool->cond_task);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (int ii = 1; ii < pool->num_threads; ii++)
+        pthread_join(pool->threads[ii], NULL);
+
+    pthread_cond_destroy(&pool->cond_done);
+    pthread_cond_destroy(&pool->cond_task);
+    pthread_mutex_destroy(&pool->mutex);
+    pool->started = 0;
+#endif
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2019 Gianluca Frison, Dimitris Kouzoupis, Robin Verschueren,
+ * Andrea Zanelli, Niels van Duijkeren, Jonathan Frey, Tommaso Sartor,
+ * Branimir Novoselnik, Rien Quirynen, Rezart Qelibari, Dang Doan,
+ * Jonas Koenemann, Yutao Chen, Tobias Schöls, Jonas Schlagenhauf, Moritz Diehl
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#ifndef ACADOS_UTILS_THREADS_H_
+#define ACADOS_UTILS_THREADS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(ACADOS_WITH_PTHREADS)
+#include <pthread.h>
+#endif
+
+
+
+typedef void (*acados_task_fun)(void *arg);
+
+/** A persistent worker thread executing one task at a time.
+ *  Without ACADOS_WITH_PTHREADS, tasks are executed by the calling thread on submit. */
+typedef struct acados_worker_
+{
+#if defined(ACADOS_WITH_PTHREADS)
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond_task;  // signaled on submit and stop
+    pthread_cond_t cond_done;  // signaled when the task is done
+#endif
+    acados_task_fun task;
+    void *arg;
+    int pending;  // a task is submitted and not finished yet
+    int started;
+    int shutdown;
+} acados_worker;
+
+/* Initializes the worker struct, the thread is started on the first submit. */
+void acados_worker_init(acados_worker *worker);
+
+/* Executes task(arg) on the worker thread, waits for a previously submitted task first. */
+void acados_worker_submit(acados_worker *worker, acados_task_fun task, void *arg);
+
+/* Waits until the submitted task (if any) is finished. */
+void acados_worker_wait(acados_worker *worker);
+
+/* Returns 1 if a submitted task is not finished yet, 0 otherwise. */
+int acados_worker_busy(acados_worker *worker);
+
+/* Waits for the submitted task and joins the worker thread. */
+void acados_worker_stop(acados_worker *worker);
+
+
+
+// maximum number of threads of a thread pool (including the calling thread)
+#define ACADOS_MAX_THREADS 64
+
+typedef void (*acados_stage_fun)(void *arg, int stage);
+
+// distribution of the stages of balanced loops over the threads
+typedef enum
+{
+    ACADOS_SCHEDULE_STATIC,   // contiguous blocks of stages
+    ACADOS_SCHEDULE_LPT,      // longest processing time first, using the recorded stage times
+    ACADOS_SCHEDULE_DYNAMIC,  // threads take the next stage in order of decreasing stage time
+} acados_schedule_t;
+
+struct acados_thread_pool_;
+
+typedef struct
+{
+    struct acados_thread_pool_ *pool;
+    int id;
+} acados_pool_worker;
+
+/** A pool of persistent worker threads executing loops over stages.
+ *  The calling thread acts as worker 0, the pool has num_threads-1 additional threads.
+ *  Idle workers spin for spin_iter iterations before they sleep on a condition variable.
+ *  Without ACADOS_WITH_PTHREADS, loops are executed with OpenMP (ACADOS_WITH_OPENMP) or serially. */
+typedef struct acados_thread_pool_
+{
+#if defined(ACADOS_WITH_PTHREADS)
+    pthread_t *threads;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond_task;  // signaled on new loop and stop
+    pthread_cond_t cond_done;  // signaled when all workers finished the loop
+#endif
+    acados_pool_worker *workers;
+    int *affinity;  // core of each worker, -1: not pinned (ignored for the calling thread)
+    int num_threads;
+    int max_n;  // maximum loop length
+    int spin_iter;
+    acados_schedule_t schedule;
+
+    // current loop
+    acados_stage_fun fun;
+    void *arg;
+    int n;
+    acados_schedule_t loop_schedule;
+    double *stage_time;  // recorded stage times, NULL if not recorded
+    int *order;  // stages by decreasing stage time
+    int order_n;  // loop length of order
+    int *list;  // stages of each worker (LPT)
+    int *list_start;  // start of the stages of each worker in list (LPT)
+    int *owner;  // worker of each stage (LPT)
+    int next;  // next stage in order (dynamic)
+
+    // statistics
+    double *busy_time;  // time spent in loops by each worker
+    double wall_time;  // wall time of the loops
+
+    unsigned generation;  // incremented for every loop
+    int num_done;  // workers done with the current loop
+    int num_sleeping;  // workers waiting on cond_task
+    int started;
+    int shutdown;
+} acados_thread_pool;
+
+//
+int acados_thread_pool_calculate_size(int num_threads, int max_n);
+//
+acados_thread_pool *acados_thread_pool_assign(int num_threads, int max_n, void *raw_memory);
+/* Sets the schedule of balanced loops, the spin iterations and (if not NULL) the cores of the
+ * num_threads workers, -1: not pinned. The affinity is applied when the threads are started,
+ * affinity[0] is ignored as the affinity of the calling thread is left unchanged. */
+void acados_thread_pool_configure(acados_thread_pool *pool, acados_schedule_t schedule,
+                                  int spin_iter, int *affinity);
+/* Executes fun(arg, i) for i = 0, ..., n-1 on contiguous blocks of stages, the threads are
+ * started on the first call. */
+void acados_thread_pool_parallel_for(acados_thread_pool *pool, int n, acados_stage_fun fun,
+                                     void *arg);
+/* As acados_thread_pool_parallel_for, with the stages distributed according to the schedule of
+ * the pool and the stage times in stage_time, which are updated with the measured times. */
+void acados_thread_pool_parallel_for_balanced(acados_thread_pool *pool, int n,
+                                              acados_stage_fun fun, void *arg, double *stage_time);
+/* Writes the fraction of the loop wall time each of the num_threads workers was busy. */
+void acados_thread_pool_get_utilization(acados_thread_pool *pool, double *utilization);
+/* Resets the busy and wall times. */
+void acados_thread_pool_reset_stats(acados_thread_pool *pool);
+/* Joins the worker threads. */
+void acados_thread_pool_stop(acados_thread_pool *pool);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  // ACADOS_UTILS_THREADS_H_
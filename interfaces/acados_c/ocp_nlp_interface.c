@@ -270,6 +270,12 @@ ocp_nlp_config *ocp_nlp_config_create(ocp_nlp_plan plan)
                     case LIFTED_IRK:
                         sim_lifted_irk_config_initialize_default(config->dynamics[i]->sim_solver);
                         break;
+                    case ROSENBROCK:
+                        sim_rosenbrock_config_initialize_default(config->dynamics[i]->sim_solver);
+                        break;
+                    case EXP_EULER:
+                        sim_exp_euler_config_initialize_default(config->dynamics[i]->sim_solver);
+                        break;
                     default:
                         printf("\nerror: ocp_nlp_config_create: unsupported plan->sim_solver\n");
                         exit(1);
@@ -362,8 +368,24 @@ ocp_nlp_in *ocp_nlp_in_create(ocp_nlp_config *config, ocp_nlp_dims *dims)
 
 
 
-void ocp_nlp_in_destroy(void *in)
+// waits for an asynchronous preparation phase reading the struct, see ocp_nlp_sqp_rti
+static void ocp_nlp_wait_for_worker(acados_worker **worker)
+{
+    if (*worker != NULL)
+    {
+        acados_worker_wait(*worker);
+        *worker = NULL;
+    }
+}
+
+
+
+void ocp_nlp_in_destroy(void *in_)
 {
+    ocp_nlp_in *in = in_;
+
+    ocp_nlp_wait_for_worker(&in->worker);
+
     free(in);
 }
 
@@ -372,6 +394,8 @@ void ocp_nlp_in_destroy(void *in)
 void ocp_nlp_in_set(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in, int stage,
         const char *field, void *value)
 {
+    ocp_nlp_wait_for_worker(&in->worker);
+
     if (!strcmp(field, "Ts"))
     {
         double *Ts_value = value;
@@ -392,6 +416,8 @@ int ocp_nlp_dynamics_model_set(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_n
 {
     ocp_nlp_dynamics_config *dynamics_config = config->dynamics[stage];
 
+    ocp_nlp_wait_for_worker(&in->worker);
+
     dynamics_config->model_set(dynamics_config, dims->dynamics[stage], in->dynamics[stage], field, value);
 
     return ACADOS_SUCCESS;
@@ -404,6 +430,8 @@ int ocp_nlp_cost_model_set(ocp_nlp_config *config, ocp_nlp_dims *dims,
 {
     ocp_nlp_cost_config *cost_config = config->cost[stage];
 
+    ocp_nlp_wait_for_worker(&in->worker);
+
     return cost_config->model_set(cost_config, dims->cost[stage], in->cost[stage], field, value);
 
 }
@@ -415,12 +443,69 @@ int ocp_nlp_constraints_model_set(ocp_nlp_config *config, ocp_nlp_dims *dims,
 {
     ocp_nlp_constraints_config *constr_config = config->constraints[stage];
 
+    ocp_nlp_wait_for_worker(&in->worker);
+
     return constr_config->model_set(constr_config, dims->constraints[stage],
             in->constraints[stage], field, value);
 }
 
 
 
+int ocp_nlp_cost_model_set_all_stages(ocp_nlp_config *config, ocp_nlp_dims *dims,
+        ocp_nlp_in *in, const char *field, double *value)
+{
+    struct blasfeo_dvec *vec;
+    int offset, size;
+    int idx = 0;
+
+    ocp_nlp_wait_for_worker(&in->worker);
+
+    for (int stage = 0; stage <= dims->N; stage++)
+    {
+        ocp_nlp_cost_config *cost_config = config->cost[stage];
+        if (cost_config->model_get_dvec_ptr(cost_config, dims->cost[stage], in->cost[stage],
+                field, &vec, &offset, &size) != ACADOS_SUCCESS)
+        {
+            printf("\nerror: ocp_nlp_cost_model_set_all_stages: field %s not available\n", field);
+            exit(1);
+        }
+        blasfeo_pack_dvec(size, value + idx, vec, offset);
+        idx += size;
+    }
+
+    return idx;
+}
+
+
+
+int ocp_nlp_constraints_model_set_all_stages(ocp_nlp_config *config, ocp_nlp_dims *dims,
+        ocp_nlp_in *in, const char *field, double *value)
+{
+    struct blasfeo_dvec *vec;
+    int offset, size;
+    int idx = 0;
+
+    ocp_nlp_wait_for_worker(&in->worker);
+
+    for (int stage = 0; stage <= dims->N; stage++)
+    {
+        ocp_nlp_constraints_config *constr_config = config->constraints[stage];
+        if (constr_config->model_get_dvec_ptr(constr_config, dims->constraints[stage],
+                in->constraints[stage], field, &vec, &offset, &size) != ACADOS_SUCCESS)
+        {
+            printf("\nerror: ocp_nlp_constraints_model_set_all_stages: field %s not available\n",
+                field);
+            exit(1);
+        }
+        blasfeo_pack_dvec(size, value + idx, vec, offset);
+        idx += size;
+    }
+
+    return idx;
+}
+
+
+
 /************************************************
 * out
 ************************************************/
@@ -442,40 +527,77 @@ ocp_nlp_out *ocp_nlp_out_create(ocp_nlp_config *config, ocp_nlp_dims *dims)
 
 
 
-void ocp_nlp_out_destroy(void *out)
+void ocp_nlp_out_destroy(void *out_)
 {
+    ocp_nlp_out *out = out_;
+
+    ocp_nlp_wait_for_worker(&out->worker);
+
     free(out);
 }
 
 
 
-void ocp_nlp_out_set(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
-        int stage, const char *field, void *value)
+static int ocp_nlp_out_get_dvec_ptr(ocp_nlp_dims *dims, ocp_nlp_out *out, int stage,
+        const char *field, struct blasfeo_dvec **vec, int *offset, int *size)
 {
     if (!strcmp(field, "x"))
     {
-        double *double_values = value;
-        blasfeo_pack_dvec(dims->nx[stage], double_values, &out->ux[stage], dims->nu[stage]);
+        *vec = &out->ux[stage];
+        *offset = dims->nu[stage];
+        *size = dims->nx[stage];
     }
     else if (!strcmp(field, "u"))
     {
-        double *double_values = value;
-        blasfeo_pack_dvec(dims->nu[stage], double_values, &out->ux[stage], 0);
+        *vec = &out->ux[stage];
+        *offset = 0;
+        *size = dims->nu[stage];
+    }
+    else if (!strcmp(field, "z"))
+    {
+        *vec = &out->z[stage];
+        *offset = 0;
+        *size = dims->nz[stage];
     }
     else if (!strcmp(field, "pi"))
     {
-        double *double_values = value;
-        blasfeo_pack_dvec(dims->nx[stage+1], double_values, &out->pi[stage], 0);
+        *vec = &out->pi[stage];
+        *offset = 0;
+        *size = dims->nx[stage+1];
     }
     else if (!strcmp(field, "lam"))
     {
-        double *double_values = value;
-        blasfeo_pack_dvec(2*dims->ni[stage], double_values, &out->lam[stage], 0);
+        *vec = &out->lam[stage];
+        *offset = 0;
+        *size = 2*dims->ni[stage];
     }
     else if (!strcmp(field, "t"))
+    {
+        *vec = &out->t[stage];
+        *offset = 0;
+        *size = 2*dims->ni[stage];
+    }
+    else
+    {
+        return ACADOS_FAILURE;
+    }
+    return ACADOS_SUCCESS;
+}
+
+
+
+void ocp_nlp_out_set(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+        int stage, const char *field, void *value)
+{
+    struct blasfeo_dvec *vec;
+    int offset, size;
+
+    ocp_nlp_wait_for_worker(&out->worker);
+
+    if (ocp_nlp_out_get_dvec_ptr(dims, out, stage, field, &vec, &offset, &size) == ACADOS_SUCCESS)
     {
         double *double_values = value;
-        blasfeo_pack_dvec(2*dims->ni[stage], double_values, &out->t[stage], 0);
+        blasfeo_pack_dvec(size, double_values, vec, offset);
     }
     else
     {
@@ -489,46 +611,210 @@ void ocp_nlp_out_set(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *ou
 void ocp_nlp_out_get(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
         int stage, const char *field, void *value)
 {
-    if (!strcmp(field, "x"))
+    struct blasfeo_dvec *vec;
+    int offset, size;
+
+    if ((!strcmp(field, "kkt_norm_inf")) || (!strcmp(field, "kkt_norm")))
     {
         double *double_values = value;
-        blasfeo_unpack_dvec(dims->nx[stage], &out->ux[stage], dims->nu[stage], double_values);
+        double_values[0] = out->inf_norm_res;
     }
-    else if (!strcmp(field, "u"))
+    else if (ocp_nlp_out_get_dvec_ptr(dims, out, stage, field, &vec, &offset, &size)
+                == ACADOS_SUCCESS)
     {
         double *double_values = value;
-        blasfeo_unpack_dvec(dims->nu[stage], &out->ux[stage], 0, double_values);
+        blasfeo_unpack_dvec(size, vec, offset, double_values);
     }
-    else if (!strcmp(field, "z"))
+    else
     {
-        double *double_values = value;
-        blasfeo_unpack_dvec(dims->nz[stage], &out->z[stage], 0, double_values);
+        printf("\nerror: ocp_nlp_out_get: field %s not available\n", field);
+        exit(1);
     }
-    else if (!strcmp(field, "pi"))
+}
+
+
+
+int ocp_nlp_out_set_all(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+        const char *field, double *value)
+{
+    struct blasfeo_dvec *vec;
+    int offset, size;
+    int idx = 0;
+
+    // pi is not defined on the terminal stage
+    int N = !strcmp(field, "pi") ? dims->N - 1 : dims->N;
+
+    ocp_nlp_wait_for_worker(&out->worker);
+
+    for (int stage = 0; stage <= N; stage++)
     {
-        double *double_values = value;
-        blasfeo_unpack_dvec(dims->nx[stage+1], &out->pi[stage], 0, double_values);
+        if (ocp_nlp_out_get_dvec_ptr(dims, out, stage, field, &vec, &offset, &size)
+                != ACADOS_SUCCESS)
+        {
+            printf("\nerror: ocp_nlp_out_set_all: field %s not available\n", field);
+            exit(1);
+        }
+        blasfeo_pack_dvec(size, value + idx, vec, offset);
+        idx += size;
     }
-    else if (!strcmp(field, "lam"))
+
+    return idx;
+}
+
+
+
+int ocp_nlp_out_get_all(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+        const char *field, double *value)
+{
+    struct blasfeo_dvec *vec;
+    int offset, size;
+    int idx = 0;
+
+    // pi is not defined on the terminal stage
+    int N = !strcmp(field, "pi") ? dims->N - 1 : dims->N;
+
+    for (int stage = 0; stage <= N; stage++)
     {
-        double *double_values = value;
-        blasfeo_unpack_dvec(2*dims->ni[stage], &out->lam[stage], 0, double_values);
+        if (ocp_nlp_out_get_dvec_ptr(dims, out, stage, field, &vec, &offset, &size)
+                != ACADOS_SUCCESS)
+        {
+            printf("\nerror: ocp_nlp_out_get_all: field %s not available\n", field);
+            exit(1);
+        }
+        blasfeo_unpack_dvec(size, vec, offset, value + idx);
+        idx += size;
     }
-    else if (!strcmp(field, "t"))
+
+    return idx;
+}
+
+
+
+/************************************************
+* field handles
+************************************************/
+
+ocp_nlp_field_handle *ocp_nlp_field_handle_create(ocp_nlp_config *config, ocp_nlp_dims *dims,
+        ocp_nlp_in *in, ocp_nlp_out *out, const char *module, int stage_start, int stage_end,
+        const char *field)
+{
+    if (stage_start < 0 || stage_end > dims->N || stage_start > stage_end)
     {
-        double *double_values = value;
-        blasfeo_unpack_dvec(2*dims->ni[stage], &out->t[stage], 0, double_values);
+        printf("\nerror: ocp_nlp_field_handle_create: invalid stage range [%d, %d]\n",
+            stage_start, stage_end);
+        exit(1);
     }
-    else if ((!strcmp(field, "kkt_norm_inf")) || (!strcmp(field, "kkt_norm")))
+
+    int num_stages = stage_end - stage_start + 1;
+
+    int bytes = sizeof(ocp_nlp_field_handle) + num_stages * sizeof(ocp_nlp_field_segment);
+    char *c_ptr = acados_calloc(1, bytes);
+
+    ocp_nlp_field_handle *handle = (ocp_nlp_field_handle *) c_ptr;
+    c_ptr += sizeof(ocp_nlp_field_handle);
+
+    handle->stage_start = stage_start;
+    handle->stage_end = stage_end;
+    handle->segments = (ocp_nlp_field_segment *) c_ptr;
+    handle->worker = !strcmp(module, "out") ? &out->worker : &in->worker;
+
+    for (int stage = stage_start; stage <= stage_end; stage++)
     {
-        double *double_values = value;
-        double_values[0] = out->inf_norm_res;
+        ocp_nlp_field_segment *seg = &handle->segments[stage - stage_start];
+        int status = ACADOS_FAILURE;
+
+        if (!strcmp(module, "in"))
+        {
+            // parameters are not part of ocp_nlp_in, they are held by the external functions
+            if (strcmp(field, "Ts"))
+            {
+                printf("\nerror: ocp_nlp_field_handle_create: module in only provides Ts, got %s;"
+                    " parameters are set on the external functions (set_param)\n", field);
+                exit(1);
+            }
+            if (stage < dims->N)
+            {
+                seg->ptr = &in->Ts[stage];
+                seg->size = 1;
+                status = ACADOS_SUCCESS;
+            }
+        }
+        else if (!strcmp(module, "cost"))
+        {
+            ocp_nlp_cost_config *cost_config = config->cost[stage];
+            status = cost_config->model_get_dvec_ptr(cost_config, dims->cost[stage],
+                in->cost[stage], field, &seg->vec, &seg->offset, &seg->size);
+        }
+        else if (!strcmp(module, "constraints"))
+        {
+            ocp_nlp_constraints_config *constr_config = config->constraints[stage];
+            status = constr_config->model_get_dvec_ptr(constr_config,
+                dims->constraints[stage], in->constraints[stage], field,
+                &seg->vec, &seg->offset, &seg->size);
+        }
+        else if (!strcmp(module, "out"))
+        {
+            if (!(!strcmp(field, "pi") && stage == dims->N))
+                status = ocp_nlp_out_get_dvec_ptr(dims, out, stage, field,
+                    &seg->vec, &seg->offset, &seg->size);
+        }
+        else
+        {
+            printf("\nerror: ocp_nlp_field_handle_create: module %s not available\n", module);
+            exit(1);
+        }
+
+        if (status != ACADOS_SUCCESS)
+        {
+            printf("\nerror: ocp_nlp_field_handle_create: field %s of module %s "
+                "not available at stage %d\n", field, module, stage);
+            exit(1);
+        }
     }
+
+    return handle;
+}
+
+
+
+void ocp_nlp_field_handle_destroy(void *handle)
+{
+    free(handle);
+}
+
+
+
+int ocp_nlp_field_handle_get_size(ocp_nlp_field_handle *handle, int stage)
+{
+    return handle->segments[stage - handle->stage_start].size;
+}
+
+
+
+void ocp_nlp_set_by_handle(ocp_nlp_field_handle *handle, int stage, double *value)
+{
+    ocp_nlp_field_segment *seg = &handle->segments[stage - handle->stage_start];
+
+    ocp_nlp_wait_for_worker(handle->worker);
+
+    if (seg->vec)
+        blasfeo_pack_dvec(seg->size, value, seg->vec, seg->offset);
     else
-    {
-        printf("\nerror: ocp_nlp_out_get: field %s not available\n", field);
-        exit(1);
-    }
+        for (int ii = 0; ii < seg->size; ii++)
+            seg->ptr[ii] = value[ii];
+}
+
+
+
+void ocp_nlp_get_by_handle(ocp_nlp_field_handle *handle, int stage, double *value)
+{
+    ocp_nlp_field_segment *seg = &handle->segments[stage - handle->stage_start];
+
+    if (seg->vec)
+        blasfeo_unpack_dvec(seg->size, seg->vec, seg->offset, value);
+    else
+        for (int ii = 0; ii < seg->size; ii++)
+            value[ii] = seg->ptr[ii];
 }
 
 
@@ -847,13 +1133,26 @@ ocp_nlp_solver *ocp_nlp_solver_create(ocp_nlp_config *config, ocp_nlp_dims *dims
 }
 
 
-void ocp_nlp_solver_destroy(void *solver)
+void ocp_nlp_solver_destroy(void *solver_)
 {
+    ocp_nlp_solver *solver = solver_;
+
+    if (solver->config->terminate != NULL)
+        solver->config->terminate(solver->config, solver->mem, solver->work);
+
     free(solver);
 }
 
 
 
+void ocp_nlp_solver_wait(ocp_nlp_solver *solver)
+{
+    if (solver->config->wait != NULL)
+        solver->config->wait(solver->config, solver->mem);
+}
+
+
+
 int ocp_nlp_solve(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out)
 {
     return solver->config->evaluate(solver->config, solver->dims, nlp_in, nlp_out,
@@ -880,9 +1179,29 @@ void ocp_nlp_eval_param_sens(ocp_nlp_solver *solver, char *field, int stage, int
 
 
 
+void ocp_nlp_eval_param_sens_batch(ocp_nlp_solver *solver, char *field, int stage, int n_dir,
+                                   int *index, double *sens, int ld_sens)
+{
+    solver->config->eval_param_sens_batch(solver->config, solver->dims, solver->opts, solver->mem,
+                                          solver->work, field, stage, n_dir, index, sens, ld_sens);
+    return;
+}
+
+
+
 void ocp_nlp_get(ocp_nlp_config *config, ocp_nlp_solver *solver,
                  const char *field, void *return_value_)
 {
+    if (!strncmp(field, "qp_cond_N", 9) || !strcmp(field, "qp_res_single") ||
+        !strcmp(field, "qp_res_mixed") || !strcmp(field, "qp_itref_mixed_iter"))
+    {
+        // partial condensing horizon and candidate timings of the xcond solver,
+        // mixed precision accuracy report of the qp solver
+        ocp_nlp_memory *nlp_mem;
+        config->get(config, solver->dims, solver->mem, "nlp_mem", &nlp_mem);
+        config->qp_solver->memory_get(config->qp_solver, nlp_mem->qp_solver_mem, field+3, return_value_);
+        return;
+    }
     solver->config->get(solver->config, solver->dims, solver->mem, field, return_value_);
 }
 
@@ -922,6 +1241,8 @@ void ocp_nlp_set(ocp_nlp_config *config, ocp_nlp_solver *solver,
 
     ocp_nlp_dims *dims = solver->dims;
 
+    ocp_nlp_solver_wait(solver);
+
     if (!strcmp(field, "z_guess"))
     {
         int nz = dims->nz[stage];
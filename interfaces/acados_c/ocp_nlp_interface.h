@@ -46,6 +46,8 @@ extern "C" {
 #include "acados/sim/sim_irk_integrator.h"
 #include "acados/sim/sim_lifted_irk_integrator.h"
 #include "acados/sim/sim_gnsf.h"
+#include "acados/sim/sim_rosenbrock_integrator.h"
+#include "acados/sim/sim_exp_euler_integrator.h"
 // acados_c
 #include "acados_c/ocp_qp_interface.h"
 #include "acados_c/sim_interface.h"
@@ -147,6 +149,28 @@ typedef struct
 } ocp_nlp_solver;
 
 
+
+/// Direct reference to the data of a field on one stage.
+typedef struct
+{
+    struct blasfeo_dvec *vec;  // NULL if the field is a plain double array
+    double *ptr;
+    int offset;
+    int size;
+} ocp_nlp_field_segment;
+
+
+
+/// Pre-resolved field, see ocp_nlp_field_handle_create.
+typedef struct
+{
+    int stage_start;
+    int stage_end;
+    ocp_nlp_field_segment *segments;
+    acados_worker **worker;  // worker slot of the struct holding the field, see ocp_nlp_in
+} ocp_nlp_field_handle;
+
+
 /// Constructs an empty plan struct (user nlp configuration), all fields are set to a
 /// default/invalid state.
 ///
@@ -192,6 +216,17 @@ ocp_nlp_in *ocp_nlp_in_create(ocp_nlp_config *config, ocp_nlp_dims *dims);
 /// \param in The inputs struct.
 void ocp_nlp_in_destroy(void *in);
 
+// NOTE: with the asynchronous preparation phase of SQP_RTI (option rti_async),
+// the solver keeps reading the inputs, outputs and options of the last call after it returns.
+// All setters of in, out and opts (including the handle and all-stages variants) and their
+// destructors wait for the preparation phase to finish before writing, so they may be
+// called at any time. The solver has to be destroyed before in, out and opts.
+// The preparation phase for the next call starts right after the feedback phase, so data set
+// in between takes effect with a delay of one sample: the next feedback phase solves a QP
+// linearized with the previous references, parameters, cost and constraints. Only the initial
+// value (lbx and ubx at stage 0) is embedded in the feedback phase and used immediately.
+// To apply new data without delay, call the solver with rti_phase 1 and then rti_phase 2.
+
 
 /// Sets the sampling times for the given stage.
 ///
@@ -242,6 +277,28 @@ int ocp_nlp_cost_model_set(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_i
 int ocp_nlp_constraints_model_set(ocp_nlp_config *config, ocp_nlp_dims *dims,
         ocp_nlp_in *in, int stage, const char *field, void *value);
 
+/// Sets a vector field of the cost module on all stages 0, ..., N at once.
+///
+/// \param config The configuration struct.
+/// \param dims The dimension struct.
+/// \param in The inputs struct.
+/// \param field The name of the field, e.g. yref, zl, Zu.
+/// \param value Stage-major array, the values of stage i follow those of stage i-1.
+/// \return The number of doubles read from value.
+int ocp_nlp_cost_model_set_all_stages(ocp_nlp_config *config, ocp_nlp_dims *dims,
+        ocp_nlp_in *in, const char *field, double *value);
+
+/// Sets a vector field of the constraints module on all stages 0, ..., N at once.
+///
+/// \param config The configuration struct.
+/// \param dims The dimension struct.
+/// \param in The inputs struct.
+/// \param field The name of the field, e.g. lbx, ubu, lh.
+/// \param value Stage-major array, the values of stage i follow those of stage i-1.
+/// \return The number of doubles read from value.
+int ocp_nlp_constraints_model_set_all_stages(ocp_nlp_config *config, ocp_nlp_dims *dims,
+        ocp_nlp_in *in, const char *field, double *value);
+
 /* out */
 
 /// Constructs an output struct for the non-linear program.
@@ -279,10 +336,73 @@ void ocp_nlp_out_set(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *ou
 void ocp_nlp_out_get(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
         int stage, const char *field, void *value);
 
+/// Sets a field of the output struct on all stages at once (stages 0, ..., N-1 for pi).
+///
+/// \param config The configuration struct.
+/// \param dims The dimension struct.
+/// \param out The output struct.
+/// \param field The name of the field, either x, u, z, pi, lam, t.
+/// \param value Stage-major array, the values of stage i follow those of stage i-1.
+/// \return The number of doubles read from value.
+int ocp_nlp_out_set_all(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+        const char *field, double *value);
+
+/// Gets a field of the output struct on all stages at once (stages 0, ..., N-1 for pi).
+///
+/// \param config The configuration struct.
+/// \param dims The dimension struct.
+/// \param out The output struct.
+/// \param field The name of the field, either x, u, z, pi, lam, t.
+/// \param value Pointer to the stage-major output memory.
+/// \return The number of doubles written to value.
+int ocp_nlp_out_get_all(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+        const char *field, double *value);
+
 //
 void ocp_nlp_get_at_stage(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_solver *solver,
         int stage, const char *field, void *value);
 
+/* field handles */
+
+/// Resolves a string field once into direct pointers to its data on a range of
+/// stages, such that repeated set/get calls in a control loop bypass the
+/// string dispatch. Vector-valued fields only.
+///
+/// \param config The configuration struct.
+/// \param dims The dimension struct.
+/// \param in The inputs struct.
+/// \param out The output struct.
+/// \param module The module holding the field, either in (Ts only, parameters are held by the
+///     external functions), cost, constraints, out.
+/// \param stage_start First stage covered by the handle.
+/// \param stage_end Last stage covered by the handle (inclusive).
+/// \param field The name of the field, e.g. yref, lbx, ubu, x, u.
+ocp_nlp_field_handle *ocp_nlp_field_handle_create(ocp_nlp_config *config, ocp_nlp_dims *dims,
+        ocp_nlp_in *in, ocp_nlp_out *out, const char *module, int stage_start, int stage_end,
+        const char *field);
+
+/// Destructor of a field handle.
+///
+/// \param handle The field handle.
+void ocp_nlp_field_handle_destroy(void *handle);
+
+/// Returns the number of doubles accessed by the handle at the given stage.
+int ocp_nlp_field_handle_get_size(ocp_nlp_field_handle *handle, int stage);
+
+/// Sets the field referenced by the handle at the given stage.
+///
+/// \param handle The field handle.
+/// \param stage Stage number, within the range of the handle.
+/// \param value Pointer to ocp_nlp_field_handle_get_size(handle, stage) doubles.
+void ocp_nlp_set_by_handle(ocp_nlp_field_handle *handle, int stage, double *value);
+
+/// Gets the field referenced by the handle at the given stage.
+///
+/// \param handle The field handle.
+/// \param stage Stage number, within the range of the handle.
+/// \param value Pointer to the output memory.
+void ocp_nlp_get_by_handle(ocp_nlp_field_handle *handle, int stage, double *value);
+
 // TODO(andrea): remove this once/if the MATLAB interface uses the new setters below?
 int ocp_nlp_dims_get_from_attr(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
         int stage, const char *field);
@@ -341,6 +461,13 @@ ocp_nlp_solver *ocp_nlp_solver_create(ocp_nlp_config *config, ocp_nlp_dims *dims
 /// \param solver The solver struct.
 void ocp_nlp_solver_destroy(void *solver);
 
+/// Waits until work of the solver running in the background is finished,
+/// e.g. the asynchronous preparation phase of SQP_RTI (option rti_async).
+/// The setters wait implicitly, this is only needed to modify the data directly.
+///
+/// \param solver The solver struct.
+void ocp_nlp_solver_wait(ocp_nlp_solver *solver);
+
 /// Solves the optimal control problem. Call ocp_nlp_precompute before
 /// calling this functions (TBC).
 ///
@@ -360,10 +487,31 @@ int ocp_nlp_precompute(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, ocp_nlp_out *
 //
 void ocp_nlp_eval_param_sens(ocp_nlp_solver *solver, char *field, int stage, int index, ocp_nlp_out *sens_nlp_out);
 
+/// Computes the sensitivities of the last QP solution w.r.t. several entries of a parameter,
+/// reusing the QP setup and factorization across the directions.
+/// This is not a true multi-RHS solve: each direction runs its own single-RHS backsolve,
+/// the saving over ocp_nlp_eval_param_sens is the QP copy done once for all directions.
+///
+/// \param solver The solver struct.
+/// \param field The parameter, supports "ex" at stage 0, i.e. the Jacobian w.r.t. the initial state.
+///     Sensitivities w.r.t. the model parameters ("p", "p_global", "parameter_values") are not
+///     supported: the model functions provide no derivatives w.r.t. the parameters. Requesting
+///     them is an error.
+/// \param stage The stage of the parameter.
+/// \param n_dir The number of directions.
+/// \param index The n_dir parameter entries.
+/// \param sens Column-major output, column k holds the sensitivity w.r.t. index[k],
+///     with ux, pi and lam of all stages stacked: ocp_nlp_param_sens_rows(dims) rows.
+/// \param ld_sens The leading dimension of sens, at least ocp_nlp_param_sens_rows(dims).
+void ocp_nlp_eval_param_sens_batch(ocp_nlp_solver *solver, char *field, int stage, int n_dir,
+        int *index, double *sens, int ld_sens);
+
 /* get */
 /// \param config The configuration struct.
 /// \param solver The solver struct.
 /// \param field Supports "sqp_iter", "status", "nlp_res", "time_tot", ...
+///     and "qp_cond_N", "qp_cond_N_num_cand", "qp_cond_N_cand", "qp_cond_N_time" of the xcond solver,
+///     and "qp_res_single", "qp_res_mixed", "qp_itref_mixed_iter" of HPIPM in mixed precision.
 /// \param return_value_ Pointer to the output memory.
 void ocp_nlp_get(ocp_nlp_config *config, ocp_nlp_solver *solver,
         const char *field, void *return_value_);
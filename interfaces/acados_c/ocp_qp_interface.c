@@ -56,6 +56,7 @@
 #endif
 
 #include "acados/ocp_qp/ocp_qp_hpipm.h"
+#include "acados/ocp_qp/ocp_qp_pdas.h"
 #ifdef ACADOS_WITH_HPMPC
 #include "acados/ocp_qp/ocp_qp_hpmpc.h"
 #endif
@@ -114,6 +115,11 @@ void ocp_qp_xcond_solver_config_initialize_from_plan(
 			ocp_qp_partial_condensing_config_initialize_default(solver_config->xcond);
             break;
 #endif
+        case PARTIAL_CONDENSING_PDAS:
+			ocp_qp_xcond_solver_config_initialize_default(solver_config);
+            ocp_qp_pdas_config_initialize_default(solver_config->qp_solver);
+			ocp_qp_partial_condensing_config_initialize_default(solver_config->xcond);
+            break;
         case FULL_CONDENSING_HPIPM:
 			ocp_qp_xcond_solver_config_initialize_default(solver_config);
             dense_qp_hpipm_config_initialize_default(solver_config->qp_solver);
@@ -418,12 +424,85 @@ int ocp_qp_solve(ocp_qp_solver *solver, ocp_qp_in *qp_in, ocp_qp_out *qp_out)
 }
 
 
+void ocp_qp_solver_in_set(ocp_qp_solver *solver, ocp_qp_in *qp_in, int stage, char *field,
+                          void *value)
+{
+    d_ocp_qp_set(field, stage, value, qp_in);
+
+    // all fields that do not enter the condensed matrices
+    const char *vector_fields[] = {"b", "q", "r", "lb", "ub", "lbx", "ubx", "lbu", "ubu",
+                                   "lg", "ug", "zl", "zu", "lls", "lus"};
+    int num_vector_fields = sizeof(vector_fields) / sizeof(vector_fields[0]);
+
+    for (int ii = 0; ii < num_vector_fields; ii++)
+    {
+        if (!strcmp(field, vector_fields[ii]))
+            return;
+    }
+
+    solver->config->memory_set(solver->config, solver->mem, "mat_dirty", &stage);
+}
+
+
+
 void ocp_qp_solver_destroy(ocp_qp_solver *solver)
 {
     free(solver);
 }
 
 
+
+ocp_qp_batch_solver *ocp_qp_batch_create(ocp_qp_xcond_solver_config *config,
+                                         ocp_qp_xcond_solver_dims *dims, void *opts_, int n_batch,
+                                         int num_threads)
+{
+    config->opts_update(config, dims, opts_);
+
+    int bytes = sizeof(ocp_qp_batch_solver);
+    bytes += ocp_qp_xcond_solver_batch_memory_calculate_size(config, dims, opts_, n_batch,
+                                                             num_threads);
+
+    char *c_ptr = calloc(1, bytes);
+
+    ocp_qp_batch_solver *solver = (ocp_qp_batch_solver *) c_ptr;
+    c_ptr += sizeof(ocp_qp_batch_solver);
+
+    solver->config = config;
+    solver->dims = dims;
+    solver->opts = opts_;
+    solver->n_batch = n_batch;
+    solver->mem = ocp_qp_xcond_solver_batch_memory_assign(config, dims, opts_, n_batch,
+                                                          num_threads, c_ptr);
+
+    return solver;
+}
+
+
+
+void ocp_qp_batch_destroy(ocp_qp_batch_solver *solver)
+{
+    ocp_qp_xcond_solver_batch_memory_terminate(solver->mem);
+    free(solver);
+}
+
+
+
+int ocp_qp_batch_solve(ocp_qp_batch_solver *solver, ocp_qp_in **qp_in, ocp_qp_out **qp_out,
+                       int n_batch, int *status)
+{
+    int acados_return = ocp_qp_xcond_solver_batch(solver->config, solver->dims, qp_in, qp_out,
+                                                  n_batch, solver->opts, solver->mem);
+
+    if (status != NULL)
+    {
+        for (int ii = 0; ii < n_batch; ii++)
+            status[ii] = solver->mem->status[ii];
+    }
+
+    return acados_return;
+}
+
+
 // qp residual
 static ocp_qp_res *ocp_qp_res_create(ocp_qp_dims *dims)
 {
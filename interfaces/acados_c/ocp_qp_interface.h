@@ -51,6 +51,7 @@ extern "C" {
 ///   PARTIAL_CONDENSING_OOQP
 ///   PARTIAL_CONDENSING_OSQP
 ///   PARTIAL_CONDENSING_QPDUNES
+///   PARTIAL_CONDENSING_PDAS
 ///   FULL_CONDENSING_HPIPM
 ///   FULL_CONDENSING_QPOASES
 ///   FULL_CONDENSING_QORE
@@ -73,6 +74,7 @@ typedef enum {
 #ifdef ACADOS_WITH_QPDUNES
     PARTIAL_CONDENSING_QPDUNES,
 #endif
+    PARTIAL_CONDENSING_PDAS,
     FULL_CONDENSING_HPIPM,
 #ifdef ACADOS_WITH_QPOASES
     FULL_CONDENSING_QPOASES,
@@ -105,6 +107,17 @@ typedef struct
 } ocp_qp_solver;
 
 
+/// Solver for a batch of qps with the same dimensions.
+typedef struct
+{
+    ocp_qp_xcond_solver_config *config;
+    ocp_qp_xcond_solver_dims *dims;
+    void *opts;
+    ocp_qp_xcond_solver_batch_memory *mem;
+    int n_batch;
+} ocp_qp_batch_solver;
+
+
 /// Initializes the qp solver configuration.
 /// TBC should this be private/static - no, used in ocp_nlp
 void ocp_qp_xcond_solver_config_initialize_from_plan(
@@ -231,6 +244,49 @@ void ocp_qp_x_cond_solver_free(ocp_qp_xcond_solver_config *config,
 int ocp_qp_solve(ocp_qp_solver *solver, ocp_qp_in *qp_in, ocp_qp_out *qp_out);
 
 
+/// Sets a field of the qp and marks the stage as changed for the solver, such that with the
+/// option mat_dirty_tracking the matrices are only condensed again if one of them changed.
+///
+/// \param solver The solver.
+/// \param qp_in The inputs struct.
+/// \param stage Stage number.
+/// \param field The name of the field, e.g. A, B, Q, b, q, lbx.
+/// \param value The new values.
+void ocp_qp_solver_in_set(ocp_qp_solver *solver, ocp_qp_in *qp_in, int stage, char *field,
+                          void *value);
+
+
+/// Creates a solver for up to n_batch qps with the same dimensions and options.
+/// Memory and workspace of all instances are allocated in one block.
+/// With presolve and cond_N_auto, each instance keeps its own presolved dimensions and horizon.
+///
+/// \param config The configuration struct.
+/// \param dims The dimension struct.
+/// \param opts_ The options struct.
+/// \param n_batch Maximum number of qps solved in one call.
+/// \param num_threads Number of threads, including the calling thread.
+ocp_qp_batch_solver *ocp_qp_batch_create(ocp_qp_xcond_solver_config *config,
+                                         ocp_qp_xcond_solver_dims *dims, void *opts_, int n_batch,
+                                         int num_threads);
+
+/// Destroys a batch solver, joins its threads and frees memory.
+///
+/// \param solver The batch solver.
+void ocp_qp_batch_destroy(ocp_qp_batch_solver *solver);
+
+/// Solves the qps qp_in[i], i < n_batch, in parallel. The solution of each qp does not depend
+/// on the number of threads.
+///
+/// \param solver The batch solver.
+/// \param qp_in Array of n_batch input structs.
+/// \param qp_out Array of n_batch output structs.
+/// \param n_batch Number of qps.
+/// \param status Output array for the status of each qp, can be NULL.
+/// \return The first nonzero status, 0 if all qps are solved.
+int ocp_qp_batch_solve(ocp_qp_batch_solver *solver, ocp_qp_in **qp_in, ocp_qp_out **qp_out,
+                       int n_batch, int *status);
+
+
 /// Calculates the infinity norm of the residuals.
 ///
 /// \param dims The dimension struct.
@@ -37,6 +37,8 @@
 #include "acados/sim/sim_gnsf.h"
 #include "acados/sim/sim_irk_integrator.h"
 #include "acados/sim/sim_lifted_irk_integrator.h"
+#include "acados/sim/sim_rosenbrock_integrator.h"
+#include "acados/sim/sim_exp_euler_integrator.h"
 
 #include "acados_c/sim_interface.h"
 
@@ -45,7 +47,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "acados/utils/external_function_generic.h"
 #include "acados/utils/mem.h"
+#include "acados/utils/threads.h"
 
 
 
@@ -78,6 +82,12 @@ sim_config *sim_config_create(sim_solver_plan plan)
             break;
         case LIFTED_IRK:
             sim_lifted_irk_config_initialize_default(solver_config);
+            break;
+        case ROSENBROCK:
+            sim_rosenbrock_config_initialize_default(solver_config);
+            break;
+        case EXP_EULER:
+            sim_exp_euler_config_initialize_default(solver_config);
             break;
 		case INVALID_SIM_SOLVER:
             printf("\nerror: sim_config_create: forgot to initialize plan->sim_solver\n");
@@ -320,3 +330,271 @@ int sim_solver_set(sim_solver *solver, const char *field, void *value)
 {
     return solver->config->memory_set(solver->config, solver->dims, solver->mem, field, value);
 }
+
+
+
+void sim_solver_get(sim_solver *solver, const char *field, void *value)
+{
+    solver->config->memory_get(solver->config, solver->dims, solver->mem, field, value);
+}
+
+
+
+/************************************************
+* batch
+************************************************/
+
+int sim_batch_calculate_size(sim_config *config, void *dims, void *opts_, int num_threads, int np)
+{
+    int size = sizeof(sim_batch);
+
+    size += 3 * num_threads * sizeof(void *);  // solver in out
+    size += SIM_BATCH_MAX_PARAM_FUN * num_threads * sizeof(void *);  // param_fun
+    size += 2 * num_threads * sizeof(int);  // num_param_fun status
+
+    size += acados_thread_pool_calculate_size(num_threads, num_threads);
+
+    for (int ii = 0; ii < num_threads; ii++)
+    {
+        size += sim_calculate_size(config, dims, opts_);
+        size += sim_in_calculate_size(config, dims);
+        size += sim_out_calculate_size(config, dims);
+        size += 3 * 8;  // align
+    }
+
+    size += 8;  // align
+
+    return size;
+}
+
+
+
+sim_batch *sim_batch_assign(sim_config *config, void *dims, void *opts_, int num_threads, int np,
+                            void *raw_memory)
+{
+    char *c_ptr = (char *) raw_memory;
+
+    sim_batch *batch = (sim_batch *) c_ptr;
+    c_ptr += sizeof(sim_batch);
+
+    batch->config = config;
+    batch->dims = dims;
+    batch->opts = opts_;
+    batch->num_threads = num_threads;
+    batch->np = np;
+    config->dims_get(config, dims, "nx", &batch->nx);
+    config->dims_get(config, dims, "nu", &batch->nu);
+
+    align_char_to(8, &c_ptr);
+
+    batch->solver = (sim_solver **) c_ptr;
+    c_ptr += num_threads * sizeof(void *);
+    batch->in = (sim_in **) c_ptr;
+    c_ptr += num_threads * sizeof(void *);
+    batch->out = (sim_out **) c_ptr;
+    c_ptr += num_threads * sizeof(void *);
+    batch->param_fun = (void **) c_ptr;
+    c_ptr += SIM_BATCH_MAX_PARAM_FUN * num_threads * sizeof(void *);
+
+    assign_and_advance_int(num_threads, &batch->num_param_fun, &c_ptr);
+    assign_and_advance_int(num_threads, &batch->status, &c_ptr);
+
+    align_char_to(8, &c_ptr);
+    batch->pool = acados_thread_pool_assign(num_threads, num_threads, c_ptr);
+    c_ptr += acados_thread_pool_calculate_size(num_threads, num_threads);
+
+    // memory and workspace of each worker
+    for (int ii = 0; ii < num_threads; ii++)
+    {
+        align_char_to(8, &c_ptr);
+        batch->solver[ii] = sim_assign(config, dims, opts_, c_ptr);
+        c_ptr += sim_calculate_size(config, dims, opts_);
+
+        align_char_to(8, &c_ptr);
+        batch->in[ii] = sim_in_assign(config, dims, c_ptr);
+        c_ptr += sim_in_calculate_size(config, dims);
+
+        align_char_to(8, &c_ptr);
+        batch->out[ii] = sim_out_assign(config, dims, c_ptr);
+        c_ptr += sim_out_calculate_size(config, dims);
+
+        batch->num_param_fun[ii] = 0;
+        batch->status[ii] = ACADOS_SUCCESS;
+    }
+
+    batch->num_traj = 0;
+
+    assert((char *) raw_memory + sim_batch_calculate_size(config, dims, opts_, num_threads, np)
+           >= c_ptr);
+
+    return batch;
+}
+
+
+
+sim_batch *sim_batch_create(sim_config *config, void *dims, void *opts_, int num_threads, int np)
+{
+    if (num_threads < 1 || num_threads > ACADOS_MAX_THREADS)
+    {
+        printf("\nerror: sim_batch_create: num_threads = %d not in [1, %d]\n",
+               num_threads, ACADOS_MAX_THREADS);
+        exit(1);
+    }
+
+    // update Butcher tableau (needed if the user changed ns)
+    config->opts_update(config, dims, opts_);
+    int bytes = sim_batch_calculate_size(config, dims, opts_, num_threads, np);
+
+    void *ptr = calloc(1, bytes);
+
+    sim_batch *batch = sim_batch_assign(config, dims, opts_, num_threads, np, ptr);
+
+    return batch;
+}
+
+
+
+void sim_batch_destroy(void *batch_)
+{
+    sim_batch *batch = batch_;
+
+    acados_thread_pool_stop(batch->pool);
+    free(batch);
+}
+
+
+
+int sim_batch_in_set(sim_batch *batch, const char *field, void *value)
+{
+    int status = ACADOS_SUCCESS;
+
+    for (int ii = 0; ii < batch->num_threads; ii++)
+    {
+        status = sim_in_set(batch->config, batch->dims, batch->in[ii], field, value);
+        if (status != ACADOS_SUCCESS)
+            break;
+    }
+
+    return status;
+}
+
+
+
+int sim_batch_model_set(sim_batch *batch, int worker, const char *field, void *value)
+{
+    if (worker < 0 || worker >= batch->num_threads)
+    {
+        printf("\nerror: sim_batch_model_set: worker %d not in [0, %d)\n",
+               worker, batch->num_threads);
+        exit(1);
+    }
+
+    int status = batch->config->model_set(batch->in[worker]->model, field, value);
+
+    // remember the function to set its parameters for each trajectory
+    if (batch->np > 0)
+    {
+        void **param_fun = batch->param_fun + SIM_BATCH_MAX_PARAM_FUN * worker;
+        int num = batch->num_param_fun[worker];
+
+        int found = 0;
+        for (int ii = 0; ii < num; ii++)
+            found |= param_fun[ii] == value;
+
+        if (!found)
+        {
+            if (num == SIM_BATCH_MAX_PARAM_FUN)
+            {
+                printf("\nerror: sim_batch_model_set: more than %d parametric functions\n",
+                       SIM_BATCH_MAX_PARAM_FUN);
+                exit(1);
+            }
+            param_fun[num] = value;
+            batch->num_param_fun[worker] = num + 1;
+        }
+    }
+
+    return status;
+}
+
+
+
+// simulates a contiguous block of the trajectories with the solver of one worker
+static void sim_batch_worker(void *batch_, int worker)
+{
+    sim_batch *batch = batch_;
+
+    int nx = batch->nx;
+    int nu = batch->nu;
+    int np = batch->np;
+    int num_threads = batch->num_threads;
+    int num_traj = batch->num_traj;
+
+    sim_solver *solver = batch->solver[worker];
+    sim_in *in = batch->in[worker];
+    sim_out *out = batch->out[worker];
+    void **param_fun = batch->param_fun + SIM_BATCH_MAX_PARAM_FUN * worker;
+
+    int start = (worker * num_traj) / num_threads;
+    int end = ((worker + 1) * num_traj) / num_threads;
+
+    batch->status[worker] = ACADOS_SUCCESS;
+
+    for (int kk = start; kk < end; kk++)
+    {
+        for (int ii = 0; ii < nx; ii++)
+            in->x[ii] = batch->x0[kk * nx + ii];
+        for (int ii = 0; ii < nu; ii++)
+            in->u[ii] = batch->u[kk * nu + ii];
+
+        if (np > 0)
+        {
+            for (int ii = 0; ii < batch->num_param_fun[worker]; ii++)
+            {
+                external_function_param_generic *fun = param_fun[ii];
+                fun->set_param(fun, batch->p + kk * np);
+            }
+        }
+
+        int status = sim_solve(solver, in, out);
+        if (status != ACADOS_SUCCESS && batch->status[worker] == ACADOS_SUCCESS)
+            batch->status[worker] = status;
+
+        for (int ii = 0; ii < nx; ii++)
+            batch->xn[kk * nx + ii] = out->xn[ii];
+        if (batch->S_forw != NULL)
+        {
+            for (int ii = 0; ii < nx * (nx + nu); ii++)
+                batch->S_forw[kk * nx * (nx + nu) + ii] = out->S_forw[ii];
+        }
+    }
+}
+
+
+
+int sim_solve_batch(sim_batch *batch, int num_traj, double *x0, double *u, double *p,
+                    double *xn, double *S_forw)
+{
+    if (batch->np > 0 && p == NULL)
+    {
+        printf("\nerror: sim_solve_batch: p is NULL with np = %d\n", batch->np);
+        exit(1);
+    }
+
+    batch->num_traj = num_traj;
+    batch->x0 = x0;
+    batch->u = u;
+    batch->p = p;
+    batch->xn = xn;
+    batch->S_forw = S_forw;
+
+    acados_thread_pool_parallel_for(batch->pool, batch->num_threads, &sim_batch_worker, batch);
+
+    for (int ii = 0; ii < batch->num_threads; ii++)
+    {
+        if (batch->status[ii] != ACADOS_SUCCESS)
+            return batch->status[ii];
+    }
+
+    return ACADOS_SUCCESS;
+}
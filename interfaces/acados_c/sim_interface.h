@@ -40,6 +40,7 @@ extern "C" {
 #endif
 
 #include "acados/sim/sim_common.h"
+#include "acados/utils/threads.h"
 
 
 
@@ -49,6 +50,8 @@ typedef enum
 	IRK,
 	GNSF,
 	LIFTED_IRK,
+	ROSENBROCK,  // approximate sensitivities, an OCP optimum is biased by O(step^2)
+	EXP_EULER,
 	INVALID_SIM_SOLVER,
 } sim_solver_t;
 
@@ -72,6 +75,42 @@ typedef struct
 
 
 
+// maximum number of parametric model functions per batch worker
+#define SIM_BATCH_MAX_PARAM_FUN 16
+
+/** Solver for batches of trajectories with the same model and options.
+ *  Every worker thread owns a solver, sim_in and sim_out carved from a single arena;
+ *  the model functions of each worker are set separately, as external functions are not
+ *  thread safe. With np > 0, the model functions are parametric external functions
+ *  (external_function_param_casadi or external_function_param_generic). */
+typedef struct
+{
+    sim_config *config;
+    void *dims;
+    void *opts;
+    int num_threads;
+    int nx;
+    int nu;
+    int np;
+    sim_solver **solver;  // one per worker
+    sim_in **in;
+    sim_out **out;
+    void **param_fun;  // param_fun[SIM_BATCH_MAX_PARAM_FUN * worker + ii]
+    int *num_param_fun;
+    int *status;  // status of each worker in the last batch
+    acados_thread_pool *pool;
+
+    // current batch
+    int num_traj;
+    double *x0;
+    double *u;
+    double *p;
+    double *xn;
+    double *S_forw;
+} sim_batch;
+
+
+
 /* config */
 //
 sim_config *sim_config_create(sim_solver_plan plan);
@@ -130,6 +169,28 @@ int sim_solve(sim_solver *solver, sim_in *in, sim_out *out);
 int sim_precompute(sim_solver *solver, sim_in *in, sim_out *out);
 //
 int sim_solver_set(sim_solver *solver, const char *field, void *value);
+//
+void sim_solver_get(sim_solver *solver, const char *field, void *value);
+
+/* batch */
+//
+int sim_batch_calculate_size(sim_config *config, void *dims, void *opts_, int num_threads, int np);
+//
+sim_batch *sim_batch_assign(sim_config *config, void *dims, void *opts_, int num_threads, int np,
+                            void *raw_memory);
+//
+sim_batch *sim_batch_create(sim_config *config, void *dims, void *opts_, int num_threads, int np);
+//
+void sim_batch_destroy(void *batch);
+/* Sets a field of the sim_in of all workers, e.g. T or the seeds. */
+int sim_batch_in_set(sim_batch *batch, const char *field, void *value);
+/* Sets a model function of one worker. */
+int sim_batch_model_set(sim_batch *batch, int worker, const char *field, void *value);
+/* Simulates num_traj trajectories from x0[nx*num_traj] with u[nu*num_traj] and
+ * p[np*num_traj] (may be NULL if np == 0), writes xn[nx*num_traj] and, if not NULL,
+ * S_forw[nx*(nx+nu)*num_traj]. Returns the first nonzero status of the workers. */
+int sim_solve_batch(sim_batch *batch, int num_traj, double *x0, double *u, double *p,
+                    double *xn, double *S_forw);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -65,6 +65,7 @@ classdef acados_ocp_opts < handle
             obj.opts_struct.nlp_solver_tol_comp = 1e-6;
             obj.opts_struct.nlp_solver_ext_qp_res = 0; % compute QP residuals at each NLP iteration
             obj.opts_struct.nlp_solver_step_length = 1.0; % fixed step length in SQP algorithm
+            obj.opts_struct.globalization = 'fixed_step'; % fixed_step, merit_backtracking, filter_line_search
             obj.opts_struct.rti_phase = 0; % RTI phase: (1) preparation, (2) feedback, (0) both
             obj.opts_struct.qp_solver = 'partial_condensing_hpipm';
             obj.opts_struct.qp_solver_iter_max = 50;
@@ -140,6 +141,8 @@ classdef acados_ocp_opts < handle
                 obj.opts_struct.nlp_solver_ext_qp_res = value;
             elseif (strcmp(field, 'nlp_solver_step_length'))
                 obj.opts_struct.nlp_solver_step_length = value;
+            elseif (strcmp(field, 'globalization'))
+                obj.opts_struct.globalization = value;
             elseif (strcmp(field, 'rti_phase'))
                 obj.opts_struct.rti_phase = value;
             elseif (strcmp(field, 'nlp_solver_warm_start_first_qp'))
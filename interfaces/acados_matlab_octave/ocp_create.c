@@ -330,6 +330,10 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
     {
         plan->ocp_qp_solver_plan.qp_solver = FULL_CONDENSING_HPIPM;
     }
+    else if (!strcmp(qp_solver, "partial_condensing_pdas"))
+    {
+        plan->ocp_qp_solver_plan.qp_solver = PARTIAL_CONDENSING_PDAS;
+    }
 #if defined(ACADOS_WITH_QPOASES)
     else if (!strcmp(qp_solver, "full_condensing_qpoases"))
     {
@@ -351,7 +355,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
     else
     {
         MEX_FIELD_VALUE_NOT_SUPPORTED_SUGGEST(fun_name, "qp_solver", qp_solver,
-             "partial_condensing_hpipm, full_condensing_hpipm, full_condensing_qpoases, partial_condensing_osqp, partial_condensing_hpmpc");
+             "partial_condensing_hpipm, full_condensing_hpipm, full_condensing_qpoases, partial_condensing_osqp, partial_condensing_hpmpc, partial_condensing_pdas");
     }
 
 
@@ -777,6 +781,12 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
         double nlp_solver_step_length = mxGetScalar( mxGetField( matlab_opts, 0, "nlp_solver_step_length" ) );
         ocp_nlp_solver_opts_set(config, opts, "step_length", &nlp_solver_step_length);
     }
+    // nlp solver globalization
+    if (mxGetField( matlab_opts, 0, "globalization" )!=NULL)
+    {
+        char *globalization = mxArrayToString( mxGetField( matlab_opts, 0, "globalization" ) );
+        ocp_nlp_solver_opts_set(config, opts, "globalization", globalization);
+    }
     // RTI phase
     if (mxGetField( matlab_opts, 0, "rti_phase" )!=NULL)
     {
@@ -832,6 +842,10 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
         {
             ocp_nlp_solver_opts_set(config, opts, "qp_cond_N", &qp_solver_cond_N);
         }
+        else if ( plan->ocp_qp_solver_plan.qp_solver == PARTIAL_CONDENSING_PDAS )
+        {
+            ocp_nlp_solver_opts_set(config, opts, "qp_cond_N", &qp_solver_cond_N);
+        }
         #if defined( ACADOS_WITH_HPMPC )
         else if ( plan->ocp_qp_solver_plan.qp_solver == PARTIAL_CONDENSING_HPMPC )
         {
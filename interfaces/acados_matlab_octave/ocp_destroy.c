@@ -85,13 +85,14 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
 
 
     /* free memory */
+    // the solver first, it may still use config, in, out and opts
+    ocp_nlp_solver_destroy(solver);
     ocp_nlp_plan_destroy(plan);
     ocp_nlp_config_destroy(config);
     ocp_nlp_dims_destroy(dims);
     ocp_nlp_solver_opts_destroy(opts);
     ocp_nlp_in_destroy(in);
     ocp_nlp_out_destroy(out);
-    ocp_nlp_solver_destroy(solver);
     ocp_nlp_out_destroy(sens_out);
 
 
@@ -1724,6 +1724,12 @@ class AcadosOcpOptions:
         self.__nlp_solver_type  = 'SQP_RTI'                   # NLP solver
         self.__nlp_solver_step_length = 1.0                   # fixed Newton step length
         self.__levenberg_marquardt = 0.0
+        self.__globalization = 'FIXED_STEP'                   # globalization strategy of the SQP method
+        self.__alpha_min = 0.05                               # minimum step length in merit backtracking
+        self.__alpha_reduction = 0.7                          # step length reduction factor in merit backtracking
+        self.__line_search_use_sufficient_descent = 1         # Armijo condition in merit backtracking
+        self.__eps_sufficient_descent = 1e-4                  # Armijo constant in merit backtracking
+        self.__globalization_use_SOC = 0                      # second-order correction in merit backtracking
         self.__sim_method_num_stages  = 4                     # number of stages in the integrator
         self.__sim_method_num_steps   = 1                     # number of steps in the integrator
         self.__sim_method_newton_iter = 3                     # number of Newton iterations in simulation method
@@ -1734,6 +1740,7 @@ class AcadosOcpOptions:
         self.__qp_solver_tol_comp = None                      # QP solver complementarity
         self.__qp_solver_iter_max = 50                        # QP solver max iter
         self.__qp_solver_cond_N = None                        # QP solver: new horizon after partial condensing
+        self.__qp_solver_cond_N_auto = 0                      # QP solver: automatic choice of the horizon after partial condensing
         self.__nlp_solver_tol_stat = 1e-6                     # NLP solver stationarity tolerance
         self.__nlp_solver_tol_eq   = 1e-6                     # NLP solver equality tolerance
         self.__nlp_solver_tol_ineq = 1e-6                     # NLP solver inequality
@@ -1788,6 +1795,37 @@ class AcadosOcpOptions:
         """Factor for LM regularization"""
         return self.__levenberg_marquardt
 
+    @property
+    def globalization(self):
+        """Globalization strategy of the SQP method: 'FIXED_STEP', 'MERIT_BACKTRACKING' or
+        'FILTER_LINE_SEARCH' (SQP only)"""
+        return self.__globalization
+
+    @property
+    def alpha_min(self):
+        """Minimum step length in merit backtracking line search"""
+        return self.__alpha_min
+
+    @property
+    def alpha_reduction(self):
+        """Step length reduction factor in merit backtracking line search"""
+        return self.__alpha_reduction
+
+    @property
+    def line_search_use_sufficient_descent(self):
+        """Use Armijo condition (1) or simple decrease (0) in merit backtracking line search"""
+        return self.__line_search_use_sufficient_descent
+
+    @property
+    def eps_sufficient_descent(self):
+        """Constant in the Armijo condition of the merit backtracking line search"""
+        return self.__eps_sufficient_descent
+
+    @property
+    def globalization_use_SOC(self):
+        """Try a second-order correction when the full step is rejected by the line search"""
+        return self.__globalization_use_SOC
+
     @property
     def sim_method_num_stages(self):
         """Number of stages in the integrator"""
@@ -1833,6 +1871,16 @@ class AcadosOcpOptions:
         """QP solver: New horizon after partial condensing"""
         return self.__qp_solver_cond_N
 
+    @property
+    def qp_solver_cond_N_auto(self):
+        """QP solver: Automatic choice of the horizon after partial condensing.
+        0: use qp_solver_cond_N,
+        1: choose it with a cost model based on the dimensions,
+        2: time the best candidates of the cost model during the first QP solves and keep the fastest.
+        Default: 0
+        """
+        return self.__qp_solver_cond_N_auto
+
     @property
     def qp_solver_iter_max(self):
         """QP solver: maximum number of iterations"""
@@ -2043,6 +2091,53 @@ class AcadosOcpOptions:
         else:
             raise Exception('Invalid levenberg_marquardt value. levenberg_marquardt must be a positive float. Exiting')
 
+    @globalization.setter
+    def globalization(self, globalization):
+        globalization_types = ('FIXED_STEP', 'MERIT_BACKTRACKING', 'FILTER_LINE_SEARCH')
+
+        if globalization in globalization_types:
+            self.__globalization = globalization
+        else:
+            raise Exception('Invalid globalization value. Possible values are:\n\n' \
+                    + ',\n'.join(globalization_types) + '.\n\nYou have: ' + globalization + '.\n\nExiting.')
+
+    @alpha_min.setter
+    def alpha_min(self, alpha_min):
+        if isinstance(alpha_min, float) and alpha_min > 0:
+            self.__alpha_min = alpha_min
+        else:
+            raise Exception('Invalid alpha_min value. alpha_min must be a positive float. Exiting')
+
+    @alpha_reduction.setter
+    def alpha_reduction(self, alpha_reduction):
+        if isinstance(alpha_reduction, float) and alpha_reduction > 0 and alpha_reduction < 1:
+            self.__alpha_reduction = alpha_reduction
+        else:
+            raise Exception('Invalid alpha_reduction value. alpha_reduction must be a float in (0, 1). Exiting')
+
+    @line_search_use_sufficient_descent.setter
+    def line_search_use_sufficient_descent(self, line_search_use_sufficient_descent):
+        if line_search_use_sufficient_descent in [0, 1]:
+            self.__line_search_use_sufficient_descent = line_search_use_sufficient_descent
+        else:
+            raise Exception('Invalid value for line_search_use_sufficient_descent. Possible values are 0, 1, got ' \
+                    + str(line_search_use_sufficient_descent))
+
+    @eps_sufficient_descent.setter
+    def eps_sufficient_descent(self, eps_sufficient_descent):
+        if isinstance(eps_sufficient_descent, float) and eps_sufficient_descent > 0 and eps_sufficient_descent < 1:
+            self.__eps_sufficient_descent = eps_sufficient_descent
+        else:
+            raise Exception('Invalid eps_sufficient_descent value. eps_sufficient_descent must be a float in (0, 1). Exiting')
+
+    @globalization_use_SOC.setter
+    def globalization_use_SOC(self, globalization_use_SOC):
+        if globalization_use_SOC in [0, 1]:
+            self.__globalization_use_SOC = globalization_use_SOC
+        else:
+            raise Exception('Invalid value for globalization_use_SOC. Possible values are 0, 1, got ' \
+                    + str(globalization_use_SOC))
+
     @qp_solver_tol_stat.setter
     def qp_solver_tol_stat(self, qp_solver_tol_stat):
 
@@ -2067,6 +2162,14 @@ class AcadosOcpOptions:
         else:
             raise Exception('Invalid qp_solver_cond_N value. qp_solver_cond_N must be a positive int. Exiting')
 
+    @qp_solver_cond_N_auto.setter
+    def qp_solver_cond_N_auto(self, qp_solver_cond_N_auto):
+
+        if qp_solver_cond_N_auto in [0, 1, 2]:
+            self.__qp_solver_cond_N_auto = qp_solver_cond_N_auto
+        else:
+            raise Exception('Invalid qp_solver_cond_N_auto value. qp_solver_cond_N_auto must be in [0, 1, 2]. Exiting')
+
     @qp_solver_tol_eq.setter
     def qp_solver_tol_eq(self, qp_solver_tol_eq):
 
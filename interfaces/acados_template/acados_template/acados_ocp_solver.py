@@ -999,6 +999,114 @@ class AcadosOcpSolver:
         return
 
 
+    def _all_stages_dims(self, field_):
+        """
+        per-stage dimensions of field_ for the bulk setters/getters, cached by field
+        """
+        if not hasattr(self, '_all_stages_dims_cache'):
+            self._all_stages_dims_cache = dict()
+
+        if field_ not in self._all_stages_dims_cache:
+            self.shared_lib.ocp_nlp_dims_get_from_attr.argtypes = \
+                [c_void_p, c_void_p, c_void_p, c_int, c_char_p]
+            self.shared_lib.ocp_nlp_dims_get_from_attr.restype = c_int
+
+            N = self.N - 1 if field_ == 'pi' else self.N
+            self._all_stages_dims_cache[field_] = [
+                self.shared_lib.ocp_nlp_dims_get_from_attr(self.nlp_config, \
+                    self.nlp_dims, self.nlp_out, stage, field_.encode('utf-8')) \
+                for stage in range(N+1)]
+
+        return self._all_stages_dims_cache[field_]
+
+
+    def set_all_stages(self, field_, value_):
+        """
+        set numerical data on all shooting nodes with a single call:
+            :param field_: string in ['yref', 'lbx', 'ubx', 'lbu', 'ubu', 'lg', 'ug', 'zl', 'zu', 'Zl', 'Zu',
+                'x', 'u', 'pi', 'lam', 't', 'p']
+            :param value_: array with one row per shooting node (N for pi, N+1 otherwise),
+                or the stage-major concatenation of these rows if the dimension varies along the horizon
+        """
+        cost_fields = ['y_ref', 'yref', 'zl', 'zu', 'Zl', 'Zu']
+        constraints_fields = ['lbx', 'ubx', 'lbu', 'ubu', 'lg', 'ug']
+        out_fields = ['x', 'u', 'pi', 'lam', 't']
+
+        if field_ not in cost_fields + constraints_fields + out_fields + ['p']:
+            raise Exception("AcadosOcpSolver.set_all_stages(): {} is not a valid argument.\
+                \nPossible values are {}. Exiting.".format(field_, \
+                cost_fields + constraints_fields + out_fields + ['p']))
+
+        # cast value_ to avoid conversion issues, bulk data is passed stage-major
+        value_ = np.ascontiguousarray(value_, dtype=np.float64).ravel()
+        value_data = cast(value_.ctypes.data, POINTER(c_double))
+
+        if field_ == 'p':
+            np_ = self.acados_ocp.dims.np
+            if value_.shape[0] != (self.N+1) * np_:
+                raise Exception('AcadosOcpSolver.set_all_stages(): mismatching dimension for field "p" ' \
+                    'with dimension {} (you have {})'.format((self.N+1) * np_, value_.shape[0]))
+            self.shared_lib.acados_update_params_all.argtypes = [POINTER(c_double), c_int]
+            self.shared_lib.acados_update_params_all.restype = c_int
+            self.shared_lib.acados_update_params_all(value_data, np_)
+            return
+
+        total = sum(self._all_stages_dims(field_))
+        if value_.shape[0] != total:
+            raise Exception('AcadosOcpSolver.set_all_stages(): mismatching dimension for field "{}" ' \
+                'with dimension {} (you have {})'.format(field_, total, value_.shape[0]))
+
+        field = field_.encode('utf-8')
+        value_data_p = cast((value_data), c_void_p)
+
+        if field_ in cost_fields:
+            fun = self.shared_lib.ocp_nlp_cost_model_set_all_stages
+            handle = self.nlp_in
+        elif field_ in constraints_fields:
+            fun = self.shared_lib.ocp_nlp_constraints_model_set_all_stages
+            handle = self.nlp_in
+        else:
+            fun = self.shared_lib.ocp_nlp_out_set_all
+            handle = self.nlp_out
+
+        fun.argtypes = [c_void_p, c_void_p, c_void_p, c_char_p, c_void_p]
+        fun.restype = c_int
+        fun(self.nlp_config, self.nlp_dims, handle, field, value_data_p)
+
+        return
+
+
+    def get_all_stages(self, field_):
+        """
+        get the last solution of the solver on all shooting nodes with a single call:
+            :param field_: string in ['x', 'u', 'z', 'pi', 'lam', 't']
+
+            returns an array with one row per shooting node (N for pi, N+1 otherwise),
+            or the stage-major concatenation of these rows if the dimension varies along the horizon
+        """
+        out_fields = ['x', 'u', 'z', 'pi', 'lam', 't']
+
+        if field_ not in out_fields:
+            raise Exception('AcadosOcpSolver.get_all_stages(): {} is an invalid argument.\
+                    \n Possible values are {}. Exiting.'.format(field_, out_fields))
+
+        stage_dims = self._all_stages_dims(field_)
+
+        out = np.ascontiguousarray(np.zeros((sum(stage_dims),)), dtype=np.float64)
+        out_data = cast(out.ctypes.data, POINTER(c_double))
+
+        self.shared_lib.ocp_nlp_out_get_all.argtypes = \
+            [c_void_p, c_void_p, c_void_p, c_char_p, c_void_p]
+        self.shared_lib.ocp_nlp_out_get_all.restype = c_int
+        self.shared_lib.ocp_nlp_out_get_all(self.nlp_config, \
+            self.nlp_dims, self.nlp_out, field_.encode('utf-8'), out_data)
+
+        if len(set(stage_dims)) == 1:
+            out = out.reshape((len(stage_dims), stage_dims[0]))
+
+        return out
+
+
     def options_set(self, field_, value_):
         """
         set options of the solver:
@@ -1006,8 +1114,8 @@ class AcadosOcpSolver:
             :param field_: string, e.g. 'print_level', 'rti_phase', 'initialize_t_slacks', 'step_length'
             :param value_: of type int, float
         """
-        int_fields = ['print_level', 'rti_phase', 'initialize_t_slacks']
-        double_fields = ['step_length']
+        int_fields = ['print_level', 'rti_phase', 'initialize_t_slacks', 'line_search_use_sufficient_descent', 'globalization_use_SOC']
+        double_fields = ['step_length', 'alpha_min', 'alpha_reduction', 'eps_sufficient_descent']
         string_fields = ['globalization']
 
         if field_ in int_fields:
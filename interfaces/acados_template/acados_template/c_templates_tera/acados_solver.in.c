@@ -1474,6 +1474,36 @@ int acados_create()
     double levenberg_marquardt = {{ solver_options.levenberg_marquardt }};
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "levenberg_marquardt", &levenberg_marquardt);
 
+{%- if solver_options.globalization == "MERIT_BACKTRACKING" %}
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "globalization", "merit_backtracking");
+
+    double alpha_min = {{ solver_options.alpha_min }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "alpha_min", &alpha_min);
+
+    double alpha_reduction = {{ solver_options.alpha_reduction }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "alpha_reduction", &alpha_reduction);
+
+    int line_search_use_sufficient_descent = {{ solver_options.line_search_use_sufficient_descent }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "line_search_use_sufficient_descent", &line_search_use_sufficient_descent);
+
+    double eps_sufficient_descent = {{ solver_options.eps_sufficient_descent }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "eps_sufficient_descent", &eps_sufficient_descent);
+
+    int globalization_use_SOC = {{ solver_options.globalization_use_SOC }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "globalization_use_SOC", &globalization_use_SOC);
+{%- elif solver_options.globalization == "FILTER_LINE_SEARCH" %}
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "globalization", "filter_line_search");
+
+    double alpha_min = {{ solver_options.alpha_min }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "alpha_min", &alpha_min);
+
+    double alpha_reduction = {{ solver_options.alpha_reduction }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "alpha_reduction", &alpha_reduction);
+
+    double eps_sufficient_descent = {{ solver_options.eps_sufficient_descent }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "eps_sufficient_descent", &eps_sufficient_descent);
+{%- endif %}
+
     /* options QP solver */
 {%- if solver_options.qp_solver is starting_with("PARTIAL_CONDENSING") %}
     int qp_solver_cond_N;
@@ -1485,6 +1515,11 @@ int acados_create()
     qp_solver_cond_N = N;
     {%- endif %}
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "qp_cond_N", &qp_solver_cond_N);
+
+    {%- if solver_options.qp_solver_cond_N_auto %}
+    int qp_solver_cond_N_auto = {{ solver_options.qp_solver_cond_N_auto }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "qp_cond_N_auto", &qp_solver_cond_N_auto);
+    {%- endif %}
 {% endif %}
 
     int qp_solver_iter_max = {{ solver_options.qp_solver_iter_max }};
@@ -1780,6 +1815,51 @@ int acados_update_params(int stage, double *p, int np)
 
 
 
+int acados_update_params_all(double *p, int np)
+{
+    // p is stage-major, np parameters for each of the stages 0, ..., N
+    int solver_status = 0;
+
+    for (int stage = 0; stage <= {{ dims.N }}; stage++)
+    {
+        solver_status = acados_update_params(stage, p + stage*np, np);
+        if (solver_status)
+            break;
+    }
+
+    return solver_status;
+}
+
+
+
+int acados_cost_set_all_stages(const char *field, double *value)
+{
+    return ocp_nlp_cost_model_set_all_stages(nlp_config, nlp_dims, nlp_in, field, value);
+}
+
+
+
+int acados_constraints_set_all_stages(const char *field, double *value)
+{
+    return ocp_nlp_constraints_model_set_all_stages(nlp_config, nlp_dims, nlp_in, field, value);
+}
+
+
+
+int acados_out_set_all(const char *field, double *value)
+{
+    return ocp_nlp_out_set_all(nlp_config, nlp_dims, nlp_out, field, value);
+}
+
+
+
+int acados_out_get_all(const char *field, double *value)
+{
+    return ocp_nlp_out_get_all(nlp_config, nlp_dims, nlp_out, field, value);
+}
+
+
+
 int acados_solve()
 {
     // solve NLP 
@@ -1791,11 +1871,11 @@ int acados_solve()
 
 int acados_free()
 {
-    // free memory
+    // free memory, the solver first as it may still use in, out and opts
+    ocp_nlp_solver_destroy(nlp_solver);
     ocp_nlp_solver_opts_destroy(nlp_opts);
     ocp_nlp_in_destroy(nlp_in);
     ocp_nlp_out_destroy(nlp_out);
-    ocp_nlp_solver_destroy(nlp_solver);
     ocp_nlp_dims_destroy(nlp_dims);
     ocp_nlp_config_destroy(nlp_config);
     ocp_nlp_plan_destroy(nlp_solver_plan);
@@ -43,6 +43,11 @@ extern "C" {
 
 int acados_create();
 int acados_update_params(int stage, double *value, int np);
+int acados_update_params_all(double *value, int np);
+int acados_cost_set_all_stages(const char *field, double *value);
+int acados_constraints_set_all_stages(const char *field, double *value);
+int acados_out_set_all(const char *field, double *value);
+int acados_out_get_all(const char *field, double *value);
 int acados_solve();
 int acados_free();
 void acados_print_stats();
@@ -35,6 +35,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <cmath>
 #include <cstdlib>
 
 #include "test/test_utils/eigen.h"
@@ -759,13 +760,213 @@ void read_final_state(const int nx, const int num_free_masses, double *xN)
 // BROKEN & removed since external function convention changed, input is x, u now.
 
 
+// additional checks on the solved problem
+typedef void (*chain_check_fun)(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
+                                ocp_nlp_out *nlp_out, ocp_nlp_solver *solver);
+
+
+
+// set/get round-trip through field handles on the in, constraints and out modules
+static void check_field_handles(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
+                                ocp_nlp_out *nlp_out, ocp_nlp_solver *solver)
+{
+    int N = dims->N;
+
+    // out: the handle reads and writes the same data as ocp_nlp_out_get
+    ocp_nlp_field_handle *x_handle =
+        ocp_nlp_field_handle_create(config, dims, nlp_in, nlp_out, "out", 0, N, "x");
+    for (int stage = 0; stage <= N; stage++)
+    {
+        int size = ocp_nlp_field_handle_get_size(x_handle, stage);
+        REQUIRE(size == dims->nx[stage]);
+
+        std::vector<double> x_handle_val(size), x_out_val(size);
+        ocp_nlp_get_by_handle(x_handle, stage, x_handle_val.data());
+        ocp_nlp_out_get(config, dims, nlp_out, stage, "x", x_out_val.data());
+        REQUIRE(x_handle_val == x_out_val);
+
+        for (int ii = 0; ii < size; ii++)
+            x_handle_val[ii] += 1.0 + stage;
+        ocp_nlp_set_by_handle(x_handle, stage, x_handle_val.data());
+        ocp_nlp_out_get(config, dims, nlp_out, stage, "x", x_out_val.data());
+        REQUIRE(x_handle_val == x_out_val);
+    }
+    ocp_nlp_field_handle_destroy(x_handle);
+
+    // constraints: lbx on the intermediate stages
+    ocp_nlp_field_handle *lbx_handle =
+        ocp_nlp_field_handle_create(config, dims, nlp_in, nlp_out, "constraints", 1, N-1, "lbx");
+    for (int stage = 1; stage < N; stage++)
+    {
+        int size = ocp_nlp_field_handle_get_size(lbx_handle, stage);
+        std::vector<double> lbx_set(size), lbx_get(size);
+        for (int ii = 0; ii < size; ii++)
+            lbx_set[ii] = -10.0 - ii - stage;
+        ocp_nlp_set_by_handle(lbx_handle, stage, lbx_set.data());
+        ocp_nlp_get_by_handle(lbx_handle, stage, lbx_get.data());
+        REQUIRE(lbx_set == lbx_get);
+    }
+    ocp_nlp_field_handle_destroy(lbx_handle);
+
+    // in: Ts
+    ocp_nlp_field_handle *Ts_handle =
+        ocp_nlp_field_handle_create(config, dims, nlp_in, nlp_out, "in", 0, N-1, "Ts");
+    for (int stage = 0; stage < N; stage++)
+    {
+        REQUIRE(ocp_nlp_field_handle_get_size(Ts_handle, stage) == 1);
+        double Ts_set = 0.1 * (stage + 1);
+        double Ts_get;
+        ocp_nlp_set_by_handle(Ts_handle, stage, &Ts_set);
+        ocp_nlp_get_by_handle(Ts_handle, stage, &Ts_get);
+        REQUIRE(Ts_get == Ts_set);
+        REQUIRE(nlp_in->Ts[stage] == Ts_set);
+    }
+    ocp_nlp_field_handle_destroy(Ts_handle);
+}
+
+
+
+// all-stage setters and getters agree with the per-stage ones
+static void check_bulk_set_get(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
+                               ocp_nlp_out *nlp_out, ocp_nlp_solver *solver)
+{
+    int N = dims->N;
+
+    // out: x on stages 0, ..., N
+    int nx_all = 0;
+    for (int stage = 0; stage <= N; stage++)
+        nx_all += dims->nx[stage];
+
+    std::vector<double> x_all(nx_all);
+    REQUIRE(ocp_nlp_out_get_all(config, dims, nlp_out, "x", x_all.data()) == nx_all);
+    for (int ii = 0; ii < nx_all; ii++)
+        x_all[ii] += 0.5 * ii;
+    REQUIRE(ocp_nlp_out_set_all(config, dims, nlp_out, "x", x_all.data()) == nx_all);
+
+    int idx = 0;
+    for (int stage = 0; stage <= N; stage++)
+    {
+        std::vector<double> x_stage(dims->nx[stage]);
+        ocp_nlp_out_get(config, dims, nlp_out, stage, "x", x_stage.data());
+        for (int ii = 0; ii < dims->nx[stage]; ii++)
+            REQUIRE(x_stage[ii] == x_all[idx + ii]);
+        idx += dims->nx[stage];
+    }
+
+    // out: pi on stages 0, ..., N-1
+    int npi_all = 0;
+    for (int stage = 0; stage < N; stage++)
+        npi_all += dims->nx[stage+1];
+
+    std::vector<double> pi_all(npi_all);
+    REQUIRE(ocp_nlp_out_get_all(config, dims, nlp_out, "pi", pi_all.data()) == npi_all);
+
+    idx = 0;
+    for (int stage = 0; stage < N; stage++)
+    {
+        std::vector<double> pi_stage(dims->nx[stage+1]);
+        ocp_nlp_out_get(config, dims, nlp_out, stage, "pi", pi_stage.data());
+        for (int ii = 0; ii < dims->nx[stage+1]; ii++)
+            REQUIRE(pi_stage[ii] == pi_all[idx + ii]);
+        idx += dims->nx[stage+1];
+    }
+
+    // constraints: lbx, read back through a field handle
+    ocp_nlp_field_handle *lbx_handle =
+        ocp_nlp_field_handle_create(config, dims, nlp_in, nlp_out, "constraints", 0, N, "lbx");
+
+    int nlbx_all = 0;
+    for (int stage = 0; stage <= N; stage++)
+        nlbx_all += ocp_nlp_field_handle_get_size(lbx_handle, stage);
+
+    std::vector<double> lbx_all(nlbx_all);
+    for (int ii = 0; ii < nlbx_all; ii++)
+        lbx_all[ii] = -1.0 - ii;
+    REQUIRE(ocp_nlp_constraints_model_set_all_stages(config, dims, nlp_in, "lbx",
+                                                     lbx_all.data()) == nlbx_all);
+
+    idx = 0;
+    for (int stage = 0; stage <= N; stage++)
+    {
+        int size = ocp_nlp_field_handle_get_size(lbx_handle, stage);
+        std::vector<double> lbx_stage(size);
+        ocp_nlp_get_by_handle(lbx_handle, stage, lbx_stage.data());
+        for (int ii = 0; ii < size; ii++)
+            REQUIRE(lbx_stage[ii] == lbx_all[idx + ii]);
+        idx += size;
+    }
+    ocp_nlp_field_handle_destroy(lbx_handle);
+}
+
+
+
+// batched parametric sensitivities agree with one ocp_nlp_eval_param_sens call per direction
+static void check_param_sens_batch(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
+                                   ocp_nlp_out *nlp_out, ocp_nlp_solver *solver)
+{
+    int N = dims->N;
+    int *nv = dims->nv;
+    int *nx = dims->nx;
+    int *ni = dims->ni;
+
+    int n_dir = nx[0];
+    std::vector<int> index(n_dir);
+    for (int k = 0; k < n_dir; k++)
+        index[k] = k;
+
+    int rows = ocp_nlp_param_sens_rows(dims);
+    int ld_sens = rows + 2;  // padded leading dimension
+    std::vector<double> sens_batch(ld_sens * n_dir, 0.0);
+    ocp_nlp_eval_param_sens_batch(solver, (char *) "ex", 0, n_dir, index.data(),
+                                  sens_batch.data(), ld_sens);
+
+    ocp_nlp_out *sens_nlp_out = ocp_nlp_out_create(config, dims);
+    std::vector<double> sens_single(rows);
+
+    for (int k = 0; k < n_dir; k++)
+    {
+        ocp_nlp_eval_param_sens(solver, (char *) "ex", 0, index[k], sens_nlp_out);
+
+        // same layout as the batch columns: ux, pi, lam of all stages
+        double *ptr = sens_single.data();
+        for (int i = 0; i <= N; i++)
+        {
+            blasfeo_unpack_dvec(nv[i], sens_nlp_out->ux + i, 0, ptr);
+            ptr += nv[i];
+        }
+        for (int i = 0; i < N; i++)
+        {
+            blasfeo_unpack_dvec(nx[i+1], sens_nlp_out->pi + i, 0, ptr);
+            ptr += nx[i+1];
+        }
+        for (int i = 0; i <= N; i++)
+        {
+            blasfeo_unpack_dvec(2 * ni[i], sens_nlp_out->lam + i, 0, ptr);
+            ptr += 2 * ni[i];
+        }
+
+        for (int ii = 0; ii < rows; ii++)
+            REQUIRE(sens_batch[k * ld_sens + ii] == Approx(sens_single[ii]).margin(1e-10));
+    }
+
+    ocp_nlp_out_destroy(sens_nlp_out);
+}
+
+
+
 void setup_and_solve_nlp(int NN,
     int NMF,
     std::string const& con_str,
     std::string const& cost_str,
     std::string const& qp_solver_str,
     std::string const& model_str,
-    std::string const& integrator_str
+    std::string const& integrator_str,
+    std::string const& globalization_str = "fixed_step",
+    int globalization_use_SOC = 0,
+    int num_threads = 0,  // 0: default of the solver
+    std::string const& thread_schedule = "",  // empty: default of the solver
+    std::vector<double> *ux_sol = NULL,
+    chain_check_fun check = NULL
     )
 {
     /************************************************
@@ -1411,6 +1612,20 @@ void setup_and_solve_nlp(int NN,
     ocp_nlp_solver_opts_set(config, nlp_opts, "tol_ineq", &tol_ineq);
     ocp_nlp_solver_opts_set(config, nlp_opts, "tol_comp", &tol_comp);
 
+    if (globalization_str != "fixed_step")
+    {
+        ocp_nlp_solver_opts_set(config, nlp_opts, "globalization",
+                                (void *) globalization_str.c_str());
+        ocp_nlp_solver_opts_set(config, nlp_opts, "globalization_use_SOC",
+                                &globalization_use_SOC);
+    }
+
+    if (num_threads > 0)
+        ocp_nlp_solver_opts_set(config, nlp_opts, "num_threads", &num_threads);
+    if (!thread_schedule.empty())
+        ocp_nlp_solver_opts_set(config, nlp_opts, "thread_schedule",
+                                (void *) thread_schedule.c_str());
+
     /************************************************
     * ocp_nlp out
     ************************************************/
@@ -1437,10 +1652,12 @@ void setup_and_solve_nlp(int NN,
     status = ocp_nlp_solve(solver, nlp_in, nlp_out);
 
     double max_res = 0.0;
-    double inf_norm_res_g = ((ocp_nlp_sqp_memory *)solver->mem)->nlp_res->inf_norm_res_g;
-    double inf_norm_res_b = ((ocp_nlp_sqp_memory *)solver->mem)->nlp_res->inf_norm_res_b;
-    double inf_norm_res_d = ((ocp_nlp_sqp_memory *)solver->mem)->nlp_res->inf_norm_res_d;
-    double inf_norm_res_m = ((ocp_nlp_sqp_memory *)solver->mem)->nlp_res->inf_norm_res_m;
+    ocp_nlp_res *nlp_res;
+    ocp_nlp_get(config, solver, "nlp_res", &nlp_res);
+    double inf_norm_res_g = nlp_res->inf_norm_res_g;
+    double inf_norm_res_b = nlp_res->inf_norm_res_b;
+    double inf_norm_res_d = nlp_res->inf_norm_res_d;
+    double inf_norm_res_m = nlp_res->inf_norm_res_m;
     max_res = (inf_norm_res_g > max_res) ? inf_norm_res_g : max_res;
     max_res = (inf_norm_res_b > max_res) ? inf_norm_res_b : max_res;
     max_res = (inf_norm_res_d > max_res) ? inf_norm_res_d : max_res;
@@ -1450,6 +1667,20 @@ void setup_and_solve_nlp(int NN,
     REQUIRE(status == 0);
     REQUIRE(max_res <= TOL);
 
+    if (ux_sol != NULL)
+    {
+        ux_sol->clear();
+        for (int i = 0; i <= NN; i++)
+        {
+            std::vector<double> ux_i(nu[i] + nx[i]);
+            blasfeo_unpack_dvec(nu[i] + nx[i], nlp_out->ux+i, 0, ux_i.data());
+            ux_sol->insert(ux_sol->end(), ux_i.begin(), ux_i.end());
+        }
+    }
+
+    if (check != NULL)
+        check(config, dims, nlp_in, nlp_out, solver);
+
     /************************************************
     * free memory
     ************************************************/
@@ -1631,3 +1862,252 @@ TEST_CASE("chain example", "[NLP solver]")
         }  // horizon lenght
     }
 }  // TEST_CASE
+
+
+
+/************************************************
+* TEST CASE: nonlinear chain, merit backtracking
+************************************************/
+
+TEST_CASE("chain example merit backtracking", "[NLP solver]")
+{
+    std::vector<int> num_masses = {2, 3, 4};
+    std::vector<std::string> cons = {"BOX", "GENERAL"};
+    std::vector<int> use_SOC = {0, 1};
+
+    for (int NMF : num_masses)
+    {
+        SECTION("Number of masses: " + std::to_string(NMF))
+        {
+            for (std::string con_str : cons)
+            {
+                SECTION("Type of constraints: " + con_str)
+                {
+                    for (int soc : use_SOC)
+                    {
+                        SECTION("Second-order correction: " + std::to_string(soc))
+                        {
+                            setup_and_solve_nlp(20, NMF, con_str, "MIXED", "SPARSE_HPIPM",
+                                                "MIXED", "MIXED", "merit_backtracking", soc);
+                        }  // second-order correction
+                    }
+                }  // type of constraints
+            }
+        }  // number of masses
+    }
+}  // TEST_CASE
+
+
+
+/************************************************
+* TEST CASE: nonlinear chain, filter line search
+************************************************/
+
+TEST_CASE("chain example filter line search", "[NLP solver]")
+{
+    std::vector<int> num_masses = {2, 3, 4};
+    std::vector<std::string> cons = {"BOX", "GENERAL"};
+    std::vector<std::string> models = {"DISCRETE", "CONTINUOUS", "MIXED"};
+
+    for (int NMF : num_masses)
+    {
+        SECTION("Number of masses: " + std::to_string(NMF))
+        {
+            for (std::string con_str : cons)
+            {
+                SECTION("Type of constraints: " + con_str)
+                {
+                    for (std::string model_str : models)
+                    {
+                        SECTION("Type of model: " + model_str)
+                        {
+                            setup_and_solve_nlp(20, NMF, con_str, "MIXED", "SPARSE_HPIPM",
+                                                model_str, "MIXED", "filter_line_search");
+                        }  // type of model
+                    }
+                }  // type of constraints
+            }
+        }  // number of masses
+    }
+}  // TEST_CASE
+
+
+
+/************************************************
+* TEST CASE: nonlinear chain, parallel stages
+************************************************/
+
+TEST_CASE("chain example parallel stages", "[NLP solver]")
+{
+    std::vector<int> num_masses = {2, 3, 4};
+    std::vector<std::string> models = {"DISCRETE", "CONTINUOUS"};
+    std::vector<std::string> schedules = {"static", "lpt", "dynamic"};
+
+    for (int NMF : num_masses)
+    {
+        SECTION("Number of masses: " + std::to_string(NMF))
+        {
+            for (std::string model_str : models)
+            {
+                SECTION("Type of model: " + model_str)
+                {
+                    for (std::string schedule_str : schedules)
+                    {
+                        SECTION("Thread schedule: " + schedule_str)
+                        {
+                            std::vector<double> ux_serial, ux_parallel;
+
+                            setup_and_solve_nlp(20, NMF, "BOX", "MIXED", "SPARSE_HPIPM",
+                                model_str, "MIXED", "fixed_step", 0, 1, "", &ux_serial);
+                            setup_and_solve_nlp(20, NMF, "BOX", "MIXED", "SPARSE_HPIPM",
+                                model_str, "MIXED", "fixed_step", 0, 4, schedule_str,
+                                &ux_parallel);
+
+                            REQUIRE(ux_serial.size() == ux_parallel.size());
+                            for (size_t ii = 0; ii < ux_serial.size(); ii++)
+                                REQUIRE(std::abs(ux_serial[ii] - ux_parallel[ii]) <= 1e-10);
+                        }  // thread schedule
+                    }
+                }  // type of model
+            }
+        }  // number of masses
+    }
+}  // TEST_CASE
+
+
+
+
+/************************************************
+* TEST CASE: nonlinear chain, field handles
+************************************************/
+
+TEST_CASE("chain example field handles", "[NLP solver]")
+{
+    std::vector<std::string> cons = {"BOX", "GENERAL"};
+
+    for (std::string con_str : cons)
+    {
+        SECTION("Type of constraints: " + con_str)
+        {
+            setup_and_solve_nlp(20, 3, con_str, "MIXED", "SPARSE_HPIPM", "MIXED", "MIXED",
+                                "fixed_step", 0, 0, "", NULL, &check_field_handles);
+        }  // type of constraints
+    }
+}  // TEST_CASE
+
+
+
+/************************************************
+* TEST CASE: nonlinear chain, batched sensitivities
+************************************************/
+
+TEST_CASE("chain example batched parametric sensitivities", "[NLP solver]")
+{
+    // "ex" is the box on x at stage 0, which only the BOX constraints provide
+    setup_and_solve_nlp(20, 3, "BOX", "MIXED", "SPARSE_HPIPM", "MIXED", "MIXED",
+                        "fixed_step", 0, 0, "", NULL, &check_param_sens_batch);
+}  // TEST_CASE
+
+
+
+/************************************************
+* TEST CASE: nonlinear chain, all-stage set/get
+************************************************/
+
+TEST_CASE("chain example all-stage set and get", "[NLP solver]")
+{
+    setup_and_solve_nlp(20, 3, "BOX", "MIXED", "SPARSE_HPIPM", "MIXED", "MIXED",
+                        "fixed_step", 0, 0, "", NULL, &check_bulk_set_get);
+}  // TEST_CASE
+
+
+
+/************************************************
+* TEST CASE: CasADi argument types
+************************************************/
+
+TEST_CASE("chain model casadi argument types", "[NLP solver]")
+{
+    // least squares cost of the chain with 2 masses: y (9, dense), dy/d(x, u) (9 x 9, sparse)
+    external_function_casadi ls_cost;
+    select_ls_stage_cost_jac_casadi(0, 1, 1, &ls_cost);
+    external_function_casadi_create(&ls_cost);
+
+    const int nx = 6, nu = 3, ny = 9;
+
+    double x[nx], u[nu];
+    for (int ii = 0; ii < nx; ii++) x[ii] = 0.1 * (ii + 1);
+    for (int ii = 0; ii < nu; ii++) u[ii] = -0.2 * (ii + 1);
+
+    // reference: plain column-major arguments
+    double y_ref[ny], J_ref[ny * ny];
+    ext_fun_arg_t type_in[2] = {COLMAJ, COLMAJ};
+    void *in[2] = {x, u};
+    ext_fun_arg_t type_out[2] = {COLMAJ, COLMAJ};
+    void *out[2] = {y_ref, J_ref};
+    ls_cost.evaluate(&ls_cost, type_in, in, type_out, out);
+
+    // inputs at offsets of a blasfeo vector, as stored in ocp_nlp_out
+    struct blasfeo_dvec ux;
+    blasfeo_allocate_dvec(nu + nx, &ux);
+    blasfeo_pack_dvec(nu, u, &ux, 0);
+    blasfeo_pack_dvec(nx, x, &ux, nu);
+    struct blasfeo_dvec_args x_args = {&ux, nu};
+    struct blasfeo_dvec_args u_args = {&ux, 0};
+    type_in[0] = BLASFEO_DVEC_ARGS;
+    type_in[1] = BLASFEO_DVEC_ARGS;
+    in[0] = &x_args;
+    in[1] = &u_args;
+
+    SECTION("blasfeo vector and padded column-major outputs")
+    {
+        struct blasfeo_dvec y;
+        blasfeo_allocate_dvec(ny, &y);
+        const int lda = ny + 2;
+        std::vector<double> J_pad(lda * ny, -1.0);
+        struct colmaj_args J_args = {J_pad.data(), lda};
+
+        type_out[0] = BLASFEO_DVEC;
+        type_out[1] = COLMAJ_ARGS;
+        out[0] = &y;
+        out[1] = &J_args;
+        ls_cost.evaluate(&ls_cost, type_in, in, type_out, out);
+
+        for (int ii = 0; ii < ny; ii++)
+            REQUIRE(BLASFEO_DVECEL(&y, ii) == y_ref[ii]);
+        for (int jj = 0; jj < ny; jj++)
+        {
+            for (int ii = 0; ii < ny; ii++)
+                REQUIRE(J_pad[ii + lda * jj] == J_ref[ii + ny * jj]);
+            // padding is left untouched
+            for (int ii = ny; ii < lda; ii++)
+                REQUIRE(J_pad[ii + lda * jj] == -1.0);
+        }
+
+        blasfeo_free_dvec(&y);
+    }
+
+    SECTION("blasfeo matrix output")
+    {
+        double y[ny];
+        struct blasfeo_dmat J;
+        blasfeo_allocate_dmat(ny, ny, &J);
+
+        type_out[0] = COLMAJ;
+        type_out[1] = BLASFEO_DMAT;
+        out[0] = y;
+        out[1] = &J;
+        ls_cost.evaluate(&ls_cost, type_in, in, type_out, out);
+
+        for (int ii = 0; ii < ny; ii++)
+            REQUIRE(y[ii] == y_ref[ii]);
+        for (int jj = 0; jj < ny; jj++)
+            for (int ii = 0; ii < ny; ii++)
+                REQUIRE(BLASFEO_DMATEL(&J, ii, jj) == J_ref[ii + ny * jj]);
+
+        blasfeo_free_dmat(&J);
+    }
+
+    blasfeo_free_dvec(&ux);
+    external_function_casadi_free(&ls_cost);
+}  // TEST_CASE
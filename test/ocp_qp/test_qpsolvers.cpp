@@ -32,6 +32,8 @@
  */
 
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -54,6 +56,7 @@ ocp_qp_solver_t hashit(std::string const &inString)
 {
     if (inString == "SPARSE_HPIPM") return PARTIAL_CONDENSING_HPIPM;
     if (inString == "DENSE_HPIPM") return FULL_CONDENSING_HPIPM;
+    if (inString == "SPARSE_PDAS") return PARTIAL_CONDENSING_PDAS;
 #ifdef ACADOS_WITH_HPMPC
     if (inString == "SPARSE_HPMPC") return PARTIAL_CONDENSING_HPMPC;
 #endif
@@ -89,6 +92,7 @@ double solver_tolerance(std::string const &inString)
     if (inString == "SPARSE_OOQP") return 1e-5;
     if (inString == "DENSE_OOQP") return 1e-5;
     if (inString == "SPARSE_OSQP") return 1e-8;
+    if (inString == "SPARSE_PDAS") return 1e-8;
 
     return -1;
 }
@@ -99,7 +103,8 @@ void set_N2(std::string const &inString, ocp_qp_xcond_solver_config *config, voi
 {
     bool option_found = false;
 
-    if ( inString=="SPARSE_HPIPM" | inString=="SPARSE_HPMPC" | inString == "SPARSE_OOQP" | inString == "SPARSE_OSQP" )
+    if ( inString=="SPARSE_HPIPM" | inString=="SPARSE_HPMPC" | inString == "SPARSE_OOQP" | inString == "SPARSE_OSQP" |
+         inString == "SPARSE_PDAS" )
     {
 		config->opts_set(config, opts, "cond_N", &N2);
     }
@@ -124,6 +129,7 @@ TEST_CASE("mass spring example", "[QP solvers]")
     vector<std::string> solvers = {
                                     "DENSE_HPIPM"
                                    ,"SPARSE_HPIPM"
+                                   ,"SPARSE_PDAS"
 #ifdef ACADOS_WITH_HPMPC
                                    ,"SPARSE_HPMPC"
 #endif
@@ -273,3 +279,702 @@ TEST_CASE("mass spring example", "[QP solvers]")
     }  // END_FOR_SOLVERS
 
 }  // END_TEST_CASE
+
+
+
+TEST_CASE("mass spring example, rhs-only condensing", "[QP solvers]")
+{
+    vector<std::string> solvers = {"DENSE_HPIPM", "SPARSE_HPIPM"};
+
+    int nx_ = 8;
+    int nu_ = 3;
+    int N = 15;
+    int nb_ = 11;
+    int ng_ = 0;
+    int ngN = 0;
+    int N2 = 5;
+
+    for (std::string solver : solvers)
+    {
+        SECTION(solver)
+        {
+            ocp_qp_solver_plan plan;
+            plan.qp_solver = hashit(solver);
+
+            ocp_qp_xcond_solver_config *config = ocp_qp_xcond_solver_config_create(plan);
+            ocp_qp_xcond_solver_dims *qp_dims =
+                create_ocp_qp_dims_mass_spring(config, N, nx_, nu_, nb_, ng_, ngN);
+            ocp_qp_in *qp_in = create_ocp_qp_in_mass_spring(qp_dims->orig_dims);
+            ocp_qp_out *qp_out = ocp_qp_out_create(qp_dims->orig_dims);
+            ocp_qp_out *qp_out_ref = ocp_qp_out_create(qp_dims->orig_dims);
+
+            // reference solver condenses the matrices on every call
+            void *opts_ref = ocp_qp_xcond_solver_opts_create(config, qp_dims);
+            set_N2(solver, config, opts_ref, N2, N);
+            ocp_qp_solver *qp_solver_ref = ocp_qp_create(config, qp_dims, opts_ref);
+
+            void *opts = ocp_qp_xcond_solver_opts_create(config, qp_dims);
+            set_N2(solver, config, opts, N2, N);
+            int mat_dirty_tracking = 1;
+            config->opts_set(config, opts, "mat_dirty_tracking", &mat_dirty_tracking);
+            ocp_qp_solver *qp_solver = ocp_qp_create(config, qp_dims, opts);
+
+            REQUIRE(ocp_qp_solve(qp_solver, qp_in, qp_out) == 0);
+
+            // change the gradient only, the condensed matrices are reused
+            vector<double> q(nx_, 1.0);
+            ocp_qp_solver_in_set(qp_solver, qp_in, 1, (char *) "q", q.data());
+
+            REQUIRE(ocp_qp_solve(qp_solver, qp_in, qp_out) == 0);
+            REQUIRE(ocp_qp_solve(qp_solver_ref, qp_in, qp_out_ref) == 0);
+            REQUIRE(((qp_info *) qp_out->misc)->num_cond_skip == 1);
+
+            vector<double> ux(nx_ + nu_), ux_ref(nx_ + nu_);
+            for (int ii = 0; ii <= N; ii++)
+            {
+                int nux = qp_dims->orig_dims->nu[ii] + qp_dims->orig_dims->nx[ii];
+                blasfeo_unpack_dvec(nux, qp_out->ux + ii, 0, ux.data());
+                blasfeo_unpack_dvec(nux, qp_out_ref->ux + ii, 0, ux_ref.data());
+                for (int jj = 0; jj < nux; jj++)
+                    REQUIRE(std::abs(ux[jj] - ux_ref[jj]) <= 1e-8);
+            }
+
+            // changing a matrix triggers the full condensing again
+            vector<double> Q(nx_ * nx_, 0.0);
+            for (int jj = 0; jj < nx_; jj++)
+                Q[jj * (nx_ + 1)] = 2.0;
+            ocp_qp_solver_in_set(qp_solver, qp_in, 1, (char *) "Q", Q.data());
+
+            REQUIRE(ocp_qp_solve(qp_solver, qp_in, qp_out) == 0);
+            REQUIRE(((qp_info *) qp_out->misc)->num_cond_skip == 1);
+
+            free(qp_solver);
+            free(qp_solver_ref);
+            free(opts);
+            free(opts_ref);
+            free(qp_out_ref);
+            free(qp_out);
+            free(qp_in);
+            free(qp_dims);
+            free(config);
+        }
+    }
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("mass spring example, automatic partial condensing horizon", "[QP solvers]")
+{
+    int nx_ = 8;
+    int nu_ = 3;
+    int N = 15;
+    int nb_ = 11;
+    int ng_ = 0;
+    int ngN = 0;
+
+    ocp_qp_solver_plan plan;
+    plan.qp_solver = PARTIAL_CONDENSING_HPIPM;
+
+    ocp_qp_xcond_solver_config *config = ocp_qp_xcond_solver_config_create(plan);
+    // NOTE: separate dims, the condensed dimensions depend on the horizon of the solver
+    ocp_qp_xcond_solver_dims *qp_dims =
+        create_ocp_qp_dims_mass_spring(config, N, nx_, nu_, nb_, ng_, ngN);
+    ocp_qp_xcond_solver_dims *qp_dims_ref =
+        create_ocp_qp_dims_mass_spring(config, N, nx_, nu_, nb_, ng_, ngN);
+    ocp_qp_in *qp_in = create_ocp_qp_in_mass_spring(qp_dims->orig_dims);
+    ocp_qp_out *qp_out = ocp_qp_out_create(qp_dims->orig_dims);
+    ocp_qp_out *qp_out_ref = ocp_qp_out_create(qp_dims->orig_dims);
+
+    void *opts_ref = ocp_qp_xcond_solver_opts_create(config, qp_dims_ref);
+    ocp_qp_solver *qp_solver_ref = ocp_qp_create(config, qp_dims_ref, opts_ref);
+    REQUIRE(ocp_qp_solve(qp_solver_ref, qp_in, qp_out_ref) == 0);
+
+    void *opts = ocp_qp_xcond_solver_opts_create(config, qp_dims);
+    int cond_N_auto = 2;
+    config->opts_set(config, opts, "cond_N_auto", &cond_N_auto);
+    int cond_N_auto_calls = 1;
+    config->opts_set(config, opts, "cond_N_auto_calls", &cond_N_auto_calls);
+    ocp_qp_solver *qp_solver = ocp_qp_create(config, qp_dims, opts);
+
+    int num_cand;
+    config->memory_get(config, qp_solver->mem, "cond_N_num_cand", &num_cand);
+    REQUIRE(num_cand >= 1);
+    REQUIRE(num_cand <= XCOND_SOLVER_N_CAND_MAX);
+    vector<int> cand(num_cand);
+    config->memory_get(config, qp_solver->mem, "cond_N_cand", cand.data());
+
+    // each candidate horizon gives the same solution
+    vector<double> ux(nx_ + nu_), ux_ref(nx_ + nu_);
+    for (int kk = 0; kk <= num_cand; kk++)
+    {
+        int cond_N;
+        config->memory_get(config, qp_solver->mem, "cond_N", &cond_N);
+        if (kk < num_cand)
+            REQUIRE(cond_N == cand[kk]);
+
+        REQUIRE(ocp_qp_solve(qp_solver, qp_in, qp_out) == 0);
+
+        for (int ii = 0; ii <= N; ii++)
+        {
+            int nux = qp_dims->orig_dims->nu[ii] + qp_dims->orig_dims->nx[ii];
+            blasfeo_unpack_dvec(nux, qp_out->ux + ii, 0, ux.data());
+            blasfeo_unpack_dvec(nux, qp_out_ref->ux + ii, 0, ux_ref.data());
+            for (int jj = 0; jj < nux; jj++)
+                REQUIRE(std::abs(ux[jj] - ux_ref[jj]) <= 1e-8);
+        }
+    }
+
+    // the fastest candidate is kept
+    int cond_N;
+    config->memory_get(config, qp_solver->mem, "cond_N", &cond_N);
+    vector<double> cand_time(num_cand);
+    config->memory_get(config, qp_solver->mem, "cond_N_time", cand_time.data());
+    int idx_min = 0;
+    for (int ii = 1; ii < num_cand; ii++)
+        if (cand_time[ii] < cand_time[idx_min])
+            idx_min = ii;
+    REQUIRE(cond_N == cand[idx_min]);
+
+    free(qp_solver);
+    free(qp_solver_ref);
+    free(opts);
+    free(opts_ref);
+    free(qp_out_ref);
+    free(qp_out);
+    free(qp_in);
+    free(qp_dims_ref);
+    free(qp_dims);
+    free(config);
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("mass spring example, non-uniform partial condensing blocks", "[QP solvers]")
+{
+    int nx_ = 8;
+    int nu_ = 3;
+    int N = 15;
+    int nb_ = 11;
+    int ng_ = 0;
+    int ngN = 0;
+
+    ocp_qp_solver_plan plan;
+    plan.qp_solver = PARTIAL_CONDENSING_HPIPM;
+
+    ocp_qp_xcond_solver_config *config = ocp_qp_xcond_solver_config_create(plan);
+    ocp_qp_xcond_solver_dims *qp_dims =
+        create_ocp_qp_dims_mass_spring(config, N, nx_, nu_, nb_, ng_, ngN);
+    ocp_qp_xcond_solver_dims *qp_dims_ref =
+        create_ocp_qp_dims_mass_spring(config, N, nx_, nu_, nb_, ng_, ngN);
+    ocp_qp_in *qp_in = create_ocp_qp_in_mass_spring(qp_dims->orig_dims);
+    ocp_qp_out *qp_out = ocp_qp_out_create(qp_dims->orig_dims);
+    ocp_qp_out *qp_out_ref = ocp_qp_out_create(qp_dims->orig_dims);
+
+    void *opts_ref = ocp_qp_xcond_solver_opts_create(config, qp_dims_ref);
+    ocp_qp_solver *qp_solver_ref = ocp_qp_create(config, qp_dims_ref, opts_ref);
+    REQUIRE(ocp_qp_solve(qp_solver_ref, qp_in, qp_out_ref) == 0);
+
+    // short blocks at the beginning of the horizon, long ones later
+    int N2 = 4;
+    int block_size[] = {1, 2, 4, 8};
+    void *opts = ocp_qp_xcond_solver_opts_create(config, qp_dims);
+    config->opts_set(config, opts, "cond_N", &N2);
+    config->opts_set(config, opts, "cond_block_size", block_size);
+    ocp_qp_solver *qp_solver = ocp_qp_create(config, qp_dims, opts);
+
+    REQUIRE(ocp_qp_solve(qp_solver, qp_in, qp_out) == 0);
+
+    ocp_qp_dims *pcond_dims;
+    config->xcond->dims_get(config->xcond, qp_dims->xcond_dims, "xcond_dims", &pcond_dims);
+    REQUIRE(pcond_dims->N == N2);
+    for (int ii = 0; ii < N2; ii++)
+        REQUIRE(pcond_dims->nu[ii] == block_size[ii] * nu_);
+
+    vector<double> ux(nx_ + nu_), ux_ref(nx_ + nu_);
+    for (int ii = 0; ii <= N; ii++)
+    {
+        int nux = qp_dims->orig_dims->nu[ii] + qp_dims->orig_dims->nx[ii];
+        blasfeo_unpack_dvec(nux, qp_out->ux + ii, 0, ux.data());
+        blasfeo_unpack_dvec(nux, qp_out_ref->ux + ii, 0, ux_ref.data());
+        for (int jj = 0; jj < nux; jj++)
+            REQUIRE(std::abs(ux[jj] - ux_ref[jj]) <= 1e-8);
+    }
+
+    free(qp_solver);
+    free(qp_solver_ref);
+    free(opts);
+    free(opts_ref);
+    free(qp_out_ref);
+    free(qp_out);
+    free(qp_in);
+    free(qp_dims_ref);
+    free(qp_dims);
+    free(config);
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("mass spring example, mixed precision hpipm", "[QP solvers]")
+{
+    int nx_ = 8;
+    int nu_ = 3;
+    int N = 15;
+    int nb_ = 11;
+    int ng_ = 0;
+    int ngN = 0;
+
+    ocp_qp_solver_plan plan;
+    plan.qp_solver = PARTIAL_CONDENSING_HPIPM;
+
+    ocp_qp_xcond_solver_config *config = ocp_qp_xcond_solver_config_create(plan);
+    ocp_qp_xcond_solver_dims *qp_dims =
+        create_ocp_qp_dims_mass_spring(config, N, nx_, nu_, nb_, ng_, ngN);
+    ocp_qp_in *qp_in = create_ocp_qp_in_mass_spring(qp_dims->orig_dims);
+    ocp_qp_out *qp_out = ocp_qp_out_create(qp_dims->orig_dims);
+    ocp_qp_out *qp_out_ref = ocp_qp_out_create(qp_dims->orig_dims);
+
+    void *opts_ref = ocp_qp_xcond_solver_opts_create(config, qp_dims);
+    ocp_qp_solver *qp_solver_ref = ocp_qp_create(config, qp_dims, opts_ref);
+    REQUIRE(ocp_qp_solve(qp_solver_ref, qp_in, qp_out_ref) == 0);
+
+    void *opts = ocp_qp_xcond_solver_opts_create(config, qp_dims);
+    int mixed_precision = 1;
+    config->opts_set(config, opts, "mixed_precision", &mixed_precision);
+    int itref_mixed = 3;
+    config->opts_set(config, opts, "itref_mixed", &itref_mixed);
+    ocp_qp_solver *qp_solver = ocp_qp_create(config, qp_dims, opts);
+    ocp_qp_solve(qp_solver, qp_in, qp_out);
+
+    // iterative refinement does not lose accuracy w.r.t. the single precision solve
+    double res_single[4], res_mixed[4];
+    config->memory_get(config, qp_solver->mem, "res_single", res_single);
+    config->memory_get(config, qp_solver->mem, "res_mixed", res_mixed);
+    int itref_mixed_iter;
+    config->memory_get(config, qp_solver->mem, "itref_mixed_iter", &itref_mixed_iter);
+    REQUIRE(itref_mixed_iter <= itref_mixed);
+    double res_single_max = 0, res_mixed_max = 0;
+    for (int ii = 0; ii < 4; ii++)
+    {
+        res_single_max = std::max(res_single_max, res_single[ii]);
+        res_mixed_max = std::max(res_mixed_max, res_mixed[ii]);
+    }
+    REQUIRE(res_mixed_max <= res_single_max);
+
+    // solution close to the double precision one
+    vector<double> ux(nx_ + nu_), ux_ref(nx_ + nu_);
+    for (int ii = 0; ii <= N; ii++)
+    {
+        int nux = qp_dims->orig_dims->nu[ii] + qp_dims->orig_dims->nx[ii];
+        blasfeo_unpack_dvec(nux, qp_out->ux + ii, 0, ux.data());
+        blasfeo_unpack_dvec(nux, qp_out_ref->ux + ii, 0, ux_ref.data());
+        for (int jj = 0; jj < nux; jj++)
+            REQUIRE(std::abs(ux[jj] - ux_ref[jj]) <= 1e-3);
+    }
+
+    free(qp_solver);
+    free(qp_solver_ref);
+    free(opts);
+    free(opts_ref);
+    free(qp_out_ref);
+    free(qp_out);
+    free(qp_in);
+    free(qp_dims);
+    free(config);
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("mass spring example, presolve", "[QP solvers]")
+{
+    vector<std::string> solvers = {"DENSE_HPIPM", "SPARSE_HPIPM"};
+
+    int nx_ = 8;
+    int nu_ = 3;
+    int N = 15;
+    int nb_ = 11;
+    int ng_ = 0;
+    int ngN = 0;
+
+    for (std::string solver : solvers)
+    {
+        SECTION(solver)
+        {
+            ocp_qp_solver_plan plan;
+            plan.qp_solver = hashit(solver);
+
+            ocp_qp_xcond_solver_config *config = ocp_qp_xcond_solver_config_create(plan);
+            ocp_qp_xcond_solver_dims *qp_dims =
+                create_ocp_qp_dims_mass_spring(config, N, nx_, nu_, nb_, ng_, ngN);
+            ocp_qp_in *qp_in = create_ocp_qp_in_mass_spring(qp_dims->orig_dims);
+            ocp_qp_out *qp_out = ocp_qp_out_create(qp_dims->orig_dims);
+            ocp_qp_out *qp_out_ref = ocp_qp_out_create(qp_dims->orig_dims);
+
+            // lock the first input
+            int num_fixed = 0;
+            for (int ii = 0; ii < N; ii++)
+            {
+                int nb = qp_dims->orig_dims->nb[ii];
+                int ng = qp_dims->orig_dims->ng[ii];
+                for (int jj = 0; jj < nb; jj++)
+                {
+                    if (qp_in->idxb[ii][jj] == 0 && qp_dims->orig_dims->nu[ii] > 0)
+                    {
+                        BLASFEO_DVECEL(qp_in->d+ii, jj) = 0.1;
+                        BLASFEO_DVECEL(qp_in->d+ii, nb+ng+jj) = -0.1;
+                        num_fixed++;
+                    }
+                }
+            }
+
+            void *opts_ref = ocp_qp_xcond_solver_opts_create(config, qp_dims);
+            ocp_qp_solver *qp_solver_ref = ocp_qp_create(config, qp_dims, opts_ref);
+            REQUIRE(ocp_qp_solve(qp_solver_ref, qp_in, qp_out_ref) == 0);
+
+            void *opts = ocp_qp_xcond_solver_opts_create(config, qp_dims);
+            int presolve = 1;
+            config->opts_set(config, opts, "presolve", &presolve);
+            ocp_qp_solver *qp_solver = ocp_qp_create(config, qp_dims, opts);
+            REQUIRE(ocp_qp_solve(qp_solver, qp_in, qp_out) == 0);
+
+            int nu_fixed;
+            config->memory_get(config, qp_solver->mem, "presolve_nu_fixed", &nu_fixed);
+            REQUIRE(nu_fixed == num_fixed);
+
+            // same primal solution and multipliers of the dynamics
+            vector<double> ux(nx_ + nu_), ux_ref(nx_ + nu_);
+            vector<double> pi(nx_), pi_ref(nx_);
+            for (int ii = 0; ii <= N; ii++)
+            {
+                int nux = qp_dims->orig_dims->nu[ii] + qp_dims->orig_dims->nx[ii];
+                blasfeo_unpack_dvec(nux, qp_out->ux + ii, 0, ux.data());
+                blasfeo_unpack_dvec(nux, qp_out_ref->ux + ii, 0, ux_ref.data());
+                for (int jj = 0; jj < nux; jj++)
+                    REQUIRE(std::abs(ux[jj] - ux_ref[jj]) <= 1e-5);
+                if (ii < N)
+                {
+                    int nx1 = qp_dims->orig_dims->nx[ii+1];
+                    blasfeo_unpack_dvec(nx1, qp_out->pi + ii, 0, pi.data());
+                    blasfeo_unpack_dvec(nx1, qp_out_ref->pi + ii, 0, pi_ref.data());
+                    for (int jj = 0; jj < nx1; jj++)
+                        REQUIRE(std::abs(pi[jj] - pi_ref[jj]) <= 1e-5);
+                }
+            }
+
+            free(qp_solver);
+            free(qp_solver_ref);
+            free(opts);
+            free(opts_ref);
+            free(qp_out_ref);
+            free(qp_out);
+            free(qp_in);
+            free(qp_dims);
+            free(config);
+        }  // END_SECTION
+    }  // END_FOR_SOLVERS
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("mass spring example, active-set warm start", "[QP solvers]")
+{
+    int nx_ = 8;
+    int nu_ = 3;
+    int N = 15;
+    int nb_ = 11;
+    int ng_ = 0;
+    int ngN = 0;
+
+    ocp_qp_solver_plan plan;
+    plan.qp_solver = PARTIAL_CONDENSING_PDAS;
+
+    ocp_qp_xcond_solver_config *config = ocp_qp_xcond_solver_config_create(plan);
+    ocp_qp_xcond_solver_dims *qp_dims =
+        create_ocp_qp_dims_mass_spring(config, N, nx_, nu_, nb_, ng_, ngN);
+    ocp_qp_in *qp_in = create_ocp_qp_in_mass_spring(qp_dims->orig_dims);
+    ocp_qp_out *qp_out = ocp_qp_out_create(qp_dims->orig_dims);
+
+    void *opts = ocp_qp_xcond_solver_opts_create(config, qp_dims);
+    int warm_start = 1;
+    config->opts_set(config, opts, "warm_start", &warm_start);
+    ocp_qp_solver *qp_solver = ocp_qp_create(config, qp_dims, opts);
+
+    REQUIRE(ocp_qp_solve(qp_solver, qp_in, qp_out) == 0);
+    int iter_cold;
+    config->memory_get(config, qp_solver->mem, "iter", &iter_cold);
+
+    // the active set of the previous solution is optimal, one factorization suffices
+    REQUIRE(ocp_qp_solve(qp_solver, qp_in, qp_out) == 0);
+    int iter_warm;
+    config->memory_get(config, qp_solver->mem, "iter", &iter_warm);
+    REQUIRE(iter_warm == 1);
+    REQUIRE(iter_warm <= iter_cold);
+
+    double res[4];
+    ocp_qp_inf_norm_residuals(qp_dims->orig_dims, qp_in, qp_out, res);
+    for (int ii = 0; ii < 4; ii++)
+        REQUIRE(res[ii] <= solver_tolerance("SPARSE_PDAS"));
+
+    free(qp_solver);
+    free(opts);
+    free(qp_out);
+    free(qp_in);
+    free(qp_dims);
+    free(config);
+}  // END_TEST_CASE
+
+
+
+#ifdef ACADOS_WITH_OSQP
+TEST_CASE("mass spring example, osqp partial matrix update", "[QP solvers]")
+{
+    int nx_ = 8;
+    int nu_ = 3;
+    int N = 15;
+    int nb_ = 11;
+    int ng_ = 0;
+    int ngN = 0;
+
+    double tol = solver_tolerance("SPARSE_OSQP");
+
+    ocp_qp_solver_plan plan;
+    plan.qp_solver = PARTIAL_CONDENSING_OSQP;
+
+    ocp_qp_xcond_solver_config *config = ocp_qp_xcond_solver_config_create(plan);
+    ocp_qp_xcond_solver_dims *qp_dims =
+        create_ocp_qp_dims_mass_spring(config, N, nx_, nu_, nb_, ng_, ngN);
+    ocp_qp_in *qp_in = create_ocp_qp_in_mass_spring(qp_dims->orig_dims);
+    ocp_qp_out *qp_out = ocp_qp_out_create(qp_dims->orig_dims);
+    ocp_qp_out *qp_out_ref = ocp_qp_out_create(qp_dims->orig_dims);
+
+    void *opts = ocp_qp_xcond_solver_opts_create(config, qp_dims);
+    ocp_qp_solver *qp_solver = ocp_qp_create(config, qp_dims, opts);
+
+    REQUIRE(ocp_qp_solve(qp_solver, qp_in, qp_out) == 0);
+
+    // gradient only: no matrix update, osqp keeps its factorization
+    vector<double> q(nx_, 1.0);
+    ocp_qp_solver_in_set(qp_solver, qp_in, 1, (char *) "q", q.data());
+
+    REQUIRE(ocp_qp_solve(qp_solver, qp_in, qp_out) == 0);
+    int P_nnz_changed, A_nnz_changed;
+    config->memory_get(config, qp_solver->mem, "P_nnz_changed", &P_nnz_changed);
+    config->memory_get(config, qp_solver->mem, "A_nnz_changed", &A_nnz_changed);
+    REQUIRE(P_nnz_changed == 0);
+    REQUIRE(A_nnz_changed == 0);
+
+    // new Hessian block: only the changed nonzeros of P are passed to osqp
+    vector<double> Q(nx_ * nx_, 0.0);
+    for (int jj = 0; jj < nx_; jj++)
+        Q[jj * (nx_ + 1)] = 2.0;
+    ocp_qp_solver_in_set(qp_solver, qp_in, 1, (char *) "Q", Q.data());
+
+    REQUIRE(ocp_qp_solve(qp_solver, qp_in, qp_out) == 0);
+    config->memory_get(config, qp_solver->mem, "P_nnz_changed", &P_nnz_changed);
+    config->memory_get(config, qp_solver->mem, "A_nnz_changed", &A_nnz_changed);
+    REQUIRE(P_nnz_changed > 0);
+    REQUIRE(A_nnz_changed == 0);
+
+    // reference: a new solver, set up from scratch with the changed qp
+    void *opts_ref = ocp_qp_xcond_solver_opts_create(config, qp_dims);
+    ocp_qp_solver *qp_solver_ref = ocp_qp_create(config, qp_dims, opts_ref);
+    REQUIRE(ocp_qp_solve(qp_solver_ref, qp_in, qp_out_ref) == 0);
+
+    double res[4];
+    ocp_qp_inf_norm_residuals(qp_dims->orig_dims, qp_in, qp_out, res);
+    for (int ii = 0; ii < 4; ii++)
+        REQUIRE(res[ii] <= tol);
+
+    vector<double> ux(nx_ + nu_), ux_ref(nx_ + nu_);
+    for (int ii = 0; ii <= N; ii++)
+    {
+        int nux = qp_dims->orig_dims->nu[ii] + qp_dims->orig_dims->nx[ii];
+        blasfeo_unpack_dvec(nux, qp_out->ux + ii, 0, ux.data());
+        blasfeo_unpack_dvec(nux, qp_out_ref->ux + ii, 0, ux_ref.data());
+        for (int jj = 0; jj < nux; jj++)
+            REQUIRE(std::abs(ux[jj] - ux_ref[jj]) <= 1e-6);
+    }
+
+    free(qp_solver);
+    free(qp_solver_ref);
+    free(opts);
+    free(opts_ref);
+    free(qp_out_ref);
+    free(qp_out);
+    free(qp_in);
+    free(qp_dims);
+    free(config);
+}  // END_TEST_CASE
+#endif
+
+
+
+#ifdef ACADOS_WITH_QPOASES
+TEST_CASE("mass spring example, qpoases hotstart with matrix check", "[QP solvers]")
+{
+    int nx_ = 8;
+    int nu_ = 3;
+    int N = 15;
+    int nb_ = 11;
+    int ng_ = 0;
+    int ngN = 0;
+
+    ocp_qp_solver_plan plan;
+    plan.qp_solver = FULL_CONDENSING_QPOASES;
+
+    ocp_qp_xcond_solver_config *config = ocp_qp_xcond_solver_config_create(plan);
+    ocp_qp_xcond_solver_dims *qp_dims =
+        create_ocp_qp_dims_mass_spring(config, N, nx_, nu_, nb_, ng_, ngN);
+    ocp_qp_in *qp_in = create_ocp_qp_in_mass_spring(qp_dims->orig_dims);
+    ocp_qp_out *qp_out = ocp_qp_out_create(qp_dims->orig_dims);
+    ocp_qp_out *qp_out_ref = ocp_qp_out_create(qp_dims->orig_dims);
+
+    void *opts = ocp_qp_xcond_solver_opts_create(config, qp_dims);
+    int warm_start = 3;
+    config->opts_set(config, opts, "warm_start", &warm_start);
+    ocp_qp_solver *qp_solver = ocp_qp_create(config, qp_dims, opts);
+
+    // reference: cold start, initialized on every call
+    void *opts_ref = ocp_qp_xcond_solver_opts_create(config, qp_dims);
+    int warm_start_ref = 0;
+    config->opts_set(config, opts_ref, "warm_start", &warm_start_ref);
+    ocp_qp_solver *qp_solver_ref = ocp_qp_create(config, qp_dims, opts_ref);
+
+    REQUIRE(ocp_qp_solve(qp_solver, qp_in, qp_out) == 0);
+    int qp_init, num_qp_init;
+    config->memory_get(config, qp_solver->mem, "qp_init", &qp_init);
+    REQUIRE(qp_init == 1);
+
+    vector<double> q(nx_, 1.0);
+    vector<double> Q(nx_ * nx_, 0.0);
+    for (int jj = 0; jj < nx_; jj++)
+        Q[jj * (nx_ + 1)] = 2.0;
+
+    for (int change = 0; change < 2; change++)
+    {
+        if (change == 0)
+        {
+            // gradient only: hotstart
+            ocp_qp_solver_in_set(qp_solver, qp_in, 1, (char *) "q", q.data());
+        }
+        else
+        {
+            // new Hessian block: initialization from the previous working set (initW)
+            ocp_qp_solver_in_set(qp_solver, qp_in, 1, (char *) "Q", Q.data());
+        }
+
+        REQUIRE(ocp_qp_solve(qp_solver, qp_in, qp_out) == 0);
+        REQUIRE(ocp_qp_solve(qp_solver_ref, qp_in, qp_out_ref) == 0);
+
+        config->memory_get(config, qp_solver->mem, "qp_init", &qp_init);
+        config->memory_get(config, qp_solver->mem, "num_qp_init", &num_qp_init);
+        REQUIRE(qp_init == change);
+        REQUIRE(num_qp_init == 1 + change);
+
+        vector<double> ux(nx_ + nu_), ux_ref(nx_ + nu_);
+        for (int ii = 0; ii <= N; ii++)
+        {
+            int nux = qp_dims->orig_dims->nu[ii] + qp_dims->orig_dims->nx[ii];
+            blasfeo_unpack_dvec(nux, qp_out->ux + ii, 0, ux.data());
+            blasfeo_unpack_dvec(nux, qp_out_ref->ux + ii, 0, ux_ref.data());
+            for (int jj = 0; jj < nux; jj++)
+                REQUIRE(std::abs(ux[jj] - ux_ref[jj]) <= solver_tolerance("DENSE_QPOASES"));
+        }
+    }
+
+    free(qp_solver);
+    free(qp_solver_ref);
+    free(opts);
+    free(opts_ref);
+    free(qp_out_ref);
+    free(qp_out);
+    free(qp_in);
+    free(qp_dims);
+    free(config);
+}  // END_TEST_CASE
+#endif
+
+
+
+TEST_CASE("mass spring example, batch of qps", "[QP solvers]")
+{
+    vector<std::string> solvers = {"DENSE_HPIPM", "SPARSE_HPIPM"};
+
+    int nx_ = 8;
+    int nu_ = 3;
+    int N = 15;
+    int nb_ = 11;
+    int ng_ = 0;
+    int ngN = 0;
+    int N2 = 5;
+
+    int n_batch = 6;
+    int num_threads = 3;
+
+    for (std::string solver : solvers)
+    {
+        SECTION(solver)
+        {
+            ocp_qp_solver_plan plan;
+            plan.qp_solver = hashit(solver);
+
+            ocp_qp_xcond_solver_config *config = ocp_qp_xcond_solver_config_create(plan);
+            ocp_qp_xcond_solver_dims *qp_dims =
+                create_ocp_qp_dims_mass_spring(config, N, nx_, nu_, nb_, ng_, ngN);
+
+            vector<ocp_qp_in *> qp_in(n_batch);
+            vector<ocp_qp_out *> qp_out(n_batch);
+            vector<ocp_qp_out *> qp_out_ref(n_batch);
+            for (int kk = 0; kk < n_batch; kk++)
+            {
+                qp_in[kk] = create_ocp_qp_in_mass_spring(qp_dims->orig_dims);
+                qp_out[kk] = ocp_qp_out_create(qp_dims->orig_dims);
+                qp_out_ref[kk] = ocp_qp_out_create(qp_dims->orig_dims);
+
+                // a different gradient for each instance
+                vector<double> q(nx_, 0.1 * kk);
+                for (int ii = 1; ii < N; ii++)
+                    d_ocp_qp_set((char *) "q", ii, q.data(), qp_in[kk]);
+            }
+
+            void *opts = ocp_qp_xcond_solver_opts_create(config, qp_dims);
+            set_N2(solver, config, opts, N2, N);
+
+            // reference: one qp at a time
+            ocp_qp_solver *qp_solver = ocp_qp_create(config, qp_dims, opts);
+            for (int kk = 0; kk < n_batch; kk++)
+                REQUIRE(ocp_qp_solve(qp_solver, qp_in[kk], qp_out_ref[kk]) == 0);
+
+            ocp_qp_batch_solver *batch_solver =
+                ocp_qp_batch_create(config, qp_dims, opts, n_batch, num_threads);
+            vector<int> status(n_batch, -1);
+            REQUIRE(ocp_qp_batch_solve(batch_solver, qp_in.data(), qp_out.data(), n_batch,
+                                       status.data()) == 0);
+
+            vector<double> ux(nx_ + nu_), ux_ref(nx_ + nu_);
+            for (int kk = 0; kk < n_batch; kk++)
+            {
+                REQUIRE(status[kk] == 0);
+                for (int ii = 0; ii <= N; ii++)
+                {
+                    int nux = qp_dims->orig_dims->nu[ii] + qp_dims->orig_dims->nx[ii];
+                    blasfeo_unpack_dvec(nux, qp_out[kk]->ux + ii, 0, ux.data());
+                    blasfeo_unpack_dvec(nux, qp_out_ref[kk]->ux + ii, 0, ux_ref.data());
+                    for (int jj = 0; jj < nux; jj++)
+                        REQUIRE(ux[jj] == ux_ref[jj]);
+                }
+            }
+
+            ocp_qp_batch_destroy(batch_solver);
+            free(qp_solver);
+            free(opts);
+            for (int kk = 0; kk < n_batch; kk++)
+            {
+                free(qp_out_ref[kk]);
+                free(qp_out[kk]);
+                free(qp_in[kk]);
+            }
+            free(qp_dims);
+            free(config);
+        }
+    }
+}  // END_TEST_CASE
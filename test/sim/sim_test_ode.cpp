@@ -604,3 +604,960 @@ TEST_CASE("wt_nx3_example", "[integrators]")
     external_function_casadi_free(&get_matrices_fun);
 
 }  // END_TEST_CASE
+
+
+
+TEST_CASE("wt_nx3_example adaptive ERK", "[integrators]")
+{
+    int ii, jj;
+
+    const int nx = 3;
+    const int nu = 4;
+    int NF = nx + nu;  // columns of forward seed
+
+    double T = 0.05;  // simulation time
+
+    double x_ref_sol[nx];
+    double S_forw_ref_sol[nx*NF];
+    double S_adj_ref_sol[NF];
+
+    /************************************************
+    * external functions (explicit model)
+    ************************************************/
+
+    // expl_ode_fun
+    external_function_casadi expl_ode_fun;
+    expl_ode_fun.casadi_fun = &casadi_expl_ode_fun;
+    expl_ode_fun.casadi_work = &casadi_expl_ode_fun_work;
+    expl_ode_fun.casadi_sparsity_in = &casadi_expl_ode_fun_sparsity_in;
+    expl_ode_fun.casadi_sparsity_out = &casadi_expl_ode_fun_sparsity_out;
+    expl_ode_fun.casadi_n_in = &casadi_expl_ode_fun_n_in;
+    expl_ode_fun.casadi_n_out = &casadi_expl_ode_fun_n_out;
+    external_function_casadi_create(&expl_ode_fun);
+
+    // expl_vde_for
+    external_function_casadi expl_vde_for;
+    expl_vde_for.casadi_fun = &casadi_expl_vde_for;
+    expl_vde_for.casadi_work = &casadi_expl_vde_for_work;
+    expl_vde_for.casadi_sparsity_in = &casadi_expl_vde_for_sparsity_in;
+    expl_vde_for.casadi_sparsity_out = &casadi_expl_vde_for_sparsity_out;
+    expl_vde_for.casadi_n_in = &casadi_expl_vde_for_n_in;
+    expl_vde_for.casadi_n_out = &casadi_expl_vde_for_n_out;
+    external_function_casadi_create(&expl_vde_for);
+
+    // expl_vde_adj
+    external_function_casadi expl_vde_adj;
+    expl_vde_adj.casadi_fun = &casadi_expl_vde_adj;
+    expl_vde_adj.casadi_work = &casadi_expl_vde_adj_work;
+    expl_vde_adj.casadi_sparsity_in = &casadi_expl_vde_adj_sparsity_in;
+    expl_vde_adj.casadi_sparsity_out = &casadi_expl_vde_adj_sparsity_out;
+    expl_vde_adj.casadi_n_in = &casadi_expl_vde_adj_n_in;
+    expl_vde_adj.casadi_n_out = &casadi_expl_vde_adj_n_out;
+    external_function_casadi_create(&expl_vde_adj);
+
+    sim_solver_plan plan;
+    plan.sim_solver = ERK;
+
+    // reference: fixed step RK4, stages 0 and adaptive pairs 4 and 7
+    vector<int> num_stages = {0, 4, 7};
+
+    for (int ns : num_stages)
+    {
+        sim_config *config = sim_config_create(plan);
+
+        void *dims = sim_dims_create(config);
+        sim_dims_set(config, dims, "nx", &nx);
+        sim_dims_set(config, dims, "nu", &nu);
+
+        void *opts_ = sim_opts_create(config, dims);
+        sim_opts *opts = (sim_opts *) opts_;
+
+        bool sens_adj = true;
+        sim_opts_set(config, opts, "sens_adj", &sens_adj);
+
+        if (ns == 0)
+        {
+            int num_steps = 200;
+            sim_opts_set(config, opts, "num_steps", &num_steps);
+        }
+        else
+        {
+            bool adaptive_steps = true;
+            double tol = 1e-10;
+            sim_opts_set(config, opts, "ns", &ns);
+            sim_opts_set(config, opts, "adaptive_steps", &adaptive_steps);
+            sim_opts_set(config, opts, "abs_tol", &tol);
+            sim_opts_set(config, opts, "rel_tol", &tol);
+        }
+
+        sim_in *in = sim_in_create(config, dims);
+        sim_out *out = sim_out_create(config, dims);
+
+        in->T = T;
+
+        sim_in_set(config, dims, in, "expl_ode_fun", &expl_ode_fun);
+        sim_in_set(config, dims, in, "expl_vde_for", &expl_vde_for);
+        sim_in_set(config, dims, in, "expl_vde_adj", &expl_vde_adj);
+
+        for (jj = 0; jj < nx; jj++)
+            in->x[jj] = x0[jj];
+        for (jj = 0; jj < nu; jj++)
+            in->u[jj] = u_sim[jj];
+
+        // seeds forw
+        for (ii = 0; ii < nx * NF; ii++)
+            in->S_forw[ii] = 0.0;
+        for (ii = 0; ii < nx; ii++)
+            in->S_forw[ii * (nx + 1)] = 1.0;
+
+        // seeds adj
+        for (ii = 0; ii < nx; ii++)
+            in->S_adj[ii] = 1.0;
+
+        sim_solver *sim_solver = sim_solver_create(config, dims, opts);
+
+        int acados_return = sim_solve(sim_solver, in, out);
+        REQUIRE(acados_return == 0);
+
+        if (ns == 0)
+        {
+            for (jj = 0; jj < nx; jj++)
+                x_ref_sol[jj] = out->xn[jj];
+            for (jj = 0; jj < nx*NF; jj++)
+                S_forw_ref_sol[jj] = out->S_forw[jj];
+            for (jj = 0; jj < NF; jj++)
+                S_adj_ref_sol[jj] = out->S_adj[jj];
+        }
+        else
+        {
+            int num_steps, num_rejected_steps;
+            sim_solver_get(sim_solver, "num_steps", &num_steps);
+            sim_solver_get(sim_solver, "num_rejected_steps", &num_rejected_steps);
+
+            std::cout << "\n---> testing adaptive ERK (num_stages = " << ns << ", num_steps = "
+                    << num_steps << ", num_rejected_steps = " << num_rejected_steps << ")\n";
+
+            REQUIRE(num_steps >= 1);
+            REQUIRE(num_steps + num_rejected_steps <= opts->max_num_steps);
+
+            for (jj = 0; jj < nx; jj++)
+                REQUIRE(fabs(out->xn[jj] - x_ref_sol[jj]) <= 1e-7);
+            for (jj = 0; jj < nx*NF; jj++)
+                REQUIRE(fabs(out->S_forw[jj] - S_forw_ref_sol[jj]) <= 1e-7);
+            for (jj = 0; jj < NF; jj++)
+                REQUIRE(fabs(out->S_adj[jj] - S_adj_ref_sol[jj]) <= 1e-7);
+        }
+
+        sim_config_destroy(config);
+        sim_dims_destroy(dims);
+        sim_opts_destroy(opts);
+
+        sim_in_destroy(in);
+        sim_out_destroy(out);
+        sim_solver_destroy(sim_solver);
+    }
+
+    external_function_casadi_free(&expl_ode_fun);
+    external_function_casadi_free(&expl_vde_for);
+    external_function_casadi_free(&expl_vde_adj);
+
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("wt_nx3_example IRK simplified Newton", "[integrators]")
+{
+    int ii, jj;
+
+    const int nx = 3;
+    const int nu = 4;
+    int NF = nx + nu;  // columns of forward seed
+
+    double T = 0.05;  // simulation time
+
+    double x_ref_sol[nx];
+    double S_forw_ref_sol[nx*NF];
+
+    /************************************************
+    * external functions (implicit model)
+    ************************************************/
+
+    // impl_ode_fun
+    external_function_casadi impl_ode_fun;
+    impl_ode_fun.casadi_fun = &casadi_impl_ode_fun;
+    impl_ode_fun.casadi_work = &casadi_impl_ode_fun_work;
+    impl_ode_fun.casadi_sparsity_in = &casadi_impl_ode_fun_sparsity_in;
+    impl_ode_fun.casadi_sparsity_out = &casadi_impl_ode_fun_sparsity_out;
+    impl_ode_fun.casadi_n_in = &casadi_impl_ode_fun_n_in;
+    impl_ode_fun.casadi_n_out = &casadi_impl_ode_fun_n_out;
+    external_function_casadi_create(&impl_ode_fun);
+
+    // impl_ode_fun_jac_x_xdot
+    external_function_casadi impl_ode_fun_jac_x_xdot;
+    impl_ode_fun_jac_x_xdot.casadi_fun = &casadi_impl_ode_fun_jac_x_xdot;
+    impl_ode_fun_jac_x_xdot.casadi_work = &casadi_impl_ode_fun_jac_x_xdot_work;
+    impl_ode_fun_jac_x_xdot.casadi_sparsity_in = &casadi_impl_ode_fun_jac_x_xdot_sparsity_in;
+    impl_ode_fun_jac_x_xdot.casadi_sparsity_out = &casadi_impl_ode_fun_jac_x_xdot_sparsity_out;
+    impl_ode_fun_jac_x_xdot.casadi_n_in = &casadi_impl_ode_fun_jac_x_xdot_n_in;
+    impl_ode_fun_jac_x_xdot.casadi_n_out = &casadi_impl_ode_fun_jac_x_xdot_n_out;
+    external_function_casadi_create(&impl_ode_fun_jac_x_xdot);
+
+    // impl_ode_jac_x_xdot_u
+    external_function_casadi impl_ode_jac_x_xdot_u;
+    impl_ode_jac_x_xdot_u.casadi_fun = &casadi_impl_ode_jac_x_xdot_u;
+    impl_ode_jac_x_xdot_u.casadi_work = &casadi_impl_ode_jac_x_xdot_u_work;
+    impl_ode_jac_x_xdot_u.casadi_sparsity_in = &casadi_impl_ode_jac_x_xdot_u_sparsity_in;
+    impl_ode_jac_x_xdot_u.casadi_sparsity_out = &casadi_impl_ode_jac_x_xdot_u_sparsity_out;
+    impl_ode_jac_x_xdot_u.casadi_n_in = &casadi_impl_ode_jac_x_xdot_u_n_in;
+    impl_ode_jac_x_xdot_u.casadi_n_out = &casadi_impl_ode_jac_x_xdot_u_n_out;
+    external_function_casadi_create(&impl_ode_jac_x_xdot_u);
+
+    sim_solver_plan plan;
+    plan.sim_solver = IRK;
+
+    for (int ns = 1; ns < 6; ns++)
+    {
+        // reference: exact Newton, simplified Newton
+        for (int simplified = 0; simplified < 2; simplified++)
+        {
+            sim_config *config = sim_config_create(plan);
+
+            void *dims = sim_dims_create(config);
+            sim_dims_set(config, dims, "nx", &nx);
+            sim_dims_set(config, dims, "nu", &nu);
+
+            void *opts_ = sim_opts_create(config, dims);
+            sim_opts *opts = (sim_opts *) opts_;
+
+            int newton_iter = 20;
+            int num_steps = 2;
+            bool jac_reuse = false;
+            bool simplified_newton = simplified;
+            sim_opts_set(config, opts, "ns", &ns);
+            sim_opts_set(config, opts, "num_steps", &num_steps);
+            sim_opts_set(config, opts, "newton_iter", &newton_iter);
+            sim_opts_set(config, opts, "jac_reuse", &jac_reuse);
+            sim_opts_set(config, opts, "simplified_newton", &simplified_newton);
+
+            sim_in *in = sim_in_create(config, dims);
+            sim_out *out = sim_out_create(config, dims);
+
+            in->T = T;
+
+            sim_in_set(config, dims, in, "impl_ode_fun", &impl_ode_fun);
+            sim_in_set(config, dims, in, "impl_ode_fun_jac_x_xdot", &impl_ode_fun_jac_x_xdot);
+            sim_in_set(config, dims, in, "impl_ode_jac_x_xdot_u", &impl_ode_jac_x_xdot_u);
+
+            for (jj = 0; jj < nx; jj++)
+                in->x[jj] = x0[jj];
+            for (jj = 0; jj < nu; jj++)
+                in->u[jj] = u_sim[jj];
+
+            // seeds forw
+            for (ii = 0; ii < nx * NF; ii++)
+                in->S_forw[ii] = 0.0;
+            for (ii = 0; ii < nx; ii++)
+                in->S_forw[ii * (nx + 1)] = 1.0;
+            in->identity_seed = true;
+
+            sim_solver *sim_solver = sim_solver_create(config, dims, opts);
+
+            int acados_return = sim_solve(sim_solver, in, out);
+            REQUIRE(acados_return == 0);
+
+            if (!simplified)
+            {
+                for (jj = 0; jj < nx; jj++)
+                    x_ref_sol[jj] = out->xn[jj];
+                for (jj = 0; jj < nx*NF; jj++)
+                    S_forw_ref_sol[jj] = out->S_forw[jj];
+            }
+            else
+            {
+                std::cout << "\n---> testing IRK simplified Newton (num_stages = " << ns << ")\n";
+
+                for (jj = 0; jj < nx; jj++)
+                    REQUIRE(fabs(out->xn[jj] - x_ref_sol[jj]) <= 1e-9);
+                for (jj = 0; jj < nx*NF; jj++)
+                    REQUIRE(fabs(out->S_forw[jj] - S_forw_ref_sol[jj]) <= 1e-9);
+            }
+
+            sim_config_destroy(config);
+            sim_dims_destroy(dims);
+            sim_opts_destroy(opts);
+
+            sim_in_destroy(in);
+            sim_out_destroy(out);
+            sim_solver_destroy(sim_solver);
+        }
+    }
+
+    external_function_casadi_free(&impl_ode_fun);
+    external_function_casadi_free(&impl_ode_fun_jac_x_xdot);
+    external_function_casadi_free(&impl_ode_jac_x_xdot_u);
+
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("wt_nx3_example IRK Newton tolerance", "[integrators]")
+{
+    int ii, jj;
+
+    const int nx = 3;
+    const int nu = 4;
+    int NF = nx + nu;  // columns of forward seed
+
+    double T = 0.05;  // simulation time
+
+    double x_ref_sol[nx];
+    double S_forw_ref_sol[nx*NF];
+
+    /************************************************
+    * external functions (implicit model)
+    ************************************************/
+
+    // impl_ode_fun
+    external_function_casadi impl_ode_fun;
+    impl_ode_fun.casadi_fun = &casadi_impl_ode_fun;
+    impl_ode_fun.casadi_work = &casadi_impl_ode_fun_work;
+    impl_ode_fun.casadi_sparsity_in = &casadi_impl_ode_fun_sparsity_in;
+    impl_ode_fun.casadi_sparsity_out = &casadi_impl_ode_fun_sparsity_out;
+    impl_ode_fun.casadi_n_in = &casadi_impl_ode_fun_n_in;
+    impl_ode_fun.casadi_n_out = &casadi_impl_ode_fun_n_out;
+    external_function_casadi_create(&impl_ode_fun);
+
+    // impl_ode_fun_jac_x_xdot
+    external_function_casadi impl_ode_fun_jac_x_xdot;
+    impl_ode_fun_jac_x_xdot.casadi_fun = &casadi_impl_ode_fun_jac_x_xdot;
+    impl_ode_fun_jac_x_xdot.casadi_work = &casadi_impl_ode_fun_jac_x_xdot_work;
+    impl_ode_fun_jac_x_xdot.casadi_sparsity_in = &casadi_impl_ode_fun_jac_x_xdot_sparsity_in;
+    impl_ode_fun_jac_x_xdot.casadi_sparsity_out = &casadi_impl_ode_fun_jac_x_xdot_sparsity_out;
+    impl_ode_fun_jac_x_xdot.casadi_n_in = &casadi_impl_ode_fun_jac_x_xdot_n_in;
+    impl_ode_fun_jac_x_xdot.casadi_n_out = &casadi_impl_ode_fun_jac_x_xdot_n_out;
+    external_function_casadi_create(&impl_ode_fun_jac_x_xdot);
+
+    // impl_ode_jac_x_xdot_u
+    external_function_casadi impl_ode_jac_x_xdot_u;
+    impl_ode_jac_x_xdot_u.casadi_fun = &casadi_impl_ode_jac_x_xdot_u;
+    impl_ode_jac_x_xdot_u.casadi_work = &casadi_impl_ode_jac_x_xdot_u_work;
+    impl_ode_jac_x_xdot_u.casadi_sparsity_in = &casadi_impl_ode_jac_x_xdot_u_sparsity_in;
+    impl_ode_jac_x_xdot_u.casadi_sparsity_out = &casadi_impl_ode_jac_x_xdot_u_sparsity_out;
+    impl_ode_jac_x_xdot_u.casadi_n_in = &casadi_impl_ode_jac_x_xdot_u_n_in;
+    impl_ode_jac_x_xdot_u.casadi_n_out = &casadi_impl_ode_jac_x_xdot_u_n_out;
+    external_function_casadi_create(&impl_ode_jac_x_xdot_u);
+
+    sim_solver_plan plan;
+    plan.sim_solver = IRK;
+
+    const int num_steps = 2;
+    const int newton_iter = 20;
+
+    for (int ns = 1; ns < 6; ns++)
+    {
+        // reference: fixed number of iterations, then residual based exit
+        for (int use_tol = 0; use_tol < 2; use_tol++)
+        {
+            sim_config *config = sim_config_create(plan);
+
+            void *dims = sim_dims_create(config);
+            sim_dims_set(config, dims, "nx", &nx);
+            sim_dims_set(config, dims, "nu", &nu);
+
+            void *opts_ = sim_opts_create(config, dims);
+            sim_opts *opts = (sim_opts *) opts_;
+
+            int num_steps_ = num_steps;
+            int newton_iter_ = newton_iter;
+            bool jac_reuse = use_tol;
+            double newton_tol = use_tol ? 1e-10 : 0.0;
+            sim_opts_set(config, opts, "ns", &ns);
+            sim_opts_set(config, opts, "num_steps", &num_steps_);
+            sim_opts_set(config, opts, "newton_iter", &newton_iter_);
+            sim_opts_set(config, opts, "jac_reuse", &jac_reuse);
+            sim_opts_set(config, opts, "newton_tol", &newton_tol);
+
+            sim_in *in = sim_in_create(config, dims);
+            sim_out *out = sim_out_create(config, dims);
+
+            in->T = T;
+
+            sim_in_set(config, dims, in, "impl_ode_fun", &impl_ode_fun);
+            sim_in_set(config, dims, in, "impl_ode_fun_jac_x_xdot", &impl_ode_fun_jac_x_xdot);
+            sim_in_set(config, dims, in, "impl_ode_jac_x_xdot_u", &impl_ode_jac_x_xdot_u);
+
+            for (jj = 0; jj < nx; jj++)
+                in->x[jj] = x0[jj];
+            for (jj = 0; jj < nu; jj++)
+                in->u[jj] = u_sim[jj];
+
+            // seeds forw
+            for (ii = 0; ii < nx * NF; ii++)
+                in->S_forw[ii] = 0.0;
+            for (ii = 0; ii < nx; ii++)
+                in->S_forw[ii * (nx + 1)] = 1.0;
+            in->identity_seed = true;
+
+            sim_solver *sim_solver = sim_solver_create(config, dims, opts);
+
+            int acados_return = sim_solve(sim_solver, in, out);
+            REQUIRE(acados_return == 0);
+
+            int iter_steps[num_steps];
+            double res_steps[num_steps];
+            int iter_total;
+            sim_solver_get(sim_solver, "newton_iter", iter_steps);
+            sim_solver_get(sim_solver, "newton_res", res_steps);
+            sim_solver_get(sim_solver, "newton_iter_total", &iter_total);
+
+            if (!use_tol)
+            {
+                REQUIRE(iter_total == num_steps * newton_iter);
+
+                for (jj = 0; jj < nx; jj++)
+                    x_ref_sol[jj] = out->xn[jj];
+                for (jj = 0; jj < nx*NF; jj++)
+                    S_forw_ref_sol[jj] = out->S_forw[jj];
+            }
+            else
+            {
+                std::cout << "\n---> testing IRK Newton tolerance (num_stages = " << ns
+                          << ", newton_iter_total = " << iter_total << ")\n";
+
+                for (jj = 0; jj < num_steps; jj++)
+                {
+                    REQUIRE(iter_steps[jj] < newton_iter);
+                    REQUIRE(res_steps[jj] <= newton_tol);
+                }
+
+                for (jj = 0; jj < nx; jj++)
+                    REQUIRE(fabs(out->xn[jj] - x_ref_sol[jj]) <= 1e-9);
+                for (jj = 0; jj < nx*NF; jj++)
+                    REQUIRE(fabs(out->S_forw[jj] - S_forw_ref_sol[jj]) <= 1e-9);
+            }
+
+            sim_config_destroy(config);
+            sim_dims_destroy(dims);
+            sim_opts_destroy(opts);
+
+            sim_in_destroy(in);
+            sim_out_destroy(out);
+            sim_solver_destroy(sim_solver);
+        }
+    }
+
+    external_function_casadi_free(&impl_ode_fun);
+    external_function_casadi_free(&impl_ode_fun_jac_x_xdot);
+    external_function_casadi_free(&impl_ode_jac_x_xdot_u);
+
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("wt_nx3_example ERK batch", "[integrators]")
+{
+    int ii, jj, kk;
+
+    const int nx = 3;
+    const int nu = 4;
+    int NF = nx + nu;  // columns of forward seed
+
+    double T = 0.05;  // simulation time
+
+    const int num_threads = 2;
+    const int num_traj = 7;
+
+    /************************************************
+    * external functions (explicit model), one set per worker
+    ************************************************/
+
+    vector<external_function_casadi> expl_ode_fun(num_threads + 1);
+    vector<external_function_casadi> expl_vde_for(num_threads + 1);
+
+    for (ii = 0; ii < num_threads + 1; ii++)
+    {
+        expl_ode_fun[ii].casadi_fun = &casadi_expl_ode_fun;
+        expl_ode_fun[ii].casadi_work = &casadi_expl_ode_fun_work;
+        expl_ode_fun[ii].casadi_sparsity_in = &casadi_expl_ode_fun_sparsity_in;
+        expl_ode_fun[ii].casadi_sparsity_out = &casadi_expl_ode_fun_sparsity_out;
+        expl_ode_fun[ii].casadi_n_in = &casadi_expl_ode_fun_n_in;
+        expl_ode_fun[ii].casadi_n_out = &casadi_expl_ode_fun_n_out;
+        external_function_casadi_create(&expl_ode_fun[ii]);
+
+        expl_vde_for[ii].casadi_fun = &casadi_expl_vde_for;
+        expl_vde_for[ii].casadi_work = &casadi_expl_vde_for_work;
+        expl_vde_for[ii].casadi_sparsity_in = &casadi_expl_vde_for_sparsity_in;
+        expl_vde_for[ii].casadi_sparsity_out = &casadi_expl_vde_for_sparsity_out;
+        expl_vde_for[ii].casadi_n_in = &casadi_expl_vde_for_n_in;
+        expl_vde_for[ii].casadi_n_out = &casadi_expl_vde_for_n_out;
+        external_function_casadi_create(&expl_vde_for[ii]);
+    }
+
+    sim_solver_plan plan;
+    plan.sim_solver = ERK;
+
+    sim_config *config = sim_config_create(plan);
+
+    void *dims = sim_dims_create(config);
+    sim_dims_set(config, dims, "nx", &nx);
+    sim_dims_set(config, dims, "nu", &nu);
+
+    void *opts = sim_opts_create(config, dims);
+    int num_steps = 10;
+    sim_opts_set(config, opts, "num_steps", &num_steps);
+
+    // perturbed initial states and controls
+    vector<double> x0_batch(nx * num_traj);
+    vector<double> u_batch(nu * num_traj);
+    for (kk = 0; kk < num_traj; kk++)
+    {
+        for (jj = 0; jj < nx; jj++)
+            x0_batch[kk * nx + jj] = x0[jj] * (1.0 + 0.01 * kk);
+        for (jj = 0; jj < nu; jj++)
+            u_batch[kk * nu + jj] = u_sim[jj] * (1.0 - 0.01 * kk);
+    }
+
+    vector<double> S_forw_seed(nx * NF, 0.0);
+    for (ii = 0; ii < nx; ii++)
+        S_forw_seed[ii * (nx + 1)] = 1.0;
+
+    // batch
+    sim_batch *batch = sim_batch_create(config, dims, opts, num_threads, 0);
+
+    sim_batch_in_set(batch, "T", &T);
+    sim_batch_in_set(batch, "S_forw", S_forw_seed.data());
+    for (ii = 0; ii < num_threads; ii++)
+    {
+        sim_batch_model_set(batch, ii, "expl_ode_fun", &expl_ode_fun[ii]);
+        sim_batch_model_set(batch, ii, "expl_vde_for", &expl_vde_for[ii]);
+    }
+
+    vector<double> xn_batch(nx * num_traj);
+    vector<double> S_forw_batch(nx * NF * num_traj);
+
+    int acados_return = sim_solve_batch(batch, num_traj, x0_batch.data(), u_batch.data(), NULL,
+                                        xn_batch.data(), S_forw_batch.data());
+    REQUIRE(acados_return == 0);
+
+    // reference: one trajectory at a time
+    sim_in *in = sim_in_create(config, dims);
+    sim_out *out = sim_out_create(config, dims);
+
+    in->T = T;
+    sim_in_set(config, dims, in, "expl_ode_fun", &expl_ode_fun[num_threads]);
+    sim_in_set(config, dims, in, "expl_vde_for", &expl_vde_for[num_threads]);
+    sim_in_set(config, dims, in, "S_forw", S_forw_seed.data());
+
+    sim_solver *sim_solver = sim_solver_create(config, dims, opts);
+
+    for (kk = 0; kk < num_traj; kk++)
+    {
+        sim_in_set(config, dims, in, "x", &x0_batch[kk * nx]);
+        sim_in_set(config, dims, in, "u", &u_batch[kk * nu]);
+
+        acados_return = sim_solve(sim_solver, in, out);
+        REQUIRE(acados_return == 0);
+
+        for (jj = 0; jj < nx; jj++)
+            REQUIRE(fabs(xn_batch[kk * nx + jj] - out->xn[jj]) <= 1e-14);
+        for (jj = 0; jj < nx * NF; jj++)
+            REQUIRE(fabs(S_forw_batch[kk * nx * NF + jj] - out->S_forw[jj]) <= 1e-14);
+    }
+
+    sim_batch_destroy(batch);
+    sim_solver_destroy(sim_solver);
+    sim_in_destroy(in);
+    sim_out_destroy(out);
+
+    sim_opts_destroy(opts);
+    sim_dims_destroy(dims);
+    sim_config_destroy(config);
+
+    for (ii = 0; ii < num_threads + 1; ii++)
+    {
+        external_function_casadi_free(&expl_ode_fun[ii]);
+        external_function_casadi_free(&expl_vde_for[ii]);
+    }
+
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("wt_nx3_example Rosenbrock and exponential Euler", "[integrators]")
+{
+    int ii, jj, kk;
+
+    const int nx = 3;
+    const int nu = 4;
+    int NF = nx + nu;  // columns of forward seed
+
+    double T = 0.05;  // simulation time
+
+    /************************************************
+    * external functions (explicit model)
+    ************************************************/
+
+    external_function_casadi expl_ode_fun;
+    expl_ode_fun.casadi_fun = &casadi_expl_ode_fun;
+    expl_ode_fun.casadi_work = &casadi_expl_ode_fun_work;
+    expl_ode_fun.casadi_sparsity_in = &casadi_expl_ode_fun_sparsity_in;
+    expl_ode_fun.casadi_sparsity_out = &casadi_expl_ode_fun_sparsity_out;
+    expl_ode_fun.casadi_n_in = &casadi_expl_ode_fun_n_in;
+    expl_ode_fun.casadi_n_out = &casadi_expl_ode_fun_n_out;
+    external_function_casadi_create(&expl_ode_fun);
+
+    external_function_casadi expl_vde_for;
+    expl_vde_for.casadi_fun = &casadi_expl_vde_for;
+    expl_vde_for.casadi_work = &casadi_expl_vde_for_work;
+    expl_vde_for.casadi_sparsity_in = &casadi_expl_vde_for_sparsity_in;
+    expl_vde_for.casadi_sparsity_out = &casadi_expl_vde_for_sparsity_out;
+    expl_vde_for.casadi_n_in = &casadi_expl_vde_for_n_in;
+    expl_vde_for.casadi_n_out = &casadi_expl_vde_for_n_out;
+    external_function_casadi_create(&expl_vde_for);
+
+    vector<double> S_forw_seed(nx * NF, 0.0);
+    for (ii = 0; ii < nx; ii++)
+        S_forw_seed[ii * (nx + 1)] = 1.0;
+
+    // adjoint seed
+    vector<double> S_adj_seed = {1.0, -0.5, 2.0};
+
+    // linear part of exponential Euler: jacobian of the ode at (x0, u)
+    vector<double> f0(nx), A_LO(nx * nx), f0_u(nx * nu);
+    {
+        ext_fun_arg_t ext_fun_type_in[4] = {COLMAJ, COLMAJ, COLMAJ, COLMAJ};
+        void *ext_fun_in[4] = {x0, S_forw_seed.data(), S_forw_seed.data() + nx * nx, u_sim};
+        ext_fun_arg_t ext_fun_type_out[3] = {COLMAJ, COLMAJ, COLMAJ};
+        void *ext_fun_out[3] = {f0.data(), A_LO.data(), f0_u.data()};
+        expl_vde_for.evaluate(&expl_vde_for, ext_fun_type_in, ext_fun_in, ext_fun_type_out,
+                              ext_fun_out);
+    }
+
+    /************************************************
+    * reference: fine ERK
+    ************************************************/
+
+    vector<double> x_ref(nx);
+    vector<double> S_forw_ref(nx * NF);
+
+    vector<sim_solver_t> solvers = {ERK, ROSENBROCK, EXP_EULER};
+    vector<int> steps = {100, 500, 2000};
+    vector<double> tols = {0.0, 1e-6, 1e-4};
+    // finite differences of the discrete map: the Rosenbrock sensitivities are only O(step^2)
+    // accurate, the exponential Euler ones are exact
+    vector<double> tols_fd = {0.0, 1e-5, 1e-6};
+    double eps_fd = 1e-6;
+
+    for (int is = 0; is < (int) solvers.size(); is++)
+    {
+        sim_solver_plan plan;
+        plan.sim_solver = solvers[is];
+
+        sim_config *config = sim_config_create(plan);
+
+        void *dims = sim_dims_create(config);
+        sim_dims_set(config, dims, "nx", &nx);
+        sim_dims_set(config, dims, "nu", &nu);
+
+        void *opts = sim_opts_create(config, dims);
+        sim_opts_set(config, opts, "num_steps", &steps[is]);
+        bool sens_adj = true;
+        sim_opts_set(config, opts, "sens_adj", &sens_adj);
+
+        sim_in *in = sim_in_create(config, dims);
+        sim_out *out = sim_out_create(config, dims);
+
+        in->T = T;
+        sim_in_set(config, dims, in, "x", x0);
+        sim_in_set(config, dims, in, "u", u_sim);
+        sim_in_set(config, dims, in, "S_forw", S_forw_seed.data());
+        sim_in_set(config, dims, in, "S_adj", S_adj_seed.data());
+        sim_in_set(config, dims, in, "expl_ode_fun", &expl_ode_fun);
+        sim_in_set(config, dims, in, "expl_vde_for", &expl_vde_for);
+        if (solvers[is] == EXP_EULER)
+            sim_in_set(config, dims, in, "A_LO", A_LO.data());
+
+        sim_solver *sim_solver = sim_solver_create(config, dims, opts);
+
+        int acados_return = sim_solve(sim_solver, in, out);
+        REQUIRE(acados_return == 0);
+
+        if (solvers[is] == ERK)
+        {
+            for (jj = 0; jj < nx; jj++)
+                x_ref[jj] = out->xn[jj];
+            for (jj = 0; jj < nx * NF; jj++)
+                S_forw_ref[jj] = out->S_forw[jj];
+        }
+        else
+        {
+            for (jj = 0; jj < nx; jj++)
+                REQUIRE(fabs(out->xn[jj] - x_ref[jj]) <= tols[is]);
+            for (jj = 0; jj < nx * NF; jj++)
+                REQUIRE(fabs(out->S_forw[jj] - S_forw_ref[jj]) <= tols[is]);
+
+            vector<double> S_forw(out->S_forw, out->S_forw + nx * NF);
+
+            // adjoint sensitivities: S_adj = S_forw' * seed
+            for (jj = 0; jj < NF; jj++)
+            {
+                double S_adj_fwd = 0.0;
+                for (ii = 0; ii < nx; ii++)
+                    S_adj_fwd += S_forw[ii + nx * jj] * S_adj_seed[ii];
+                REQUIRE(fabs(out->S_adj[jj] - S_adj_fwd) <= 1e-10 * (1.0 + fabs(S_adj_fwd)));
+            }
+
+            // forward sensitivities: central finite differences of the discrete map w.r.t. (x0, u)
+            vector<double> xu(x0, x0 + nx);
+            xu.insert(xu.end(), u_sim, u_sim + nu);
+            vector<double> xn_p(nx), xn_m(nx);
+            for (jj = 0; jj < NF; jj++)
+            {
+                for (kk = -1; kk <= 1; kk += 2)
+                {
+                    vector<double> xu_pert(xu);
+                    xu_pert[jj] += kk * eps_fd;
+                    sim_in_set(config, dims, in, "x", xu_pert.data());
+                    sim_in_set(config, dims, in, "u", xu_pert.data() + nx);
+
+                    REQUIRE(sim_solve(sim_solver, in, out) == 0);
+                    for (ii = 0; ii < nx; ii++)
+                        (kk < 0 ? xn_m : xn_p)[ii] = out->xn[ii];
+                }
+                for (ii = 0; ii < nx; ii++)
+                {
+                    double S_fd = (xn_p[ii] - xn_m[ii]) / (2.0 * eps_fd);
+                    REQUIRE(fabs(S_fd - S_forw[ii + nx * jj]) <=
+                            tols_fd[is] * (1.0 + fabs(S_fd)));
+                }
+            }
+        }
+
+        sim_solver_destroy(sim_solver);
+        sim_in_destroy(in);
+        sim_out_destroy(out);
+
+        sim_opts_destroy(opts);
+        sim_dims_destroy(dims);
+        sim_config_destroy(config);
+    }
+
+    external_function_casadi_free(&expl_ode_fun);
+    external_function_casadi_free(&expl_vde_for);
+
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("wt_nx3_example dense output", "[integrators]")
+{
+    int ii, jj, kk;
+
+    const int nx = 3;
+    const int nu = 4;
+    int NF = nx + nu;  // columns of forward seed
+
+    double T = 0.05;  // simulation time
+
+    const int n_dense = 3;
+    double t_dense[n_dense] = {0.3*T, 0.75*T, T};
+
+    double x_ref_sol[n_dense*nx];
+    double S_forw_ref_sol[n_dense*nx*NF];
+    double x_dense[n_dense*nx];
+    double S_dense[n_dense*nx*NF];
+
+    /************************************************
+    * external functions
+    ************************************************/
+
+    // expl_ode_fun
+    external_function_casadi expl_ode_fun;
+    expl_ode_fun.casadi_fun = &casadi_expl_ode_fun;
+    expl_ode_fun.casadi_work = &casadi_expl_ode_fun_work;
+    expl_ode_fun.casadi_sparsity_in = &casadi_expl_ode_fun_sparsity_in;
+    expl_ode_fun.casadi_sparsity_out = &casadi_expl_ode_fun_sparsity_out;
+    expl_ode_fun.casadi_n_in = &casadi_expl_ode_fun_n_in;
+    expl_ode_fun.casadi_n_out = &casadi_expl_ode_fun_n_out;
+    external_function_casadi_create(&expl_ode_fun);
+
+    // expl_vde_for
+    external_function_casadi expl_vde_for;
+    expl_vde_for.casadi_fun = &casadi_expl_vde_for;
+    expl_vde_for.casadi_work = &casadi_expl_vde_for_work;
+    expl_vde_for.casadi_sparsity_in = &casadi_expl_vde_for_sparsity_in;
+    expl_vde_for.casadi_sparsity_out = &casadi_expl_vde_for_sparsity_out;
+    expl_vde_for.casadi_n_in = &casadi_expl_vde_for_n_in;
+    expl_vde_for.casadi_n_out = &casadi_expl_vde_for_n_out;
+    external_function_casadi_create(&expl_vde_for);
+
+    // impl_ode_fun
+    external_function_casadi impl_ode_fun;
+    impl_ode_fun.casadi_fun = &casadi_impl_ode_fun;
+    impl_ode_fun.casadi_work = &casadi_impl_ode_fun_work;
+    impl_ode_fun.casadi_sparsity_in = &casadi_impl_ode_fun_sparsity_in;
+    impl_ode_fun.casadi_sparsity_out = &casadi_impl_ode_fun_sparsity_out;
+    impl_ode_fun.casadi_n_in = &casadi_impl_ode_fun_n_in;
+    impl_ode_fun.casadi_n_out = &casadi_impl_ode_fun_n_out;
+    external_function_casadi_create(&impl_ode_fun);
+
+    // impl_ode_fun_jac_x_xdot
+    external_function_casadi impl_ode_fun_jac_x_xdot;
+    impl_ode_fun_jac_x_xdot.casadi_fun = &casadi_impl_ode_fun_jac_x_xdot;
+    impl_ode_fun_jac_x_xdot.casadi_work = &casadi_impl_ode_fun_jac_x_xdot_work;
+    impl_ode_fun_jac_x_xdot.casadi_sparsity_in = &casadi_impl_ode_fun_jac_x_xdot_sparsity_in;
+    impl_ode_fun_jac_x_xdot.casadi_sparsity_out = &casadi_impl_ode_fun_jac_x_xdot_sparsity_out;
+    impl_ode_fun_jac_x_xdot.casadi_n_in = &casadi_impl_ode_fun_jac_x_xdot_n_in;
+    impl_ode_fun_jac_x_xdot.casadi_n_out = &casadi_impl_ode_fun_jac_x_xdot_n_out;
+    external_function_casadi_create(&impl_ode_fun_jac_x_xdot);
+
+    // impl_ode_jac_x_xdot_u
+    external_function_casadi impl_ode_jac_x_xdot_u;
+    impl_ode_jac_x_xdot_u.casadi_fun = &casadi_impl_ode_jac_x_xdot_u;
+    impl_ode_jac_x_xdot_u.casadi_work = &casadi_impl_ode_jac_x_xdot_u_work;
+    impl_ode_jac_x_xdot_u.casadi_sparsity_in = &casadi_impl_ode_jac_x_xdot_u_sparsity_in;
+    impl_ode_jac_x_xdot_u.casadi_sparsity_out = &casadi_impl_ode_jac_x_xdot_u_sparsity_out;
+    impl_ode_jac_x_xdot_u.casadi_n_in = &casadi_impl_ode_jac_x_xdot_u_n_in;
+    impl_ode_jac_x_xdot_u.casadi_n_out = &casadi_impl_ode_jac_x_xdot_u_n_out;
+    external_function_casadi_create(&impl_ode_jac_x_xdot_u);
+
+    // reference: fine RK4 integration up to each dense output time, then ERK and IRK dense output
+    vector<sim_solver_t> solvers = {ERK, ERK, IRK};
+
+    for (int is = 0; is < (int) solvers.size(); is++)
+    {
+        bool reference = is == 0;
+
+        sim_solver_plan plan;
+        plan.sim_solver = solvers[is];
+
+        sim_config *config = sim_config_create(plan);
+
+        void *dims = sim_dims_create(config);
+        sim_dims_set(config, dims, "nx", &nx);
+        sim_dims_set(config, dims, "nu", &nu);
+        if (!reference)
+            sim_dims_set(config, dims, "n_dense", &n_dense);
+
+        void *opts_ = sim_opts_create(config, dims);
+        sim_opts *opts = (sim_opts *) opts_;
+
+        int num_steps = reference ? 500 : 10;
+        int ns = solvers[is] == IRK ? 3 : 4;
+        sim_opts_set(config, opts, "ns", &ns);
+        sim_opts_set(config, opts, "num_steps", &num_steps);
+
+        sim_in *in = sim_in_create(config, dims);
+        sim_out *out = sim_out_create(config, dims);
+
+        if (solvers[is] == ERK)
+        {
+            sim_in_set(config, dims, in, "expl_ode_fun", &expl_ode_fun);
+            sim_in_set(config, dims, in, "expl_vde_for", &expl_vde_for);
+        }
+        else
+        {
+            sim_in_set(config, dims, in, "impl_ode_fun", &impl_ode_fun);
+            sim_in_set(config, dims, in, "impl_ode_fun_jac_x_xdot", &impl_ode_fun_jac_x_xdot);
+            sim_in_set(config, dims, in, "impl_ode_jac_x_xdot_u", &impl_ode_jac_x_xdot_u);
+        }
+
+        if (!reference)
+            sim_in_set(config, dims, in, "t_dense", t_dense);
+
+        sim_solver *sim_solver = sim_solver_create(config, dims, opts);
+
+        for (kk = 0; kk < (reference ? n_dense : 1); kk++)
+        {
+            in->T = reference ? t_dense[kk] : T;
+
+            for (jj = 0; jj < nx; jj++)
+                in->x[jj] = x0[jj];
+            for (jj = 0; jj < nu; jj++)
+                in->u[jj] = u_sim[jj];
+
+            // seeds forw
+            for (ii = 0; ii < nx * NF; ii++)
+                in->S_forw[ii] = 0.0;
+            for (ii = 0; ii < nx; ii++)
+                in->S_forw[ii * (nx + 1)] = 1.0;
+            in->identity_seed = true;
+
+            int acados_return = sim_solve(sim_solver, in, out);
+            REQUIRE(acados_return == 0);
+
+            if (reference)
+            {
+                for (jj = 0; jj < nx; jj++)
+                    x_ref_sol[kk*nx+jj] = out->xn[jj];
+                for (jj = 0; jj < nx*NF; jj++)
+                    S_forw_ref_sol[kk*nx*NF+jj] = out->S_forw[jj];
+            }
+        }
+
+        if (!reference)
+        {
+            std::cout << "\n---> testing dense output (solver = "
+                      << (solvers[is] == ERK ? "ERK" : "IRK") << ", num_stages = " << ns << ")\n";
+
+            sim_out_get(config, dims, out, "x_dense", x_dense);
+            sim_out_get(config, dims, out, "S_dense", S_dense);
+
+            for (jj = 0; jj < n_dense*nx; jj++)
+                REQUIRE(fabs(x_dense[jj] - x_ref_sol[jj]) <= 1e-6);
+            for (jj = 0; jj < n_dense*nx*NF; jj++)
+                REQUIRE(fabs(S_dense[jj] - S_forw_ref_sol[jj]) <= 1e-5);
+
+            // the last point is the end of the interval
+            for (jj = 0; jj < nx; jj++)
+                REQUIRE(fabs(x_dense[(n_dense-1)*nx+jj] - out->xn[jj]) <= 1e-10);
+        }
+
+        sim_config_destroy(config);
+        sim_dims_destroy(dims);
+        sim_opts_destroy(opts);
+
+        sim_in_destroy(in);
+        sim_out_destroy(out);
+        sim_solver_destroy(sim_solver);
+    }
+
+    external_function_casadi_free(&expl_ode_fun);
+    external_function_casadi_free(&expl_vde_for);
+    external_function_casadi_free(&impl_ode_fun);
+    external_function_casadi_free(&impl_ode_fun_jac_x_xdot);
+    external_function_casadi_free(&impl_ode_jac_x_xdot_u);
+
+}  // END_TEST_CASE
+
+
+
+TEST_CASE("Gauss-Legendre tableau cache", "[integrators]")
+{
+    for (int ns = 1; ns <= 4; ns++)
+    {
+        const gauss_tableau *tableau = gauss_tableau_get(ns, false);
+
+        // repeated lookups return the same shared tableau
+        REQUIRE(gauss_tableau_get(ns, false) == tableau);
+        REQUIRE(tableau->ns == ns);
+
+        // consistency of the butcher tableau
+        double b_sum = 0.0;
+        for (int i = 0; i < ns; i++)
+        {
+            double a_sum = 0.0;
+            for (int j = 0; j < ns; j++)
+                a_sum += tableau->A_mat[i * ns + j];
+            REQUIRE(a_sum == Approx(tableau->c_vec[i]).epsilon(1e-10));
+            b_sum += tableau->b_vec[i];
+        }
+        REQUIRE(b_sum == Approx(1.0).epsilon(1e-10));
+
+        // the simplified Newton transformation is added to the same entry
+        const gauss_tableau *simplified = gauss_tableau_get(ns, true);
+        REQUIRE(simplified == tableau);
+        REQUIRE(simplified->scheme != NULL);
+    }
+
+}  // END_TEST_CASE